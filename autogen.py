@@ -26,21 +26,32 @@ OUTPUT_DIR = './tests/main/src'
 collections = [
     # type, header, pfx, sname, key, val
     {'t': 'BITSET',       'h': '"cmc/bitset.h"',       'pfx': 'bs',  'sname': 'bitset',       'key': '',       'val': ''      },
+    {'t': 'BTREEMAP',     'h': '"cmc/btreemap.h"',     'pfx': 'btm', 'sname': 'btreemap',     'key': 'size_t', 'val': 'size_t'},
+    {'t': 'BTREESET',     'h': '"cmc/btreeset.h"',     'pfx': 'bts', 'sname': 'btreeset',     'key': '',       'val': 'size_t'},
     {'t': 'DEQUE',        'h': '"cmc/deque.h"',        'pfx': 'd',   'sname': 'deque',        'key': '',       'val': 'size_t'},
+    {'t': 'GAPBUFFER',    'h': '"cmc/gapbuffer.h"',    'pfx': 'gb',  'sname': 'gapbuffer',    'key': '',       'val': 'size_t'},
     {'t': 'HASHBIDIMAP',  'h': '"cmc/hashbidimap.h"',  'pfx': 'hbm', 'sname': 'hashbidimap',  'key': 'size_t', 'val': 'size_t'},
     {'t': 'HASHMAP',      'h': '"cmc/hashmap.h"',      'pfx': 'hm',  'sname': 'hashmap',      'key': 'size_t', 'val': 'size_t'},
     {'t': 'HASHMULTIMAP', 'h': '"cmc/hashmultimap.h"', 'pfx': 'hmm', 'sname': 'hashmultimap', 'key': 'size_t', 'val': 'size_t'},
     {'t': 'HASHMULTISET', 'h': '"cmc/hashmultiset.h"', 'pfx': 'hms', 'sname': 'hashmultiset', 'key': '',       'val': 'size_t'},
     {'t': 'HASHSET',      'h': '"cmc/hashset.h"',      'pfx': 'hs',  'sname': 'hashset',      'key': '',       'val': 'size_t'},
     {'t': 'HEAP',         'h': '"cmc/heap.h"',         'pfx': 'h',   'sname': 'heap',         'key': '',       'val': 'size_t'},
+    {'t': 'INDEXHEAP',    'h': '"cmc/indexheap.h"',    'pfx': 'ixh', 'sname': 'indexheap',    'key': '',       'val': 'size_t'},
     {'t': 'INTERVALHEAP', 'h': '"cmc/intervalheap.h"', 'pfx': 'ih',  'sname': 'intervalheap', 'key': '',       'val': 'size_t'},
+    {'t': 'LFSTACK',      'h': '"cmc/lfstack.h"',      'pfx': 'lfs', 'sname': 'lfstack',      'key': '',       'val': 'size_t'},
     {'t': 'LINKEDLIST',   'h': '"cmc/linkedlist.h"',   'pfx': 'll',  'sname': 'linkedlist',   'key': '',       'val': 'size_t'},
     {'t': 'LIST',         'h': '"cmc/list.h"',         'pfx': 'l',   'sname': 'list',         'key': '',       'val': 'size_t'},
+    {'t': 'MPMCQUEUE',    'h': '"cmc/mpmcqueue.h"',    'pfx': 'mpq', 'sname': 'mpmcqueue',    'key': '',       'val': 'size_t'},
     {'t': 'QUEUE',        'h': '"cmc/queue.h"',        'pfx': 'q',   'sname': 'queue',        'key': '',       'val': 'size_t'},
+    {'t': 'RADIXHEAP',    'h': '"cmc/radixheap.h"',    'pfx': 'rh',  'sname': 'radixheap',    'key': 'size_t', 'val': 'size_t'},
+    {'t': 'SEGDEQUE',     'h': '"cmc/segdeque.h"',     'pfx': 'sd',  'sname': 'segdeque',     'key': '',       'val': 'size_t'},
     {'t': 'SORTEDLIST',   'h': '"cmc/sortedlist.h"',   'pfx': 'sl',  'sname': 'sortedlist',   'key': '',       'val': 'size_t'},
+    {'t': 'SMALLVEC',     'h': '"cmc/smallvec.h"',     'pfx': 'sv',  'sname': 'smallvec',     'key': '',       'val': 'size_t, 8'},
+    {'t': 'SPSCQUEUE',    'h': '"cmc/spscqueue.h"',    'pfx': 'spq', 'sname': 'spscqueue',    'key': '',       'val': 'size_t'},
     {'t': 'STACK',        'h': '"cmc/stack.h"',        'pfx': 's',   'sname': 'stack',        'key': '',       'val': 'size_t'},
     {'t': 'TREEMAP',      'h': '"cmc/treemap.h"',      'pfx': 'tm',  'sname': 'treemap',      'key': 'size_t', 'val': 'size_t'},
-    {'t': 'TREESET',      'h': '"cmc/treeset.h"',      'pfx': 'ts',  'sname': 'treeset',      'key': '',       'val': 'size_t'}
+    {'t': 'TREESET',      'h': '"cmc/treeset.h"',      'pfx': 'ts',  'sname': 'treeset',      'key': '',       'val': 'size_t'},
+    {'t': 'UNROLLEDLIST', 'h': '"cmc/unrolledlist.h"', 'pfx': 'ul',  'sname': 'unrolledlist', 'key': '',       'val': 'size_t'}
 ]
 
 # Create output directory
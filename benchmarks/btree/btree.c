@@ -0,0 +1,93 @@
+/**
+ * btree.c
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/* Comparing the AVL Tree based TreeMap against the B-Tree based BTreeMap */
+
+#include "../util/twister.c"
+#include "utl/futils.h"
+#include "utl/timer.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+#define MAX 1000000
+
+#if defined(CMC_TREEMAP)
+#include "cmc/treemap.h"
+CMC_GENERATE_TREEMAP(m, map, size_t, size_t)
+#define TARGET "TREEMAP"
+#elif defined(CMC_BTREEMAP)
+#include "cmc/btreemap.h"
+CMC_GENERATE_BTREEMAP(m, map, size_t, size_t)
+#define TARGET "BTREEMAP"
+#else
+#error Please define either CMC_TREEMAP or CMC_BTREEMAP
+#endif
+
+struct map_fkey *fkey = &(struct map_fkey){ .cmp = cmc_size_cmp };
+struct map_fval *fval = &(struct map_fval){ .cmp = cmc_size_cmp };
+
+size_t keys[MAX];
+
+void report(const char *operation, struct cmc_timer *timer)
+{
+    printf("%-10s: %.0lf milliseconds\n", operation, timer->result);
+}
+
+int main(void)
+{
+    mt_state state;
+    twist_init(&state, 42);
+
+    for (size_t i = 0; i < MAX; i++)
+        keys[i] = twist_uint64(&state);
+
+    struct map *m = m_new(fkey, fval);
+
+    size_t sum = 0;
+    struct cmc_timer timer;
+
+    printf("----------------------------------------\n");
+    printf("%s\n", TARGET);
+#if defined(CMC_BTREEMAP)
+    printf("Order: %d\n", CMC_BTREE_ORDER);
+#endif
+
+    cmc_timer_start(timer);
+    for (size_t i = 0; i < MAX; i++)
+        m_insert(m, keys[i], i);
+    cmc_timer_stop(timer);
+    report("Insert", &timer);
+
+    cmc_timer_start(timer);
+    for (size_t i = 0; i < MAX; i++)
+        sum += m_get(m, keys[i]);
+    cmc_timer_stop(timer);
+    report("Search", &timer);
+
+    cmc_timer_start(timer);
+    for (struct map_iter it = m_iter_start(m); !m_iter_at_end(&it);
+         m_iter_next(&it))
+        sum += m_iter_value(&it);
+    cmc_timer_stop(timer);
+    report("Iterate", &timer);
+
+    cmc_timer_start(timer);
+    for (size_t i = 0; i < MAX; i++)
+        m_remove(m, keys[i], NULL);
+    cmc_timer_stop(timer);
+    report("Remove", &timer);
+
+    printf("SUM: %" PRIuMAX "\n", sum);
+    printf("----------------------------------------\n");
+
+    m_free(m);
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+/**
+ * heap.c
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/* Comparing heaps with different arities. For each size the heap is filled */
+/* with random keys and then emptied by removing its top, which is repeated */
+/* until TOTAL keys went through the heap so every size does the same work. */
+
+#include "../util/twister.c"
+#include "cmc/heap.h"
+#include "cmc/intervalheap.h"
+#include "utl/futils.h"
+#include "utl/timer.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+#ifndef TOTAL
+#define TOTAL 10000000
+#endif
+
+CMC_GENERATE_HEAP(h2, heap2, size_t)
+CMC_GENERATE_HEAP_DARY(h4, heap4, size_t, 4)
+CMC_GENERATE_HEAP_DARY(h8, heap8, size_t, 8)
+CMC_GENERATE_INTERVALHEAP(ih2, intervalheap2, size_t)
+CMC_GENERATE_INTERVALHEAP_DARY(ih4, intervalheap4, size_t, 4)
+CMC_GENERATE_INTERVALHEAP_DARY(ih8, intervalheap8, size_t, 8)
+
+size_t keys[TOTAL];
+
+void report(const char *name, size_t size, struct cmc_timer *insert,
+            struct cmc_timer *removal, size_t sum)
+{
+    printf("%-14s %10" PRIuMAX " %12.0lf %12.0lf %22" PRIuMAX "\n", name,
+           (uintmax_t)size, insert->result, removal->result, (uintmax_t)sum);
+}
+
+/* Times the insertion and the removal of every key of a heap */
+#define BENCH_HEAP(PFX, SNAME, NAME, SIZE)                       \
+    do                                                           \
+    {                                                            \
+        size_t size = SIZE;                                      \
+        struct SNAME##_fval fval = { .cmp = cmc_size_cmp };      \
+        struct SNAME *h = PFX##_new(size, cmc_min_heap, &fval);  \
+        struct cmc_timer insert = { 0 }, removal = { 0 }, timer; \
+        size_t sum = 0;                                          \
+                                                                 \
+        for (size_t r = 0; r < TOTAL / size; r++)                \
+        {                                                        \
+            cmc_timer_start(timer);                              \
+            for (size_t k = 0; k < size; k++)                    \
+                PFX##_insert(h, keys[r * size + k]);             \
+            cmc_timer_stop(timer);                               \
+            insert.result += timer.result;                       \
+                                                                 \
+            cmc_timer_start(timer);                              \
+            while (!PFX##_empty(h))                              \
+            {                                                    \
+                sum += PFX##_peek(h);                            \
+                PFX##_remove(h);                                 \
+            }                                                    \
+            cmc_timer_stop(timer);                               \
+            removal.result += timer.result;                      \
+        }                                                        \
+                                                                 \
+        report(NAME, size, &insert, &removal, sum);              \
+                                                                 \
+        PFX##_free(h);                                           \
+    } while (0)
+
+/* Same as above but removing from both ends */
+#define BENCH_INTERVALHEAP(PFX, SNAME, NAME, SIZE)               \
+    do                                                           \
+    {                                                            \
+        size_t size = SIZE;                                      \
+        struct SNAME##_fval fval = { .cmp = cmc_size_cmp };      \
+        struct SNAME *h = PFX##_new(size, &fval);                \
+        struct cmc_timer insert = { 0 }, removal = { 0 }, timer; \
+        size_t sum = 0;                                          \
+                                                                 \
+        for (size_t r = 0; r < TOTAL / size; r++)                \
+        {                                                        \
+            cmc_timer_start(timer);                              \
+            for (size_t k = 0; k < size; k++)                    \
+                PFX##_insert(h, keys[r * size + k]);             \
+            cmc_timer_stop(timer);                               \
+            insert.result += timer.result;                       \
+                                                                 \
+            cmc_timer_start(timer);                              \
+            while (!PFX##_empty(h))                              \
+            {                                                    \
+                sum += PFX##_min(h);                             \
+                PFX##_remove_min(h);                             \
+                                                                 \
+                if (!PFX##_empty(h))                             \
+                {                                                \
+                    sum += PFX##_max(h);                         \
+                    PFX##_remove_max(h);                         \
+                }                                                \
+            }                                                    \
+            cmc_timer_stop(timer);                               \
+            removal.result += timer.result;                      \
+        }                                                        \
+                                                                 \
+        report(NAME, size, &insert, &removal, sum);              \
+                                                                 \
+        PFX##_free(h);                                           \
+    } while (0)
+
+int main(void)
+{
+    size_t sizes[] = { 1000, 100000, TOTAL };
+    size_t n = sizeof(sizes) / sizeof(sizes[0]);
+
+    mt_state state;
+    twist_init(&state, 42);
+
+    for (size_t i = 0; i < TOTAL; i++)
+        keys[i] = twist_uint64(&state) % (TOTAL * 4);
+
+    printf("%-14s %10s %12s %12s %22s\n", "Heap", "Size", "Insert (ms)",
+           "Remove (ms)", "Sum");
+
+    for (size_t i = 0; i < n; i++)
+    {
+        BENCH_HEAP(h2, heap2, "Heap D=2", sizes[i]);
+        BENCH_HEAP(h4, heap4, "Heap D=4", sizes[i]);
+        BENCH_HEAP(h8, heap8, "Heap D=8", sizes[i]);
+        BENCH_INTERVALHEAP(ih2, intervalheap2, "IntervalHeap 2", sizes[i]);
+        BENCH_INTERVALHEAP(ih4, intervalheap4, "IntervalHeap 4", sizes[i]);
+        BENCH_INTERVALHEAP(ih8, intervalheap8, "IntervalHeap 8", sizes[i]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+/**
+ * lfstack.c
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/* Throughput of a Stack guarded by a mutex, of a LFStack and of a LFStack */
+/* used through magazines for different amounts of threads. Each thread does */
+/* a push followed by a pop, so the stack stays small and every operation */
+/* contends for its top. The time is measured with the wall clock since */
+/* cmc_timer gives the processor time of all threads. */
+
+#include "cmc/lfstack.h"
+#include "cmc/stack.h"
+#include "utl/futils.h"
+#include "utl/mutex.h"
+#include "utl/thread.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <time.h>
+
+#ifndef TOTAL
+#define TOTAL 4000000
+#endif
+
+#define MAX_THREADS 16
+
+CMC_GENERATE_STACK(s, stack, size_t)
+CMC_GENERATE_LFSTACK(lfs, lfstack, size_t)
+
+struct stack_fval *s_fval = &(struct stack_fval){ .cmp = cmc_size_cmp };
+struct lfstack_fval *lfs_fval = &(struct lfstack_fval){ .cmp = cmc_size_cmp };
+
+struct locked_stack
+{
+    struct stack *stack;
+    struct cmc_mutex mutex;
+};
+
+struct worker
+{
+    void *stack;
+    size_t count;
+    size_t sum;
+};
+
+double wall_ms(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+int locked_worker(void *args)
+{
+    struct worker *w = args;
+    struct locked_stack *ls = w->stack;
+
+    for (size_t i = 0; i < w->count; i++)
+    {
+        cmc_mtx_lock(&ls->mutex);
+        s_push(ls->stack, i);
+        cmc_mtx_unlock(&ls->mutex);
+
+        cmc_mtx_lock(&ls->mutex);
+        w->sum += s_top(ls->stack);
+        s_pop(ls->stack);
+        cmc_mtx_unlock(&ls->mutex);
+    }
+
+    return 0;
+}
+
+int lockfree_worker(void *args)
+{
+    struct worker *w = args;
+    size_t value;
+
+    for (size_t i = 0; i < w->count; i++)
+    {
+        lfs_push(w->stack, i);
+
+        if (lfs_pop(w->stack, &value))
+            w->sum += value;
+    }
+
+    return 0;
+}
+
+int magazine_worker(void *args)
+{
+    struct worker *w = args;
+    struct lfstack_magazine mag;
+    size_t value;
+
+    lfs_mag_init(&mag, w->stack);
+
+    for (size_t i = 0; i < w->count; i++)
+    {
+        lfs_mag_push(&mag, i);
+
+        if (lfs_mag_pop(&mag, &value))
+            w->sum += value;
+    }
+
+    lfs_mag_flush(&mag);
+
+    return 0;
+}
+
+/* Splits TOTAL push and pop pairs among the threads and returns the elapsed */
+/* time in milliseconds */
+double run(void *stack, size_t threads, cmc_thread_proc proc)
+{
+    struct cmc_thread t[MAX_THREADS];
+    struct worker w[MAX_THREADS];
+
+    double start = wall_ms();
+
+    for (size_t i = 0; i < threads; i++)
+    {
+        w[i] = (struct worker){ stack, TOTAL / threads, 0 };
+        cmc_thrd_create(&t[i], proc, &w[i]);
+    }
+
+    for (size_t i = 0; i < threads; i++)
+        cmc_thrd_join(&t[i], NULL);
+
+    return wall_ms() - start;
+}
+
+int main(void)
+{
+    size_t threads[] = { 1, 2, 4, 8, 16 };
+    size_t n = sizeof(threads) / sizeof(threads[0]);
+
+    printf("%7s %20s %20s %20s\n", "Threads", "Stack + mutex (ms)",
+           "LFStack (ms)", "Magazines (ms)");
+
+    for (size_t i = 0; i < n; i++)
+    {
+        struct locked_stack ls;
+        ls.stack = s_new(1024, s_fval);
+        cmc_mtx_init(&ls.mutex);
+
+        double locked = run(&ls, threads[i], locked_worker);
+
+        cmc_mtx_destroy(&ls.mutex);
+        s_free(ls.stack);
+
+        struct lfstack *stack = lfs_new(1024, lfs_fval);
+
+        double lockfree = run(stack, threads[i], lockfree_worker);
+        double magazine = run(stack, threads[i], magazine_worker);
+
+        lfs_free(stack);
+
+        printf("%7" PRIuMAX " %20.0lf %20.0lf %20.0lf\n", (uintmax_t)threads[i],
+               locked, lockfree, magazine);
+    }
+
+    return 0;
+}
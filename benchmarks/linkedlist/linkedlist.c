@@ -0,0 +1,71 @@
+/**
+ * linkedlist.c
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/* Comparing a LinkedList used as a work queue with and without a node pool */
+
+#include "cmc/linkedlist.h"
+#include "utl/futils.h"
+#include "utl/timer.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+#define ROUNDS 1000
+#define BATCH 10000
+
+CMC_GENERATE_LINKEDLIST(ll, linkedlist, size_t)
+
+struct linkedlist_fval *fval = &(struct linkedlist_fval){ .cmp = cmc_size_cmp };
+
+double run(size_t chunk_size, size_t *sum)
+{
+    struct linkedlist *ll = ll_new(fval);
+    struct cmc_timer timer;
+
+    ll_set_pool(ll, chunk_size);
+
+    cmc_timer_start(timer);
+
+    for (size_t r = 0; r < ROUNDS; r++)
+    {
+        for (size_t i = 0; i < BATCH; i++)
+            ll_push_back(ll, i);
+
+        /* Leaves some work items behind so that the list never empties */
+        for (size_t i = 0; i < BATCH - 1; i++)
+        {
+            *sum += ll_front(ll);
+            ll_pop_front(ll);
+        }
+    }
+
+    ll_free(ll);
+
+    cmc_timer_stop(timer);
+
+    return timer.result;
+}
+
+int main(void)
+{
+    size_t chunk_sizes[] = { 0, 64, 1024 };
+
+    printf("%-12s %12s %20s\n", "Chunk size", "Time (ms)", "Sum");
+
+    for (size_t i = 0; i < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); i++)
+    {
+        size_t sum = 0;
+        double result = run(chunk_sizes[i], &sum);
+
+        printf("%-12" PRIuMAX " %12.0lf %20" PRIuMAX "\n",
+               (uintmax_t)chunk_sizes[i], result, (uintmax_t)sum);
+    }
+
+    return 0;
+}
@@ -0,0 +1,201 @@
+/**
+ * mpmcqueue.c
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/* Throughput of a Queue guarded by a mutex and of a MPMCQueue for different */
+/* amounts of producer and consumer threads. The time is measured with the */
+/* wall clock since cmc_timer gives the processor time of all threads. */
+
+#include "cmc/mpmcqueue.h"
+#include "cmc/queue.h"
+#include "utl/futils.h"
+#include "utl/mutex.h"
+#include "utl/thread.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <time.h>
+
+#ifndef TOTAL
+#define TOTAL 4000000
+#endif
+
+#define CAPACITY 1024
+#define MAX_THREADS 16
+
+CMC_GENERATE_QUEUE(q, queue, size_t)
+CMC_GENERATE_MPMCQUEUE(mpq, mpmcqueue, size_t)
+
+struct queue_fval *q_fval = &(struct queue_fval){ .cmp = cmc_size_cmp };
+struct mpmcqueue_fval *mpq_fval =
+    &(struct mpmcqueue_fval){ .cmp = cmc_size_cmp };
+
+struct locked_queue
+{
+    struct queue *queue;
+    struct cmc_mutex mutex;
+};
+
+struct worker
+{
+    void *queue;
+    size_t count;
+    size_t sum;
+};
+
+double wall_ms(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+int locked_producer(void *args)
+{
+    struct worker *w = args;
+    struct locked_queue *lq = w->queue;
+
+    for (size_t i = 0; i < w->count;)
+    {
+        cmc_mtx_lock(&lq->mutex);
+
+        /* Keeps the queue bounded like the MPMCQueue */
+        if (!q_full(lq->queue))
+        {
+            q_enqueue(lq->queue, i);
+            i++;
+        }
+
+        cmc_mtx_unlock(&lq->mutex);
+    }
+
+    return 0;
+}
+
+int locked_consumer(void *args)
+{
+    struct worker *w = args;
+    struct locked_queue *lq = w->queue;
+
+    for (size_t i = 0; i < w->count;)
+    {
+        cmc_mtx_lock(&lq->mutex);
+
+        if (!q_empty(lq->queue))
+        {
+            w->sum += q_peek(lq->queue);
+            q_dequeue(lq->queue);
+            i++;
+        }
+
+        cmc_mtx_unlock(&lq->mutex);
+    }
+
+    return 0;
+}
+
+int mpmc_producer(void *args)
+{
+    struct worker *w = args;
+
+    for (size_t i = 0; i < w->count; i++)
+        mpq_enqueue(w->queue, i);
+
+    return 0;
+}
+
+int mpmc_consumer(void *args)
+{
+    struct worker *w = args;
+    size_t value;
+
+    for (size_t i = 0; i < w->count; i++)
+    {
+        mpq_dequeue(w->queue, &value);
+        w->sum += value;
+    }
+
+    return 0;
+}
+
+/* Splits TOTAL elements among the producers and among the consumers and */
+/* returns the elapsed time in milliseconds */
+double run(void *queue, size_t producers, size_t consumers,
+           cmc_thread_proc producer, cmc_thread_proc consumer)
+{
+    struct cmc_thread p[MAX_THREADS], c[MAX_THREADS];
+    struct worker pw[MAX_THREADS], cw[MAX_THREADS];
+
+    double start = wall_ms();
+
+    for (size_t i = 0; i < consumers; i++)
+    {
+        cw[i] = (struct worker){ queue, TOTAL / consumers, 0 };
+        cmc_thrd_create(&c[i], consumer, &cw[i]);
+    }
+
+    for (size_t i = 0; i < producers; i++)
+    {
+        pw[i] = (struct worker){ queue, TOTAL / producers, 0 };
+        cmc_thrd_create(&p[i], producer, &pw[i]);
+    }
+
+    for (size_t i = 0; i < producers; i++)
+        cmc_thrd_join(&p[i], NULL);
+
+    for (size_t i = 0; i < consumers; i++)
+        cmc_thrd_join(&c[i], NULL);
+
+    return wall_ms() - start;
+}
+
+int main(void)
+{
+    size_t threads[] = { 1, 2, 4, 8, 16 };
+    size_t n = sizeof(threads) / sizeof(threads[0]);
+
+    printf("%9s %9s %20s %20s\n", "Producers", "Consumers",
+           "Queue + mutex (ms)", "MPMCQueue (ms)");
+
+    for (size_t i = 0; i < n; i++)
+    {
+        for (size_t j = 0; j < n; j++)
+        {
+            size_t producers = threads[i];
+            size_t consumers = threads[j];
+
+            /* Every producer and consumer moves the same amount */
+            if (TOTAL % producers != 0 || TOTAL % consumers != 0)
+                continue;
+
+            struct locked_queue lq;
+            lq.queue = q_new(CAPACITY, q_fval);
+            cmc_mtx_init(&lq.mutex);
+
+            double locked = run(&lq, producers, consumers, locked_producer,
+                                locked_consumer);
+
+            cmc_mtx_destroy(&lq.mutex);
+            q_free(lq.queue);
+
+            struct mpmcqueue *queue = mpq_new(CAPACITY, mpq_fval);
+
+            double lockfree =
+                run(queue, producers, consumers, mpmc_producer, mpmc_consumer);
+
+            mpq_free(queue);
+
+            printf("%9" PRIuMAX " %9" PRIuMAX " %20.0lf %20.0lf\n",
+                   (uintmax_t)producers, (uintmax_t)consumers, locked,
+                   lockfree);
+        }
+    }
+
+    return 0;
+}
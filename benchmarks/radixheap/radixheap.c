@@ -0,0 +1,133 @@
+/**
+ * radixheap.c
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/* Comparing the RadixHeap with the Heap on a monotone workload, like the */
+/* one of an event simulation. The queue starts with SIZE events and then */
+/* TOTAL times the earliest event is taken out and another one is scheduled */
+/* a random delay after it, so the queue keeps the same size. */
+
+#include "../util/twister.c"
+#include "cmc/heap.h"
+#include "cmc/radixheap.h"
+#include "utl/timer.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+#ifndef TOTAL
+#define TOTAL 10000000
+#endif
+
+/* Maximum delay between an event and the one it schedules */
+#define DELAY 1000
+
+struct event
+{
+    uint64_t time;
+    size_t id;
+};
+
+int event_cmp(struct event a, struct event b)
+{
+    return (a.time > b.time) - (a.time < b.time);
+}
+
+CMC_GENERATE_HEAP(h2, heap2, struct event)
+CMC_GENERATE_HEAP_DARY(h4, heap4, struct event, 4)
+CMC_GENERATE_RADIXHEAP(rh, radixheap, uint64_t, size_t)
+
+uint64_t delays[TOTAL];
+
+void report(const char *name, size_t size, struct cmc_timer *timer,
+            uint64_t sum)
+{
+    printf("%-14s %10" PRIuMAX " %12.0lf %22" PRIuMAX "\n", name,
+           (uintmax_t)size, timer->result, (uintmax_t)sum);
+}
+
+/* Times a heap of events, which is a MinHeap by their time */
+#define BENCH_HEAP(PFX, SNAME, NAME, SIZE)                      \
+    do                                                          \
+    {                                                           \
+        size_t size = SIZE;                                     \
+        struct SNAME##_fval fval = { .cmp = event_cmp };        \
+        struct SNAME *h = PFX##_new(size, cmc_min_heap, &fval); \
+        struct cmc_timer timer;                                 \
+        uint64_t sum = 0;                                       \
+                                                                \
+        for (size_t k = 0; k < size; k++)                       \
+            PFX##_insert(h, (struct event){ delays[k], k });    \
+                                                                \
+        cmc_timer_start(timer);                                 \
+        for (size_t k = 0; k < TOTAL; k++)                      \
+        {                                                       \
+            struct event e = PFX##_peek(h);                     \
+            PFX##_remove(h);                                    \
+            sum += e.time;                                      \
+            e.time += delays[k];                                \
+            PFX##_insert(h, e);                                 \
+        }                                                       \
+        cmc_timer_stop(timer);                                  \
+                                                                \
+        report(NAME, size, &timer, sum);                        \
+                                                                \
+        PFX##_free(h);                                          \
+    } while (0)
+
+/* Same as above with the time as the key and the id as the value */
+#define BENCH_RADIXHEAP(PFX, SNAME, NAME, SIZE)  \
+    do                                           \
+    {                                            \
+        size_t size = SIZE;                      \
+        struct SNAME##_fval fval = { 0 };        \
+        struct SNAME *h = PFX##_new(&fval);      \
+        struct cmc_timer timer;                  \
+        uint64_t sum = 0;                        \
+                                                 \
+        for (size_t k = 0; k < size; k++)        \
+            PFX##_push(h, delays[k], k);         \
+                                                 \
+        cmc_timer_start(timer);                  \
+        for (size_t k = 0; k < TOTAL; k++)       \
+        {                                        \
+            uint64_t time;                       \
+            size_t id;                           \
+            PFX##_pop_min(h, &time, &id);        \
+            sum += time;                         \
+            PFX##_push(h, time + delays[k], id); \
+        }                                        \
+        cmc_timer_stop(timer);                   \
+                                                 \
+        report(NAME, size, &timer, sum);         \
+                                                 \
+        PFX##_free(h);                           \
+    } while (0)
+
+int main(void)
+{
+    size_t sizes[] = { 1000, 100000, 1000000 };
+    size_t n = sizeof(sizes) / sizeof(sizes[0]);
+
+    mt_state state;
+    twist_init(&state, 42);
+
+    for (size_t i = 0; i < TOTAL; i++)
+        delays[i] = twist_uint64(&state) % DELAY + 1;
+
+    printf("%-14s %10s %12s %22s\n", "Queue", "Size", "Time (ms)", "Sum");
+
+    for (size_t i = 0; i < n; i++)
+    {
+        BENCH_HEAP(h2, heap2, "Heap D=2", sizes[i]);
+        BENCH_HEAP(h4, heap4, "Heap D=4", sizes[i]);
+        BENCH_RADIXHEAP(rh, radixheap, "RadixHeap", sizes[i]);
+    }
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+/**
+ * segdeque.c
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/* Comparing the growth of a Deque and a SegDeque. The pushes are timed in */
+/* batches and the slowest batch shows how long the deque stalls to grow. */
+
+#include "cmc/deque.h"
+#include "cmc/segdeque.h"
+#include "utl/futils.h"
+#include "utl/timer.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+#define TOTAL 20000000
+#define BATCH 65536
+
+CMC_GENERATE_DEQUE(d, deque, size_t)
+CMC_GENERATE_SEGDEQUE(sd, segdeque, size_t)
+
+struct deque_fval *d_fval = &(struct deque_fval){ .cmp = cmc_size_cmp };
+struct segdeque_fval *sd_fval = &(struct segdeque_fval){ .cmp = cmc_size_cmp };
+
+int main(void)
+{
+    struct cmc_timer timer;
+    struct cmc_timer batch;
+    double slowest;
+
+    printf("%-10s %12s %20s %12s\n", "Collection", "Total (ms)",
+           "Slowest batch (ms)", "Iterate (ms)");
+
+    struct deque *d = d_new(16, d_fval);
+
+    slowest = 0;
+    cmc_timer_start(timer);
+
+    for (size_t i = 0; i < TOTAL; i += BATCH)
+    {
+        cmc_timer_start(batch);
+
+        for (size_t j = i; j < i + BATCH && j < TOTAL; j++)
+            d_push_back(d, j);
+
+        cmc_timer_stop(batch);
+
+        if (batch.result > slowest)
+            slowest = batch.result;
+    }
+
+    cmc_timer_stop(timer);
+
+    double total = timer.result;
+    size_t sum = 0;
+
+    cmc_timer_start(timer);
+
+    struct deque_iter d_it;
+    for (d_it = d_iter_start(d); !d_iter_at_end(&d_it); d_iter_next(&d_it))
+        sum += d_iter_value(&d_it);
+
+    cmc_timer_stop(timer);
+
+    printf("%-10s %12.0lf %20.0lf %12.0lf\n", "Deque", total, slowest,
+           timer.result);
+
+    d_free(d);
+
+    struct segdeque *sd = sd_new(16, sd_fval);
+
+    slowest = 0;
+    cmc_timer_start(timer);
+
+    for (size_t i = 0; i < TOTAL; i += BATCH)
+    {
+        cmc_timer_start(batch);
+
+        for (size_t j = i; j < i + BATCH && j < TOTAL; j++)
+            sd_push_back(sd, j);
+
+        cmc_timer_stop(batch);
+
+        if (batch.result > slowest)
+            slowest = batch.result;
+    }
+
+    cmc_timer_stop(timer);
+
+    total = timer.result;
+
+    cmc_timer_start(timer);
+
+    struct segdeque_iter sd_it;
+    for (sd_it = sd_iter_start(sd); !sd_iter_at_end(&sd_it);
+         sd_iter_next(&sd_it))
+        sum += sd_iter_value(&sd_it);
+
+    cmc_timer_stop(timer);
+
+    printf("%-10s %12.0lf %20.0lf %12.0lf\n", "SegDeque", total, slowest,
+           timer.result);
+
+    sd_free(sd);
+
+    printf("\nSum: %" PRIuMAX "\n", (uintmax_t)sum);
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * sort.c
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/* Comparing List's sort (pattern-defeating quicksort) and a List generated */
+/* with a radix sort against qsort */
+
+#include "../util/twister.c"
+#include "cmc/list.h"
+#include "utl/futils.h"
+#include "utl/timer.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+#define MAX 1000000
+
+CMC_GENERATE_LIST(l, list, size_t)
+CMC_GENERATE_LIST_RADIX(rl, radix_list, size_t, uint64_t, cmc_size_key)
+
+struct list_fval *fval = &(struct list_fval){ .cmp = cmc_size_cmp };
+struct radix_list_fval *rfval =
+    &(struct radix_list_fval){ .cmp = cmc_size_cmp };
+
+size_t values[MAX];
+
+int qsort_cmp(const void *a, const void *b)
+{
+    return cmc_size_cmp(*(const size_t *)a, *(const size_t *)b);
+}
+
+void fill(const char *pattern, mt_state *state)
+{
+    for (size_t i = 0; i < MAX; i++)
+    {
+        if (strcmp(pattern, "Random") == 0)
+            values[i] = twist_uint64(state);
+        else if (strcmp(pattern, "Timestamps") == 0)
+            values[i] = UINT64_C(1600000000000) + twist_uint64(state) % MAX;
+        else if (strcmp(pattern, "Sorted") == 0)
+            values[i] = i;
+        else if (strcmp(pattern, "Reversed") == 0)
+            values[i] = MAX - i;
+        else if (strcmp(pattern, "Sawtooth") == 0)
+            values[i] = i % 1000;
+        else if (strcmp(pattern, "All equal") == 0)
+            values[i] = 42;
+        else if (strcmp(pattern, "Organ pipe") == 0)
+            values[i] = i < MAX / 2 ? i : MAX - i;
+    }
+}
+
+int main(void)
+{
+    const char *patterns[] = { "Random",    "Timestamps", "Sorted",
+                               "Reversed",  "Sawtooth",   "All equal",
+                               "Organ pipe" };
+
+    mt_state state;
+    twist_init(&state, 42);
+
+    struct list *l = l_new(MAX, fval);
+    struct radix_list *rl = rl_new(MAX, rfval);
+    struct cmc_timer timer;
+
+    printf("%-12s %12s %12s %12s\n", "Pattern", "l_sort", "rl_sort", "qsort");
+
+    for (size_t p = 0; p < sizeof(patterns) / sizeof(patterns[0]); p++)
+    {
+        double result, radix_result;
+
+        fill(patterns[p], &state);
+        l_clear(l);
+        l_seq_push_back(l, values, MAX);
+
+        cmc_timer_start(timer);
+        l_sort(l);
+        cmc_timer_stop(timer);
+        result = timer.result;
+
+        fill(patterns[p], &state);
+        rl_clear(rl);
+        rl_seq_push_back(rl, values, MAX);
+
+        cmc_timer_start(timer);
+        rl_sort(rl);
+        cmc_timer_stop(timer);
+        radix_result = timer.result;
+
+        fill(patterns[p], &state);
+
+        cmc_timer_start(timer);
+        qsort(values, MAX, sizeof(size_t), qsort_cmp);
+        cmc_timer_stop(timer);
+
+        printf("%-12s %9.0lf ms %9.0lf ms %9.0lf ms\n", patterns[p], result,
+               radix_result, timer.result);
+    }
+
+    l_free(l);
+    rl_free(rl);
+
+    return 0;
+}
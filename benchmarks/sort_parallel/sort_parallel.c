@@ -0,0 +1,77 @@
+/**
+ * sort_parallel.c
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/* How List's parallel sort scales with the amount of threads */
+
+#include "../util/twister.c"
+#include "cmc/list.h"
+#include "utl/condvar.h"
+#include "utl/futils.h"
+#include "utl/thread.h"
+#include "utl/timer.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+#define MAX 10000000
+
+CMC_GENERATE_LIST(l, list, size_t)
+CMC_GENERATE_LIST_PARALLEL(l, list, size_t)
+
+CMC_GENERATE_LIST_RADIX(rl, radix_list, size_t, uint64_t, cmc_size_key)
+CMC_GENERATE_LIST_PARALLEL(rl, radix_list, size_t)
+
+struct list_fval *fval = &(struct list_fval){ .cmp = cmc_size_cmp };
+struct radix_list_fval *rfval =
+    &(struct radix_list_fval){ .cmp = cmc_size_cmp };
+
+size_t values[MAX];
+
+int main(void)
+{
+    mt_state state;
+    twist_init(&state, 42);
+
+    for (size_t i = 0; i < MAX; i++)
+        values[i] = twist_uint64(&state);
+
+    struct list *l = l_new(MAX, fval);
+    struct radix_list *rl = rl_new(MAX, rfval);
+    struct cmc_timer timer;
+
+    printf("%-8s %12s %12s\n", "Threads", "l_sort", "rl_sort");
+
+    for (size_t threads = 1; threads <= 64; threads *= 2)
+    {
+        double result;
+
+        l_clear(l);
+        l_seq_push_back(l, values, MAX);
+
+        cmc_timer_start(timer);
+        l_sort_parallel(l, threads);
+        cmc_timer_stop(timer);
+        result = timer.result;
+
+        rl_clear(rl);
+        rl_seq_push_back(rl, values, MAX);
+
+        cmc_timer_start(timer);
+        rl_sort_parallel(rl, threads);
+        cmc_timer_stop(timer);
+
+        printf("%-8" PRIuMAX " %9.0lf ms %9.0lf ms\n", (uintmax_t)threads,
+               result, timer.result);
+    }
+
+    l_free(l);
+    rl_free(rl);
+
+    return 0;
+}
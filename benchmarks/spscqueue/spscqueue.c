@@ -0,0 +1,219 @@
+/**
+ * spscqueue.c
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/* Throughput of passing elements from one thread to another through a Queue */
+/* guarded by a mutex and through a SPSCQueue, one element at a time and in */
+/* batches. The time is measured with the wall clock since cmc_timer gives the
+ */
+/* processor time of both threads. */
+
+#include "cmc/queue.h"
+#include "cmc/spscqueue.h"
+#include "utl/futils.h"
+#include "utl/mutex.h"
+#include "utl/thread.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <time.h>
+
+#ifndef TOTAL
+#define TOTAL 10000000
+#endif
+
+#define CAPACITY 1024
+#define BATCH 64
+
+CMC_GENERATE_QUEUE(q, queue, size_t)
+CMC_GENERATE_SPSCQUEUE(spq, spscqueue, size_t)
+
+struct queue_fval *q_fval = &(struct queue_fval){ .cmp = cmc_size_cmp };
+struct spscqueue_fval *spq_fval =
+    &(struct spscqueue_fval){ .cmp = cmc_size_cmp };
+
+struct locked_queue
+{
+    struct queue *queue;
+    struct cmc_mutex mutex;
+};
+
+/* Sum of the elements received by the consumer */
+size_t received;
+
+double wall_ms(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+int locked_producer(void *args)
+{
+    struct locked_queue *lq = args;
+
+    for (size_t i = 0; i < TOTAL;)
+    {
+        cmc_mtx_lock(&lq->mutex);
+
+        /* Keeps the queue bounded like the SPSCQueue */
+        if (!q_full(lq->queue))
+        {
+            q_enqueue(lq->queue, i);
+            i++;
+        }
+
+        cmc_mtx_unlock(&lq->mutex);
+    }
+
+    return 0;
+}
+
+int locked_consumer(void *args)
+{
+    struct locked_queue *lq = args;
+    size_t sum = 0;
+
+    for (size_t i = 0; i < TOTAL;)
+    {
+        cmc_mtx_lock(&lq->mutex);
+
+        if (!q_empty(lq->queue))
+        {
+            sum += q_peek(lq->queue);
+            q_dequeue(lq->queue);
+            i++;
+        }
+
+        cmc_mtx_unlock(&lq->mutex);
+    }
+
+    received = sum;
+
+    return 0;
+}
+
+int spsc_producer(void *args)
+{
+    struct spscqueue *queue = args;
+
+    for (size_t i = 0; i < TOTAL;)
+    {
+        if (spq_try_enqueue(queue, i))
+            i++;
+    }
+
+    return 0;
+}
+
+int spsc_consumer(void *args)
+{
+    struct spscqueue *queue = args;
+    size_t sum = 0;
+    size_t value;
+
+    for (size_t i = 0; i < TOTAL;)
+    {
+        if (spq_try_dequeue(queue, &value))
+        {
+            sum += value;
+            i++;
+        }
+    }
+
+    received = sum;
+
+    return 0;
+}
+
+int spsc_producer_n(void *args)
+{
+    struct spscqueue *queue = args;
+    size_t batch[BATCH];
+
+    for (size_t i = 0; i < TOTAL;)
+    {
+        size_t n = TOTAL - i < BATCH ? TOTAL - i : BATCH;
+
+        for (size_t j = 0; j < n; j++)
+            batch[j] = i + j;
+
+        for (size_t sent = 0; sent < n;)
+            sent += spq_try_enqueue_n(queue, batch + sent, n - sent);
+
+        i += n;
+    }
+
+    return 0;
+}
+
+int spsc_consumer_n(void *args)
+{
+    struct spscqueue *queue = args;
+    size_t batch[BATCH];
+    size_t sum = 0;
+
+    for (size_t i = 0; i < TOTAL;)
+    {
+        size_t n = spq_try_dequeue_n(queue, batch, BATCH);
+
+        for (size_t j = 0; j < n; j++)
+            sum += batch[j];
+
+        i += n;
+    }
+
+    received = sum;
+
+    return 0;
+}
+
+void run(const char *name, cmc_thread_proc producer, cmc_thread_proc consumer,
+         void *args)
+{
+    struct cmc_thread p, c;
+
+    received = 0;
+
+    double start = wall_ms();
+
+    cmc_thrd_create(&c, consumer, args);
+    cmc_thrd_create(&p, producer, args);
+
+    cmc_thrd_join(&p, NULL);
+    cmc_thrd_join(&c, NULL);
+
+    double total = wall_ms() - start;
+
+    printf("%-20s %12.0lf %16.1lf %s\n", name, total, TOTAL / total / 1000.0,
+           received == (size_t)TOTAL * (TOTAL - 1) / 2 ? "" : "(wrong sum)");
+}
+
+int main(void)
+{
+    printf("%-20s %12s %16s\n", "Queue", "Total (ms)", "Millions per sec");
+
+    struct locked_queue lq;
+    lq.queue = q_new(CAPACITY, q_fval);
+    cmc_mtx_init(&lq.mutex);
+
+    run("Queue + mutex", locked_producer, locked_consumer, &lq);
+
+    cmc_mtx_destroy(&lq.mutex);
+    q_free(lq.queue);
+
+    struct spscqueue *queue = spq_new(CAPACITY, spq_fval);
+
+    run("SPSCQueue", spsc_producer, spsc_consumer, queue);
+    run("SPSCQueue (batch)", spsc_producer_n, spsc_consumer_n, queue);
+
+    spq_free(queue);
+
+    return 0;
+}
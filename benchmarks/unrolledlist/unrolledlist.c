@@ -0,0 +1,131 @@
+/**
+ * unrolledlist.c
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/* Comparing the iteration of a List, a LinkedList and an UnrolledList and */
+/* inserting in the middle of the LinkedList and the UnrolledList */
+
+#include "cmc/linkedlist.h"
+#include "cmc/list.h"
+#include "cmc/unrolledlist.h"
+#include "utl/futils.h"
+#include "utl/timer.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+#define TOTAL 1000000
+#define ROUNDS 100
+#define INSERTS 100000
+
+CMC_GENERATE_LIST(l, list, size_t)
+CMC_GENERATE_LINKEDLIST(ll, linkedlist, size_t)
+CMC_GENERATE_UNROLLEDLIST(ul, unrolledlist, size_t)
+
+struct list_fval *l_fval = &(struct list_fval){ .cmp = cmc_size_cmp };
+struct linkedlist_fval *ll_fval =
+    &(struct linkedlist_fval){ .cmp = cmc_size_cmp };
+struct unrolledlist_fval *ul_fval =
+    &(struct unrolledlist_fval){ .cmp = cmc_size_cmp };
+
+int main(void)
+{
+    struct list *l = l_new(TOTAL, l_fval);
+    struct linkedlist *ll = ll_new(ll_fval);
+    struct unrolledlist *ul = ul_new(ul_fval);
+    struct cmc_timer timer;
+
+    for (size_t i = 0; i < TOTAL; i++)
+    {
+        l_push_back(l, i);
+        ll_push_back(ll, i);
+        ul_push_back(ul, i);
+    }
+
+    printf("%-14s %14s %14s\n", "Collection", "Iterate (ms)", "Insert (ms)");
+
+    size_t sum = 0;
+
+    cmc_timer_start(timer);
+
+    for (size_t r = 0; r < ROUNDS; r++)
+    {
+        struct list_iter it;
+        for (it = l_iter_start(l); !l_iter_at_end(&it); l_iter_next(&it))
+            sum += l_iter_value(&it);
+    }
+
+    cmc_timer_stop(timer);
+
+    printf("%-14s %14.0lf %14s\n", "List", timer.result, "-");
+
+    cmc_timer_start(timer);
+
+    for (size_t r = 0; r < ROUNDS; r++)
+    {
+        struct linkedlist_iter it;
+        for (it = ll_iter_start(ll); !ll_iter_at_end(&it); ll_iter_next(&it))
+            sum += ll_iter_value(&it);
+    }
+
+    cmc_timer_stop(timer);
+
+    double iterate = timer.result;
+
+    /* Inserts after the cursor, which is kept in the middle of the list */
+    struct linkedlist_iter ll_it = ll_iter_start(ll);
+    ll_iter_go_to(&ll_it, TOTAL / 2);
+
+    cmc_timer_start(timer);
+
+    for (size_t i = 0; i < INSERTS; i++)
+    {
+        ll_add_next(ll, ll_it.cursor, i);
+        ll_iter_next(&ll_it);
+    }
+
+    cmc_timer_stop(timer);
+
+    printf("%-14s %14.0lf %14.0lf\n", "LinkedList", iterate, timer.result);
+
+    cmc_timer_start(timer);
+
+    for (size_t r = 0; r < ROUNDS; r++)
+    {
+        struct unrolledlist_iter it;
+        for (it = ul_iter_start(ul); !ul_iter_at_end(&it); ul_iter_next(&it))
+            sum += ul_iter_value(&it);
+    }
+
+    cmc_timer_stop(timer);
+
+    iterate = timer.result;
+
+    struct unrolledlist_iter ul_it = ul_iter_start(ul);
+    ul_iter_go_to(&ul_it, TOTAL / 2);
+
+    cmc_timer_start(timer);
+
+    for (size_t i = 0; i < INSERTS; i++)
+    {
+        ul_iter_add_next(&ul_it, i);
+        ul_iter_next(&ul_it);
+    }
+
+    cmc_timer_stop(timer);
+
+    printf("%-14s %14.0lf %14.0lf\n", "UnrolledList", iterate, timer.result);
+
+    printf("\nSum: %" PRIuMAX "\n", (uintmax_t)sum);
+
+    l_free(l);
+    ll_free(ll);
+    ul_free(ul);
+
+    return 0;
+}
@@ -0,0 +1,1357 @@
+/**
+ * btreemap.h
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * BTreeMap
+ *
+ * A BTreeMap is an implementation of a Map that keeps its keys sorted. Like a
+ * Map, it has only unique keys. This implementation uses a B+ Tree where each
+ * node stores many keys contiguously, making the tree much shallower than a
+ * binary tree and reducing the amount of cache misses per look up. All values
+ * are stored in the leaf nodes, which are linked together for fast sequential
+ * iteration. The amount of keys per node can be tuned by CMC_BTREE_ORDER.
+ */
+
+#ifndef CMC_BTREEMAP_H
+#define CMC_BTREEMAP_H
+
+/* -------------------------------------------------------------------------
+ * Core functionalities of the C Macro Collections Library
+ * ------------------------------------------------------------------------- */
+#include "../cor/btree.h"
+#include "../cor/core.h"
+
+/* -------------------------------------------------------------------------
+ * BTreeMap specific
+ * ------------------------------------------------------------------------- */
+/* to_string format */
+static const char *cmc_string_fmt_btreemap = "struct %s<%s, %s> "
+                                             "at %p { "
+                                             "root:%p, "
+                                             "head:%p, "
+                                             "tail:%p, "
+                                             "count:%" PRIuMAX ", "
+                                             "flag:%d, "
+                                             "f_key:%p, "
+                                             "f_val:%p, "
+                                             "alloc:%p, "
+                                             "callbacks:%p }";
+
+#define CMC_GENERATE_BTREEMAP(PFX, SNAME, K, V)    \
+    CMC_GENERATE_BTREEMAP_HEADER(PFX, SNAME, K, V) \
+    CMC_GENERATE_BTREEMAP_SOURCE(PFX, SNAME, K, V)
+
+#define CMC_WRAPGEN_BTREEMAP_HEADER(PFX, SNAME, K, V) \
+    CMC_GENERATE_BTREEMAP_HEADER(PFX, SNAME, K, V)
+
+#define CMC_WRAPGEN_BTREEMAP_SOURCE(PFX, SNAME, K, V) \
+    CMC_GENERATE_BTREEMAP_SOURCE(PFX, SNAME, K, V)
+
+/* -------------------------------------------------------------------------
+ * Header
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_BTREEMAP_HEADER(PFX, SNAME, K, V)                        \
+                                                                              \
+    /* BTreeMap Structure */                                                  \
+    struct SNAME                                                              \
+    {                                                                         \
+        /* Root node */                                                       \
+        struct SNAME##_node *root;                                            \
+                                                                              \
+        /* Leftmost leaf node, holding the smallest keys */                   \
+        struct SNAME##_leaf *head;                                            \
+                                                                              \
+        /* Rightmost leaf node, holding the greatest keys */                  \
+        struct SNAME##_leaf *tail;                                            \
+                                                                              \
+        /* Current amount of keys */                                          \
+        size_t count;                                                         \
+                                                                              \
+        /* Flags indicating errors or success */                              \
+        int flag;                                                             \
+                                                                              \
+        /* Key function table */                                              \
+        struct SNAME##_fkey *f_key;                                           \
+                                                                              \
+        /* Value function table */                                            \
+        struct SNAME##_fval *f_val;                                           \
+                                                                              \
+        /* Custom allocation functions */                                     \
+        struct cmc_alloc_node *alloc;                                         \
+                                                                              \
+        /* Custom callback functions */                                       \
+        struct cmc_callbacks *callbacks;                                      \
+    };                                                                        \
+                                                                              \
+    /* BTreeMap Node */                                                       \
+    /* Common part of leaf and inner nodes */                                 \
+    struct SNAME##_node                                                       \
+    {                                                                         \
+        /* Amount of keys currently stored in this node */                    \
+        size_t length;                                                        \
+                                                                              \
+        /* If this node is a leaf node or an inner node */                    \
+        bool leaf;                                                            \
+                                                                              \
+        /* Keys sorted in ascending order and stored contiguously */          \
+        K keys[CMC_BTREE_MAX_KEYS];                                           \
+    };                                                                        \
+                                                                              \
+    /* BTreeMap Leaf Node */                                                  \
+    struct SNAME##_leaf                                                       \
+    {                                                                         \
+        /* Common node part, must be the first member */                      \
+        struct SNAME##_node node;                                             \
+                                                                              \
+        /* Values associated with each key */                                 \
+        V values[CMC_BTREE_MAX_KEYS];                                         \
+                                                                              \
+        /* Previous leaf node in key order */                                 \
+        struct SNAME##_leaf *prev;                                            \
+                                                                              \
+        /* Next leaf node in key order */                                     \
+        struct SNAME##_leaf *next;                                            \
+    };                                                                        \
+                                                                              \
+    /* BTreeMap Inner Node */                                                 \
+    struct SNAME##_inner                                                      \
+    {                                                                         \
+        /* Common node part, must be the first member */                      \
+        struct SNAME##_node node;                                             \
+                                                                              \
+        /* Child subtrees. Keys in children[i] are less than keys[i] and */   \
+        /* keys in children[i + 1] are greater than or equal to keys[i] */    \
+        struct SNAME##_node *children[CMC_BTREE_MAX_KEYS + 1];                \
+    };                                                                        \
+                                                                              \
+    /* Key struct function table */                                           \
+    struct SNAME##_fkey                                                       \
+    {                                                                         \
+        /* Comparator function */                                             \
+        int (*cmp)(K, K);                                                     \
+                                                                              \
+        /* Copy function */                                                   \
+        K (*cpy)(K);                                                          \
+                                                                              \
+        /* To string function */                                              \
+        bool (*str)(FILE *, K);                                               \
+                                                                              \
+        /* Free from memory function */                                       \
+        void (*free)(K);                                                      \
+                                                                              \
+        /* Hash function */                                                   \
+        size_t (*hash)(K);                                                    \
+                                                                              \
+        /* Priority function */                                               \
+        int (*pri)(K, K);                                                     \
+    };                                                                        \
+                                                                              \
+    /* Value struct function table */                                         \
+    struct SNAME##_fval                                                       \
+    {                                                                         \
+        /* Comparator function */                                             \
+        int (*cmp)(V, V);                                                     \
+                                                                              \
+        /* Copy function */                                                   \
+        V (*cpy)(V);                                                          \
+                                                                              \
+        /* To string function */                                              \
+        bool (*str)(FILE *, V);                                               \
+                                                                              \
+        /* Free from memory function */                                       \
+        void (*free)(V);                                                      \
+                                                                              \
+        /* Hash function */                                                   \
+        size_t (*hash)(V);                                                    \
+                                                                              \
+        /* Priority function */                                               \
+        int (*pri)(V, V);                                                     \
+    };                                                                        \
+                                                                              \
+    /* BTreeMap Iterator */                                                   \
+    struct SNAME##_iter                                                       \
+    {                                                                         \
+        /* Target btreemap */                                                 \
+        struct SNAME *target;                                                 \
+                                                                              \
+        /* Leaf node where the cursor is currently at */                      \
+        struct SNAME##_leaf *cursor;                                          \
+                                                                              \
+        /* Position of the cursor inside its leaf node */                     \
+        size_t position;                                                      \
+                                                                              \
+        /* Keeps track of relative index to the iteration of elements */      \
+        size_t index;                                                         \
+                                                                              \
+        /* If the iterator has reached the start of the iteration */          \
+        bool start;                                                           \
+                                                                              \
+        /* If the iterator has reached the end of the iteration */            \
+        bool end;                                                             \
+    };                                                                        \
+                                                                              \
+    /* Collection Functions */                                                \
+    /* Collection Allocation and Deallocation */                              \
+    struct SNAME *PFX##_new(struct SNAME##_fkey *f_key,                       \
+                            struct SNAME##_fval *f_val);                      \
+    struct SNAME *PFX##_new_custom(                                           \
+        struct SNAME##_fkey *f_key, struct SNAME##_fval *f_val,               \
+        struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks);       \
+    void PFX##_clear(struct SNAME *_map_);                                    \
+    void PFX##_free(struct SNAME *_map_);                                     \
+    /* Customization of Allocation and Callbacks */                           \
+    void PFX##_customize(struct SNAME *_map_, struct cmc_alloc_node *alloc,   \
+                         struct cmc_callbacks *callbacks);                    \
+    /* Collection Input and Output */                                         \
+    bool PFX##_insert(struct SNAME *_map_, K key, V value);                   \
+    bool PFX##_update(struct SNAME *_map_, K key, V new_value, V *old_value); \
+    bool PFX##_remove(struct SNAME *_map_, K key, V *out_value);              \
+    /* Element Access */                                                      \
+    bool PFX##_max(struct SNAME *_map_, K *key, V *value);                    \
+    bool PFX##_min(struct SNAME *_map_, K *key, V *value);                    \
+    V PFX##_get(struct SNAME *_map_, K key);                                  \
+    V *PFX##_get_ref(struct SNAME *_map_, K key);                             \
+    /* Collection State */                                                    \
+    bool PFX##_contains(struct SNAME *_map_, K key);                          \
+    bool PFX##_empty(struct SNAME *_map_);                                    \
+    size_t PFX##_count(struct SNAME *_map_);                                  \
+    int PFX##_flag(struct SNAME *_map_);                                      \
+    /* Collection Utility */                                                  \
+    struct SNAME *PFX##_copy_of(struct SNAME *_map_);                         \
+    bool PFX##_equals(struct SNAME *_map1_, struct SNAME *_map2_);            \
+    struct cmc_string PFX##_to_string(struct SNAME *_map_);                   \
+    bool PFX##_print(struct SNAME *_map_, FILE *fptr);                        \
+                                                                              \
+    /* Iterator Functions */                                                  \
+    /* Iterator Initialization */                                             \
+    struct SNAME##_iter PFX##_iter_start(struct SNAME *target);               \
+    struct SNAME##_iter PFX##_iter_end(struct SNAME *target);                 \
+    /* Iterator State */                                                      \
+    bool PFX##_iter_at_start(struct SNAME##_iter *iter);                      \
+    bool PFX##_iter_at_end(struct SNAME##_iter *iter);                        \
+    /* Iterator Movement */                                                   \
+    bool PFX##_iter_to_start(struct SNAME##_iter *iter);                      \
+    bool PFX##_iter_to_end(struct SNAME##_iter *iter);                        \
+    bool PFX##_iter_next(struct SNAME##_iter *iter);                          \
+    bool PFX##_iter_prev(struct SNAME##_iter *iter);                          \
+    bool PFX##_iter_advance(struct SNAME##_iter *iter, size_t steps);         \
+    bool PFX##_iter_rewind(struct SNAME##_iter *iter, size_t steps);          \
+    bool PFX##_iter_go_to(struct SNAME##_iter *iter, size_t index);           \
+    /* Iterator Access */                                                     \
+    K PFX##_iter_key(struct SNAME##_iter *iter);                              \
+    V PFX##_iter_value(struct SNAME##_iter *iter);                            \
+    V *PFX##_iter_rvalue(struct SNAME##_iter *iter);                          \
+    size_t PFX##_iter_index(struct SNAME##_iter *iter);
+
+/* -------------------------------------------------------------------------
+ * Source
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_BTREEMAP_SOURCE(PFX, SNAME, K, V)                         \
+                                                                               \
+    /* Implementation Detail Functions */                                      \
+    static struct SNAME##_leaf *PFX##_impl_new_leaf(struct SNAME *_map_);      \
+    static struct SNAME##_inner *PFX##_impl_new_inner(struct SNAME *_map_);    \
+    static void PFX##_impl_free_node(struct SNAME *_map_,                      \
+                                     struct SNAME##_node *node);               \
+    static size_t PFX##_impl_lower(struct SNAME *_map_,                        \
+                                   struct SNAME##_node *node, K key);          \
+    static size_t PFX##_impl_upper(struct SNAME *_map_,                        \
+                                   struct SNAME##_node *node, K key);          \
+    static struct SNAME##_leaf *PFX##_impl_get_leaf(struct SNAME *_map_,       \
+                                                    K key, size_t *index);     \
+    static bool PFX##_impl_split_child(                                        \
+        struct SNAME *_map_, struct SNAME##_inner *parent, size_t index);      \
+    static size_t PFX##_impl_fill_child(                                       \
+        struct SNAME *_map_, struct SNAME##_inner *parent, size_t index);      \
+    static void PFX##_impl_merge_children(                                     \
+        struct SNAME *_map_, struct SNAME##_inner *parent, size_t index);      \
+    static void PFX##_impl_replace_separator(struct SNAME *_map_, K key,       \
+                                             K successor);                     \
+                                                                               \
+    struct SNAME *PFX##_new(struct SNAME##_fkey *f_key,                        \
+                            struct SNAME##_fval *f_val)                        \
+    {                                                                          \
+        return PFX##_new_custom(f_key, f_val, NULL, NULL);                     \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_new_custom(                                            \
+        struct SNAME##_fkey *f_key, struct SNAME##_fval *f_val,                \
+        struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks)         \
+    {                                                                          \
+        if (!f_key || !f_val)                                                  \
+            return NULL;                                                       \
+                                                                               \
+        if (!alloc)                                                            \
+            alloc = &cmc_alloc_node_default;                                   \
+                                                                               \
+        struct SNAME *_map_ = alloc->malloc(sizeof(struct SNAME));             \
+                                                                               \
+        if (!_map_)                                                            \
+            return NULL;                                                       \
+                                                                               \
+        _map_->root = NULL;                                                    \
+        _map_->head = NULL;                                                    \
+        _map_->tail = NULL;                                                    \
+        _map_->count = 0;                                                      \
+        _map_->flag = cmc_flags.OK;                                            \
+        _map_->f_key = f_key;                                                  \
+        _map_->f_val = f_val;                                                  \
+        _map_->alloc = alloc;                                                  \
+        _map_->callbacks = callbacks;                                          \
+                                                                               \
+        return _map_;                                                          \
+    }                                                                          \
+                                                                               \
+    void PFX##_clear(struct SNAME *_map_)                                      \
+    {                                                                          \
+        if (_map_->f_key->free || _map_->f_val->free)                          \
+        {                                                                      \
+            struct SNAME##_leaf *leaf = _map_->head;                           \
+                                                                               \
+            for (; leaf != NULL; leaf = leaf->next)                            \
+            {                                                                  \
+                for (size_t i = 0; i < leaf->node.length; i++)                 \
+                {                                                              \
+                    if (_map_->f_key->free)                                    \
+                        _map_->f_key->free(leaf->node.keys[i]);                \
+                    if (_map_->f_val->free)                                    \
+                        _map_->f_val->free(leaf->values[i]);                   \
+                }                                                              \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        if (_map_->root)                                                       \
+            PFX##_impl_free_node(_map_, _map_->root);                          \
+                                                                               \
+        _map_->root = NULL;                                                    \
+        _map_->head = NULL;                                                    \
+        _map_->tail = NULL;                                                    \
+        _map_->count = 0;                                                      \
+        _map_->flag = cmc_flags.OK;                                            \
+    }                                                                          \
+                                                                               \
+    void PFX##_free(struct SNAME *_map_)                                       \
+    {                                                                          \
+        PFX##_clear(_map_);                                                    \
+                                                                               \
+        _map_->alloc->free(_map_);                                             \
+    }                                                                          \
+                                                                               \
+    void PFX##_customize(struct SNAME *_map_, struct cmc_alloc_node *alloc,    \
+                         struct cmc_callbacks *callbacks)                      \
+    {                                                                          \
+        if (!alloc)                                                            \
+            _map_->alloc = &cmc_alloc_node_default;                            \
+        else                                                                   \
+            _map_->alloc = alloc;                                              \
+                                                                               \
+        _map_->callbacks = callbacks;                                          \
+                                                                               \
+        _map_->flag = cmc_flags.OK;                                            \
+    }                                                                          \
+                                                                               \
+    bool PFX##_insert(struct SNAME *_map_, K key, V value)                     \
+    {                                                                          \
+        if (_map_->root == NULL)                                               \
+        {                                                                      \
+            struct SNAME##_leaf *leaf = PFX##_impl_new_leaf(_map_);            \
+                                                                               \
+            if (!leaf)                                                         \
+            {                                                                  \
+                _map_->flag = cmc_flags.ALLOC;                                 \
+                return false;                                                  \
+            }                                                                  \
+                                                                               \
+            _map_->root = &(leaf->node);                                       \
+            _map_->head = leaf;                                                \
+            _map_->tail = leaf;                                                \
+        }                                                                      \
+        else if (_map_->root->length == CMC_BTREE_MAX_KEYS)                    \
+        {                                                                      \
+            /* The tree only grows in height when the root is split */         \
+            struct SNAME##_inner *root = PFX##_impl_new_inner(_map_);          \
+                                                                               \
+            if (!root)                                                         \
+            {                                                                  \
+                _map_->flag = cmc_flags.ALLOC;                                 \
+                return false;                                                  \
+            }                                                                  \
+                                                                               \
+            root->children[0] = _map_->root;                                   \
+                                                                               \
+            if (!PFX##_impl_split_child(_map_, root, 0))                       \
+            {                                                                  \
+                _map_->alloc->free(root);                                      \
+                _map_->flag = cmc_flags.ALLOC;                                 \
+                return false;                                                  \
+            }                                                                  \
+                                                                               \
+            _map_->root = &(root->node);                                       \
+        }                                                                      \
+                                                                               \
+        /* Full nodes are split on the way down so that a parent always */     \
+        /* has room for a new separator key */                                 \
+        struct SNAME##_node *scan = _map_->root;                               \
+                                                                               \
+        while (!scan->leaf)                                                    \
+        {                                                                      \
+            struct SNAME##_inner *inner = (struct SNAME##_inner *)scan;        \
+            size_t i = PFX##_impl_upper(_map_, scan, key);                     \
+                                                                               \
+            if (inner->children[i]->length == CMC_BTREE_MAX_KEYS)              \
+            {                                                                  \
+                if (!PFX##_impl_split_child(_map_, inner, i))                  \
+                {                                                              \
+                    _map_->flag = cmc_flags.ALLOC;                             \
+                    return false;                                              \
+                }                                                              \
+                                                                               \
+                if (_map_->f_key->cmp(scan->keys[i], key) <= 0)                \
+                    i++;                                                       \
+            }                                                                  \
+                                                                               \
+            scan = inner->children[i];                                         \
+        }                                                                      \
+                                                                               \
+        struct SNAME##_leaf *leaf = (struct SNAME##_leaf *)scan;               \
+        size_t i = PFX##_impl_lower(_map_, scan, key);                         \
+                                                                               \
+        if (i < scan->length && _map_->f_key->cmp(scan->keys[i], key) == 0)    \
+        {                                                                      \
+            _map_->flag = cmc_flags.DUPLICATE;                                 \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        memmove(scan->keys + i + 1, scan->keys + i,                            \
+                (scan->length - i) * sizeof(K));                               \
+        memmove(leaf->values + i + 1, leaf->values + i,                        \
+                (scan->length - i) * sizeof(V));                               \
+                                                                               \
+        scan->keys[i] = key;                                                   \
+        leaf->values[i] = value;                                               \
+        scan->length++;                                                        \
+                                                                               \
+        _map_->count++;                                                        \
+        _map_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        if (_map_->callbacks && _map_->callbacks->create)                      \
+            _map_->callbacks->create();                                        \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_update(struct SNAME *_map_, K key, V new_value, V *old_value)   \
+    {                                                                          \
+        size_t index;                                                          \
+        struct SNAME##_leaf *leaf = PFX##_impl_get_leaf(_map_, key, &index);   \
+                                                                               \
+        if (!leaf)                                                             \
+        {                                                                      \
+            _map_->flag = cmc_flags.NOT_FOUND;                                 \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (old_value)                                                         \
+            *old_value = leaf->values[index];                                  \
+                                                                               \
+        leaf->values[index] = new_value;                                       \
+                                                                               \
+        _map_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        if (_map_->callbacks && _map_->callbacks->update)                      \
+            _map_->callbacks->update();                                        \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_remove(struct SNAME *_map_, K key, V *out_value)                \
+    {                                                                          \
+        if (PFX##_empty(_map_))                                                \
+        {                                                                      \
+            _map_->flag = cmc_flags.EMPTY;                                     \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        /* Nodes with the minimum amount of keys are filled on the way */      \
+        /* down so that a leaf can always lose one key */                      \
+        struct SNAME##_node *scan = _map_->root;                               \
+                                                                               \
+        while (!scan->leaf)                                                    \
+        {                                                                      \
+            struct SNAME##_inner *inner = (struct SNAME##_inner *)scan;        \
+            size_t i = PFX##_impl_upper(_map_, scan, key);                     \
+                                                                               \
+            if (inner->children[i]->length == CMC_BTREE_MIN_KEYS)              \
+                i = PFX##_impl_fill_child(_map_, inner, i);                    \
+                                                                               \
+            struct SNAME##_node *child = inner->children[i];                   \
+                                                                               \
+            /* The tree only shrinks in height when the root is emptied */     \
+            if (scan->length == 0)                                             \
+            {                                                                  \
+                _map_->root = child;                                           \
+                _map_->alloc->free(inner);                                     \
+            }                                                                  \
+                                                                               \
+            scan = child;                                                      \
+        }                                                                      \
+                                                                               \
+        struct SNAME##_leaf *leaf = (struct SNAME##_leaf *)scan;               \
+        size_t i = PFX##_impl_lower(_map_, scan, key);                         \
+                                                                               \
+        if (i == scan->length || _map_->f_key->cmp(scan->keys[i], key) != 0)   \
+        {                                                                      \
+            _map_->flag = cmc_flags.NOT_FOUND;                                 \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (out_value)                                                         \
+            *out_value = leaf->values[i];                                      \
+                                                                               \
+        memmove(scan->keys + i, scan->keys + i + 1,                            \
+                (scan->length - i - 1) * sizeof(K));                           \
+        memmove(leaf->values + i, leaf->values + i + 1,                        \
+                (scan->length - i - 1) * sizeof(V));                           \
+                                                                               \
+        scan->length--;                                                        \
+        _map_->count--;                                                        \
+                                                                               \
+        /* The first key of a leaf might also be a separator in an inner */    \
+        /* node, which must not keep a key that now belongs to the caller */   \
+        if (i == 0 && scan->length > 0)                                        \
+            PFX##_impl_replace_separator(_map_, key, scan->keys[0]);           \
+                                                                               \
+        if (_map_->count == 0)                                                 \
+        {                                                                      \
+            _map_->alloc->free(leaf);                                          \
+                                                                               \
+            _map_->root = NULL;                                                \
+            _map_->head = NULL;                                                \
+            _map_->tail = NULL;                                                \
+        }                                                                      \
+                                                                               \
+        _map_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        if (_map_->callbacks && _map_->callbacks->delete)                      \
+            _map_->callbacks->delete ();                                       \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_max(struct SNAME *_map_, K *key, V *value)                      \
+    {                                                                          \
+        if (PFX##_empty(_map_))                                                \
+        {                                                                      \
+            _map_->flag = cmc_flags.EMPTY;                                     \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        struct SNAME##_leaf *leaf = _map_->tail;                               \
+                                                                               \
+        if (key)                                                               \
+            *key = leaf->node.keys[leaf->node.length - 1];                     \
+        if (value)                                                             \
+            *value = leaf->values[leaf->node.length - 1];                      \
+                                                                               \
+        _map_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        if (_map_->callbacks && _map_->callbacks->read)                        \
+            _map_->callbacks->read();                                          \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_min(struct SNAME *_map_, K *key, V *value)                      \
+    {                                                                          \
+        if (PFX##_empty(_map_))                                                \
+        {                                                                      \
+            _map_->flag = cmc_flags.EMPTY;                                     \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        struct SNAME##_leaf *leaf = _map_->head;                               \
+                                                                               \
+        if (key)                                                               \
+            *key = leaf->node.keys[0];                                         \
+        if (value)                                                             \
+            *value = leaf->values[0];                                          \
+                                                                               \
+        _map_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        if (_map_->callbacks && _map_->callbacks->read)                        \
+            _map_->callbacks->read();                                          \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    V PFX##_get(struct SNAME *_map_, K key)                                    \
+    {                                                                          \
+        if (PFX##_empty(_map_))                                                \
+        {                                                                      \
+            _map_->flag = cmc_flags.EMPTY;                                     \
+            return (V){ 0 };                                                   \
+        }                                                                      \
+                                                                               \
+        size_t index;                                                          \
+        struct SNAME##_leaf *leaf = PFX##_impl_get_leaf(_map_, key, &index);   \
+                                                                               \
+        if (!leaf)                                                             \
+        {                                                                      \
+            _map_->flag = cmc_flags.NOT_FOUND;                                 \
+            return (V){ 0 };                                                   \
+        }                                                                      \
+                                                                               \
+        _map_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        if (_map_->callbacks && _map_->callbacks->read)                        \
+            _map_->callbacks->read();                                          \
+                                                                               \
+        return leaf->values[index];                                            \
+    }                                                                          \
+                                                                               \
+    V *PFX##_get_ref(struct SNAME *_map_, K key)                               \
+    {                                                                          \
+        if (PFX##_empty(_map_))                                                \
+        {                                                                      \
+            _map_->flag = cmc_flags.EMPTY;                                     \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        size_t index;                                                          \
+        struct SNAME##_leaf *leaf = PFX##_impl_get_leaf(_map_, key, &index);   \
+                                                                               \
+        if (!leaf)                                                             \
+        {                                                                      \
+            _map_->flag = cmc_flags.NOT_FOUND;                                 \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        _map_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        if (_map_->callbacks && _map_->callbacks->read)                        \
+            _map_->callbacks->read();                                          \
+                                                                               \
+        return &(leaf->values[index]);                                         \
+    }                                                                          \
+                                                                               \
+    bool PFX##_contains(struct SNAME *_map_, K key)                            \
+    {                                                                          \
+        size_t index;                                                          \
+        bool result = PFX##_impl_get_leaf(_map_, key, &index) != NULL;         \
+                                                                               \
+        _map_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        if (_map_->callbacks && _map_->callbacks->read)                        \
+            _map_->callbacks->read();                                          \
+                                                                               \
+        return result;                                                         \
+    }                                                                          \
+                                                                               \
+    bool PFX##_empty(struct SNAME *_map_)                                      \
+    {                                                                          \
+        return _map_->count == 0;                                              \
+    }                                                                          \
+                                                                               \
+    size_t PFX##_count(struct SNAME *_map_)                                    \
+    {                                                                          \
+        return _map_->count;                                                   \
+    }                                                                          \
+                                                                               \
+    int PFX##_flag(struct SNAME *_map_)                                        \
+    {                                                                          \
+        return _map_->flag;                                                    \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_copy_of(struct SNAME *_map_)                           \
+    {                                                                          \
+        /* Callback will be added later */                                     \
+        struct SNAME *result =                                                 \
+            PFX##_new_custom(_map_->f_key, _map_->f_val, _map_->alloc, NULL);  \
+                                                                               \
+        if (!result)                                                           \
+        {                                                                      \
+            _map_->flag = cmc_flags.ERROR;                                     \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        struct SNAME##_leaf *leaf = _map_->head;                               \
+                                                                               \
+        for (; leaf != NULL; leaf = leaf->next)                                \
+        {                                                                      \
+            for (size_t i = 0; i < leaf->node.length; i++)                     \
+            {                                                                  \
+                K key = leaf->node.keys[i];                                    \
+                V value = leaf->values[i];                                     \
+                                                                               \
+                if (_map_->f_key->cpy)                                         \
+                    key = _map_->f_key->cpy(key);                              \
+                if (_map_->f_val->cpy)                                         \
+                    value = _map_->f_val->cpy(value);                          \
+                                                                               \
+                if (!PFX##_insert(result, key, value))                         \
+                {                                                              \
+                    PFX##_free(result);                                        \
+                    _map_->flag = cmc_flags.ALLOC;                             \
+                    return NULL;                                               \
+                }                                                              \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        result->callbacks = _map_->callbacks;                                  \
+        _map_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        return result;                                                         \
+    }                                                                          \
+                                                                               \
+    bool PFX##_equals(struct SNAME *_map1_, struct SNAME *_map2_)              \
+    {                                                                          \
+        _map1_->flag = cmc_flags.OK;                                           \
+        _map2_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_map1_->count != _map2_->count)                                    \
+            return false;                                                      \
+                                                                               \
+        /* Both maps are sorted so they can be compared in lockstep */         \
+        struct SNAME##_iter iter1 = PFX##_iter_start(_map1_);                  \
+        struct SNAME##_iter iter2 = PFX##_iter_start(_map2_);                  \
+                                                                               \
+        for (; !PFX##_iter_at_end(&iter1);                                     \
+             PFX##_iter_next(&iter1), PFX##_iter_next(&iter2))                 \
+        {                                                                      \
+            if (_map1_->f_key->cmp(PFX##_iter_key(&iter1),                     \
+                                   PFX##_iter_key(&iter2)) != 0)               \
+                return false;                                                  \
+                                                                               \
+            if (_map1_->f_val->cmp(PFX##_iter_value(&iter1),                   \
+                                   PFX##_iter_value(&iter2)) != 0)             \
+                return false;                                                  \
+        }                                                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    struct cmc_string PFX##_to_string(struct SNAME *_map_)                     \
+    {                                                                          \
+        struct cmc_string str;                                                 \
+        struct SNAME *m_ = _map_;                                              \
+                                                                               \
+        int n = snprintf(str.s, cmc_string_len, cmc_string_fmt_btreemap,       \
+                         #SNAME, #K, #V, m_, m_->root, m_->head, m_->tail,     \
+                         m_->count, m_->flag, m_->f_key, m_->f_val, m_->alloc, \
+                         m_->callbacks);                                       \
+                                                                               \
+        return n >= 0 ? str : (struct cmc_string){ 0 };                        \
+    }                                                                          \
+                                                                               \
+    bool PFX##_print(struct SNAME *_map_, FILE *fptr)                          \
+    {                                                                          \
+        struct SNAME##_leaf *leaf = _map_->head;                               \
+                                                                               \
+        for (; leaf != NULL; leaf = leaf->next)                                \
+        {                                                                      \
+            for (size_t i = 0; i < leaf->node.length; i++)                     \
+            {                                                                  \
+                if (!_map_->f_key->str(fptr, leaf->node.keys[i]) ||            \
+                    !_map_->f_val->str(fptr, leaf->values[i]))                 \
+                    return false;                                              \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    struct SNAME##_iter PFX##_iter_start(struct SNAME *target)                 \
+    {                                                                          \
+        struct SNAME##_iter iter;                                              \
+                                                                               \
+        iter.target = target;                                                  \
+        iter.cursor = target->head;                                            \
+        iter.position = 0;                                                     \
+        iter.index = 0;                                                        \
+        iter.start = true;                                                     \
+        iter.end = PFX##_empty(target);                                        \
+                                                                               \
+        return iter;                                                           \
+    }                                                                          \
+                                                                               \
+    struct SNAME##_iter PFX##_iter_end(struct SNAME *target)                   \
+    {                                                                          \
+        struct SNAME##_iter iter;                                              \
+                                                                               \
+        iter.target = target;                                                  \
+        iter.cursor = target->tail;                                            \
+        iter.position = 0;                                                     \
+        iter.index = 0;                                                        \
+        iter.start = PFX##_empty(target);                                      \
+        iter.end = true;                                                       \
+                                                                               \
+        if (!PFX##_empty(target))                                              \
+        {                                                                      \
+            iter.position = target->tail->node.length - 1;                     \
+            iter.index = target->count - 1;                                    \
+        }                                                                      \
+                                                                               \
+        return iter;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_at_start(struct SNAME##_iter *iter)                        \
+    {                                                                          \
+        return PFX##_empty(iter->target) || iter->start;                       \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_at_end(struct SNAME##_iter *iter)                          \
+    {                                                                          \
+        return PFX##_empty(iter->target) || iter->end;                         \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_to_start(struct SNAME##_iter *iter)                        \
+    {                                                                          \
+        if (!PFX##_empty(iter->target))                                        \
+        {                                                                      \
+            iter->cursor = iter->target->head;                                 \
+            iter->position = 0;                                                \
+            iter->index = 0;                                                   \
+            iter->start = true;                                                \
+            iter->end = PFX##_empty(iter->target);                             \
+                                                                               \
+            return true;                                                       \
+        }                                                                      \
+                                                                               \
+        return false;                                                          \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_to_end(struct SNAME##_iter *iter)                          \
+    {                                                                          \
+        if (!PFX##_empty(iter->target))                                        \
+        {                                                                      \
+            iter->cursor = iter->target->tail;                                 \
+            iter->position = iter->cursor->node.length - 1;                    \
+            iter->index = iter->target->count - 1;                             \
+            iter->start = PFX##_empty(iter->target);                           \
+            iter->end = true;                                                  \
+                                                                               \
+            return true;                                                       \
+        }                                                                      \
+                                                                               \
+        return false;                                                          \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_next(struct SNAME##_iter *iter)                            \
+    {                                                                          \
+        if (iter->end)                                                         \
+            return false;                                                      \
+                                                                               \
+        if (iter->index + 1 == iter->target->count)                            \
+        {                                                                      \
+            iter->end = true;                                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        iter->start = PFX##_empty(iter->target);                               \
+                                                                               \
+        if (++iter->position == iter->cursor->node.length)                     \
+        {                                                                      \
+            iter->cursor = iter->cursor->next;                                 \
+            iter->position = 0;                                                \
+        }                                                                      \
+                                                                               \
+        iter->index++;                                                         \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_prev(struct SNAME##_iter *iter)                            \
+    {                                                                          \
+        if (iter->start)                                                       \
+            return false;                                                      \
+                                                                               \
+        if (iter->index == 0)                                                  \
+        {                                                                      \
+            iter->start = true;                                                \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        iter->end = PFX##_empty(iter->target);                                 \
+                                                                               \
+        if (iter->position == 0)                                               \
+        {                                                                      \
+            iter->cursor = iter->cursor->prev;                                 \
+            iter->position = iter->cursor->node.length - 1;                    \
+        }                                                                      \
+        else                                                                   \
+            iter->position--;                                                  \
+                                                                               \
+        iter->index--;                                                         \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Returns true only if the iterator moved */                              \
+    bool PFX##_iter_advance(struct SNAME##_iter *iter, size_t steps)           \
+    {                                                                          \
+        if (iter->end)                                                         \
+            return false;                                                      \
+                                                                               \
+        if (iter->index + 1 == iter->target->count)                            \
+        {                                                                      \
+            iter->end = true;                                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (steps == 0 || iter->index + steps >= iter->target->count)          \
+            return false;                                                      \
+                                                                               \
+        iter->start = PFX##_empty(iter->target);                               \
+        iter->index += steps;                                                  \
+                                                                               \
+        /* Whole leaf nodes are skipped at once */                             \
+        steps += iter->position;                                               \
+                                                                               \
+        while (steps >= iter->cursor->node.length)                             \
+        {                                                                      \
+            steps -= iter->cursor->node.length;                                \
+            iter->cursor = iter->cursor->next;                                 \
+        }                                                                      \
+                                                                               \
+        iter->position = steps;                                                \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Returns true only if the iterator moved */                              \
+    bool PFX##_iter_rewind(struct SNAME##_iter *iter, size_t steps)            \
+    {                                                                          \
+        if (iter->start)                                                       \
+            return false;                                                      \
+                                                                               \
+        if (iter->index == 0)                                                  \
+        {                                                                      \
+            iter->start = true;                                                \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (steps == 0 || iter->index < steps)                                 \
+            return false;                                                      \
+                                                                               \
+        iter->end = PFX##_empty(iter->target);                                 \
+        iter->index -= steps;                                                  \
+                                                                               \
+        /* Whole leaf nodes are skipped at once */                             \
+        while (steps > iter->position)                                         \
+        {                                                                      \
+            steps -= iter->position + 1;                                       \
+            iter->cursor = iter->cursor->prev;                                 \
+            iter->position = iter->cursor->node.length - 1;                    \
+        }                                                                      \
+                                                                               \
+        iter->position -= steps;                                               \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Returns true only if the iterator was able to be positioned at the */   \
+    /* given index */                                                          \
+    bool PFX##_iter_go_to(struct SNAME##_iter *iter, size_t index)             \
+    {                                                                          \
+        if (index >= iter->target->count)                                      \
+            return false;                                                      \
+                                                                               \
+        if (iter->index > index)                                               \
+            return PFX##_iter_rewind(iter, iter->index - index);               \
+        else if (iter->index < index)                                          \
+            return PFX##_iter_advance(iter, index - iter->index);              \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    K PFX##_iter_key(struct SNAME##_iter *iter)                                \
+    {                                                                          \
+        if (PFX##_empty(iter->target))                                         \
+            return (K){ 0 };                                                   \
+                                                                               \
+        return iter->cursor->node.keys[iter->position];                        \
+    }                                                                          \
+                                                                               \
+    V PFX##_iter_value(struct SNAME##_iter *iter)                              \
+    {                                                                          \
+        if (PFX##_empty(iter->target))                                         \
+            return (V){ 0 };                                                   \
+                                                                               \
+        return iter->cursor->values[iter->position];                           \
+    }                                                                          \
+                                                                               \
+    V *PFX##_iter_rvalue(struct SNAME##_iter *iter)                            \
+    {                                                                          \
+        if (PFX##_empty(iter->target))                                         \
+            return NULL;                                                       \
+                                                                               \
+        return &(iter->cursor->values[iter->position]);                        \
+    }                                                                          \
+                                                                               \
+    size_t PFX##_iter_index(struct SNAME##_iter *iter)                         \
+    {                                                                          \
+        return iter->index;                                                    \
+    }                                                                          \
+                                                                               \
+    static struct SNAME##_leaf *PFX##_impl_new_leaf(struct SNAME *_map_)       \
+    {                                                                          \
+        struct SNAME##_leaf *leaf =                                            \
+            _map_->alloc->malloc(sizeof(struct SNAME##_leaf));                 \
+                                                                               \
+        if (!leaf)                                                             \
+            return NULL;                                                       \
+                                                                               \
+        leaf->node.length = 0;                                                 \
+        leaf->node.leaf = true;                                                \
+        leaf->prev = NULL;                                                     \
+        leaf->next = NULL;                                                     \
+                                                                               \
+        return leaf;                                                           \
+    }                                                                          \
+                                                                               \
+    static struct SNAME##_inner *PFX##_impl_new_inner(struct SNAME *_map_)     \
+    {                                                                          \
+        struct SNAME##_inner *inner =                                          \
+            _map_->alloc->malloc(sizeof(struct SNAME##_inner));                \
+                                                                               \
+        if (!inner)                                                            \
+            return NULL;                                                       \
+                                                                               \
+        inner->node.length = 0;                                                \
+        inner->node.leaf = false;                                              \
+                                                                               \
+        return inner;                                                          \
+    }                                                                          \
+                                                                               \
+    static void PFX##_impl_free_node(struct SNAME *_map_,                      \
+                                     struct SNAME##_node *node)                \
+    {                                                                          \
+        /* The height of the tree is very small so recursion is fine */        \
+        if (!node->leaf)                                                       \
+        {                                                                      \
+            struct SNAME##_inner *inner = (struct SNAME##_inner *)node;        \
+                                                                               \
+            for (size_t i = 0; i <= node->length; i++)                         \
+                PFX##_impl_free_node(_map_, inner->children[i]);               \
+        }                                                                      \
+                                                                               \
+        _map_->alloc->free(node);                                              \
+    }                                                                          \
+                                                                               \
+    /* Index of the first key in node that is greater than or equal to key */  \
+    static size_t PFX##_impl_lower(struct SNAME *_map_,                        \
+                                   struct SNAME##_node *node, K key)           \
+    {                                                                          \
+        size_t low = 0, high = node->length;                                   \
+                                                                               \
+        while (low < high)                                                     \
+        {                                                                      \
+            size_t mid = low + (high - low) / 2;                               \
+                                                                               \
+            if (_map_->f_key->cmp(node->keys[mid], key) < 0)                   \
+                low = mid + 1;                                                 \
+            else                                                               \
+                high = mid;                                                    \
+        }                                                                      \
+                                                                               \
+        return low;                                                            \
+    }                                                                          \
+                                                                               \
+    /* Index of the first key in node that is greater than key */              \
+    static size_t PFX##_impl_upper(struct SNAME *_map_,                        \
+                                   struct SNAME##_node *node, K key)           \
+    {                                                                          \
+        size_t low = 0, high = node->length;                                   \
+                                                                               \
+        while (low < high)                                                     \
+        {                                                                      \
+            size_t mid = low + (high - low) / 2;                               \
+                                                                               \
+            if (_map_->f_key->cmp(node->keys[mid], key) <= 0)                  \
+                low = mid + 1;                                                 \
+            else                                                               \
+                high = mid;                                                    \
+        }                                                                      \
+                                                                               \
+        return low;                                                            \
+    }                                                                          \
+                                                                               \
+    static struct SNAME##_leaf *PFX##_impl_get_leaf(struct SNAME *_map_,       \
+                                                    K key, size_t *index)      \
+    {                                                                          \
+        struct SNAME##_node *scan = _map_->root;                               \
+                                                                               \
+        if (!scan)                                                             \
+            return NULL;                                                       \
+                                                                               \
+        while (!scan->leaf)                                                    \
+        {                                                                      \
+            struct SNAME##_inner *inner = (struct SNAME##_inner *)scan;        \
+                                                                               \
+            scan = inner->children[PFX##_impl_upper(_map_, scan, key)];        \
+        }                                                                      \
+                                                                               \
+        size_t i = PFX##_impl_lower(_map_, scan, key);                         \
+                                                                               \
+        if (i == scan->length || _map_->f_key->cmp(scan->keys[i], key) != 0)   \
+            return NULL;                                                       \
+                                                                               \
+        *index = i;                                                            \
+                                                                               \
+        return (struct SNAME##_leaf *)scan;                                    \
+    }                                                                          \
+                                                                               \
+    /* Splits the full child at index of parent in two nodes */                \
+    static bool PFX##_impl_split_child(                                        \
+        struct SNAME *_map_, struct SNAME##_inner *parent, size_t index)       \
+    {                                                                          \
+        struct SNAME##_node *child = parent->children[index];                  \
+        struct SNAME##_node *sibling;                                          \
+        K separator;                                                           \
+                                                                               \
+        if (child->leaf)                                                       \
+        {                                                                      \
+            struct SNAME##_leaf *left = (struct SNAME##_leaf *)child;          \
+            struct SNAME##_leaf *right = PFX##_impl_new_leaf(_map_);           \
+                                                                               \
+            if (!right)                                                        \
+                return false;                                                  \
+                                                                               \
+            /* Keys are copied to the right leaf and the first one of them */  \
+            /* is also copied up to the parent as a separator */               \
+            size_t from = CMC_BTREE_MIN_KEYS + 1;                              \
+            size_t length = child->length - from;                              \
+                                                                               \
+            memcpy(right->node.keys, child->keys + from, length * sizeof(K));  \
+            memcpy(right->values, left->values + from, length * sizeof(V));    \
+                                                                               \
+            right->node.length = length;                                       \
+            child->length = from;                                              \
+                                                                               \
+            right->prev = left;                                                \
+            right->next = left->next;                                          \
+                                                                               \
+            if (left->next)                                                    \
+                left->next->prev = right;                                      \
+            else                                                               \
+                _map_->tail = right;                                           \
+                                                                               \
+            left->next = right;                                                \
+                                                                               \
+            separator = right->node.keys[0];                                   \
+            sibling = &(right->node);                                          \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            struct SNAME##_inner *left = (struct SNAME##_inner *)child;        \
+            struct SNAME##_inner *right = PFX##_impl_new_inner(_map_);         \
+                                                                               \
+            if (!right)                                                        \
+                return false;                                                  \
+                                                                               \
+            /* The median key is moved up to the parent */                     \
+            size_t from = CMC_BTREE_MIN_KEYS + 1;                              \
+            size_t length = child->length - from;                              \
+                                                                               \
+            memcpy(right->node.keys, child->keys + from, length * sizeof(K));  \
+            memcpy(right->children, left->children + from,                     \
+                   (length + 1) * sizeof(struct SNAME##_node *));              \
+                                                                               \
+            right->node.length = length;                                       \
+            child->length = CMC_BTREE_MIN_KEYS;                                \
+                                                                               \
+            separator = child->keys[CMC_BTREE_MIN_KEYS];                       \
+            sibling = &(right->node);                                          \
+        }                                                                      \
+                                                                               \
+        struct SNAME##_node *node = &(parent->node);                           \
+                                                                               \
+        memmove(node->keys + index + 1, node->keys + index,                    \
+                (node->length - index) * sizeof(K));                           \
+        memmove(parent->children + index + 2, parent->children + index + 1,    \
+                (node->length - index) * sizeof(struct SNAME##_node *));       \
+                                                                               \
+        node->keys[index] = separator;                                         \
+        parent->children[index + 1] = sibling;                                 \
+        node->length++;                                                        \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Makes sure that the child at index of parent has more than the */       \
+    /* minimum amount of keys by either borrowing a key from a sibling or */   \
+    /* merging with it. Returns the new index of that child. */                \
+    static size_t PFX##_impl_fill_child(                                       \
+        struct SNAME *_map_, struct SNAME##_inner *parent, size_t index)       \
+    {                                                                          \
+        struct SNAME##_node *node = &(parent->node);                           \
+        struct SNAME##_node *child = parent->children[index];                  \
+        struct SNAME##_node *left = NULL, *right = NULL;                       \
+                                                                               \
+        if (index > 0)                                                         \
+            left = parent->children[index - 1];                                \
+        if (index < node->length)                                              \
+            right = parent->children[index + 1];                               \
+                                                                               \
+        if (left && left->length > CMC_BTREE_MIN_KEYS)                         \
+        {                                                                      \
+            /* Borrow the greatest key from the left sibling */                \
+            memmove(child->keys + 1, child->keys, child->length * sizeof(K));  \
+                                                                               \
+            if (child->leaf)                                                   \
+            {                                                                  \
+                struct SNAME##_leaf *c = (struct SNAME##_leaf *)child;         \
+                struct SNAME##_leaf *l = (struct SNAME##_leaf *)left;          \
+                                                                               \
+                memmove(c->values + 1, c->values, child->length * sizeof(V));  \
+                                                                               \
+                child->keys[0] = left->keys[left->length - 1];                 \
+                c->values[0] = l->values[left->length - 1];                    \
+                                                                               \
+                node->keys[index - 1] = child->keys[0];                        \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                struct SNAME##_inner *c = (struct SNAME##_inner *)child;       \
+                struct SNAME##_inner *l = (struct SNAME##_inner *)left;        \
+                                                                               \
+                memmove(c->children + 1, c->children,                          \
+                        (child->length + 1) * sizeof(struct SNAME##_node *));  \
+                                                                               \
+                child->keys[0] = node->keys[index - 1];                        \
+                c->children[0] = l->children[left->length];                    \
+                                                                               \
+                node->keys[index - 1] = left->keys[left->length - 1];          \
+            }                                                                  \
+                                                                               \
+            child->length++;                                                   \
+            left->length--;                                                    \
+        }                                                                      \
+        else if (right && right->length > CMC_BTREE_MIN_KEYS)                  \
+        {                                                                      \
+            /* Borrow the smallest key from the right sibling */               \
+            if (child->leaf)                                                   \
+            {                                                                  \
+                struct SNAME##_leaf *c = (struct SNAME##_leaf *)child;         \
+                struct SNAME##_leaf *r = (struct SNAME##_leaf *)right;         \
+                                                                               \
+                child->keys[child->length] = right->keys[0];                   \
+                c->values[child->length] = r->values[0];                       \
+                                                                               \
+                memmove(right->keys, right->keys + 1,                          \
+                        (right->length - 1) * sizeof(K));                      \
+                memmove(r->values, r->values + 1,                              \
+                        (right->length - 1) * sizeof(V));                      \
+                                                                               \
+                node->keys[index] = right->keys[0];                            \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                struct SNAME##_inner *c = (struct SNAME##_inner *)child;       \
+                struct SNAME##_inner *r = (struct SNAME##_inner *)right;       \
+                                                                               \
+                child->keys[child->length] = node->keys[index];                \
+                c->children[child->length + 1] = r->children[0];               \
+                                                                               \
+                node->keys[index] = right->keys[0];                            \
+                                                                               \
+                memmove(right->keys, right->keys + 1,                          \
+                        (right->length - 1) * sizeof(K));                      \
+                memmove(r->children, r->children + 1,                          \
+                        right->length * sizeof(struct SNAME##_node *));        \
+            }                                                                  \
+                                                                               \
+            child->length++;                                                   \
+            right->length--;                                                   \
+        }                                                                      \
+        else if (right)                                                        \
+            PFX##_impl_merge_children(_map_, parent, index);                   \
+        else                                                                   \
+            PFX##_impl_merge_children(_map_, parent, --index);                 \
+                                                                               \
+        return index;                                                          \
+    }                                                                          \
+                                                                               \
+    /* Merges the children at index and index + 1 of parent */                 \
+    static void PFX##_impl_merge_children(                                     \
+        struct SNAME *_map_, struct SNAME##_inner *parent, size_t index)       \
+    {                                                                          \
+        struct SNAME##_node *node = &(parent->node);                           \
+        struct SNAME##_node *left = parent->children[index];                   \
+        struct SNAME##_node *right = parent->children[index + 1];              \
+                                                                               \
+        if (left->leaf)                                                        \
+        {                                                                      \
+            struct SNAME##_leaf *l = (struct SNAME##_leaf *)left;              \
+            struct SNAME##_leaf *r = (struct SNAME##_leaf *)right;             \
+                                                                               \
+            memcpy(left->keys + left->length, right->keys,                     \
+                   right->length * sizeof(K));                                 \
+            memcpy(l->values + left->length, r->values,                        \
+                   right->length * sizeof(V));                                 \
+                                                                               \
+            left->length += right->length;                                     \
+                                                                               \
+            l->next = r->next;                                                 \
+                                                                               \
+            if (r->next)                                                       \
+                r->next->prev = l;                                             \
+            else                                                               \
+                _map_->tail = l;                                               \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            struct SNAME##_inner *l = (struct SNAME##_inner *)left;            \
+            struct SNAME##_inner *r = (struct SNAME##_inner *)right;           \
+                                                                               \
+            /* The separator is moved down between the two nodes */            \
+            left->keys[left->length] = node->keys[index];                      \
+                                                                               \
+            memcpy(left->keys + left->length + 1, right->keys,                 \
+                   right->length * sizeof(K));                                 \
+            memcpy(l->children + left->length + 1, r->children,                \
+                   (right->length + 1) * sizeof(struct SNAME##_node *));       \
+                                                                               \
+            left->length += right->length + 1;                                 \
+        }                                                                      \
+                                                                               \
+        memmove(node->keys + index, node->keys + index + 1,                    \
+                (node->length - index - 1) * sizeof(K));                       \
+        memmove(parent->children + index + 1, parent->children + index + 2,    \
+                (node->length - index - 1) * sizeof(struct SNAME##_node *));   \
+                                                                               \
+        node->length--;                                                        \
+                                                                               \
+        _map_->alloc->free(right);                                             \
+    }                                                                          \
+                                                                               \
+    /* Replaces the separator equal to key, if there is one, with its */       \
+    /* successor. Separators are the first key of a subtree so there is */     \
+    /* at most one of them and it is on the way down to key */                 \
+    static void PFX##_impl_replace_separator(struct SNAME *_map_, K key,       \
+                                             K successor)                      \
+    {                                                                          \
+        struct SNAME##_node *scan = _map_->root;                               \
+                                                                               \
+        while (!scan->leaf)                                                    \
+        {                                                                      \
+            size_t i = PFX##_impl_upper(_map_, scan, key);                     \
+                                                                               \
+            if (i > 0 && _map_->f_key->cmp(scan->keys[i - 1], key) == 0)       \
+            {                                                                  \
+                scan->keys[i - 1] = successor;                                 \
+                return;                                                        \
+            }                                                                  \
+                                                                               \
+            scan = ((struct SNAME##_inner *)scan)->children[i];                \
+        }                                                                      \
+    }
+
+#endif /* CMC_BTREEMAP_H */
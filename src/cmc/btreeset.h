@@ -0,0 +1,1476 @@
+/**
+ * btreeset.h
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * BTreeSet
+ *
+ * A BTreeSet is an implementation of a Set that keeps its elements sorted.
+ * Like a Set it has only unique keys. This implementation uses a B+ Tree where
+ * each node stores many elements contiguously, making the tree much shallower
+ * than a binary tree and reducing the amount of cache misses per look up. All
+ * elements are stored in the leaf nodes, which are linked together for fast
+ * sequential iteration. The amount of elements per node can be tuned by
+ * CMC_BTREE_ORDER.
+ */
+
+#ifndef CMC_BTREESET_H
+#define CMC_BTREESET_H
+
+/* -------------------------------------------------------------------------
+ * Core functionalities of the C Macro Collections Library
+ * ------------------------------------------------------------------------- */
+#include "../cor/btree.h"
+#include "../cor/core.h"
+
+/* -------------------------------------------------------------------------
+ * BTreeSet specific
+ * ------------------------------------------------------------------------- */
+/* to_string format */
+static const char *cmc_string_fmt_btreeset = "struct %s<%s> "
+                                             "at %p { "
+                                             "root:%p, "
+                                             "head:%p, "
+                                             "tail:%p, "
+                                             "count:%" PRIuMAX ", "
+                                             "flag:%d, "
+                                             "f_val:%p, "
+                                             "alloc:%p, "
+                                             "callbacks:%p }";
+
+#define CMC_GENERATE_BTREESET(PFX, SNAME, V)    \
+    CMC_GENERATE_BTREESET_HEADER(PFX, SNAME, V) \
+    CMC_GENERATE_BTREESET_SOURCE(PFX, SNAME, V)
+
+#define CMC_WRAPGEN_BTREESET_HEADER(PFX, SNAME, K, V) \
+    CMC_GENERATE_BTREESET_HEADER(PFX, SNAME, V)
+
+#define CMC_WRAPGEN_BTREESET_SOURCE(PFX, SNAME, K, V) \
+    CMC_GENERATE_BTREESET_SOURCE(PFX, SNAME, V)
+
+/* -------------------------------------------------------------------------
+ * Header
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_BTREESET_HEADER(PFX, SNAME, V)                            \
+                                                                               \
+    /* BTreeSet Structure */                                                   \
+    struct SNAME                                                               \
+    {                                                                          \
+        /* Root node */                                                        \
+        struct SNAME##_node *root;                                             \
+                                                                               \
+        /* Leftmost leaf node, holding the smallest elements */                \
+        struct SNAME##_leaf *head;                                             \
+                                                                               \
+        /* Rightmost leaf node, holding the greatest elements */               \
+        struct SNAME##_leaf *tail;                                             \
+                                                                               \
+        /* Current amount of elements */                                       \
+        size_t count;                                                          \
+                                                                               \
+        /* Flags indicating errors or success */                               \
+        int flag;                                                              \
+                                                                               \
+        /* Value function table */                                             \
+        struct SNAME##_fval *f_val;                                            \
+                                                                               \
+        /* Custom allocation functions */                                      \
+        struct cmc_alloc_node *alloc;                                          \
+                                                                               \
+        /* Custom callback functions */                                        \
+        struct cmc_callbacks *callbacks;                                       \
+    };                                                                         \
+                                                                               \
+    /* BTreeSet Node */                                                        \
+    /* Common part of leaf and inner nodes */                                  \
+    struct SNAME##_node                                                        \
+    {                                                                          \
+        /* Amount of elements currently stored in this node */                 \
+        size_t length;                                                         \
+                                                                               \
+        /* If this node is a leaf node or an inner node */                     \
+        bool leaf;                                                             \
+                                                                               \
+        /* Elements sorted in ascending order and stored contiguously */       \
+        V values[CMC_BTREE_MAX_KEYS];                                          \
+    };                                                                         \
+                                                                               \
+    /* BTreeSet Leaf Node */                                                   \
+    struct SNAME##_leaf                                                        \
+    {                                                                          \
+        /* Common node part, must be the first member */                       \
+        struct SNAME##_node node;                                              \
+                                                                               \
+        /* Previous leaf node in element order */                              \
+        struct SNAME##_leaf *prev;                                             \
+                                                                               \
+        /* Next leaf node in element order */                                  \
+        struct SNAME##_leaf *next;                                             \
+    };                                                                         \
+                                                                               \
+    /* BTreeSet Inner Node */                                                  \
+    struct SNAME##_inner                                                       \
+    {                                                                          \
+        /* Common node part, must be the first member */                       \
+        struct SNAME##_node node;                                              \
+                                                                               \
+        /* Child subtrees. Elements in children[i] are less than values[i] */  \
+        /* and in children[i + 1] are greater than or equal to values[i] */    \
+        struct SNAME##_node *children[CMC_BTREE_MAX_KEYS + 1];                 \
+    };                                                                         \
+                                                                               \
+    /* Value struct function table */                                          \
+    struct SNAME##_fval                                                        \
+    {                                                                          \
+        /* Comparator function */                                              \
+        int (*cmp)(V, V);                                                      \
+                                                                               \
+        /* Copy function */                                                    \
+        V (*cpy)(V);                                                           \
+                                                                               \
+        /* To string function */                                               \
+        bool (*str)(FILE *, V);                                                \
+                                                                               \
+        /* Free from memory function */                                        \
+        void (*free)(V);                                                       \
+                                                                               \
+        /* Hash function */                                                    \
+        size_t (*hash)(V);                                                     \
+                                                                               \
+        /* Priority function */                                                \
+        int (*pri)(V, V);                                                      \
+    };                                                                         \
+                                                                               \
+    /* BTreeSet Iterator */                                                    \
+    struct SNAME##_iter                                                        \
+    {                                                                          \
+        /* Target btreeset */                                                  \
+        struct SNAME *target;                                                  \
+                                                                               \
+        /* Leaf node where the cursor is currently at */                       \
+        struct SNAME##_leaf *cursor;                                           \
+                                                                               \
+        /* Position of the cursor inside its leaf node */                      \
+        size_t position;                                                       \
+                                                                               \
+        /* Keeps track of relative index to the iteration of elements */       \
+        size_t index;                                                          \
+                                                                               \
+        /* If the iterator has reached the start of the iteration */           \
+        bool start;                                                            \
+                                                                               \
+        /* If the iterator has reached the end of the iteration */             \
+        bool end;                                                              \
+    };                                                                         \
+                                                                               \
+    /* Collection Functions */                                                 \
+    /* Collection Allocation and Deallocation */                               \
+    struct SNAME *PFX##_new(struct SNAME##_fval *f_val);                       \
+    struct SNAME *PFX##_new_custom(struct SNAME##_fval *f_val,                 \
+                                   struct cmc_alloc_node *alloc,               \
+                                   struct cmc_callbacks *callbacks);           \
+    void PFX##_clear(struct SNAME *_set_);                                     \
+    void PFX##_free(struct SNAME *_set_);                                      \
+    /* Customization of Allocation and Callbacks */                            \
+    void PFX##_customize(struct SNAME *_set_, struct cmc_alloc_node *alloc,    \
+                         struct cmc_callbacks *callbacks);                     \
+    /* Collection Input and Output */                                          \
+    bool PFX##_insert(struct SNAME *_set_, V value);                           \
+    bool PFX##_remove(struct SNAME *_set_, V value);                           \
+    /* Element Access */                                                       \
+    bool PFX##_max(struct SNAME *_set_, V *value);                             \
+    bool PFX##_min(struct SNAME *_set_, V *value);                             \
+    /* Collection State */                                                     \
+    bool PFX##_contains(struct SNAME *_set_, V value);                         \
+    bool PFX##_empty(struct SNAME *_set_);                                     \
+    size_t PFX##_count(struct SNAME *_set_);                                   \
+    int PFX##_flag(struct SNAME *_set_);                                       \
+    /* Collection Utility */                                                   \
+    struct SNAME *PFX##_copy_of(struct SNAME *_set_);                          \
+    bool PFX##_equals(struct SNAME *_set1_, struct SNAME *_set2_);             \
+    struct cmc_string PFX##_to_string(struct SNAME *_set_);                    \
+    bool PFX##_print(struct SNAME *_set_, FILE *fptr);                         \
+    /* Set Operations */                                                       \
+    struct SNAME *PFX##_union(struct SNAME *_set1_, struct SNAME *_set2_);     \
+    struct SNAME *PFX##_intersection(struct SNAME *_set1_,                     \
+                                     struct SNAME *_set2_);                    \
+    struct SNAME *PFX##_difference(struct SNAME *_set1_,                       \
+                                   struct SNAME *_set2_);                      \
+    struct SNAME *PFX##_symmetric_difference(struct SNAME *_set1_,             \
+                                             struct SNAME *_set2_);            \
+    bool PFX##_is_subset(struct SNAME *_set1_, struct SNAME *_set2_);          \
+    bool PFX##_is_superset(struct SNAME *_set1_, struct SNAME *_set2_);        \
+    bool PFX##_is_proper_subset(struct SNAME *_set1_, struct SNAME *_set2_);   \
+    bool PFX##_is_proper_superset(struct SNAME *_set1_, struct SNAME *_set2_); \
+    bool PFX##_is_disjointset(struct SNAME *_set1_, struct SNAME *_set2_);     \
+                                                                               \
+    /* Iterator Functions */                                                   \
+    /* Iterator Initialization */                                              \
+    struct SNAME##_iter PFX##_iter_start(struct SNAME *target);                \
+    struct SNAME##_iter PFX##_iter_end(struct SNAME *target);                  \
+    /* Iterator State */                                                       \
+    bool PFX##_iter_at_start(struct SNAME##_iter *iter);                       \
+    bool PFX##_iter_at_end(struct SNAME##_iter *iter);                         \
+    /* Iterator Movement */                                                    \
+    bool PFX##_iter_to_start(struct SNAME##_iter *iter);                       \
+    bool PFX##_iter_to_end(struct SNAME##_iter *iter);                         \
+    bool PFX##_iter_next(struct SNAME##_iter *iter);                           \
+    bool PFX##_iter_prev(struct SNAME##_iter *iter);                           \
+    bool PFX##_iter_advance(struct SNAME##_iter *iter, size_t steps);          \
+    bool PFX##_iter_rewind(struct SNAME##_iter *iter, size_t steps);           \
+    bool PFX##_iter_go_to(struct SNAME##_iter *iter, size_t index);            \
+    /* Iterator Access */                                                      \
+    V PFX##_iter_value(struct SNAME##_iter *iter);                             \
+    size_t PFX##_iter_index(struct SNAME##_iter *iter);
+
+/* -------------------------------------------------------------------------
+ * Source
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_BTREESET_SOURCE(PFX, SNAME, V)                            \
+                                                                               \
+    /* Implementation Detail Functions */                                      \
+    static struct SNAME##_leaf *PFX##_impl_new_leaf(struct SNAME *_set_);      \
+    static struct SNAME##_inner *PFX##_impl_new_inner(struct SNAME *_set_);    \
+    static void PFX##_impl_free_node(struct SNAME *_set_,                      \
+                                     struct SNAME##_node *node);               \
+    static size_t PFX##_impl_lower(struct SNAME *_set_,                        \
+                                   struct SNAME##_node *node, V value);        \
+    static size_t PFX##_impl_upper(struct SNAME *_set_,                        \
+                                   struct SNAME##_node *node, V value);        \
+    static struct SNAME##_leaf *PFX##_impl_get_leaf(struct SNAME *_set_,       \
+                                                    V value, size_t *index);   \
+    static bool PFX##_impl_split_child(                                        \
+        struct SNAME *_set_, struct SNAME##_inner *parent, size_t index);      \
+    static size_t PFX##_impl_fill_child(                                       \
+        struct SNAME *_set_, struct SNAME##_inner *parent, size_t index);      \
+    static void PFX##_impl_merge_children(                                     \
+        struct SNAME *_set_, struct SNAME##_inner *parent, size_t index);      \
+    static void PFX##_impl_replace_separator(struct SNAME *_set_, V value,     \
+                                             V successor);                     \
+                                                                               \
+    struct SNAME *PFX##_new(struct SNAME##_fval *f_val)                        \
+    {                                                                          \
+        return PFX##_new_custom(f_val, NULL, NULL);                            \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_new_custom(struct SNAME##_fval *f_val,                 \
+                                   struct cmc_alloc_node *alloc,               \
+                                   struct cmc_callbacks *callbacks)            \
+    {                                                                          \
+        if (!f_val)                                                            \
+            return NULL;                                                       \
+                                                                               \
+        if (!alloc)                                                            \
+            alloc = &cmc_alloc_node_default;                                   \
+                                                                               \
+        struct SNAME *_set_ = alloc->malloc(sizeof(struct SNAME));             \
+                                                                               \
+        if (!_set_)                                                            \
+            return NULL;                                                       \
+                                                                               \
+        _set_->root = NULL;                                                    \
+        _set_->head = NULL;                                                    \
+        _set_->tail = NULL;                                                    \
+        _set_->count = 0;                                                      \
+        _set_->flag = cmc_flags.OK;                                            \
+        _set_->f_val = f_val;                                                  \
+        _set_->alloc = alloc;                                                  \
+        _set_->callbacks = callbacks;                                          \
+                                                                               \
+        return _set_;                                                          \
+    }                                                                          \
+                                                                               \
+    void PFX##_clear(struct SNAME *_set_)                                      \
+    {                                                                          \
+        if (_set_->f_val->free)                                                \
+        {                                                                      \
+            struct SNAME##_leaf *leaf = _set_->head;                           \
+                                                                               \
+            for (; leaf != NULL; leaf = leaf->next)                            \
+            {                                                                  \
+                for (size_t i = 0; i < leaf->node.length; i++)                 \
+                    _set_->f_val->free(leaf->node.values[i]);                  \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        if (_set_->root)                                                       \
+            PFX##_impl_free_node(_set_, _set_->root);                          \
+                                                                               \
+        _set_->root = NULL;                                                    \
+        _set_->head = NULL;                                                    \
+        _set_->tail = NULL;                                                    \
+        _set_->count = 0;                                                      \
+        _set_->flag = cmc_flags.OK;                                            \
+    }                                                                          \
+                                                                               \
+    void PFX##_free(struct SNAME *_set_)                                       \
+    {                                                                          \
+        PFX##_clear(_set_);                                                    \
+                                                                               \
+        _set_->alloc->free(_set_);                                             \
+    }                                                                          \
+                                                                               \
+    void PFX##_customize(struct SNAME *_set_, struct cmc_alloc_node *alloc,    \
+                         struct cmc_callbacks *callbacks)                      \
+    {                                                                          \
+        if (!alloc)                                                            \
+            _set_->alloc = &cmc_alloc_node_default;                            \
+        else                                                                   \
+            _set_->alloc = alloc;                                              \
+                                                                               \
+        _set_->callbacks = callbacks;                                          \
+                                                                               \
+        _set_->flag = cmc_flags.OK;                                            \
+    }                                                                          \
+                                                                               \
+    bool PFX##_insert(struct SNAME *_set_, V value)                            \
+    {                                                                          \
+        if (_set_->root == NULL)                                               \
+        {                                                                      \
+            struct SNAME##_leaf *leaf = PFX##_impl_new_leaf(_set_);            \
+                                                                               \
+            if (!leaf)                                                         \
+            {                                                                  \
+                _set_->flag = cmc_flags.ALLOC;                                 \
+                return false;                                                  \
+            }                                                                  \
+                                                                               \
+            _set_->root = &(leaf->node);                                       \
+            _set_->head = leaf;                                                \
+            _set_->tail = leaf;                                                \
+        }                                                                      \
+        else if (_set_->root->length == CMC_BTREE_MAX_KEYS)                    \
+        {                                                                      \
+            /* The tree only grows in height when the root is split */         \
+            struct SNAME##_inner *root = PFX##_impl_new_inner(_set_);          \
+                                                                               \
+            if (!root)                                                         \
+            {                                                                  \
+                _set_->flag = cmc_flags.ALLOC;                                 \
+                return false;                                                  \
+            }                                                                  \
+                                                                               \
+            root->children[0] = _set_->root;                                   \
+                                                                               \
+            if (!PFX##_impl_split_child(_set_, root, 0))                       \
+            {                                                                  \
+                _set_->alloc->free(root);                                      \
+                _set_->flag = cmc_flags.ALLOC;                                 \
+                return false;                                                  \
+            }                                                                  \
+                                                                               \
+            _set_->root = &(root->node);                                       \
+        }                                                                      \
+                                                                               \
+        /* Full nodes are split on the way down so that a parent always */     \
+        /* has room for a new separator */                                     \
+        struct SNAME##_node *scan = _set_->root;                               \
+                                                                               \
+        while (!scan->leaf)                                                    \
+        {                                                                      \
+            struct SNAME##_inner *inner = (struct SNAME##_inner *)scan;        \
+            size_t i = PFX##_impl_upper(_set_, scan, value);                   \
+                                                                               \
+            if (inner->children[i]->length == CMC_BTREE_MAX_KEYS)              \
+            {                                                                  \
+                if (!PFX##_impl_split_child(_set_, inner, i))                  \
+                {                                                              \
+                    _set_->flag = cmc_flags.ALLOC;                             \
+                    return false;                                              \
+                }                                                              \
+                                                                               \
+                if (_set_->f_val->cmp(scan->values[i], value) <= 0)            \
+                    i++;                                                       \
+            }                                                                  \
+                                                                               \
+            scan = inner->children[i];                                         \
+        }                                                                      \
+                                                                               \
+        size_t i = PFX##_impl_lower(_set_, scan, value);                       \
+                                                                               \
+        if (i < scan->length &&                                                \
+            _set_->f_val->cmp(scan->values[i], value) == 0)                    \
+        {                                                                      \
+            _set_->flag = cmc_flags.DUPLICATE;                                 \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        memmove(scan->values + i + 1, scan->values + i,                        \
+                (scan->length - i) * sizeof(V));                               \
+                                                                               \
+        scan->values[i] = value;                                               \
+        scan->length++;                                                        \
+                                                                               \
+        _set_->count++;                                                        \
+        _set_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        if (_set_->callbacks && _set_->callbacks->create)                      \
+            _set_->callbacks->create();                                        \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_remove(struct SNAME *_set_, V value)                            \
+    {                                                                          \
+        if (PFX##_empty(_set_))                                                \
+        {                                                                      \
+            _set_->flag = cmc_flags.EMPTY;                                     \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        /* Nodes with the minimum amount of elements are filled on the way */  \
+        /* down so that a leaf can always lose one element */                  \
+        struct SNAME##_node *scan = _set_->root;                               \
+                                                                               \
+        while (!scan->leaf)                                                    \
+        {                                                                      \
+            struct SNAME##_inner *inner = (struct SNAME##_inner *)scan;        \
+            size_t i = PFX##_impl_upper(_set_, scan, value);                   \
+                                                                               \
+            if (inner->children[i]->length == CMC_BTREE_MIN_KEYS)              \
+                i = PFX##_impl_fill_child(_set_, inner, i);                    \
+                                                                               \
+            struct SNAME##_node *child = inner->children[i];                   \
+                                                                               \
+            /* The tree only shrinks in height when the root is emptied */     \
+            if (scan->length == 0)                                             \
+            {                                                                  \
+                _set_->root = child;                                           \
+                _set_->alloc->free(inner);                                     \
+            }                                                                  \
+                                                                               \
+            scan = child;                                                      \
+        }                                                                      \
+                                                                               \
+        size_t i = PFX##_impl_lower(_set_, scan, value);                       \
+                                                                               \
+        if (i == scan->length ||                                               \
+            _set_->f_val->cmp(scan->values[i], value) != 0)                    \
+        {                                                                      \
+            _set_->flag = cmc_flags.NOT_FOUND;                                 \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        memmove(scan->values + i, scan->values + i + 1,                        \
+                (scan->length - i - 1) * sizeof(V));                           \
+                                                                               \
+        scan->length--;                                                        \
+        _set_->count--;                                                        \
+                                                                               \
+        /* The first value of a leaf might also be a separator in an inner */  \
+        /* node, which must not keep a value that now belongs to the caller */ \
+        if (i == 0 && scan->length > 0)                                        \
+            PFX##_impl_replace_separator(_set_, value, scan->values[0]);       \
+                                                                               \
+        if (_set_->count == 0)                                                 \
+        {                                                                      \
+            _set_->alloc->free(scan);                                          \
+                                                                               \
+            _set_->root = NULL;                                                \
+            _set_->head = NULL;                                                \
+            _set_->tail = NULL;                                                \
+        }                                                                      \
+                                                                               \
+        _set_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        if (_set_->callbacks && _set_->callbacks->delete)                      \
+            _set_->callbacks->delete ();                                       \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_max(struct SNAME *_set_, V *value)                              \
+    {                                                                          \
+        if (PFX##_empty(_set_))                                                \
+        {                                                                      \
+            _set_->flag = cmc_flags.EMPTY;                                     \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (value)                                                             \
+            *value = _set_->tail->node.values[_set_->tail->node.length - 1];   \
+                                                                               \
+        _set_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        if (_set_->callbacks && _set_->callbacks->read)                        \
+            _set_->callbacks->read();                                          \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_min(struct SNAME *_set_, V *value)                              \
+    {                                                                          \
+        if (PFX##_empty(_set_))                                                \
+        {                                                                      \
+            _set_->flag = cmc_flags.EMPTY;                                     \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (value)                                                             \
+            *value = _set_->head->node.values[0];                              \
+                                                                               \
+        _set_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        if (_set_->callbacks && _set_->callbacks->read)                        \
+            _set_->callbacks->read();                                          \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_contains(struct SNAME *_set_, V value)                          \
+    {                                                                          \
+        size_t index;                                                          \
+        bool result = PFX##_impl_get_leaf(_set_, value, &index) != NULL;       \
+                                                                               \
+        _set_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        if (_set_->callbacks && _set_->callbacks->read)                        \
+            _set_->callbacks->read();                                          \
+                                                                               \
+        return result;                                                         \
+    }                                                                          \
+                                                                               \
+    bool PFX##_empty(struct SNAME *_set_)                                      \
+    {                                                                          \
+        return _set_->count == 0;                                              \
+    }                                                                          \
+                                                                               \
+    size_t PFX##_count(struct SNAME *_set_)                                    \
+    {                                                                          \
+        return _set_->count;                                                   \
+    }                                                                          \
+                                                                               \
+    int PFX##_flag(struct SNAME *_set_)                                        \
+    {                                                                          \
+        return _set_->flag;                                                    \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_copy_of(struct SNAME *_set_)                           \
+    {                                                                          \
+        /* Callback will be added later */                                     \
+        struct SNAME *result =                                                 \
+            PFX##_new_custom(_set_->f_val, _set_->alloc, NULL);                \
+                                                                               \
+        if (!result)                                                           \
+        {                                                                      \
+            _set_->flag = cmc_flags.ERROR;                                     \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        struct SNAME##_leaf *leaf = _set_->head;                               \
+                                                                               \
+        for (; leaf != NULL; leaf = leaf->next)                                \
+        {                                                                      \
+            for (size_t i = 0; i < leaf->node.length; i++)                     \
+            {                                                                  \
+                V value = leaf->node.values[i];                                \
+                                                                               \
+                if (_set_->f_val->cpy)                                         \
+                    value = _set_->f_val->cpy(value);                          \
+                                                                               \
+                if (!PFX##_insert(result, value))                              \
+                {                                                              \
+                    PFX##_free(result);                                        \
+                    _set_->flag = cmc_flags.ALLOC;                             \
+                    return NULL;                                               \
+                }                                                              \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        result->callbacks = _set_->callbacks;                                  \
+        _set_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        return result;                                                         \
+    }                                                                          \
+                                                                               \
+    bool PFX##_equals(struct SNAME *_set1_, struct SNAME *_set2_)              \
+    {                                                                          \
+        _set1_->flag = cmc_flags.OK;                                           \
+        _set2_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_set1_->count != _set2_->count)                                    \
+            return false;                                                      \
+                                                                               \
+        /* Both sets are sorted so they can be compared in lockstep */         \
+        struct SNAME##_iter iter1 = PFX##_iter_start(_set1_);                  \
+        struct SNAME##_iter iter2 = PFX##_iter_start(_set2_);                  \
+                                                                               \
+        for (; !PFX##_iter_at_end(&iter1);                                     \
+             PFX##_iter_next(&iter1), PFX##_iter_next(&iter2))                 \
+        {                                                                      \
+            if (_set1_->f_val->cmp(PFX##_iter_value(&iter1),                   \
+                                   PFX##_iter_value(&iter2)) != 0)             \
+                return false;                                                  \
+        }                                                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    struct cmc_string PFX##_to_string(struct SNAME *_set_)                     \
+    {                                                                          \
+        struct cmc_string str;                                                 \
+        struct SNAME *s_ = _set_;                                              \
+                                                                               \
+        int n =                                                                \
+            snprintf(str.s, cmc_string_len, cmc_string_fmt_btreeset, #SNAME,   \
+                     #V, s_, s_->root, s_->head, s_->tail, s_->count,          \
+                     s_->flag, s_->f_val, s_->alloc, s_->callbacks);           \
+                                                                               \
+        return n >= 0 ? str : (struct cmc_string){ 0 };                        \
+    }                                                                          \
+                                                                               \
+    bool PFX##_print(struct SNAME *_set_, FILE *fptr)                          \
+    {                                                                          \
+        struct SNAME##_leaf *leaf = _set_->head;                               \
+                                                                               \
+        for (; leaf != NULL; leaf = leaf->next)                                \
+        {                                                                      \
+            for (size_t i = 0; i < leaf->node.length; i++)                     \
+            {                                                                  \
+                if (!_set_->f_val->str(fptr, leaf->node.values[i]))            \
+                    return false;                                              \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* All set operations walk both sets in order, like in a merge */          \
+    struct SNAME *PFX##_union(struct SNAME *_set1_, struct SNAME *_set2_)      \
+    {                                                                          \
+        struct SNAME *_set_r_ =                                                \
+            PFX##_new_custom(_set1_->f_val, _set1_->alloc, _set1_->callbacks); \
+                                                                               \
+        if (!_set_r_)                                                          \
+            return NULL;                                                       \
+                                                                               \
+        struct SNAME##_iter iter1 = PFX##_iter_start(_set1_);                  \
+        struct SNAME##_iter iter2 = PFX##_iter_start(_set2_);                  \
+                                                                               \
+        while (!PFX##_iter_at_end(&iter1) || !PFX##_iter_at_end(&iter2))       \
+        {                                                                      \
+            if (PFX##_iter_at_end(&iter1))                                     \
+            {                                                                  \
+                PFX##_insert(_set_r_, PFX##_iter_value(&iter2));               \
+                PFX##_iter_next(&iter2);                                       \
+                continue;                                                      \
+            }                                                                  \
+                                                                               \
+            if (PFX##_iter_at_end(&iter2))                                     \
+            {                                                                  \
+                PFX##_insert(_set_r_, PFX##_iter_value(&iter1));               \
+                PFX##_iter_next(&iter1);                                       \
+                continue;                                                      \
+            }                                                                  \
+                                                                               \
+            V value1 = PFX##_iter_value(&iter1);                               \
+            V value2 = PFX##_iter_value(&iter2);                               \
+                                                                               \
+            int c = _set1_->f_val->cmp(value1, value2);                        \
+                                                                               \
+            if (c <= 0)                                                        \
+            {                                                                  \
+                PFX##_insert(_set_r_, value1);                                 \
+                PFX##_iter_next(&iter1);                                       \
+                                                                               \
+                if (c == 0)                                                    \
+                    PFX##_iter_next(&iter2);                                   \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                PFX##_insert(_set_r_, value2);                                 \
+                PFX##_iter_next(&iter2);                                       \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        return _set_r_;                                                        \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_intersection(struct SNAME *_set1_,                     \
+                                     struct SNAME *_set2_)                     \
+    {                                                                          \
+        struct SNAME *_set_r_ =                                                \
+            PFX##_new_custom(_set1_->f_val, _set1_->alloc, _set1_->callbacks); \
+                                                                               \
+        if (!_set_r_)                                                          \
+            return NULL;                                                       \
+                                                                               \
+        struct SNAME##_iter iter1 = PFX##_iter_start(_set1_);                  \
+        struct SNAME##_iter iter2 = PFX##_iter_start(_set2_);                  \
+                                                                               \
+        while (!PFX##_iter_at_end(&iter1) && !PFX##_iter_at_end(&iter2))       \
+        {                                                                      \
+            V value1 = PFX##_iter_value(&iter1);                               \
+            V value2 = PFX##_iter_value(&iter2);                               \
+                                                                               \
+            int c = _set1_->f_val->cmp(value1, value2);                        \
+                                                                               \
+            if (c == 0)                                                        \
+            {                                                                  \
+                PFX##_insert(_set_r_, value1);                                 \
+                PFX##_iter_next(&iter1);                                       \
+                PFX##_iter_next(&iter2);                                       \
+            }                                                                  \
+            else if (c < 0)                                                    \
+                PFX##_iter_next(&iter1);                                       \
+            else                                                               \
+                PFX##_iter_next(&iter2);                                       \
+        }                                                                      \
+                                                                               \
+        return _set_r_;                                                        \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_difference(struct SNAME *_set1_, struct SNAME *_set2_) \
+    {                                                                          \
+        struct SNAME *_set_r_ =                                                \
+            PFX##_new_custom(_set1_->f_val, _set1_->alloc, _set1_->callbacks); \
+                                                                               \
+        if (!_set_r_)                                                          \
+            return NULL;                                                       \
+                                                                               \
+        struct SNAME##_iter iter1 = PFX##_iter_start(_set1_);                  \
+        struct SNAME##_iter iter2 = PFX##_iter_start(_set2_);                  \
+                                                                               \
+        while (!PFX##_iter_at_end(&iter1))                                     \
+        {                                                                      \
+            V value1 = PFX##_iter_value(&iter1);                               \
+                                                                               \
+            if (PFX##_iter_at_end(&iter2))                                     \
+            {                                                                  \
+                PFX##_insert(_set_r_, value1);                                 \
+                PFX##_iter_next(&iter1);                                       \
+                continue;                                                      \
+            }                                                                  \
+                                                                               \
+            int c = _set1_->f_val->cmp(value1, PFX##_iter_value(&iter2));      \
+                                                                               \
+            if (c < 0)                                                         \
+            {                                                                  \
+                PFX##_insert(_set_r_, value1);                                 \
+                PFX##_iter_next(&iter1);                                       \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                if (c == 0)                                                    \
+                    PFX##_iter_next(&iter1);                                   \
+                                                                               \
+                PFX##_iter_next(&iter2);                                       \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        return _set_r_;                                                        \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_symmetric_difference(struct SNAME *_set1_,             \
+                                             struct SNAME *_set2_)             \
+    {                                                                          \
+        struct SNAME *_set_r_ =                                                \
+            PFX##_new_custom(_set1_->f_val, _set1_->alloc, _set1_->callbacks); \
+                                                                               \
+        if (!_set_r_)                                                          \
+            return NULL;                                                       \
+                                                                               \
+        struct SNAME##_iter iter1 = PFX##_iter_start(_set1_);                  \
+        struct SNAME##_iter iter2 = PFX##_iter_start(_set2_);                  \
+                                                                               \
+        while (!PFX##_iter_at_end(&iter1) || !PFX##_iter_at_end(&iter2))       \
+        {                                                                      \
+            if (PFX##_iter_at_end(&iter1))                                     \
+            {                                                                  \
+                PFX##_insert(_set_r_, PFX##_iter_value(&iter2));               \
+                PFX##_iter_next(&iter2);                                       \
+                continue;                                                      \
+            }                                                                  \
+                                                                               \
+            if (PFX##_iter_at_end(&iter2))                                     \
+            {                                                                  \
+                PFX##_insert(_set_r_, PFX##_iter_value(&iter1));               \
+                PFX##_iter_next(&iter1);                                       \
+                continue;                                                      \
+            }                                                                  \
+                                                                               \
+            V value1 = PFX##_iter_value(&iter1);                               \
+            V value2 = PFX##_iter_value(&iter2);                               \
+                                                                               \
+            int c = _set1_->f_val->cmp(value1, value2);                        \
+                                                                               \
+            if (c == 0)                                                        \
+            {                                                                  \
+                PFX##_iter_next(&iter1);                                       \
+                PFX##_iter_next(&iter2);                                       \
+            }                                                                  \
+            else if (c < 0)                                                    \
+            {                                                                  \
+                PFX##_insert(_set_r_, value1);                                 \
+                PFX##_iter_next(&iter1);                                       \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                PFX##_insert(_set_r_, value2);                                 \
+                PFX##_iter_next(&iter2);                                       \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        return _set_r_;                                                        \
+    }                                                                          \
+                                                                               \
+    /* Is _set1_ a subset of _set2_ ? */                                       \
+    /* A set X is a subset of a set Y when: X <= Y */                          \
+    /* If X is a subset of Y, then Y is a superset of X */                     \
+    bool PFX##_is_subset(struct SNAME *_set1_, struct SNAME *_set2_)           \
+    {                                                                          \
+        /* If the cardinality of _set1_ is greater than that of _set2_ */      \
+        /* then it is safe to say that _set1_ can't be a subset of _set2_ */   \
+        if (_set1_->count > _set2_->count)                                     \
+            return false;                                                      \
+                                                                               \
+        /* The empty set is a subset of all sets */                            \
+        if (PFX##_empty(_set1_))                                               \
+            return true;                                                       \
+                                                                               \
+        struct SNAME##_iter iter1 = PFX##_iter_start(_set1_);                  \
+        struct SNAME##_iter iter2 = PFX##_iter_start(_set2_);                  \
+                                                                               \
+        while (!PFX##_iter_at_end(&iter1))                                     \
+        {                                                                      \
+            if (PFX##_iter_at_end(&iter2))                                     \
+                return false;                                                  \
+                                                                               \
+            int c = _set1_->f_val->cmp(PFX##_iter_value(&iter1),               \
+                                       PFX##_iter_value(&iter2));              \
+                                                                               \
+            /* An element of _set1_ was skipped in _set2_ */                   \
+            if (c < 0)                                                         \
+                return false;                                                  \
+                                                                               \
+            if (c == 0)                                                        \
+                PFX##_iter_next(&iter1);                                       \
+                                                                               \
+            PFX##_iter_next(&iter2);                                           \
+        }                                                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Is _set1_ a superset of _set2_ ? */                                     \
+    /* A set X is a superset of a set Y when: X >= Y */                        \
+    /* If X is a superset of Y, then Y is a subset of X */                     \
+    bool PFX##_is_superset(struct SNAME *_set1_, struct SNAME *_set2_)         \
+    {                                                                          \
+        return PFX##_is_subset(_set2_, _set1_);                                \
+    }                                                                          \
+                                                                               \
+    /* Is _set1_ a proper subset of _set2_ ? */                                \
+    /* A set X is a proper subset of a set Y when: X < Y */                    \
+    /* If X is a proper subset of Y, then Y is a proper superset of X */       \
+    bool PFX##_is_proper_subset(struct SNAME *_set1_, struct SNAME *_set2_)    \
+    {                                                                          \
+        /* If the cardinality of _set1_ is greater than or equal to that */    \
+        /* of _set2_, then it is safe to say that _set1_ can't be a proper */  \
+        /* subset of _set2_ */                                                 \
+        if (_set1_->count >= _set2_->count)                                    \
+            return false;                                                      \
+                                                                               \
+        return PFX##_is_subset(_set1_, _set2_);                                \
+    }                                                                          \
+                                                                               \
+    /* Is _set1_ a proper superset of _set2_ ? */                              \
+    /* A set X is a proper superset of a set Y when: X > Y */                  \
+    /* If X is a proper superset of Y, then Y is a proper subset of X */       \
+    bool PFX##_is_proper_superset(struct SNAME *_set1_, struct SNAME *_set2_)  \
+    {                                                                          \
+        return PFX##_is_proper_subset(_set2_, _set1_);                         \
+    }                                                                          \
+                                                                               \
+    /* Is _set1_ a disjointset of _set2_ ? */                                  \
+    /* A set X is a disjointset of a set Y if their intersection is empty, */  \
+    /* that is, if there are no elements in common between the two */          \
+    bool PFX##_is_disjointset(struct SNAME *_set1_, struct SNAME *_set2_)      \
+    {                                                                          \
+        struct SNAME##_iter iter1 = PFX##_iter_start(_set1_);                  \
+        struct SNAME##_iter iter2 = PFX##_iter_start(_set2_);                  \
+                                                                               \
+        while (!PFX##_iter_at_end(&iter1) && !PFX##_iter_at_end(&iter2))       \
+        {                                                                      \
+            int c = _set1_->f_val->cmp(PFX##_iter_value(&iter1),               \
+                                       PFX##_iter_value(&iter2));              \
+                                                                               \
+            if (c == 0)                                                        \
+                return false;                                                  \
+            else if (c < 0)                                                    \
+                PFX##_iter_next(&iter1);                                       \
+            else                                                               \
+                PFX##_iter_next(&iter2);                                       \
+        }                                                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    struct SNAME##_iter PFX##_iter_start(struct SNAME *target)                 \
+    {                                                                          \
+        struct SNAME##_iter iter;                                              \
+                                                                               \
+        iter.target = target;                                                  \
+        iter.cursor = target->head;                                            \
+        iter.position = 0;                                                     \
+        iter.index = 0;                                                        \
+        iter.start = true;                                                     \
+        iter.end = PFX##_empty(target);                                        \
+                                                                               \
+        return iter;                                                           \
+    }                                                                          \
+                                                                               \
+    struct SNAME##_iter PFX##_iter_end(struct SNAME *target)                   \
+    {                                                                          \
+        struct SNAME##_iter iter;                                              \
+                                                                               \
+        iter.target = target;                                                  \
+        iter.cursor = target->tail;                                            \
+        iter.position = 0;                                                     \
+        iter.index = 0;                                                        \
+        iter.start = PFX##_empty(target);                                      \
+        iter.end = true;                                                       \
+                                                                               \
+        if (!PFX##_empty(target))                                              \
+        {                                                                      \
+            iter.position = target->tail->node.length - 1;                     \
+            iter.index = target->count - 1;                                    \
+        }                                                                      \
+                                                                               \
+        return iter;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_at_start(struct SNAME##_iter *iter)                        \
+    {                                                                          \
+        return PFX##_empty(iter->target) || iter->start;                       \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_at_end(struct SNAME##_iter *iter)                          \
+    {                                                                          \
+        return PFX##_empty(iter->target) || iter->end;                         \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_to_start(struct SNAME##_iter *iter)                        \
+    {                                                                          \
+        if (!PFX##_empty(iter->target))                                        \
+        {                                                                      \
+            iter->cursor = iter->target->head;                                 \
+            iter->position = 0;                                                \
+            iter->index = 0;                                                   \
+            iter->start = true;                                                \
+            iter->end = PFX##_empty(iter->target);                             \
+                                                                               \
+            return true;                                                       \
+        }                                                                      \
+                                                                               \
+        return false;                                                          \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_to_end(struct SNAME##_iter *iter)                          \
+    {                                                                          \
+        if (!PFX##_empty(iter->target))                                        \
+        {                                                                      \
+            iter->cursor = iter->target->tail;                                 \
+            iter->position = iter->cursor->node.length - 1;                    \
+            iter->index = iter->target->count - 1;                             \
+            iter->start = PFX##_empty(iter->target);                           \
+            iter->end = true;                                                  \
+                                                                               \
+            return true;                                                       \
+        }                                                                      \
+                                                                               \
+        return false;                                                          \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_next(struct SNAME##_iter *iter)                            \
+    {                                                                          \
+        if (iter->end)                                                         \
+            return false;                                                      \
+                                                                               \
+        if (iter->index + 1 == iter->target->count)                            \
+        {                                                                      \
+            iter->end = true;                                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        iter->start = PFX##_empty(iter->target);                               \
+                                                                               \
+        if (++iter->position == iter->cursor->node.length)                     \
+        {                                                                      \
+            iter->cursor = iter->cursor->next;                                 \
+            iter->position = 0;                                                \
+        }                                                                      \
+                                                                               \
+        iter->index++;                                                         \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_prev(struct SNAME##_iter *iter)                            \
+    {                                                                          \
+        if (iter->start)                                                       \
+            return false;                                                      \
+                                                                               \
+        if (iter->index == 0)                                                  \
+        {                                                                      \
+            iter->start = true;                                                \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        iter->end = PFX##_empty(iter->target);                                 \
+                                                                               \
+        if (iter->position == 0)                                               \
+        {                                                                      \
+            iter->cursor = iter->cursor->prev;                                 \
+            iter->position = iter->cursor->node.length - 1;                    \
+        }                                                                      \
+        else                                                                   \
+            iter->position--;                                                  \
+                                                                               \
+        iter->index--;                                                         \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Returns true only if the iterator moved */                              \
+    bool PFX##_iter_advance(struct SNAME##_iter *iter, size_t steps)           \
+    {                                                                          \
+        if (iter->end)                                                         \
+            return false;                                                      \
+                                                                               \
+        if (iter->index + 1 == iter->target->count)                            \
+        {                                                                      \
+            iter->end = true;                                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (steps == 0 || iter->index + steps >= iter->target->count)          \
+            return false;                                                      \
+                                                                               \
+        iter->start = PFX##_empty(iter->target);                               \
+        iter->index += steps;                                                  \
+                                                                               \
+        /* Whole leaf nodes are skipped at once */                             \
+        steps += iter->position;                                               \
+                                                                               \
+        while (steps >= iter->cursor->node.length)                             \
+        {                                                                      \
+            steps -= iter->cursor->node.length;                                \
+            iter->cursor = iter->cursor->next;                                 \
+        }                                                                      \
+                                                                               \
+        iter->position = steps;                                                \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Returns true only if the iterator moved */                              \
+    bool PFX##_iter_rewind(struct SNAME##_iter *iter, size_t steps)            \
+    {                                                                          \
+        if (iter->start)                                                       \
+            return false;                                                      \
+                                                                               \
+        if (iter->index == 0)                                                  \
+        {                                                                      \
+            iter->start = true;                                                \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (steps == 0 || iter->index < steps)                                 \
+            return false;                                                      \
+                                                                               \
+        iter->end = PFX##_empty(iter->target);                                 \
+        iter->index -= steps;                                                  \
+                                                                               \
+        /* Whole leaf nodes are skipped at once */                             \
+        while (steps > iter->position)                                         \
+        {                                                                      \
+            steps -= iter->position + 1;                                       \
+            iter->cursor = iter->cursor->prev;                                 \
+            iter->position = iter->cursor->node.length - 1;                    \
+        }                                                                      \
+                                                                               \
+        iter->position -= steps;                                               \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Returns true only if the iterator was able to be positioned at the */   \
+    /* given index */                                                          \
+    bool PFX##_iter_go_to(struct SNAME##_iter *iter, size_t index)             \
+    {                                                                          \
+        if (index >= iter->target->count)                                      \
+            return false;                                                      \
+                                                                               \
+        if (iter->index > index)                                               \
+            return PFX##_iter_rewind(iter, iter->index - index);               \
+        else if (iter->index < index)                                          \
+            return PFX##_iter_advance(iter, index - iter->index);              \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    V PFX##_iter_value(struct SNAME##_iter *iter)                              \
+    {                                                                          \
+        if (PFX##_empty(iter->target))                                         \
+            return (V){ 0 };                                                   \
+                                                                               \
+        return iter->cursor->node.values[iter->position];                      \
+    }                                                                          \
+                                                                               \
+    size_t PFX##_iter_index(struct SNAME##_iter *iter)                         \
+    {                                                                          \
+        return iter->index;                                                    \
+    }                                                                          \
+                                                                               \
+    static struct SNAME##_leaf *PFX##_impl_new_leaf(struct SNAME *_set_)       \
+    {                                                                          \
+        struct SNAME##_leaf *leaf =                                            \
+            _set_->alloc->malloc(sizeof(struct SNAME##_leaf));                 \
+                                                                               \
+        if (!leaf)                                                             \
+            return NULL;                                                       \
+                                                                               \
+        leaf->node.length = 0;                                                 \
+        leaf->node.leaf = true;                                                \
+        leaf->prev = NULL;                                                     \
+        leaf->next = NULL;                                                     \
+                                                                               \
+        return leaf;                                                           \
+    }                                                                          \
+                                                                               \
+    static struct SNAME##_inner *PFX##_impl_new_inner(struct SNAME *_set_)     \
+    {                                                                          \
+        struct SNAME##_inner *inner =                                          \
+            _set_->alloc->malloc(sizeof(struct SNAME##_inner));                \
+                                                                               \
+        if (!inner)                                                            \
+            return NULL;                                                       \
+                                                                               \
+        inner->node.length = 0;                                                \
+        inner->node.leaf = false;                                              \
+                                                                               \
+        return inner;                                                          \
+    }                                                                          \
+                                                                               \
+    static void PFX##_impl_free_node(struct SNAME *_set_,                      \
+                                     struct SNAME##_node *node)                \
+    {                                                                          \
+        /* The height of the tree is very small so recursion is fine */        \
+        if (!node->leaf)                                                       \
+        {                                                                      \
+            struct SNAME##_inner *inner = (struct SNAME##_inner *)node;        \
+                                                                               \
+            for (size_t i = 0; i <= node->length; i++)                         \
+                PFX##_impl_free_node(_set_, inner->children[i]);               \
+        }                                                                      \
+                                                                               \
+        _set_->alloc->free(node);                                              \
+    }                                                                          \
+                                                                               \
+    /* Index of the first element in node that is greater than or equal to */  \
+    /* value */                                                                \
+    static size_t PFX##_impl_lower(struct SNAME *_set_,                        \
+                                   struct SNAME##_node *node, V value)         \
+    {                                                                          \
+        size_t low = 0, high = node->length;                                   \
+                                                                               \
+        while (low < high)                                                     \
+        {                                                                      \
+            size_t mid = low + (high - low) / 2;                               \
+                                                                               \
+            if (_set_->f_val->cmp(node->values[mid], value) < 0)               \
+                low = mid + 1;                                                 \
+            else                                                               \
+                high = mid;                                                    \
+        }                                                                      \
+                                                                               \
+        return low;                                                            \
+    }                                                                          \
+                                                                               \
+    /* Index of the first element in node that is greater than value */        \
+    static size_t PFX##_impl_upper(struct SNAME *_set_,                        \
+                                   struct SNAME##_node *node, V value)         \
+    {                                                                          \
+        size_t low = 0, high = node->length;                                   \
+                                                                               \
+        while (low < high)                                                     \
+        {                                                                      \
+            size_t mid = low + (high - low) / 2;                               \
+                                                                               \
+            if (_set_->f_val->cmp(node->values[mid], value) <= 0)              \
+                low = mid + 1;                                                 \
+            else                                                               \
+                high = mid;                                                    \
+        }                                                                      \
+                                                                               \
+        return low;                                                            \
+    }                                                                          \
+                                                                               \
+    static struct SNAME##_leaf *PFX##_impl_get_leaf(struct SNAME *_set_,       \
+                                                    V value, size_t *index)    \
+    {                                                                          \
+        struct SNAME##_node *scan = _set_->root;                               \
+                                                                               \
+        if (!scan)                                                             \
+            return NULL;                                                       \
+                                                                               \
+        while (!scan->leaf)                                                    \
+        {                                                                      \
+            struct SNAME##_inner *inner = (struct SNAME##_inner *)scan;        \
+                                                                               \
+            scan = inner->children[PFX##_impl_upper(_set_, scan, value)];      \
+        }                                                                      \
+                                                                               \
+        size_t i = PFX##_impl_lower(_set_, scan, value);                       \
+                                                                               \
+        if (i == scan->length ||                                               \
+            _set_->f_val->cmp(scan->values[i], value) != 0)                    \
+            return NULL;                                                       \
+                                                                               \
+        *index = i;                                                            \
+                                                                               \
+        return (struct SNAME##_leaf *)scan;                                    \
+    }                                                                          \
+                                                                               \
+    /* Splits the full child at index of parent in two nodes */                \
+    static bool PFX##_impl_split_child(                                        \
+        struct SNAME *_set_, struct SNAME##_inner *parent, size_t index)       \
+    {                                                                          \
+        struct SNAME##_node *child = parent->children[index];                  \
+        struct SNAME##_node *sibling;                                          \
+        V separator;                                                           \
+                                                                               \
+        if (child->leaf)                                                       \
+        {                                                                      \
+            struct SNAME##_leaf *left = (struct SNAME##_leaf *)child;          \
+            struct SNAME##_leaf *right = PFX##_impl_new_leaf(_set_);           \
+                                                                               \
+            if (!right)                                                        \
+                return false;                                                  \
+                                                                               \
+            /* Elements are copied to the right leaf and the first one of */   \
+            /* them is also copied up to the parent as a separator */          \
+            size_t from = CMC_BTREE_MIN_KEYS + 1;                              \
+            size_t length = child->length - from;                              \
+                                                                               \
+            memcpy(right->node.values, child->values + from,                   \
+                   length * sizeof(V));                                        \
+                                                                               \
+            right->node.length = length;                                       \
+            child->length = from;                                              \
+                                                                               \
+            right->prev = left;                                                \
+            right->next = left->next;                                          \
+                                                                               \
+            if (left->next)                                                    \
+                left->next->prev = right;                                      \
+            else                                                               \
+                _set_->tail = right;                                           \
+                                                                               \
+            left->next = right;                                                \
+                                                                               \
+            separator = right->node.values[0];                                 \
+            sibling = &(right->node);                                          \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            struct SNAME##_inner *left = (struct SNAME##_inner *)child;        \
+            struct SNAME##_inner *right = PFX##_impl_new_inner(_set_);         \
+                                                                               \
+            if (!right)                                                        \
+                return false;                                                  \
+                                                                               \
+            /* The median element is moved up to the parent */                 \
+            size_t from = CMC_BTREE_MIN_KEYS + 1;                              \
+            size_t length = child->length - from;                              \
+                                                                               \
+            memcpy(right->node.values, child->values + from,                   \
+                   length * sizeof(V));                                        \
+            memcpy(right->children, left->children + from,                     \
+                   (length + 1) * sizeof(struct SNAME##_node *));              \
+                                                                               \
+            right->node.length = length;                                       \
+            child->length = CMC_BTREE_MIN_KEYS;                                \
+                                                                               \
+            separator = child->values[CMC_BTREE_MIN_KEYS];                     \
+            sibling = &(right->node);                                          \
+        }                                                                      \
+                                                                               \
+        struct SNAME##_node *node = &(parent->node);                           \
+                                                                               \
+        memmove(node->values + index + 1, node->values + index,                \
+                (node->length - index) * sizeof(V));                           \
+        memmove(parent->children + index + 2, parent->children + index + 1,    \
+                (node->length - index) * sizeof(struct SNAME##_node *));       \
+                                                                               \
+        node->values[index] = separator;                                       \
+        parent->children[index + 1] = sibling;                                 \
+        node->length++;                                                        \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Makes sure that the child at index of parent has more than the */       \
+    /* minimum amount of elements by either borrowing an element from a */     \
+    /* sibling or merging with it. Returns the new index of that child. */     \
+    static size_t PFX##_impl_fill_child(                                       \
+        struct SNAME *_set_, struct SNAME##_inner *parent, size_t index)       \
+    {                                                                          \
+        struct SNAME##_node *node = &(parent->node);                           \
+        struct SNAME##_node *child = parent->children[index];                  \
+        struct SNAME##_node *left = NULL, *right = NULL;                       \
+                                                                               \
+        if (index > 0)                                                         \
+            left = parent->children[index - 1];                                \
+        if (index < node->length)                                              \
+            right = parent->children[index + 1];                               \
+                                                                               \
+        if (left && left->length > CMC_BTREE_MIN_KEYS)                         \
+        {                                                                      \
+            /* Borrow the greatest element from the left sibling */            \
+            memmove(child->values + 1, child->values,                          \
+                    child->length * sizeof(V));                                \
+                                                                               \
+            if (child->leaf)                                                   \
+            {                                                                  \
+                child->values[0] = left->values[left->length - 1];             \
+                                                                               \
+                node->values[index - 1] = child->values[0];                    \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                struct SNAME##_inner *c = (struct SNAME##_inner *)child;       \
+                struct SNAME##_inner *l = (struct SNAME##_inner *)left;        \
+                                                                               \
+                memmove(c->children + 1, c->children,                          \
+                        (child->length + 1) * sizeof(struct SNAME##_node *));  \
+                                                                               \
+                child->values[0] = node->values[index - 1];                    \
+                c->children[0] = l->children[left->length];                    \
+                                                                               \
+                node->values[index - 1] = left->values[left->length - 1];      \
+            }                                                                  \
+                                                                               \
+            child->length++;                                                   \
+            left->length--;                                                    \
+        }                                                                      \
+        else if (right && right->length > CMC_BTREE_MIN_KEYS)                  \
+        {                                                                      \
+            /* Borrow the smallest element from the right sibling */           \
+            if (child->leaf)                                                   \
+            {                                                                  \
+                child->values[child->length] = right->values[0];               \
+                                                                               \
+                memmove(right->values, right->values + 1,                      \
+                        (right->length - 1) * sizeof(V));                      \
+                                                                               \
+                node->values[index] = right->values[0];                        \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                struct SNAME##_inner *c = (struct SNAME##_inner *)child;       \
+                struct SNAME##_inner *r = (struct SNAME##_inner *)right;       \
+                                                                               \
+                child->values[child->length] = node->values[index];            \
+                c->children[child->length + 1] = r->children[0];               \
+                                                                               \
+                node->values[index] = right->values[0];                        \
+                                                                               \
+                memmove(right->values, right->values + 1,                      \
+                        (right->length - 1) * sizeof(V));                      \
+                memmove(r->children, r->children + 1,                          \
+                        right->length * sizeof(struct SNAME##_node *));        \
+            }                                                                  \
+                                                                               \
+            child->length++;                                                   \
+            right->length--;                                                   \
+        }                                                                      \
+        else if (right)                                                        \
+            PFX##_impl_merge_children(_set_, parent, index);                   \
+        else                                                                   \
+            PFX##_impl_merge_children(_set_, parent, --index);                 \
+                                                                               \
+        return index;                                                          \
+    }                                                                          \
+                                                                               \
+    /* Merges the children at index and index + 1 of parent */                 \
+    static void PFX##_impl_merge_children(                                     \
+        struct SNAME *_set_, struct SNAME##_inner *parent, size_t index)       \
+    {                                                                          \
+        struct SNAME##_node *node = &(parent->node);                           \
+        struct SNAME##_node *left = parent->children[index];                   \
+        struct SNAME##_node *right = parent->children[index + 1];              \
+                                                                               \
+        if (left->leaf)                                                        \
+        {                                                                      \
+            struct SNAME##_leaf *l = (struct SNAME##_leaf *)left;              \
+            struct SNAME##_leaf *r = (struct SNAME##_leaf *)right;             \
+                                                                               \
+            memcpy(left->values + left->length, right->values,                 \
+                   right->length * sizeof(V));                                 \
+                                                                               \
+            left->length += right->length;                                     \
+                                                                               \
+            l->next = r->next;                                                 \
+                                                                               \
+            if (r->next)                                                       \
+                r->next->prev = l;                                             \
+            else                                                               \
+                _set_->tail = l;                                               \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            struct SNAME##_inner *l = (struct SNAME##_inner *)left;            \
+            struct SNAME##_inner *r = (struct SNAME##_inner *)right;           \
+                                                                               \
+            /* The separator is moved down between the two nodes */            \
+            left->values[left->length] = node->values[index];                  \
+                                                                               \
+            memcpy(left->values + left->length + 1, right->values,             \
+                   right->length * sizeof(V));                                 \
+            memcpy(l->children + left->length + 1, r->children,                \
+                   (right->length + 1) * sizeof(struct SNAME##_node *));       \
+                                                                               \
+            left->length += right->length + 1;                                 \
+        }                                                                      \
+                                                                               \
+        memmove(node->values + index, node->values + index + 1,                \
+                (node->length - index - 1) * sizeof(V));                       \
+        memmove(parent->children + index + 1, parent->children + index + 2,    \
+                (node->length - index - 1) * sizeof(struct SNAME##_node *));   \
+                                                                               \
+        node->length--;                                                        \
+                                                                               \
+        _set_->alloc->free(right);                                             \
+    }                                                                          \
+                                                                               \
+    /* Replaces the separator equal to value, if there is one, with its */     \
+    /* successor. Separators are the first value of a subtree so there is */   \
+    /* at most one of them and it is on the way down to value */               \
+    static void PFX##_impl_replace_separator(struct SNAME *_set_, V value,     \
+                                             V successor)                      \
+    {                                                                          \
+        struct SNAME##_node *scan = _set_->root;                               \
+                                                                               \
+        while (!scan->leaf)                                                    \
+        {                                                                      \
+            size_t i = PFX##_impl_upper(_set_, scan, value);                   \
+                                                                               \
+            if (i > 0 && _set_->f_val->cmp(scan->values[i - 1], value) == 0)   \
+            {                                                                  \
+                scan->values[i - 1] = successor;                               \
+                return;                                                        \
+            }                                                                  \
+                                                                               \
+            scan = ((struct SNAME##_inner *)scan)->children[i];                \
+        }                                                                      \
+    }
+
+#endif /* CMC_BTREESET_H */
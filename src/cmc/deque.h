@@ -35,6 +35,7 @@
  * Core functionalities of the C Macro Collections Library
  * ------------------------------------------------------------------------- */
 #include "../cor/core.h"
+#include "../cor/search.h"
 
 /* -------------------------------------------------------------------------
  * Deque Specific
@@ -56,6 +57,12 @@ static const char *cmc_string_fmt_deque = "struct %s<%s> "
     CMC_GENERATE_DEQUE_HEADER(PFX, SNAME, V) \
     CMC_GENERATE_DEQUE_SOURCE(PFX, SNAME, V)
 
+/* Generates a Deque of plain old data, which is searched by comparing the */
+/* bytes of the elements instead of calling the comparator (see cor/search.h) */
+#define CMC_GENERATE_DEQUE_POD(PFX, SNAME, V) \
+    CMC_GENERATE_DEQUE_HEADER(PFX, SNAME, V)  \
+    CMC_GENERATE_DEQUE_SOURCE_POD(PFX, SNAME, V)
+
 #define CMC_WRAPGEN_DEQUE_HEADER(PFX, SNAME, K, V) \
     CMC_GENERATE_DEQUE_HEADER(PFX, SNAME, V)
 
@@ -95,6 +102,9 @@ static const char *cmc_string_fmt_deque = "struct %s<%s> "
                                                                               \
         /* Custom callback functions */                                       \
         struct cmc_callbacks *callbacks;                                      \
+                                                                              \
+        /* Growth policy of the buffer */                                     \
+        const struct cmc_growth *growth;                                      \
     };                                                                        \
                                                                               \
     struct SNAME##_fval                                                       \
@@ -153,11 +163,15 @@ static const char *cmc_string_fmt_deque = "struct %s<%s> "
     /* Customization of Allocation and Callbacks */                           \
     void PFX##_customize(struct SNAME *_deque_, struct cmc_alloc_node *alloc, \
                          struct cmc_callbacks *callbacks);                    \
+    void PFX##_set_growth(struct SNAME *_deque_,                              \
+                          const struct cmc_growth *growth);                   \
     /* Collection Input and Output */                                         \
     bool PFX##_push_front(struct SNAME *_deque_, V value);                    \
     bool PFX##_push_back(struct SNAME *_deque_, V value);                     \
     bool PFX##_pop_front(struct SNAME *_deque_);                              \
     bool PFX##_pop_back(struct SNAME *_deque_);                               \
+    bool PFX##_push_back_n(struct SNAME *_deque_, V *values, size_t n);       \
+    size_t PFX##_pop_front_n(struct SNAME *_deque_, V *out, size_t n);        \
     /* Element Access */                                                      \
     V PFX##_front(struct SNAME *_deque_);                                     \
     V PFX##_back(struct SNAME *_deque_);                                      \
@@ -170,6 +184,8 @@ static const char *cmc_string_fmt_deque = "struct %s<%s> "
     int PFX##_flag(struct SNAME *_deque_);                                    \
     /* Collection Utility */                                                  \
     bool PFX##_resize(struct SNAME *_deque_, size_t capacity);                \
+    bool PFX##_reserve(struct SNAME *_deque_, size_t size);                   \
+    bool PFX##_shrink_to_fit(struct SNAME *_deque_);                          \
     struct SNAME *PFX##_copy_of(struct SNAME *_deque_);                       \
     bool PFX##_equals(struct SNAME *_deque1_, struct SNAME *_deque2_);        \
     struct cmc_string PFX##_to_string(struct SNAME *_deque_);                 \
@@ -198,7 +214,15 @@ static const char *cmc_string_fmt_deque = "struct %s<%s> "
 /* -------------------------------------------------------------------------
  * Source
  * ------------------------------------------------------------------------- */
-#define CMC_GENERATE_DEQUE_SOURCE(PFX, SNAME, V)                               \
+#define CMC_GENERATE_DEQUE_SOURCE(PFX, SNAME, V) \
+    CMC_GENERATE_SEARCH(PFX, V)                  \
+    CMC_GENERATE_DEQUE_CORE_SOURCE(PFX, SNAME, V)
+
+#define CMC_GENERATE_DEQUE_SOURCE_POD(PFX, SNAME, V) \
+    CMC_GENERATE_SEARCH_POD(PFX, V)                  \
+    CMC_GENERATE_DEQUE_CORE_SOURCE(PFX, SNAME, V)
+
+#define CMC_GENERATE_DEQUE_CORE_SOURCE(PFX, SNAME, V)                          \
                                                                                \
     /* Implementation Detail Functions */                                      \
     /* None */                                                                 \
@@ -242,6 +266,7 @@ static const char *cmc_string_fmt_deque = "struct %s<%s> "
         _deque_->f_val = f_val;                                                \
         _deque_->alloc = alloc;                                                \
         _deque_->callbacks = callbacks;                                        \
+        _deque_->growth = NULL;                                                \
                                                                                \
         return _deque_;                                                        \
     }                                                                          \
@@ -279,6 +304,7 @@ static const char *cmc_string_fmt_deque = "struct %s<%s> "
         _deque_.f_val = f_val;                                                 \
         _deque_.alloc = alloc;                                                 \
         _deque_.callbacks = callbacks;                                         \
+        _deque_.growth = NULL;                                                 \
                                                                                \
         return _deque_;                                                        \
     }                                                                          \
@@ -348,11 +374,21 @@ static const char *cmc_string_fmt_deque = "struct %s<%s> "
         _deque_->flag = cmc_flags.OK;                                          \
     }                                                                          \
                                                                                \
+    /* Sets the growth policy used when the buffer is full (NULL for the */    \
+    /* default one) */                                                         \
+    void PFX##_set_growth(struct SNAME *_deque_,                               \
+                          const struct cmc_growth *growth)                     \
+    {                                                                          \
+        _deque_->growth = growth;                                              \
+                                                                               \
+        _deque_->flag = cmc_flags.OK;                                          \
+    }                                                                          \
+                                                                               \
     bool PFX##_push_front(struct SNAME *_deque_, V value)                      \
     {                                                                          \
         if (PFX##_full(_deque_))                                               \
         {                                                                      \
-            if (!PFX##_resize(_deque_, _deque_->capacity * 2))                 \
+            if (!PFX##_reserve(_deque_, 1))                                    \
                 return false;                                                  \
         }                                                                      \
                                                                                \
@@ -374,7 +410,7 @@ static const char *cmc_string_fmt_deque = "struct %s<%s> "
     {                                                                          \
         if (PFX##_full(_deque_))                                               \
         {                                                                      \
-            if (!PFX##_resize(_deque_, _deque_->capacity * 2))                 \
+            if (!PFX##_reserve(_deque_, 1))                                    \
                 return false;                                                  \
         }                                                                      \
                                                                                \
@@ -437,6 +473,76 @@ static const char *cmc_string_fmt_deque = "struct %s<%s> "
         return true;                                                           \
     }                                                                          \
                                                                                \
+    /* Pushes n values to the back of the deque, copying them in at most */    \
+    /* two parts split where the buffer wraps around */                        \
+    bool PFX##_push_back_n(struct SNAME *_deque_, V *values, size_t n)         \
+    {                                                                          \
+        if (n == 0)                                                            \
+        {                                                                      \
+            _deque_->flag = cmc_flags.OK;                                      \
+            return true;                                                       \
+        }                                                                      \
+                                                                               \
+        if (!PFX##_reserve(_deque_, n))                                        \
+            return false;                                                      \
+                                                                               \
+        size_t count1 = _deque_->capacity - _deque_->back;                     \
+                                                                               \
+        if (count1 > n)                                                        \
+            count1 = n;                                                        \
+                                                                               \
+        memcpy(_deque_->buffer + _deque_->back, values, sizeof(V) * count1);   \
+        memcpy(_deque_->buffer, values + count1, sizeof(V) * (n - count1));    \
+                                                                               \
+        _deque_->back = (_deque_->back + n) % _deque_->capacity;               \
+                                                                               \
+        _deque_->count += n;                                                   \
+        _deque_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        if (_deque_->callbacks && _deque_->callbacks->create)                  \
+            _deque_->callbacks->create();                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Pops up to n values from the front of the deque, copying them to out */ \
+    /* if it is not NULL, and returns how many were popped */                  \
+    size_t PFX##_pop_front_n(struct SNAME *_deque_, V *out, size_t n)          \
+    {                                                                          \
+        if (PFX##_empty(_deque_))                                              \
+        {                                                                      \
+            _deque_->flag = cmc_flags.EMPTY;                                   \
+            return 0;                                                          \
+        }                                                                      \
+                                                                               \
+        if (n > _deque_->count)                                                \
+            n = _deque_->count;                                                \
+                                                                               \
+        size_t count1 = _deque_->capacity - _deque_->front;                    \
+                                                                               \
+        if (count1 > n)                                                        \
+            count1 = n;                                                        \
+                                                                               \
+        if (out)                                                               \
+        {                                                                      \
+            memcpy(out, _deque_->buffer + _deque_->front, sizeof(V) * count1); \
+            memcpy(out + count1, _deque_->buffer, sizeof(V) * (n - count1));   \
+        }                                                                      \
+                                                                               \
+        memset(_deque_->buffer + _deque_->front, 0, sizeof(V) * count1);       \
+        memset(_deque_->buffer, 0, sizeof(V) * (n - count1));                  \
+                                                                               \
+        _deque_->front = (_deque_->front + n) % _deque_->capacity;             \
+                                                                               \
+        _deque_->count -= n;                                                   \
+        _deque_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        if (_deque_->callbacks && _deque_->callbacks->delete)                  \
+            _deque_->callbacks->delete ();                                     \
+                                                                               \
+        return n;                                                              \
+    }                                                                          \
+                                                                               \
     V PFX##_front(struct SNAME *_deque_)                                       \
     {                                                                          \
         if (PFX##_empty(_deque_))                                              \
@@ -474,18 +580,20 @@ static const char *cmc_string_fmt_deque = "struct %s<%s> "
     {                                                                          \
         _deque_->flag = cmc_flags.OK;                                          \
                                                                                \
-        bool result = false;                                                   \
+        /* The elements might wrap around the end of the buffer */             \
+        size_t count1 = _deque_->capacity - _deque_->front;                    \
+        size_t count2 = 0;                                                     \
                                                                                \
-        for (size_t i = _deque_->front, j = 0; j < _deque_->count; j++)        \
-        {                                                                      \
-            if (_deque_->f_val->cmp(_deque_->buffer[i], value) == 0)           \
-            {                                                                  \
-                result = true;                                                 \
-                break;                                                         \
-            }                                                                  \
+        if (count1 >= _deque_->count)                                          \
+            count1 = _deque_->count;                                           \
+        else                                                                   \
+            count2 = _deque_->count - count1;                                  \
                                                                                \
-            i = (i + 1) % _deque_->capacity;                                   \
-        }                                                                      \
+        bool result =                                                          \
+            PFX##_impl_search(_deque_->buffer + _deque_->front, count1, value, \
+                              _deque_->f_val->cmp) < count1 ||                 \
+            PFX##_impl_search(_deque_->buffer, count2, value,                  \
+                              _deque_->f_val->cmp) < count2;                   \
                                                                                \
         if (_deque_->callbacks && _deque_->callbacks->read)                    \
             _deque_->callbacks->read();                                        \
@@ -531,27 +639,68 @@ static const char *cmc_string_fmt_deque = "struct %s<%s> "
             return false;                                                      \
         }                                                                      \
                                                                                \
-        V *new_buffer = _deque_->alloc->malloc(sizeof(V) * capacity);          \
-                                                                               \
-        if (!new_buffer)                                                       \
+        if (capacity > _deque_->capacity)                                      \
         {                                                                      \
-            _deque_->flag = cmc_flags.ALLOC;                                   \
-            return false;                                                      \
-        }                                                                      \
+            /* Growing with realloc lets the allocator extend the buffer in */ \
+            /* place, or remap it when it is huge, instead of copying it */    \
+            V *new_buffer = _deque_->alloc->realloc(_deque_->buffer,           \
+                                                    sizeof(V) * capacity);     \
                                                                                \
-        for (size_t i = _deque_->front, j = 0; j < _deque_->count; j++)        \
-        {                                                                      \
-            new_buffer[j] = _deque_->buffer[i];                                \
+            if (!new_buffer)                                                   \
+            {                                                                  \
+                _deque_->flag = cmc_flags.ALLOC;                               \
+                return false;                                                  \
+            }                                                                  \
                                                                                \
-            i = (i + 1) % _deque_->capacity;                                   \
+            size_t old_capacity = _deque_->capacity;                           \
+                                                                               \
+            /* If the elements wrap around the end of the old buffer, the */   \
+            /* smaller of the two parts is moved to make them contiguous */    \
+            if (_deque_->front + _deque_->count > old_capacity)                \
+            {                                                                  \
+                size_t tail = old_capacity - _deque_->front;                   \
+                size_t head = _deque_->count - tail;                           \
+                                                                               \
+                if (head < tail && head <= capacity - old_capacity)            \
+                    memcpy(new_buffer + old_capacity, new_buffer,              \
+                           sizeof(V) * head);                                  \
+                else                                                           \
+                {                                                              \
+                    memmove(new_buffer + capacity - tail,                      \
+                            new_buffer + _deque_->front, sizeof(V) * tail);    \
+                                                                               \
+                    _deque_->front = capacity - tail;                          \
+                }                                                              \
+            }                                                                  \
+                                                                               \
+            _deque_->buffer = new_buffer;                                      \
+            _deque_->capacity = capacity;                                      \
+            _deque_->back = (_deque_->front + _deque_->count) % capacity;      \
         }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            V *new_buffer = _deque_->alloc->malloc(sizeof(V) * capacity);      \
                                                                                \
-        _deque_->alloc->free(_deque_->buffer);                                 \
+            if (!new_buffer)                                                   \
+            {                                                                  \
+                _deque_->flag = cmc_flags.ALLOC;                               \
+                return false;                                                  \
+            }                                                                  \
                                                                                \
-        _deque_->buffer = new_buffer;                                          \
-        _deque_->capacity = capacity;                                          \
-        _deque_->front = 0;                                                    \
-        _deque_->back = _deque_->count;                                        \
+            for (size_t i = _deque_->front, j = 0; j < _deque_->count; j++)    \
+            {                                                                  \
+                new_buffer[j] = _deque_->buffer[i];                            \
+                                                                               \
+                i = (i + 1) % _deque_->capacity;                               \
+            }                                                                  \
+                                                                               \
+            _deque_->alloc->free(_deque_->buffer);                             \
+                                                                               \
+            _deque_->buffer = new_buffer;                                      \
+            _deque_->capacity = capacity;                                      \
+            _deque_->front = 0;                                                \
+            _deque_->back = _deque_->count % capacity;                         \
+        }                                                                      \
                                                                                \
     success:                                                                   \
                                                                                \
@@ -561,6 +710,32 @@ static const char *cmc_string_fmt_deque = "struct %s<%s> "
         return true;                                                           \
     }                                                                          \
                                                                                \
+    /* Makes room for at least size more elements, growing the buffer */       \
+    /* according to the growth policy */                                       \
+    bool PFX##_reserve(struct SNAME *_deque_, size_t size)                     \
+    {                                                                          \
+        _deque_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        if (size <= _deque_->capacity - _deque_->count)                        \
+            return true;                                                       \
+                                                                               \
+        if (size > SIZE_MAX - _deque_->count)                                  \
+        {                                                                      \
+            _deque_->flag = cmc_flags.ERROR;                                   \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        return PFX##_resize(                                                   \
+            _deque_, cmc_growth_capacity(_deque_->growth, _deque_->capacity,   \
+                                         _deque_->count + size));              \
+    }                                                                          \
+                                                                               \
+    /* Reduces the capacity to the amount of elements */                       \
+    bool PFX##_shrink_to_fit(struct SNAME *_deque_)                            \
+    {                                                                          \
+        return PFX##_resize(_deque_, _deque_->count > 0 ? _deque_->count : 1); \
+    }                                                                          \
+                                                                               \
     struct SNAME *PFX##_copy_of(struct SNAME *_deque_)                         \
     {                                                                          \
         struct SNAME *result =                                                 \
@@ -593,6 +768,7 @@ static const char *cmc_string_fmt_deque = "struct %s<%s> "
         }                                                                      \
                                                                                \
         result->count = _deque_->count;                                        \
+        result->growth = _deque_->growth;                                      \
         result->front = 0;                                                     \
         result->back = _deque_->count;                                         \
                                                                                \
@@ -0,0 +1,1212 @@
+/**
+ * gapbuffer.h
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * GapBuffer
+ *
+ * A GapBuffer is a List (see list.h) that keeps its unused capacity as a gap
+ * inside the buffer instead of at its end. The elements before the gap are at
+ * the start of the buffer and the elements after the gap are at the end of the
+ * buffer. Inserting or removing elements at the gap only changes its bounds, so
+ * many edits around the same index cost O(1) each, while a List moves every
+ * element after that index on every edit.
+ *
+ * Before an element is inserted or removed at an index the gap is moved there,
+ * which moves as many elements as there are between that index and the gap
+ * (see move_gap). Accessing an element by its index is still O(1): elements
+ * before the gap are at their index in the buffer and elements after the gap
+ * are shifted by the size of the gap.
+ *
+ * It has the same functions as a List and they behave the same way. Sorting
+ * the whole GapBuffer moves its gap to the end.
+ */
+
+#ifndef CMC_GAPBUFFER_H
+#define CMC_GAPBUFFER_H
+
+/* -------------------------------------------------------------------------
+ * Core functionalities of the C Macro Collections Library
+ * ------------------------------------------------------------------------- */
+#include "../cor/core.h"
+#include "../cor/search.h"
+#include "../cor/sort.h"
+
+/* -------------------------------------------------------------------------
+ * GapBuffer specific
+ * ------------------------------------------------------------------------- */
+/* to_string format */
+static const char *cmc_string_fmt_gapbuffer = "struct %s<%s> "
+                                              "at %p { "
+                                              "buffer:%p, "
+                                              "capacity:%" PRIuMAX ", "
+                                              "count:%" PRIuMAX ", "
+                                              "gap:%" PRIuMAX ", "
+                                              "flag:%d, "
+                                              "f_val:%p, "
+                                              "alloc:%p, "
+                                              "callbacks:%p }";
+
+#define CMC_GENERATE_GAPBUFFER(PFX, SNAME, V)    \
+    CMC_GENERATE_GAPBUFFER_HEADER(PFX, SNAME, V) \
+    CMC_GENERATE_GAPBUFFER_SOURCE(PFX, SNAME, V)
+
+/* Generates a GapBuffer of plain old data, which is searched by comparing */
+/* the bytes of the elements instead of calling the comparator */
+/* (see cor/search.h) */
+#define CMC_GENERATE_GAPBUFFER_POD(PFX, SNAME, V) \
+    CMC_GENERATE_GAPBUFFER_HEADER(PFX, SNAME, V)  \
+    CMC_GENERATE_GAPBUFFER_SOURCE_POD(PFX, SNAME, V)
+
+#define CMC_WRAPGEN_GAPBUFFER_HEADER(PFX, SNAME, K, V) \
+    CMC_GENERATE_GAPBUFFER_HEADER(PFX, SNAME, V)
+
+#define CMC_WRAPGEN_GAPBUFFER_SOURCE(PFX, SNAME, K, V) \
+    CMC_GENERATE_GAPBUFFER_SOURCE(PFX, SNAME, V)
+
+/* -------------------------------------------------------------------------
+ * Header
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_GAPBUFFER_HEADER(PFX, SNAME, V)                           \
+                                                                               \
+    /* GapBuffer Structure */                                                  \
+    struct SNAME                                                               \
+    {                                                                          \
+        /* Dynamic array of elements with a gap in it */                       \
+        V *buffer;                                                             \
+                                                                               \
+        /* Current array capacity */                                           \
+        size_t capacity;                                                       \
+                                                                               \
+        /* Current amount of elements */                                       \
+        size_t count;                                                          \
+                                                                               \
+        /* Where the gap starts, which is the index of the element after it */ \
+        size_t gap;                                                            \
+                                                                               \
+        /* Flags indicating errors or success */                               \
+        int flag;                                                              \
+                                                                               \
+        /* Value function table */                                             \
+        struct SNAME##_fval *f_val;                                            \
+                                                                               \
+        /* Custom allocation functions */                                      \
+        struct cmc_alloc_node *alloc;                                          \
+                                                                               \
+        /* Custom callback functions */                                        \
+        struct cmc_callbacks *callbacks;                                       \
+                                                                               \
+        /* Growth policy of the buffer */                                      \
+        const struct cmc_growth *growth;                                       \
+    };                                                                         \
+                                                                               \
+    /* Value struct function table */                                          \
+    struct SNAME##_fval                                                        \
+    {                                                                          \
+        /* Comparator function */                                              \
+        int (*cmp)(V, V);                                                      \
+                                                                               \
+        /* Copy function */                                                    \
+        V (*cpy)(V);                                                           \
+                                                                               \
+        /* To string function */                                               \
+        bool (*str)(FILE *, V);                                                \
+                                                                               \
+        /* Free from memory function */                                        \
+        void (*free)(V);                                                       \
+                                                                               \
+        /* Hash function */                                                    \
+        size_t (*hash)(V);                                                     \
+                                                                               \
+        /* Priority function */                                                \
+        int (*pri)(V, V);                                                      \
+    };                                                                         \
+                                                                               \
+    /* GapBuffer Iterator */                                                   \
+    struct SNAME##_iter                                                        \
+    {                                                                          \
+        /* Target gap buffer */                                                \
+        struct SNAME *target;                                                  \
+                                                                               \
+        /* Cursor's position (index) */                                        \
+        size_t cursor;                                                         \
+                                                                               \
+        /* If the iterator has reached the start of the iteration */           \
+        bool start;                                                            \
+                                                                               \
+        /* If the iterator has reached the end of the iteration */             \
+        bool end;                                                              \
+    };                                                                         \
+                                                                               \
+    /* Collection Functions */                                                 \
+    /* Collection Allocation and Deallocation */                               \
+    struct SNAME *PFX##_new(size_t capacity, struct SNAME##_fval *f_val);      \
+    struct SNAME *PFX##_new_custom(                                            \
+        size_t capacity, struct SNAME##_fval *f_val,                           \
+        struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks);        \
+    void PFX##_clear(struct SNAME *_gbuf_);                                    \
+    void PFX##_free(struct SNAME *_gbuf_);                                     \
+    /* Customization of Allocation and Callbacks */                            \
+    void PFX##_customize(struct SNAME *_gbuf_, struct cmc_alloc_node *alloc,   \
+                         struct cmc_callbacks *callbacks);                     \
+    void PFX##_set_growth(struct SNAME *_gbuf_,                                \
+                          const struct cmc_growth *growth);                    \
+    /* Collection Input and Output */                                          \
+    bool PFX##_push_front(struct SNAME *_gbuf_, V value);                      \
+    bool PFX##_push_at(struct SNAME *_gbuf_, V value, size_t index);           \
+    bool PFX##_push_back(struct SNAME *_gbuf_, V value);                       \
+    bool PFX##_pop_front(struct SNAME *_gbuf_);                                \
+    bool PFX##_pop_at(struct SNAME *_gbuf_, size_t index);                     \
+    bool PFX##_pop_back(struct SNAME *_gbuf_);                                 \
+    /* Collection Sequence Input and Output */                                 \
+    bool PFX##_seq_push_front(struct SNAME *_gbuf_, V *values, size_t size);   \
+    bool PFX##_seq_push_at(struct SNAME *_gbuf_, V *values, size_t size,       \
+                           size_t index);                                      \
+    bool PFX##_seq_push_back(struct SNAME *_gbuf_, V *values, size_t size);    \
+    bool PFX##_seq_pop_at(struct SNAME *_gbuf_, size_t from, size_t to);       \
+    struct SNAME *PFX##_seq_sublist(struct SNAME *_gbuf_, size_t from,         \
+                                    size_t to);                                \
+    /* Element Access */                                                       \
+    V PFX##_front(struct SNAME *_gbuf_);                                       \
+    V PFX##_get(struct SNAME *_gbuf_, size_t index);                           \
+    V *PFX##_get_ref(struct SNAME *_gbuf_, size_t index);                      \
+    V PFX##_back(struct SNAME *_gbuf_);                                        \
+    size_t PFX##_index_of(struct SNAME *_gbuf_, V value, bool from_start);     \
+    /* Collection State */                                                     \
+    bool PFX##_contains(struct SNAME *_gbuf_, V value);                        \
+    bool PFX##_empty(struct SNAME *_gbuf_);                                    \
+    bool PFX##_full(struct SNAME *_gbuf_);                                     \
+    size_t PFX##_count(struct SNAME *_gbuf_);                                  \
+    bool PFX##_fits(struct SNAME *_gbuf_, size_t size);                        \
+    size_t PFX##_capacity(struct SNAME *_gbuf_);                               \
+    size_t PFX##_gap_index(struct SNAME *_gbuf_);                              \
+    int PFX##_flag(struct SNAME *_gbuf_);                                      \
+    /* Collection Utility */                                                   \
+    bool PFX##_move_gap(struct SNAME *_gbuf_, size_t index);                   \
+    bool PFX##_resize(struct SNAME *_gbuf_, size_t capacity);                  \
+    bool PFX##_reserve(struct SNAME *_gbuf_, size_t size);                     \
+    bool PFX##_shrink_to_fit(struct SNAME *_gbuf_);                            \
+    void PFX##_sort(struct SNAME *_gbuf_);                                     \
+    bool PFX##_sort_range(struct SNAME *_gbuf_, size_t from, size_t to);       \
+    struct SNAME *PFX##_copy_of(struct SNAME *_gbuf_);                         \
+    bool PFX##_equals(struct SNAME *_gbuf1_, struct SNAME *_gbuf2_);           \
+    struct cmc_string PFX##_to_string(struct SNAME *_gbuf_);                   \
+    bool PFX##_print(struct SNAME *_gbuf_, FILE *fptr);                        \
+                                                                               \
+    /* Iterator Functions */                                                   \
+    /* Iterator Initialization */                                              \
+    struct SNAME##_iter PFX##_iter_start(struct SNAME *target);                \
+    struct SNAME##_iter PFX##_iter_end(struct SNAME *target);                  \
+    /* Iterator State */                                                       \
+    bool PFX##_iter_at_start(struct SNAME##_iter *iter);                       \
+    bool PFX##_iter_at_end(struct SNAME##_iter *iter);                         \
+    /* Iterator Movement */                                                    \
+    bool PFX##_iter_to_start(struct SNAME##_iter *iter);                       \
+    bool PFX##_iter_to_end(struct SNAME##_iter *iter);                         \
+    bool PFX##_iter_next(struct SNAME##_iter *iter);                           \
+    bool PFX##_iter_prev(struct SNAME##_iter *iter);                           \
+    bool PFX##_iter_advance(struct SNAME##_iter *iter, size_t steps);          \
+    bool PFX##_iter_rewind(struct SNAME##_iter *iter, size_t steps);           \
+    bool PFX##_iter_go_to(struct SNAME##_iter *iter, size_t index);            \
+    /* Iterator Access */                                                      \
+    V PFX##_iter_value(struct SNAME##_iter *iter);                             \
+    V *PFX##_iter_rvalue(struct SNAME##_iter *iter);                           \
+    size_t PFX##_iter_index(struct SNAME##_iter *iter);
+
+/* -------------------------------------------------------------------------
+ * Source
+ * ------------------------------------------------------------------------- */
+/* Just like in list.h, the source is made of the search, the core functions */
+/* and the sort */
+#define CMC_GENERATE_GAPBUFFER_SOURCE(PFX, SNAME, V)  \
+    CMC_GENERATE_SEARCH(PFX, V)                       \
+    CMC_GENERATE_GAPBUFFER_CORE_SOURCE(PFX, SNAME, V) \
+    CMC_GENERATE_GAPBUFFER_SORT_SOURCE(PFX, SNAME, V)
+
+#define CMC_GENERATE_GAPBUFFER_SOURCE_POD(PFX, SNAME, V) \
+    CMC_GENERATE_SEARCH_POD(PFX, V)                      \
+    CMC_GENERATE_GAPBUFFER_CORE_SOURCE(PFX, SNAME, V)    \
+    CMC_GENERATE_GAPBUFFER_SORT_SOURCE(PFX, SNAME, V)
+
+#define CMC_GENERATE_GAPBUFFER_CORE_SOURCE(PFX, SNAME, V)                      \
+                                                                               \
+    /* Implementation Detail Functions */                                      \
+    static size_t PFX##_impl_position(struct SNAME *_gbuf_, size_t index);     \
+    static void PFX##_impl_sort_array(struct SNAME *_gbuf_, V *array,          \
+                                      size_t count);                           \
+                                                                               \
+    struct SNAME *PFX##_new(size_t capacity, struct SNAME##_fval *f_val)       \
+    {                                                                          \
+        struct cmc_alloc_node *alloc = &cmc_alloc_node_default;                \
+                                                                               \
+        if (capacity < 1)                                                      \
+            return NULL;                                                       \
+                                                                               \
+        struct SNAME *_gbuf_ = alloc->malloc(sizeof(struct SNAME));            \
+                                                                               \
+        if (!_gbuf_)                                                           \
+            return NULL;                                                       \
+                                                                               \
+        _gbuf_->buffer = alloc->calloc(capacity, sizeof(V));                   \
+                                                                               \
+        if (!_gbuf_->buffer)                                                   \
+        {                                                                      \
+            alloc->free(_gbuf_);                                               \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        _gbuf_->capacity = capacity;                                           \
+        _gbuf_->count = 0;                                                     \
+        _gbuf_->gap = 0;                                                       \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+        _gbuf_->f_val = f_val;                                                 \
+        _gbuf_->alloc = alloc;                                                 \
+        _gbuf_->callbacks = NULL;                                              \
+        _gbuf_->growth = NULL;                                                 \
+                                                                               \
+        return _gbuf_;                                                         \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_new_custom(                                            \
+        size_t capacity, struct SNAME##_fval *f_val,                           \
+        struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks)         \
+    {                                                                          \
+        if (capacity < 1)                                                      \
+            return NULL;                                                       \
+                                                                               \
+        if (!f_val)                                                            \
+            return NULL;                                                       \
+                                                                               \
+        if (!alloc)                                                            \
+            alloc = &cmc_alloc_node_default;                                   \
+                                                                               \
+        struct SNAME *_gbuf_ = alloc->malloc(sizeof(struct SNAME));            \
+                                                                               \
+        if (!_gbuf_)                                                           \
+            return NULL;                                                       \
+                                                                               \
+        _gbuf_->buffer = alloc->calloc(capacity, sizeof(V));                   \
+                                                                               \
+        if (!_gbuf_->buffer)                                                   \
+        {                                                                      \
+            alloc->free(_gbuf_);                                               \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        _gbuf_->capacity = capacity;                                           \
+        _gbuf_->count = 0;                                                     \
+        _gbuf_->gap = 0;                                                       \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+        _gbuf_->f_val = f_val;                                                 \
+        _gbuf_->alloc = alloc;                                                 \
+        _gbuf_->callbacks = callbacks;                                         \
+        _gbuf_->growth = NULL;                                                 \
+                                                                               \
+        return _gbuf_;                                                         \
+    }                                                                          \
+                                                                               \
+    void PFX##_clear(struct SNAME *_gbuf_)                                     \
+    {                                                                          \
+        if (_gbuf_->f_val->free)                                               \
+        {                                                                      \
+            for (size_t i = 0; i < _gbuf_->count; i++)                         \
+                _gbuf_->f_val->free(                                           \
+                    _gbuf_->buffer[PFX##_impl_position(_gbuf_, i)]);           \
+        }                                                                      \
+                                                                               \
+        memset(_gbuf_->buffer, 0, sizeof(V) * _gbuf_->capacity);               \
+                                                                               \
+        _gbuf_->count = 0;                                                     \
+        _gbuf_->gap = 0;                                                       \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+    }                                                                          \
+                                                                               \
+    void PFX##_free(struct SNAME *_gbuf_)                                      \
+    {                                                                          \
+        if (_gbuf_->f_val->free)                                               \
+        {                                                                      \
+            for (size_t i = 0; i < _gbuf_->count; i++)                         \
+                _gbuf_->f_val->free(                                           \
+                    _gbuf_->buffer[PFX##_impl_position(_gbuf_, i)]);           \
+        }                                                                      \
+                                                                               \
+        _gbuf_->alloc->free(_gbuf_->buffer);                                   \
+        _gbuf_->alloc->free(_gbuf_);                                           \
+    }                                                                          \
+                                                                               \
+    void PFX##_customize(struct SNAME *_gbuf_, struct cmc_alloc_node *alloc,   \
+                         struct cmc_callbacks *callbacks)                      \
+    {                                                                          \
+        if (!alloc)                                                            \
+            _gbuf_->alloc = &cmc_alloc_node_default;                           \
+        else                                                                   \
+            _gbuf_->alloc = alloc;                                             \
+                                                                               \
+        _gbuf_->callbacks = callbacks;                                         \
+                                                                               \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+    }                                                                          \
+                                                                               \
+    /* Sets the growth policy used when the buffer is full (NULL for the */    \
+    /* default one) */                                                         \
+    void PFX##_set_growth(struct SNAME *_gbuf_,                                \
+                          const struct cmc_growth *growth)                     \
+    {                                                                          \
+        _gbuf_->growth = growth;                                               \
+                                                                               \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_push_front(struct SNAME *_gbuf_, V value)                       \
+    {                                                                          \
+        return PFX##_push_at(_gbuf_, value, 0);                                \
+    }                                                                          \
+                                                                               \
+    bool PFX##_push_at(struct SNAME *_gbuf_, V value, size_t index)            \
+    {                                                                          \
+        if (index > _gbuf_->count)                                             \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.RANGE;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (PFX##_full(_gbuf_))                                                \
+        {                                                                      \
+            if (!PFX##_reserve(_gbuf_, 1))                                     \
+                return false;                                                  \
+        }                                                                      \
+                                                                               \
+        PFX##_move_gap(_gbuf_, index);                                         \
+                                                                               \
+        _gbuf_->buffer[_gbuf_->gap++] = value;                                 \
+        _gbuf_->count++;                                                       \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_gbuf_->callbacks && _gbuf_->callbacks->create)                    \
+            _gbuf_->callbacks->create();                                       \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_push_back(struct SNAME *_gbuf_, V value)                        \
+    {                                                                          \
+        return PFX##_push_at(_gbuf_, value, _gbuf_->count);                    \
+    }                                                                          \
+                                                                               \
+    bool PFX##_pop_front(struct SNAME *_gbuf_)                                 \
+    {                                                                          \
+        return PFX##_pop_at(_gbuf_, 0);                                        \
+    }                                                                          \
+                                                                               \
+    bool PFX##_pop_at(struct SNAME *_gbuf_, size_t index)                      \
+    {                                                                          \
+        if (PFX##_empty(_gbuf_))                                               \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.EMPTY;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (index >= _gbuf_->count)                                            \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.RANGE;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        /* Removes the element from whichever side of the gap it is, so */     \
+        /* that removing the elements before or after the gap one by one */    \
+        /* never moves the others */                                           \
+        if (index < _gbuf_->gap)                                               \
+        {                                                                      \
+            PFX##_move_gap(_gbuf_, index + 1);                                 \
+                                                                               \
+            _gbuf_->buffer[--_gbuf_->gap] = (V){ 0 };                          \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            PFX##_move_gap(_gbuf_, index);                                     \
+                                                                               \
+            _gbuf_->buffer[index + _gbuf_->capacity - _gbuf_->count] =         \
+                (V){ 0 };                                                      \
+        }                                                                      \
+                                                                               \
+        _gbuf_->count--;                                                       \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_gbuf_->callbacks && _gbuf_->callbacks->delete)                    \
+            _gbuf_->callbacks->delete ();                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_pop_back(struct SNAME *_gbuf_)                                  \
+    {                                                                          \
+        if (PFX##_empty(_gbuf_))                                               \
+            return false;                                                      \
+                                                                               \
+        return PFX##_pop_at(_gbuf_, _gbuf_->count - 1);                        \
+    }                                                                          \
+                                                                               \
+    bool PFX##_seq_push_front(struct SNAME *_gbuf_, V *values, size_t size)    \
+    {                                                                          \
+        return PFX##_seq_push_at(_gbuf_, values, size, 0);                     \
+    }                                                                          \
+                                                                               \
+    bool PFX##_seq_push_at(struct SNAME *_gbuf_, V *values, size_t size,       \
+                           size_t index)                                       \
+    {                                                                          \
+        if (size == 0)                                                         \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.INVALID;                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (index > _gbuf_->count)                                             \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.RANGE;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (!PFX##_fits(_gbuf_, size))                                         \
+        {                                                                      \
+            if (!PFX##_reserve(_gbuf_, size))                                  \
+                return false;                                                  \
+        }                                                                      \
+                                                                               \
+        PFX##_move_gap(_gbuf_, index);                                         \
+                                                                               \
+        memcpy(_gbuf_->buffer + _gbuf_->gap, values, size * sizeof(V));        \
+                                                                               \
+        _gbuf_->gap += size;                                                   \
+        _gbuf_->count += size;                                                 \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_gbuf_->callbacks && _gbuf_->callbacks->create)                    \
+            _gbuf_->callbacks->create();                                       \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_seq_push_back(struct SNAME *_gbuf_, V *values, size_t size)     \
+    {                                                                          \
+        return PFX##_seq_push_at(_gbuf_, values, size, _gbuf_->count);         \
+    }                                                                          \
+                                                                               \
+    bool PFX##_seq_pop_at(struct SNAME *_gbuf_, size_t from, size_t to)        \
+    {                                                                          \
+        if (from > to)                                                         \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.INVALID;                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (to >= _gbuf_->count)                                               \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.RANGE;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        size_t length = to - from + 1;                                         \
+                                                                               \
+        PFX##_move_gap(_gbuf_, from);                                          \
+                                                                               \
+        /* The elements to be removed are right after the gap */               \
+        memset(_gbuf_->buffer + from + _gbuf_->capacity - _gbuf_->count, 0,    \
+               length * sizeof(V));                                            \
+                                                                               \
+        _gbuf_->count -= length;                                               \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_gbuf_->callbacks && _gbuf_->callbacks->delete)                    \
+            _gbuf_->callbacks->delete ();                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_seq_sublist(struct SNAME *_gbuf_, size_t from,         \
+                                    size_t to)                                 \
+    {                                                                          \
+        if (from > to)                                                         \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.INVALID;                                  \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        if (to >= _gbuf_->count)                                               \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.RANGE;                                    \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        size_t length = to - from + 1;                                         \
+                                                                               \
+        struct SNAME *result = PFX##_new_custom(                               \
+            length, _gbuf_->f_val, _gbuf_->alloc, _gbuf_->callbacks);          \
+                                                                               \
+        if (!result)                                                           \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.ALLOC;                                    \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        PFX##_move_gap(_gbuf_, from);                                          \
+                                                                               \
+        V *values = _gbuf_->buffer + from + _gbuf_->capacity - _gbuf_->count;  \
+                                                                               \
+        memcpy(result->buffer, values, length * sizeof(V));                    \
+        memset(values, 0, length * sizeof(V));                                 \
+                                                                               \
+        _gbuf_->count -= length;                                               \
+        result->count = length;                                                \
+        result->gap = length;                                                  \
+                                                                               \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_gbuf_->callbacks && _gbuf_->callbacks->delete)                    \
+            _gbuf_->callbacks->delete ();                                      \
+                                                                               \
+        return result;                                                         \
+    }                                                                          \
+                                                                               \
+    V PFX##_front(struct SNAME *_gbuf_)                                        \
+    {                                                                          \
+        if (PFX##_empty(_gbuf_))                                               \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.EMPTY;                                    \
+            return (V){ 0 };                                                   \
+        }                                                                      \
+                                                                               \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_gbuf_->callbacks && _gbuf_->callbacks->read)                      \
+            _gbuf_->callbacks->read();                                         \
+                                                                               \
+        return _gbuf_->buffer[PFX##_impl_position(_gbuf_, 0)];                 \
+    }                                                                          \
+                                                                               \
+    V PFX##_get(struct SNAME *_gbuf_, size_t index)                            \
+    {                                                                          \
+        if (PFX##_empty(_gbuf_))                                               \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.EMPTY;                                    \
+            return (V){ 0 };                                                   \
+        }                                                                      \
+                                                                               \
+        if (index >= _gbuf_->count)                                            \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.RANGE;                                    \
+            return (V){ 0 };                                                   \
+        }                                                                      \
+                                                                               \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_gbuf_->callbacks && _gbuf_->callbacks->read)                      \
+            _gbuf_->callbacks->read();                                         \
+                                                                               \
+        return _gbuf_->buffer[PFX##_impl_position(_gbuf_, index)];             \
+    }                                                                          \
+                                                                               \
+    V *PFX##_get_ref(struct SNAME *_gbuf_, size_t index)                       \
+    {                                                                          \
+        if (PFX##_empty(_gbuf_))                                               \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.EMPTY;                                    \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        if (index >= _gbuf_->count)                                            \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.RANGE;                                    \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_gbuf_->callbacks && _gbuf_->callbacks->read)                      \
+            _gbuf_->callbacks->read();                                         \
+                                                                               \
+        return &(_gbuf_->buffer[PFX##_impl_position(_gbuf_, index)]);          \
+    }                                                                          \
+                                                                               \
+    V PFX##_back(struct SNAME *_gbuf_)                                         \
+    {                                                                          \
+        if (PFX##_empty(_gbuf_))                                               \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.EMPTY;                                    \
+            return (V){ 0 };                                                   \
+        }                                                                      \
+                                                                               \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_gbuf_->callbacks && _gbuf_->callbacks->read)                      \
+            _gbuf_->callbacks->read();                                         \
+                                                                               \
+        return _gbuf_->buffer[PFX##_impl_position(_gbuf_, _gbuf_->count - 1)]; \
+    }                                                                          \
+                                                                               \
+    /* Searches the elements before and after the gap without moving it */     \
+    size_t PFX##_index_of(struct SNAME *_gbuf_, V value, bool from_start)      \
+    {                                                                          \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        size_t gap = _gbuf_->gap;                                              \
+        size_t after = _gbuf_->count - gap;                                    \
+        V *tail = _gbuf_->buffer + _gbuf_->capacity - after;                   \
+                                                                               \
+        size_t result;                                                         \
+                                                                               \
+        if (from_start)                                                        \
+        {                                                                      \
+            result = PFX##_impl_search(_gbuf_->buffer, gap, value,             \
+                                       _gbuf_->f_val->cmp);                    \
+                                                                               \
+            if (result == gap)                                                 \
+                result +=                                                      \
+                    PFX##_impl_search(tail, after, value, _gbuf_->f_val->cmp); \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            result = PFX##_impl_search_last(tail, after, value,                \
+                                            _gbuf_->f_val->cmp);               \
+                                                                               \
+            if (result < after)                                                \
+                result += gap;                                                 \
+            else                                                               \
+            {                                                                  \
+                result = PFX##_impl_search_last(_gbuf_->buffer, gap, value,    \
+                                                _gbuf_->f_val->cmp);           \
+                                                                               \
+                if (result == gap)                                             \
+                    result = _gbuf_->count;                                    \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        if (_gbuf_->callbacks && _gbuf_->callbacks->read)                      \
+            _gbuf_->callbacks->read();                                         \
+                                                                               \
+        return result;                                                         \
+    }                                                                          \
+                                                                               \
+    bool PFX##_contains(struct SNAME *_gbuf_, V value)                         \
+    {                                                                          \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        size_t gap = _gbuf_->gap;                                              \
+        size_t after = _gbuf_->count - gap;                                    \
+        V *tail = _gbuf_->buffer + _gbuf_->capacity - after;                   \
+                                                                               \
+        bool result =                                                          \
+            PFX##_impl_search(_gbuf_->buffer, gap, value,                      \
+                              _gbuf_->f_val->cmp) < gap ||                     \
+            PFX##_impl_search(tail, after, value, _gbuf_->f_val->cmp) < after; \
+                                                                               \
+        if (_gbuf_->callbacks && _gbuf_->callbacks->read)                      \
+            _gbuf_->callbacks->read();                                         \
+                                                                               \
+        return result;                                                         \
+    }                                                                          \
+                                                                               \
+    bool PFX##_empty(struct SNAME *_gbuf_)                                     \
+    {                                                                          \
+        return _gbuf_->count == 0;                                             \
+    }                                                                          \
+                                                                               \
+    bool PFX##_full(struct SNAME *_gbuf_)                                      \
+    {                                                                          \
+        return _gbuf_->count >= _gbuf_->capacity;                              \
+    }                                                                          \
+                                                                               \
+    size_t PFX##_count(struct SNAME *_gbuf_)                                   \
+    {                                                                          \
+        return _gbuf_->count;                                                  \
+    }                                                                          \
+                                                                               \
+    bool PFX##_fits(struct SNAME *_gbuf_, size_t size)                         \
+    {                                                                          \
+        return _gbuf_->count + size <= _gbuf_->capacity;                       \
+    }                                                                          \
+                                                                               \
+    size_t PFX##_capacity(struct SNAME *_gbuf_)                                \
+    {                                                                          \
+        return _gbuf_->capacity;                                               \
+    }                                                                          \
+                                                                               \
+    /* Returns the index where the next element would be inserted without */   \
+    /* moving the gap */                                                       \
+    size_t PFX##_gap_index(struct SNAME *_gbuf_)                               \
+    {                                                                          \
+        return _gbuf_->gap;                                                    \
+    }                                                                          \
+                                                                               \
+    int PFX##_flag(struct SNAME *_gbuf_)                                       \
+    {                                                                          \
+        return _gbuf_->flag;                                                   \
+    }                                                                          \
+                                                                               \
+    /* Moves the gap to the given index, which can be the count of elements */ \
+    /* for the gap to be at the end. The elements between the old and the */   \
+    /* new index are moved to the other side of the gap. */                    \
+    bool PFX##_move_gap(struct SNAME *_gbuf_, size_t index)                    \
+    {                                                                          \
+        if (index > _gbuf_->count)                                             \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.RANGE;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        V *buffer = _gbuf_->buffer;                                            \
+        size_t gap = _gbuf_->gap;                                              \
+        size_t size = _gbuf_->capacity - _gbuf_->count;                        \
+                                                                               \
+        /* The slots that end up in the gap are zeroed just like the unused */ \
+        /* slots of a List */                                                  \
+        if (index < gap)                                                       \
+        {                                                                      \
+            size_t length = gap - index;                                       \
+                                                                               \
+            memmove(buffer + index + size, buffer + index,                     \
+                    length * sizeof(V));                                       \
+            memset(buffer + index, 0,                                          \
+                   (length < size ? length : size) * sizeof(V));               \
+        }                                                                      \
+        else if (index > gap)                                                  \
+        {                                                                      \
+            size_t length = index - gap;                                       \
+            size_t start = index > gap + size ? index : gap + size;            \
+                                                                               \
+            memmove(buffer + gap, buffer + gap + size, length * sizeof(V));    \
+            memset(buffer + start, 0, (index + size - start) * sizeof(V));     \
+        }                                                                      \
+                                                                               \
+        _gbuf_->gap = index;                                                   \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_resize(struct SNAME *_gbuf_, size_t capacity)                   \
+    {                                                                          \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_gbuf_->capacity == capacity)                                      \
+            return true;                                                       \
+                                                                               \
+        if (capacity < _gbuf_->count)                                          \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.INVALID;                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        /* The elements after the gap must stay at the end of the buffer */    \
+        size_t old_capacity = _gbuf_->capacity;                                \
+        size_t after = _gbuf_->count - _gbuf_->gap;                            \
+                                                                               \
+        if (capacity < old_capacity)                                           \
+        {                                                                      \
+            memmove(_gbuf_->buffer + capacity - after,                         \
+                    _gbuf_->buffer + old_capacity - after, after * sizeof(V)); \
+        }                                                                      \
+                                                                               \
+        V *new_buffer =                                                        \
+            _gbuf_->alloc->realloc(_gbuf_->buffer, sizeof(V) * capacity);      \
+                                                                               \
+        if (!new_buffer)                                                       \
+        {                                                                      \
+            if (capacity < old_capacity)                                       \
+            {                                                                  \
+                memmove(_gbuf_->buffer + old_capacity - after,                 \
+                        _gbuf_->buffer + capacity - after, after * sizeof(V)); \
+                memset(_gbuf_->buffer + _gbuf_->gap, 0,                        \
+                       (old_capacity - _gbuf_->count) * sizeof(V));            \
+            }                                                                  \
+                                                                               \
+            _gbuf_->flag = cmc_flags.ALLOC;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (capacity > old_capacity)                                           \
+        {                                                                      \
+            memmove(new_buffer + capacity - after,                             \
+                    new_buffer + old_capacity - after, after * sizeof(V));     \
+        }                                                                      \
+                                                                               \
+        memset(new_buffer + _gbuf_->gap, 0,                                    \
+               (capacity - _gbuf_->count) * sizeof(V));                        \
+                                                                               \
+        _gbuf_->buffer = new_buffer;                                           \
+        _gbuf_->capacity = capacity;                                           \
+                                                                               \
+        if (_gbuf_->callbacks && _gbuf_->callbacks->resize)                    \
+            _gbuf_->callbacks->resize();                                       \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Makes room for at least size more elements, growing the buffer */       \
+    /* according to the growth policy */                                       \
+    bool PFX##_reserve(struct SNAME *_gbuf_, size_t size)                      \
+    {                                                                          \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (size <= _gbuf_->capacity - _gbuf_->count)                          \
+            return true;                                                       \
+                                                                               \
+        if (size > SIZE_MAX - _gbuf_->count)                                   \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.ERROR;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        return PFX##_resize(                                                   \
+            _gbuf_, cmc_growth_capacity(_gbuf_->growth, _gbuf_->capacity,      \
+                                        _gbuf_->count + size));                \
+    }                                                                          \
+                                                                               \
+    /* Reduces the capacity to the amount of elements */                       \
+    bool PFX##_shrink_to_fit(struct SNAME *_gbuf_)                             \
+    {                                                                          \
+        return PFX##_resize(_gbuf_, _gbuf_->count > 0 ? _gbuf_->count : 1);    \
+    }                                                                          \
+                                                                               \
+    /* Sorts the gap buffer in ascending order, moving the gap to the end */   \
+    void PFX##_sort(struct SNAME *_gbuf_)                                      \
+    {                                                                          \
+        PFX##_move_gap(_gbuf_, _gbuf_->count);                                 \
+                                                                               \
+        PFX##_impl_sort_array(_gbuf_, _gbuf_->buffer, _gbuf_->count);          \
+                                                                               \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_gbuf_->callbacks && _gbuf_->callbacks->update)                    \
+            _gbuf_->callbacks->update();                                       \
+    }                                                                          \
+                                                                               \
+    /* Sorts the elements in the range [from, to] in ascending order. The */   \
+    /* gap is only moved if it is inside of the range. */                      \
+    bool PFX##_sort_range(struct SNAME *_gbuf_, size_t from, size_t to)        \
+    {                                                                          \
+        if (from > to)                                                         \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.INVALID;                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (to >= _gbuf_->count)                                               \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.RANGE;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (_gbuf_->gap > from && _gbuf_->gap <= to)                           \
+            PFX##_move_gap(_gbuf_, to + 1);                                    \
+                                                                               \
+        PFX##_impl_sort_array(                                                 \
+            _gbuf_, _gbuf_->buffer + PFX##_impl_position(_gbuf_, from),        \
+            to - from + 1);                                                    \
+                                                                               \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_gbuf_->callbacks && _gbuf_->callbacks->update)                    \
+            _gbuf_->callbacks->update();                                       \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_copy_of(struct SNAME *_gbuf_)                          \
+    {                                                                          \
+        struct SNAME *result =                                                 \
+            PFX##_new_custom(_gbuf_->capacity, _gbuf_->f_val, _gbuf_->alloc,   \
+                             _gbuf_->callbacks);                               \
+                                                                               \
+        if (!result)                                                           \
+        {                                                                      \
+            _gbuf_->flag = cmc_flags.ALLOC;                                    \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        /* The copy keeps its gap at the same index */                         \
+        size_t after = _gbuf_->count - _gbuf_->gap;                            \
+        size_t tail = _gbuf_->capacity - after;                                \
+                                                                               \
+        if (_gbuf_->f_val->cpy)                                                \
+        {                                                                      \
+            for (size_t i = 0; i < _gbuf_->count; i++)                         \
+            {                                                                  \
+                size_t j = PFX##_impl_position(_gbuf_, i);                     \
+                                                                               \
+                result->buffer[j] = _gbuf_->f_val->cpy(_gbuf_->buffer[j]);     \
+            }                                                                  \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            memcpy(result->buffer, _gbuf_->buffer, sizeof(V) * _gbuf_->gap);   \
+            memcpy(result->buffer + tail, _gbuf_->buffer + tail,               \
+                   sizeof(V) * after);                                         \
+        }                                                                      \
+                                                                               \
+        result->count = _gbuf_->count;                                         \
+        result->gap = _gbuf_->gap;                                             \
+        result->growth = _gbuf_->growth;                                       \
+                                                                               \
+        _gbuf_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        return result;                                                         \
+    }                                                                          \
+                                                                               \
+    bool PFX##_equals(struct SNAME *_gbuf1_, struct SNAME *_gbuf2_)            \
+    {                                                                          \
+        _gbuf1_->flag = cmc_flags.OK;                                          \
+        _gbuf2_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        if (_gbuf1_->count != _gbuf2_->count)                                  \
+            return false;                                                      \
+                                                                               \
+        for (size_t i = 0; i < _gbuf1_->count; i++)                            \
+        {                                                                      \
+            V value1 = _gbuf1_->buffer[PFX##_impl_position(_gbuf1_, i)];       \
+            V value2 = _gbuf2_->buffer[PFX##_impl_position(_gbuf2_, i)];       \
+                                                                               \
+            if (_gbuf1_->f_val->cmp(value1, value2) != 0)                      \
+                return false;                                                  \
+        }                                                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    struct cmc_string PFX##_to_string(struct SNAME *_gbuf_)                    \
+    {                                                                          \
+        struct cmc_string str;                                                 \
+        struct SNAME *g_ = _gbuf_;                                             \
+                                                                               \
+        int n =                                                                \
+            snprintf(str.s, cmc_string_len, cmc_string_fmt_gapbuffer, #SNAME,  \
+                     #V, g_, g_->buffer, g_->capacity, g_->count, g_->gap,     \
+                     g_->flag, g_->f_val, g_->alloc, g_->callbacks);           \
+                                                                               \
+        return n >= 0 ? str : (struct cmc_string){ 0 };                        \
+    }                                                                          \
+                                                                               \
+    bool PFX##_print(struct SNAME *_gbuf_, FILE *fptr)                         \
+    {                                                                          \
+        for (size_t i = 0; i < _gbuf_->count; i++)                             \
+        {                                                                      \
+            V value = _gbuf_->buffer[PFX##_impl_position(_gbuf_, i)];          \
+                                                                               \
+            if (!_gbuf_->f_val->str(fptr, value))                              \
+                return false;                                                  \
+        }                                                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    struct SNAME##_iter PFX##_iter_start(struct SNAME *target)                 \
+    {                                                                          \
+        struct SNAME##_iter iter;                                              \
+                                                                               \
+        iter.target = target;                                                  \
+        iter.cursor = 0;                                                       \
+        iter.start = true;                                                     \
+        iter.end = PFX##_empty(target);                                        \
+                                                                               \
+        return iter;                                                           \
+    }                                                                          \
+                                                                               \
+    struct SNAME##_iter PFX##_iter_end(struct SNAME *target)                   \
+    {                                                                          \
+        struct SNAME##_iter iter;                                              \
+                                                                               \
+        iter.target = target;                                                  \
+        iter.cursor = 0;                                                       \
+        iter.start = PFX##_empty(target);                                      \
+        iter.end = true;                                                       \
+                                                                               \
+        if (!PFX##_empty(target))                                              \
+            iter.cursor = target->count - 1;                                   \
+                                                                               \
+        return iter;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_at_start(struct SNAME##_iter *iter)                        \
+    {                                                                          \
+        return PFX##_empty(iter->target) || iter->start;                       \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_at_end(struct SNAME##_iter *iter)                          \
+    {                                                                          \
+        return PFX##_empty(iter->target) || iter->end;                         \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_to_start(struct SNAME##_iter *iter)                        \
+    {                                                                          \
+        if (!PFX##_empty(iter->target))                                        \
+        {                                                                      \
+            iter->cursor = 0;                                                  \
+            iter->start = true;                                                \
+            iter->end = PFX##_empty(iter->target);                             \
+                                                                               \
+            return true;                                                       \
+        }                                                                      \
+                                                                               \
+        return false;                                                          \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_to_end(struct SNAME##_iter *iter)                          \
+    {                                                                          \
+        if (!PFX##_empty(iter->target))                                        \
+        {                                                                      \
+            iter->start = PFX##_empty(iter->target);                           \
+            iter->cursor = iter->target->count - 1;                            \
+            iter->end = true;                                                  \
+                                                                               \
+            return true;                                                       \
+        }                                                                      \
+                                                                               \
+        return false;                                                          \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_next(struct SNAME##_iter *iter)                            \
+    {                                                                          \
+        if (iter->end)                                                         \
+            return false;                                                      \
+                                                                               \
+        if (iter->cursor + 1 == iter->target->count)                           \
+        {                                                                      \
+            iter->end = true;                                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        iter->start = PFX##_empty(iter->target);                               \
+                                                                               \
+        iter->cursor++;                                                        \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_prev(struct SNAME##_iter *iter)                            \
+    {                                                                          \
+        if (iter->start)                                                       \
+            return false;                                                      \
+                                                                               \
+        if (iter->cursor == 0)                                                 \
+        {                                                                      \
+            iter->start = true;                                                \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        iter->end = PFX##_empty(iter->target);                                 \
+                                                                               \
+        iter->cursor--;                                                        \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Returns true only if the iterator moved */                              \
+    bool PFX##_iter_advance(struct SNAME##_iter *iter, size_t steps)           \
+    {                                                                          \
+        if (iter->end)                                                         \
+            return false;                                                      \
+                                                                               \
+        if (iter->cursor + 1 == iter->target->count)                           \
+        {                                                                      \
+            iter->end = true;                                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (steps == 0 || iter->cursor + steps >= iter->target->count)         \
+            return false;                                                      \
+                                                                               \
+        iter->start = PFX##_empty(iter->target);                               \
+                                                                               \
+        iter->cursor += steps;                                                 \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Returns true only if the iterator moved */                              \
+    bool PFX##_iter_rewind(struct SNAME##_iter *iter, size_t steps)            \
+    {                                                                          \
+        if (iter->start)                                                       \
+            return false;                                                      \
+                                                                               \
+        if (iter->cursor == 0)                                                 \
+        {                                                                      \
+            iter->start = true;                                                \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (steps == 0 || iter->cursor < steps)                                \
+            return false;                                                      \
+                                                                               \
+        iter->end = PFX##_empty(iter->target);                                 \
+                                                                               \
+        iter->cursor -= steps;                                                 \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Returns true only if the iterator was able to be positioned at the */   \
+    /* given index */                                                          \
+    bool PFX##_iter_go_to(struct SNAME##_iter *iter, size_t index)             \
+    {                                                                          \
+        if (index >= iter->target->count)                                      \
+            return false;                                                      \
+                                                                               \
+        if (iter->cursor > index)                                              \
+            return PFX##_iter_rewind(iter, iter->cursor - index);              \
+        else if (iter->cursor < index)                                         \
+            return PFX##_iter_advance(iter, index - iter->cursor);             \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    V PFX##_iter_value(struct SNAME##_iter *iter)                              \
+    {                                                                          \
+        if (PFX##_empty(iter->target))                                         \
+            return (V){ 0 };                                                   \
+                                                                               \
+        return iter->target                                                    \
+            ->buffer[PFX##_impl_position(iter->target, iter->cursor)];         \
+    }                                                                          \
+                                                                               \
+    V *PFX##_iter_rvalue(struct SNAME##_iter *iter)                            \
+    {                                                                          \
+        if (PFX##_empty(iter->target))                                         \
+            return NULL;                                                       \
+                                                                               \
+        return &(iter->target->buffer[PFX##_impl_position(iter->target,        \
+                                                          iter->cursor)]);     \
+    }                                                                          \
+                                                                               \
+    size_t PFX##_iter_index(struct SNAME##_iter *iter)                         \
+    {                                                                          \
+        return iter->cursor;                                                   \
+    }                                                                          \
+                                                                               \
+    /* Maps an index to its position in the buffer, skipping the gap */        \
+    static size_t PFX##_impl_position(struct SNAME *_gbuf_, size_t index)      \
+    {                                                                          \
+        if (index < _gbuf_->gap)                                               \
+            return index;                                                      \
+                                                                               \
+        return index + _gbuf_->capacity - _gbuf_->count;                       \
+    }
+
+/* -------------------------------------------------------------------------
+ * Sort Source
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_GAPBUFFER_SORT_SOURCE(PFX, SNAME, V)             \
+                                                                      \
+    CMC_GENERATE_SORT(PFX, V)                                         \
+                                                                      \
+    static void PFX##_impl_sort_array(struct SNAME *_gbuf_, V *array, \
+                                      size_t count)                   \
+    {                                                                 \
+        PFX##_impl_sort(array, count, _gbuf_->f_val->cmp);            \
+    }
+
+#endif /* CMC_GAPBUFFER_H */
@@ -25,6 +25,18 @@
  *     - insert : Adds an element to the heap
  *     - remove_(min/max): Removes the min/max element from the heap
  *     - min/max : Accesses the min/max element from the heap
+ *
+ * By default each node has two children. CMC_GENERATE_HEAP_DARY generates a
+ * d-ary heap instead, where the children of the node at index i are at
+ * indexes i * D + 1 to i * D + D. A 4-ary or 8-ary heap of small values has
+ * all the children of a node in one or two cache lines, which makes large
+ * heaps faster. The arity doesn't change the API.
+ *
+ * A heap can also be built from many elements at once with from_array and
+ * insert_many, which use Floyd's bottom-up construction in O(n) instead of
+ * O(n log n) from inserting them one by one. heap_sort sorts the buffer in
+ * place and drain_sorted copies every element to an array in the order they
+ * would be removed, leaving the heap empty.
  */
 
 #ifndef CMC_HEAP_H
@@ -34,22 +46,7 @@
  * Core functionalities of the C Macro Collections Library
  * ------------------------------------------------------------------------- */
 #include "../cor/core.h"
-
-/* -------------------------------------------------------------------------
- * Heap Implementation
- * ------------------------------------------------------------------------- */
-/**
- * enum cmc_heap_order
- *
- * Defines the two possible heaps:
- * - Max Heap has the greatest element at the top
- * - Min Heap has the smallest element at the top
- */
-enum cmc_heap_order
-{
-    cmc_max_heap = 1,
-    cmc_min_heap = -1
-};
+#include "../cor/heap.h"
 
 /* -------------------------------------------------------------------------
  * Heap specific
@@ -70,6 +67,14 @@ static const char *cmc_string_fmt_heap = "struct %s<%s> "
     CMC_GENERATE_HEAP_HEADER(PFX, SNAME, V) \
     CMC_GENERATE_HEAP_SOURCE(PFX, SNAME, V)
 
+/* Generates a heap where each node has D children, which must be at least 2 */
+#define CMC_GENERATE_HEAP_DARY(PFX, SNAME, V, D) \
+    CMC_GENERATE_HEAP_HEADER(PFX, SNAME, V)      \
+    CMC_GENERATE_HEAP_DARY_SOURCE(PFX, SNAME, V, D)
+
+#define CMC_GENERATE_HEAP_SOURCE(PFX, SNAME, V) \
+    CMC_GENERATE_HEAP_DARY_SOURCE(PFX, SNAME, V, 2)
+
 #define CMC_WRAPGEN_HEAP_HEADER(PFX, SNAME, K, V) \
     CMC_GENERATE_HEAP_HEADER(PFX, SNAME, V)
 
@@ -107,6 +112,9 @@ static const char *cmc_string_fmt_heap = "struct %s<%s> "
                                                                              \
         /* Custom callback functions */                                      \
         struct cmc_callbacks *callbacks;                                     \
+                                                                             \
+        /* Growth policy of the buffer */                                    \
+        const struct cmc_growth *growth;                                     \
     };                                                                       \
                                                                              \
     /* Value struct function table */                                        \
@@ -154,13 +162,19 @@ static const char *cmc_string_fmt_heap = "struct %s<%s> "
     struct SNAME *PFX##_new_custom(                                          \
         size_t capacity, enum cmc_heap_order HO, struct SNAME##_fval *f_val, \
         struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks);      \
+    struct SNAME *PFX##_from_array(V *values, size_t count,                  \
+                                   enum cmc_heap_order HO,                   \
+                                   struct SNAME##_fval *f_val);              \
     void PFX##_clear(struct SNAME *_heap_);                                  \
     void PFX##_free(struct SNAME *_heap_);                                   \
     /* Customization of Allocation and Callbacks */                          \
     void PFX##_customize(struct SNAME *_heap_, struct cmc_alloc_node *alloc, \
                          struct cmc_callbacks *callbacks);                   \
+    void PFX##_set_growth(struct SNAME *_heap_,                              \
+                          const struct cmc_growth *growth);                  \
     /* Collection Input and Output */                                        \
     bool PFX##_insert(struct SNAME *_heap_, V value);                        \
+    bool PFX##_insert_many(struct SNAME *_heap_, V *values, size_t count);   \
     bool PFX##_remove(struct SNAME *_heap_);                                 \
     /* Element Access */                                                     \
     V PFX##_peek(struct SNAME *_heap_);                                      \
@@ -173,6 +187,10 @@ static const char *cmc_string_fmt_heap = "struct %s<%s> "
     int PFX##_flag(struct SNAME *_heap_);                                    \
     /* Collection Utility */                                                 \
     bool PFX##_resize(struct SNAME *_heap_, size_t capacity);                \
+    bool PFX##_reserve(struct SNAME *_heap_, size_t size);                   \
+    bool PFX##_shrink_to_fit(struct SNAME *_heap_);                          \
+    void PFX##_heap_sort(struct SNAME *_heap_);                              \
+    size_t PFX##_drain_sorted(struct SNAME *_heap_, V *out);                 \
     struct SNAME *PFX##_copy_of(struct SNAME *_heap_);                       \
     bool PFX##_equals(struct SNAME *_heap1_, struct SNAME *_heap2_);         \
     struct cmc_string PFX##_to_string(struct SNAME *_heap_);                 \
@@ -200,11 +218,13 @@ static const char *cmc_string_fmt_heap = "struct %s<%s> "
 /* -------------------------------------------------------------------------
  * Source
  * ------------------------------------------------------------------------- */
-#define CMC_GENERATE_HEAP_SOURCE(PFX, SNAME, V)                                \
+#define CMC_GENERATE_HEAP_DARY_SOURCE(PFX, SNAME, V, D)                        \
                                                                                \
     /* Implementation Detail Functions */                                      \
     static void PFX##_impl_float_up(struct SNAME *_heap_, size_t index);       \
     static void PFX##_impl_float_down(struct SNAME *_heap_, size_t index);     \
+    static void PFX##_impl_heapify(struct SNAME *_heap_);                      \
+    static void PFX##_impl_sort(struct SNAME *_heap_);                         \
                                                                                \
     struct SNAME *PFX##_new(size_t capacity, enum cmc_heap_order HO,           \
                             struct SNAME##_fval *f_val)                        \
@@ -240,6 +260,7 @@ static const char *cmc_string_fmt_heap = "struct %s<%s> "
         _heap_->f_val = f_val;                                                 \
         _heap_->alloc = alloc;                                                 \
         _heap_->callbacks = NULL;                                              \
+        _heap_->growth = NULL;                                                 \
                                                                                \
         return _heap_;                                                         \
     }                                                                          \
@@ -280,6 +301,28 @@ static const char *cmc_string_fmt_heap = "struct %s<%s> "
         _heap_->f_val = f_val;                                                 \
         _heap_->alloc = alloc;                                                 \
         _heap_->callbacks = callbacks;                                         \
+        _heap_->growth = NULL;                                                 \
+                                                                               \
+        return _heap_;                                                         \
+    }                                                                          \
+                                                                               \
+    /* Creates a heap out of count values, copying them and building the */    \
+    /* heap bottom-up in O(n) instead of inserting them one by one */          \
+    struct SNAME *PFX##_from_array(V *values, size_t count,                    \
+                                   enum cmc_heap_order HO,                     \
+                                   struct SNAME##_fval *f_val)                 \
+    {                                                                          \
+        struct SNAME *_heap_ = PFX##_new(count > 0 ? count : 1, HO, f_val);    \
+                                                                               \
+        if (!_heap_)                                                           \
+            return NULL;                                                       \
+                                                                               \
+        if (count > 0)                                                         \
+            memcpy(_heap_->buffer, values, sizeof(V) * count);                 \
+                                                                               \
+        _heap_->count = count;                                                 \
+                                                                               \
+        PFX##_impl_heapify(_heap_);                                            \
                                                                                \
         return _heap_;                                                         \
     }                                                                          \
@@ -327,11 +370,21 @@ static const char *cmc_string_fmt_heap = "struct %s<%s> "
         _heap_->flag = cmc_flags.OK;                                           \
     }                                                                          \
                                                                                \
+    /* Sets the growth policy used when the buffer is full (NULL for the */    \
+    /* default one) */                                                         \
+    void PFX##_set_growth(struct SNAME *_heap_,                                \
+                          const struct cmc_growth *growth)                     \
+    {                                                                          \
+        _heap_->growth = growth;                                               \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+    }                                                                          \
+                                                                               \
     bool PFX##_insert(struct SNAME *_heap_, V value)                           \
     {                                                                          \
         if (PFX##_full(_heap_))                                                \
         {                                                                      \
-            if (!PFX##_resize(_heap_, _heap_->count * 2))                      \
+            if (!PFX##_reserve(_heap_, 1))                                     \
                 return false;                                                  \
         }                                                                      \
                                                                                \
@@ -350,6 +403,41 @@ static const char *cmc_string_fmt_heap = "struct %s<%s> "
         return true;                                                           \
     }                                                                          \
                                                                                \
+    /* Inserts count values at once. If they are at least as many as the */    \
+    /* values already in the heap the whole heap is rebuilt bottom-up in */    \
+    /* O(n), otherwise each one floats up on its own */                        \
+    bool PFX##_insert_many(struct SNAME *_heap_, V *values, size_t count)      \
+    {                                                                          \
+        if (!PFX##_reserve(_heap_, count))                                     \
+            return false;                                                      \
+                                                                               \
+        if (count == 0)                                                        \
+            return true;                                                       \
+                                                                               \
+        size_t start = _heap_->count;                                          \
+                                                                               \
+        memcpy(_heap_->buffer + start, values, sizeof(V) * count);             \
+                                                                               \
+        if (count >= start)                                                    \
+        {                                                                      \
+            _heap_->count += count;                                            \
+                                                                               \
+            PFX##_impl_heapify(_heap_);                                        \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            for (size_t i = 0; i < count; i++)                                 \
+                PFX##_impl_float_up(_heap_, _heap_->count++);                  \
+        }                                                                      \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_heap_->callbacks && _heap_->callbacks->create)                    \
+            _heap_->callbacks->create();                                       \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
     bool PFX##_remove(struct SNAME *_heap_)                                    \
     {                                                                          \
         if (PFX##_empty(_heap_))                                               \
@@ -457,8 +545,6 @@ static const char *cmc_string_fmt_heap = "struct %s<%s> "
             return false;                                                      \
         }                                                                      \
                                                                                \
-        /* TODO zero out new slots */                                          \
-                                                                               \
         _heap_->buffer = new_buffer;                                           \
         _heap_->capacity = capacity;                                           \
                                                                                \
@@ -470,6 +556,73 @@ static const char *cmc_string_fmt_heap = "struct %s<%s> "
         return true;                                                           \
     }                                                                          \
                                                                                \
+    /* Makes room for at least size more elements, growing the buffer */       \
+    /* according to the growth policy */                                       \
+    bool PFX##_reserve(struct SNAME *_heap_, size_t size)                      \
+    {                                                                          \
+        _heap_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (size <= _heap_->capacity - _heap_->count)                          \
+            return true;                                                       \
+                                                                               \
+        if (size > SIZE_MAX - _heap_->count)                                   \
+        {                                                                      \
+            _heap_->flag = cmc_flags.ERROR;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        return PFX##_resize(                                                   \
+            _heap_, cmc_growth_capacity(_heap_->growth, _heap_->capacity,      \
+                                        _heap_->count + size));                \
+    }                                                                          \
+                                                                               \
+    /* Reduces the capacity to the amount of elements */                       \
+    bool PFX##_shrink_to_fit(struct SNAME *_heap_)                             \
+    {                                                                          \
+        return PFX##_resize(_heap_, _heap_->count > 0 ? _heap_->count : 1);    \
+    }                                                                          \
+                                                                               \
+    /* Sorts the buffer in place from the top of the heap to its bottom. */    \
+    /* A sorted array is also a valid heap, so the heap can still be used */   \
+    /* and its iterator goes through the values in order */                    \
+    void PFX##_heap_sort(struct SNAME *_heap_)                                 \
+    {                                                                          \
+        PFX##_impl_sort(_heap_);                                               \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_heap_->callbacks && _heap_->callbacks->update)                    \
+            _heap_->callbacks->update();                                       \
+    }                                                                          \
+                                                                               \
+    /* Removes every value, copying them to out from the top of the heap */    \
+    /* to its bottom, and returns how many were removed. The values are */     \
+    /* not freed since they now belong to out */                               \
+    size_t PFX##_drain_sorted(struct SNAME *_heap_, V *out)                    \
+    {                                                                          \
+        size_t count = _heap_->count;                                          \
+                                                                               \
+        if (count == 0)                                                        \
+        {                                                                      \
+            _heap_->flag = cmc_flags.EMPTY;                                    \
+            return 0;                                                          \
+        }                                                                      \
+                                                                               \
+        PFX##_impl_sort(_heap_);                                               \
+                                                                               \
+        memcpy(out, _heap_->buffer, sizeof(V) * count);                        \
+        memset(_heap_->buffer, 0, sizeof(V) * count);                          \
+                                                                               \
+        _heap_->count = 0;                                                     \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_heap_->callbacks && _heap_->callbacks->delete)                    \
+            _heap_->callbacks->delete ();                                      \
+                                                                               \
+        return count;                                                          \
+    }                                                                          \
+                                                                               \
     struct SNAME *PFX##_copy_of(struct SNAME *_heap_)                          \
     {                                                                          \
         struct SNAME *result =                                                 \
@@ -491,6 +644,7 @@ static const char *cmc_string_fmt_heap = "struct %s<%s> "
             memcpy(result->buffer, _heap_->buffer, sizeof(V) * _heap_->count); \
                                                                                \
         result->count = _heap_->count;                                         \
+        result->growth = _heap_->growth;                                       \
                                                                                \
         _heap_->flag = cmc_flags.OK;                                           \
                                                                                \
@@ -717,70 +871,105 @@ static const char *cmc_string_fmt_heap = "struct %s<%s> "
                                                                                \
     static void PFX##_impl_float_up(struct SNAME *_heap_, size_t index)        \
     {                                                                          \
-        /* Current index */                                                    \
-        size_t C = index;                                                      \
-        V child = _heap_->buffer[C];                                           \
-        V parent = _heap_->buffer[(index - 1) / 2];                            \
-                                                                               \
         int mod = _heap_->HO;                                                  \
                                                                                \
-        while (C > 0 && _heap_->f_val->cmp(child, parent) * mod > 0)           \
-        {                                                                      \
-            /* Swap between C (current element) and its parent */              \
-            V tmp = _heap_->buffer[C];                                         \
-            _heap_->buffer[C] = _heap_->buffer[(C - 1) / 2];                   \
-            _heap_->buffer[(C - 1) / 2] = tmp;                                 \
+        /* The value is only written once it reaches its final position */     \
+        V value = _heap_->buffer[index];                                       \
                                                                                \
-            /* Go to parent */                                                 \
-            C = (C - 1) / 2;                                                   \
+        while (index > 0)                                                      \
+        {                                                                      \
+            size_t P = (index - 1) / (D);                                      \
                                                                                \
-            /* Prevent the two lines below from accessing a negative index */  \
-            if (C == 0)                                                        \
+            if (_heap_->f_val->cmp(value, _heap_->buffer[P]) * mod <= 0)       \
                 break;                                                         \
                                                                                \
-            child = _heap_->buffer[C];                                         \
-            parent = _heap_->buffer[(C - 1) / 2];                              \
+            _heap_->buffer[index] = _heap_->buffer[P];                         \
+            index = P;                                                         \
         }                                                                      \
+                                                                               \
+        _heap_->buffer[index] = value;                                         \
     }                                                                          \
                                                                                \
     static void PFX##_impl_float_down(struct SNAME *_heap_, size_t index)      \
     {                                                                          \
         int mod = _heap_->HO;                                                  \
                                                                                \
-        while (index < _heap_->count)                                          \
+        if (index >= _heap_->count)                                            \
+            return;                                                            \
+                                                                               \
+        /* The value is only written once it reaches its final position */     \
+        V value = _heap_->buffer[index];                                       \
+                                                                               \
+        while (true)                                                           \
         {                                                                      \
-            size_t L = 2 * index + 1;                                          \
-            size_t R = 2 * index + 2;                                          \
-            size_t C = index;                                                  \
+            /* The children of a node are next to each other */                \
+            size_t first = index * (D) + 1;                                    \
                                                                                \
-            /* Determine if we swap with the left or right element */          \
-            if (L < _heap_->count &&                                           \
-                _heap_->f_val->cmp(_heap_->buffer[L], _heap_->buffer[C]) *     \
-                        mod >                                                  \
-                    0)                                                         \
-            {                                                                  \
-                C = L;                                                         \
-            }                                                                  \
+            if (first >= _heap_->count)                                        \
+                break;                                                         \
+                                                                               \
+            size_t last =                                                      \
+                _heap_->count - first > (D) ? first + (D) : _heap_->count;     \
+                                                                               \
+            /* Pick the child that should be the closest to the top */         \
+            size_t C = first;                                                  \
                                                                                \
-            if (R < _heap_->count &&                                           \
-                _heap_->f_val->cmp(_heap_->buffer[R], _heap_->buffer[C]) *     \
+            for (size_t i = first + 1; i < last; i++)                          \
+            {                                                                  \
+                if (_heap_->f_val->cmp(_heap_->buffer[i], _heap_->buffer[C]) * \
                         mod >                                                  \
                     0)                                                         \
-            {                                                                  \
-                C = R;                                                         \
+                    C = i;                                                     \
             }                                                                  \
                                                                                \
-            /* Swap only if either left or right was picked, otherwise done */ \
-            if (C != index)                                                    \
-            {                                                                  \
-                V tmp = _heap_->buffer[index];                                 \
-                _heap_->buffer[index] = _heap_->buffer[C];                     \
-                _heap_->buffer[C] = tmp;                                       \
-                                                                               \
-                index = C;                                                     \
-            }                                                                  \
-            else                                                               \
+            /* Done if the value doesn't go below that child */                \
+            if (_heap_->f_val->cmp(_heap_->buffer[C], value) * mod <= 0)       \
                 break;                                                         \
+                                                                               \
+            _heap_->buffer[index] = _heap_->buffer[C];                         \
+            index = C;                                                         \
+        }                                                                      \
+                                                                               \
+        _heap_->buffer[index] = value;                                         \
+    }                                                                          \
+                                                                               \
+    /* Floyd's bottom-up heap construction: every node that has children */    \
+    /* floats down, starting from the last one */                              \
+    static void PFX##_impl_heapify(struct SNAME *_heap_)                       \
+    {                                                                          \
+        if (_heap_->count < 2)                                                 \
+            return;                                                            \
+                                                                               \
+        for (size_t i = (_heap_->count - 2) / (D) + 1; i > 0; i--)             \
+            PFX##_impl_float_down(_heap_, i - 1);                              \
+    }                                                                          \
+                                                                               \
+    /* Heapsort that leaves the buffer sorted from the top of the heap to */   \
+    /* its bottom */                                                           \
+    static void PFX##_impl_sort(struct SNAME *_heap_)                          \
+    {                                                                          \
+        size_t count = _heap_->count;                                          \
+                                                                               \
+        /* Moves the top to the end of the heap, which shrinks by one */       \
+        while (_heap_->count > 1)                                              \
+        {                                                                      \
+            V tmp = _heap_->buffer[0];                                         \
+            _heap_->buffer[0] = _heap_->buffer[_heap_->count - 1];             \
+            _heap_->buffer[_heap_->count - 1] = tmp;                           \
+                                                                               \
+            _heap_->count--;                                                   \
+                                                                               \
+            PFX##_impl_float_down(_heap_, 0);                                  \
+        }                                                                      \
+                                                                               \
+        _heap_->count = count;                                                 \
+                                                                               \
+        /* The top is now at the end so the buffer is reversed */              \
+        for (size_t i = 0, j = count; i + 1 < j; i++, j--)                     \
+        {                                                                      \
+            V tmp = _heap_->buffer[i];                                         \
+            _heap_->buffer[i] = _heap_->buffer[j - 1];                         \
+            _heap_->buffer[j - 1] = tmp;                                       \
         }                                                                      \
     }
 
@@ -0,0 +1,694 @@
+/**
+ * indexheap.h
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * IndexHeap
+ *
+ * An addressable Heap, also known as an indexed priority queue. Every value
+ * inserted gets a handle that stays the same while the value is in the heap,
+ * no matter how many times it moves. A handle can then be used to read the
+ * value, to change it with update or to take it out of the heap with
+ * remove_handle, all in O(log n) or less. This avoids inserting a value again
+ * every time its priority changes and skipping the stale copies later on,
+ * which is what algorithms like Dijkstra's or A* have to do with a plain Heap.
+ *
+ * Values are stored by handle and never move. The heap itself is an array of
+ * handles and a second array keeps the position of each handle in it, which
+ * float_up and float_down update as they move handles around. The handles
+ * that are not in use are kept in the same array right after the heap, so a
+ * handle is in the heap if its position is less than the count.
+ *
+ * Handles go from 0 to capacity - 1. Once a value is removed its handle may be
+ * given to the next value inserted.
+ */
+
+#ifndef CMC_INDEXHEAP_H
+#define CMC_INDEXHEAP_H
+
+/* -------------------------------------------------------------------------
+ * Core functionalities of the C Macro Collections Library
+ * ------------------------------------------------------------------------- */
+#include "../cor/core.h"
+#include "../cor/heap.h"
+
+/* -------------------------------------------------------------------------
+ * IndexHeap specific
+ * ------------------------------------------------------------------------- */
+/* to_string format */
+static const char *cmc_string_fmt_indexheap = "struct %s<%s> "
+                                              "at %p { "
+                                              "values:%p, "
+                                              "handles:%p, "
+                                              "positions:%p, "
+                                              "capacity:%" PRIuMAX ", "
+                                              "count:%" PRIuMAX ", "
+                                              "type:%s, "
+                                              "flag:%d, "
+                                              "f_val:%p, "
+                                              "alloc:%p, "
+                                              "callbacks:%p }";
+
+#define CMC_GENERATE_INDEXHEAP(PFX, SNAME, V)    \
+    CMC_GENERATE_INDEXHEAP_HEADER(PFX, SNAME, V) \
+    CMC_GENERATE_INDEXHEAP_SOURCE(PFX, SNAME, V)
+
+#define CMC_WRAPGEN_INDEXHEAP_HEADER(PFX, SNAME, K, V) \
+    CMC_GENERATE_INDEXHEAP_HEADER(PFX, SNAME, V)
+
+#define CMC_WRAPGEN_INDEXHEAP_SOURCE(PFX, SNAME, K, V) \
+    CMC_GENERATE_INDEXHEAP_SOURCE(PFX, SNAME, V)
+
+/* -------------------------------------------------------------------------
+ * Header
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_INDEXHEAP_HEADER(PFX, SNAME, V)                         \
+                                                                             \
+    /* IndexHeap Structure */                                                \
+    struct SNAME                                                             \
+    {                                                                        \
+        /* Value of each handle */                                           \
+        V *values;                                                           \
+                                                                             \
+        /* Handles in the heap followed by the ones not in use */            \
+        size_t *handles;                                                     \
+                                                                             \
+        /* Position of each handle in the handles array */                   \
+        size_t *positions;                                                   \
+                                                                             \
+        /* Current array capacity */                                         \
+        size_t capacity;                                                     \
+                                                                             \
+        /* Current amount of elements in the heap */                         \
+        size_t count;                                                        \
+                                                                             \
+        /* Heap order (MaxHeap or MinHeap) */                                \
+        enum cmc_heap_order HO;                                              \
+                                                                             \
+        /* Flags indicating errors or success */                             \
+        int flag;                                                            \
+                                                                             \
+        /* Value function table */                                           \
+        struct SNAME##_fval *f_val;                                          \
+                                                                             \
+        /* Custom allocation functions */                                    \
+        struct cmc_alloc_node *alloc;                                        \
+                                                                             \
+        /* Custom callback functions */                                      \
+        struct cmc_callbacks *callbacks;                                     \
+                                                                             \
+        /* Growth policy of the arrays */                                    \
+        const struct cmc_growth *growth;                                     \
+    };                                                                       \
+                                                                             \
+    /* Value struct function table */                                        \
+    struct SNAME##_fval                                                      \
+    {                                                                        \
+        /* Comparator function */                                            \
+        int (*cmp)(V, V);                                                    \
+                                                                             \
+        /* Copy function */                                                  \
+        V (*cpy)(V);                                                         \
+                                                                             \
+        /* To string function */                                             \
+        bool (*str)(FILE *, V);                                              \
+                                                                             \
+        /* Free from memory function */                                      \
+        void (*free)(V);                                                     \
+                                                                             \
+        /* Hash function */                                                  \
+        size_t (*hash)(V);                                                   \
+                                                                             \
+        /* Priority function */                                              \
+        int (*pri)(V, V);                                                    \
+    };                                                                       \
+                                                                             \
+    /* Collection Functions */                                               \
+    /* Collection Allocation and Deallocation */                             \
+    struct SNAME *PFX##_new(size_t capacity, enum cmc_heap_order HO,         \
+                            struct SNAME##_fval *f_val);                     \
+    struct SNAME *PFX##_new_custom(                                          \
+        size_t capacity, enum cmc_heap_order HO, struct SNAME##_fval *f_val, \
+        struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks);      \
+    void PFX##_clear(struct SNAME *_heap_);                                  \
+    void PFX##_free(struct SNAME *_heap_);                                   \
+    /* Customization of Allocation and Callbacks */                          \
+    void PFX##_customize(struct SNAME *_heap_, struct cmc_alloc_node *alloc, \
+                         struct cmc_callbacks *callbacks);                   \
+    void PFX##_set_growth(struct SNAME *_heap_,                              \
+                          const struct cmc_growth *growth);                  \
+    /* Collection Input and Output */                                        \
+    bool PFX##_insert(struct SNAME *_heap_, V value, size_t *handle);        \
+    bool PFX##_remove(struct SNAME *_heap_);                                 \
+    bool PFX##_remove_handle(struct SNAME *_heap_, size_t handle);           \
+    bool PFX##_update(struct SNAME *_heap_, size_t handle, V value);         \
+    /* Element Access */                                                     \
+    V PFX##_peek(struct SNAME *_heap_);                                      \
+    size_t PFX##_peek_handle(struct SNAME *_heap_);                          \
+    V PFX##_get(struct SNAME *_heap_, size_t handle);                        \
+    /* Collection State */                                                   \
+    bool PFX##_contains(struct SNAME *_heap_, size_t handle);                \
+    bool PFX##_empty(struct SNAME *_heap_);                                  \
+    bool PFX##_full(struct SNAME *_heap_);                                   \
+    size_t PFX##_count(struct SNAME *_heap_);                                \
+    size_t PFX##_capacity(struct SNAME *_heap_);                             \
+    int PFX##_flag(struct SNAME *_heap_);                                    \
+    /* Collection Utility */                                                 \
+    bool PFX##_resize(struct SNAME *_heap_, size_t capacity);                \
+    bool PFX##_reserve(struct SNAME *_heap_, size_t size);                   \
+    struct cmc_string PFX##_to_string(struct SNAME *_heap_);                 \
+    bool PFX##_print(struct SNAME *_heap_, FILE *fptr);
+
+/* -------------------------------------------------------------------------
+ * Source
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_INDEXHEAP_SOURCE(PFX, SNAME, V)                           \
+                                                                               \
+    /* Implementation Detail Functions */                                      \
+    static void PFX##_impl_remove_at(struct SNAME *_heap_, size_t index);      \
+    static void PFX##_impl_float_up(struct SNAME *_heap_, size_t index);       \
+    static void PFX##_impl_float_down(struct SNAME *_heap_, size_t index);     \
+                                                                               \
+    struct SNAME *PFX##_new(size_t capacity, enum cmc_heap_order HO,           \
+                            struct SNAME##_fval *f_val)                        \
+    {                                                                          \
+        return PFX##_new_custom(capacity, HO, f_val, NULL, NULL);              \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_new_custom(                                            \
+        size_t capacity, enum cmc_heap_order HO, struct SNAME##_fval *f_val,   \
+        struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks)         \
+    {                                                                          \
+        if (capacity < 1)                                                      \
+            return NULL;                                                       \
+                                                                               \
+        if (HO != cmc_min_heap && HO != cmc_max_heap)                          \
+            return NULL;                                                       \
+                                                                               \
+        if (!f_val)                                                            \
+            return NULL;                                                       \
+                                                                               \
+        if (!alloc)                                                            \
+            alloc = &cmc_alloc_node_default;                                   \
+                                                                               \
+        struct SNAME *_heap_ = alloc->malloc(sizeof(struct SNAME));            \
+                                                                               \
+        if (!_heap_)                                                           \
+            return NULL;                                                       \
+                                                                               \
+        _heap_->values = alloc->calloc(capacity, sizeof(V));                   \
+        _heap_->handles = alloc->calloc(capacity, sizeof(size_t));             \
+        _heap_->positions = alloc->calloc(capacity, sizeof(size_t));           \
+                                                                               \
+        if (!_heap_->values || !_heap_->handles || !_heap_->positions)         \
+        {                                                                      \
+            alloc->free(_heap_->values);                                       \
+            alloc->free(_heap_->handles);                                      \
+            alloc->free(_heap_->positions);                                    \
+            alloc->free(_heap_);                                               \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        /* Every handle starts out unused */                                   \
+        for (size_t i = 0; i < capacity; i++)                                  \
+        {                                                                      \
+            _heap_->handles[i] = i;                                            \
+            _heap_->positions[i] = i;                                          \
+        }                                                                      \
+                                                                               \
+        _heap_->capacity = capacity;                                           \
+        _heap_->count = 0;                                                     \
+        _heap_->HO = HO;                                                       \
+        _heap_->flag = cmc_flags.OK;                                           \
+        _heap_->f_val = f_val;                                                 \
+        _heap_->alloc = alloc;                                                 \
+        _heap_->callbacks = callbacks;                                         \
+        _heap_->growth = NULL;                                                 \
+                                                                               \
+        return _heap_;                                                         \
+    }                                                                          \
+                                                                               \
+    void PFX##_clear(struct SNAME *_heap_)                                     \
+    {                                                                          \
+        if (_heap_->f_val->free)                                               \
+        {                                                                      \
+            for (size_t i = 0; i < _heap_->count; i++)                         \
+            {                                                                  \
+                _heap_->f_val->free(_heap_->values[_heap_->handles[i]]);       \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        memset(_heap_->values, 0, sizeof(V) * _heap_->capacity);               \
+                                                                               \
+        _heap_->count = 0;                                                     \
+        _heap_->flag = cmc_flags.OK;                                           \
+    }                                                                          \
+                                                                               \
+    void PFX##_free(struct SNAME *_heap_)                                      \
+    {                                                                          \
+        if (_heap_->f_val->free)                                               \
+        {                                                                      \
+            for (size_t i = 0; i < _heap_->count; i++)                         \
+            {                                                                  \
+                _heap_->f_val->free(_heap_->values[_heap_->handles[i]]);       \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        _heap_->alloc->free(_heap_->values);                                   \
+        _heap_->alloc->free(_heap_->handles);                                  \
+        _heap_->alloc->free(_heap_->positions);                                \
+        _heap_->alloc->free(_heap_);                                           \
+    }                                                                          \
+                                                                               \
+    void PFX##_customize(struct SNAME *_heap_, struct cmc_alloc_node *alloc,   \
+                         struct cmc_callbacks *callbacks)                      \
+    {                                                                          \
+        if (!alloc)                                                            \
+            _heap_->alloc = &cmc_alloc_node_default;                           \
+        else                                                                   \
+            _heap_->alloc = alloc;                                             \
+                                                                               \
+        _heap_->callbacks = callbacks;                                         \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+    }                                                                          \
+                                                                               \
+    /* Sets the growth policy used when the arrays are full (NULL for the */   \
+    /* default one) */                                                         \
+    void PFX##_set_growth(struct SNAME *_heap_,                                \
+                          const struct cmc_growth *growth)                     \
+    {                                                                          \
+        _heap_->growth = growth;                                               \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+    }                                                                          \
+                                                                               \
+    /* Inserts a value and, if handle is not NULL, stores the handle of the */ \
+    /* value in it */                                                          \
+    bool PFX##_insert(struct SNAME *_heap_, V value, size_t *handle)           \
+    {                                                                          \
+        if (PFX##_full(_heap_))                                                \
+        {                                                                      \
+            if (!PFX##_reserve(_heap_, 1))                                     \
+                return false;                                                  \
+        }                                                                      \
+                                                                               \
+        /* Takes the first handle not in use */                                \
+        size_t H = _heap_->handles[_heap_->count++];                           \
+                                                                               \
+        _heap_->values[H] = value;                                             \
+                                                                               \
+        PFX##_impl_float_up(_heap_, _heap_->count - 1);                        \
+                                                                               \
+        if (handle)                                                            \
+            *handle = H;                                                       \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_heap_->callbacks && _heap_->callbacks->create)                    \
+            _heap_->callbacks->create();                                       \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_remove(struct SNAME *_heap_)                                    \
+    {                                                                          \
+        if (PFX##_empty(_heap_))                                               \
+        {                                                                      \
+            _heap_->flag = cmc_flags.EMPTY;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        PFX##_impl_remove_at(_heap_, 0);                                       \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_heap_->callbacks && _heap_->callbacks->delete)                    \
+            _heap_->callbacks->delete ();                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Removes the value of a handle from anywhere in the heap */              \
+    bool PFX##_remove_handle(struct SNAME *_heap_, size_t handle)              \
+    {                                                                          \
+        if (!PFX##_contains(_heap_, handle))                                   \
+        {                                                                      \
+            _heap_->flag = cmc_flags.INVALID;                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        PFX##_impl_remove_at(_heap_, _heap_->positions[handle]);               \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_heap_->callbacks && _heap_->callbacks->delete)                    \
+            _heap_->callbacks->delete ();                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Replaces the value of a handle, which then floats up or down to its */  \
+    /* new position. The old value is not freed */                             \
+    bool PFX##_update(struct SNAME *_heap_, size_t handle, V value)            \
+    {                                                                          \
+        if (!PFX##_contains(_heap_, handle))                                   \
+        {                                                                      \
+            _heap_->flag = cmc_flags.INVALID;                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        _heap_->values[handle] = value;                                        \
+                                                                               \
+        PFX##_impl_float_up(_heap_, _heap_->positions[handle]);                \
+        PFX##_impl_float_down(_heap_, _heap_->positions[handle]);              \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_heap_->callbacks && _heap_->callbacks->update)                    \
+            _heap_->callbacks->update();                                       \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    V PFX##_peek(struct SNAME *_heap_)                                         \
+    {                                                                          \
+        if (PFX##_empty(_heap_))                                               \
+        {                                                                      \
+            _heap_->flag = cmc_flags.EMPTY;                                    \
+            return (V){ 0 };                                                   \
+        }                                                                      \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_heap_->callbacks && _heap_->callbacks->read)                      \
+            _heap_->callbacks->read();                                         \
+                                                                               \
+        return _heap_->values[_heap_->handles[0]];                             \
+    }                                                                          \
+                                                                               \
+    /* Returns the handle of the value at the top of the heap */               \
+    size_t PFX##_peek_handle(struct SNAME *_heap_)                             \
+    {                                                                          \
+        if (PFX##_empty(_heap_))                                               \
+        {                                                                      \
+            _heap_->flag = cmc_flags.EMPTY;                                    \
+            return 0;                                                          \
+        }                                                                      \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_heap_->callbacks && _heap_->callbacks->read)                      \
+            _heap_->callbacks->read();                                         \
+                                                                               \
+        return _heap_->handles[0];                                             \
+    }                                                                          \
+                                                                               \
+    V PFX##_get(struct SNAME *_heap_, size_t handle)                           \
+    {                                                                          \
+        if (!PFX##_contains(_heap_, handle))                                   \
+        {                                                                      \
+            _heap_->flag = cmc_flags.INVALID;                                  \
+            return (V){ 0 };                                                   \
+        }                                                                      \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_heap_->callbacks && _heap_->callbacks->read)                      \
+            _heap_->callbacks->read();                                         \
+                                                                               \
+        return _heap_->values[handle];                                         \
+    }                                                                          \
+                                                                               \
+    /* Checks in O(1) if a handle has a value in the heap */                   \
+    bool PFX##_contains(struct SNAME *_heap_, size_t handle)                   \
+    {                                                                          \
+        return handle < _heap_->capacity &&                                    \
+               _heap_->positions[handle] < _heap_->count;                      \
+    }                                                                          \
+                                                                               \
+    bool PFX##_empty(struct SNAME *_heap_)                                     \
+    {                                                                          \
+        return _heap_->count == 0;                                             \
+    }                                                                          \
+                                                                               \
+    bool PFX##_full(struct SNAME *_heap_)                                      \
+    {                                                                          \
+        return _heap_->count >= _heap_->capacity;                              \
+    }                                                                          \
+                                                                               \
+    size_t PFX##_count(struct SNAME *_heap_)                                   \
+    {                                                                          \
+        return _heap_->count;                                                  \
+    }                                                                          \
+                                                                               \
+    size_t PFX##_capacity(struct SNAME *_heap_)                                \
+    {                                                                          \
+        return _heap_->capacity;                                               \
+    }                                                                          \
+                                                                               \
+    int PFX##_flag(struct SNAME *_heap_)                                       \
+    {                                                                          \
+        return _heap_->flag;                                                   \
+    }                                                                          \
+                                                                               \
+    /* Changes the capacity, which is also the amount of handles. It can */    \
+    /* only shrink if no handle greater than or equal to the new capacity */   \
+    /* is in use */                                                            \
+    bool PFX##_resize(struct SNAME *_heap_, size_t capacity)                   \
+    {                                                                          \
+        _heap_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_heap_->capacity == capacity)                                      \
+            goto success;                                                      \
+                                                                               \
+        if (capacity < _heap_->count)                                          \
+        {                                                                      \
+            _heap_->flag = cmc_flags.INVALID;                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (capacity > SIZE_MAX / sizeof(V) ||                                 \
+            capacity > SIZE_MAX / sizeof(size_t))                              \
+        {                                                                      \
+            _heap_->flag = cmc_flags.ERROR;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (capacity < _heap_->capacity)                                       \
+        {                                                                      \
+            for (size_t i = 0; i < _heap_->count; i++)                         \
+            {                                                                  \
+                if (_heap_->handles[i] >= capacity)                            \
+                {                                                              \
+                    _heap_->flag = cmc_flags.INVALID;                          \
+                    return false;                                              \
+                }                                                              \
+            }                                                                  \
+                                                                               \
+            /* Moves the handles that go away to the end of the array */       \
+            for (size_t H = _heap_->capacity, end = H; H > capacity;           \
+                 H--, end--)                                                   \
+            {                                                                  \
+                size_t P = _heap_->positions[H - 1];                           \
+                size_t last = _heap_->handles[end - 1];                        \
+                                                                               \
+                _heap_->handles[P] = last;                                     \
+                _heap_->positions[last] = P;                                   \
+                _heap_->handles[end - 1] = H - 1;                              \
+                _heap_->positions[H - 1] = end - 1;                            \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        /* The arrays are replaced only once the three of them could be */     \
+        /* allocated, so a failure keeps the old arrays and capacity */        \
+        V *new_values = _heap_->alloc->malloc(sizeof(V) * capacity);           \
+        size_t *new_handles =                                                  \
+            _heap_->alloc->malloc(sizeof(size_t) * capacity);                  \
+        size_t *new_positions =                                                \
+            _heap_->alloc->malloc(sizeof(size_t) * capacity);                  \
+                                                                               \
+        if (!new_values || !new_handles || !new_positions)                     \
+        {                                                                      \
+            _heap_->alloc->free(new_values);                                   \
+            _heap_->alloc->free(new_handles);                                  \
+            _heap_->alloc->free(new_positions);                                \
+                                                                               \
+            _heap_->flag = cmc_flags.ALLOC;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        size_t kept =                                                          \
+            capacity < _heap_->capacity ? capacity : _heap_->capacity;         \
+                                                                               \
+        memcpy(new_values, _heap_->values, sizeof(V) * kept);                  \
+        memcpy(new_handles, _heap_->handles, sizeof(size_t) * kept);           \
+        memcpy(new_positions, _heap_->positions, sizeof(size_t) * kept);       \
+                                                                               \
+        _heap_->alloc->free(_heap_->values);                                   \
+        _heap_->alloc->free(_heap_->handles);                                  \
+        _heap_->alloc->free(_heap_->positions);                                \
+                                                                               \
+        _heap_->values = new_values;                                           \
+        _heap_->handles = new_handles;                                         \
+        _heap_->positions = new_positions;                                     \
+                                                                               \
+        /* The new handles are not in use */                                   \
+        for (size_t i = _heap_->capacity; i < capacity; i++)                   \
+        {                                                                      \
+            _heap_->values[i] = (V){ 0 };                                      \
+            _heap_->handles[i] = i;                                            \
+            _heap_->positions[i] = i;                                          \
+        }                                                                      \
+                                                                               \
+        _heap_->capacity = capacity;                                           \
+                                                                               \
+    success:                                                                   \
+                                                                               \
+        if (_heap_->callbacks && _heap_->callbacks->resize)                    \
+            _heap_->callbacks->resize();                                       \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Makes room for at least size more elements, growing the arrays */       \
+    /* according to the growth policy */                                       \
+    bool PFX##_reserve(struct SNAME *_heap_, size_t size)                      \
+    {                                                                          \
+        _heap_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (size <= _heap_->capacity - _heap_->count)                          \
+            return true;                                                       \
+                                                                               \
+        if (size > SIZE_MAX - _heap_->count)                                   \
+        {                                                                      \
+            _heap_->flag = cmc_flags.ERROR;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        return PFX##_resize(                                                   \
+            _heap_, cmc_growth_capacity(_heap_->growth, _heap_->capacity,      \
+                                        _heap_->count + size));                \
+    }                                                                          \
+                                                                               \
+    struct cmc_string PFX##_to_string(struct SNAME *_heap_)                    \
+    {                                                                          \
+        struct cmc_string str;                                                 \
+        struct SNAME *h_ = _heap_;                                             \
+        const char *t = h_->HO == 1 ? "MaxHeap" : "MinHeap";                   \
+                                                                               \
+        int n = snprintf(str.s, cmc_string_len, cmc_string_fmt_indexheap,      \
+                         #SNAME, #V, h_, h_->values, h_->handles,              \
+                         h_->positions, h_->capacity, h_->count, t, h_->flag,  \
+                         h_->f_val, h_->alloc, h_->callbacks);                 \
+                                                                               \
+        return n >= 0 ? str : (struct cmc_string){ 0 };                        \
+    }                                                                          \
+                                                                               \
+    bool PFX##_print(struct SNAME *_heap_, FILE *fptr)                         \
+    {                                                                          \
+        for (size_t i = 0; i < _heap_->count; i++)                             \
+        {                                                                      \
+            if (!_heap_->f_val->str(fptr, _heap_->values[_heap_->handles[i]])) \
+                return false;                                                  \
+        }                                                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Swaps the handle at index with the last one in the heap, which makes */ \
+    /* it the first handle not in use, and then puts the moved handle back */  \
+    /* in place */                                                             \
+    static void PFX##_impl_remove_at(struct SNAME *_heap_, size_t index)       \
+    {                                                                          \
+        size_t H = _heap_->handles[index];                                     \
+        size_t last = _heap_->handles[_heap_->count - 1];                      \
+                                                                               \
+        _heap_->handles[index] = last;                                         \
+        _heap_->positions[last] = index;                                       \
+        _heap_->handles[_heap_->count - 1] = H;                                \
+        _heap_->positions[H] = _heap_->count - 1;                              \
+                                                                               \
+        _heap_->values[H] = (V){ 0 };                                          \
+        _heap_->count--;                                                       \
+                                                                               \
+        if (index < _heap_->count)                                             \
+        {                                                                      \
+            PFX##_impl_float_up(_heap_, index);                                \
+            PFX##_impl_float_down(_heap_, _heap_->positions[last]);            \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static void PFX##_impl_float_up(struct SNAME *_heap_, size_t index)        \
+    {                                                                          \
+        int mod = _heap_->HO;                                                  \
+                                                                               \
+        /* The handle is only written once it reaches its final position */    \
+        size_t H = _heap_->handles[index];                                     \
+        V value = _heap_->values[H];                                           \
+                                                                               \
+        while (index > 0)                                                      \
+        {                                                                      \
+            size_t P = (index - 1) / 2;                                        \
+            size_t parent = _heap_->handles[P];                                \
+                                                                               \
+            if (_heap_->f_val->cmp(value, _heap_->values[parent]) * mod <= 0)  \
+                break;                                                         \
+                                                                               \
+            _heap_->handles[index] = parent;                                   \
+            _heap_->positions[parent] = index;                                 \
+            index = P;                                                         \
+        }                                                                      \
+                                                                               \
+        _heap_->handles[index] = H;                                            \
+        _heap_->positions[H] = index;                                          \
+    }                                                                          \
+                                                                               \
+    static void PFX##_impl_float_down(struct SNAME *_heap_, size_t index)      \
+    {                                                                          \
+        int mod = _heap_->HO;                                                  \
+                                                                               \
+        if (index >= _heap_->count)                                            \
+            return;                                                            \
+                                                                               \
+        /* The handle is only written once it reaches its final position */    \
+        size_t H = _heap_->handles[index];                                     \
+        V value = _heap_->values[H];                                           \
+                                                                               \
+        while (true)                                                           \
+        {                                                                      \
+            size_t C = index * 2 + 1;                                          \
+                                                                               \
+            if (C >= _heap_->count)                                            \
+                break;                                                         \
+                                                                               \
+            /* Pick the child that should be the closest to the top */         \
+            if (C + 1 < _heap_->count &&                                       \
+                _heap_->f_val->cmp(_heap_->values[_heap_->handles[C + 1]],     \
+                                   _heap_->values[_heap_->handles[C]]) *       \
+                        mod >                                                  \
+                    0)                                                         \
+                C++;                                                           \
+                                                                               \
+            size_t child = _heap_->handles[C];                                 \
+                                                                               \
+            /* Done if the value doesn't go below that child */                \
+            if (_heap_->f_val->cmp(_heap_->values[child], value) * mod <= 0)   \
+                break;                                                         \
+                                                                               \
+            _heap_->handles[index] = child;                                    \
+            _heap_->positions[child] = index;                                  \
+            index = C;                                                         \
+        }                                                                      \
+                                                                               \
+        _heap_->handles[index] = H;                                            \
+        _heap_->positions[H] = index;                                          \
+    }
+
+#endif /* CMC_INDEXHEAP_H */
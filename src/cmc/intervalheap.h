@@ -16,6 +16,21 @@
  * - O(log n) - Insert
  * - O(log n) - Remove Min
  * - O(log n) - Remove Max
+ *
+ * By default each node has two children. CMC_GENERATE_INTERVALHEAP_DARY
+ * generates a heap where each node has D children, at indexes i * D + 1 to
+ * i * D + D of the array of pairs. Both the MinHeap and the MaxHeap use the
+ * same arity, which doesn't change the API.
+ *
+ * from_array and insert_many build the heap bottom-up in O(n), ordering the
+ * two values of each node and then floating down every node with children
+ * on both heaps.
+ *
+ * A heap created with new_bounded keeps at most a fixed amount of values,
+ * like the best k values of a stream. offer_max keeps the greatest ones: a
+ * value that is not greater than the minimum is rejected in O(1), otherwise
+ * it replaces the minimum in place with a single float down. offer_min is
+ * the opposite. drain_sorted then moves every value out in order.
  */
 
 #ifndef CMC_INTERVALHEAP_H
@@ -45,6 +60,14 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
     CMC_GENERATE_INTERVALHEAP_HEADER(PFX, SNAME, V) \
     CMC_GENERATE_INTERVALHEAP_SOURCE(PFX, SNAME, V)
 
+/* Generates a heap where each node has D children, which must be at least 2 */
+#define CMC_GENERATE_INTERVALHEAP_DARY(PFX, SNAME, V, D) \
+    CMC_GENERATE_INTERVALHEAP_HEADER(PFX, SNAME, V)      \
+    CMC_GENERATE_INTERVALHEAP_DARY_SOURCE(PFX, SNAME, V, D)
+
+#define CMC_GENERATE_INTERVALHEAP_SOURCE(PFX, SNAME, V) \
+    CMC_GENERATE_INTERVALHEAP_DARY_SOURCE(PFX, SNAME, V, 2)
+
 #define CMC_WRAPGEN_INTERVALHEAP_HEADER(PFX, SNAME, K, V) \
     CMC_GENERATE_INTERVALHEAP_HEADER(PFX, SNAME, V)
 
@@ -72,6 +95,10 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
         /* Current amount of elements in the heap */                         \
         size_t count;                                                        \
                                                                              \
+        /* Maximum amount of elements kept by offer_max and offer_min */     \
+        /* or 0 if the heap is not bounded */                                \
+        size_t bound;                                                        \
+                                                                             \
         /* Flags indicating errors or success */                             \
         int flag;                                                            \
                                                                              \
@@ -83,6 +110,9 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
                                                                              \
         /* Custom callback functions */                                      \
         struct cmc_callbacks *callbacks;                                     \
+                                                                             \
+        /* Growth policy of the buffer */                                    \
+        const struct cmc_growth *growth;                                     \
     };                                                                       \
                                                                              \
     /* Value struct function table */                                        \
@@ -129,15 +159,24 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
     struct SNAME *PFX##_new_custom(                                          \
         size_t capacity, struct SNAME##_fval *f_val,                         \
         struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks);      \
+    struct SNAME *PFX##_new_bounded(size_t bound,                            \
+                                    struct SNAME##_fval *f_val);             \
+    struct SNAME *PFX##_from_array(V *values, size_t count,                  \
+                                   struct SNAME##_fval *f_val);              \
     void PFX##_clear(struct SNAME *_heap_);                                  \
     void PFX##_free(struct SNAME *_heap_);                                   \
     /* Customization of Allocation and Callbacks */                          \
     void PFX##_customize(struct SNAME *_heap_, struct cmc_alloc_node *alloc, \
                          struct cmc_callbacks *callbacks);                   \
+    void PFX##_set_growth(struct SNAME *_heap_,                              \
+                          const struct cmc_growth *growth);                  \
     /* Collection Input and Output */                                        \
     bool PFX##_insert(struct SNAME *_heap_, V value);                        \
+    bool PFX##_insert_many(struct SNAME *_heap_, V *values, size_t count);   \
     bool PFX##_remove_max(struct SNAME *_heap_);                             \
     bool PFX##_remove_min(struct SNAME *_heap_);                             \
+    bool PFX##_offer_max(struct SNAME *_heap_, V value);                     \
+    bool PFX##_offer_min(struct SNAME *_heap_, V value);                     \
     /* Collection Update */                                                  \
     bool PFX##_update_max(struct SNAME *_heap_, V value);                    \
     bool PFX##_update_min(struct SNAME *_heap_, V value);                    \
@@ -153,6 +192,9 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
     int PFX##_flag(struct SNAME *_heap_);                                    \
     /* Collection Utility */                                                 \
     bool PFX##_resize(struct SNAME *_heap_, size_t capacity);                \
+    bool PFX##_reserve(struct SNAME *_heap_, size_t size);                   \
+    bool PFX##_shrink_to_fit(struct SNAME *_heap_);                          \
+    size_t PFX##_drain_sorted(struct SNAME *_heap_, V *out);                 \
     struct SNAME *PFX##_copy_of(struct SNAME *_set_);                        \
     bool PFX##_equals(struct SNAME *_heap1_, struct SNAME *_heap2_);         \
     struct cmc_string PFX##_to_string(struct SNAME *_heap_);                 \
@@ -180,13 +222,14 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
 /* -------------------------------------------------------------------------
  * Source
  * ------------------------------------------------------------------------- */
-#define CMC_GENERATE_INTERVALHEAP_SOURCE(PFX, SNAME, V)                        \
+#define CMC_GENERATE_INTERVALHEAP_DARY_SOURCE(PFX, SNAME, V, D)                \
                                                                                \
     /* Implementation Detail Functions */                                      \
     static void PFX##_impl_float_up_max(struct SNAME *_heap_);                 \
     static void PFX##_impl_float_up_min(struct SNAME *_heap_);                 \
-    static void PFX##_impl_float_down_max(struct SNAME *_heap_);               \
-    static void PFX##_impl_float_down_min(struct SNAME *_heap_);               \
+    static void PFX##_impl_float_down_max(struct SNAME *_heap_, size_t index); \
+    static void PFX##_impl_float_down_min(struct SNAME *_heap_, size_t index); \
+    static void PFX##_impl_heapify(struct SNAME *_heap_);                      \
                                                                                \
     struct SNAME *PFX##_new(size_t capacity, struct SNAME##_fval *f_val)       \
     {                                                                          \
@@ -216,10 +259,12 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
         _heap_->capacity = capacity;                                           \
         _heap_->size = 0;                                                      \
         _heap_->count = 0;                                                     \
+        _heap_->bound = 0;                                                     \
         _heap_->flag = cmc_flags.OK;                                           \
         _heap_->f_val = f_val;                                                 \
         _heap_->alloc = alloc;                                                 \
         _heap_->callbacks = NULL;                                              \
+        _heap_->growth = NULL;                                                 \
                                                                                \
         return _heap_;                                                         \
     }                                                                          \
@@ -255,10 +300,47 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
         _heap_->capacity = capacity;                                           \
         _heap_->size = 0;                                                      \
         _heap_->count = 0;                                                     \
+        _heap_->bound = 0;                                                     \
         _heap_->flag = cmc_flags.OK;                                           \
         _heap_->f_val = f_val;                                                 \
         _heap_->alloc = alloc;                                                 \
         _heap_->callbacks = callbacks;                                         \
+        _heap_->growth = NULL;                                                 \
+                                                                               \
+        return _heap_;                                                         \
+    }                                                                          \
+                                                                               \
+    /* Creates a heap that keeps at most bound values when they are added */   \
+    /* with offer_max or offer_min. Its buffer never has to grow */            \
+    struct SNAME *PFX##_new_bounded(size_t bound, struct SNAME##_fval *f_val)  \
+    {                                                                          \
+        struct SNAME *_heap_ = PFX##_new(bound, f_val);                        \
+                                                                               \
+        if (!_heap_)                                                           \
+            return NULL;                                                       \
+                                                                               \
+        _heap_->bound = bound;                                                 \
+                                                                               \
+        return _heap_;                                                         \
+    }                                                                          \
+                                                                               \
+    /* Creates a heap out of count values, copying them and building the */    \
+    /* heap bottom-up in O(n) instead of inserting them one by one */          \
+    struct SNAME *PFX##_from_array(V *values, size_t count,                    \
+                                   struct SNAME##_fval *f_val)                 \
+    {                                                                          \
+        struct SNAME *_heap_ = PFX##_new(count > 0 ? count : 1, f_val);        \
+                                                                               \
+        if (!_heap_)                                                           \
+            return NULL;                                                       \
+                                                                               \
+        for (size_t i = 0; i < count; i++)                                     \
+            _heap_->buffer[i / 2][i % 2] = values[i];                          \
+                                                                               \
+        _heap_->count = count;                                                 \
+        _heap_->size = count / 2 + count % 2;                                  \
+                                                                               \
+        PFX##_impl_heapify(_heap_);                                            \
                                                                                \
         return _heap_;                                                         \
     }                                                                          \
@@ -308,11 +390,28 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
         _heap_->flag = cmc_flags.OK;                                           \
     }                                                                          \
                                                                                \
+    /* Sets the growth policy used when the buffer is full (NULL for the */    \
+    /* default one) */                                                         \
+    void PFX##_set_growth(struct SNAME *_heap_,                                \
+                          const struct cmc_growth *growth)                     \
+    {                                                                          \
+        _heap_->growth = growth;                                               \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+    }                                                                          \
+                                                                               \
     bool PFX##_insert(struct SNAME *_heap_, V value)                           \
     {                                                                          \
+        /* A bounded heap only grows up to its bound */                        \
+        if (_heap_->bound != 0 && _heap_->count >= _heap_->bound)              \
+        {                                                                      \
+            _heap_->flag = cmc_flags.INVALID;                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
         if (PFX##_full(_heap_))                                                \
         {                                                                      \
-            if (!PFX##_resize(_heap_, _heap_->capacity * 4))                   \
+            if (!PFX##_reserve(_heap_, 1))                                     \
                 return false;                                                  \
         }                                                                      \
                                                                                \
@@ -348,9 +447,8 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
         if (_heap_->count > 2)                                                 \
         {                                                                      \
             /* Determine wheather to do a MaxHeap insert or a MinHeap */       \
-            /* insert. For any integer this index calculation results in */    \
-            /* an even number representing the parent of the last value */     \
-            V(*parent)[2] = &(_heap_->buffer[(_heap_->size - 2) / 2]);         \
+            /* insert by comparing with the parent of the last node */         \
+            V(*parent)[2] = &(_heap_->buffer[(_heap_->size - 2) / (D)]);       \
                                                                                \
             if (_heap_->f_val->cmp((*parent)[0], value) > 0)                   \
                 PFX##_impl_float_up_min(_heap_);                               \
@@ -365,6 +463,59 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
         return true;                                                           \
     }                                                                          \
                                                                                \
+    /* Inserts count values at once. If they are at least as many as the */    \
+    /* values already in the heap the whole heap is rebuilt bottom-up in */    \
+    /* O(n), otherwise they are inserted one by one */                         \
+    bool PFX##_insert_many(struct SNAME *_heap_, V *values, size_t count)      \
+    {                                                                          \
+        if (_heap_->bound != 0 && count > _heap_->bound - _heap_->count)       \
+        {                                                                      \
+            _heap_->flag = cmc_flags.INVALID;                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (!PFX##_reserve(_heap_, count))                                     \
+            return false;                                                      \
+                                                                               \
+        if (count == 0)                                                        \
+            return true;                                                       \
+                                                                               \
+        if (count >= _heap_->count)                                            \
+        {                                                                      \
+            /* The last node might have only its MinHeap value */              \
+            for (size_t i = 0; i < count; i++)                                 \
+            {                                                                  \
+                size_t j = _heap_->count + i;                                  \
+                                                                               \
+                _heap_->buffer[j / 2][j % 2] = values[i];                      \
+            }                                                                  \
+                                                                               \
+            _heap_->count += count;                                            \
+            _heap_->size = _heap_->count / 2 + _heap_->count % 2;              \
+                                                                               \
+            PFX##_impl_heapify(_heap_);                                        \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            struct cmc_callbacks *callbacks = _heap_->callbacks;               \
+                                                                               \
+            /* The callback is only called once */                             \
+            _heap_->callbacks = NULL;                                          \
+                                                                               \
+            for (size_t i = 0; i < count; i++)                                 \
+                PFX##_insert(_heap_, values[i]);                               \
+                                                                               \
+            _heap_->callbacks = callbacks;                                     \
+        }                                                                      \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_heap_->callbacks && _heap_->callbacks->create)                    \
+            _heap_->callbacks->create();                                       \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
     bool PFX##_remove_max(struct SNAME *_heap_)                                \
     {                                                                          \
         if (PFX##_empty(_heap_))                                               \
@@ -406,7 +557,7 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
         _heap_->count--;                                                       \
                                                                                \
         /* FLoat Down on the MaxHeap */                                        \
-        PFX##_impl_float_down_max(_heap_);                                     \
+        PFX##_impl_float_down_max(_heap_, 0);                                  \
                                                                                \
     success:                                                                   \
                                                                                \
@@ -459,7 +610,7 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
         _heap_->count--;                                                       \
                                                                                \
         /* FLoat Down on the MinHeap */                                        \
-        PFX##_impl_float_down_min(_heap_);                                     \
+        PFX##_impl_float_down_min(_heap_, 0);                                  \
                                                                                \
     success:                                                                   \
                                                                                \
@@ -471,6 +622,45 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
         return true;                                                           \
     }                                                                          \
                                                                                \
+    /* Adds a value to a bounded heap that keeps the greatest values. Once */  \
+    /* the heap is full a value is rejected in O(1) if it is not greater */    \
+    /* than the minimum, otherwise it replaces the minimum, which is not */    \
+    /* freed. Returns false if the value was not added. On a heap that is */   \
+    /* not bounded it is the same as insert */                                 \
+    bool PFX##_offer_max(struct SNAME *_heap_, V value)                        \
+    {                                                                          \
+        if (_heap_->bound == 0 || _heap_->count < _heap_->bound)               \
+            return PFX##_insert(_heap_, value);                                \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_heap_->f_val->cmp(value, _heap_->buffer[0][0]) <= 0)              \
+            return false;                                                      \
+                                                                               \
+        return PFX##_update_min(_heap_, value);                                \
+    }                                                                          \
+                                                                               \
+    /* Adds a value to a bounded heap that keeps the smallest values. Once */  \
+    /* the heap is full a value is rejected in O(1) if it is not less than */  \
+    /* the maximum, otherwise it replaces the maximum, which is not freed. */  \
+    /* Returns false if the value was not added. On a heap that is not */      \
+    /* bounded it is the same as insert */                                     \
+    bool PFX##_offer_min(struct SNAME *_heap_, V value)                        \
+    {                                                                          \
+        if (_heap_->bound == 0 || _heap_->count < _heap_->bound)               \
+            return PFX##_insert(_heap_, value);                                \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        /* With a single value it is both the minimum and the maximum */       \
+        size_t j = _heap_->count == 1 ? 0 : 1;                                 \
+                                                                               \
+        if (_heap_->f_val->cmp(value, _heap_->buffer[0][j]) >= 0)              \
+            return false;                                                      \
+                                                                               \
+        return PFX##_update_max(_heap_, value);                                \
+    }                                                                          \
+                                                                               \
     bool PFX##_update_max(struct SNAME *_heap_, V value)                       \
     {                                                                          \
         if (PFX##_empty(_heap_))                                               \
@@ -490,14 +680,14 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
             _heap_->buffer[0][1] = _heap_->buffer[0][0];                       \
             _heap_->buffer[0][0] = value;                                      \
                                                                                \
-            PFX##_impl_float_down_max(_heap_);                                 \
+            PFX##_impl_float_down_max(_heap_, 0);                              \
         }                                                                      \
         else                                                                   \
         {                                                                      \
             /* Update Max element and float it down */                         \
             _heap_->buffer[0][1] = value;                                      \
                                                                                \
-            PFX##_impl_float_down_max(_heap_);                                 \
+            PFX##_impl_float_down_max(_heap_, 0);                              \
         }                                                                      \
                                                                                \
         _heap_->flag = cmc_flags.OK;                                           \
@@ -527,14 +717,14 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
             _heap_->buffer[0][0] = _heap_->buffer[0][1];                       \
             _heap_->buffer[0][1] = value;                                      \
                                                                                \
-            PFX##_impl_float_down_min(_heap_);                                 \
+            PFX##_impl_float_down_min(_heap_, 0);                              \
         }                                                                      \
         else                                                                   \
         {                                                                      \
             /* Update Min element and float it down */                         \
             _heap_->buffer[0][0] = value;                                      \
                                                                                \
-            PFX##_impl_float_down_min(_heap_);                                 \
+            PFX##_impl_float_down_min(_heap_, 0);                              \
         }                                                                      \
                                                                                \
         _heap_->flag = cmc_flags.OK;                                           \
@@ -634,7 +824,8 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
         if (_heap_->capacity == capacity)                                      \
             goto success;                                                      \
                                                                                \
-        if (capacity < _heap_->count)                                          \
+        /* The capacity is counted in nodes */                                 \
+        if (capacity < _heap_->size)                                           \
         {                                                                      \
             _heap_->flag = cmc_flags.INVALID;                                  \
             return false;                                                      \
@@ -677,6 +868,77 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
         return true;                                                           \
     }                                                                          \
                                                                                \
+    /* Makes room for at least size more elements, growing the buffer */       \
+    /* according to the growth policy */                                       \
+    bool PFX##_reserve(struct SNAME *_heap_, size_t size)                      \
+    {                                                                          \
+        _heap_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (size <= _heap_->capacity * 2 - _heap_->count)                      \
+            return true;                                                       \
+                                                                               \
+        if (size > SIZE_MAX - _heap_->count)                                   \
+        {                                                                      \
+            _heap_->flag = cmc_flags.ERROR;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        /* The capacity is counted in nodes, which hold two elements each */   \
+        size_t required = _heap_->count + size;                                \
+        size_t nodes = required / 2 + required % 2;                            \
+                                                                               \
+        return PFX##_resize(                                                   \
+            _heap_,                                                            \
+            cmc_growth_capacity(_heap_->growth, _heap_->capacity, nodes));     \
+    }                                                                          \
+                                                                               \
+    /* Reduces the capacity to the amount of nodes in use */                   \
+    bool PFX##_shrink_to_fit(struct SNAME *_heap_)                             \
+    {                                                                          \
+        return PFX##_resize(_heap_, _heap_->size > 0 ? _heap_->size : 1);      \
+    }                                                                          \
+                                                                               \
+    /* Removes every value, copying them to out from the smallest to the */    \
+    /* greatest, and returns how many were removed. The values are not */      \
+    /* freed since they now belong to out */                                   \
+    size_t PFX##_drain_sorted(struct SNAME *_heap_, V *out)                    \
+    {                                                                          \
+        size_t count = _heap_->count;                                          \
+                                                                               \
+        if (count == 0)                                                        \
+        {                                                                      \
+            _heap_->flag = cmc_flags.EMPTY;                                    \
+            return 0;                                                          \
+        }                                                                      \
+                                                                               \
+        struct cmc_callbacks *callbacks = _heap_->callbacks;                   \
+                                                                               \
+        /* The callback is only called once */                                 \
+        _heap_->callbacks = NULL;                                              \
+                                                                               \
+        /* Takes values from both ends of the heap at once */                  \
+        for (size_t i = 0, j = count; i < j; i++, j--)                         \
+        {                                                                      \
+            out[i] = _heap_->buffer[0][0];                                     \
+            PFX##_remove_min(_heap_);                                          \
+                                                                               \
+            if (i + 1 < j)                                                     \
+            {                                                                  \
+                out[j - 1] = _heap_->buffer[0][_heap_->count == 1 ? 0 : 1];    \
+                PFX##_remove_max(_heap_);                                      \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        _heap_->callbacks = callbacks;                                         \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_heap_->callbacks && _heap_->callbacks->delete)                    \
+            _heap_->callbacks->delete ();                                      \
+                                                                               \
+        return count;                                                          \
+    }                                                                          \
+                                                                               \
     struct SNAME *PFX##_copy_of(struct SNAME *_heap_)                          \
     {                                                                          \
         struct SNAME *result = _heap_->alloc->malloc(sizeof(struct SNAME));    \
@@ -952,7 +1214,7 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
         while (index > 0)                                                      \
         {                                                                      \
             /* Parent index */                                                 \
-            size_t P_index = (index - 1) / 2;                                  \
+            size_t P_index = (index - 1) / (D);                                \
                                                                                \
             V(*parent)[2] = &(_heap_->buffer[P_index]);                        \
                                                                                \
@@ -999,7 +1261,7 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
         while (index > 0)                                                      \
         {                                                                      \
             /* Parent index */                                                 \
-            size_t P_index = (index - 1) / 2;                                  \
+            size_t P_index = (index - 1) / (D);                                \
                                                                                \
             V(*parent)[2] = &(_heap_->buffer[P_index]);                        \
                                                                                \
@@ -1017,45 +1279,37 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
         }                                                                      \
     }                                                                          \
                                                                                \
-    static void PFX##_impl_float_down_max(struct SNAME *_heap_)                \
+    static void PFX##_impl_float_down_max(struct SNAME *_heap_, size_t index)  \
     {                                                                          \
-        /* Floats Down from the MinHeap */                                     \
-        size_t index = 0;                                                      \
-                                                                               \
+        /* Floats Down on the MaxHeap */                                       \
         V(*curr_node)[2] = &(_heap_->buffer[index]);                           \
                                                                                \
         while (true)                                                           \
         {                                                                      \
+            /* The children of a node are next to each other */                \
+            size_t first = index * (D) + 1;                                    \
+                                                                               \
             /* If there are no children it is done */                          \
-            if (2 * index + 1 >= _heap_->size)                                 \
+            if (first >= _heap_->size)                                         \
                 break;                                                         \
                                                                                \
-            /* Child index to be compared with current value */                \
-            size_t child;                                                      \
-            size_t L_index = index * 2 + 1;                                    \
-            size_t R_index = index * 2 + 2;                                    \
+            size_t last =                                                      \
+                _heap_->size - first > (D) ? first + (D) : _heap_->size;       \
+                                                                               \
+            /* Pick the child with the greatest MaxHeap value */               \
+            size_t child = first;                                              \
                                                                                \
-            /* If there are two children, pick the smallest one */             \
-            if (R_index < _heap_->size)                                        \
+            for (size_t i = first + 1; i < last; i++)                          \
             {                                                                  \
-                V(*L)[2] = &(_heap_->buffer[L_index]);                         \
-                V(*R)[2] = &(_heap_->buffer[R_index]);                         \
-                                                                               \
-                /* If the right child is the last node and there is no */      \
-                /* MaxHeap value */                                            \
-                /* then do the comparison with the MinHeap value */            \
-                if (R_index == _heap_->size - 1 && _heap_->count % 2 != 0)     \
-                    child = _heap_->f_val->cmp((*L)[1], (*R)[0]) > 0           \
-                                ? L_index                                      \
-                                : R_index;                                     \
-                else                                                           \
-                    child = _heap_->f_val->cmp((*L)[1], (*R)[1]) > 0           \
-                                ? L_index                                      \
-                                : R_index;                                     \
+                /* If the child is the last node and there is no MaxHeap */    \
+                /* value then do the comparison with the MinHeap value */      \
+                int j =                                                        \
+                    i == _heap_->size - 1 && _heap_->count % 2 != 0 ? 0 : 1;   \
+                                                                               \
+                if (_heap_->f_val->cmp(_heap_->buffer[child][1],               \
+                                       _heap_->buffer[i][j]) <= 0)             \
+                    child = i;                                                 \
             }                                                                  \
-            /* Pick the only one available */                                  \
-            else                                                               \
-                child = L_index;                                               \
                                                                                \
             V(*child_node)[2] = &(_heap_->buffer[child]);                      \
                                                                                \
@@ -1107,36 +1361,32 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
         }                                                                      \
     }                                                                          \
                                                                                \
-    static void PFX##_impl_float_down_min(struct SNAME *_heap_)                \
+    static void PFX##_impl_float_down_min(struct SNAME *_heap_, size_t index)  \
     {                                                                          \
-        /* Floats Down from the MinHeap */                                     \
-        size_t index = 0;                                                      \
-                                                                               \
+        /* Floats Down on the MinHeap */                                       \
         V(*curr_node)[2] = &(_heap_->buffer[index]);                           \
                                                                                \
         while (true)                                                           \
         {                                                                      \
+            /* The children of a node are next to each other */                \
+            size_t first = index * (D) + 1;                                    \
+                                                                               \
             /* If there are no children it is done */                          \
-            if (2 * index + 1 >= _heap_->size)                                 \
+            if (first >= _heap_->size)                                         \
                 break;                                                         \
                                                                                \
-            /* Child index to be compared with current value */                \
-            size_t child;                                                      \
-            size_t L_index = index * 2 + 1;                                    \
-            size_t R_index = index * 2 + 2;                                    \
+            size_t last =                                                      \
+                _heap_->size - first > (D) ? first + (D) : _heap_->size;       \
                                                                                \
-            /* If there are two children, pick the smallest one */             \
-            if (R_index < _heap_->size)                                        \
-            {                                                                  \
-                V(*L)[2] = &(_heap_->buffer[L_index]);                         \
-                V(*R)[2] = &(_heap_->buffer[R_index]);                         \
+            /* Pick the child with the smallest MinHeap value */               \
+            size_t child = first;                                              \
                                                                                \
-                child = _heap_->f_val->cmp((*L)[0], (*R)[0]) < 0 ? L_index     \
-                                                                 : R_index;    \
+            for (size_t i = first + 1; i < last; i++)                          \
+            {                                                                  \
+                if (_heap_->f_val->cmp(_heap_->buffer[child][0],               \
+                                       _heap_->buffer[i][0]) >= 0)             \
+                    child = i;                                                 \
             }                                                                  \
-            /* Pick the only one available */                                  \
-            else                                                               \
-                child = L_index;                                               \
                                                                                \
             V(*child_node)[2] = &(_heap_->buffer[child]);                      \
                                                                                \
@@ -1169,6 +1419,35 @@ static const char *cmc_string_fmt_intervalheap = "struct %s<%s> "
             index = child;                                                     \
             curr_node = child_node;                                            \
         }                                                                      \
+    }                                                                          \
+                                                                               \
+    /* Builds the heap bottom-up: the two values of each node are put in */    \
+    /* order and then every node that has children floats down on both */      \
+    /* heaps, starting from the last one */                                    \
+    static void PFX##_impl_heapify(struct SNAME *_heap_)                       \
+    {                                                                          \
+        /* A last node with a single value has no MaxHeap value */             \
+        size_t full = _heap_->count / 2;                                       \
+                                                                               \
+        for (size_t i = 0; i < full; i++)                                      \
+        {                                                                      \
+            if (_heap_->f_val->cmp(_heap_->buffer[i][0],                       \
+                                   _heap_->buffer[i][1]) > 0)                  \
+            {                                                                  \
+                V tmp = _heap_->buffer[i][0];                                  \
+                _heap_->buffer[i][0] = _heap_->buffer[i][1];                   \
+                _heap_->buffer[i][1] = tmp;                                    \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        if (_heap_->size < 2)                                                  \
+            return;                                                            \
+                                                                               \
+        for (size_t i = (_heap_->size - 2) / (D) + 1; i > 0; i--)              \
+        {                                                                      \
+            PFX##_impl_float_down_min(_heap_, i - 1);                          \
+            PFX##_impl_float_down_max(_heap_, i - 1);                          \
+        }                                                                      \
     }
 
 #endif /* CMC_INTERVALHEAP_H */
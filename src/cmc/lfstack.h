@@ -0,0 +1,770 @@
+/**
+ * lfstack.h
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * LFStack
+ *
+ * A lock-free Stack that can be shared by any number of threads. It is a
+ * Treiber stack: a singly-linked list of nodes where the top node is replaced
+ * with a compare-and-swap by every push and pop.
+ *
+ * The nodes come from chunks that are only freed with the stack, so a thread
+ * can always read a node that another thread has just popped. Popped nodes go
+ * to a second Treiber stack of unused nodes and are reused by the next pushes.
+ * Nodes are referenced by their index in the chunks plus one (zero is the end
+ * of the list) and the chunks double in size, so there are at most 32 of
+ * them. This lets the top of each list be a single 64-bit word with the index
+ * of the top node in the lower 32 bits and a tag in the upper 32 bits. The tag
+ * is incremented by every change, so a compare-and-swap fails if the top was
+ * popped and pushed back in between (the ABA problem).
+ *
+ * The functions push_n and pop_n move many values with a single
+ * compare-and-swap on the top of the stack, and pop_all detaches the whole
+ * stack at once.
+ *
+ * Magazines are optional per-thread caches. A thread pushes to and pops from
+ * its own magazine and only goes to the shared stack to move half a magazine
+ * at once, when the magazine is full or empty. A magazine must only be used
+ * by one thread at a time and it must be flushed before the stack is freed.
+ * Values kept in magazines are not in the stack, and values that go through
+ * magazines are not kept in LIFO order.
+ *
+ * The functions new, clear, free and print must not be called while other
+ * threads are using the stack. The functions that can be called concurrently
+ * don't update the stack's flag since many threads would write to it; their
+ * result tells if they succeeded. There is no count since keeping one would
+ * add a shared counter to every push and pop.
+ */
+
+#ifndef CMC_LFSTACK_H
+#define CMC_LFSTACK_H
+
+/* -------------------------------------------------------------------------
+ * Core functionalities of the C Macro Collections Library
+ * ------------------------------------------------------------------------- */
+#include "../cor/core.h"
+
+#include <stdatomic.h>
+
+/* -------------------------------------------------------------------------
+ * LFStack specific
+ * ------------------------------------------------------------------------- */
+/* to_string format */
+static const char *cmc_string_fmt_lfstack = "struct %s<%s> "
+                                            "at %p { "
+                                            "head:%" PRIuMAX ", "
+                                            "free_head:%" PRIuMAX ", "
+                                            "nodes:%" PRIuMAX ", "
+                                            "chunk_size:%" PRIuMAX ", "
+                                            "flag:%d, "
+                                            "f_val:%p, "
+                                            "alloc:%p, "
+                                            "callbacks:%p }";
+
+/* Size in bytes of a cache line */
+#ifndef CMC_LFSTACK_CACHE_LINE
+#define CMC_LFSTACK_CACHE_LINE 64
+#endif /* CMC_LFSTACK_CACHE_LINE */
+
+/* Amount of values held by a magazine, which must be at least 2 */
+#ifndef CMC_LFSTACK_MAGAZINE
+#define CMC_LFSTACK_MAGAZINE 32
+#endif /* CMC_LFSTACK_MAGAZINE */
+
+/* Maximum amount of chunks of nodes */
+#define CMC_LFSTACK_CHUNKS 32
+
+#define CMC_GENERATE_LFSTACK(PFX, SNAME, V)    \
+    CMC_GENERATE_LFSTACK_HEADER(PFX, SNAME, V) \
+    CMC_GENERATE_LFSTACK_SOURCE(PFX, SNAME, V)
+
+#define CMC_WRAPGEN_LFSTACK_HEADER(PFX, SNAME, K, V) \
+    CMC_GENERATE_LFSTACK_HEADER(PFX, SNAME, V)
+
+#define CMC_WRAPGEN_LFSTACK_SOURCE(PFX, SNAME, K, V) \
+    CMC_GENERATE_LFSTACK_SOURCE(PFX, SNAME, V)
+
+/* -------------------------------------------------------------------------
+ * Header
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_LFSTACK_HEADER(PFX, SNAME, V)                             \
+                                                                               \
+    /* LFStack Structure */                                                    \
+    struct SNAME                                                               \
+    {                                                                          \
+        /* The structure is not aligned to a cache line when it comes from */  \
+        /* malloc, so a whole line of padding separates each part of it */     \
+        char pad_0[CMC_LFSTACK_CACHE_LINE];                                    \
+                                                                               \
+        /* Top of the stack, with a tag in the upper 32 bits */                \
+        _Atomic uint64_t head;                                                 \
+                                                                               \
+        char pad_1[CMC_LFSTACK_CACHE_LINE];                                    \
+                                                                               \
+        /* Top of the list of unused nodes, with a tag in the upper 32 bits */ \
+        _Atomic uint64_t free_head;                                            \
+                                                                               \
+        char pad_2[CMC_LFSTACK_CACHE_LINE];                                    \
+                                                                               \
+        /* Amount of nodes taken from the chunks */                            \
+        _Atomic size_t nodes;                                                  \
+                                                                               \
+        /* Chunk k holds chunk_size << k nodes */                              \
+        _Atomic(struct SNAME##_node *) chunks[CMC_LFSTACK_CHUNKS];             \
+                                                                               \
+        /* Size of the first chunk, which is a power of two */                 \
+        size_t chunk_size;                                                     \
+                                                                               \
+        /* Flags indicating errors or success */                               \
+        int flag;                                                              \
+                                                                               \
+        /* Value function table */                                             \
+        struct SNAME##_fval *f_val;                                            \
+                                                                               \
+        /* Custom allocation functions */                                      \
+        struct cmc_alloc_node *alloc;                                          \
+                                                                               \
+        /* Custom callback functions */                                        \
+        struct cmc_callbacks *callbacks;                                       \
+    };                                                                         \
+                                                                               \
+    /* LFStack Node */                                                         \
+    struct SNAME##_node                                                        \
+    {                                                                          \
+        /* Reference to the node below this one */                             \
+        _Atomic uint32_t next;                                                 \
+                                                                               \
+        /* Value stored in this node */                                        \
+        V value;                                                               \
+    };                                                                         \
+                                                                               \
+    /* LFStack Magazine */                                                     \
+    struct SNAME##_magazine                                                    \
+    {                                                                          \
+        /* Target stack */                                                     \
+        struct SNAME *target;                                                  \
+                                                                               \
+        /* Current amount of values */                                         \
+        size_t count;                                                          \
+                                                                               \
+        /* Values cached by the thread */                                      \
+        V values[CMC_LFSTACK_MAGAZINE];                                        \
+    };                                                                         \
+                                                                               \
+    /* Value struct function table */                                          \
+    struct SNAME##_fval                                                        \
+    {                                                                          \
+        /* Comparator function */                                              \
+        int (*cmp)(V, V);                                                      \
+                                                                               \
+        /* Copy function */                                                    \
+        V (*cpy)(V);                                                           \
+                                                                               \
+        /* To string function */                                               \
+        bool (*str)(FILE *, V);                                                \
+                                                                               \
+        /* Free from memory function */                                        \
+        void (*free)(V);                                                       \
+                                                                               \
+        /* Hash function */                                                    \
+        size_t (*hash)(V);                                                     \
+                                                                               \
+        /* Priority function */                                                \
+        int (*pri)(V, V);                                                      \
+    };                                                                         \
+                                                                               \
+    /* Collection Functions */                                                 \
+    /* Collection Allocation and Deallocation */                               \
+    struct SNAME *PFX##_new(size_t capacity, struct SNAME##_fval *f_val);      \
+    struct SNAME *PFX##_new_custom(                                            \
+        size_t capacity, struct SNAME##_fval *f_val,                           \
+        struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks);        \
+    void PFX##_clear(struct SNAME *_stack_);                                   \
+    void PFX##_free(struct SNAME *_stack_);                                    \
+    /* Customization of Allocation and Callbacks */                            \
+    void PFX##_customize(struct SNAME *_stack_, struct cmc_alloc_node *alloc,  \
+                         struct cmc_callbacks *callbacks);                     \
+    /* Collection Input and Output */                                          \
+    bool PFX##_push(struct SNAME *_stack_, V value);                           \
+    bool PFX##_pop(struct SNAME *_stack_, V *out);                             \
+    bool PFX##_push_n(struct SNAME *_stack_, V *values, size_t n);             \
+    size_t PFX##_pop_n(struct SNAME *_stack_, V *out, size_t n);               \
+    size_t PFX##_pop_all(struct SNAME *_stack_, void (*consume)(V, void *),    \
+                         void *args);                                          \
+    /* Magazine Functions */                                                   \
+    void PFX##_mag_init(struct SNAME##_magazine *mag, struct SNAME *target);   \
+    bool PFX##_mag_push(struct SNAME##_magazine *mag, V value);                \
+    bool PFX##_mag_pop(struct SNAME##_magazine *mag, V *out);                  \
+    bool PFX##_mag_flush(struct SNAME##_magazine *mag);                        \
+    /* Collection State */                                                     \
+    bool PFX##_empty(struct SNAME *_stack_);                                   \
+    int PFX##_flag(struct SNAME *_stack_);                                     \
+    /* Collection Utility */                                                   \
+    struct cmc_string PFX##_to_string(struct SNAME *_stack_);                  \
+    bool PFX##_print(struct SNAME *_stack_, FILE *fptr);
+
+/* -------------------------------------------------------------------------
+ * Source
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_LFSTACK_SOURCE(PFX, SNAME, V)                             \
+                                                                               \
+    /* Implementation Detail Functions */                                      \
+    static struct SNAME##_node *PFX##_impl_node(struct SNAME *_stack_,         \
+                                                uint32_t ref);                 \
+    static size_t PFX##_impl_pop_chain(struct SNAME *_stack_,                  \
+                                       _Atomic uint64_t *top, size_t n,        \
+                                       uint32_t *first, uint32_t *last);       \
+    static void PFX##_impl_push_chain(struct SNAME *_stack_,                   \
+                                      _Atomic uint64_t *top, uint32_t first,   \
+                                      uint32_t last);                          \
+    static bool PFX##_impl_alloc_chain(struct SNAME *_stack_, size_t n,        \
+                                       uint32_t *first, uint32_t *last);       \
+                                                                               \
+    struct SNAME *PFX##_new(size_t capacity, struct SNAME##_fval *f_val)       \
+    {                                                                          \
+        return PFX##_new_custom(capacity, f_val, NULL, NULL);                  \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_new_custom(                                            \
+        size_t capacity, struct SNAME##_fval *f_val,                           \
+        struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks)         \
+    {                                                                          \
+        if (capacity < 1 || capacity > UINT32_MAX - 1)                         \
+            return NULL;                                                       \
+                                                                               \
+        if (!f_val)                                                            \
+            return NULL;                                                       \
+                                                                               \
+        if (!alloc)                                                            \
+            alloc = &cmc_alloc_node_default;                                   \
+                                                                               \
+        size_t chunk_size = 16;                                                \
+                                                                               \
+        while (chunk_size < capacity)                                          \
+            chunk_size *= 2;                                                   \
+                                                                               \
+        struct SNAME *_stack_ = alloc->malloc(sizeof(struct SNAME));           \
+                                                                               \
+        if (!_stack_)                                                          \
+            return NULL;                                                       \
+                                                                               \
+        struct SNAME##_node *chunk =                                           \
+            alloc->malloc(chunk_size * sizeof(struct SNAME##_node));           \
+                                                                               \
+        if (!chunk)                                                            \
+        {                                                                      \
+            alloc->free(_stack_);                                              \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        atomic_init(&_stack_->head, 0);                                        \
+        atomic_init(&_stack_->free_head, 0);                                   \
+        atomic_init(&_stack_->nodes, 0);                                       \
+        atomic_init(&_stack_->chunks[0], chunk);                               \
+                                                                               \
+        for (size_t i = 1; i < CMC_LFSTACK_CHUNKS; i++)                        \
+            atomic_init(&_stack_->chunks[i], NULL);                            \
+                                                                               \
+        _stack_->chunk_size = chunk_size;                                      \
+        _stack_->flag = cmc_flags.OK;                                          \
+        _stack_->f_val = f_val;                                                \
+        _stack_->alloc = alloc;                                                \
+        _stack_->callbacks = callbacks;                                        \
+                                                                               \
+        return _stack_;                                                        \
+    }                                                                          \
+                                                                               \
+    void PFX##_clear(struct SNAME *_stack_)                                    \
+    {                                                                          \
+        uint64_t head =                                                        \
+            atomic_load_explicit(&_stack_->head, memory_order_relaxed);        \
+        uint32_t ref = (uint32_t)head;                                         \
+        uint32_t last = 0;                                                     \
+                                                                               \
+        if (ref != 0)                                                          \
+        {                                                                      \
+            for (uint32_t r = ref; r != 0;)                                    \
+            {                                                                  \
+                struct SNAME##_node *node = PFX##_impl_node(_stack_, r);       \
+                                                                               \
+                if (_stack_->f_val->free)                                      \
+                    _stack_->f_val->free(node->value);                         \
+                                                                               \
+                last = r;                                                      \
+                r = atomic_load_explicit(&node->next, memory_order_relaxed);   \
+            }                                                                  \
+                                                                               \
+            PFX##_impl_push_chain(_stack_, &_stack_->free_head, ref, last);    \
+                                                                               \
+            atomic_store_explicit(&_stack_->head, ((head >> 32) + 1) << 32,    \
+                                  memory_order_relaxed);                       \
+        }                                                                      \
+                                                                               \
+        _stack_->flag = cmc_flags.OK;                                          \
+    }                                                                          \
+                                                                               \
+    void PFX##_free(struct SNAME *_stack_)                                     \
+    {                                                                          \
+        if (_stack_->f_val->free)                                              \
+        {                                                                      \
+            uint64_t head =                                                    \
+                atomic_load_explicit(&_stack_->head, memory_order_relaxed);    \
+                                                                               \
+            for (uint32_t r = (uint32_t)head; r != 0;)                         \
+            {                                                                  \
+                struct SNAME##_node *node = PFX##_impl_node(_stack_, r);       \
+                                                                               \
+                _stack_->f_val->free(node->value);                             \
+                                                                               \
+                r = atomic_load_explicit(&node->next, memory_order_relaxed);   \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        for (size_t i = 0; i < CMC_LFSTACK_CHUNKS; i++)                        \
+        {                                                                      \
+            struct SNAME##_node *chunk = atomic_load_explicit(                 \
+                &_stack_->chunks[i], memory_order_relaxed);                    \
+                                                                               \
+            if (chunk)                                                         \
+                _stack_->alloc->free(chunk);                                   \
+        }                                                                      \
+                                                                               \
+        _stack_->alloc->free(_stack_);                                         \
+    }                                                                          \
+                                                                               \
+    void PFX##_customize(struct SNAME *_stack_, struct cmc_alloc_node *alloc,  \
+                         struct cmc_callbacks *callbacks)                      \
+    {                                                                          \
+        if (!alloc)                                                            \
+            _stack_->alloc = &cmc_alloc_node_default;                          \
+        else                                                                   \
+            _stack_->alloc = alloc;                                            \
+                                                                               \
+        _stack_->callbacks = callbacks;                                        \
+                                                                               \
+        _stack_->flag = cmc_flags.OK;                                          \
+    }                                                                          \
+                                                                               \
+    bool PFX##_push(struct SNAME *_stack_, V value)                            \
+    {                                                                          \
+        uint32_t ref, last;                                                    \
+                                                                               \
+        if (!PFX##_impl_alloc_chain(_stack_, 1, &ref, &last))                  \
+            return false;                                                      \
+                                                                               \
+        PFX##_impl_node(_stack_, ref)->value = value;                          \
+                                                                               \
+        PFX##_impl_push_chain(_stack_, &_stack_->head, ref, ref);              \
+                                                                               \
+        if (_stack_->callbacks && _stack_->callbacks->create)                  \
+            _stack_->callbacks->create();                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_pop(struct SNAME *_stack_, V *out)                              \
+    {                                                                          \
+        uint32_t ref, last;                                                    \
+                                                                               \
+        if (PFX##_impl_pop_chain(_stack_, &_stack_->head, 1, &ref, &last) ==   \
+            0)                                                                 \
+            return false;                                                      \
+                                                                               \
+        if (out)                                                               \
+            *out = PFX##_impl_node(_stack_, ref)->value;                       \
+                                                                               \
+        PFX##_impl_push_chain(_stack_, &_stack_->free_head, ref, ref);         \
+                                                                               \
+        if (_stack_->callbacks && _stack_->callbacks->delete)                  \
+            _stack_->callbacks->delete ();                                     \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Pushes values[0] first and values[n - 1] last, so it ends up on top */  \
+    bool PFX##_push_n(struct SNAME *_stack_, V *values, size_t n)              \
+    {                                                                          \
+        if (n == 0)                                                            \
+            return true;                                                       \
+                                                                               \
+        uint32_t first, last;                                                  \
+                                                                               \
+        if (!PFX##_impl_alloc_chain(_stack_, n, &first, &last))                \
+            return false;                                                      \
+                                                                               \
+        uint32_t ref = first;                                                  \
+                                                                               \
+        for (size_t i = n; i > 0; i--)                                         \
+        {                                                                      \
+            struct SNAME##_node *node = PFX##_impl_node(_stack_, ref);         \
+                                                                               \
+            node->value = values[i - 1];                                       \
+                                                                               \
+            ref = atomic_load_explicit(&node->next, memory_order_relaxed);     \
+        }                                                                      \
+                                                                               \
+        PFX##_impl_push_chain(_stack_, &_stack_->head, first, last);           \
+                                                                               \
+        if (_stack_->callbacks && _stack_->callbacks->create)                  \
+            _stack_->callbacks->create();                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Pops up to n values, copying them to out (from the top down) if it */   \
+    /* is not NULL, and returns how many were popped */                        \
+    size_t PFX##_pop_n(struct SNAME *_stack_, V *out, size_t n)                \
+    {                                                                          \
+        uint32_t first, last;                                                  \
+                                                                               \
+        size_t count =                                                         \
+            PFX##_impl_pop_chain(_stack_, &_stack_->head, n, &first, &last);   \
+                                                                               \
+        if (count == 0)                                                        \
+            return 0;                                                          \
+                                                                               \
+        if (out)                                                               \
+        {                                                                      \
+            uint32_t ref = first;                                              \
+                                                                               \
+            for (size_t i = 0; i < count; i++)                                 \
+            {                                                                  \
+                struct SNAME##_node *node = PFX##_impl_node(_stack_, ref);     \
+                                                                               \
+                out[i] = node->value;                                          \
+                                                                               \
+                ref = atomic_load_explicit(&node->next, memory_order_relaxed); \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        PFX##_impl_push_chain(_stack_, &_stack_->free_head, first, last);      \
+                                                                               \
+        if (_stack_->callbacks && _stack_->callbacks->delete)                  \
+            _stack_->callbacks->delete ();                                     \
+                                                                               \
+        return count;                                                          \
+    }                                                                          \
+                                                                               \
+    /* Detaches the whole stack with a single compare-and-swap and passes */   \
+    /* each value to consume, from the top down, if it is not NULL */          \
+    size_t PFX##_pop_all(struct SNAME *_stack_, void (*consume)(V, void *),    \
+                         void *args)                                           \
+    {                                                                          \
+        uint64_t head =                                                        \
+            atomic_load_explicit(&_stack_->head, memory_order_acquire);        \
+                                                                               \
+        do                                                                     \
+        {                                                                      \
+            if ((uint32_t)head == 0)                                           \
+                return 0;                                                      \
+        } while (!atomic_compare_exchange_weak_explicit(                       \
+            &_stack_->head, &head, ((head >> 32) + 1) << 32,                   \
+            memory_order_acquire, memory_order_acquire));                      \
+                                                                               \
+        uint32_t first = (uint32_t)head;                                       \
+        uint32_t last = 0;                                                     \
+        size_t count = 0;                                                      \
+                                                                               \
+        for (uint32_t ref = first; ref != 0; count++)                          \
+        {                                                                      \
+            struct SNAME##_node *node = PFX##_impl_node(_stack_, ref);         \
+                                                                               \
+            if (consume)                                                       \
+                consume(node->value, args);                                    \
+                                                                               \
+            last = ref;                                                        \
+            ref = atomic_load_explicit(&node->next, memory_order_relaxed);     \
+        }                                                                      \
+                                                                               \
+        PFX##_impl_push_chain(_stack_, &_stack_->free_head, first, last);      \
+                                                                               \
+        if (_stack_->callbacks && _stack_->callbacks->delete)                  \
+            _stack_->callbacks->delete ();                                     \
+                                                                               \
+        return count;                                                          \
+    }                                                                          \
+                                                                               \
+    void PFX##_mag_init(struct SNAME##_magazine *mag, struct SNAME *target)    \
+    {                                                                          \
+        mag->target = target;                                                  \
+        mag->count = 0;                                                        \
+    }                                                                          \
+                                                                               \
+    /* When the magazine is full its newest half is pushed to the stack */     \
+    bool PFX##_mag_push(struct SNAME##_magazine *mag, V value)                 \
+    {                                                                          \
+        if (mag->count == CMC_LFSTACK_MAGAZINE)                                \
+        {                                                                      \
+            size_t half = CMC_LFSTACK_MAGAZINE / 2;                            \
+                                                                               \
+            if (!PFX##_push_n(mag->target, mag->values + half,                 \
+                              CMC_LFSTACK_MAGAZINE - half))                    \
+                return false;                                                  \
+                                                                               \
+            mag->count = half;                                                 \
+        }                                                                      \
+                                                                               \
+        mag->values[mag->count++] = value;                                     \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* When the magazine is empty it takes up to half a magazine from the */   \
+    /* stack */                                                                \
+    bool PFX##_mag_pop(struct SNAME##_magazine *mag, V *out)                   \
+    {                                                                          \
+        if (mag->count == 0)                                                   \
+        {                                                                      \
+            mag->count = PFX##_pop_n(mag->target, mag->values,                 \
+                                     CMC_LFSTACK_MAGAZINE / 2);                \
+                                                                               \
+            if (mag->count == 0)                                               \
+                return false;                                                  \
+        }                                                                      \
+                                                                               \
+        mag->count--;                                                          \
+                                                                               \
+        if (out)                                                               \
+            *out = mag->values[mag->count];                                    \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_mag_flush(struct SNAME##_magazine *mag)                         \
+    {                                                                          \
+        if (!PFX##_push_n(mag->target, mag->values, mag->count))               \
+            return false;                                                      \
+                                                                               \
+        mag->count = 0;                                                        \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_empty(struct SNAME *_stack_)                                    \
+    {                                                                          \
+        return (uint32_t)atomic_load_explicit(&_stack_->head,                  \
+                                              memory_order_acquire) == 0;      \
+    }                                                                          \
+                                                                               \
+    int PFX##_flag(struct SNAME *_stack_)                                      \
+    {                                                                          \
+        return _stack_->flag;                                                  \
+    }                                                                          \
+                                                                               \
+    struct cmc_string PFX##_to_string(struct SNAME *_stack_)                   \
+    {                                                                          \
+        struct cmc_string str;                                                 \
+        struct SNAME *s_ = _stack_;                                            \
+                                                                               \
+        int n = snprintf(                                                      \
+            str.s, cmc_string_len, cmc_string_fmt_lfstack, #SNAME, #V, s_,     \
+            (uintmax_t)(uint32_t)atomic_load_explicit(&s_->head,               \
+                                                      memory_order_relaxed),   \
+            (uintmax_t)(uint32_t)atomic_load_explicit(&s_->free_head,          \
+                                                      memory_order_relaxed),   \
+            (uintmax_t)atomic_load_explicit(&s_->nodes, memory_order_relaxed), \
+            s_->chunk_size, s_->flag, s_->f_val, s_->alloc, s_->callbacks);    \
+                                                                               \
+        return n >= 0 ? str : (struct cmc_string){ 0 };                        \
+    }                                                                          \
+                                                                               \
+    bool PFX##_print(struct SNAME *_stack_, FILE *fptr)                        \
+    {                                                                          \
+        uint64_t head =                                                        \
+            atomic_load_explicit(&_stack_->head, memory_order_relaxed);        \
+                                                                               \
+        for (uint32_t ref = (uint32_t)head; ref != 0;)                         \
+        {                                                                      \
+            struct SNAME##_node *node = PFX##_impl_node(_stack_, ref);         \
+                                                                               \
+            if (!_stack_->f_val->str(fptr, node->value))                       \
+                return false;                                                  \
+                                                                               \
+            ref = atomic_load_explicit(&node->next, memory_order_relaxed);     \
+        }                                                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Finds the node of a reference, which is its index plus one */           \
+    static struct SNAME##_node *PFX##_impl_node(struct SNAME *_stack_,         \
+                                                uint32_t ref)                  \
+    {                                                                          \
+        size_t index = ref - 1;                                                \
+        size_t size = _stack_->chunk_size;                                     \
+        size_t k = 0;                                                          \
+                                                                               \
+        while (index >= size)                                                  \
+        {                                                                      \
+            index -= size;                                                     \
+            size *= 2;                                                         \
+            k++;                                                               \
+        }                                                                      \
+                                                                               \
+        return atomic_load_explicit(&_stack_->chunks[k],                       \
+                                    memory_order_acquire) +                    \
+               index;                                                          \
+    }                                                                          \
+                                                                               \
+    /* Detaches up to n nodes from the top of a list and returns how many */   \
+    /* were detached. The nodes are walked before the compare-and-swap and */  \
+    /* might be changed by other threads meanwhile, but then the tag of the */ \
+    /* top has changed too and the compare-and-swap fails */                   \
+    static size_t PFX##_impl_pop_chain(struct SNAME *_stack_,                  \
+                                       _Atomic uint64_t *top, size_t n,        \
+                                       uint32_t *first, uint32_t *last)        \
+    {                                                                          \
+        if (n == 0)                                                            \
+            return 0;                                                          \
+                                                                               \
+        uint64_t old = atomic_load_explicit(top, memory_order_acquire);        \
+                                                                               \
+        for (;;)                                                               \
+        {                                                                      \
+            uint32_t ref = (uint32_t)old;                                      \
+                                                                               \
+            if (ref == 0)                                                      \
+                return 0;                                                      \
+                                                                               \
+            uint32_t end = ref;                                                \
+            size_t count = 1;                                                  \
+            uint32_t next = atomic_load_explicit(                              \
+                &PFX##_impl_node(_stack_, end)->next, memory_order_acquire);   \
+                                                                               \
+            while (count < n && next != 0)                                     \
+            {                                                                  \
+                end = next;                                                    \
+                count++;                                                       \
+                next =                                                         \
+                    atomic_load_explicit(&PFX##_impl_node(_stack_, end)->next, \
+                                         memory_order_acquire);                \
+            }                                                                  \
+                                                                               \
+            uint64_t new_top = (((old >> 32) + 1) << 32) | next;               \
+                                                                               \
+            if (atomic_compare_exchange_weak_explicit(top, &old, new_top,      \
+                                                      memory_order_acquire,    \
+                                                      memory_order_acquire))   \
+            {                                                                  \
+                *first = ref;                                                  \
+                *last = end;                                                   \
+                                                                               \
+                return count;                                                  \
+            }                                                                  \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    /* Pushes a chain of nodes linked from first to last on top of a list */   \
+    static void PFX##_impl_push_chain(struct SNAME *_stack_,                   \
+                                      _Atomic uint64_t *top, uint32_t first,   \
+                                      uint32_t last)                           \
+    {                                                                          \
+        struct SNAME##_node *node = PFX##_impl_node(_stack_, last);            \
+        uint64_t old = atomic_load_explicit(top, memory_order_relaxed);        \
+        uint64_t new_top;                                                      \
+                                                                               \
+        do                                                                     \
+        {                                                                      \
+            atomic_store_explicit(&node->next, (uint32_t)old,                  \
+                                  memory_order_release);                       \
+                                                                               \
+            new_top = (((old >> 32) + 1) << 32) | first;                       \
+                                                                               \
+        } while (!atomic_compare_exchange_weak_explicit(                       \
+            top, &old, new_top, memory_order_release, memory_order_relaxed));  \
+    }                                                                          \
+                                                                               \
+    /* Takes a chain of n nodes, first from the list of unused nodes and */    \
+    /* then from the chunks, allocating new chunks when needed */              \
+    static bool PFX##_impl_alloc_chain(struct SNAME *_stack_, size_t n,        \
+                                       uint32_t *first, uint32_t *last)        \
+    {                                                                          \
+        size_t count = PFX##_impl_pop_chain(_stack_, &_stack_->free_head, n,   \
+                                            first, last);                      \
+                                                                               \
+        if (count == n)                                                        \
+            return true;                                                       \
+                                                                               \
+        size_t m = n - count;                                                  \
+        size_t start = atomic_fetch_add_explicit(&_stack_->nodes, m,           \
+                                                 memory_order_relaxed);        \
+                                                                               \
+        size_t reserved = start + m;                                           \
+                                                                               \
+        if (start + m > UINT32_MAX - 1 || start + m < start)                   \
+            goto error;                                                        \
+                                                                               \
+        /* Makes sure the chunks of the nodes start to start + m exist */      \
+        size_t begin = 0;                                                      \
+        size_t size = _stack_->chunk_size;                                     \
+                                                                               \
+        for (size_t k = 0; begin < start + m; k++)                             \
+        {                                                                      \
+            if (begin + size > start &&                                        \
+                !atomic_load_explicit(&_stack_->chunks[k],                     \
+                                      memory_order_acquire))                   \
+            {                                                                  \
+                struct SNAME##_node *chunk = _stack_->alloc->malloc(           \
+                    size * sizeof(struct SNAME##_node));                       \
+                                                                               \
+                if (!chunk)                                                    \
+                    goto error;                                                \
+                                                                               \
+                struct SNAME##_node *expected = NULL;                          \
+                                                                               \
+                /* Another thread might have allocated it meanwhile */         \
+                if (!atomic_compare_exchange_strong_explicit(                  \
+                        &_stack_->chunks[k], &expected, chunk,                 \
+                        memory_order_release, memory_order_acquire))           \
+                    _stack_->alloc->free(chunk);                               \
+            }                                                                  \
+                                                                               \
+            begin += size;                                                     \
+            size *= 2;                                                         \
+        }                                                                      \
+                                                                               \
+        /* The chunks are not zeroed, so every new node must be linked, the */ \
+        /* last one included, before the chain can be reached by a thread */   \
+        /* walking the list of unused nodes */                                 \
+        for (size_t i = 0; i < m; i++)                                         \
+        {                                                                      \
+            uint32_t ref = (uint32_t)(start + i + 1);                          \
+                                                                               \
+            atomic_store_explicit(&PFX##_impl_node(_stack_, ref)->next,        \
+                                  i + 1 < m ? ref + 1 : 0,                     \
+                                  memory_order_relaxed);                       \
+        }                                                                      \
+                                                                               \
+        if (count == 0)                                                        \
+            *first = (uint32_t)(start + 1);                                    \
+        else                                                                   \
+            atomic_store_explicit(&PFX##_impl_node(_stack_, *last)->next,      \
+                                  (uint32_t)(start + 1),                       \
+                                  memory_order_release);                       \
+                                                                               \
+        *last = (uint32_t)(start + m);                                         \
+                                                                               \
+        return true;                                                           \
+                                                                               \
+    error:                                                                     \
+        /* Gives the indices back, unless another thread has taken more */     \
+        /* since then, in which case they are skipped */                       \
+        atomic_compare_exchange_strong_explicit(&_stack_->nodes, &reserved,    \
+                                                start, memory_order_relaxed,   \
+                                                memory_order_relaxed);         \
+                                                                               \
+        if (count > 0)                                                         \
+            PFX##_impl_push_chain(_stack_, &_stack_->free_head, *first,        \
+                                  *last);                                      \
+                                                                               \
+        return false;                                                          \
+    }
+
+#endif /* CMC_LFSTACK_H */
@@ -23,6 +23,14 @@
  * and removals at both ends in O(1) and in a given index in O(N). The list has
  * a head and tail pointer. The head points to the first element in the sequence
  * and tail points to the last.
+ *
+ * Node Pool
+ *
+ * By default every node is allocated and freed on its own. A list can instead
+ * use a node pool (see set_pool), which allocates nodes in chunks and keeps the
+ * removed nodes in a free list to be reused by the next insertions. The chunks
+ * are only released when the list is freed or the pool is disabled, so nodes
+ * never move and the node functions keep working the same way.
  */
 
 #ifndef CMC_LINKEDLIST_H
@@ -85,6 +93,15 @@ static const char *cmc_string_fmt_linkedlist = "struct %s<%s> "
                                                                              \
         /* Custom callback functions */                                      \
         struct cmc_callbacks *callbacks;                                     \
+                                                                             \
+        /* Removed nodes kept for reuse when the node pool is enabled */     \
+        struct SNAME##_node *pool;                                           \
+                                                                             \
+        /* Chunks of nodes allocated by the node pool */                     \
+        struct SNAME##_chunk *chunks;                                        \
+                                                                             \
+        /* Amount of nodes per chunk or 0 if the node pool is disabled */    \
+        size_t chunk_size;                                                   \
     };                                                                       \
                                                                              \
     /* Doubly-linked list node */                                            \
@@ -100,6 +117,16 @@ static const char *cmc_string_fmt_linkedlist = "struct %s<%s> "
         struct SNAME##_node *prev;                                           \
     };                                                                       \
                                                                              \
+    /* Chunk of nodes allocated at once by the node pool */                  \
+    struct SNAME##_chunk                                                     \
+    {                                                                        \
+        /* Previously allocated chunk */                                     \
+        struct SNAME##_chunk *next;                                          \
+                                                                             \
+        /* Nodes of this chunk */                                            \
+        struct SNAME##_node nodes[];                                         \
+    };                                                                       \
+                                                                             \
     /* Value struct function table */                                        \
     struct SNAME##_fval                                                      \
     {                                                                        \
@@ -152,6 +179,7 @@ static const char *cmc_string_fmt_linkedlist = "struct %s<%s> "
     /* Customization of Allocation and Callbacks */                          \
     void PFX##_customize(struct SNAME *_list_, struct cmc_alloc_node *alloc, \
                          struct cmc_callbacks *callbacks);                   \
+    bool PFX##_set_pool(struct SNAME *_list_, size_t chunk_size);            \
     /* Collection Input and Output */                                        \
     bool PFX##_push_front(struct SNAME *_list_, V value);                    \
     bool PFX##_push_at(struct SNAME *_list_, V value, size_t index);         \
@@ -222,7 +250,7 @@ static const char *cmc_string_fmt_linkedlist = "struct %s<%s> "
 #define CMC_GENERATE_LINKEDLIST_SOURCE(PFX, SNAME, V)                          \
                                                                                \
     /* Implementation Detail Functions */                                      \
-    /* None */                                                                 \
+    static void PFX##_impl_release_chunks(struct SNAME *_list_);               \
                                                                                \
     struct SNAME *PFX##_new(struct SNAME##_fval *f_val)                        \
     {                                                                          \
@@ -243,6 +271,9 @@ static const char *cmc_string_fmt_linkedlist = "struct %s<%s> "
         _list_->f_val = f_val;                                                 \
         _list_->alloc = alloc;                                                 \
         _list_->callbacks = NULL;                                              \
+        _list_->pool = NULL;                                                   \
+        _list_->chunks = NULL;                                                 \
+        _list_->chunk_size = 0;                                                \
                                                                                \
         return _list_;                                                         \
     }                                                                          \
@@ -269,12 +300,40 @@ static const char *cmc_string_fmt_linkedlist = "struct %s<%s> "
         _list_->f_val = f_val;                                                 \
         _list_->alloc = alloc;                                                 \
         _list_->callbacks = callbacks;                                         \
+        _list_->pool = NULL;                                                   \
+        _list_->chunks = NULL;                                                 \
+        _list_->chunk_size = 0;                                                \
                                                                                \
         return _list_;                                                         \
     }                                                                          \
                                                                                \
     void PFX##_clear(struct SNAME *_list_)                                     \
     {                                                                          \
+        /* With the node pool, the nodes are all moved to its free list at */  \
+        /* once and only the values need to be visited */                      \
+        if (_list_->chunk_size > 0)                                            \
+        {                                                                      \
+            if (_list_->f_val->free)                                           \
+            {                                                                  \
+                for (struct SNAME##_node *scan = _list_->head; scan != NULL;   \
+                     scan = scan->next)                                        \
+                    _list_->f_val->free(scan->value);                          \
+            }                                                                  \
+                                                                               \
+            if (_list_->tail != NULL)                                          \
+            {                                                                  \
+                _list_->tail->next = _list_->pool;                             \
+                _list_->pool = _list_->head;                                   \
+            }                                                                  \
+                                                                               \
+            _list_->count = 0;                                                 \
+            _list_->head = NULL;                                               \
+            _list_->tail = NULL;                                               \
+            _list_->flag = cmc_flags.OK;                                       \
+                                                                               \
+            return;                                                            \
+        }                                                                      \
+                                                                               \
         struct SNAME##_node *scan = _list_->head;                              \
                                                                                \
         while (_list_->head != NULL)                                           \
@@ -301,6 +360,8 @@ static const char *cmc_string_fmt_linkedlist = "struct %s<%s> "
     {                                                                          \
         PFX##_clear(_list_);                                                   \
                                                                                \
+        PFX##_impl_release_chunks(_list_);                                     \
+                                                                               \
         _list_->alloc->free(_list_);                                           \
     }                                                                          \
                                                                                \
@@ -317,6 +378,32 @@ static const char *cmc_string_fmt_linkedlist = "struct %s<%s> "
         _list_->flag = cmc_flags.OK;                                           \
     }                                                                          \
                                                                                \
+    /* Enables the node pool, allocating nodes in chunks of chunk_size, or */  \
+    /* disables it if chunk_size is 0, releasing its chunks. This can only */  \
+    /* be done while the list is empty. */                                     \
+    bool PFX##_set_pool(struct SNAME *_list_, size_t chunk_size)               \
+    {                                                                          \
+        if (!PFX##_empty(_list_))                                              \
+        {                                                                      \
+            _list_->flag = cmc_flags.INVALID;                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (chunk_size > (SIZE_MAX - sizeof(struct SNAME##_chunk)) /           \
+                             sizeof(struct SNAME##_node))                      \
+        {                                                                      \
+            _list_->flag = cmc_flags.ERROR;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        PFX##_impl_release_chunks(_list_);                                     \
+                                                                               \
+        _list_->chunk_size = chunk_size;                                       \
+        _list_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
     bool PFX##_push_front(struct SNAME *_list_, V value)                       \
     {                                                                          \
         struct SNAME##_node *_node_ = PFX##_new_node(_list_, value);           \
@@ -422,7 +509,7 @@ static const char *cmc_string_fmt_linkedlist = "struct %s<%s> "
         struct SNAME##_node *_node_ = _list_->head;                            \
         _list_->head = _list_->head->next;                                     \
                                                                                \
-        _list_->alloc->free(_node_);                                           \
+        PFX##_free_node(_list_, _node_);                                       \
                                                                                \
         if (_list_->head == NULL)                                              \
             _list_->tail = NULL;                                               \
@@ -469,7 +556,7 @@ static const char *cmc_string_fmt_linkedlist = "struct %s<%s> "
         _node_->next->prev = _node_->prev;                                     \
         _node_->prev->next = _node_->next;                                     \
                                                                                \
-        _list_->alloc->free(_node_);                                           \
+        PFX##_free_node(_list_, _node_);                                       \
                                                                                \
         _list_->count--;                                                       \
         _list_->flag = cmc_flags.OK;                                           \
@@ -491,7 +578,7 @@ static const char *cmc_string_fmt_linkedlist = "struct %s<%s> "
         struct SNAME##_node *_node_ = _list_->tail;                            \
         _list_->tail = _list_->tail->prev;                                     \
                                                                                \
-        _list_->alloc->free(_node_);                                           \
+        PFX##_free_node(_list_, _node_);                                       \
                                                                                \
         if (_list_->tail == NULL)                                              \
             _list_->head = NULL;                                               \
@@ -637,6 +724,8 @@ static const char *cmc_string_fmt_linkedlist = "struct %s<%s> "
         if (!result)                                                           \
             return NULL;                                                       \
                                                                                \
+        PFX##_set_pool(result, _list_->chunk_size);                            \
+                                                                               \
         struct SNAME##_node *scan = _list_->head;                              \
                                                                                \
         while (scan != NULL)                                                   \
@@ -647,9 +736,9 @@ static const char *cmc_string_fmt_linkedlist = "struct %s<%s> "
                                                                                \
             if (_list_->f_val->cpy)                                            \
                 new_node =                                                     \
-                    PFX##_new_node(_list_, _list_->f_val->cpy(scan->value));   \
+                    PFX##_new_node(result, _list_->f_val->cpy(scan->value));   \
             else                                                               \
-                new_node = PFX##_new_node(_list_, scan->value);                \
+                new_node = PFX##_new_node(result, scan->value);                \
                                                                                \
             if (!result->head)                                                 \
             {                                                                  \
@@ -725,13 +814,44 @@ static const char *cmc_string_fmt_linkedlist = "struct %s<%s> "
                                                                                \
     struct SNAME##_node *PFX##_new_node(struct SNAME *_list_, V value)         \
     {                                                                          \
-        struct SNAME##_node *_node_ =                                          \
-            _list_->alloc->malloc(sizeof(struct SNAME##_node));                \
+        struct SNAME##_node *_node_;                                           \
                                                                                \
-        if (!_node_)                                                           \
+        if (_list_->chunk_size == 0)                                           \
         {                                                                      \
-            _list_->flag = cmc_flags.ALLOC;                                    \
-            return NULL;                                                       \
+            _node_ = _list_->alloc->malloc(sizeof(struct SNAME##_node));       \
+                                                                               \
+            if (!_node_)                                                       \
+            {                                                                  \
+                _list_->flag = cmc_flags.ALLOC;                                \
+                return NULL;                                                   \
+            }                                                                  \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            if (!_list_->pool)                                                 \
+            {                                                                  \
+                struct SNAME##_chunk *chunk = _list_->alloc->malloc(           \
+                    sizeof(struct SNAME##_chunk) +                             \
+                    sizeof(struct SNAME##_node) * _list_->chunk_size);         \
+                                                                               \
+                if (!chunk)                                                    \
+                {                                                              \
+                    _list_->flag = cmc_flags.ALLOC;                            \
+                    return NULL;                                               \
+                }                                                              \
+                                                                               \
+                chunk->next = _list_->chunks;                                  \
+                _list_->chunks = chunk;                                        \
+                                                                               \
+                for (size_t i = _list_->chunk_size; i > 0; i--)                \
+                {                                                              \
+                    chunk->nodes[i - 1].next = _list_->pool;                   \
+                    _list_->pool = &chunk->nodes[i - 1];                       \
+                }                                                              \
+            }                                                                  \
+                                                                               \
+            _node_ = _list_->pool;                                             \
+            _list_->pool = _node_->next;                                       \
         }                                                                      \
                                                                                \
         _node_->value = value;                                                 \
@@ -741,9 +861,16 @@ static const char *cmc_string_fmt_linkedlist = "struct %s<%s> "
         return _node_;                                                         \
     }                                                                          \
                                                                                \
+    /* With the node pool enabled the node is kept for reuse */                \
     void PFX##_free_node(struct SNAME *_list_, struct SNAME##_node *_node_)    \
     {                                                                          \
-        _list_->alloc->free(_node_);                                           \
+        if (_list_->chunk_size == 0)                                           \
+            _list_->alloc->free(_node_);                                       \
+        else                                                                   \
+        {                                                                      \
+            _node_->next = _list_->pool;                                       \
+            _list_->pool = _node_;                                             \
+        }                                                                      \
     }                                                                          \
                                                                                \
     struct SNAME##_node *PFX##_head(struct SNAME *_list_)                      \
@@ -859,7 +986,7 @@ static const char *cmc_string_fmt_linkedlist = "struct %s<%s> "
         else                                                                   \
             _owner_->tail = _node_;                                            \
                                                                                \
-        _owner_->alloc->free(tmp);                                             \
+        PFX##_free_node(_owner_, tmp);                                         \
                                                                                \
         _owner_->count--;                                                      \
         _owner_->flag = cmc_flags.OK;                                          \
@@ -879,7 +1006,7 @@ static const char *cmc_string_fmt_linkedlist = "struct %s<%s> "
         else                                                                   \
             _owner_->tail = _node_->prev;                                      \
                                                                                \
-        _owner_->alloc->free(_node_);                                          \
+        PFX##_free_node(_owner_, _node_);                                      \
                                                                                \
         _owner_->count--;                                                      \
         _owner_->flag = cmc_flags.OK;                                          \
@@ -904,7 +1031,7 @@ static const char *cmc_string_fmt_linkedlist = "struct %s<%s> "
         else                                                                   \
             _owner_->head = _node_;                                            \
                                                                                \
-        _owner_->alloc->free(tmp);                                             \
+        PFX##_free_node(_owner_, tmp);                                         \
                                                                                \
         _owner_->count--;                                                      \
         _owner_->flag = cmc_flags.OK;                                          \
@@ -1118,6 +1245,23 @@ static const char *cmc_string_fmt_linkedlist = "struct %s<%s> "
     struct SNAME##_node *PFX##_iter_node(struct SNAME##_iter *iter)            \
     {                                                                          \
         return iter->cursor;                                                   \
+    }                                                                          \
+                                                                               \
+    static void PFX##_impl_release_chunks(struct SNAME *_list_)                \
+    {                                                                          \
+        struct SNAME##_chunk *chunk = _list_->chunks;                          \
+                                                                               \
+        while (chunk != NULL)                                                  \
+        {                                                                      \
+            struct SNAME##_chunk *next = chunk->next;                          \
+                                                                               \
+            _list_->alloc->free(chunk);                                        \
+                                                                               \
+            chunk = next;                                                      \
+        }                                                                      \
+                                                                               \
+        _list_->pool = NULL;                                                   \
+        _list_->chunks = NULL;                                                 \
     }
 
 #endif /* CMC_LINKEDLIST_H */
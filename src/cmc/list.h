@@ -34,6 +34,10 @@
  * left. Is is also possible to remove a range of elements or extract them,
  * creating a new list with the removed items.
  *
+ * The list is sorted with a comparison sort or, when it is generated with
+ * CMC_GENERATE_LIST_RADIX, with a radix sort over integer keys extracted from
+ * its elements.
+ *
  * The iterator is a simple structure that is capable of going back and
  * forwards. Any modifications to the target list during iteration is considered
  * undefined behavior. Its sole purpose is to facilitate navigation through a
@@ -47,6 +51,8 @@
  * Core functionalities of the C Macro Collections Library
  * ------------------------------------------------------------------------- */
 #include "../cor/core.h"
+#include "../cor/search.h"
+#include "../cor/sort.h"
 
 /* -------------------------------------------------------------------------
  * List specific
@@ -66,6 +72,25 @@ static const char *cmc_string_fmt_list = "struct %s<%s> "
     CMC_GENERATE_LIST_HEADER(PFX, SNAME, V) \
     CMC_GENERATE_LIST_SOURCE(PFX, SNAME, V)
 
+/* Generates a List that is sorted with a radix sort over the keys KEY(value) */
+/* of type K, which must be an unsigned integer (see cor/sort.h) */
+#define CMC_GENERATE_LIST_RADIX(PFX, SNAME, V, K, KEY) \
+    CMC_GENERATE_LIST_HEADER(PFX, SNAME, V)            \
+    CMC_GENERATE_LIST_SOURCE_RADIX(PFX, SNAME, V, K, KEY)
+
+/* Generates a List of plain old data, which is searched by comparing the */
+/* bytes of the elements instead of calling the comparator (see cor/search.h) */
+#define CMC_GENERATE_LIST_POD(PFX, SNAME, V) \
+    CMC_GENERATE_LIST_HEADER(PFX, SNAME, V)  \
+    CMC_GENERATE_LIST_SOURCE_POD(PFX, SNAME, V)
+
+/* The parallel sort depends on utl/thread.h and utl/condvar.h, which must */
+/* be included before expanding it, and it must be expanded in the same file */
+/* as the SOURCE part of the List */
+#define CMC_GENERATE_LIST_PARALLEL(PFX, SNAME, V)    \
+    CMC_GENERATE_LIST_PARALLEL_HEADER(PFX, SNAME, V) \
+    CMC_GENERATE_LIST_PARALLEL_SOURCE(PFX, SNAME, V)
+
 #define CMC_WRAPGEN_LIST_HEADER(PFX, SNAME, K, V) \
     CMC_GENERATE_LIST_HEADER(PFX, SNAME, V)
 
@@ -100,6 +125,9 @@ static const char *cmc_string_fmt_list = "struct %s<%s> "
                                                                              \
         /* Custom callback functions */                                      \
         struct cmc_callbacks *callbacks;                                     \
+                                                                             \
+        /* Growth policy of the buffer */                                    \
+        const struct cmc_growth *growth;                                     \
     };                                                                       \
                                                                              \
     /* Value struct function table */                                        \
@@ -151,6 +179,8 @@ static const char *cmc_string_fmt_list = "struct %s<%s> "
     /* Customization of Allocation and Callbacks */                          \
     void PFX##_customize(struct SNAME *_list_, struct cmc_alloc_node *alloc, \
                          struct cmc_callbacks *callbacks);                   \
+    void PFX##_set_growth(struct SNAME *_list_,                              \
+                          const struct cmc_growth *growth);                  \
     /* Collection Input and Output */                                        \
     bool PFX##_push_front(struct SNAME *_list_, V value);                    \
     bool PFX##_push_at(struct SNAME *_list_, V value, size_t index);         \
@@ -182,6 +212,10 @@ static const char *cmc_string_fmt_list = "struct %s<%s> "
     int PFX##_flag(struct SNAME *_list_);                                    \
     /* Collection Utility */                                                 \
     bool PFX##_resize(struct SNAME *_list_, size_t capacity);                \
+    bool PFX##_reserve(struct SNAME *_list_, size_t size);                   \
+    bool PFX##_shrink_to_fit(struct SNAME *_list_);                          \
+    void PFX##_sort(struct SNAME *_list_);                                   \
+    bool PFX##_sort_range(struct SNAME *_list_, size_t from, size_t to);     \
     struct SNAME *PFX##_copy_of(struct SNAME *_list_);                       \
     bool PFX##_equals(struct SNAME *_list1_, struct SNAME *_list2_);         \
     struct cmc_string PFX##_to_string(struct SNAME *_list_);                 \
@@ -210,10 +244,29 @@ static const char *cmc_string_fmt_list = "struct %s<%s> "
 /* -------------------------------------------------------------------------
  * Source
  * ------------------------------------------------------------------------- */
-#define CMC_GENERATE_LIST_SOURCE(PFX, SNAME, V)                                \
+/* The source is made of three parts: the search, the core functions and */
+/* the sort. These macros combine the default ones, but any other */
+/* combination of them can be expanded instead. */
+#define CMC_GENERATE_LIST_SOURCE(PFX, SNAME, V)  \
+    CMC_GENERATE_SEARCH(PFX, V)                  \
+    CMC_GENERATE_LIST_CORE_SOURCE(PFX, SNAME, V) \
+    CMC_GENERATE_LIST_SORT_SOURCE(PFX, SNAME, V)
+
+#define CMC_GENERATE_LIST_SOURCE_POD(PFX, SNAME, V) \
+    CMC_GENERATE_SEARCH_POD(PFX, V)                 \
+    CMC_GENERATE_LIST_CORE_SOURCE(PFX, SNAME, V)    \
+    CMC_GENERATE_LIST_SORT_SOURCE(PFX, SNAME, V)
+
+#define CMC_GENERATE_LIST_SOURCE_RADIX(PFX, SNAME, V, K, KEY) \
+    CMC_GENERATE_SEARCH(PFX, V)                               \
+    CMC_GENERATE_LIST_CORE_SOURCE(PFX, SNAME, V)              \
+    CMC_GENERATE_LIST_RADIX_SORT_SOURCE(PFX, SNAME, V, K, KEY)
+
+#define CMC_GENERATE_LIST_CORE_SOURCE(PFX, SNAME, V)                           \
                                                                                \
     /* Implementation Detail Functions */                                      \
-    /* None */                                                                 \
+    static void PFX##_impl_sort_array(struct SNAME *_list_, V *array,          \
+                                      size_t count);                           \
                                                                                \
     struct SNAME *PFX##_new(size_t capacity, struct SNAME##_fval *f_val)       \
     {                                                                          \
@@ -241,6 +294,7 @@ static const char *cmc_string_fmt_list = "struct %s<%s> "
         _list_->f_val = f_val;                                                 \
         _list_->alloc = alloc;                                                 \
         _list_->callbacks = NULL;                                              \
+        _list_->growth = NULL;                                                 \
                                                                                \
         return _list_;                                                         \
     }                                                                          \
@@ -277,6 +331,7 @@ static const char *cmc_string_fmt_list = "struct %s<%s> "
         _list_->f_val = f_val;                                                 \
         _list_->alloc = alloc;                                                 \
         _list_->callbacks = callbacks;                                         \
+        _list_->growth = NULL;                                                 \
                                                                                \
         return _list_;                                                         \
     }                                                                          \
@@ -320,11 +375,21 @@ static const char *cmc_string_fmt_list = "struct %s<%s> "
         _list_->flag = cmc_flags.OK;                                           \
     }                                                                          \
                                                                                \
+    /* Sets the growth policy used when the buffer is full (NULL for the */    \
+    /* default one) */                                                         \
+    void PFX##_set_growth(struct SNAME *_list_,                                \
+                          const struct cmc_growth *growth)                     \
+    {                                                                          \
+        _list_->growth = growth;                                               \
+                                                                               \
+        _list_->flag = cmc_flags.OK;                                           \
+    }                                                                          \
+                                                                               \
     bool PFX##_push_front(struct SNAME *_list_, V value)                       \
     {                                                                          \
         if (PFX##_full(_list_))                                                \
         {                                                                      \
-            if (!PFX##_resize(_list_, _list_->count * 2))                      \
+            if (!PFX##_reserve(_list_, 1))                                     \
                 return false;                                                  \
         }                                                                      \
                                                                                \
@@ -355,7 +420,7 @@ static const char *cmc_string_fmt_list = "struct %s<%s> "
                                                                                \
         if (PFX##_full(_list_))                                                \
         {                                                                      \
-            if (!PFX##_resize(_list_, _list_->count * 2))                      \
+            if (!PFX##_reserve(_list_, 1))                                     \
                 return false;                                                  \
         }                                                                      \
                                                                                \
@@ -376,7 +441,7 @@ static const char *cmc_string_fmt_list = "struct %s<%s> "
     {                                                                          \
         if (PFX##_full(_list_))                                                \
         {                                                                      \
-            if (!PFX##_resize(_list_, _list_->count * 2))                      \
+            if (!PFX##_reserve(_list_, 1))                                     \
                 return false;                                                  \
         }                                                                      \
                                                                                \
@@ -459,7 +524,7 @@ static const char *cmc_string_fmt_list = "struct %s<%s> "
                                                                                \
         if (!PFX##_fits(_list_, size))                                         \
         {                                                                      \
-            if (!PFX##_resize(_list_, _list_->count + size))                   \
+            if (!PFX##_reserve(_list_, size))                                  \
                 return false;                                                  \
         }                                                                      \
                                                                                \
@@ -499,7 +564,7 @@ static const char *cmc_string_fmt_list = "struct %s<%s> "
                                                                                \
         if (!PFX##_fits(_list_, size))                                         \
         {                                                                      \
-            if (!PFX##_resize(_list_, _list_->count + size))                   \
+            if (!PFX##_reserve(_list_, size))                                  \
                 return false;                                                  \
         }                                                                      \
                                                                                \
@@ -527,7 +592,7 @@ static const char *cmc_string_fmt_list = "struct %s<%s> "
                                                                                \
         if (!PFX##_fits(_list_, size))                                         \
         {                                                                      \
-            if (!PFX##_resize(_list_, _list_->count + size))                   \
+            if (!PFX##_reserve(_list_, size))                                  \
                 return false;                                                  \
         }                                                                      \
                                                                                \
@@ -698,30 +763,14 @@ static const char *cmc_string_fmt_list = "struct %s<%s> "
     {                                                                          \
         _list_->flag = cmc_flags.OK;                                           \
                                                                                \
-        size_t result = _list_->count;                                         \
+        size_t result;                                                         \
                                                                                \
         if (from_start)                                                        \
-        {                                                                      \
-            for (size_t i = 0; i < _list_->count; i++)                         \
-            {                                                                  \
-                if (_list_->f_val->cmp(_list_->buffer[i], value) == 0)         \
-                {                                                              \
-                    result = i;                                                \
-                    break;                                                     \
-                }                                                              \
-            }                                                                  \
-        }                                                                      \
+            result = PFX##_impl_search(_list_->buffer, _list_->count, value,   \
+                                       _list_->f_val->cmp);                    \
         else                                                                   \
-        {                                                                      \
-            for (size_t i = _list_->count; i > 0; i--)                         \
-            {                                                                  \
-                if (_list_->f_val->cmp(_list_->buffer[i - 1], value) == 0)     \
-                {                                                              \
-                    result = i - 1;                                            \
-                    break;                                                     \
-                }                                                              \
-            }                                                                  \
-        }                                                                      \
+            result = PFX##_impl_search_last(_list_->buffer, _list_->count,     \
+                                            value, _list_->f_val->cmp);        \
                                                                                \
         if (_list_->callbacks && _list_->callbacks->read)                      \
             _list_->callbacks->read();                                         \
@@ -733,16 +782,8 @@ static const char *cmc_string_fmt_list = "struct %s<%s> "
     {                                                                          \
         _list_->flag = cmc_flags.OK;                                           \
                                                                                \
-        bool result = false;                                                   \
-                                                                               \
-        for (size_t i = 0; i < _list_->count; i++)                             \
-        {                                                                      \
-            if (_list_->f_val->cmp(_list_->buffer[i], value) == 0)             \
-            {                                                                  \
-                result = true;                                                 \
-                break;                                                         \
-            }                                                                  \
-        }                                                                      \
+        bool result = PFX##_impl_search(_list_->buffer, _list_->count, value,  \
+                                        _list_->f_val->cmp) < _list_->count;   \
                                                                                \
         if (_list_->callbacks && _list_->callbacks->read)                      \
             _list_->callbacks->read();                                         \
@@ -802,8 +843,6 @@ static const char *cmc_string_fmt_list = "struct %s<%s> "
             return false;                                                      \
         }                                                                      \
                                                                                \
-        /* TODO zero out new slots */                                          \
-                                                                               \
         _list_->buffer = new_buffer;                                           \
         _list_->capacity = capacity;                                           \
                                                                                \
@@ -813,6 +852,68 @@ static const char *cmc_string_fmt_list = "struct %s<%s> "
         return true;                                                           \
     }                                                                          \
                                                                                \
+    /* Makes room for at least size more elements, growing the buffer */       \
+    /* according to the growth policy */                                       \
+    bool PFX##_reserve(struct SNAME *_list_, size_t size)                      \
+    {                                                                          \
+        _list_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (size <= _list_->capacity - _list_->count)                          \
+            return true;                                                       \
+                                                                               \
+        if (size > SIZE_MAX - _list_->count)                                   \
+        {                                                                      \
+            _list_->flag = cmc_flags.ERROR;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        return PFX##_resize(                                                   \
+            _list_, cmc_growth_capacity(_list_->growth, _list_->capacity,      \
+                                        _list_->count + size));                \
+    }                                                                          \
+                                                                               \
+    /* Reduces the capacity to the amount of elements */                       \
+    bool PFX##_shrink_to_fit(struct SNAME *_list_)                             \
+    {                                                                          \
+        return PFX##_resize(_list_, _list_->count > 0 ? _list_->count : 1);    \
+    }                                                                          \
+                                                                               \
+    /* Sorts the list in ascending order */                                    \
+    void PFX##_sort(struct SNAME *_list_)                                      \
+    {                                                                          \
+        PFX##_impl_sort_array(_list_, _list_->buffer, _list_->count);          \
+                                                                               \
+        _list_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_list_->callbacks && _list_->callbacks->update)                    \
+            _list_->callbacks->update();                                       \
+    }                                                                          \
+                                                                               \
+    /* Sorts the elements in the range [from, to] in ascending order */        \
+    bool PFX##_sort_range(struct SNAME *_list_, size_t from, size_t to)        \
+    {                                                                          \
+        if (from > to)                                                         \
+        {                                                                      \
+            _list_->flag = cmc_flags.INVALID;                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (to >= _list_->count)                                               \
+        {                                                                      \
+            _list_->flag = cmc_flags.RANGE;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        PFX##_impl_sort_array(_list_, _list_->buffer + from, to - from + 1);   \
+                                                                               \
+        _list_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_list_->callbacks && _list_->callbacks->update)                    \
+            _list_->callbacks->update();                                       \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
     struct SNAME *PFX##_copy_of(struct SNAME *_list_)                          \
     {                                                                          \
         struct SNAME *result =                                                 \
@@ -834,6 +935,7 @@ static const char *cmc_string_fmt_list = "struct %s<%s> "
             memcpy(result->buffer, _list_->buffer, sizeof(V) * _list_->count); \
                                                                                \
         result->count = _list_->count;                                         \
+        result->growth = _list_->growth;                                       \
                                                                                \
         _list_->flag = cmc_flags.OK;                                           \
                                                                                \
@@ -1062,4 +1164,59 @@ static const char *cmc_string_fmt_list = "struct %s<%s> "
         return iter->cursor;                                                   \
     }
 
+/* -------------------------------------------------------------------------
+ * Sort Source
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_LIST_SORT_SOURCE(PFX, SNAME, V)                  \
+                                                                      \
+    CMC_GENERATE_SORT(PFX, V)                                         \
+                                                                      \
+    static void PFX##_impl_sort_array(struct SNAME *_list_, V *array, \
+                                      size_t count)                   \
+    {                                                                 \
+        PFX##_impl_sort(array, count, _list_->f_val->cmp);            \
+    }
+
+#define CMC_GENERATE_LIST_RADIX_SORT_SOURCE(PFX, SNAME, V, K, KEY)    \
+                                                                      \
+    CMC_GENERATE_SORT_RADIX(PFX, V, K, KEY)                           \
+                                                                      \
+    static void PFX##_impl_sort_array(struct SNAME *_list_, V *array, \
+                                      size_t count)                   \
+    {                                                                 \
+        PFX##_impl_sort_radix(array, count, _list_->alloc,            \
+                              _list_->f_val->cmp);                    \
+    }
+
+/* -------------------------------------------------------------------------
+ * Parallel Sort
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_LIST_PARALLEL_HEADER(PFX, SNAME, V)              \
+                                                                      \
+    /* Sorts the list using up to the given amount of threads. The */ \
+    /* allocator of the list must be thread-safe. */                  \
+    void PFX##_sort_parallel(struct SNAME *_list_, size_t threads);
+
+#define CMC_GENERATE_LIST_PARALLEL_SOURCE(PFX, SNAME, V)                      \
+                                                                              \
+    CMC_GENERATE_SORT_PARALLEL(PFX, SNAME, V)                                 \
+                                                                              \
+    static void PFX##_impl_sort_chunk(V *array, size_t count, void *args)     \
+    {                                                                         \
+        PFX##_impl_sort_array((struct SNAME *)args, array, count);            \
+    }                                                                         \
+                                                                              \
+    void PFX##_sort_parallel(struct SNAME *_list_, size_t threads)            \
+    {                                                                         \
+        if (!PFX##_impl_sort_parallel(_list_->buffer, _list_->count, threads, \
+                                      _list_->alloc, _list_->f_val->cmp,      \
+                                      PFX##_impl_sort_chunk, _list_))         \
+            PFX##_impl_sort_array(_list_, _list_->buffer, _list_->count);     \
+                                                                              \
+        _list_->flag = cmc_flags.OK;                                          \
+                                                                              \
+        if (_list_->callbacks && _list_->callbacks->update)                   \
+            _list_->callbacks->update();                                      \
+    }
+
 #endif /* CMC_LIST_H */
@@ -0,0 +1,647 @@
+/**
+ * mpmcqueue.h
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * MPMCQueue
+ *
+ * A multi-producer/multi-consumer Queue. It is a bounded ring buffer that can
+ * be shared by any number of threads enqueueing and dequeueing elements at
+ * the same time without a global lock.
+ *
+ * Each cell of the buffer has a sequence number that tells whose turn it is
+ * to use the cell. A producer may write to the cell at position `pos` when
+ * its sequence is `pos` and a consumer may read from it when its sequence is
+ * `pos + 1`. Producers and consumers claim a position by incrementing the
+ * `enqueue_pos` or `dequeue_pos` with a compare-and-swap, so threads only
+ * contend with the threads on the same side and never for the same cell.
+ * After a cell is written its sequence becomes `pos + 1` and after it is read
+ * its sequence becomes `pos + capacity`, which is the position it will have
+ * in the next lap around the buffer. The capacity is rounded up to a power of
+ * two (and at least 2).
+ *
+ * The try functions never block and return false if the queue is full (for
+ * enqueue) or empty (for dequeue). The blocking functions enqueue and dequeue
+ * first spin on their try functions CMC_MPMCQUEUE_SPIN times and then sleep on
+ * a condition variable (see utl/condvar.h) until another thread makes room or
+ * adds an element. The mutex is only used by sleeping threads and by the
+ * threads that wake them up.
+ *
+ * The functions new, clear, free, customize and print must not be called
+ * while other threads are using the queue. The try functions don't update the
+ * queue's flag since many threads would write to it; their result tells if
+ * they succeeded. Callbacks are called from the thread that enqueued or
+ * dequeued the element.
+ */
+
+#ifndef CMC_MPMCQUEUE_H
+#define CMC_MPMCQUEUE_H
+
+/* -------------------------------------------------------------------------
+ * Core functionalities of the C Macro Collections Library
+ * ------------------------------------------------------------------------- */
+#include "../cor/core.h"
+#include "../utl/condvar.h"
+#include "../utl/mutex.h"
+
+#include <stdatomic.h>
+
+/* -------------------------------------------------------------------------
+ * MPMCQueue specific
+ * ------------------------------------------------------------------------- */
+/* to_string format */
+static const char *cmc_string_fmt_mpmcqueue = "struct %s<%s> "
+                                              "at %p { "
+                                              "buffer:%p, "
+                                              "capacity:%" PRIuMAX ", "
+                                              "enqueue_pos:%" PRIuMAX ", "
+                                              "dequeue_pos:%" PRIuMAX ", "
+                                              "flag:%d, "
+                                              "f_val:%p, "
+                                              "alloc:%p, "
+                                              "callbacks:%p }";
+
+/* Size in bytes of a cache line */
+#ifndef CMC_MPMCQUEUE_CACHE_LINE
+#define CMC_MPMCQUEUE_CACHE_LINE 64
+#endif /* CMC_MPMCQUEUE_CACHE_LINE */
+
+/* How many times the blocking functions try again before sleeping */
+#ifndef CMC_MPMCQUEUE_SPIN
+#define CMC_MPMCQUEUE_SPIN 256
+#endif /* CMC_MPMCQUEUE_SPIN */
+
+#define CMC_GENERATE_MPMCQUEUE(PFX, SNAME, V)    \
+    CMC_GENERATE_MPMCQUEUE_HEADER(PFX, SNAME, V) \
+    CMC_GENERATE_MPMCQUEUE_SOURCE(PFX, SNAME, V)
+
+#define CMC_WRAPGEN_MPMCQUEUE_HEADER(PFX, SNAME, K, V) \
+    CMC_GENERATE_MPMCQUEUE_HEADER(PFX, SNAME, V)
+
+#define CMC_WRAPGEN_MPMCQUEUE_SOURCE(PFX, SNAME, K, V) \
+    CMC_GENERATE_MPMCQUEUE_SOURCE(PFX, SNAME, V)
+
+/* -------------------------------------------------------------------------
+ * Header
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_MPMCQUEUE_HEADER(PFX, SNAME, V)                          \
+                                                                              \
+    /* MPMCQueue Structure */                                                 \
+    struct SNAME                                                              \
+    {                                                                         \
+        /* The structure is not aligned to a cache line when it comes from */ \
+        /* malloc, so a whole line of padding separates each part of it */    \
+        char pad_0[CMC_MPMCQUEUE_CACHE_LINE];                                 \
+                                                                              \
+        /* Next position to be claimed by a producer */                       \
+        _Atomic size_t enqueue_pos;                                           \
+                                                                              \
+        char pad_1[CMC_MPMCQUEUE_CACHE_LINE];                                 \
+                                                                              \
+        /* Next position to be claimed by a consumer */                       \
+        _Atomic size_t dequeue_pos;                                           \
+                                                                              \
+        char pad_2[CMC_MPMCQUEUE_CACHE_LINE];                                 \
+                                                                              \
+        /* Circular array of cells */                                         \
+        struct SNAME##_cell *buffer;                                          \
+                                                                              \
+        /* Capacity of the buffer, which is a power of two */                 \
+        size_t capacity;                                                      \
+                                                                              \
+        /* Amount of producers sleeping until the queue is not full */        \
+        _Atomic size_t sleeping_producers;                                    \
+                                                                              \
+        /* Amount of consumers sleeping until the queue is not empty */       \
+        _Atomic size_t sleeping_consumers;                                    \
+                                                                              \
+        /* Held by the sleeping threads and by the threads waking them */     \
+        struct cmc_mutex mutex;                                               \
+                                                                              \
+        /* Signaled when an element is dequeued */                            \
+        struct cmc_condvar not_full;                                          \
+                                                                              \
+        /* Signaled when an element is enqueued */                            \
+        struct cmc_condvar not_empty;                                         \
+                                                                              \
+        /* Flags indicating errors or success */                              \
+        int flag;                                                             \
+                                                                              \
+        /* Value function table */                                            \
+        struct SNAME##_fval *f_val;                                           \
+                                                                              \
+        /* Custom allocation functions */                                     \
+        struct cmc_alloc_node *alloc;                                         \
+                                                                              \
+        /* Custom callback functions */                                       \
+        struct cmc_callbacks *callbacks;                                      \
+    };                                                                        \
+                                                                              \
+    /* MPMCQueue Cell */                                                      \
+    struct SNAME##_cell                                                       \
+    {                                                                         \
+        /* Position in which this cell can be used next */                    \
+        _Atomic size_t sequence;                                              \
+                                                                              \
+        /* Value stored in this cell */                                       \
+        V value;                                                              \
+    };                                                                        \
+                                                                              \
+    /* Value struct function table */                                         \
+    struct SNAME##_fval                                                       \
+    {                                                                         \
+        /* Comparator function */                                             \
+        int (*cmp)(V, V);                                                     \
+                                                                              \
+        /* Copy function */                                                   \
+        V (*cpy)(V);                                                          \
+                                                                              \
+        /* To string function */                                              \
+        bool (*str)(FILE *, V);                                               \
+                                                                              \
+        /* Free from memory function */                                       \
+        void (*free)(V);                                                      \
+                                                                              \
+        /* Hash function */                                                   \
+        size_t (*hash)(V);                                                    \
+                                                                              \
+        /* Priority function */                                               \
+        int (*pri)(V, V);                                                     \
+    };                                                                        \
+                                                                              \
+    /* Collection Functions */                                                \
+    /* Collection Allocation and Deallocation */                              \
+    struct SNAME *PFX##_new(size_t capacity, struct SNAME##_fval *f_val);     \
+    struct SNAME *PFX##_new_custom(                                           \
+        size_t capacity, struct SNAME##_fval *f_val,                          \
+        struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks);       \
+    void PFX##_clear(struct SNAME *_queue_);                                  \
+    void PFX##_free(struct SNAME *_queue_);                                   \
+    /* Customization of Allocation and Callbacks */                           \
+    void PFX##_customize(struct SNAME *_queue_, struct cmc_alloc_node *alloc, \
+                         struct cmc_callbacks *callbacks);                    \
+    /* Non-blocking Input and Output */                                       \
+    bool PFX##_try_enqueue(struct SNAME *_queue_, V value);                   \
+    bool PFX##_try_dequeue(struct SNAME *_queue_, V *out);                    \
+    /* Blocking Input and Output */                                           \
+    bool PFX##_enqueue(struct SNAME *_queue_, V value);                       \
+    bool PFX##_dequeue(struct SNAME *_queue_, V *out);                        \
+    /* Collection State */                                                    \
+    bool PFX##_empty(struct SNAME *_queue_);                                  \
+    bool PFX##_full(struct SNAME *_queue_);                                   \
+    size_t PFX##_count(struct SNAME *_queue_);                                \
+    size_t PFX##_capacity(struct SNAME *_queue_);                             \
+    int PFX##_flag(struct SNAME *_queue_);                                    \
+    /* Collection Utility */                                                  \
+    struct cmc_string PFX##_to_string(struct SNAME *_queue_);                 \
+    bool PFX##_print(struct SNAME *_queue_, FILE *fptr);
+
+/* -------------------------------------------------------------------------
+ * Source
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_MPMCQUEUE_SOURCE(PFX, SNAME, V)                           \
+                                                                               \
+    /* Implementation Detail Functions */                                      \
+    static size_t PFX##_impl_capacity(size_t capacity);                        \
+    static bool PFX##_impl_try_enqueue(struct SNAME *_queue_, V value);        \
+    static bool PFX##_impl_try_dequeue(struct SNAME *_queue_, V *out);         \
+    static void PFX##_impl_wake(struct SNAME *_queue_,                         \
+                                _Atomic size_t *sleeping,                      \
+                                struct cmc_condvar *cond);                     \
+                                                                               \
+    struct SNAME *PFX##_new(size_t capacity, struct SNAME##_fval *f_val)       \
+    {                                                                          \
+        return PFX##_new_custom(capacity, f_val, NULL, NULL);                  \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_new_custom(                                            \
+        size_t capacity, struct SNAME##_fval *f_val,                           \
+        struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks)         \
+    {                                                                          \
+        if (capacity < 1)                                                      \
+            return NULL;                                                       \
+                                                                               \
+        if (!f_val)                                                            \
+            return NULL;                                                       \
+                                                                               \
+        capacity = PFX##_impl_capacity(capacity);                              \
+                                                                               \
+        if (capacity == 0)                                                     \
+            return NULL;                                                       \
+                                                                               \
+        if (!alloc)                                                            \
+            alloc = &cmc_alloc_node_default;                                   \
+                                                                               \
+        struct SNAME *_queue_ = alloc->malloc(sizeof(struct SNAME));           \
+                                                                               \
+        if (!_queue_)                                                          \
+            return NULL;                                                       \
+                                                                               \
+        _queue_->buffer =                                                      \
+            alloc->calloc(capacity, sizeof(struct SNAME##_cell));              \
+                                                                               \
+        if (!_queue_->buffer)                                                  \
+        {                                                                      \
+            alloc->free(_queue_);                                              \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        if (!cmc_mtx_init(&_queue_->mutex))                                    \
+            goto mutex_error;                                                  \
+                                                                               \
+        if (!cmc_cnd_init(&_queue_->not_full))                                 \
+            goto not_full_error;                                               \
+                                                                               \
+        if (!cmc_cnd_init(&_queue_->not_empty))                                \
+            goto not_empty_error;                                              \
+                                                                               \
+        for (size_t i = 0; i < capacity; i++)                                  \
+            atomic_init(&_queue_->buffer[i].sequence, i);                      \
+                                                                               \
+        atomic_init(&_queue_->enqueue_pos, 0);                                 \
+        atomic_init(&_queue_->dequeue_pos, 0);                                 \
+        atomic_init(&_queue_->sleeping_producers, 0);                          \
+        atomic_init(&_queue_->sleeping_consumers, 0);                          \
+                                                                               \
+        _queue_->capacity = capacity;                                          \
+        _queue_->flag = cmc_flags.OK;                                          \
+        _queue_->f_val = f_val;                                                \
+        _queue_->alloc = alloc;                                                \
+        _queue_->callbacks = callbacks;                                        \
+                                                                               \
+        return _queue_;                                                        \
+                                                                               \
+    not_empty_error:                                                           \
+        cmc_cnd_destroy(&_queue_->not_full);                                   \
+    not_full_error:                                                            \
+        cmc_mtx_destroy(&_queue_->mutex);                                      \
+    mutex_error:                                                               \
+        alloc->free(_queue_->buffer);                                          \
+        alloc->free(_queue_);                                                  \
+                                                                               \
+        return NULL;                                                           \
+    }                                                                          \
+                                                                               \
+    void PFX##_clear(struct SNAME *_queue_)                                    \
+    {                                                                          \
+        size_t front =                                                         \
+            atomic_load_explicit(&_queue_->dequeue_pos, memory_order_relaxed); \
+        size_t back =                                                          \
+            atomic_load_explicit(&_queue_->enqueue_pos, memory_order_relaxed); \
+                                                                               \
+        if (_queue_->f_val->free)                                              \
+        {                                                                      \
+            for (size_t i = front; i != back; i++)                             \
+                _queue_->f_val->free(                                          \
+                    _queue_->buffer[i & (_queue_->capacity - 1)].value);       \
+        }                                                                      \
+                                                                               \
+        for (size_t i = 0; i < _queue_->capacity; i++)                         \
+        {                                                                      \
+            atomic_store_explicit(&_queue_->buffer[i].sequence, i,             \
+                                  memory_order_relaxed);                       \
+            memset(&_queue_->buffer[i].value, 0, sizeof(V));                   \
+        }                                                                      \
+                                                                               \
+        atomic_store_explicit(&_queue_->enqueue_pos, 0, memory_order_relaxed); \
+        atomic_store_explicit(&_queue_->dequeue_pos, 0, memory_order_relaxed); \
+                                                                               \
+        _queue_->flag = cmc_flags.OK;                                          \
+    }                                                                          \
+                                                                               \
+    void PFX##_free(struct SNAME *_queue_)                                     \
+    {                                                                          \
+        size_t front =                                                         \
+            atomic_load_explicit(&_queue_->dequeue_pos, memory_order_relaxed); \
+        size_t back =                                                          \
+            atomic_load_explicit(&_queue_->enqueue_pos, memory_order_relaxed); \
+                                                                               \
+        if (_queue_->f_val->free)                                              \
+        {                                                                      \
+            for (size_t i = front; i != back; i++)                             \
+                _queue_->f_val->free(                                          \
+                    _queue_->buffer[i & (_queue_->capacity - 1)].value);       \
+        }                                                                      \
+                                                                               \
+        cmc_cnd_destroy(&_queue_->not_empty);                                  \
+        cmc_cnd_destroy(&_queue_->not_full);                                   \
+        cmc_mtx_destroy(&_queue_->mutex);                                      \
+                                                                               \
+        _queue_->alloc->free(_queue_->buffer);                                 \
+        _queue_->alloc->free(_queue_);                                         \
+    }                                                                          \
+                                                                               \
+    void PFX##_customize(struct SNAME *_queue_, struct cmc_alloc_node *alloc,  \
+                         struct cmc_callbacks *callbacks)                      \
+    {                                                                          \
+        if (!alloc)                                                            \
+            _queue_->alloc = &cmc_alloc_node_default;                          \
+        else                                                                   \
+            _queue_->alloc = alloc;                                            \
+                                                                               \
+        _queue_->callbacks = callbacks;                                        \
+                                                                               \
+        _queue_->flag = cmc_flags.OK;                                          \
+    }                                                                          \
+                                                                               \
+    bool PFX##_try_enqueue(struct SNAME *_queue_, V value)                     \
+    {                                                                          \
+        if (!PFX##_impl_try_enqueue(_queue_, value))                           \
+            return false;                                                      \
+                                                                               \
+        PFX##_impl_wake(_queue_, &_queue_->sleeping_consumers,                 \
+                        &_queue_->not_empty);                                  \
+                                                                               \
+        if (_queue_->callbacks && _queue_->callbacks->create)                  \
+            _queue_->callbacks->create();                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_try_dequeue(struct SNAME *_queue_, V *out)                      \
+    {                                                                          \
+        if (!PFX##_impl_try_dequeue(_queue_, out))                             \
+            return false;                                                      \
+                                                                               \
+        PFX##_impl_wake(_queue_, &_queue_->sleeping_producers,                 \
+                        &_queue_->not_full);                                   \
+                                                                               \
+        if (_queue_->callbacks && _queue_->callbacks->delete)                  \
+            _queue_->callbacks->delete ();                                     \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_enqueue(struct SNAME *_queue_, V value)                         \
+    {                                                                          \
+        for (size_t i = 0; i < CMC_MPMCQUEUE_SPIN; i++)                        \
+        {                                                                      \
+            if (PFX##_try_enqueue(_queue_, value))                             \
+                return true;                                                   \
+        }                                                                      \
+                                                                               \
+        if (!cmc_mtx_lock(&_queue_->mutex))                                    \
+            return false;                                                      \
+                                                                               \
+        /* The counter goes up before trying again so that a consumer that */  \
+        /* frees a cell either is seen by the try or sees the counter */       \
+        atomic_fetch_add(&_queue_->sleeping_producers, 1);                     \
+        atomic_thread_fence(memory_order_seq_cst);                             \
+                                                                               \
+        bool result = true;                                                    \
+                                                                               \
+        /* The mutex is still locked, so a consumer can only be woken after */ \
+        /* it is unlocked */                                                   \
+        while (!PFX##_impl_try_enqueue(_queue_, value))                        \
+        {                                                                      \
+            if (!cmc_cnd_wait(&_queue_->not_full, &_queue_->mutex))            \
+            {                                                                  \
+                result = false;                                                \
+                break;                                                         \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        atomic_fetch_sub(&_queue_->sleeping_producers, 1);                     \
+                                                                               \
+        cmc_mtx_unlock(&_queue_->mutex);                                       \
+                                                                               \
+        if (!result)                                                           \
+            return false;                                                      \
+                                                                               \
+        PFX##_impl_wake(_queue_, &_queue_->sleeping_consumers,                 \
+                        &_queue_->not_empty);                                  \
+                                                                               \
+        if (_queue_->callbacks && _queue_->callbacks->create)                  \
+            _queue_->callbacks->create();                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_dequeue(struct SNAME *_queue_, V *out)                          \
+    {                                                                          \
+        for (size_t i = 0; i < CMC_MPMCQUEUE_SPIN; i++)                        \
+        {                                                                      \
+            if (PFX##_try_dequeue(_queue_, out))                               \
+                return true;                                                   \
+        }                                                                      \
+                                                                               \
+        if (!cmc_mtx_lock(&_queue_->mutex))                                    \
+            return false;                                                      \
+                                                                               \
+        atomic_fetch_add(&_queue_->sleeping_consumers, 1);                     \
+        atomic_thread_fence(memory_order_seq_cst);                             \
+                                                                               \
+        bool result = true;                                                    \
+                                                                               \
+        while (!PFX##_impl_try_dequeue(_queue_, out))                          \
+        {                                                                      \
+            if (!cmc_cnd_wait(&_queue_->not_empty, &_queue_->mutex))           \
+            {                                                                  \
+                result = false;                                                \
+                break;                                                         \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        atomic_fetch_sub(&_queue_->sleeping_consumers, 1);                     \
+                                                                               \
+        cmc_mtx_unlock(&_queue_->mutex);                                       \
+                                                                               \
+        if (!result)                                                           \
+            return false;                                                      \
+                                                                               \
+        PFX##_impl_wake(_queue_, &_queue_->sleeping_producers,                 \
+                        &_queue_->not_full);                                   \
+                                                                               \
+        if (_queue_->callbacks && _queue_->callbacks->delete)                  \
+            _queue_->callbacks->delete ();                                     \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_empty(struct SNAME *_queue_)                                    \
+    {                                                                          \
+        return PFX##_count(_queue_) == 0;                                      \
+    }                                                                          \
+                                                                               \
+    bool PFX##_full(struct SNAME *_queue_)                                     \
+    {                                                                          \
+        return PFX##_count(_queue_) >= _queue_->capacity;                      \
+    }                                                                          \
+                                                                               \
+    /* Other threads can change the queue right after, so the result is */     \
+    /* only a snapshot that counts claimed positions */                        \
+    size_t PFX##_count(struct SNAME *_queue_)                                  \
+    {                                                                          \
+        size_t front =                                                         \
+            atomic_load_explicit(&_queue_->dequeue_pos, memory_order_acquire); \
+        size_t back =                                                          \
+            atomic_load_explicit(&_queue_->enqueue_pos, memory_order_acquire); \
+                                                                               \
+        /* Elements can be dequeued and enqueued between both loads */         \
+        return back - front > _queue_->capacity ? _queue_->capacity            \
+                                                : back - front;                \
+    }                                                                          \
+                                                                               \
+    size_t PFX##_capacity(struct SNAME *_queue_)                               \
+    {                                                                          \
+        return _queue_->capacity;                                              \
+    }                                                                          \
+                                                                               \
+    int PFX##_flag(struct SNAME *_queue_)                                      \
+    {                                                                          \
+        return _queue_->flag;                                                  \
+    }                                                                          \
+                                                                               \
+    struct cmc_string PFX##_to_string(struct SNAME *_queue_)                   \
+    {                                                                          \
+        struct cmc_string str;                                                 \
+        struct SNAME *q_ = _queue_;                                            \
+                                                                               \
+        int n = snprintf(                                                      \
+            str.s, cmc_string_len, cmc_string_fmt_mpmcqueue, #SNAME, #V, q_,   \
+            q_->buffer, q_->capacity,                                          \
+            atomic_load_explicit(&q_->enqueue_pos, memory_order_relaxed),      \
+            atomic_load_explicit(&q_->dequeue_pos, memory_order_relaxed),      \
+            q_->flag, q_->f_val, q_->alloc, q_->callbacks);                    \
+                                                                               \
+        return n >= 0 ? str : (struct cmc_string){ 0 };                        \
+    }                                                                          \
+                                                                               \
+    bool PFX##_print(struct SNAME *_queue_, FILE *fptr)                        \
+    {                                                                          \
+        size_t front =                                                         \
+            atomic_load_explicit(&_queue_->dequeue_pos, memory_order_relaxed); \
+        size_t back =                                                          \
+            atomic_load_explicit(&_queue_->enqueue_pos, memory_order_relaxed); \
+                                                                               \
+        for (size_t i = front; i != back; i++)                                 \
+        {                                                                      \
+            if (!_queue_->f_val->str(                                          \
+                    fptr, _queue_->buffer[i & (_queue_->capacity - 1)].value)) \
+                return false;                                                  \
+        }                                                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Rounds the capacity up to a power of two that is at least 2, or */      \
+    /* returns 0 if it can't */                                                \
+    static size_t PFX##_impl_capacity(size_t capacity)                         \
+    {                                                                          \
+        size_t result = 2;                                                     \
+                                                                               \
+        while (result < capacity)                                              \
+        {                                                                      \
+            if (result > SIZE_MAX / 2)                                         \
+                return 0;                                                      \
+                                                                               \
+            result *= 2;                                                       \
+        }                                                                      \
+                                                                               \
+        return result;                                                         \
+    }                                                                          \
+                                                                               \
+    /* Claims a position for a producer and writes the value to its cell */    \
+    static bool PFX##_impl_try_enqueue(struct SNAME *_queue_, V value)         \
+    {                                                                          \
+        struct SNAME##_cell *cell;                                             \
+        size_t pos =                                                           \
+            atomic_load_explicit(&_queue_->enqueue_pos, memory_order_relaxed); \
+                                                                               \
+        for (;;)                                                               \
+        {                                                                      \
+            cell = &_queue_->buffer[pos & (_queue_->capacity - 1)];            \
+                                                                               \
+            size_t seq =                                                       \
+                atomic_load_explicit(&cell->sequence, memory_order_acquire);   \
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;                     \
+                                                                               \
+            if (diff == 0)                                                     \
+            {                                                                  \
+                /* On failure pos is updated to the current enqueue_pos */     \
+                if (atomic_compare_exchange_weak_explicit(                     \
+                        &_queue_->enqueue_pos, &pos, pos + 1,                  \
+                        memory_order_relaxed, memory_order_relaxed))           \
+                    break;                                                     \
+            }                                                                  \
+            /* The cell has not been read since the last lap */                \
+            else if (diff < 0)                                                 \
+                return false;                                                  \
+            /* Another producer claimed this position */                       \
+            else                                                               \
+                pos = atomic_load_explicit(&_queue_->enqueue_pos,              \
+                                           memory_order_relaxed);              \
+        }                                                                      \
+                                                                               \
+        cell->value = value;                                                   \
+                                                                               \
+        atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release); \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Claims a position for a consumer and reads the value from its cell */   \
+    static bool PFX##_impl_try_dequeue(struct SNAME *_queue_, V *out)          \
+    {                                                                          \
+        struct SNAME##_cell *cell;                                             \
+        size_t pos =                                                           \
+            atomic_load_explicit(&_queue_->dequeue_pos, memory_order_relaxed); \
+                                                                               \
+        for (;;)                                                               \
+        {                                                                      \
+            cell = &_queue_->buffer[pos & (_queue_->capacity - 1)];            \
+                                                                               \
+            size_t seq =                                                       \
+                atomic_load_explicit(&cell->sequence, memory_order_acquire);   \
+            intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);               \
+                                                                               \
+            if (diff == 0)                                                     \
+            {                                                                  \
+                if (atomic_compare_exchange_weak_explicit(                     \
+                        &_queue_->dequeue_pos, &pos, pos + 1,                  \
+                        memory_order_relaxed, memory_order_relaxed))           \
+                    break;                                                     \
+            }                                                                  \
+            /* The cell has not been written in this lap */                    \
+            else if (diff < 0)                                                 \
+                return false;                                                  \
+            /* Another consumer claimed this position */                       \
+            else                                                               \
+                pos = atomic_load_explicit(&_queue_->dequeue_pos,              \
+                                           memory_order_relaxed);              \
+        }                                                                      \
+                                                                               \
+        if (out)                                                               \
+            *out = cell->value;                                                \
+                                                                               \
+        atomic_store_explicit(&cell->sequence, pos + _queue_->capacity,        \
+                              memory_order_release);                           \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Wakes up a thread sleeping on cond if there is one. The fence pairs */  \
+    /* with the one in enqueue and dequeue, after the sleeping counter is */   \
+    /* incremented, so that a thread can't go to sleep without seeing the */   \
+    /* cell that was just written or read */                                   \
+    static void PFX##_impl_wake(struct SNAME *_queue_,                         \
+                                _Atomic size_t *sleeping,                      \
+                                struct cmc_condvar *cond)                      \
+    {                                                                          \
+        atomic_thread_fence(memory_order_seq_cst);                             \
+                                                                               \
+        if (atomic_load_explicit(sleeping, memory_order_relaxed) == 0)         \
+            return;                                                            \
+                                                                               \
+        cmc_mtx_lock(&_queue_->mutex);                                         \
+        cmc_cnd_signal(cond);                                                  \
+        cmc_mtx_unlock(&_queue_->mutex);                                       \
+    }
+
+#endif /* CMC_MPMCQUEUE_H */
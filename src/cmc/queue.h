@@ -47,6 +47,7 @@
  * Core functionalities of the C Macro Collections Library
  * ------------------------------------------------------------------------- */
 #include "../cor/core.h"
+#include "../cor/search.h"
 
 /* -------------------------------------------------------------------------
  * Queue specific
@@ -68,6 +69,12 @@ static const char *cmc_string_fmt_queue = "struct %s<%s> "
     CMC_GENERATE_QUEUE_HEADER(PFX, SNAME, V) \
     CMC_GENERATE_QUEUE_SOURCE(PFX, SNAME, V)
 
+/* Generates a Queue of plain old data, which is searched by comparing the */
+/* bytes of the elements instead of calling the comparator (see cor/search.h) */
+#define CMC_GENERATE_QUEUE_POD(PFX, SNAME, V) \
+    CMC_GENERATE_QUEUE_HEADER(PFX, SNAME, V)  \
+    CMC_GENERATE_QUEUE_SOURCE_POD(PFX, SNAME, V)
+
 #define CMC_WRAPGEN_QUEUE_HEADER(PFX, SNAME, K, V) \
     CMC_GENERATE_QUEUE_HEADER(PFX, SNAME, V)
 
@@ -108,6 +115,9 @@ static const char *cmc_string_fmt_queue = "struct %s<%s> "
                                                                               \
         /* Custom callback functions */                                       \
         struct cmc_callbacks *callbacks;                                      \
+                                                                              \
+        /* Growth policy of the buffer */                                     \
+        const struct cmc_growth *growth;                                      \
     };                                                                        \
                                                                               \
     /* Value struct function table */                                         \
@@ -162,9 +172,13 @@ static const char *cmc_string_fmt_queue = "struct %s<%s> "
     /* Customization of Allocation and Callbacks */                           \
     void PFX##_customize(struct SNAME *_queue_, struct cmc_alloc_node *alloc, \
                          struct cmc_callbacks *callbacks);                    \
+    void PFX##_set_growth(struct SNAME *_queue_,                              \
+                          const struct cmc_growth *growth);                   \
     /* Collection Input and Output */                                         \
     bool PFX##_enqueue(struct SNAME *_queue_, V value);                       \
     bool PFX##_dequeue(struct SNAME *_queue_);                                \
+    bool PFX##_enqueue_n(struct SNAME *_queue_, V *values, size_t n);         \
+    size_t PFX##_dequeue_n(struct SNAME *_queue_, V *out, size_t n);          \
     /* Element Access */                                                      \
     V PFX##_peek(struct SNAME *_queue_);                                      \
     /* Collection State */                                                    \
@@ -176,6 +190,8 @@ static const char *cmc_string_fmt_queue = "struct %s<%s> "
     int PFX##_flag(struct SNAME *_queue_);                                    \
     /* Collection Utility */                                                  \
     bool PFX##_resize(struct SNAME *_queue_, size_t capacity);                \
+    bool PFX##_reserve(struct SNAME *_queue_, size_t size);                   \
+    bool PFX##_shrink_to_fit(struct SNAME *_queue_);                          \
     struct SNAME *PFX##_copy_of(struct SNAME *_queue_);                       \
     bool PFX##_equals(struct SNAME *_queue1_, struct SNAME *_queue2_);        \
     struct cmc_string PFX##_to_string(struct SNAME *_queue_);                 \
@@ -204,7 +220,15 @@ static const char *cmc_string_fmt_queue = "struct %s<%s> "
 /* -------------------------------------------------------------------------
  * Source
  * ------------------------------------------------------------------------- */
-#define CMC_GENERATE_QUEUE_SOURCE(PFX, SNAME, V)                               \
+#define CMC_GENERATE_QUEUE_SOURCE(PFX, SNAME, V) \
+    CMC_GENERATE_SEARCH(PFX, V)                  \
+    CMC_GENERATE_QUEUE_CORE_SOURCE(PFX, SNAME, V)
+
+#define CMC_GENERATE_QUEUE_SOURCE_POD(PFX, SNAME, V) \
+    CMC_GENERATE_SEARCH_POD(PFX, V)                  \
+    CMC_GENERATE_QUEUE_CORE_SOURCE(PFX, SNAME, V)
+
+#define CMC_GENERATE_QUEUE_CORE_SOURCE(PFX, SNAME, V)                          \
                                                                                \
     /* Implementation Detail Functions */                                      \
     /* None */                                                                 \
@@ -240,6 +264,7 @@ static const char *cmc_string_fmt_queue = "struct %s<%s> "
         _queue_->f_val = f_val;                                                \
         _queue_->alloc = alloc;                                                \
         _queue_->callbacks = NULL;                                             \
+        _queue_->growth = NULL;                                                \
                                                                                \
         return _queue_;                                                        \
     }                                                                          \
@@ -278,6 +303,7 @@ static const char *cmc_string_fmt_queue = "struct %s<%s> "
         _queue_->f_val = f_val;                                                \
         _queue_->alloc = alloc;                                                \
         _queue_->callbacks = callbacks;                                        \
+        _queue_->growth = NULL;                                                \
                                                                                \
         return _queue_;                                                        \
     }                                                                          \
@@ -331,11 +357,21 @@ static const char *cmc_string_fmt_queue = "struct %s<%s> "
         _queue_->flag = cmc_flags.OK;                                          \
     }                                                                          \
                                                                                \
+    /* Sets the growth policy used when the buffer is full (NULL for the */    \
+    /* default one) */                                                         \
+    void PFX##_set_growth(struct SNAME *_queue_,                               \
+                          const struct cmc_growth *growth)                     \
+    {                                                                          \
+        _queue_->growth = growth;                                              \
+                                                                               \
+        _queue_->flag = cmc_flags.OK;                                          \
+    }                                                                          \
+                                                                               \
     bool PFX##_enqueue(struct SNAME *_queue_, V value)                         \
     {                                                                          \
         if (PFX##_full(_queue_))                                               \
         {                                                                      \
-            if (!PFX##_resize(_queue_, _queue_->capacity * 2))                 \
+            if (!PFX##_reserve(_queue_, 1))                                    \
                 return false;                                                  \
         }                                                                      \
                                                                                \
@@ -374,6 +410,76 @@ static const char *cmc_string_fmt_queue = "struct %s<%s> "
         return true;                                                           \
     }                                                                          \
                                                                                \
+    /* Enqueues n values, copying them in at most two parts split where the */ \
+    /* buffer wraps around */                                                  \
+    bool PFX##_enqueue_n(struct SNAME *_queue_, V *values, size_t n)           \
+    {                                                                          \
+        if (n == 0)                                                            \
+        {                                                                      \
+            _queue_->flag = cmc_flags.OK;                                      \
+            return true;                                                       \
+        }                                                                      \
+                                                                               \
+        if (!PFX##_reserve(_queue_, n))                                        \
+            return false;                                                      \
+                                                                               \
+        size_t count1 = _queue_->capacity - _queue_->back;                     \
+                                                                               \
+        if (count1 > n)                                                        \
+            count1 = n;                                                        \
+                                                                               \
+        memcpy(_queue_->buffer + _queue_->back, values, sizeof(V) * count1);   \
+        memcpy(_queue_->buffer, values + count1, sizeof(V) * (n - count1));    \
+                                                                               \
+        _queue_->back = (_queue_->back + n) % _queue_->capacity;               \
+                                                                               \
+        _queue_->count += n;                                                   \
+        _queue_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        if (_queue_->callbacks && _queue_->callbacks->create)                  \
+            _queue_->callbacks->create();                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Dequeues up to n values, copying them to out if it is not NULL, and */  \
+    /* returns how many were dequeued */                                       \
+    size_t PFX##_dequeue_n(struct SNAME *_queue_, V *out, size_t n)            \
+    {                                                                          \
+        if (PFX##_empty(_queue_))                                              \
+        {                                                                      \
+            _queue_->flag = cmc_flags.EMPTY;                                   \
+            return 0;                                                          \
+        }                                                                      \
+                                                                               \
+        if (n > _queue_->count)                                                \
+            n = _queue_->count;                                                \
+                                                                               \
+        size_t count1 = _queue_->capacity - _queue_->front;                    \
+                                                                               \
+        if (count1 > n)                                                        \
+            count1 = n;                                                        \
+                                                                               \
+        if (out)                                                               \
+        {                                                                      \
+            memcpy(out, _queue_->buffer + _queue_->front, sizeof(V) * count1); \
+            memcpy(out + count1, _queue_->buffer, sizeof(V) * (n - count1));   \
+        }                                                                      \
+                                                                               \
+        memset(_queue_->buffer + _queue_->front, 0, sizeof(V) * count1);       \
+        memset(_queue_->buffer, 0, sizeof(V) * (n - count1));                  \
+                                                                               \
+        _queue_->front = (_queue_->front + n) % _queue_->capacity;             \
+                                                                               \
+        _queue_->count -= n;                                                   \
+        _queue_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        if (_queue_->callbacks && _queue_->callbacks->delete)                  \
+            _queue_->callbacks->delete ();                                     \
+                                                                               \
+        return n;                                                              \
+    }                                                                          \
+                                                                               \
     V PFX##_peek(struct SNAME *_queue_)                                        \
     {                                                                          \
         if (PFX##_empty(_queue_))                                              \
@@ -394,18 +500,20 @@ static const char *cmc_string_fmt_queue = "struct %s<%s> "
     {                                                                          \
         _queue_->flag = cmc_flags.OK;                                          \
                                                                                \
-        bool result = false;                                                   \
+        /* The elements might wrap around the end of the buffer */             \
+        size_t count1 = _queue_->capacity - _queue_->front;                    \
+        size_t count2 = 0;                                                     \
                                                                                \
-        for (size_t i = _queue_->front, j = 0; j < _queue_->count; j++)        \
-        {                                                                      \
-            if (_queue_->f_val->cmp(_queue_->buffer[i], value) == 0)           \
-            {                                                                  \
-                result = true;                                                 \
-                break;                                                         \
-            }                                                                  \
+        if (count1 >= _queue_->count)                                          \
+            count1 = _queue_->count;                                           \
+        else                                                                   \
+            count2 = _queue_->count - count1;                                  \
                                                                                \
-            i = (i + 1) % _queue_->capacity;                                   \
-        }                                                                      \
+        bool result =                                                          \
+            PFX##_impl_search(_queue_->buffer + _queue_->front, count1, value, \
+                              _queue_->f_val->cmp) < count1 ||                 \
+            PFX##_impl_search(_queue_->buffer, count2, value,                  \
+                              _queue_->f_val->cmp) < count2;                   \
                                                                                \
         if (_queue_->callbacks && _queue_->callbacks->read)                    \
             _queue_->callbacks->read();                                        \
@@ -449,27 +557,68 @@ static const char *cmc_string_fmt_queue = "struct %s<%s> "
             return false;                                                      \
         }                                                                      \
                                                                                \
-        V *new_buffer = _queue_->alloc->malloc(sizeof(V) * capacity);          \
-                                                                               \
-        if (!new_buffer)                                                       \
+        if (capacity > _queue_->capacity)                                      \
         {                                                                      \
-            _queue_->flag = cmc_flags.ALLOC;                                   \
-            return false;                                                      \
-        }                                                                      \
+            /* Growing with realloc lets the allocator extend the buffer in */ \
+            /* place, or remap it when it is huge, instead of copying it */    \
+            V *new_buffer = _queue_->alloc->realloc(_queue_->buffer,           \
+                                                    sizeof(V) * capacity);     \
                                                                                \
-        for (size_t i = _queue_->front, j = 0; j < _queue_->count; j++)        \
-        {                                                                      \
-            new_buffer[j] = _queue_->buffer[i];                                \
+            if (!new_buffer)                                                   \
+            {                                                                  \
+                _queue_->flag = cmc_flags.ALLOC;                               \
+                return false;                                                  \
+            }                                                                  \
                                                                                \
-            i = (i + 1) % _queue_->capacity;                                   \
+            size_t old_capacity = _queue_->capacity;                           \
+                                                                               \
+            /* If the elements wrap around the end of the old buffer, the */   \
+            /* smaller of the two parts is moved to make them contiguous */    \
+            if (_queue_->front + _queue_->count > old_capacity)                \
+            {                                                                  \
+                size_t tail = old_capacity - _queue_->front;                   \
+                size_t head = _queue_->count - tail;                           \
+                                                                               \
+                if (head < tail && head <= capacity - old_capacity)            \
+                    memcpy(new_buffer + old_capacity, new_buffer,              \
+                           sizeof(V) * head);                                  \
+                else                                                           \
+                {                                                              \
+                    memmove(new_buffer + capacity - tail,                      \
+                            new_buffer + _queue_->front, sizeof(V) * tail);    \
+                                                                               \
+                    _queue_->front = capacity - tail;                          \
+                }                                                              \
+            }                                                                  \
+                                                                               \
+            _queue_->buffer = new_buffer;                                      \
+            _queue_->capacity = capacity;                                      \
+            _queue_->back = (_queue_->front + _queue_->count) % capacity;      \
         }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            V *new_buffer = _queue_->alloc->malloc(sizeof(V) * capacity);      \
                                                                                \
-        _queue_->alloc->free(_queue_->buffer);                                 \
+            if (!new_buffer)                                                   \
+            {                                                                  \
+                _queue_->flag = cmc_flags.ALLOC;                               \
+                return false;                                                  \
+            }                                                                  \
                                                                                \
-        _queue_->buffer = new_buffer;                                          \
-        _queue_->capacity = capacity;                                          \
-        _queue_->front = 0;                                                    \
-        _queue_->back = _queue_->count;                                        \
+            for (size_t i = _queue_->front, j = 0; j < _queue_->count; j++)    \
+            {                                                                  \
+                new_buffer[j] = _queue_->buffer[i];                            \
+                                                                               \
+                i = (i + 1) % _queue_->capacity;                               \
+            }                                                                  \
+                                                                               \
+            _queue_->alloc->free(_queue_->buffer);                             \
+                                                                               \
+            _queue_->buffer = new_buffer;                                      \
+            _queue_->capacity = capacity;                                      \
+            _queue_->front = 0;                                                \
+            _queue_->back = _queue_->count % capacity;                         \
+        }                                                                      \
                                                                                \
     success:                                                                   \
                                                                                \
@@ -481,6 +630,32 @@ static const char *cmc_string_fmt_queue = "struct %s<%s> "
         return true;                                                           \
     }                                                                          \
                                                                                \
+    /* Makes room for at least size more elements, growing the buffer */       \
+    /* according to the growth policy */                                       \
+    bool PFX##_reserve(struct SNAME *_queue_, size_t size)                     \
+    {                                                                          \
+        _queue_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        if (size <= _queue_->capacity - _queue_->count)                        \
+            return true;                                                       \
+                                                                               \
+        if (size > SIZE_MAX - _queue_->count)                                  \
+        {                                                                      \
+            _queue_->flag = cmc_flags.ERROR;                                   \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        return PFX##_resize(                                                   \
+            _queue_, cmc_growth_capacity(_queue_->growth, _queue_->capacity,   \
+                                         _queue_->count + size));              \
+    }                                                                          \
+                                                                               \
+    /* Reduces the capacity to the amount of elements */                       \
+    bool PFX##_shrink_to_fit(struct SNAME *_queue_)                            \
+    {                                                                          \
+        return PFX##_resize(_queue_, _queue_->count > 0 ? _queue_->count : 1); \
+    }                                                                          \
+                                                                               \
     struct SNAME *PFX##_copy_of(struct SNAME *_queue_)                         \
     {                                                                          \
         struct SNAME *result =                                                 \
@@ -513,6 +688,7 @@ static const char *cmc_string_fmt_queue = "struct %s<%s> "
         }                                                                      \
                                                                                \
         result->count = _queue_->count;                                        \
+        result->growth = _queue_->growth;                                      \
         result->front = 0;                                                     \
         result->back = _queue_->count;                                         \
                                                                                \
@@ -0,0 +1,516 @@
+/**
+ * radixheap.h
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * RadixHeap
+ *
+ * A monotone priority queue of unsigned integer keys, each with a value. The
+ * key popped is always the smallest one and a key can't be smaller than the
+ * last key popped, which is the case of event simulations and of Dijkstra's
+ * algorithm with integer weights. Keys are never compared with a function.
+ *
+ * Entries are kept in buckets by the highest bit in which their key differs
+ * from the last key popped: bucket 0 holds the keys equal to it and bucket i
+ * the ones where bit i - 1 is the highest one that differs. Pushing an entry
+ * only appends it to its bucket. When bucket 0 is empty, the lowest bucket
+ * with entries is emptied: its smallest key becomes the last key popped and
+ * each entry goes to a lower bucket. An entry only moves down, so pop_min
+ * takes amortized O(log C), where C is the largest key.
+ *
+ * K must be an unsigned integer type. Entries with the same key are popped in
+ * any order.
+ */
+
+#ifndef CMC_RADIXHEAP_H
+#define CMC_RADIXHEAP_H
+
+/* -------------------------------------------------------------------------
+ * Core functionalities of the C Macro Collections Library
+ * ------------------------------------------------------------------------- */
+#include "../cor/core.h"
+
+/* -------------------------------------------------------------------------
+ * RadixHeap specific
+ * ------------------------------------------------------------------------- */
+/* to_string format */
+static const char *cmc_string_fmt_radixheap = "struct %s<%s, %s> "
+                                              "at %p { "
+                                              "last:%" PRIuMAX ", "
+                                              "count:%" PRIuMAX ", "
+                                              "flag:%d, "
+                                              "f_val:%p, "
+                                              "alloc:%p, "
+                                              "callbacks:%p }";
+
+/* Initial capacity of a bucket */
+#ifndef CMC_RADIXHEAP_BUCKET_SIZE
+#define CMC_RADIXHEAP_BUCKET_SIZE 16
+#endif /* CMC_RADIXHEAP_BUCKET_SIZE */
+
+/* Amount of bits needed to represent x, which is zero only for zero */
+static inline size_t cmc_radixheap_bit_length(uintmax_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return x == 0 ? 0
+                  : sizeof(unsigned long long) * CHAR_BIT -
+                        (size_t)__builtin_clzll((unsigned long long)x);
+#else
+    size_t result = 0;
+
+    while (x != 0)
+    {
+        x >>= 1;
+        result++;
+    }
+
+    return result;
+#endif
+}
+
+#define CMC_GENERATE_RADIXHEAP(PFX, SNAME, K, V)    \
+    CMC_GENERATE_RADIXHEAP_HEADER(PFX, SNAME, K, V) \
+    CMC_GENERATE_RADIXHEAP_SOURCE(PFX, SNAME, K, V)
+
+#define CMC_WRAPGEN_RADIXHEAP_HEADER(PFX, SNAME, K, V) \
+    CMC_GENERATE_RADIXHEAP_HEADER(PFX, SNAME, K, V)
+
+#define CMC_WRAPGEN_RADIXHEAP_SOURCE(PFX, SNAME, K, V) \
+    CMC_GENERATE_RADIXHEAP_SOURCE(PFX, SNAME, K, V)
+
+/* -------------------------------------------------------------------------
+ * Header
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_RADIXHEAP_HEADER(PFX, SNAME, K, V)                      \
+                                                                             \
+    /* RadixHeap Entry */                                                    \
+    struct SNAME##_entry                                                     \
+    {                                                                        \
+        /* Entry's key */                                                    \
+        K key;                                                               \
+                                                                             \
+        /* Entry's value */                                                  \
+        V value;                                                             \
+    };                                                                       \
+                                                                             \
+    /* RadixHeap Bucket */                                                   \
+    struct SNAME##_bucket                                                    \
+    {                                                                        \
+        /* Dynamic array of entries in no particular order */                \
+        struct SNAME##_entry *buffer;                                        \
+                                                                             \
+        /* Current array capacity */                                         \
+        size_t capacity;                                                     \
+                                                                             \
+        /* Current amount of entries in the bucket */                        \
+        size_t count;                                                        \
+    };                                                                       \
+                                                                             \
+    /* RadixHeap Structure */                                                \
+    struct SNAME                                                             \
+    {                                                                        \
+        /* One bucket for each bit of a key plus one for the last key */     \
+        struct SNAME##_bucket buckets[sizeof(K) * CHAR_BIT + 1];             \
+                                                                             \
+        /* Last key popped, no key smaller than it can be pushed */          \
+        K last;                                                              \
+                                                                             \
+        /* Current amount of entries in the heap */                          \
+        size_t count;                                                        \
+                                                                             \
+        /* Flags indicating errors or success */                             \
+        int flag;                                                            \
+                                                                             \
+        /* Value function table */                                           \
+        struct SNAME##_fval *f_val;                                          \
+                                                                             \
+        /* Custom allocation functions */                                    \
+        struct cmc_alloc_node *alloc;                                        \
+                                                                             \
+        /* Custom callback functions */                                      \
+        struct cmc_callbacks *callbacks;                                     \
+    };                                                                       \
+                                                                             \
+    /* Value struct function table */                                        \
+    struct SNAME##_fval                                                      \
+    {                                                                        \
+        /* Comparator function */                                            \
+        int (*cmp)(V, V);                                                    \
+                                                                             \
+        /* Copy function */                                                  \
+        V (*cpy)(V);                                                         \
+                                                                             \
+        /* To string function */                                             \
+        bool (*str)(FILE *, V);                                              \
+                                                                             \
+        /* Free from memory function */                                      \
+        void (*free)(V);                                                     \
+                                                                             \
+        /* Hash function */                                                  \
+        size_t (*hash)(V);                                                   \
+                                                                             \
+        /* Priority function */                                              \
+        int (*pri)(V, V);                                                    \
+    };                                                                       \
+                                                                             \
+    /* Collection Functions */                                               \
+    /* Collection Allocation and Deallocation */                             \
+    struct SNAME *PFX##_new(struct SNAME##_fval *f_val);                     \
+    struct SNAME *PFX##_new_custom(struct SNAME##_fval *f_val,               \
+                                   struct cmc_alloc_node *alloc,             \
+                                   struct cmc_callbacks *callbacks);         \
+    void PFX##_clear(struct SNAME *_heap_);                                  \
+    void PFX##_free(struct SNAME *_heap_);                                   \
+    /* Customization of Allocation and Callbacks */                          \
+    void PFX##_customize(struct SNAME *_heap_, struct cmc_alloc_node *alloc, \
+                         struct cmc_callbacks *callbacks);                   \
+    /* Collection Input and Output */                                        \
+    bool PFX##_push(struct SNAME *_heap_, K key, V value);                   \
+    bool PFX##_pop_min(struct SNAME *_heap_, K *key, V *value);              \
+    /* Element Access */                                                     \
+    bool PFX##_peek(struct SNAME *_heap_, K *key, V *value);                 \
+    K PFX##_last(struct SNAME *_heap_);                                      \
+    /* Collection State */                                                   \
+    bool PFX##_empty(struct SNAME *_heap_);                                  \
+    size_t PFX##_count(struct SNAME *_heap_);                                \
+    int PFX##_flag(struct SNAME *_heap_);                                    \
+    /* Collection Utility */                                                 \
+    struct cmc_string PFX##_to_string(struct SNAME *_heap_);                 \
+    bool PFX##_print(struct SNAME *_heap_, FILE *fptr);
+
+/* -------------------------------------------------------------------------
+ * Source
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_RADIXHEAP_SOURCE(PFX, SNAME, K, V)                        \
+                                                                               \
+    /* Implementation Detail Functions */                                      \
+    static size_t PFX##_impl_bucket(K key, K last);                            \
+    static bool PFX##_impl_grow(struct SNAME *_heap_,                          \
+                                struct SNAME##_bucket *bucket, size_t size);   \
+    static bool PFX##_impl_refill(struct SNAME *_heap_);                       \
+                                                                               \
+    struct SNAME *PFX##_new(struct SNAME##_fval *f_val)                        \
+    {                                                                          \
+        return PFX##_new_custom(f_val, NULL, NULL);                            \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_new_custom(struct SNAME##_fval *f_val,                 \
+                                   struct cmc_alloc_node *alloc,               \
+                                   struct cmc_callbacks *callbacks)            \
+    {                                                                          \
+        if (!f_val)                                                            \
+            return NULL;                                                       \
+                                                                               \
+        if (!alloc)                                                            \
+            alloc = &cmc_alloc_node_default;                                   \
+                                                                               \
+        struct SNAME *_heap_ = alloc->malloc(sizeof(struct SNAME));            \
+                                                                               \
+        if (!_heap_)                                                           \
+            return NULL;                                                       \
+                                                                               \
+        /* Buckets only get a buffer when an entry goes to them */             \
+        for (size_t i = 0; i < sizeof(K) * CHAR_BIT + 1; i++)                  \
+            _heap_->buckets[i] = (struct SNAME##_bucket){ NULL, 0, 0 };        \
+                                                                               \
+        _heap_->last = 0;                                                      \
+        _heap_->count = 0;                                                     \
+        _heap_->flag = cmc_flags.OK;                                           \
+        _heap_->f_val = f_val;                                                 \
+        _heap_->alloc = alloc;                                                 \
+        _heap_->callbacks = callbacks;                                         \
+                                                                               \
+        return _heap_;                                                         \
+    }                                                                          \
+                                                                               \
+    /* Removes every entry and allows any key to be pushed again */            \
+    void PFX##_clear(struct SNAME *_heap_)                                     \
+    {                                                                          \
+        for (size_t i = 0; i < sizeof(K) * CHAR_BIT + 1; i++)                  \
+        {                                                                      \
+            struct SNAME##_bucket *bucket = &(_heap_->buckets[i]);             \
+                                                                               \
+            if (_heap_->f_val->free)                                           \
+            {                                                                  \
+                for (size_t j = 0; j < bucket->count; j++)                     \
+                    _heap_->f_val->free(bucket->buffer[j].value);              \
+            }                                                                  \
+                                                                               \
+            bucket->count = 0;                                                 \
+        }                                                                      \
+                                                                               \
+        _heap_->last = 0;                                                      \
+        _heap_->count = 0;                                                     \
+        _heap_->flag = cmc_flags.OK;                                           \
+    }                                                                          \
+                                                                               \
+    void PFX##_free(struct SNAME *_heap_)                                      \
+    {                                                                          \
+        for (size_t i = 0; i < sizeof(K) * CHAR_BIT + 1; i++)                  \
+        {                                                                      \
+            struct SNAME##_bucket *bucket = &(_heap_->buckets[i]);             \
+                                                                               \
+            if (_heap_->f_val->free)                                           \
+            {                                                                  \
+                for (size_t j = 0; j < bucket->count; j++)                     \
+                    _heap_->f_val->free(bucket->buffer[j].value);              \
+            }                                                                  \
+                                                                               \
+            if (bucket->buffer)                                                \
+                _heap_->alloc->free(bucket->buffer);                           \
+        }                                                                      \
+                                                                               \
+        _heap_->alloc->free(_heap_);                                           \
+    }                                                                          \
+                                                                               \
+    void PFX##_customize(struct SNAME *_heap_, struct cmc_alloc_node *alloc,   \
+                         struct cmc_callbacks *callbacks)                      \
+    {                                                                          \
+        if (!alloc)                                                            \
+            _heap_->alloc = &cmc_alloc_node_default;                           \
+        else                                                                   \
+            _heap_->alloc = alloc;                                             \
+                                                                               \
+        _heap_->callbacks = callbacks;                                         \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+    }                                                                          \
+                                                                               \
+    /* Pushes an entry, which fails with cmc_flags.INVALID if key is */        \
+    /* smaller than the last key popped */                                     \
+    bool PFX##_push(struct SNAME *_heap_, K key, V value)                      \
+    {                                                                          \
+        if (key < _heap_->last)                                                \
+        {                                                                      \
+            _heap_->flag = cmc_flags.INVALID;                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        struct SNAME##_bucket *bucket =                                        \
+            &(_heap_->buckets[PFX##_impl_bucket(key, _heap_->last)]);          \
+                                                                               \
+        if (bucket->count == bucket->capacity)                                 \
+        {                                                                      \
+            if (!PFX##_impl_grow(_heap_, bucket, 1))                           \
+                return false;                                                  \
+        }                                                                      \
+                                                                               \
+        bucket->buffer[bucket->count++] =                                      \
+            (struct SNAME##_entry){ key, value };                              \
+                                                                               \
+        _heap_->count++;                                                       \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_heap_->callbacks && _heap_->callbacks->create)                    \
+            _heap_->callbacks->create();                                       \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Removes an entry with the smallest key, storing its key and value in */ \
+    /* the ones that are not NULL */                                           \
+    bool PFX##_pop_min(struct SNAME *_heap_, K *key, V *value)                 \
+    {                                                                          \
+        if (PFX##_empty(_heap_))                                               \
+        {                                                                      \
+            _heap_->flag = cmc_flags.EMPTY;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (!PFX##_impl_refill(_heap_))                                        \
+            return false;                                                      \
+                                                                               \
+        struct SNAME##_bucket *bucket = &(_heap_->buckets[0]);                 \
+        struct SNAME##_entry entry = bucket->buffer[--bucket->count];          \
+                                                                               \
+        if (key)                                                               \
+            *key = entry.key;                                                  \
+        if (value)                                                             \
+            *value = entry.value;                                              \
+                                                                               \
+        _heap_->count--;                                                       \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_heap_->callbacks && _heap_->callbacks->delete)                    \
+            _heap_->callbacks->delete ();                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Reads the entry that pop_min would remove. Since the buckets might */   \
+    /* have to be rearranged this may also fail with cmc_flags.ALLOC */        \
+    bool PFX##_peek(struct SNAME *_heap_, K *key, V *value)                    \
+    {                                                                          \
+        if (PFX##_empty(_heap_))                                               \
+        {                                                                      \
+            _heap_->flag = cmc_flags.EMPTY;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (!PFX##_impl_refill(_heap_))                                        \
+            return false;                                                      \
+                                                                               \
+        struct SNAME##_bucket *bucket = &(_heap_->buckets[0]);                 \
+                                                                               \
+        if (key)                                                               \
+            *key = bucket->buffer[bucket->count - 1].key;                      \
+        if (value)                                                             \
+            *value = bucket->buffer[bucket->count - 1].value;                  \
+                                                                               \
+        _heap_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_heap_->callbacks && _heap_->callbacks->read)                      \
+            _heap_->callbacks->read();                                         \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Returns the smallest key that can be pushed */                          \
+    K PFX##_last(struct SNAME *_heap_)                                         \
+    {                                                                          \
+        return _heap_->last;                                                   \
+    }                                                                          \
+                                                                               \
+    bool PFX##_empty(struct SNAME *_heap_)                                     \
+    {                                                                          \
+        return _heap_->count == 0;                                             \
+    }                                                                          \
+                                                                               \
+    size_t PFX##_count(struct SNAME *_heap_)                                   \
+    {                                                                          \
+        return _heap_->count;                                                  \
+    }                                                                          \
+                                                                               \
+    int PFX##_flag(struct SNAME *_heap_)                                       \
+    {                                                                          \
+        return _heap_->flag;                                                   \
+    }                                                                          \
+                                                                               \
+    struct cmc_string PFX##_to_string(struct SNAME *_heap_)                    \
+    {                                                                          \
+        struct cmc_string str;                                                 \
+        struct SNAME *h_ = _heap_;                                             \
+                                                                               \
+        int n = snprintf(str.s, cmc_string_len, cmc_string_fmt_radixheap,      \
+                         #SNAME, #K, #V, h_, (uintmax_t)h_->last, h_->count,   \
+                         h_->flag, h_->f_val, h_->alloc, h_->callbacks);       \
+                                                                               \
+        return n >= 0 ? str : (struct cmc_string){ 0 };                        \
+    }                                                                          \
+                                                                               \
+    /* Prints every entry as key:value, bucket by bucket */                    \
+    bool PFX##_print(struct SNAME *_heap_, FILE *fptr)                         \
+    {                                                                          \
+        for (size_t i = 0; i < sizeof(K) * CHAR_BIT + 1; i++)                  \
+        {                                                                      \
+            struct SNAME##_bucket *bucket = &(_heap_->buckets[i]);             \
+                                                                               \
+            for (size_t j = 0; j < bucket->count; j++)                         \
+            {                                                                  \
+                if (fprintf(fptr, "%" PRIuMAX ":",                             \
+                            (uintmax_t)bucket->buffer[j].key) < 0)             \
+                    return false;                                              \
+                                                                               \
+                if (!_heap_->f_val->str(fptr, bucket->buffer[j].value))        \
+                    return false;                                              \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Index of the bucket of a key given the last key popped */               \
+    static size_t PFX##_impl_bucket(K key, K last)                             \
+    {                                                                          \
+        return cmc_radixheap_bit_length((uintmax_t)(key ^ last));              \
+    }                                                                          \
+                                                                               \
+    /* Makes room for at least size more entries in a bucket */                \
+    static bool PFX##_impl_grow(struct SNAME *_heap_,                          \
+                                struct SNAME##_bucket *bucket, size_t size)    \
+    {                                                                          \
+        if (size <= bucket->capacity - bucket->count)                          \
+            return true;                                                       \
+                                                                               \
+        size_t capacity = bucket->capacity == 0 ? CMC_RADIXHEAP_BUCKET_SIZE    \
+                                                : bucket->capacity * 2;        \
+                                                                               \
+        if (capacity < bucket->count + size)                                   \
+            capacity = bucket->count + size;                                   \
+                                                                               \
+        struct SNAME##_entry *new_buffer = _heap_->alloc->realloc(             \
+            bucket->buffer, sizeof(struct SNAME##_entry) * capacity);          \
+                                                                               \
+        if (!new_buffer)                                                       \
+        {                                                                      \
+            _heap_->flag = cmc_flags.ALLOC;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        bucket->buffer = new_buffer;                                           \
+        bucket->capacity = capacity;                                           \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* If bucket 0 is empty, the smallest key of the lowest bucket with */     \
+    /* entries becomes the last key popped and all of that bucket's */         \
+    /* entries go to lower buckets, which fills bucket 0 */                    \
+    static bool PFX##_impl_refill(struct SNAME *_heap_)                        \
+    {                                                                          \
+        if (_heap_->buckets[0].count > 0)                                      \
+            return true;                                                       \
+                                                                               \
+        size_t i = 1;                                                          \
+                                                                               \
+        while (_heap_->buckets[i].count == 0)                                  \
+            i++;                                                               \
+                                                                               \
+        struct SNAME##_bucket *bucket = &(_heap_->buckets[i]);                 \
+                                                                               \
+        K last = bucket->buffer[0].key;                                        \
+                                                                               \
+        for (size_t j = 1; j < bucket->count; j++)                             \
+        {                                                                      \
+            if (bucket->buffer[j].key < last)                                  \
+                last = bucket->buffer[j].key;                                  \
+        }                                                                      \
+                                                                               \
+        /* Every lower bucket is empty so all of them are reserved first */    \
+        /* in order to leave the heap untouched if an allocation fails */      \
+        size_t sizes[sizeof(K) * CHAR_BIT + 1] = { 0 };                        \
+                                                                               \
+        for (size_t j = 0; j < bucket->count; j++)                             \
+            sizes[PFX##_impl_bucket(bucket->buffer[j].key, last)]++;           \
+                                                                               \
+        for (size_t j = 0; j < i; j++)                                         \
+        {                                                                      \
+            if (!PFX##_impl_grow(_heap_, &(_heap_->buckets[j]), sizes[j]))     \
+                return false;                                                  \
+        }                                                                      \
+                                                                               \
+        for (size_t j = 0; j < bucket->count; j++)                             \
+        {                                                                      \
+            struct SNAME##_bucket *target =                                    \
+                &(_heap_->buckets[PFX##_impl_bucket(bucket->buffer[j].key,     \
+                                                    last)]);                   \
+                                                                               \
+            target->buffer[target->count++] = bucket->buffer[j];               \
+        }                                                                      \
+                                                                               \
+        bucket->count = 0;                                                     \
+                                                                               \
+        _heap_->last = last;                                                   \
+                                                                               \
+        return true;                                                           \
+    }
+
+#endif /* CMC_RADIXHEAP_H */
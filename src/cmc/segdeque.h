@@ -0,0 +1,1334 @@
+/**
+ * segdeque.h
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * SegDeque
+ *
+ * A SegDeque (segmented double-ended queue) is a Deque (see deque.h) that
+ * stores its elements in fixed size blocks instead of a single circular
+ * buffer. It has the same API as the Deque, so switching between the two only
+ * requires changing CMC_GENERATE_DEQUE to CMC_GENERATE_SEGDEQUE, and it also
+ * adds get and get_ref to access elements by index.
+ *
+ * Implementation
+ *
+ * The blocks are held by a map, which is an array of pointers to blocks where
+ * the blocks in use are contiguous. Each block holds
+ * CMC_SEGDEQUE_BLOCK_SIZE(V) elements and takes about CMC_SEGDEQUE_BLOCK_BYTES
+ * bytes. Pushing an element to a full end of the deque only allocates a new
+ * block, so elements are never moved or copied once they are pushed and their
+ * addresses stay the same until they are popped. Only the map is reallocated
+ * when it has no more room for blocks on one of its ends, which copies one
+ * pointer per block.
+ *
+ * Blocks that become empty are not freed, but kept in the map to be reused by
+ * later pushes. Use shrink_to_fit to release them. The capacity of a SegDeque
+ * is the amount of elements that fit in all of its allocated blocks, so it is
+ * always a multiple of the block size. The growth policy (see set_growth) is
+ * used by the map.
+ *
+ * Accessing an element by its index is O(1) as its block and its position in
+ * that block are computed from the position of the front element.
+ */
+
+#ifndef CMC_SEGDEQUE_H
+#define CMC_SEGDEQUE_H
+
+/* -------------------------------------------------------------------------
+ * Core functionalities of the C Macro Collections Library
+ * ------------------------------------------------------------------------- */
+#include "../cor/core.h"
+#include "../cor/search.h"
+
+/* -------------------------------------------------------------------------
+ * SegDeque Specific
+ * ------------------------------------------------------------------------- */
+/* to_string format */
+static const char *cmc_string_fmt_segdeque = "struct %s<%s> "
+                                             "at %p { "
+                                             "map:%p, "
+                                             "map_capacity:%" PRIuMAX ", "
+                                             "first:%" PRIuMAX ", "
+                                             "blocks:%" PRIuMAX ", "
+                                             "front:%" PRIuMAX ", "
+                                             "capacity:%" PRIuMAX ", "
+                                             "count:%" PRIuMAX ", "
+                                             "flag:%d, "
+                                             "f_val:%p, "
+                                             "alloc:%p, "
+                                             "callbacks:%p }";
+
+/* Approximate size in bytes of each block */
+#ifndef CMC_SEGDEQUE_BLOCK_BYTES
+#define CMC_SEGDEQUE_BLOCK_BYTES 4096
+#endif /* CMC_SEGDEQUE_BLOCK_BYTES */
+
+/* Amount of elements in each block, which is at least 16 */
+#define CMC_SEGDEQUE_BLOCK_SIZE(V)              \
+    (CMC_SEGDEQUE_BLOCK_BYTES / sizeof(V) > 16  \
+         ? CMC_SEGDEQUE_BLOCK_BYTES / sizeof(V) \
+         : 16)
+
+#define CMC_GENERATE_SEGDEQUE(PFX, SNAME, V)    \
+    CMC_GENERATE_SEGDEQUE_HEADER(PFX, SNAME, V) \
+    CMC_GENERATE_SEGDEQUE_SOURCE(PFX, SNAME, V)
+
+/* Generates a SegDeque of plain old data, which is searched by comparing the */
+/* bytes of the elements instead of calling the comparator (see cor/search.h) */
+#define CMC_GENERATE_SEGDEQUE_POD(PFX, SNAME, V) \
+    CMC_GENERATE_SEGDEQUE_HEADER(PFX, SNAME, V)  \
+    CMC_GENERATE_SEGDEQUE_SOURCE_POD(PFX, SNAME, V)
+
+#define CMC_WRAPGEN_SEGDEQUE_HEADER(PFX, SNAME, K, V) \
+    CMC_GENERATE_SEGDEQUE_HEADER(PFX, SNAME, V)
+
+#define CMC_WRAPGEN_SEGDEQUE_SOURCE(PFX, SNAME, K, V) \
+    CMC_GENERATE_SEGDEQUE_SOURCE(PFX, SNAME, V)
+
+/* -------------------------------------------------------------------------
+ * Header
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_SEGDEQUE_HEADER(PFX, SNAME, V)                           \
+                                                                              \
+    /* SegDeque Structure */                                                  \
+    struct SNAME                                                              \
+    {                                                                         \
+        /* Pointers to the blocks of elements or NULL if not allocated */     \
+        V **map;                                                              \
+                                                                              \
+        /* Amount of pointers in the map */                                   \
+        size_t map_capacity;                                                  \
+                                                                              \
+        /* Index in the map of the block holding the front element */         \
+        size_t first;                                                         \
+                                                                              \
+        /* Amount of blocks holding elements, starting at first */            \
+        size_t blocks;                                                        \
+                                                                              \
+        /* Position of the front element inside of its block */               \
+        size_t front;                                                         \
+                                                                              \
+        /* Amount of elements that fit in all allocated blocks */             \
+        size_t capacity;                                                      \
+                                                                              \
+        /* Current amount of elements */                                      \
+        size_t count;                                                         \
+                                                                              \
+        /* Flags indicating errors or success */                              \
+        int flag;                                                             \
+                                                                              \
+        /* Value function table */                                            \
+        struct SNAME##_fval *f_val;                                           \
+                                                                              \
+        /* Custom allocation functions */                                     \
+        struct cmc_alloc_node *alloc;                                         \
+                                                                              \
+        /* Custom callback functions */                                       \
+        struct cmc_callbacks *callbacks;                                      \
+                                                                              \
+        /* Growth policy of the map */                                        \
+        const struct cmc_growth *growth;                                      \
+    };                                                                        \
+                                                                              \
+    struct SNAME##_fval                                                       \
+    {                                                                         \
+        /* Comparator function */                                             \
+        int (*cmp)(V, V);                                                     \
+                                                                              \
+        /* Copy function */                                                   \
+        V (*cpy)(V);                                                          \
+                                                                              \
+        /* To string function */                                              \
+        bool (*str)(FILE *, V);                                               \
+                                                                              \
+        /* Free from memory function */                                       \
+        void (*free)(V);                                                      \
+                                                                              \
+        /* Hash function */                                                   \
+        size_t (*hash)(V);                                                    \
+                                                                              \
+        /* Priority function */                                               \
+        int (*pri)(V, V);                                                     \
+    };                                                                        \
+                                                                              \
+    /* SegDeque Iterator */                                                   \
+    struct SNAME##_iter                                                       \
+    {                                                                         \
+        /* Target segdeque */                                                 \
+        struct SNAME *target;                                                 \
+                                                                              \
+        /* Index in the map of the cursor's block */                          \
+        size_t block;                                                         \
+                                                                              \
+        /* Cursor's position inside of its block */                           \
+        size_t offset;                                                        \
+                                                                              \
+        /* Keeps track of relative index to the iteration of elements */      \
+        size_t index;                                                         \
+                                                                              \
+        /* If the iterator has reached the start of the iteration */          \
+        bool start;                                                           \
+                                                                              \
+        /* If the iterator has reached the end of the iteration */            \
+        bool end;                                                             \
+    };                                                                        \
+                                                                              \
+    /* Collection Functions */                                                \
+    /* Collection Allocation and Deallocation */                              \
+    struct SNAME *PFX##_new(size_t capacity, struct SNAME##_fval *f_val);     \
+    struct SNAME *PFX##_new_custom(                                           \
+        size_t capacity, struct SNAME##_fval *f_val,                          \
+        struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks);       \
+    struct SNAME PFX##_init(size_t capacity, struct SNAME##_fval *f_val);     \
+    struct SNAME PFX##_init_custom(                                           \
+        size_t capacity, struct SNAME##_fval *f_val,                          \
+        struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks);       \
+    void PFX##_clear(struct SNAME *_deque_);                                  \
+    void PFX##_free(struct SNAME *_deque_);                                   \
+    void PFX##_release(struct SNAME _deque_);                                 \
+    /* Customization of Allocation and Callbacks */                           \
+    void PFX##_customize(struct SNAME *_deque_, struct cmc_alloc_node *alloc, \
+                         struct cmc_callbacks *callbacks);                    \
+    void PFX##_set_growth(struct SNAME *_deque_,                              \
+                          const struct cmc_growth *growth);                   \
+    /* Collection Input and Output */                                         \
+    bool PFX##_push_front(struct SNAME *_deque_, V value);                    \
+    bool PFX##_push_back(struct SNAME *_deque_, V value);                     \
+    bool PFX##_pop_front(struct SNAME *_deque_);                              \
+    bool PFX##_pop_back(struct SNAME *_deque_);                               \
+    bool PFX##_push_back_n(struct SNAME *_deque_, V *values, size_t n);       \
+    size_t PFX##_pop_front_n(struct SNAME *_deque_, V *out, size_t n);        \
+    /* Element Access */                                                      \
+    V PFX##_front(struct SNAME *_deque_);                                     \
+    V PFX##_back(struct SNAME *_deque_);                                      \
+    V PFX##_get(struct SNAME *_deque_, size_t index);                         \
+    V *PFX##_get_ref(struct SNAME *_deque_, size_t index);                    \
+    /* Collection State */                                                    \
+    bool PFX##_contains(struct SNAME *_deque_, V value);                      \
+    bool PFX##_empty(struct SNAME *_deque_);                                  \
+    bool PFX##_full(struct SNAME *_deque_);                                   \
+    size_t PFX##_count(struct SNAME *_deque_);                                \
+    size_t PFX##_capacity(struct SNAME *_deque_);                             \
+    int PFX##_flag(struct SNAME *_deque_);                                    \
+    /* Collection Utility */                                                  \
+    bool PFX##_resize(struct SNAME *_deque_, size_t capacity);                \
+    bool PFX##_reserve(struct SNAME *_deque_, size_t size);                   \
+    bool PFX##_shrink_to_fit(struct SNAME *_deque_);                          \
+    struct SNAME *PFX##_copy_of(struct SNAME *_deque_);                       \
+    bool PFX##_equals(struct SNAME *_deque1_, struct SNAME *_deque2_);        \
+    struct cmc_string PFX##_to_string(struct SNAME *_deque_);                 \
+    bool PFX##_print(struct SNAME *_deque_, FILE *fptr);                      \
+                                                                              \
+    /* Iterator Functions */                                                  \
+    /* Iterator Initialization */                                             \
+    struct SNAME##_iter PFX##_iter_start(struct SNAME *target);               \
+    struct SNAME##_iter PFX##_iter_end(struct SNAME *target);                 \
+    /* Iterator State */                                                      \
+    bool PFX##_iter_at_start(struct SNAME##_iter *iter);                      \
+    bool PFX##_iter_at_end(struct SNAME##_iter *iter);                        \
+    /* Iterator Movement */                                                   \
+    bool PFX##_iter_to_start(struct SNAME##_iter *iter);                      \
+    bool PFX##_iter_to_end(struct SNAME##_iter *iter);                        \
+    bool PFX##_iter_next(struct SNAME##_iter *iter);                          \
+    bool PFX##_iter_prev(struct SNAME##_iter *iter);                          \
+    bool PFX##_iter_advance(struct SNAME##_iter *iter, size_t steps);         \
+    bool PFX##_iter_rewind(struct SNAME##_iter *iter, size_t steps);          \
+    bool PFX##_iter_go_to(struct SNAME##_iter *iter, size_t index);           \
+    /* Iterator Access */                                                     \
+    V PFX##_iter_value(struct SNAME##_iter *iter);                            \
+    V *PFX##_iter_rvalue(struct SNAME##_iter *iter);                          \
+    size_t PFX##_iter_index(struct SNAME##_iter *iter);
+
+/* -------------------------------------------------------------------------
+ * Source
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_SEGDEQUE_SOURCE(PFX, SNAME, V) \
+    CMC_GENERATE_SEARCH(PFX, V)                     \
+    CMC_GENERATE_SEGDEQUE_CORE_SOURCE(PFX, SNAME, V)
+
+#define CMC_GENERATE_SEGDEQUE_SOURCE_POD(PFX, SNAME, V) \
+    CMC_GENERATE_SEARCH_POD(PFX, V)                     \
+    CMC_GENERATE_SEGDEQUE_CORE_SOURCE(PFX, SNAME, V)
+
+#define CMC_GENERATE_SEGDEQUE_CORE_SOURCE(PFX, SNAME, V)                       \
+                                                                               \
+    /* Implementation Detail Functions */                                      \
+    static V *PFX##_impl_at(struct SNAME *_deque_, size_t index);              \
+    static bool PFX##_impl_block(struct SNAME *_deque_, size_t index);         \
+    static bool PFX##_impl_remap(struct SNAME *_deque_, size_t map_capacity);  \
+    static bool PFX##_impl_grow_map(struct SNAME *_deque_);                    \
+    static void PFX##_impl_iter_seek(struct SNAME##_iter *iter, size_t index); \
+                                                                               \
+    struct SNAME *PFX##_new(size_t capacity, struct SNAME##_fval *f_val)       \
+    {                                                                          \
+        return PFX##_new_custom(capacity, f_val, NULL, NULL);                  \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_new_custom(                                            \
+        size_t capacity, struct SNAME##_fval *f_val,                           \
+        struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks)         \
+    {                                                                          \
+        if (capacity < 1)                                                      \
+            return NULL;                                                       \
+                                                                               \
+        if (!f_val)                                                            \
+            return NULL;                                                       \
+                                                                               \
+        if (!alloc)                                                            \
+            alloc = &cmc_alloc_node_default;                                   \
+                                                                               \
+        struct SNAME *_deque_ = alloc->malloc(sizeof(struct SNAME));           \
+                                                                               \
+        if (!_deque_)                                                          \
+            return NULL;                                                       \
+                                                                               \
+        *_deque_ = PFX##_init_custom(capacity, f_val, alloc, callbacks);       \
+                                                                               \
+        if (!_deque_->map)                                                     \
+        {                                                                      \
+            alloc->free(_deque_);                                              \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        return _deque_;                                                        \
+    }                                                                          \
+                                                                               \
+    struct SNAME PFX##_init(size_t capacity, struct SNAME##_fval *f_val)       \
+    {                                                                          \
+        return PFX##_init_custom(capacity, f_val, NULL, NULL);                 \
+    }                                                                          \
+                                                                               \
+    struct SNAME PFX##_init_custom(                                            \
+        size_t capacity, struct SNAME##_fval *f_val,                           \
+        struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks)         \
+    {                                                                          \
+        struct SNAME _deque_ = { 0 };                                          \
+                                                                               \
+        if (capacity < 1)                                                      \
+            return _deque_;                                                    \
+                                                                               \
+        if (!f_val)                                                            \
+            return _deque_;                                                    \
+                                                                               \
+        if (!alloc)                                                            \
+            alloc = &cmc_alloc_node_default;                                   \
+                                                                               \
+        const size_t block_size = CMC_SEGDEQUE_BLOCK_SIZE(V);                  \
+                                                                               \
+        size_t blocks = (capacity - 1) / block_size + 1;                       \
+                                                                               \
+        /* Leaves a free slot on each side of the blocks */                    \
+        _deque_.map = alloc->calloc(blocks + 2, sizeof(V *));                  \
+                                                                               \
+        if (!_deque_.map)                                                      \
+            return _deque_;                                                    \
+                                                                               \
+        for (size_t i = 1; i <= blocks; i++)                                   \
+        {                                                                      \
+            _deque_.map[i] = alloc->malloc(sizeof(V) * block_size);            \
+                                                                               \
+            if (!_deque_.map[i])                                               \
+            {                                                                  \
+                for (size_t j = 1; j < i; j++)                                 \
+                    alloc->free(_deque_.map[j]);                               \
+                                                                               \
+                alloc->free(_deque_.map);                                      \
+                                                                               \
+                return (struct SNAME){ 0 };                                    \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        _deque_.map_capacity = blocks + 2;                                     \
+        _deque_.first = 1;                                                     \
+        _deque_.blocks = 0;                                                    \
+        _deque_.front = 0;                                                     \
+        _deque_.capacity = blocks * block_size;                                \
+        _deque_.count = 0;                                                     \
+        _deque_.flag = cmc_flags.OK;                                           \
+        _deque_.f_val = f_val;                                                 \
+        _deque_.alloc = alloc;                                                 \
+        _deque_.callbacks = callbacks;                                         \
+        _deque_.growth = NULL;                                                 \
+                                                                               \
+        return _deque_;                                                        \
+    }                                                                          \
+                                                                               \
+    void PFX##_clear(struct SNAME *_deque_)                                    \
+    {                                                                          \
+        if (_deque_->f_val->free)                                              \
+        {                                                                      \
+            for (size_t i = 0; i < _deque_->count; i++)                        \
+                _deque_->f_val->free(*PFX##_impl_at(_deque_, i));              \
+        }                                                                      \
+                                                                               \
+        _deque_->blocks = 0;                                                   \
+        _deque_->front = 0;                                                    \
+        _deque_->count = 0;                                                    \
+                                                                               \
+        _deque_->flag = cmc_flags.OK;                                          \
+    }                                                                          \
+                                                                               \
+    void PFX##_free(struct SNAME *_deque_)                                     \
+    {                                                                          \
+        struct cmc_alloc_node *alloc = _deque_->alloc;                         \
+                                                                               \
+        PFX##_release(*_deque_);                                               \
+                                                                               \
+        alloc->free(_deque_);                                                  \
+    }                                                                          \
+                                                                               \
+    void PFX##_release(struct SNAME _deque_)                                   \
+    {                                                                          \
+        if (_deque_.f_val->free)                                               \
+        {                                                                      \
+            for (size_t i = 0; i < _deque_.count; i++)                         \
+                _deque_.f_val->free(*PFX##_impl_at(&_deque_, i));              \
+        }                                                                      \
+                                                                               \
+        for (size_t i = 0; i < _deque_.map_capacity; i++)                      \
+        {                                                                      \
+            if (_deque_.map[i])                                                \
+                _deque_.alloc->free(_deque_.map[i]);                           \
+        }                                                                      \
+                                                                               \
+        _deque_.alloc->free(_deque_.map);                                      \
+    }                                                                          \
+                                                                               \
+    void PFX##_customize(struct SNAME *_deque_, struct cmc_alloc_node *alloc,  \
+                         struct cmc_callbacks *callbacks)                      \
+    {                                                                          \
+        if (!alloc)                                                            \
+            _deque_->alloc = &cmc_alloc_node_default;                          \
+        else                                                                   \
+            _deque_->alloc = alloc;                                            \
+                                                                               \
+        _deque_->callbacks = callbacks;                                        \
+                                                                               \
+        _deque_->flag = cmc_flags.OK;                                          \
+    }                                                                          \
+                                                                               \
+    /* Sets the growth policy used when the map is full (NULL for the */       \
+    /* default one) */                                                         \
+    void PFX##_set_growth(struct SNAME *_deque_,                               \
+                          const struct cmc_growth *growth)                     \
+    {                                                                          \
+        _deque_->growth = growth;                                              \
+                                                                               \
+        _deque_->flag = cmc_flags.OK;                                          \
+    }                                                                          \
+                                                                               \
+    bool PFX##_push_front(struct SNAME *_deque_, V value)                      \
+    {                                                                          \
+        const size_t block_size = CMC_SEGDEQUE_BLOCK_SIZE(V);                  \
+                                                                               \
+        if (PFX##_empty(_deque_))                                              \
+        {                                                                      \
+            if (!PFX##_impl_block(_deque_, _deque_->first))                    \
+                return false;                                                  \
+                                                                               \
+            _deque_->blocks = 1;                                               \
+            _deque_->front = block_size;                                       \
+        }                                                                      \
+        else if (_deque_->front == 0)                                          \
+        {                                                                      \
+            if (_deque_->first == 0 && !PFX##_impl_grow_map(_deque_))          \
+                return false;                                                  \
+                                                                               \
+            if (!PFX##_impl_block(_deque_, _deque_->first - 1))                \
+                return false;                                                  \
+                                                                               \
+            _deque_->first--;                                                  \
+            _deque_->blocks++;                                                 \
+            _deque_->front = block_size;                                       \
+        }                                                                      \
+                                                                               \
+        _deque_->front--;                                                      \
+                                                                               \
+        _deque_->map[_deque_->first][_deque_->front] = value;                  \
+                                                                               \
+        _deque_->count++;                                                      \
+        _deque_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        if (_deque_->callbacks && _deque_->callbacks->create)                  \
+            _deque_->callbacks->create();                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_push_back(struct SNAME *_deque_, V value)                       \
+    {                                                                          \
+        const size_t block_size = CMC_SEGDEQUE_BLOCK_SIZE(V);                  \
+                                                                               \
+        if (PFX##_empty(_deque_))                                              \
+        {                                                                      \
+            if (!PFX##_impl_block(_deque_, _deque_->first))                    \
+                return false;                                                  \
+                                                                               \
+            _deque_->blocks = 1;                                               \
+            _deque_->front = 0;                                                \
+        }                                                                      \
+        else if (_deque_->front + _deque_->count ==                            \
+                 _deque_->blocks * block_size)                                 \
+        {                                                                      \
+            if (_deque_->first + _deque_->blocks == _deque_->map_capacity &&   \
+                !PFX##_impl_grow_map(_deque_))                                 \
+                return false;                                                  \
+                                                                               \
+            if (!PFX##_impl_block(_deque_, _deque_->first + _deque_->blocks))  \
+                return false;                                                  \
+                                                                               \
+            _deque_->blocks++;                                                 \
+        }                                                                      \
+                                                                               \
+        *PFX##_impl_at(_deque_, _deque_->count) = value;                       \
+                                                                               \
+        _deque_->count++;                                                      \
+        _deque_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        if (_deque_->callbacks && _deque_->callbacks->create)                  \
+            _deque_->callbacks->create();                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_pop_front(struct SNAME *_deque_)                                \
+    {                                                                          \
+        if (PFX##_empty(_deque_))                                              \
+        {                                                                      \
+            _deque_->flag = cmc_flags.EMPTY;                                   \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        _deque_->count--;                                                      \
+                                                                               \
+        if (PFX##_empty(_deque_))                                              \
+        {                                                                      \
+            _deque_->blocks = 0;                                               \
+            _deque_->front = 0;                                                \
+        }                                                                      \
+        else if (++_deque_->front == CMC_SEGDEQUE_BLOCK_SIZE(V))               \
+        {                                                                      \
+            /* The block is kept in the map to be reused */                    \
+            _deque_->first++;                                                  \
+            _deque_->blocks--;                                                 \
+            _deque_->front = 0;                                                \
+        }                                                                      \
+                                                                               \
+        _deque_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        if (_deque_->callbacks && _deque_->callbacks->delete)                  \
+            _deque_->callbacks->delete ();                                     \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_pop_back(struct SNAME *_deque_)                                 \
+    {                                                                          \
+        if (PFX##_empty(_deque_))                                              \
+        {                                                                      \
+            _deque_->flag = cmc_flags.EMPTY;                                   \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        _deque_->count--;                                                      \
+                                                                               \
+        if (PFX##_empty(_deque_))                                              \
+        {                                                                      \
+            _deque_->blocks = 0;                                               \
+            _deque_->front = 0;                                                \
+        }                                                                      \
+        else if ((_deque_->front + _deque_->count) %                           \
+                     CMC_SEGDEQUE_BLOCK_SIZE(V) ==                             \
+                 0)                                                            \
+        {                                                                      \
+            /* The block is kept in the map to be reused */                    \
+            _deque_->blocks--;                                                 \
+        }                                                                      \
+                                                                               \
+        _deque_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        if (_deque_->callbacks && _deque_->callbacks->delete)                  \
+            _deque_->callbacks->delete ();                                     \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Pushes n values to the back of the deque, allocating every block */     \
+    /* they need first and then copying them one block at a time */            \
+    bool PFX##_push_back_n(struct SNAME *_deque_, V *values, size_t n)         \
+    {                                                                          \
+        const size_t block_size = CMC_SEGDEQUE_BLOCK_SIZE(V);                  \
+                                                                               \
+        _deque_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        if (n == 0)                                                            \
+            return true;                                                       \
+                                                                               \
+        if (n > SIZE_MAX - _deque_->front - _deque_->count)                    \
+        {                                                                      \
+            _deque_->flag = cmc_flags.ERROR;                                   \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (PFX##_empty(_deque_))                                              \
+            _deque_->front = 0;                                                \
+                                                                               \
+        size_t position = _deque_->front + _deque_->count;                     \
+        size_t blocks = (position + n - 1) / block_size + 1;                   \
+                                                                               \
+        if (_deque_->first + blocks > _deque_->map_capacity)                   \
+        {                                                                      \
+            size_t allocated = _deque_->capacity / block_size;                 \
+            size_t required = blocks * 2 > allocated ? blocks * 2 : allocated; \
+                                                                               \
+            if (!PFX##_impl_remap(_deque_,                                     \
+                                  cmc_growth_capacity(_deque_->growth,         \
+                                                      _deque_->map_capacity,   \
+                                                      required)))              \
+                return false;                                                  \
+        }                                                                      \
+                                                                               \
+        for (size_t i = _deque_->first + _deque_->blocks;                      \
+             i < _deque_->first + blocks; i++)                                 \
+        {                                                                      \
+            if (!PFX##_impl_block(_deque_, i))                                 \
+                return false;                                                  \
+        }                                                                      \
+                                                                               \
+        for (size_t remaining = n; remaining > 0;)                             \
+        {                                                                      \
+            size_t offset = position % block_size;                             \
+            size_t count = block_size - offset;                                \
+                                                                               \
+            if (count > remaining)                                             \
+                count = remaining;                                             \
+                                                                               \
+            memcpy(_deque_->map[_deque_->first + position / block_size] +      \
+                       offset,                                                 \
+                   values, sizeof(V) * count);                                 \
+                                                                               \
+            values += count;                                                   \
+            position += count;                                                 \
+            remaining -= count;                                                \
+        }                                                                      \
+                                                                               \
+        _deque_->blocks = blocks;                                              \
+        _deque_->count += n;                                                   \
+                                                                               \
+        if (_deque_->callbacks && _deque_->callbacks->create)                  \
+            _deque_->callbacks->create();                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Pops up to n values from the front of the deque, copying them to out */ \
+    /* if it is not NULL, and returns how many were popped */                  \
+    size_t PFX##_pop_front_n(struct SNAME *_deque_, V *out, size_t n)          \
+    {                                                                          \
+        const size_t block_size = CMC_SEGDEQUE_BLOCK_SIZE(V);                  \
+                                                                               \
+        if (PFX##_empty(_deque_))                                              \
+        {                                                                      \
+            _deque_->flag = cmc_flags.EMPTY;                                   \
+            return 0;                                                          \
+        }                                                                      \
+                                                                               \
+        if (n > _deque_->count)                                                \
+            n = _deque_->count;                                                \
+                                                                               \
+        for (size_t remaining = n; remaining > 0;)                             \
+        {                                                                      \
+            if (_deque_->front == block_size)                                  \
+            {                                                                  \
+                _deque_->first++;                                              \
+                _deque_->blocks--;                                             \
+                _deque_->front = 0;                                            \
+            }                                                                  \
+                                                                               \
+            size_t count = block_size - _deque_->front;                        \
+                                                                               \
+            if (count > remaining)                                             \
+                count = remaining;                                             \
+                                                                               \
+            if (out)                                                           \
+            {                                                                  \
+                memcpy(out, _deque_->map[_deque_->first] + _deque_->front,     \
+                       sizeof(V) * count);                                     \
+                                                                               \
+                out += count;                                                  \
+            }                                                                  \
+                                                                               \
+            _deque_->front += count;                                           \
+            remaining -= count;                                                \
+        }                                                                      \
+                                                                               \
+        _deque_->count -= n;                                                   \
+                                                                               \
+        if (PFX##_empty(_deque_))                                              \
+        {                                                                      \
+            _deque_->blocks = 0;                                               \
+            _deque_->front = 0;                                                \
+        }                                                                      \
+        else if (_deque_->front == block_size)                                 \
+        {                                                                      \
+            _deque_->first++;                                                  \
+            _deque_->blocks--;                                                 \
+            _deque_->front = 0;                                                \
+        }                                                                      \
+                                                                               \
+        _deque_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        if (_deque_->callbacks && _deque_->callbacks->delete)                  \
+            _deque_->callbacks->delete ();                                     \
+                                                                               \
+        return n;                                                              \
+    }                                                                          \
+                                                                               \
+    V PFX##_front(struct SNAME *_deque_)                                       \
+    {                                                                          \
+        if (PFX##_empty(_deque_))                                              \
+        {                                                                      \
+            _deque_->flag = cmc_flags.EMPTY;                                   \
+            return (V){ 0 };                                                   \
+        }                                                                      \
+                                                                               \
+        _deque_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        if (_deque_->callbacks && _deque_->callbacks->read)                    \
+            _deque_->callbacks->read();                                        \
+                                                                               \
+        return _deque_->map[_deque_->first][_deque_->front];                   \
+    }                                                                          \
+                                                                               \
+    V PFX##_back(struct SNAME *_deque_)                                        \
+    {                                                                          \
+        if (PFX##_empty(_deque_))                                              \
+        {                                                                      \
+            _deque_->flag = cmc_flags.EMPTY;                                   \
+            return (V){ 0 };                                                   \
+        }                                                                      \
+                                                                               \
+        _deque_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        if (_deque_->callbacks && _deque_->callbacks->read)                    \
+            _deque_->callbacks->read();                                        \
+                                                                               \
+        return *PFX##_impl_at(_deque_, _deque_->count - 1);                    \
+    }                                                                          \
+                                                                               \
+    V PFX##_get(struct SNAME *_deque_, size_t index)                           \
+    {                                                                          \
+        if (PFX##_empty(_deque_))                                              \
+        {                                                                      \
+            _deque_->flag = cmc_flags.EMPTY;                                   \
+            return (V){ 0 };                                                   \
+        }                                                                      \
+                                                                               \
+        if (index >= _deque_->count)                                           \
+        {                                                                      \
+            _deque_->flag = cmc_flags.RANGE;                                   \
+            return (V){ 0 };                                                   \
+        }                                                                      \
+                                                                               \
+        _deque_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        if (_deque_->callbacks && _deque_->callbacks->read)                    \
+            _deque_->callbacks->read();                                        \
+                                                                               \
+        return *PFX##_impl_at(_deque_, index);                                 \
+    }                                                                          \
+                                                                               \
+    V *PFX##_get_ref(struct SNAME *_deque_, size_t index)                      \
+    {                                                                          \
+        if (PFX##_empty(_deque_))                                              \
+        {                                                                      \
+            _deque_->flag = cmc_flags.EMPTY;                                   \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        if (index >= _deque_->count)                                           \
+        {                                                                      \
+            _deque_->flag = cmc_flags.RANGE;                                   \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        _deque_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        if (_deque_->callbacks && _deque_->callbacks->read)                    \
+            _deque_->callbacks->read();                                        \
+                                                                               \
+        return PFX##_impl_at(_deque_, index);                                  \
+    }                                                                          \
+                                                                               \
+    bool PFX##_contains(struct SNAME *_deque_, V value)                        \
+    {                                                                          \
+        _deque_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        bool result = false;                                                   \
+                                                                               \
+        /* Each block is searched separately */                                \
+        size_t position = _deque_->front;                                      \
+        size_t remaining = _deque_->count;                                     \
+                                                                               \
+        for (size_t i = _deque_->first; remaining > 0; i++)                    \
+        {                                                                      \
+            size_t count = CMC_SEGDEQUE_BLOCK_SIZE(V) - position;              \
+                                                                               \
+            if (count > remaining)                                             \
+                count = remaining;                                             \
+                                                                               \
+            if (PFX##_impl_search(_deque_->map[i] + position, count, value,    \
+                                  _deque_->f_val->cmp) < count)                \
+            {                                                                  \
+                result = true;                                                 \
+                break;                                                         \
+            }                                                                  \
+                                                                               \
+            remaining -= count;                                                \
+            position = 0;                                                      \
+        }                                                                      \
+                                                                               \
+        if (_deque_->callbacks && _deque_->callbacks->read)                    \
+            _deque_->callbacks->read();                                        \
+                                                                               \
+        return result;                                                         \
+    }                                                                          \
+                                                                               \
+    bool PFX##_empty(struct SNAME *_deque_)                                    \
+    {                                                                          \
+        return _deque_->count == 0;                                            \
+    }                                                                          \
+                                                                               \
+    bool PFX##_full(struct SNAME *_deque_)                                     \
+    {                                                                          \
+        return _deque_->count >= _deque_->capacity;                            \
+    }                                                                          \
+                                                                               \
+    size_t PFX##_count(struct SNAME *_deque_)                                  \
+    {                                                                          \
+        return _deque_->count;                                                 \
+    }                                                                          \
+                                                                               \
+    size_t PFX##_capacity(struct SNAME *_deque_)                               \
+    {                                                                          \
+        return _deque_->capacity;                                              \
+    }                                                                          \
+                                                                               \
+    int PFX##_flag(struct SNAME *_deque_)                                      \
+    {                                                                          \
+        return _deque_->flag;                                                  \
+    }                                                                          \
+                                                                               \
+    /* Allocates or frees blocks until the capacity is the smallest */         \
+    /* multiple of the block size that is not less than the given capacity. */ \
+    /* Blocks that hold elements are never freed. */                           \
+    bool PFX##_resize(struct SNAME *_deque_, size_t capacity)                  \
+    {                                                                          \
+        _deque_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        const size_t block_size = CMC_SEGDEQUE_BLOCK_SIZE(V);                  \
+                                                                               \
+        if (capacity < _deque_->count)                                         \
+        {                                                                      \
+            _deque_->flag = cmc_flags.INVALID;                                 \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        size_t required = capacity == 0 ? 1 : (capacity - 1) / block_size + 1; \
+        size_t allocated = _deque_->capacity / block_size;                     \
+                                                                               \
+        if (required < _deque_->blocks)                                        \
+            required = _deque_->blocks;                                        \
+                                                                               \
+        if (required > allocated)                                              \
+        {                                                                      \
+            if (_deque_->map_capacity < required + 2 &&                        \
+                !PFX##_impl_remap(_deque_, required + 2))                      \
+                return false;                                                  \
+                                                                               \
+            /* New blocks are placed after the ones in use and then before */  \
+            /* them, since pushing to the back is more common */               \
+            for (size_t i = _deque_->first + _deque_->blocks;                  \
+                 i < _deque_->map_capacity && allocated < required; i++)       \
+            {                                                                  \
+                if (!_deque_->map[i])                                          \
+                {                                                              \
+                    if (!PFX##_impl_block(_deque_, i))                         \
+                        return false;                                          \
+                                                                               \
+                    allocated++;                                               \
+                }                                                              \
+            }                                                                  \
+                                                                               \
+            for (size_t i = _deque_->first; i > 0 && allocated < required;     \
+                 i--)                                                          \
+            {                                                                  \
+                if (!_deque_->map[i - 1])                                      \
+                {                                                              \
+                    if (!PFX##_impl_block(_deque_, i - 1))                     \
+                        return false;                                          \
+                                                                               \
+                    allocated++;                                               \
+                }                                                              \
+            }                                                                  \
+        }                                                                      \
+        else if (required < allocated)                                         \
+        {                                                                      \
+            /* Frees the blocks that are farther from the ones in use first */ \
+            for (size_t i = 0; i < _deque_->first && allocated > required;     \
+                 i++)                                                          \
+            {                                                                  \
+                if (_deque_->map[i])                                           \
+                {                                                              \
+                    _deque_->alloc->free(_deque_->map[i]);                     \
+                    _deque_->map[i] = NULL;                                    \
+                                                                               \
+                    allocated--;                                               \
+                }                                                              \
+            }                                                                  \
+                                                                               \
+            for (size_t i = _deque_->map_capacity;                             \
+                 i > _deque_->first + _deque_->blocks && allocated > required; \
+                 i--)                                                          \
+            {                                                                  \
+                if (_deque_->map[i - 1])                                       \
+                {                                                              \
+                    _deque_->alloc->free(_deque_->map[i - 1]);                 \
+                    _deque_->map[i - 1] = NULL;                                \
+                                                                               \
+                    allocated--;                                               \
+                }                                                              \
+            }                                                                  \
+                                                                               \
+            _deque_->capacity = allocated * block_size;                        \
+        }                                                                      \
+                                                                               \
+        if (_deque_->callbacks && _deque_->callbacks->resize)                  \
+            _deque_->callbacks->resize();                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Makes room for at least size more elements by allocating blocks */      \
+    bool PFX##_reserve(struct SNAME *_deque_, size_t size)                     \
+    {                                                                          \
+        _deque_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        if (size <= _deque_->capacity - _deque_->count)                        \
+            return true;                                                       \
+                                                                               \
+        if (size > SIZE_MAX - _deque_->count)                                  \
+        {                                                                      \
+            _deque_->flag = cmc_flags.ERROR;                                   \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        return PFX##_resize(_deque_, _deque_->count + size);                   \
+    }                                                                          \
+                                                                               \
+    /* Frees the blocks that are not in use and shrinks the map to them */     \
+    bool PFX##_shrink_to_fit(struct SNAME *_deque_)                            \
+    {                                                                          \
+        if (!PFX##_resize(_deque_, _deque_->count))                            \
+            return false;                                                      \
+                                                                               \
+        size_t allocated = _deque_->capacity / CMC_SEGDEQUE_BLOCK_SIZE(V);     \
+                                                                               \
+        if (_deque_->map_capacity > allocated + 2)                             \
+            return PFX##_impl_remap(_deque_, allocated + 2);                   \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_copy_of(struct SNAME *_deque_)                         \
+    {                                                                          \
+        const size_t block_size = CMC_SEGDEQUE_BLOCK_SIZE(V);                  \
+                                                                               \
+        struct SNAME *result =                                                 \
+            PFX##_new_custom(_deque_->capacity, _deque_->f_val,                \
+                             _deque_->alloc, _deque_->callbacks);              \
+                                                                               \
+        if (!result)                                                           \
+        {                                                                      \
+            _deque_->flag = cmc_flags.ERROR;                                   \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        /* The blocks of result start at the index 1 of its map */             \
+        for (size_t i = 0; i < _deque_->count; i++)                            \
+        {                                                                      \
+            V value = *PFX##_impl_at(_deque_, i);                              \
+                                                                               \
+            if (_deque_->f_val->cpy)                                           \
+                value = _deque_->f_val->cpy(value);                            \
+                                                                               \
+            result->map[1 + i / block_size][i % block_size] = value;           \
+        }                                                                      \
+                                                                               \
+        result->count = _deque_->count;                                        \
+        result->blocks =                                                       \
+            _deque_->count == 0 ? 0 : (_deque_->count - 1) / block_size + 1;   \
+        result->growth = _deque_->growth;                                      \
+                                                                               \
+        _deque_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        return result;                                                         \
+    }                                                                          \
+                                                                               \
+    bool PFX##_equals(struct SNAME *_deque1_, struct SNAME *_deque2_)          \
+    {                                                                          \
+        _deque1_->flag = cmc_flags.OK;                                         \
+        _deque2_->flag = cmc_flags.OK;                                         \
+                                                                               \
+        if (_deque1_->count != _deque2_->count)                                \
+            return false;                                                      \
+                                                                               \
+        for (size_t i = 0; i < _deque1_->count; i++)                           \
+        {                                                                      \
+            if (_deque1_->f_val->cmp(*PFX##_impl_at(_deque1_, i),              \
+                                     *PFX##_impl_at(_deque2_, i)) != 0)        \
+                return false;                                                  \
+        }                                                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    struct cmc_string PFX##_to_string(struct SNAME *_deque_)                   \
+    {                                                                          \
+        struct cmc_string str;                                                 \
+        struct SNAME *d_ = _deque_;                                            \
+                                                                               \
+        int n = snprintf(str.s, cmc_string_len, cmc_string_fmt_segdeque,       \
+                         #SNAME, #V, d_, d_->map, d_->map_capacity, d_->first, \
+                         d_->blocks, d_->front, d_->capacity, d_->count,       \
+                         d_->flag, d_->f_val, d_->alloc, d_->callbacks);       \
+                                                                               \
+        return n >= 0 ? str : (struct cmc_string){ 0 };                        \
+    }                                                                          \
+                                                                               \
+    bool PFX##_print(struct SNAME *_deque_, FILE *fptr)                        \
+    {                                                                          \
+        for (size_t i = 0; i < _deque_->count; i++)                            \
+        {                                                                      \
+            if (!_deque_->f_val->str(fptr, *PFX##_impl_at(_deque_, i)))        \
+                return false;                                                  \
+        }                                                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    struct SNAME##_iter PFX##_iter_start(struct SNAME *target)                 \
+    {                                                                          \
+        struct SNAME##_iter iter;                                              \
+                                                                               \
+        iter.target = target;                                                  \
+        iter.block = target->first;                                            \
+        iter.offset = target->front;                                           \
+        iter.index = 0;                                                        \
+        iter.start = true;                                                     \
+        iter.end = PFX##_empty(target);                                        \
+                                                                               \
+        return iter;                                                           \
+    }                                                                          \
+                                                                               \
+    struct SNAME##_iter PFX##_iter_end(struct SNAME *target)                   \
+    {                                                                          \
+        struct SNAME##_iter iter;                                              \
+                                                                               \
+        iter.target = target;                                                  \
+                                                                               \
+        if (!PFX##_empty(target))                                              \
+            PFX##_impl_iter_seek(&iter, target->count - 1);                    \
+        else                                                                   \
+        {                                                                      \
+            iter.block = target->first;                                        \
+            iter.offset = target->front;                                       \
+            iter.index = 0;                                                    \
+        }                                                                      \
+                                                                               \
+        iter.start = PFX##_empty(target);                                      \
+        iter.end = true;                                                       \
+                                                                               \
+        return iter;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_at_start(struct SNAME##_iter *iter)                        \
+    {                                                                          \
+        return PFX##_empty(iter->target) || iter->start;                       \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_at_end(struct SNAME##_iter *iter)                          \
+    {                                                                          \
+        return PFX##_empty(iter->target) || iter->end;                         \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_to_start(struct SNAME##_iter *iter)                        \
+    {                                                                          \
+        if (!PFX##_empty(iter->target))                                        \
+        {                                                                      \
+            iter->block = iter->target->first;                                 \
+            iter->offset = iter->target->front;                                \
+            iter->index = 0;                                                   \
+            iter->start = true;                                                \
+            iter->end = false;                                                 \
+                                                                               \
+            return true;                                                       \
+        }                                                                      \
+                                                                               \
+        return false;                                                          \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_to_end(struct SNAME##_iter *iter)                          \
+    {                                                                          \
+        if (!PFX##_empty(iter->target))                                        \
+        {                                                                      \
+            PFX##_impl_iter_seek(iter, iter->target->count - 1);               \
+                                                                               \
+            iter->start = false;                                               \
+            iter->end = true;                                                  \
+                                                                               \
+            return true;                                                       \
+        }                                                                      \
+                                                                               \
+        return false;                                                          \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_next(struct SNAME##_iter *iter)                            \
+    {                                                                          \
+        if (iter->end)                                                         \
+            return false;                                                      \
+                                                                               \
+        if (iter->index + 1 == iter->target->count)                            \
+        {                                                                      \
+            iter->end = true;                                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        iter->start = PFX##_empty(iter->target);                               \
+                                                                               \
+        if (++iter->offset == CMC_SEGDEQUE_BLOCK_SIZE(V))                      \
+        {                                                                      \
+            iter->block++;                                                     \
+            iter->offset = 0;                                                  \
+        }                                                                      \
+                                                                               \
+        iter->index++;                                                         \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_prev(struct SNAME##_iter *iter)                            \
+    {                                                                          \
+        if (iter->start)                                                       \
+            return false;                                                      \
+                                                                               \
+        if (iter->index == 0)                                                  \
+        {                                                                      \
+            iter->start = true;                                                \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        iter->end = PFX##_empty(iter->target);                                 \
+                                                                               \
+        if (iter->offset == 0)                                                 \
+        {                                                                      \
+            iter->block--;                                                     \
+            iter->offset = CMC_SEGDEQUE_BLOCK_SIZE(V);                         \
+        }                                                                      \
+                                                                               \
+        iter->offset--;                                                        \
+        iter->index--;                                                         \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Returns true only if the iterator moved */                              \
+    bool PFX##_iter_advance(struct SNAME##_iter *iter, size_t steps)           \
+    {                                                                          \
+        if (iter->end)                                                         \
+            return false;                                                      \
+                                                                               \
+        if (iter->index + 1 == iter->target->count)                            \
+        {                                                                      \
+            iter->end = true;                                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (steps == 0 || iter->index + steps >= iter->target->count)          \
+            return false;                                                      \
+                                                                               \
+        iter->start = PFX##_empty(iter->target);                               \
+                                                                               \
+        PFX##_impl_iter_seek(iter, iter->index + steps);                       \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Returns true only if the iterator moved */                              \
+    bool PFX##_iter_rewind(struct SNAME##_iter *iter, size_t steps)            \
+    {                                                                          \
+        if (iter->start)                                                       \
+            return false;                                                      \
+                                                                               \
+        if (iter->index == 0)                                                  \
+        {                                                                      \
+            iter->start = true;                                                \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (steps == 0 || iter->index < steps)                                 \
+            return false;                                                      \
+                                                                               \
+        iter->end = PFX##_empty(iter->target);                                 \
+                                                                               \
+        PFX##_impl_iter_seek(iter, iter->index - steps);                       \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Returns true only if the iterator was able to be positioned at the */   \
+    /* given index */                                                          \
+    bool PFX##_iter_go_to(struct SNAME##_iter *iter, size_t index)             \
+    {                                                                          \
+        if (index >= iter->target->count)                                      \
+            return false;                                                      \
+                                                                               \
+        if (iter->index > index)                                               \
+            return PFX##_iter_rewind(iter, iter->index - index);               \
+        else if (iter->index < index)                                          \
+            return PFX##_iter_advance(iter, index - iter->index);              \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    V PFX##_iter_value(struct SNAME##_iter *iter)                              \
+    {                                                                          \
+        if (PFX##_empty(iter->target))                                         \
+            return (V){ 0 };                                                   \
+                                                                               \
+        return iter->target->map[iter->block][iter->offset];                   \
+    }                                                                          \
+                                                                               \
+    V *PFX##_iter_rvalue(struct SNAME##_iter *iter)                            \
+    {                                                                          \
+        if (PFX##_empty(iter->target))                                         \
+            return NULL;                                                       \
+                                                                               \
+        return &(iter->target->map[iter->block][iter->offset]);                \
+    }                                                                          \
+                                                                               \
+    size_t PFX##_iter_index(struct SNAME##_iter *iter)                         \
+    {                                                                          \
+        return iter->index;                                                    \
+    }                                                                          \
+                                                                               \
+    /* Address of the element at the given index */                            \
+    static V *PFX##_impl_at(struct SNAME *_deque_, size_t index)               \
+    {                                                                          \
+        size_t position = _deque_->front + index;                              \
+                                                                               \
+        return _deque_->map[_deque_->first +                                   \
+                            position / CMC_SEGDEQUE_BLOCK_SIZE(V)] +           \
+               position % CMC_SEGDEQUE_BLOCK_SIZE(V);                          \
+    }                                                                          \
+                                                                               \
+    /* Allocates the block at the given index of the map if there is none */   \
+    static bool PFX##_impl_block(struct SNAME *_deque_, size_t index)          \
+    {                                                                          \
+        if (_deque_->map[index])                                               \
+            return true;                                                       \
+                                                                               \
+        V *block =                                                             \
+            _deque_->alloc->malloc(sizeof(V) * CMC_SEGDEQUE_BLOCK_SIZE(V));    \
+                                                                               \
+        if (!block)                                                            \
+        {                                                                      \
+            _deque_->flag = cmc_flags.ALLOC;                                   \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        _deque_->map[index] = block;                                           \
+        _deque_->capacity += CMC_SEGDEQUE_BLOCK_SIZE(V);                       \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Moves the blocks to a new map, centering the ones in use. The blocks */ \
+    /* that are not in use are placed after them and then before them. The */  \
+    /* new map must have room for every allocated block. */                    \
+    static bool PFX##_impl_remap(struct SNAME *_deque_, size_t map_capacity)   \
+    {                                                                          \
+        V **new_map = _deque_->alloc->calloc(map_capacity, sizeof(V *));       \
+                                                                               \
+        if (!new_map)                                                          \
+        {                                                                      \
+            _deque_->flag = cmc_flags.ALLOC;                                   \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        size_t first = (map_capacity - _deque_->blocks) / 2;                   \
+                                                                               \
+        memcpy(new_map + first, _deque_->map + _deque_->first,                 \
+               sizeof(V *) * _deque_->blocks);                                 \
+                                                                               \
+        size_t after = first + _deque_->blocks;                                \
+        size_t before = first;                                                 \
+                                                                               \
+        for (size_t i = 0; i < _deque_->map_capacity; i++)                     \
+        {                                                                      \
+            if (i >= _deque_->first && i < _deque_->first + _deque_->blocks)   \
+                continue;                                                      \
+                                                                               \
+            if (!_deque_->map[i])                                              \
+                continue;                                                      \
+                                                                               \
+            if (after < map_capacity)                                          \
+                new_map[after++] = _deque_->map[i];                            \
+            else                                                               \
+                new_map[--before] = _deque_->map[i];                           \
+        }                                                                      \
+                                                                               \
+        _deque_->alloc->free(_deque_->map);                                    \
+                                                                               \
+        _deque_->map = new_map;                                                \
+        _deque_->map_capacity = map_capacity;                                  \
+        _deque_->first = first;                                                \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Makes room in the map for a block on both sides of the ones in use */   \
+    static bool PFX##_impl_grow_map(struct SNAME *_deque_)                     \
+    {                                                                          \
+        size_t map_capacity = _deque_->map_capacity;                           \
+                                                                               \
+        /* The map is only reallocated to a bigger one if more than half of */ \
+        /* it is in use, otherwise the blocks are just centered */             \
+        if (_deque_->blocks > map_capacity / 2)                                \
+        {                                                                      \
+            map_capacity = cmc_growth_capacity(_deque_->growth, map_capacity,  \
+                                               _deque_->blocks + 2);           \
+        }                                                                      \
+                                                                               \
+        return PFX##_impl_remap(_deque_, map_capacity);                        \
+    }                                                                          \
+                                                                               \
+    /* Positions the iterator at the given index */                            \
+    static void PFX##_impl_iter_seek(struct SNAME##_iter *iter, size_t index)  \
+    {                                                                          \
+        size_t position = iter->target->front + index;                         \
+                                                                               \
+        iter->block =                                                          \
+            iter->target->first + position / CMC_SEGDEQUE_BLOCK_SIZE(V);       \
+        iter->offset = position % CMC_SEGDEQUE_BLOCK_SIZE(V);                  \
+        iter->index = index;                                                   \
+    }
+
+#endif /* CMC_SEGDEQUE_H */
@@ -0,0 +1,1228 @@
+/**
+ * smallvec.h
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * SmallVec
+ *
+ * A SmallVec is a List (see list.h) that has room for N elements inside its
+ * own structure. While it holds up to N elements they are stored inline and no
+ * buffer is allocated, so creating a SmallVec takes a single allocation (or
+ * none, when it is used by value with init and release) and its elements are
+ * in the same cache lines as the rest of the structure. Once the elements
+ * spill past N they are moved to a buffer in the heap that grows just like the
+ * buffer of a List. Resizing it back to N or less moves them inline again.
+ *
+ * The inline storage is located through the capacity, which is N while the
+ * elements are inline, instead of through a pointer to the structure itself.
+ * That way a SmallVec can be copied or returned by value, as init does.
+ *
+ * It has the same functions as a List and they behave the same way, with the
+ * exception that the capacity is never smaller than N.
+ */
+
+#ifndef CMC_SMALLVEC_H
+#define CMC_SMALLVEC_H
+
+/* -------------------------------------------------------------------------
+ * Core functionalities of the C Macro Collections Library
+ * ------------------------------------------------------------------------- */
+#include "../cor/core.h"
+#include "../cor/search.h"
+#include "../cor/sort.h"
+
+/* -------------------------------------------------------------------------
+ * SmallVec specific
+ * ------------------------------------------------------------------------- */
+/* to_string format */
+static const char *cmc_string_fmt_smallvec = "struct %s<%s> "
+                                             "at %p { "
+                                             "buffer:%p, "
+                                             "inline:%d, "
+                                             "capacity:%" PRIuMAX ", "
+                                             "count:%" PRIuMAX ", "
+                                             "flag:%d, "
+                                             "f_val:%p, "
+                                             "alloc:%p, "
+                                             "callbacks:%p }";
+
+/* N is the amount of elements stored inline and it must be at least 1 */
+#define CMC_GENERATE_SMALLVEC(PFX, SNAME, V, N)    \
+    CMC_GENERATE_SMALLVEC_HEADER(PFX, SNAME, V, N) \
+    CMC_GENERATE_SMALLVEC_SOURCE(PFX, SNAME, V, N)
+
+/* Generates a SmallVec of plain old data, which is searched by comparing the */
+/* bytes of the elements instead of calling the comparator (see cor/search.h) */
+#define CMC_GENERATE_SMALLVEC_POD(PFX, SNAME, V, N) \
+    CMC_GENERATE_SMALLVEC_HEADER(PFX, SNAME, V, N)  \
+    CMC_GENERATE_SMALLVEC_SOURCE_POD(PFX, SNAME, V, N)
+
+/* -------------------------------------------------------------------------
+ * Header
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_SMALLVEC_HEADER(PFX, SNAME, V, N)                      \
+                                                                            \
+    /* SmallVec Structure */                                                \
+    struct SNAME                                                            \
+    {                                                                       \
+        /* Heap buffer, only used when the capacity is greater than N */    \
+        V *buffer;                                                          \
+                                                                            \
+        /* Current capacity, which is N while the elements are inline */    \
+        size_t capacity;                                                    \
+                                                                            \
+        /* Current amount of elements */                                    \
+        size_t count;                                                       \
+                                                                            \
+        /* Flags indicating errors or success */                            \
+        int flag;                                                           \
+                                                                            \
+        /* Value function table */                                          \
+        struct SNAME##_fval *f_val;                                         \
+                                                                            \
+        /* Custom allocation functions */                                   \
+        struct cmc_alloc_node *alloc;                                       \
+                                                                            \
+        /* Custom callback functions */                                     \
+        struct cmc_callbacks *callbacks;                                    \
+                                                                            \
+        /* Growth policy of the buffer */                                   \
+        const struct cmc_growth *growth;                                    \
+                                                                            \
+        /* Inline storage, used when the capacity is N */                   \
+        V storage[N];                                                       \
+    };                                                                      \
+                                                                            \
+    /* Value struct function table */                                       \
+    struct SNAME##_fval                                                     \
+    {                                                                       \
+        /* Comparator function */                                           \
+        int (*cmp)(V, V);                                                   \
+                                                                            \
+        /* Copy function */                                                 \
+        V (*cpy)(V);                                                        \
+                                                                            \
+        /* To string function */                                            \
+        bool (*str)(FILE *, V);                                             \
+                                                                            \
+        /* Free from memory function */                                     \
+        void (*free)(V);                                                    \
+                                                                            \
+        /* Hash function */                                                 \
+        size_t (*hash)(V);                                                  \
+                                                                            \
+        /* Priority function */                                             \
+        int (*pri)(V, V);                                                   \
+    };                                                                      \
+                                                                            \
+    /* SmallVec Iterator */                                                 \
+    struct SNAME##_iter                                                     \
+    {                                                                       \
+        /* Target smallvec */                                               \
+        struct SNAME *target;                                               \
+                                                                            \
+        /* Cursor's position (index) */                                     \
+        size_t cursor;                                                      \
+                                                                            \
+        /* If the iterator has reached the start of the iteration */        \
+        bool start;                                                         \
+                                                                            \
+        /* If the iterator has reached the end of the iteration */          \
+        bool end;                                                           \
+    };                                                                      \
+                                                                            \
+    /* Collection Functions */                                              \
+    /* Collection Allocation and Deallocation */                            \
+    struct SNAME *PFX##_new(size_t capacity, struct SNAME##_fval *f_val);   \
+    struct SNAME *PFX##_new_custom(                                         \
+        size_t capacity, struct SNAME##_fval *f_val,                        \
+        struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks);     \
+    struct SNAME PFX##_init(size_t capacity, struct SNAME##_fval *f_val);   \
+    struct SNAME PFX##_init_custom(                                         \
+        size_t capacity, struct SNAME##_fval *f_val,                        \
+        struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks);     \
+    void PFX##_clear(struct SNAME *_vec_);                                  \
+    void PFX##_free(struct SNAME *_vec_);                                   \
+    void PFX##_release(struct SNAME _vec_);                                 \
+    /* Customization of Allocation and Callbacks */                         \
+    void PFX##_customize(struct SNAME *_vec_, struct cmc_alloc_node *alloc, \
+                         struct cmc_callbacks *callbacks);                  \
+    void PFX##_set_growth(struct SNAME *_vec_,                              \
+                          const struct cmc_growth *growth);                 \
+    /* Collection Input and Output */                                       \
+    bool PFX##_push_front(struct SNAME *_vec_, V value);                    \
+    bool PFX##_push_at(struct SNAME *_vec_, V value, size_t index);         \
+    bool PFX##_push_back(struct SNAME *_vec_, V value);                     \
+    bool PFX##_pop_front(struct SNAME *_vec_);                              \
+    bool PFX##_pop_at(struct SNAME *_vec_, size_t index);                   \
+    bool PFX##_pop_back(struct SNAME *_vec_);                               \
+    /* Collection Sequence Input and Output */                              \
+    bool PFX##_seq_push_front(struct SNAME *_vec_, V *values, size_t size); \
+    bool PFX##_seq_push_at(struct SNAME *_vec_, V *values, size_t size,     \
+                           size_t index);                                   \
+    bool PFX##_seq_push_back(struct SNAME *_vec_, V *values, size_t size);  \
+    bool PFX##_seq_pop_at(struct SNAME *_vec_, size_t from, size_t to);     \
+    struct SNAME *PFX##_seq_sublist(struct SNAME *_vec_, size_t from,       \
+                                    size_t to);                             \
+    /* Element Access */                                                    \
+    V PFX##_front(struct SNAME *_vec_);                                     \
+    V PFX##_get(struct SNAME *_vec_, size_t index);                         \
+    V *PFX##_get_ref(struct SNAME *_vec_, size_t index);                    \
+    V PFX##_back(struct SNAME *_vec_);                                      \
+    size_t PFX##_index_of(struct SNAME *_vec_, V value, bool from_start);   \
+    /* Collection State */                                                  \
+    bool PFX##_contains(struct SNAME *_vec_, V value);                      \
+    bool PFX##_empty(struct SNAME *_vec_);                                  \
+    bool PFX##_full(struct SNAME *_vec_);                                   \
+    size_t PFX##_count(struct SNAME *_vec_);                                \
+    bool PFX##_fits(struct SNAME *_vec_, size_t size);                      \
+    size_t PFX##_capacity(struct SNAME *_vec_);                             \
+    bool PFX##_is_inline(struct SNAME *_vec_);                              \
+    int PFX##_flag(struct SNAME *_vec_);                                    \
+    /* Collection Utility */                                                \
+    bool PFX##_resize(struct SNAME *_vec_, size_t capacity);                \
+    bool PFX##_reserve(struct SNAME *_vec_, size_t size);                   \
+    bool PFX##_shrink_to_fit(struct SNAME *_vec_);                          \
+    void PFX##_sort(struct SNAME *_vec_);                                   \
+    bool PFX##_sort_range(struct SNAME *_vec_, size_t from, size_t to);     \
+    struct SNAME *PFX##_copy_of(struct SNAME *_vec_);                       \
+    bool PFX##_equals(struct SNAME *_vec1_, struct SNAME *_vec2_);          \
+    struct cmc_string PFX##_to_string(struct SNAME *_vec_);                 \
+    bool PFX##_print(struct SNAME *_vec_, FILE *fptr);                      \
+                                                                            \
+    /* Iterator Functions */                                                \
+    /* Iterator Initialization */                                           \
+    struct SNAME##_iter PFX##_iter_start(struct SNAME *target);             \
+    struct SNAME##_iter PFX##_iter_end(struct SNAME *target);               \
+    /* Iterator State */                                                    \
+    bool PFX##_iter_at_start(struct SNAME##_iter *iter);                    \
+    bool PFX##_iter_at_end(struct SNAME##_iter *iter);                      \
+    /* Iterator Movement */                                                 \
+    bool PFX##_iter_to_start(struct SNAME##_iter *iter);                    \
+    bool PFX##_iter_to_end(struct SNAME##_iter *iter);                      \
+    bool PFX##_iter_next(struct SNAME##_iter *iter);                        \
+    bool PFX##_iter_prev(struct SNAME##_iter *iter);                        \
+    bool PFX##_iter_advance(struct SNAME##_iter *iter, size_t steps);       \
+    bool PFX##_iter_rewind(struct SNAME##_iter *iter, size_t steps);        \
+    bool PFX##_iter_go_to(struct SNAME##_iter *iter, size_t index);         \
+    /* Iterator Access */                                                   \
+    V PFX##_iter_value(struct SNAME##_iter *iter);                          \
+    V *PFX##_iter_rvalue(struct SNAME##_iter *iter);                        \
+    size_t PFX##_iter_index(struct SNAME##_iter *iter);
+
+/* -------------------------------------------------------------------------
+ * Source
+ * ------------------------------------------------------------------------- */
+/* Just like in list.h, the source is made of the search, the core functions */
+/* and the sort */
+#define CMC_GENERATE_SMALLVEC_SOURCE(PFX, SNAME, V, N)  \
+    CMC_GENERATE_SEARCH(PFX, V)                         \
+    CMC_GENERATE_SMALLVEC_CORE_SOURCE(PFX, SNAME, V, N) \
+    CMC_GENERATE_SMALLVEC_SORT_SOURCE(PFX, SNAME, V)
+
+#define CMC_GENERATE_SMALLVEC_SOURCE_POD(PFX, SNAME, V, N) \
+    CMC_GENERATE_SEARCH_POD(PFX, V)                        \
+    CMC_GENERATE_SMALLVEC_CORE_SOURCE(PFX, SNAME, V, N)    \
+    CMC_GENERATE_SMALLVEC_SORT_SOURCE(PFX, SNAME, V)
+
+#define CMC_GENERATE_SMALLVEC_CORE_SOURCE(PFX, SNAME, V, N)                   \
+                                                                              \
+    /* Implementation Detail Functions */                                     \
+    static V *PFX##_impl_buffer(struct SNAME *_vec_);                         \
+    static void PFX##_impl_sort_array(struct SNAME *_vec_, V *array,          \
+                                      size_t count);                          \
+                                                                              \
+    struct SNAME *PFX##_new(size_t capacity, struct SNAME##_fval *f_val)      \
+    {                                                                         \
+        return PFX##_new_custom(capacity, f_val, NULL, NULL);                 \
+    }                                                                         \
+                                                                              \
+    struct SNAME *PFX##_new_custom(                                           \
+        size_t capacity, struct SNAME##_fval *f_val,                          \
+        struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks)        \
+    {                                                                         \
+        if (!alloc)                                                           \
+            alloc = &cmc_alloc_node_default;                                  \
+                                                                              \
+        struct SNAME *_vec_ = alloc->malloc(sizeof(struct SNAME));            \
+                                                                              \
+        if (!_vec_)                                                           \
+            return NULL;                                                      \
+                                                                              \
+        *_vec_ = PFX##_init_custom(capacity, f_val, alloc, callbacks);        \
+                                                                              \
+        if (!_vec_->f_val)                                                    \
+        {                                                                     \
+            alloc->free(_vec_);                                               \
+            return NULL;                                                      \
+        }                                                                     \
+                                                                              \
+        return _vec_;                                                         \
+    }                                                                         \
+                                                                              \
+    struct SNAME PFX##_init(size_t capacity, struct SNAME##_fval *f_val)      \
+    {                                                                         \
+        return PFX##_init_custom(capacity, f_val, NULL, NULL);                \
+    }                                                                         \
+                                                                              \
+    /* On failure the returned smallvec is zeroed, having f_val as NULL */    \
+    struct SNAME PFX##_init_custom(                                           \
+        size_t capacity, struct SNAME##_fval *f_val,                          \
+        struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks)        \
+    {                                                                         \
+        struct SNAME _vec_ = { 0 };                                           \
+                                                                              \
+        if (capacity < 1)                                                     \
+            return _vec_;                                                     \
+                                                                              \
+        if (!f_val)                                                           \
+            return _vec_;                                                     \
+                                                                              \
+        if (!alloc)                                                           \
+            alloc = &cmc_alloc_node_default;                                  \
+                                                                              \
+        if (capacity > N)                                                     \
+        {                                                                     \
+            _vec_.buffer = alloc->calloc(capacity, sizeof(V));                \
+                                                                              \
+            if (!_vec_.buffer)                                                \
+                return _vec_;                                                 \
+        }                                                                     \
+        else                                                                  \
+            capacity = N;                                                     \
+                                                                              \
+        _vec_.capacity = capacity;                                            \
+        _vec_.count = 0;                                                      \
+        _vec_.flag = cmc_flags.OK;                                            \
+        _vec_.f_val = f_val;                                                  \
+        _vec_.alloc = alloc;                                                  \
+        _vec_.callbacks = callbacks;                                          \
+        _vec_.growth = NULL;                                                  \
+                                                                              \
+        return _vec_;                                                         \
+    }                                                                         \
+                                                                              \
+    void PFX##_clear(struct SNAME *_vec_)                                     \
+    {                                                                         \
+        V *buffer = PFX##_impl_buffer(_vec_);                                 \
+                                                                              \
+        if (_vec_->f_val->free)                                               \
+        {                                                                     \
+            for (size_t i = 0; i < _vec_->count; i++)                         \
+                _vec_->f_val->free(buffer[i]);                                \
+        }                                                                     \
+                                                                              \
+        memset(buffer, 0, sizeof(V) * _vec_->capacity);                       \
+                                                                              \
+        _vec_->count = 0;                                                     \
+        _vec_->flag = cmc_flags.OK;                                           \
+    }                                                                         \
+                                                                              \
+    void PFX##_free(struct SNAME *_vec_)                                      \
+    {                                                                         \
+        PFX##_release(*_vec_);                                                \
+                                                                              \
+        _vec_->alloc->free(_vec_);                                            \
+    }                                                                         \
+                                                                              \
+    void PFX##_release(struct SNAME _vec_)                                    \
+    {                                                                         \
+        V *buffer = PFX##_impl_buffer(&_vec_);                                \
+                                                                              \
+        if (_vec_.f_val->free)                                                \
+        {                                                                     \
+            for (size_t i = 0; i < _vec_.count; i++)                          \
+                _vec_.f_val->free(buffer[i]);                                 \
+        }                                                                     \
+                                                                              \
+        if (_vec_.capacity > N)                                               \
+            _vec_.alloc->free(_vec_.buffer);                                  \
+    }                                                                         \
+                                                                              \
+    void PFX##_customize(struct SNAME *_vec_, struct cmc_alloc_node *alloc,   \
+                         struct cmc_callbacks *callbacks)                     \
+    {                                                                         \
+        if (!alloc)                                                           \
+            _vec_->alloc = &cmc_alloc_node_default;                           \
+        else                                                                  \
+            _vec_->alloc = alloc;                                             \
+                                                                              \
+        _vec_->callbacks = callbacks;                                         \
+                                                                              \
+        _vec_->flag = cmc_flags.OK;                                           \
+    }                                                                         \
+                                                                              \
+    /* Sets the growth policy used when the buffer is full (NULL for the */   \
+    /* default one) */                                                        \
+    void PFX##_set_growth(struct SNAME *_vec_,                                \
+                          const struct cmc_growth *growth)                    \
+    {                                                                         \
+        _vec_->growth = growth;                                               \
+                                                                              \
+        _vec_->flag = cmc_flags.OK;                                           \
+    }                                                                         \
+                                                                              \
+    bool PFX##_push_front(struct SNAME *_vec_, V value)                       \
+    {                                                                         \
+        if (PFX##_full(_vec_))                                                \
+        {                                                                     \
+            if (!PFX##_reserve(_vec_, 1))                                     \
+                return false;                                                 \
+        }                                                                     \
+                                                                              \
+        V *buffer = PFX##_impl_buffer(_vec_);                                 \
+                                                                              \
+        if (!PFX##_empty(_vec_))                                              \
+            memmove(buffer + 1, buffer, _vec_->count * sizeof(V));            \
+                                                                              \
+        buffer[0] = value;                                                    \
+                                                                              \
+        _vec_->count++;                                                       \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        if (_vec_->callbacks && _vec_->callbacks->create)                     \
+            _vec_->callbacks->create();                                       \
+                                                                              \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    bool PFX##_push_at(struct SNAME *_vec_, V value, size_t index)            \
+    {                                                                         \
+        if (index > _vec_->count)                                             \
+        {                                                                     \
+            _vec_->flag = cmc_flags.RANGE;                                    \
+            return false;                                                     \
+        }                                                                     \
+                                                                              \
+        if (PFX##_full(_vec_))                                                \
+        {                                                                     \
+            if (!PFX##_reserve(_vec_, 1))                                     \
+                return false;                                                 \
+        }                                                                     \
+                                                                              \
+        V *buffer = PFX##_impl_buffer(_vec_);                                 \
+                                                                              \
+        memmove(buffer + index + 1, buffer + index,                           \
+                (_vec_->count - index) * sizeof(V));                          \
+                                                                              \
+        buffer[index] = value;                                                \
+        _vec_->count++;                                                       \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        if (_vec_->callbacks && _vec_->callbacks->create)                     \
+            _vec_->callbacks->create();                                       \
+                                                                              \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    bool PFX##_push_back(struct SNAME *_vec_, V value)                        \
+    {                                                                         \
+        if (PFX##_full(_vec_))                                                \
+        {                                                                     \
+            if (!PFX##_reserve(_vec_, 1))                                     \
+                return false;                                                 \
+        }                                                                     \
+                                                                              \
+        PFX##_impl_buffer(_vec_)[_vec_->count++] = value;                     \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        if (_vec_->callbacks && _vec_->callbacks->create)                     \
+            _vec_->callbacks->create();                                       \
+                                                                              \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    bool PFX##_pop_front(struct SNAME *_vec_)                                 \
+    {                                                                         \
+        if (PFX##_empty(_vec_))                                               \
+        {                                                                     \
+            _vec_->flag = cmc_flags.EMPTY;                                    \
+            return false;                                                     \
+        }                                                                     \
+                                                                              \
+        V *buffer = PFX##_impl_buffer(_vec_);                                 \
+                                                                              \
+        memmove(buffer, buffer + 1, (_vec_->count - 1) * sizeof(V));          \
+                                                                              \
+        buffer[--_vec_->count] = (V){ 0 };                                    \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        if (_vec_->callbacks && _vec_->callbacks->delete)                     \
+            _vec_->callbacks->delete ();                                      \
+                                                                              \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    bool PFX##_pop_at(struct SNAME *_vec_, size_t index)                      \
+    {                                                                         \
+        if (PFX##_empty(_vec_))                                               \
+        {                                                                     \
+            _vec_->flag = cmc_flags.EMPTY;                                    \
+            return false;                                                     \
+        }                                                                     \
+                                                                              \
+        if (index >= _vec_->count)                                            \
+        {                                                                     \
+            _vec_->flag = cmc_flags.RANGE;                                    \
+            return false;                                                     \
+        }                                                                     \
+                                                                              \
+        V *buffer = PFX##_impl_buffer(_vec_);                                 \
+                                                                              \
+        memmove(buffer + index, buffer + index + 1,                           \
+                (_vec_->count - index - 1) * sizeof(V));                      \
+                                                                              \
+        buffer[--_vec_->count] = (V){ 0 };                                    \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        if (_vec_->callbacks && _vec_->callbacks->delete)                     \
+            _vec_->callbacks->delete ();                                      \
+                                                                              \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    bool PFX##_pop_back(struct SNAME *_vec_)                                  \
+    {                                                                         \
+        if (PFX##_empty(_vec_))                                               \
+        {                                                                     \
+            _vec_->flag = cmc_flags.EMPTY;                                    \
+            return false;                                                     \
+        }                                                                     \
+                                                                              \
+        PFX##_impl_buffer(_vec_)[--_vec_->count] = (V){ 0 };                  \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        if (_vec_->callbacks && _vec_->callbacks->delete)                     \
+            _vec_->callbacks->delete ();                                      \
+                                                                              \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    bool PFX##_seq_push_front(struct SNAME *_vec_, V *values, size_t size)    \
+    {                                                                         \
+        if (size == 0)                                                        \
+        {                                                                     \
+            _vec_->flag = cmc_flags.INVALID;                                  \
+            return false;                                                     \
+        }                                                                     \
+                                                                              \
+        if (!PFX##_fits(_vec_, size))                                         \
+        {                                                                     \
+            if (!PFX##_reserve(_vec_, size))                                  \
+                return false;                                                 \
+        }                                                                     \
+                                                                              \
+        V *buffer = PFX##_impl_buffer(_vec_);                                 \
+                                                                              \
+        memmove(buffer + size, buffer, _vec_->count * sizeof(V));             \
+                                                                              \
+        memcpy(buffer, values, size * sizeof(V));                             \
+                                                                              \
+        _vec_->count += size;                                                 \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        if (_vec_->callbacks && _vec_->callbacks->create)                     \
+            _vec_->callbacks->create();                                       \
+                                                                              \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    bool PFX##_seq_push_at(struct SNAME *_vec_, V *values, size_t size,       \
+                           size_t index)                                      \
+    {                                                                         \
+        if (size == 0)                                                        \
+        {                                                                     \
+            _vec_->flag = cmc_flags.INVALID;                                  \
+            return false;                                                     \
+        }                                                                     \
+                                                                              \
+        if (index > _vec_->count)                                             \
+        {                                                                     \
+            _vec_->flag = cmc_flags.RANGE;                                    \
+            return false;                                                     \
+        }                                                                     \
+                                                                              \
+        if (index == 0)                                                       \
+            return PFX##_seq_push_front(_vec_, values, size);                 \
+        else if (index == _vec_->count)                                       \
+            return PFX##_seq_push_back(_vec_, values, size);                  \
+                                                                              \
+        if (!PFX##_fits(_vec_, size))                                         \
+        {                                                                     \
+            if (!PFX##_reserve(_vec_, size))                                  \
+                return false;                                                 \
+        }                                                                     \
+                                                                              \
+        V *buffer = PFX##_impl_buffer(_vec_);                                 \
+                                                                              \
+        memmove(buffer + index + size, buffer + index,                        \
+                (_vec_->count - index) * sizeof(V));                          \
+                                                                              \
+        memcpy(buffer + index, values, size * sizeof(V));                     \
+                                                                              \
+        _vec_->count += size;                                                 \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        if (_vec_->callbacks && _vec_->callbacks->create)                     \
+            _vec_->callbacks->create();                                       \
+                                                                              \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    bool PFX##_seq_push_back(struct SNAME *_vec_, V *values, size_t size)     \
+    {                                                                         \
+        if (size == 0)                                                        \
+        {                                                                     \
+            _vec_->flag = cmc_flags.INVALID;                                  \
+            return false;                                                     \
+        }                                                                     \
+                                                                              \
+        if (!PFX##_fits(_vec_, size))                                         \
+        {                                                                     \
+            if (!PFX##_reserve(_vec_, size))                                  \
+                return false;                                                 \
+        }                                                                     \
+                                                                              \
+        memcpy(PFX##_impl_buffer(_vec_) + _vec_->count, values,               \
+               size * sizeof(V));                                             \
+                                                                              \
+        _vec_->count += size;                                                 \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        if (_vec_->callbacks && _vec_->callbacks->create)                     \
+            _vec_->callbacks->create();                                       \
+                                                                              \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    bool PFX##_seq_pop_at(struct SNAME *_vec_, size_t from, size_t to)        \
+    {                                                                         \
+        if (from > to)                                                        \
+        {                                                                     \
+            _vec_->flag = cmc_flags.INVALID;                                  \
+            return false;                                                     \
+        }                                                                     \
+                                                                              \
+        if (to >= _vec_->count)                                               \
+        {                                                                     \
+            _vec_->flag = cmc_flags.RANGE;                                    \
+            return false;                                                     \
+        }                                                                     \
+                                                                              \
+        V *buffer = PFX##_impl_buffer(_vec_);                                 \
+        size_t length = (to - from + 1);                                      \
+                                                                              \
+        memmove(buffer + from, buffer + to + 1,                               \
+                (_vec_->count - to - 1) * sizeof(V));                         \
+                                                                              \
+        memset(buffer + _vec_->count - length, 0, length * sizeof(V));        \
+                                                                              \
+        _vec_->count -= length;                                               \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        if (_vec_->callbacks && _vec_->callbacks->delete)                     \
+            _vec_->callbacks->delete ();                                      \
+                                                                              \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    struct SNAME *PFX##_seq_sublist(struct SNAME *_vec_, size_t from,         \
+                                    size_t to)                                \
+    {                                                                         \
+        if (from > to)                                                        \
+        {                                                                     \
+            _vec_->flag = cmc_flags.INVALID;                                  \
+            return NULL;                                                      \
+        }                                                                     \
+                                                                              \
+        if (to >= _vec_->count)                                               \
+        {                                                                     \
+            _vec_->flag = cmc_flags.RANGE;                                    \
+            return NULL;                                                      \
+        }                                                                     \
+                                                                              \
+        size_t length = to - from + 1;                                        \
+                                                                              \
+        struct SNAME *result = PFX##_new_custom(                              \
+            length, _vec_->f_val, _vec_->alloc, _vec_->callbacks);            \
+                                                                              \
+        if (!result)                                                          \
+        {                                                                     \
+            _vec_->flag = cmc_flags.ALLOC;                                    \
+            return NULL;                                                      \
+        }                                                                     \
+                                                                              \
+        V *buffer = PFX##_impl_buffer(_vec_);                                 \
+                                                                              \
+        memcpy(PFX##_impl_buffer(result), buffer + from, length * sizeof(V)); \
+                                                                              \
+        memmove(buffer + from, buffer + to + 1,                               \
+                (_vec_->count - to - 1) * sizeof(V));                         \
+                                                                              \
+        memset(buffer + _vec_->count - length, 0, length * sizeof(V));        \
+                                                                              \
+        _vec_->count -= length;                                               \
+        result->count = length;                                               \
+                                                                              \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        if (_vec_->callbacks && _vec_->callbacks->delete)                     \
+            _vec_->callbacks->delete ();                                      \
+                                                                              \
+        return result;                                                        \
+    }                                                                         \
+                                                                              \
+    V PFX##_front(struct SNAME *_vec_)                                        \
+    {                                                                         \
+        if (PFX##_empty(_vec_))                                               \
+        {                                                                     \
+            _vec_->flag = cmc_flags.EMPTY;                                    \
+            return (V){ 0 };                                                  \
+        }                                                                     \
+                                                                              \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        if (_vec_->callbacks && _vec_->callbacks->read)                       \
+            _vec_->callbacks->read();                                         \
+                                                                              \
+        return PFX##_impl_buffer(_vec_)[0];                                   \
+    }                                                                         \
+                                                                              \
+    V PFX##_get(struct SNAME *_vec_, size_t index)                            \
+    {                                                                         \
+        if (PFX##_empty(_vec_))                                               \
+        {                                                                     \
+            _vec_->flag = cmc_flags.EMPTY;                                    \
+            return (V){ 0 };                                                  \
+        }                                                                     \
+                                                                              \
+        if (index >= _vec_->count)                                            \
+        {                                                                     \
+            _vec_->flag = cmc_flags.RANGE;                                    \
+            return (V){ 0 };                                                  \
+        }                                                                     \
+                                                                              \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        if (_vec_->callbacks && _vec_->callbacks->read)                       \
+            _vec_->callbacks->read();                                         \
+                                                                              \
+        return PFX##_impl_buffer(_vec_)[index];                               \
+    }                                                                         \
+                                                                              \
+    V *PFX##_get_ref(struct SNAME *_vec_, size_t index)                       \
+    {                                                                         \
+        if (PFX##_empty(_vec_))                                               \
+        {                                                                     \
+            _vec_->flag = cmc_flags.EMPTY;                                    \
+            return NULL;                                                      \
+        }                                                                     \
+                                                                              \
+        if (index >= _vec_->count)                                            \
+        {                                                                     \
+            _vec_->flag = cmc_flags.RANGE;                                    \
+            return NULL;                                                      \
+        }                                                                     \
+                                                                              \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        if (_vec_->callbacks && _vec_->callbacks->read)                       \
+            _vec_->callbacks->read();                                         \
+                                                                              \
+        return &(PFX##_impl_buffer(_vec_)[index]);                            \
+    }                                                                         \
+                                                                              \
+    V PFX##_back(struct SNAME *_vec_)                                         \
+    {                                                                         \
+        if (PFX##_empty(_vec_))                                               \
+        {                                                                     \
+            _vec_->flag = cmc_flags.EMPTY;                                    \
+            return (V){ 0 };                                                  \
+        }                                                                     \
+                                                                              \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        if (_vec_->callbacks && _vec_->callbacks->read)                       \
+            _vec_->callbacks->read();                                         \
+                                                                              \
+        return PFX##_impl_buffer(_vec_)[_vec_->count - 1];                    \
+    }                                                                         \
+                                                                              \
+    size_t PFX##_index_of(struct SNAME *_vec_, V value, bool from_start)      \
+    {                                                                         \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        V *buffer = PFX##_impl_buffer(_vec_);                                 \
+        size_t result;                                                        \
+                                                                              \
+        if (from_start)                                                       \
+            result = PFX##_impl_search(buffer, _vec_->count, value,           \
+                                       _vec_->f_val->cmp);                    \
+        else                                                                  \
+            result = PFX##_impl_search_last(buffer, _vec_->count, value,      \
+                                            _vec_->f_val->cmp);               \
+                                                                              \
+        if (_vec_->callbacks && _vec_->callbacks->read)                       \
+            _vec_->callbacks->read();                                         \
+                                                                              \
+        return result;                                                        \
+    }                                                                         \
+                                                                              \
+    bool PFX##_contains(struct SNAME *_vec_, V value)                         \
+    {                                                                         \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        bool result =                                                         \
+            PFX##_impl_search(PFX##_impl_buffer(_vec_), _vec_->count, value,  \
+                              _vec_->f_val->cmp) < _vec_->count;              \
+                                                                              \
+        if (_vec_->callbacks && _vec_->callbacks->read)                       \
+            _vec_->callbacks->read();                                         \
+                                                                              \
+        return result;                                                        \
+    }                                                                         \
+                                                                              \
+    bool PFX##_empty(struct SNAME *_vec_)                                     \
+    {                                                                         \
+        return _vec_->count == 0;                                             \
+    }                                                                         \
+                                                                              \
+    bool PFX##_full(struct SNAME *_vec_)                                      \
+    {                                                                         \
+        return _vec_->count >= _vec_->capacity;                               \
+    }                                                                         \
+                                                                              \
+    size_t PFX##_count(struct SNAME *_vec_)                                   \
+    {                                                                         \
+        return _vec_->count;                                                  \
+    }                                                                         \
+                                                                              \
+    bool PFX##_fits(struct SNAME *_vec_, size_t size)                         \
+    {                                                                         \
+        return _vec_->count + size <= _vec_->capacity;                        \
+    }                                                                         \
+                                                                              \
+    size_t PFX##_capacity(struct SNAME *_vec_)                                \
+    {                                                                         \
+        return _vec_->capacity;                                               \
+    }                                                                         \
+                                                                              \
+    /* Returns true if the elements are stored inside the structure */        \
+    bool PFX##_is_inline(struct SNAME *_vec_)                                 \
+    {                                                                         \
+        return _vec_->capacity <= N;                                          \
+    }                                                                         \
+                                                                              \
+    int PFX##_flag(struct SNAME *_vec_)                                       \
+    {                                                                         \
+        return _vec_->flag;                                                   \
+    }                                                                         \
+                                                                              \
+    /* Capacities smaller than N are rounded up to N, which moves the */      \
+    /* elements back to the inline storage */                                 \
+    bool PFX##_resize(struct SNAME *_vec_, size_t capacity)                   \
+    {                                                                         \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        if (capacity < N)                                                     \
+            capacity = N;                                                     \
+                                                                              \
+        if (_vec_->capacity == capacity)                                      \
+            return true;                                                      \
+                                                                              \
+        if (capacity < _vec_->count)                                          \
+        {                                                                     \
+            _vec_->flag = cmc_flags.INVALID;                                  \
+            return false;                                                     \
+        }                                                                     \
+                                                                              \
+        if (capacity == N)                                                    \
+        {                                                                     \
+            memcpy(_vec_->storage, _vec_->buffer, sizeof(V) * _vec_->count);  \
+            memset(_vec_->storage + _vec_->count, 0,                          \
+                   sizeof(V) * (N - _vec_->count));                           \
+                                                                              \
+            _vec_->alloc->free(_vec_->buffer);                                \
+            _vec_->buffer = NULL;                                             \
+        }                                                                     \
+        else if (_vec_->capacity == N)                                        \
+        {                                                                     \
+            V *new_buffer = _vec_->alloc->malloc(sizeof(V) * capacity);       \
+                                                                              \
+            if (!new_buffer)                                                  \
+            {                                                                 \
+                _vec_->flag = cmc_flags.ALLOC;                                \
+                return false;                                                 \
+            }                                                                 \
+                                                                              \
+            memcpy(new_buffer, _vec_->storage, sizeof(V) * _vec_->count);     \
+                                                                              \
+            _vec_->buffer = new_buffer;                                       \
+        }                                                                     \
+        else                                                                  \
+        {                                                                     \
+            V *new_buffer =                                                   \
+                _vec_->alloc->realloc(_vec_->buffer, sizeof(V) * capacity);   \
+                                                                              \
+            if (!new_buffer)                                                  \
+            {                                                                 \
+                _vec_->flag = cmc_flags.ALLOC;                                \
+                return false;                                                 \
+            }                                                                 \
+                                                                              \
+            _vec_->buffer = new_buffer;                                       \
+        }                                                                     \
+                                                                              \
+        _vec_->capacity = capacity;                                           \
+                                                                              \
+        if (_vec_->callbacks && _vec_->callbacks->resize)                     \
+            _vec_->callbacks->resize();                                       \
+                                                                              \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    /* Makes room for at least size more elements, growing the buffer */      \
+    /* according to the growth policy */                                      \
+    bool PFX##_reserve(struct SNAME *_vec_, size_t size)                      \
+    {                                                                         \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        if (size <= _vec_->capacity - _vec_->count)                           \
+            return true;                                                      \
+                                                                              \
+        if (size > SIZE_MAX - _vec_->count)                                   \
+        {                                                                     \
+            _vec_->flag = cmc_flags.ERROR;                                    \
+            return false;                                                     \
+        }                                                                     \
+                                                                              \
+        return PFX##_resize(_vec_, cmc_growth_capacity(_vec_->growth,         \
+                                                       _vec_->capacity,       \
+                                                       _vec_->count + size)); \
+    }                                                                         \
+                                                                              \
+    /* Reduces the capacity to the amount of elements */                      \
+    bool PFX##_shrink_to_fit(struct SNAME *_vec_)                             \
+    {                                                                         \
+        return PFX##_resize(_vec_, _vec_->count > 0 ? _vec_->count : 1);      \
+    }                                                                         \
+                                                                              \
+    /* Sorts the smallvec in ascending order */                               \
+    void PFX##_sort(struct SNAME *_vec_)                                      \
+    {                                                                         \
+        PFX##_impl_sort_array(_vec_, PFX##_impl_buffer(_vec_), _vec_->count); \
+                                                                              \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        if (_vec_->callbacks && _vec_->callbacks->update)                     \
+            _vec_->callbacks->update();                                       \
+    }                                                                         \
+                                                                              \
+    /* Sorts the elements in the range [from, to] in ascending order */       \
+    bool PFX##_sort_range(struct SNAME *_vec_, size_t from, size_t to)        \
+    {                                                                         \
+        if (from > to)                                                        \
+        {                                                                     \
+            _vec_->flag = cmc_flags.INVALID;                                  \
+            return false;                                                     \
+        }                                                                     \
+                                                                              \
+        if (to >= _vec_->count)                                               \
+        {                                                                     \
+            _vec_->flag = cmc_flags.RANGE;                                    \
+            return false;                                                     \
+        }                                                                     \
+                                                                              \
+        PFX##_impl_sort_array(_vec_, PFX##_impl_buffer(_vec_) + from,         \
+                              to - from + 1);                                 \
+                                                                              \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        if (_vec_->callbacks && _vec_->callbacks->update)                     \
+            _vec_->callbacks->update();                                       \
+                                                                              \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    struct SNAME *PFX##_copy_of(struct SNAME *_vec_)                          \
+    {                                                                         \
+        struct SNAME *result = PFX##_new_custom(                              \
+            _vec_->capacity, _vec_->f_val, _vec_->alloc, _vec_->callbacks);   \
+                                                                              \
+        if (!result)                                                          \
+        {                                                                     \
+            _vec_->flag = cmc_flags.ALLOC;                                    \
+            return NULL;                                                      \
+        }                                                                     \
+                                                                              \
+        V *buffer = PFX##_impl_buffer(_vec_);                                 \
+        V *result_buffer = PFX##_impl_buffer(result);                         \
+                                                                              \
+        if (_vec_->f_val->cpy)                                                \
+        {                                                                     \
+            for (size_t i = 0; i < _vec_->count; i++)                         \
+                result_buffer[i] = _vec_->f_val->cpy(buffer[i]);              \
+        }                                                                     \
+        else                                                                  \
+            memcpy(result_buffer, buffer, sizeof(V) * _vec_->count);          \
+                                                                              \
+        result->count = _vec_->count;                                         \
+        result->growth = _vec_->growth;                                       \
+                                                                              \
+        _vec_->flag = cmc_flags.OK;                                           \
+                                                                              \
+        return result;                                                        \
+    }                                                                         \
+                                                                              \
+    bool PFX##_equals(struct SNAME *_vec1_, struct SNAME *_vec2_)             \
+    {                                                                         \
+        _vec1_->flag = cmc_flags.OK;                                          \
+        _vec2_->flag = cmc_flags.OK;                                          \
+                                                                              \
+        if (_vec1_->count != _vec2_->count)                                   \
+            return false;                                                     \
+                                                                              \
+        V *buffer1 = PFX##_impl_buffer(_vec1_);                               \
+        V *buffer2 = PFX##_impl_buffer(_vec2_);                               \
+                                                                              \
+        for (size_t i = 0; i < _vec1_->count; i++)                            \
+        {                                                                     \
+            if (_vec1_->f_val->cmp(buffer1[i], buffer2[i]) != 0)              \
+                return false;                                                 \
+        }                                                                     \
+                                                                              \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    struct cmc_string PFX##_to_string(struct SNAME *_vec_)                    \
+    {                                                                         \
+        struct cmc_string str;                                                \
+        struct SNAME *v_ = _vec_;                                             \
+                                                                              \
+        int n = snprintf(str.s, cmc_string_len, cmc_string_fmt_smallvec,      \
+                         #SNAME, #V, v_, PFX##_impl_buffer(v_),               \
+                         PFX##_is_inline(v_), v_->capacity, v_->count,        \
+                         v_->flag, v_->f_val, v_->alloc, v_->callbacks);      \
+                                                                              \
+        return n >= 0 ? str : (struct cmc_string){ 0 };                       \
+    }                                                                         \
+                                                                              \
+    bool PFX##_print(struct SNAME *_vec_, FILE *fptr)                         \
+    {                                                                         \
+        V *buffer = PFX##_impl_buffer(_vec_);                                 \
+                                                                              \
+        for (size_t i = 0; i < _vec_->count; i++)                             \
+        {                                                                     \
+            if (!_vec_->f_val->str(fptr, buffer[i]))                          \
+                return false;                                                 \
+        }                                                                     \
+                                                                              \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    struct SNAME##_iter PFX##_iter_start(struct SNAME *target)                \
+    {                                                                         \
+        struct SNAME##_iter iter;                                             \
+                                                                              \
+        iter.target = target;                                                 \
+        iter.cursor = 0;                                                      \
+        iter.start = true;                                                    \
+        iter.end = PFX##_empty(target);                                       \
+                                                                              \
+        return iter;                                                          \
+    }                                                                         \
+                                                                              \
+    struct SNAME##_iter PFX##_iter_end(struct SNAME *target)                  \
+    {                                                                         \
+        struct SNAME##_iter iter;                                             \
+                                                                              \
+        iter.target = target;                                                 \
+        iter.cursor = 0;                                                      \
+        iter.start = PFX##_empty(target);                                     \
+        iter.end = true;                                                      \
+                                                                              \
+        if (!PFX##_empty(target))                                             \
+            iter.cursor = target->count - 1;                                  \
+                                                                              \
+        return iter;                                                          \
+    }                                                                         \
+                                                                              \
+    bool PFX##_iter_at_start(struct SNAME##_iter *iter)                       \
+    {                                                                         \
+        return PFX##_empty(iter->target) || iter->start;                      \
+    }                                                                         \
+                                                                              \
+    bool PFX##_iter_at_end(struct SNAME##_iter *iter)                         \
+    {                                                                         \
+        return PFX##_empty(iter->target) || iter->end;                        \
+    }                                                                         \
+                                                                              \
+    bool PFX##_iter_to_start(struct SNAME##_iter *iter)                       \
+    {                                                                         \
+        if (!PFX##_empty(iter->target))                                       \
+        {                                                                     \
+            iter->cursor = 0;                                                 \
+            iter->start = true;                                               \
+            iter->end = PFX##_empty(iter->target);                            \
+                                                                              \
+            return true;                                                      \
+        }                                                                     \
+                                                                              \
+        return false;                                                         \
+    }                                                                         \
+                                                                              \
+    bool PFX##_iter_to_end(struct SNAME##_iter *iter)                         \
+    {                                                                         \
+        if (!PFX##_empty(iter->target))                                       \
+        {                                                                     \
+            iter->start = PFX##_empty(iter->target);                          \
+            iter->cursor = iter->target->count - 1;                           \
+            iter->end = true;                                                 \
+                                                                              \
+            return true;                                                      \
+        }                                                                     \
+                                                                              \
+        return false;                                                         \
+    }                                                                         \
+                                                                              \
+    bool PFX##_iter_next(struct SNAME##_iter *iter)                           \
+    {                                                                         \
+        if (iter->end)                                                        \
+            return false;                                                     \
+                                                                              \
+        if (iter->cursor + 1 == iter->target->count)                          \
+        {                                                                     \
+            iter->end = true;                                                 \
+            return false;                                                     \
+        }                                                                     \
+                                                                              \
+        iter->start = PFX##_empty(iter->target);                              \
+                                                                              \
+        iter->cursor++;                                                       \
+                                                                              \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    bool PFX##_iter_prev(struct SNAME##_iter *iter)                           \
+    {                                                                         \
+        if (iter->start)                                                      \
+            return false;                                                     \
+                                                                              \
+        if (iter->cursor == 0)                                                \
+        {                                                                     \
+            iter->start = true;                                               \
+            return false;                                                     \
+        }                                                                     \
+                                                                              \
+        iter->end = PFX##_empty(iter->target);                                \
+                                                                              \
+        iter->cursor--;                                                       \
+                                                                              \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    /* Returns true only if the iterator moved */                             \
+    bool PFX##_iter_advance(struct SNAME##_iter *iter, size_t steps)          \
+    {                                                                         \
+        if (iter->end)                                                        \
+            return false;                                                     \
+                                                                              \
+        if (iter->cursor + 1 == iter->target->count)                          \
+        {                                                                     \
+            iter->end = true;                                                 \
+            return false;                                                     \
+        }                                                                     \
+                                                                              \
+        if (steps == 0 || iter->cursor + steps >= iter->target->count)        \
+            return false;                                                     \
+                                                                              \
+        iter->start = PFX##_empty(iter->target);                              \
+                                                                              \
+        iter->cursor += steps;                                                \
+                                                                              \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    /* Returns true only if the iterator moved */                             \
+    bool PFX##_iter_rewind(struct SNAME##_iter *iter, size_t steps)           \
+    {                                                                         \
+        if (iter->start)                                                      \
+            return false;                                                     \
+                                                                              \
+        if (iter->cursor == 0)                                                \
+        {                                                                     \
+            iter->start = true;                                               \
+            return false;                                                     \
+        }                                                                     \
+                                                                              \
+        if (steps == 0 || iter->cursor < steps)                               \
+            return false;                                                     \
+                                                                              \
+        iter->end = PFX##_empty(iter->target);                                \
+                                                                              \
+        iter->cursor -= steps;                                                \
+                                                                              \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    /* Returns true only if the iterator was able to be positioned at the */  \
+    /* given index */                                                         \
+    bool PFX##_iter_go_to(struct SNAME##_iter *iter, size_t index)            \
+    {                                                                         \
+        if (index >= iter->target->count)                                     \
+            return false;                                                     \
+                                                                              \
+        if (iter->cursor > index)                                             \
+            return PFX##_iter_rewind(iter, iter->cursor - index);             \
+        else if (iter->cursor < index)                                        \
+            return PFX##_iter_advance(iter, index - iter->cursor);            \
+                                                                              \
+        return true;                                                          \
+    }                                                                         \
+                                                                              \
+    V PFX##_iter_value(struct SNAME##_iter *iter)                             \
+    {                                                                         \
+        if (PFX##_empty(iter->target))                                        \
+            return (V){ 0 };                                                  \
+                                                                              \
+        return PFX##_impl_buffer(iter->target)[iter->cursor];                 \
+    }                                                                         \
+                                                                              \
+    V *PFX##_iter_rvalue(struct SNAME##_iter *iter)                           \
+    {                                                                         \
+        if (PFX##_empty(iter->target))                                        \
+            return NULL;                                                      \
+                                                                              \
+        return &(PFX##_impl_buffer(iter->target)[iter->cursor]);              \
+    }                                                                         \
+                                                                              \
+    size_t PFX##_iter_index(struct SNAME##_iter *iter)                        \
+    {                                                                         \
+        return iter->cursor;                                                  \
+    }                                                                         \
+                                                                              \
+    static V *PFX##_impl_buffer(struct SNAME *_vec_)                          \
+    {                                                                         \
+        return _vec_->capacity > N ? _vec_->buffer : _vec_->storage;          \
+    }
+
+/* -------------------------------------------------------------------------
+ * Sort Source
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_SMALLVEC_SORT_SOURCE(PFX, SNAME, V)             \
+                                                                     \
+    CMC_GENERATE_SORT(PFX, V)                                        \
+                                                                     \
+    static void PFX##_impl_sort_array(struct SNAME *_vec_, V *array, \
+                                      size_t count)                  \
+    {                                                                \
+        PFX##_impl_sort(array, count, _vec_->f_val->cmp);            \
+    }
+
+#endif /* CMC_SMALLVEC_H */
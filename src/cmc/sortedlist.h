@@ -16,7 +16,19 @@
  * elements are only sorted when a certain action requires that the array is
  * sorted like accessing min() or max(). This prevents the array from being
  * sorted after every insertion or removal. The array is sorted using a
- * variation of quick sort that uses insertion sort for small partitions.
+ * pattern-defeating quicksort that falls back to heapsort when it detects bad
+ * partitions, so sorting is always done in O(n log n). A sorted list generated
+ * with CMC_GENERATE_SORTEDLIST_RADIX is instead sorted with a radix sort over
+ * integer keys extracted from the elements.
+ *
+ * The list keeps track of how many elements at the start of the buffer are
+ * already sorted. New elements are appended to an unsorted tail which, when the
+ * list needs to be sorted, is sorted by itself and then merged into the sorted
+ * elements. When the tail is much smaller than the rest of the list, each of
+ * its elements gallops to its position, so a few insertions between reads cost
+ * about as much as moving the elements that are greater than them. The list
+ * can also be set to eager mode, in which every insertion is placed directly
+ * in its sorted position with a binary search.
  */
 
 #ifndef CMC_SORTEDLIST_H
@@ -26,10 +38,17 @@
  * Core functionalities of the C Macro Collections Library
  * ------------------------------------------------------------------------- */
 #include "../cor/core.h"
+#include "../cor/sort.h"
 
 /* -------------------------------------------------------------------------
  * SortedList specific
  * ------------------------------------------------------------------------- */
+/* The unsorted tail is merged by galloping each of its elements into the */
+/* sorted elements when these are this many times more than the tail */
+#ifndef CMC_SORTEDLIST_GALLOP_FACTOR
+#define CMC_SORTEDLIST_GALLOP_FACTOR 8
+#endif /* CMC_SORTEDLIST_GALLOP_FACTOR */
+
 /* to_string format */
 static const char *cmc_string_fmt_sortedlist = "struct %s<%s> "
                                                "at %p { "
@@ -46,6 +65,19 @@ static const char *cmc_string_fmt_sortedlist = "struct %s<%s> "
     CMC_GENERATE_SORTEDLIST_HEADER(PFX, SNAME, V) \
     CMC_GENERATE_SORTEDLIST_SOURCE(PFX, SNAME, V)
 
+/* Generates a SortedList that is sorted with a radix sort over the keys */
+/* KEY(value) of type K, which must be an unsigned integer (see cor/sort.h) */
+#define CMC_GENERATE_SORTEDLIST_RADIX(PFX, SNAME, V, K, KEY) \
+    CMC_GENERATE_SORTEDLIST_HEADER(PFX, SNAME, V)            \
+    CMC_GENERATE_SORTEDLIST_SOURCE_RADIX(PFX, SNAME, V, K, KEY)
+
+/* The parallel sort depends on utl/thread.h and utl/condvar.h, which must */
+/* be included before expanding it, and it must be expanded in the same file */
+/* as the SOURCE part of the SortedList */
+#define CMC_GENERATE_SORTEDLIST_PARALLEL(PFX, SNAME, V)    \
+    CMC_GENERATE_SORTEDLIST_PARALLEL_HEADER(PFX, SNAME, V) \
+    CMC_GENERATE_SORTEDLIST_PARALLEL_SOURCE(PFX, SNAME, V)
+
 #define CMC_WRAPGEN_SORTEDLIST_HEADER(PFX, SNAME, K, V) \
     CMC_GENERATE_SORTEDLIST_HEADER(PFX, SNAME, V)
 
@@ -72,6 +104,12 @@ static const char *cmc_string_fmt_sortedlist = "struct %s<%s> "
         /* Flag if the list is sorted or not, used by lazy evaluation */     \
         bool is_sorted;                                                      \
                                                                              \
+        /* Amount of elements at the start of the buffer that are sorted */  \
+        size_t sorted;                                                       \
+                                                                             \
+        /* If insertions keep the list sorted */                             \
+        bool eager;                                                          \
+                                                                             \
         /* Flags indicating errors or success */                             \
         int flag;                                                            \
                                                                              \
@@ -83,6 +121,9 @@ static const char *cmc_string_fmt_sortedlist = "struct %s<%s> "
                                                                              \
         /* Custom callback functions */                                      \
         struct cmc_callbacks *callbacks;                                     \
+                                                                             \
+        /* Growth policy of the buffer */                                    \
+        const struct cmc_growth *growth;                                     \
     };                                                                       \
                                                                              \
     /* Value struct function table */                                        \
@@ -134,6 +175,8 @@ static const char *cmc_string_fmt_sortedlist = "struct %s<%s> "
     /* Customization of Allocation and Callbacks */                          \
     void PFX##_customize(struct SNAME *_list_, struct cmc_alloc_node *alloc, \
                          struct cmc_callbacks *callbacks);                   \
+    void PFX##_set_growth(struct SNAME *_list_,                              \
+                          const struct cmc_growth *growth);                  \
     /* Collection Input and Output */                                        \
     bool PFX##_insert(struct SNAME *_list_, V value);                        \
     bool PFX##_remove(struct SNAME *_list_, size_t index);                   \
@@ -151,7 +194,10 @@ static const char *cmc_string_fmt_sortedlist = "struct %s<%s> "
     int PFX##_flag(struct SNAME *_list_);                                    \
     /* Collection Utility */                                                 \
     bool PFX##_resize(struct SNAME *_list_, size_t capacity);                \
+    bool PFX##_reserve(struct SNAME *_list_, size_t size);                   \
+    bool PFX##_shrink_to_fit(struct SNAME *_list_);                          \
     void PFX##_sort(struct SNAME *_list_);                                   \
+    void PFX##_set_eager(struct SNAME *_list_, bool eager);                  \
     struct SNAME *PFX##_copy_of(struct SNAME *_list_);                       \
     bool PFX##_equals(struct SNAME *_list1_, struct SNAME *_list2_);         \
     struct cmc_string PFX##_to_string(struct SNAME *_list_);                 \
@@ -179,17 +225,26 @@ static const char *cmc_string_fmt_sortedlist = "struct %s<%s> "
 /* -------------------------------------------------------------------------
  * Source
  * ------------------------------------------------------------------------- */
-#define CMC_GENERATE_SORTEDLIST_SOURCE(PFX, SNAME, V)                          \
+#define CMC_GENERATE_SORTEDLIST_SOURCE(PFX, SNAME, V)  \
+    CMC_GENERATE_SORTEDLIST_CORE_SOURCE(PFX, SNAME, V) \
+    CMC_GENERATE_SORTEDLIST_SORT_SOURCE(PFX, SNAME, V)
+
+#define CMC_GENERATE_SORTEDLIST_SOURCE_RADIX(PFX, SNAME, V, K, KEY) \
+    CMC_GENERATE_SORTEDLIST_CORE_SOURCE(PFX, SNAME, V)              \
+    CMC_GENERATE_SORTEDLIST_RADIX_SORT_SOURCE(PFX, SNAME, V, K, KEY)
+
+#define CMC_GENERATE_SORTEDLIST_CORE_SOURCE(PFX, SNAME, V)                     \
                                                                                \
     /* Implementation Detail Functions */                                      \
     static size_t PFX##_impl_binary_search_first(struct SNAME *_list_,         \
                                                  V value);                     \
     static size_t PFX##_impl_binary_search_last(struct SNAME *_list_,          \
                                                 V value);                      \
-    void PFX##_impl_sort_quicksort(V *array, int (*cmp)(V, V), size_t low,     \
-                                   size_t high);                               \
-    void PFX##_impl_sort_insertion(V *array, int (*cmp)(V, V), size_t low,     \
-                                   size_t high);                               \
+    static void PFX##_impl_sort_array(struct SNAME *_list_, V *array,          \
+                                      size_t count);                           \
+    static size_t PFX##_impl_gallop(V *array, size_t end, V value,             \
+                                    int (*cmp)(V, V));                         \
+    static void PFX##_impl_merge_tail(struct SNAME *_list_);                   \
                                                                                \
     struct SNAME *PFX##_new(size_t capacity, struct SNAME##_fval *f_val)       \
     {                                                                          \
@@ -217,10 +272,13 @@ static const char *cmc_string_fmt_sortedlist = "struct %s<%s> "
         _list_->capacity = capacity;                                           \
         _list_->count = 0;                                                     \
         _list_->is_sorted = false;                                             \
+        _list_->sorted = 0;                                                    \
+        _list_->eager = false;                                                 \
         _list_->flag = cmc_flags.OK;                                           \
         _list_->f_val = f_val;                                                 \
         _list_->alloc = alloc;                                                 \
         _list_->callbacks = NULL;                                              \
+        _list_->growth = NULL;                                                 \
                                                                                \
         return _list_;                                                         \
     }                                                                          \
@@ -251,10 +309,13 @@ static const char *cmc_string_fmt_sortedlist = "struct %s<%s> "
         _list_->capacity = capacity;                                           \
         _list_->count = 0;                                                     \
         _list_->is_sorted = false;                                             \
+        _list_->sorted = 0;                                                    \
+        _list_->eager = false;                                                 \
         _list_->flag = cmc_flags.OK;                                           \
         _list_->f_val = f_val;                                                 \
         _list_->alloc = alloc;                                                 \
         _list_->callbacks = callbacks;                                         \
+        _list_->growth = NULL;                                                 \
                                                                                \
         return _list_;                                                         \
     }                                                                          \
@@ -270,6 +331,7 @@ static const char *cmc_string_fmt_sortedlist = "struct %s<%s> "
         memset(_list_->buffer, 0, sizeof(V) * _list_->capacity);               \
                                                                                \
         _list_->count = 0;                                                     \
+        _list_->sorted = 0;                                                    \
         _list_->flag = cmc_flags.OK;                                           \
     }                                                                          \
                                                                                \
@@ -298,17 +360,51 @@ static const char *cmc_string_fmt_sortedlist = "struct %s<%s> "
         _list_->flag = cmc_flags.OK;                                           \
     }                                                                          \
                                                                                \
+    /* Sets the growth policy used when the buffer is full (NULL for the */    \
+    /* default one) */                                                         \
+    void PFX##_set_growth(struct SNAME *_list_,                                \
+                          const struct cmc_growth *growth)                     \
+    {                                                                          \
+        _list_->growth = growth;                                               \
+                                                                               \
+        _list_->flag = cmc_flags.OK;                                           \
+    }                                                                          \
+                                                                               \
     bool PFX##_insert(struct SNAME *_list_, V value)                           \
     {                                                                          \
         if (PFX##_full(_list_))                                                \
         {                                                                      \
-            if (!PFX##_resize(_list_, _list_->capacity * 2))                   \
+            if (!PFX##_reserve(_list_, 1))                                     \
                 return false;                                                  \
         }                                                                      \
                                                                                \
-        _list_->buffer[_list_->count++] = value;                               \
+        V *buffer = _list_->buffer;                                            \
+        int (*cmp)(V, V) = _list_->f_val->cmp;                                 \
                                                                                \
-        _list_->is_sorted = false;                                             \
+        if (_list_->eager)                                                     \
+        {                                                                      \
+            PFX##_sort(_list_);                                                \
+                                                                               \
+            size_t index =                                                     \
+                PFX##_impl_gallop(buffer, _list_->count, value, cmp);          \
+                                                                               \
+            memmove(buffer + index + 1, buffer + index,                        \
+                    (_list_->count - index) * sizeof(V));                      \
+                                                                               \
+            buffer[index] = value;                                             \
+        }                                                                      \
+        else                                                                   \
+            buffer[_list_->count] = value;                                     \
+                                                                               \
+        /* The value extends the sorted elements if there is no tail and */    \
+        /* it is not less than the last sorted element */                      \
+        if (_list_->sorted == _list_->count &&                                 \
+            (_list_->sorted == 0 || _list_->eager ||                           \
+             cmp(buffer[_list_->sorted - 1], value) <= 0))                     \
+            _list_->sorted++;                                                  \
+                                                                               \
+        _list_->count++;                                                       \
+        _list_->is_sorted = _list_->sorted == _list_->count;                   \
         _list_->flag = cmc_flags.OK;                                           \
                                                                                \
         if (_list_->callbacks && _list_->callbacks->create)                    \
@@ -332,10 +428,15 @@ static const char *cmc_string_fmt_sortedlist = "struct %s<%s> "
         }                                                                      \
                                                                                \
         memmove(_list_->buffer + index, _list_->buffer + index + 1,            \
-                (_list_->count - index) * sizeof(V));                          \
+                (_list_->count - index - 1) * sizeof(V));                      \
                                                                                \
         _list_->buffer[--_list_->count] = (V){ 0 };                            \
                                                                                \
+        if (index < _list_->sorted)                                            \
+            _list_->sorted--;                                                  \
+                                                                               \
+        _list_->is_sorted = _list_->sorted == _list_->count;                   \
+                                                                               \
         _list_->flag = cmc_flags.OK;                                           \
                                                                                \
         if (_list_->callbacks && _list_->callbacks->delete)                    \
@@ -481,8 +582,6 @@ static const char *cmc_string_fmt_sortedlist = "struct %s<%s> "
             return false;                                                      \
         }                                                                      \
                                                                                \
-        /* TODO zero out remaining slots */                                    \
-                                                                               \
         _list_->buffer = new_buffer;                                           \
         _list_->capacity = capacity;                                           \
                                                                                \
@@ -496,17 +595,48 @@ static const char *cmc_string_fmt_sortedlist = "struct %s<%s> "
         return true;                                                           \
     }                                                                          \
                                                                                \
+    /* Makes room for at least size more elements, growing the buffer */       \
+    /* according to the growth policy */                                       \
+    bool PFX##_reserve(struct SNAME *_list_, size_t size)                      \
+    {                                                                          \
+        _list_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (size <= _list_->capacity - _list_->count)                          \
+            return true;                                                       \
+                                                                               \
+        if (size > SIZE_MAX - _list_->count)                                   \
+        {                                                                      \
+            _list_->flag = cmc_flags.ERROR;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        return PFX##_resize(                                                   \
+            _list_, cmc_growth_capacity(_list_->growth, _list_->capacity,      \
+                                        _list_->count + size));                \
+    }                                                                          \
+                                                                               \
+    /* Reduces the capacity to the amount of elements */                       \
+    bool PFX##_shrink_to_fit(struct SNAME *_list_)                             \
+    {                                                                          \
+        return PFX##_resize(_list_, _list_->count > 0 ? _list_->count : 1);    \
+    }                                                                          \
+                                                                               \
     void PFX##_sort(struct SNAME *_list_)                                      \
     {                                                                          \
         _list_->flag = cmc_flags.OK;                                           \
                                                                                \
         if (!_list_->is_sorted && _list_->count > 1)                           \
-        {                                                                      \
-            PFX##_impl_sort_quicksort(_list_->buffer, _list_->f_val->cmp, 0,   \
-                                      _list_->count - 1);                      \
+            PFX##_impl_merge_tail(_list_);                                     \
                                                                                \
-            _list_->is_sorted = true;                                          \
-        }                                                                      \
+        _list_->sorted = _list_->count;                                        \
+        _list_->is_sorted = true;                                              \
+    }                                                                          \
+                                                                               \
+    void PFX##_set_eager(struct SNAME *_list_, bool eager)                     \
+    {                                                                          \
+        _list_->eager = eager;                                                 \
+                                                                               \
+        _list_->flag = cmc_flags.OK;                                           \
     }                                                                          \
                                                                                \
     struct SNAME *PFX##_copy_of(struct SNAME *_list_)                          \
@@ -530,6 +660,10 @@ static const char *cmc_string_fmt_sortedlist = "struct %s<%s> "
             memcpy(result->buffer, _list_->buffer, sizeof(V) * _list_->count); \
                                                                                \
         result->count = _list_->count;                                         \
+        result->growth = _list_->growth;                                       \
+        result->is_sorted = _list_->is_sorted;                                 \
+        result->sorted = _list_->sorted;                                       \
+        result->eager = _list_->eager;                                         \
                                                                                \
         _list_->flag = cmc_flags.OK;                                           \
                                                                                \
@@ -808,78 +942,160 @@ static const char *cmc_string_fmt_sortedlist = "struct %s<%s> "
         return _list_->count;                                                  \
     }                                                                          \
                                                                                \
-    /* Characteristics of this quicksort implementation: */                    \
-    /* - Hybrid: uses insertion sort for small arrays */                       \
-    /* - Partition: Lomuto's Method */                                         \
-    /* - Tail recursion: minimize recursion depth */                           \
-    void PFX##_impl_sort_quicksort(V *array, int (*cmp)(V, V), size_t low,     \
-                                   size_t high)                                \
+    /* Returns the position of the first element in array[0, end) that is */   \
+    /* greater than value. The search starts at the end of the array with */   \
+    /* exponentially increasing steps, followed by a binary search. */         \
+    static size_t PFX##_impl_gallop(V *array, size_t end, V value,             \
+                                    int (*cmp)(V, V))                          \
     {                                                                          \
-        while (low < high)                                                     \
+        /* array[0, L) are not greater than value */                           \
+        /* array[R, end) are greater than value */                             \
+        size_t L = 0;                                                          \
+        size_t R = end;                                                        \
+        size_t step = 1;                                                       \
+                                                                               \
+        while (L < R)                                                          \
         {                                                                      \
-            /* Quicksort performs poorly for smaller arrays so let */          \
-            /* insertion sort do the job */                                    \
-            if (high - low < 10)                                               \
+            size_t probe = R > step ? R - step : 0;                            \
+                                                                               \
+            if (cmp(array[probe], value) <= 0)                                 \
             {                                                                  \
-                PFX##_impl_sort_insertion(array, cmp, low, high);              \
+                L = probe + 1;                                                 \
                 break;                                                         \
             }                                                                  \
-            else                                                               \
-            {                                                                  \
-                /* Partition */                                                \
-                V pivot = array[high];                                         \
-                                                                               \
-                size_t pindex = low;                                           \
-                                                                               \
-                for (size_t i = low; i < high; i++)                            \
-                {                                                              \
-                    if (cmp(array[i], pivot) <= 0)                             \
-                    {                                                          \
-                        V _tmp_ = array[i];                                    \
-                        array[i] = array[pindex];                              \
-                        array[pindex] = _tmp_;                                 \
-                                                                               \
-                        pindex++;                                              \
-                    }                                                          \
-                }                                                              \
-                                                                               \
-                V _tmp_ = array[pindex];                                       \
-                array[pindex] = array[high];                                   \
-                array[high] = _tmp_;                                           \
-                                                                               \
-                /* Tail recursion */                                           \
-                if (pindex - low < high - pindex)                              \
-                {                                                              \
-                    PFX##_impl_sort_quicksort(array, cmp, low, pindex - 1);    \
-                                                                               \
-                    low = pindex + 1;                                          \
-                }                                                              \
-                else                                                           \
-                {                                                              \
-                    PFX##_impl_sort_quicksort(array, cmp, pindex + 1, high);   \
                                                                                \
-                    high = pindex - 1;                                         \
-                }                                                              \
-            }                                                                  \
+            R = probe;                                                         \
+            step *= 2;                                                         \
+        }                                                                      \
+                                                                               \
+        while (L < R)                                                          \
+        {                                                                      \
+            size_t M = L + (R - L) / 2;                                        \
+                                                                               \
+            if (cmp(array[M], value) > 0)                                      \
+                R = M;                                                         \
+            else                                                               \
+                L = M + 1;                                                     \
         }                                                                      \
+                                                                               \
+        return L;                                                              \
     }                                                                          \
                                                                                \
-    void PFX##_impl_sort_insertion(V *array, int (*cmp)(V, V), size_t low,     \
-                                   size_t high)                                \
+    /* Sorts the unsorted tail and merges it into the sorted elements */       \
+    static void PFX##_impl_merge_tail(struct SNAME *_list_)                    \
     {                                                                          \
-        for (size_t i = low + 1; i <= high; i++)                               \
+        V *buffer = _list_->buffer;                                            \
+        size_t sorted = _list_->sorted;                                        \
+        size_t tail = _list_->count - sorted;                                  \
+        int (*cmp)(V, V) = _list_->f_val->cmp;                                 \
+                                                                               \
+        PFX##_impl_sort_array(_list_, buffer + sorted, tail);                  \
+                                                                               \
+        if (sorted == 0 || cmp(buffer[sorted - 1], buffer[sorted]) <= 0)       \
+            return;                                                            \
+                                                                               \
+        V *aux = _list_->alloc->malloc(sizeof(V) * tail);                      \
+                                                                               \
+        if (!aux)                                                              \
         {                                                                      \
-            V _tmp_ = array[i];                                                \
-            size_t j = i;                                                      \
+            PFX##_impl_sort_array(_list_, buffer, _list_->count);              \
+            return;                                                            \
+        }                                                                      \
                                                                                \
-            while (j > low && cmp(array[j - 1], _tmp_) > 0)                    \
+        memcpy(aux, buffer + sorted, sizeof(V) * tail);                        \
+                                                                               \
+        /* Both are merged from the back. Equal elements of the tail go */     \
+        /* after the ones that were already sorted. */                         \
+        size_t i = sorted;                                                     \
+        size_t j = tail;                                                       \
+        size_t k = _list_->count;                                              \
+                                                                               \
+        if (sorted / CMC_SORTEDLIST_GALLOP_FACTOR > tail)                      \
+        {                                                                      \
+            while (j > 0)                                                      \
+            {                                                                  \
+                size_t index = PFX##_impl_gallop(buffer, i, aux[j - 1], cmp);  \
+                                                                               \
+                k -= i - index;                                                \
+                memmove(buffer + k, buffer + index, (i - index) * sizeof(V));  \
+                                                                               \
+                buffer[--k] = aux[--j];                                        \
+                i = index;                                                     \
+            }                                                                  \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            while (i > 0 && j > 0)                                             \
             {                                                                  \
-                array[j] = array[j - 1];                                       \
-                j--;                                                           \
+                if (cmp(aux[j - 1], buffer[i - 1]) < 0)                        \
+                    buffer[--k] = buffer[--i];                                 \
+                else                                                           \
+                    buffer[--k] = aux[--j];                                    \
             }                                                                  \
                                                                                \
-            array[j] = _tmp_;                                                  \
+            while (j > 0)                                                      \
+                buffer[--k] = aux[--j];                                        \
         }                                                                      \
+                                                                               \
+        _list_->alloc->free(aux);                                              \
+    }
+
+/* -------------------------------------------------------------------------
+ * Sort Source
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_SORTEDLIST_SORT_SOURCE(PFX, SNAME, V)            \
+                                                                      \
+    CMC_GENERATE_SORT(PFX, V)                                         \
+                                                                      \
+    static void PFX##_impl_sort_array(struct SNAME *_list_, V *array, \
+                                      size_t count)                   \
+    {                                                                 \
+        PFX##_impl_sort(array, count, _list_->f_val->cmp);            \
+    }
+
+#define CMC_GENERATE_SORTEDLIST_RADIX_SORT_SOURCE(PFX, SNAME, V, K, KEY) \
+                                                                         \
+    CMC_GENERATE_SORT_RADIX(PFX, V, K, KEY)                              \
+                                                                         \
+    static void PFX##_impl_sort_array(struct SNAME *_list_, V *array,    \
+                                      size_t count)                      \
+    {                                                                    \
+        PFX##_impl_sort_radix(array, count, _list_->alloc,               \
+                              _list_->f_val->cmp);                       \
+    }
+
+/* -------------------------------------------------------------------------
+ * Parallel Sort
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_SORTEDLIST_PARALLEL_HEADER(PFX, SNAME, V)        \
+                                                                      \
+    /* Sorts the list using up to the given amount of threads. The */ \
+    /* allocator of the list must be thread-safe. */                  \
+    void PFX##_sort_parallel(struct SNAME *_list_, size_t threads);
+
+#define CMC_GENERATE_SORTEDLIST_PARALLEL_SOURCE(PFX, SNAME, V)                \
+                                                                              \
+    CMC_GENERATE_SORT_PARALLEL(PFX, SNAME, V)                                 \
+                                                                              \
+    static void PFX##_impl_sort_chunk(V *array, size_t count, void *args)     \
+    {                                                                         \
+        PFX##_impl_sort_array((struct SNAME *)args, array, count);            \
+    }                                                                         \
+                                                                              \
+    void PFX##_sort_parallel(struct SNAME *_list_, size_t threads)            \
+    {                                                                         \
+        _list_->flag = cmc_flags.OK;                                          \
+                                                                              \
+        if (!_list_->is_sorted && _list_->count > 1)                          \
+        {                                                                     \
+            if (!PFX##_impl_sort_parallel(                                    \
+                    _list_->buffer, _list_->count, threads, _list_->alloc,    \
+                    _list_->f_val->cmp, PFX##_impl_sort_chunk, _list_))       \
+                PFX##_impl_sort_array(_list_, _list_->buffer, _list_->count); \
+        }                                                                     \
+                                                                              \
+        _list_->sorted = _list_->count;                                       \
+        _list_->is_sorted = true;                                             \
     }
 
 #endif /* CMC_SORTEDLIST_H */
@@ -0,0 +1,524 @@
+/**
+ * spscqueue.h
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * SPSCQueue
+ *
+ * A single-producer/single-consumer Queue. It is a bounded ring buffer that
+ * can be shared by two threads without locks: one thread (the producer) only
+ * enqueues elements and another thread (the consumer) only dequeues them.
+ *
+ * The capacity is rounded up to a power of two so that positions are taken
+ * with a mask instead of the modulo operator. The producer owns the `tail`
+ * index and the consumer owns the `head` index. Both only grow and each one is
+ * written by a single thread with a release store, which publishes the
+ * elements written (or read) before it to the other thread.
+ *
+ * Each side keeps its index and a cached copy of the other side's index on
+ * its own cache line, so the two threads don't keep invalidating each other's
+ * cache. The other side's index is only loaded again when the cached copy says
+ * that the queue is full (for the producer) or empty (for the consumer).
+ *
+ * The bulk functions try_enqueue_n and try_dequeue_n copy a batch of elements
+ * with at most two memcpy calls and publish all of them with a single store.
+ *
+ * Only one thread may call the enqueue functions and only one thread may call
+ * the dequeue functions at a time. The other functions, except count, empty
+ * and full, must not be called while the queue is being used by both threads.
+ * The try functions don't update the queue's flag since both threads would
+ * write to it; their result tells if they succeeded. Callbacks are called from
+ * the thread that enqueued or dequeued the elements.
+ */
+
+#ifndef CMC_SPSCQUEUE_H
+#define CMC_SPSCQUEUE_H
+
+/* -------------------------------------------------------------------------
+ * Core functionalities of the C Macro Collections Library
+ * ------------------------------------------------------------------------- */
+#include "../cor/core.h"
+
+#include <stdatomic.h>
+
+/* -------------------------------------------------------------------------
+ * SPSCQueue specific
+ * ------------------------------------------------------------------------- */
+/* to_string format */
+static const char *cmc_string_fmt_spscqueue = "struct %s<%s> "
+                                              "at %p { "
+                                              "buffer:%p, "
+                                              "capacity:%" PRIuMAX ", "
+                                              "head:%" PRIuMAX ", "
+                                              "tail:%" PRIuMAX ", "
+                                              "flag:%d, "
+                                              "f_val:%p, "
+                                              "alloc:%p, "
+                                              "callbacks:%p }";
+
+/* Size in bytes of a cache line */
+#ifndef CMC_SPSCQUEUE_CACHE_LINE
+#define CMC_SPSCQUEUE_CACHE_LINE 64
+#endif /* CMC_SPSCQUEUE_CACHE_LINE */
+
+#define CMC_GENERATE_SPSCQUEUE(PFX, SNAME, V)    \
+    CMC_GENERATE_SPSCQUEUE_HEADER(PFX, SNAME, V) \
+    CMC_GENERATE_SPSCQUEUE_SOURCE(PFX, SNAME, V)
+
+#define CMC_WRAPGEN_SPSCQUEUE_HEADER(PFX, SNAME, K, V) \
+    CMC_GENERATE_SPSCQUEUE_HEADER(PFX, SNAME, V)
+
+#define CMC_WRAPGEN_SPSCQUEUE_SOURCE(PFX, SNAME, K, V) \
+    CMC_GENERATE_SPSCQUEUE_SOURCE(PFX, SNAME, V)
+
+/* -------------------------------------------------------------------------
+ * Header
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_SPSCQUEUE_HEADER(PFX, SNAME, V)                          \
+                                                                              \
+    /* SPSCQueue Structure */                                                 \
+    struct SNAME                                                              \
+    {                                                                         \
+        /* The structure is not aligned to a cache line when it comes from */ \
+        /* malloc, so a whole line of padding separates each part of it */    \
+        char pad_0[CMC_SPSCQUEUE_CACHE_LINE];                                 \
+                                                                              \
+        /* Index of the next element to be enqueued (written by producer) */  \
+        _Atomic size_t tail;                                                  \
+                                                                              \
+        /* Last head seen by the producer */                                  \
+        size_t head_cache;                                                    \
+                                                                              \
+        char pad_1[CMC_SPSCQUEUE_CACHE_LINE];                                 \
+                                                                              \
+        /* Index of the next element to be dequeued (written by consumer) */  \
+        _Atomic size_t head;                                                  \
+                                                                              \
+        /* Last tail seen by the consumer */                                  \
+        size_t tail_cache;                                                    \
+                                                                              \
+        char pad_2[CMC_SPSCQUEUE_CACHE_LINE];                                 \
+                                                                              \
+        /* Circular array of elements */                                      \
+        V *buffer;                                                            \
+                                                                              \
+        /* Capacity of the buffer, which is a power of two */                 \
+        size_t capacity;                                                      \
+                                                                              \
+        /* Flags indicating errors or success */                              \
+        int flag;                                                             \
+                                                                              \
+        /* Value function table */                                            \
+        struct SNAME##_fval *f_val;                                           \
+                                                                              \
+        /* Custom allocation functions */                                     \
+        struct cmc_alloc_node *alloc;                                         \
+                                                                              \
+        /* Custom callback functions */                                       \
+        struct cmc_callbacks *callbacks;                                      \
+    };                                                                        \
+                                                                              \
+    /* Value struct function table */                                         \
+    struct SNAME##_fval                                                       \
+    {                                                                         \
+        /* Comparator function */                                             \
+        int (*cmp)(V, V);                                                     \
+                                                                              \
+        /* Copy function */                                                   \
+        V (*cpy)(V);                                                          \
+                                                                              \
+        /* To string function */                                              \
+        bool (*str)(FILE *, V);                                               \
+                                                                              \
+        /* Free from memory function */                                       \
+        void (*free)(V);                                                      \
+                                                                              \
+        /* Hash function */                                                   \
+        size_t (*hash)(V);                                                    \
+                                                                              \
+        /* Priority function */                                               \
+        int (*pri)(V, V);                                                     \
+    };                                                                        \
+                                                                              \
+    /* Collection Functions */                                                \
+    /* Collection Allocation and Deallocation */                              \
+    struct SNAME *PFX##_new(size_t capacity, struct SNAME##_fval *f_val);     \
+    struct SNAME *PFX##_new_custom(                                           \
+        size_t capacity, struct SNAME##_fval *f_val,                          \
+        struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks);       \
+    void PFX##_clear(struct SNAME *_queue_);                                  \
+    void PFX##_free(struct SNAME *_queue_);                                   \
+    /* Customization of Allocation and Callbacks */                           \
+    void PFX##_customize(struct SNAME *_queue_, struct cmc_alloc_node *alloc, \
+                         struct cmc_callbacks *callbacks);                    \
+    /* Producer Functions */                                                  \
+    bool PFX##_try_enqueue(struct SNAME *_queue_, V value);                   \
+    size_t PFX##_try_enqueue_n(struct SNAME *_queue_, V *values, size_t n);   \
+    /* Consumer Functions */                                                  \
+    bool PFX##_try_dequeue(struct SNAME *_queue_, V *out);                    \
+    size_t PFX##_try_dequeue_n(struct SNAME *_queue_, V *out, size_t n);      \
+    bool PFX##_try_peek(struct SNAME *_queue_, V *out);                       \
+    /* Collection State */                                                    \
+    bool PFX##_empty(struct SNAME *_queue_);                                  \
+    bool PFX##_full(struct SNAME *_queue_);                                   \
+    size_t PFX##_count(struct SNAME *_queue_);                                \
+    size_t PFX##_capacity(struct SNAME *_queue_);                             \
+    int PFX##_flag(struct SNAME *_queue_);                                    \
+    /* Collection Utility */                                                  \
+    struct cmc_string PFX##_to_string(struct SNAME *_queue_);                 \
+    bool PFX##_print(struct SNAME *_queue_, FILE *fptr);
+
+/* -------------------------------------------------------------------------
+ * Source
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_SPSCQUEUE_SOURCE(PFX, SNAME, V)                           \
+                                                                               \
+    /* Implementation Detail Functions */                                      \
+    static size_t PFX##_impl_capacity(size_t capacity);                        \
+                                                                               \
+    struct SNAME *PFX##_new(size_t capacity, struct SNAME##_fval *f_val)       \
+    {                                                                          \
+        return PFX##_new_custom(capacity, f_val, NULL, NULL);                  \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_new_custom(                                            \
+        size_t capacity, struct SNAME##_fval *f_val,                           \
+        struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks)         \
+    {                                                                          \
+        if (capacity < 1)                                                      \
+            return NULL;                                                       \
+                                                                               \
+        if (!f_val)                                                            \
+            return NULL;                                                       \
+                                                                               \
+        capacity = PFX##_impl_capacity(capacity);                              \
+                                                                               \
+        if (capacity == 0)                                                     \
+            return NULL;                                                       \
+                                                                               \
+        if (!alloc)                                                            \
+            alloc = &cmc_alloc_node_default;                                   \
+                                                                               \
+        struct SNAME *_queue_ = alloc->malloc(sizeof(struct SNAME));           \
+                                                                               \
+        if (!_queue_)                                                          \
+            return NULL;                                                       \
+                                                                               \
+        _queue_->buffer = alloc->calloc(capacity, sizeof(V));                  \
+                                                                               \
+        if (!_queue_->buffer)                                                  \
+        {                                                                      \
+            alloc->free(_queue_);                                              \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        atomic_init(&_queue_->tail, 0);                                        \
+        atomic_init(&_queue_->head, 0);                                        \
+                                                                               \
+        _queue_->head_cache = 0;                                               \
+        _queue_->tail_cache = 0;                                               \
+        _queue_->capacity = capacity;                                          \
+        _queue_->flag = cmc_flags.OK;                                          \
+        _queue_->f_val = f_val;                                                \
+        _queue_->alloc = alloc;                                                \
+        _queue_->callbacks = callbacks;                                        \
+                                                                               \
+        return _queue_;                                                        \
+    }                                                                          \
+                                                                               \
+    void PFX##_clear(struct SNAME *_queue_)                                    \
+    {                                                                          \
+        size_t head =                                                          \
+            atomic_load_explicit(&_queue_->head, memory_order_relaxed);        \
+        size_t tail =                                                          \
+            atomic_load_explicit(&_queue_->tail, memory_order_relaxed);        \
+                                                                               \
+        if (_queue_->f_val->free)                                              \
+        {                                                                      \
+            for (size_t i = head; i != tail; i++)                              \
+                _queue_->f_val->free(                                          \
+                    _queue_->buffer[i & (_queue_->capacity - 1)]);             \
+        }                                                                      \
+                                                                               \
+        memset(_queue_->buffer, 0, sizeof(V) * _queue_->capacity);             \
+                                                                               \
+        atomic_store_explicit(&_queue_->tail, 0, memory_order_relaxed);        \
+        atomic_store_explicit(&_queue_->head, 0, memory_order_relaxed);        \
+                                                                               \
+        _queue_->head_cache = 0;                                               \
+        _queue_->tail_cache = 0;                                               \
+        _queue_->flag = cmc_flags.OK;                                          \
+    }                                                                          \
+                                                                               \
+    void PFX##_free(struct SNAME *_queue_)                                     \
+    {                                                                          \
+        size_t head =                                                          \
+            atomic_load_explicit(&_queue_->head, memory_order_relaxed);        \
+        size_t tail =                                                          \
+            atomic_load_explicit(&_queue_->tail, memory_order_relaxed);        \
+                                                                               \
+        if (_queue_->f_val->free)                                              \
+        {                                                                      \
+            for (size_t i = head; i != tail; i++)                              \
+                _queue_->f_val->free(                                          \
+                    _queue_->buffer[i & (_queue_->capacity - 1)]);             \
+        }                                                                      \
+                                                                               \
+        _queue_->alloc->free(_queue_->buffer);                                 \
+        _queue_->alloc->free(_queue_);                                         \
+    }                                                                          \
+                                                                               \
+    void PFX##_customize(struct SNAME *_queue_, struct cmc_alloc_node *alloc,  \
+                         struct cmc_callbacks *callbacks)                      \
+    {                                                                          \
+        if (!alloc)                                                            \
+            _queue_->alloc = &cmc_alloc_node_default;                          \
+        else                                                                   \
+            _queue_->alloc = alloc;                                            \
+                                                                               \
+        _queue_->callbacks = callbacks;                                        \
+                                                                               \
+        _queue_->flag = cmc_flags.OK;                                          \
+    }                                                                          \
+                                                                               \
+    bool PFX##_try_enqueue(struct SNAME *_queue_, V value)                     \
+    {                                                                          \
+        size_t tail =                                                          \
+            atomic_load_explicit(&_queue_->tail, memory_order_relaxed);        \
+                                                                               \
+        if (tail - _queue_->head_cache == _queue_->capacity)                   \
+        {                                                                      \
+            _queue_->head_cache =                                              \
+                atomic_load_explicit(&_queue_->head, memory_order_acquire);    \
+                                                                               \
+            if (tail - _queue_->head_cache == _queue_->capacity)               \
+                return false;                                                  \
+        }                                                                      \
+                                                                               \
+        _queue_->buffer[tail & (_queue_->capacity - 1)] = value;               \
+                                                                               \
+        atomic_store_explicit(&_queue_->tail, tail + 1, memory_order_release); \
+                                                                               \
+        if (_queue_->callbacks && _queue_->callbacks->create)                  \
+            _queue_->callbacks->create();                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Enqueues up to n values and returns how many were enqueued. They are */ \
+    /* copied in at most two parts and published to the consumer at once */    \
+    size_t PFX##_try_enqueue_n(struct SNAME *_queue_, V *values, size_t n)     \
+    {                                                                          \
+        size_t tail =                                                          \
+            atomic_load_explicit(&_queue_->tail, memory_order_relaxed);        \
+        size_t space = _queue_->capacity - (tail - _queue_->head_cache);       \
+                                                                               \
+        if (space < n)                                                         \
+        {                                                                      \
+            _queue_->head_cache =                                              \
+                atomic_load_explicit(&_queue_->head, memory_order_acquire);    \
+                                                                               \
+            space = _queue_->capacity - (tail - _queue_->head_cache);          \
+        }                                                                      \
+                                                                               \
+        if (n > space)                                                         \
+            n = space;                                                         \
+                                                                               \
+        if (n == 0)                                                            \
+            return 0;                                                          \
+                                                                               \
+        size_t index = tail & (_queue_->capacity - 1);                         \
+        size_t count1 = _queue_->capacity - index;                             \
+                                                                               \
+        if (count1 > n)                                                        \
+            count1 = n;                                                        \
+                                                                               \
+        memcpy(_queue_->buffer + index, values, count1 * sizeof(V));           \
+        memcpy(_queue_->buffer, values + count1, (n - count1) * sizeof(V));    \
+                                                                               \
+        atomic_store_explicit(&_queue_->tail, tail + n, memory_order_release); \
+                                                                               \
+        if (_queue_->callbacks && _queue_->callbacks->create)                  \
+            _queue_->callbacks->create();                                      \
+                                                                               \
+        return n;                                                              \
+    }                                                                          \
+                                                                               \
+    bool PFX##_try_dequeue(struct SNAME *_queue_, V *out)                      \
+    {                                                                          \
+        size_t head =                                                          \
+            atomic_load_explicit(&_queue_->head, memory_order_relaxed);        \
+                                                                               \
+        if (head == _queue_->tail_cache)                                       \
+        {                                                                      \
+            _queue_->tail_cache =                                              \
+                atomic_load_explicit(&_queue_->tail, memory_order_acquire);    \
+                                                                               \
+            if (head == _queue_->tail_cache)                                   \
+                return false;                                                  \
+        }                                                                      \
+                                                                               \
+        if (out)                                                               \
+            *out = _queue_->buffer[head & (_queue_->capacity - 1)];            \
+                                                                               \
+        atomic_store_explicit(&_queue_->head, head + 1, memory_order_release); \
+                                                                               \
+        if (_queue_->callbacks && _queue_->callbacks->delete)                  \
+            _queue_->callbacks->delete ();                                     \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Dequeues up to n values, copying them to out if it is not NULL, and */  \
+    /* returns how many were dequeued */                                       \
+    size_t PFX##_try_dequeue_n(struct SNAME *_queue_, V *out, size_t n)        \
+    {                                                                          \
+        size_t head =                                                          \
+            atomic_load_explicit(&_queue_->head, memory_order_relaxed);        \
+        size_t available = _queue_->tail_cache - head;                         \
+                                                                               \
+        if (available < n)                                                     \
+        {                                                                      \
+            _queue_->tail_cache =                                              \
+                atomic_load_explicit(&_queue_->tail, memory_order_acquire);    \
+                                                                               \
+            available = _queue_->tail_cache - head;                            \
+        }                                                                      \
+                                                                               \
+        if (n > available)                                                     \
+            n = available;                                                     \
+                                                                               \
+        if (n == 0)                                                            \
+            return 0;                                                          \
+                                                                               \
+        if (out)                                                               \
+        {                                                                      \
+            size_t index = head & (_queue_->capacity - 1);                     \
+            size_t count1 = _queue_->capacity - index;                         \
+                                                                               \
+            if (count1 > n)                                                    \
+                count1 = n;                                                    \
+                                                                               \
+            memcpy(out, _queue_->buffer + index, count1 * sizeof(V));          \
+            memcpy(out + count1, _queue_->buffer, (n - count1) * sizeof(V));   \
+        }                                                                      \
+                                                                               \
+        atomic_store_explicit(&_queue_->head, head + n, memory_order_release); \
+                                                                               \
+        if (_queue_->callbacks && _queue_->callbacks->delete)                  \
+            _queue_->callbacks->delete ();                                     \
+                                                                               \
+        return n;                                                              \
+    }                                                                          \
+                                                                               \
+    bool PFX##_try_peek(struct SNAME *_queue_, V *out)                         \
+    {                                                                          \
+        size_t head =                                                          \
+            atomic_load_explicit(&_queue_->head, memory_order_relaxed);        \
+                                                                               \
+        if (head == _queue_->tail_cache)                                       \
+        {                                                                      \
+            _queue_->tail_cache =                                              \
+                atomic_load_explicit(&_queue_->tail, memory_order_acquire);    \
+                                                                               \
+            if (head == _queue_->tail_cache)                                   \
+                return false;                                                  \
+        }                                                                      \
+                                                                               \
+        *out = _queue_->buffer[head & (_queue_->capacity - 1)];                \
+                                                                               \
+        if (_queue_->callbacks && _queue_->callbacks->read)                    \
+            _queue_->callbacks->read();                                        \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_empty(struct SNAME *_queue_)                                    \
+    {                                                                          \
+        return PFX##_count(_queue_) == 0;                                      \
+    }                                                                          \
+                                                                               \
+    bool PFX##_full(struct SNAME *_queue_)                                     \
+    {                                                                          \
+        return PFX##_count(_queue_) >= _queue_->capacity;                      \
+    }                                                                          \
+                                                                               \
+    /* Either thread may call it but the other one can change the queue */     \
+    /* right after, so the result is only a snapshot */                        \
+    size_t PFX##_count(struct SNAME *_queue_)                                  \
+    {                                                                          \
+        size_t head =                                                          \
+            atomic_load_explicit(&_queue_->head, memory_order_acquire);        \
+        size_t tail =                                                          \
+            atomic_load_explicit(&_queue_->tail, memory_order_acquire);        \
+                                                                               \
+        /* Elements can be dequeued and enqueued between both loads */         \
+        return tail - head > _queue_->capacity ? _queue_->capacity             \
+                                               : tail - head;                  \
+    }                                                                          \
+                                                                               \
+    size_t PFX##_capacity(struct SNAME *_queue_)                               \
+    {                                                                          \
+        return _queue_->capacity;                                              \
+    }                                                                          \
+                                                                               \
+    int PFX##_flag(struct SNAME *_queue_)                                      \
+    {                                                                          \
+        return _queue_->flag;                                                  \
+    }                                                                          \
+                                                                               \
+    struct cmc_string PFX##_to_string(struct SNAME *_queue_)                   \
+    {                                                                          \
+        struct cmc_string str;                                                 \
+        struct SNAME *q_ = _queue_;                                            \
+                                                                               \
+        int n =                                                                \
+            snprintf(str.s, cmc_string_len, cmc_string_fmt_spscqueue, #SNAME,  \
+                     #V, q_, q_->buffer, q_->capacity,                         \
+                     atomic_load_explicit(&q_->head, memory_order_relaxed),    \
+                     atomic_load_explicit(&q_->tail, memory_order_relaxed),    \
+                     q_->flag, q_->f_val, q_->alloc, q_->callbacks);           \
+                                                                               \
+        return n >= 0 ? str : (struct cmc_string){ 0 };                        \
+    }                                                                          \
+                                                                               \
+    bool PFX##_print(struct SNAME *_queue_, FILE *fptr)                        \
+    {                                                                          \
+        size_t head =                                                          \
+            atomic_load_explicit(&_queue_->head, memory_order_relaxed);        \
+        size_t tail =                                                          \
+            atomic_load_explicit(&_queue_->tail, memory_order_relaxed);        \
+                                                                               \
+        for (size_t i = head; i != tail; i++)                                  \
+        {                                                                      \
+            if (!_queue_->f_val->str(                                          \
+                    fptr, _queue_->buffer[i & (_queue_->capacity - 1)]))       \
+                return false;                                                  \
+        }                                                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Rounds the capacity up to a power of two, or returns 0 if it can't */   \
+    static size_t PFX##_impl_capacity(size_t capacity)                         \
+    {                                                                          \
+        size_t result = 1;                                                     \
+                                                                               \
+        while (result < capacity)                                              \
+        {                                                                      \
+            if (result > SIZE_MAX / 2)                                         \
+                return 0;                                                      \
+                                                                               \
+            result *= 2;                                                       \
+        }                                                                      \
+                                                                               \
+        return result;                                                         \
+    }
+
+#endif /* CMC_SPSCQUEUE_H */
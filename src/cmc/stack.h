@@ -32,6 +32,7 @@
  * Core functionalities of the C Macro Collections Library
  * ------------------------------------------------------------------------- */
 #include "../cor/core.h"
+#include "../cor/search.h"
 
 /* -------------------------------------------------------------------------
  * Stack specific
@@ -51,6 +52,12 @@ static const char *cmc_string_fmt_stack = "struct %s<%s> "
     CMC_GENERATE_STACK_HEADER(PFX, SNAME, V) \
     CMC_GENERATE_STACK_SOURCE(PFX, SNAME, V)
 
+/* Generates a Stack of plain old data, which is searched by comparing the */
+/* bytes of the elements instead of calling the comparator (see cor/search.h) */
+#define CMC_GENERATE_STACK_POD(PFX, SNAME, V) \
+    CMC_GENERATE_STACK_HEADER(PFX, SNAME, V)  \
+    CMC_GENERATE_STACK_SOURCE_POD(PFX, SNAME, V)
+
 #define CMC_WRAPGEN_STACK_HEADER(PFX, SNAME, K, V) \
     CMC_GENERATE_STACK_HEADER(PFX, SNAME, V)
 
@@ -85,6 +92,9 @@ static const char *cmc_string_fmt_stack = "struct %s<%s> "
                                                                               \
         /* Custom callback functions */                                       \
         struct cmc_callbacks *callbacks;                                      \
+                                                                              \
+        /* Growth policy of the buffer */                                     \
+        const struct cmc_growth *growth;                                      \
     };                                                                        \
                                                                               \
     /* Value struct function table */                                         \
@@ -136,6 +146,8 @@ static const char *cmc_string_fmt_stack = "struct %s<%s> "
     /* Customization of Allocation and Callbacks */                           \
     void PFX##_customize(struct SNAME *_stack_, struct cmc_alloc_node *alloc, \
                          struct cmc_callbacks *callbacks);                    \
+    void PFX##_set_growth(struct SNAME *_stack_,                              \
+                          const struct cmc_growth *growth);                   \
     /* Collection Input and Output */                                         \
     bool PFX##_push(struct SNAME *_stack_, V value);                          \
     bool PFX##_pop(struct SNAME *_stack_);                                    \
@@ -150,6 +162,8 @@ static const char *cmc_string_fmt_stack = "struct %s<%s> "
     int PFX##_flag(struct SNAME *_stack_);                                    \
     /* Collection Utility */                                                  \
     bool PFX##_resize(struct SNAME *_stack_, size_t capacity);                \
+    bool PFX##_reserve(struct SNAME *_stack_, size_t size);                   \
+    bool PFX##_shrink_to_fit(struct SNAME *_stack_);                          \
     struct SNAME *PFX##_copy_of(struct SNAME *_stack_);                       \
     bool PFX##_equals(struct SNAME *_stack1_, struct SNAME *_stack2_);        \
     struct cmc_string PFX##_to_string(struct SNAME *_stack_);                 \
@@ -178,7 +192,15 @@ static const char *cmc_string_fmt_stack = "struct %s<%s> "
 /* -------------------------------------------------------------------------
  * Source
  * ------------------------------------------------------------------------- */
-#define CMC_GENERATE_STACK_SOURCE(PFX, SNAME, V)                              \
+#define CMC_GENERATE_STACK_SOURCE(PFX, SNAME, V) \
+    CMC_GENERATE_SEARCH(PFX, V)                  \
+    CMC_GENERATE_STACK_CORE_SOURCE(PFX, SNAME, V)
+
+#define CMC_GENERATE_STACK_SOURCE_POD(PFX, SNAME, V) \
+    CMC_GENERATE_SEARCH_POD(PFX, V)                  \
+    CMC_GENERATE_STACK_CORE_SOURCE(PFX, SNAME, V)
+
+#define CMC_GENERATE_STACK_CORE_SOURCE(PFX, SNAME, V)                         \
                                                                               \
     /* Implementation Detail Functions */                                     \
     /* None */                                                                \
@@ -212,6 +234,7 @@ static const char *cmc_string_fmt_stack = "struct %s<%s> "
         _stack_->f_val = f_val;                                               \
         _stack_->alloc = alloc;                                               \
         _stack_->callbacks = NULL;                                            \
+        _stack_->growth = NULL;                                               \
                                                                               \
         return _stack_;                                                       \
     }                                                                         \
@@ -247,6 +270,7 @@ static const char *cmc_string_fmt_stack = "struct %s<%s> "
         _stack_->f_val = f_val;                                               \
         _stack_->alloc = alloc;                                               \
         _stack_->callbacks = callbacks;                                       \
+        _stack_->growth = NULL;                                               \
                                                                               \
         return _stack_;                                                       \
     }                                                                         \
@@ -290,11 +314,21 @@ static const char *cmc_string_fmt_stack = "struct %s<%s> "
         _stack_->flag = cmc_flags.OK;                                         \
     }                                                                         \
                                                                               \
+    /* Sets the growth policy used when the buffer is full (NULL for the */   \
+    /* default one) */                                                        \
+    void PFX##_set_growth(struct SNAME *_stack_,                              \
+                          const struct cmc_growth *growth)                    \
+    {                                                                         \
+        _stack_->growth = growth;                                             \
+                                                                              \
+        _stack_->flag = cmc_flags.OK;                                         \
+    }                                                                         \
+                                                                              \
     bool PFX##_push(struct SNAME *_stack_, V value)                           \
     {                                                                         \
         if (PFX##_full(_stack_))                                              \
         {                                                                     \
-            if (!PFX##_resize(_stack_, _stack_->capacity * 2))                \
+            if (!PFX##_reserve(_stack_, 1))                                   \
                 return false;                                                 \
         }                                                                     \
                                                                               \
@@ -346,16 +380,9 @@ static const char *cmc_string_fmt_stack = "struct %s<%s> "
     {                                                                         \
         _stack_->flag = cmc_flags.OK;                                         \
                                                                               \
-        bool result = false;                                                  \
-                                                                              \
-        for (size_t i = 0; i < _stack_->count; i++)                           \
-        {                                                                     \
-            if (_stack_->f_val->cmp(_stack_->buffer[i], value) == 0)          \
-            {                                                                 \
-                result = true;                                                \
-                break;                                                        \
-            }                                                                 \
-        }                                                                     \
+        bool result =                                                         \
+            PFX##_impl_search(_stack_->buffer, _stack_->count, value,         \
+                              _stack_->f_val->cmp) < _stack_->count;          \
                                                                               \
         if (_stack_->callbacks && _stack_->callbacks->read)                   \
             _stack_->callbacks->read();                                       \
@@ -408,8 +435,6 @@ static const char *cmc_string_fmt_stack = "struct %s<%s> "
             return false;                                                     \
         }                                                                     \
                                                                               \
-        /* TODO zero out new slots */                                         \
-                                                                              \
         _stack_->buffer = new_buffer;                                         \
         _stack_->capacity = capacity;                                         \
                                                                               \
@@ -423,6 +448,33 @@ static const char *cmc_string_fmt_stack = "struct %s<%s> "
         return true;                                                          \
     }                                                                         \
                                                                               \
+    /* Makes room for at least size more elements, growing the buffer */      \
+    /* according to the growth policy */                                      \
+    bool PFX##_reserve(struct SNAME *_stack_, size_t size)                    \
+    {                                                                         \
+        _stack_->flag = cmc_flags.OK;                                         \
+                                                                              \
+        if (size <= _stack_->capacity - _stack_->count)                       \
+            return true;                                                      \
+                                                                              \
+        if (size > SIZE_MAX - _stack_->count)                                 \
+        {                                                                     \
+            _stack_->flag = cmc_flags.ERROR;                                  \
+            return false;                                                     \
+        }                                                                     \
+                                                                              \
+        return PFX##_resize(                                                  \
+            _stack_, cmc_growth_capacity(_stack_->growth, _stack_->capacity,  \
+                                         _stack_->count + size));             \
+    }                                                                         \
+                                                                              \
+    /* Reduces the capacity to the amount of elements */                      \
+    bool PFX##_shrink_to_fit(struct SNAME *_stack_)                           \
+    {                                                                         \
+        return PFX##_resize(_stack_,                                          \
+                            _stack_->count > 0 ? _stack_->count : 1);         \
+    }                                                                         \
+                                                                              \
     struct SNAME *PFX##_copy_of(struct SNAME *_stack_)                        \
     {                                                                         \
         struct SNAME *result =                                                \
@@ -445,6 +497,7 @@ static const char *cmc_string_fmt_stack = "struct %s<%s> "
                    sizeof(V) * _stack_->count);                               \
                                                                               \
         result->count = _stack_->count;                                       \
+        result->growth = _stack_->growth;                                     \
                                                                               \
         _stack_->flag = cmc_flags.OK;                                         \
                                                                               \
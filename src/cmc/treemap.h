@@ -90,6 +90,9 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
         /* Node height used by the AVL tree to keep it strictly balanced */   \
         unsigned char height;                                                 \
                                                                               \
+        /* Amount of nodes in the subtree rooted at this node */              \
+        size_t size;                                                          \
+                                                                              \
         /* Right child node or subtree */                                     \
         struct SNAME##_node *right;                                           \
                                                                               \
@@ -176,6 +179,9 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
     struct SNAME *PFX##_new_custom(                                           \
         struct SNAME##_fkey *f_key, struct SNAME##_fval *f_val,               \
         struct cmc_alloc_node *alloc, struct cmc_callbacks *callbacks);       \
+    struct SNAME *PFX##_from_sorted(K *keys, V *values, size_t count,         \
+                                    struct SNAME##_fkey *f_key,               \
+                                    struct SNAME##_fval *f_val);              \
     void PFX##_clear(struct SNAME *_map_);                                    \
     void PFX##_free(struct SNAME *_map_);                                     \
     /* Customization of Allocation and Callbacks */                           \
@@ -185,13 +191,18 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
     bool PFX##_insert(struct SNAME *_map_, K key, V value);                   \
     bool PFX##_update(struct SNAME *_map_, K key, V new_value, V *old_value); \
     bool PFX##_remove(struct SNAME *_map_, K key, V *out_value);              \
+    size_t PFX##_remove_range(struct SNAME *_map_, K from, K to);             \
     /* Element Access */                                                      \
     bool PFX##_max(struct SNAME *_map_, K *key, V *value);                    \
     bool PFX##_min(struct SNAME *_map_, K *key, V *value);                    \
     V PFX##_get(struct SNAME *_map_, K key);                                  \
     V *PFX##_get_ref(struct SNAME *_map_, K key);                             \
+    bool PFX##_select(struct SNAME *_map_, size_t index, K *key, V *value);   \
+    bool PFX##_floor(struct SNAME *_map_, K key, K *out_key, V *out_value);   \
+    bool PFX##_ceiling(struct SNAME *_map_, K key, K *out_key, V *out_value); \
     /* Collection State */                                                    \
     bool PFX##_contains(struct SNAME *_map_, K key);                          \
+    size_t PFX##_rank(struct SNAME *_map_, K key);                            \
     bool PFX##_empty(struct SNAME *_map_);                                    \
     size_t PFX##_count(struct SNAME *_map_);                                  \
     int PFX##_flag(struct SNAME *_map_);                                      \
@@ -205,6 +216,10 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
     /* Iterator Initialization */                                             \
     struct SNAME##_iter PFX##_iter_start(struct SNAME *target);               \
     struct SNAME##_iter PFX##_iter_end(struct SNAME *target);                 \
+    struct SNAME##_iter PFX##_iter_from(struct SNAME *target, K key);         \
+    struct SNAME##_iter PFX##_iter_range(struct SNAME *target, K from, K to); \
+    struct SNAME##_iter PFX##_lower_bound(struct SNAME *target, K key);       \
+    struct SNAME##_iter PFX##_upper_bound(struct SNAME *target, K key);       \
     /* Iterator State */                                                      \
     bool PFX##_iter_at_start(struct SNAME##_iter *iter);                      \
     bool PFX##_iter_at_end(struct SNAME##_iter *iter);                        \
@@ -232,8 +247,26 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
                                                     K key, V value);           \
     static struct SNAME##_node *PFX##_impl_get_node(struct SNAME *_map_,       \
                                                     K key);                    \
+    static struct SNAME##_node *PFX##_impl_floor(struct SNAME *_map_, K key,   \
+                                                 bool inclusive);              \
+    static struct SNAME##_node *PFX##_impl_ceiling(struct SNAME *_map_, K key, \
+                                                   bool inclusive);            \
+    static void PFX##_impl_remove_node(struct SNAME *_map_,                    \
+                                       struct SNAME##_node *node);             \
     static unsigned char PFX##_impl_h(struct SNAME##_node *node);              \
     static unsigned char PFX##_impl_hupdate(struct SNAME##_node *node);        \
+    static size_t PFX##_impl_size(struct SNAME##_node *node);                  \
+    static size_t PFX##_impl_supdate(struct SNAME##_node *node);               \
+    static size_t PFX##_impl_index_of(struct SNAME##_node *node);              \
+    static struct SNAME##_node *PFX##_impl_select(struct SNAME##_node *node,   \
+                                                  size_t index);               \
+    static struct SNAME##_node *PFX##_impl_to_list(struct SNAME##_node *root); \
+    static struct SNAME##_node *PFX##_impl_build(struct SNAME##_node **list,   \
+                                                 size_t count);                \
+    static struct SNAME##_node *PFX##_impl_sort_list(                          \
+        struct SNAME *_map_, struct SNAME##_node *head, size_t count);         \
+    static struct SNAME##_iter PFX##_impl_iter_at(struct SNAME *target,        \
+                                                  struct SNAME##_node *node);  \
     static void PFX##_impl_rotate_right(struct SNAME##_node **Z);              \
     static void PFX##_impl_rotate_left(struct SNAME##_node **Z);               \
     static void PFX##_impl_rebalance(struct SNAME *_map_,                      \
@@ -289,6 +322,89 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
         return _map_;                                                          \
     }                                                                          \
                                                                                \
+    /* Creates a tree out of count keys and values. If the keys are sorted */  \
+    /* in ascending order the tree is built in O(n), otherwise they are */     \
+    /* sorted first. Repeated keys are only added once, keeping the first */   \
+    /* value, like PFX##_insert would. The tree owns every key and value */    \
+    /* given to it, so the ones that are not added are passed to the free */   \
+    /* functions of f_key and f_val. */                                        \
+    struct SNAME *PFX##_from_sorted(K *keys, V *values, size_t count,          \
+                                    struct SNAME##_fkey *f_key,                \
+                                    struct SNAME##_fval *f_val)                \
+    {                                                                          \
+        struct SNAME *_map_ = PFX##_new(f_key, f_val);                         \
+                                                                               \
+        if (!_map_)                                                            \
+            return NULL;                                                       \
+                                                                               \
+        /* The nodes are linked through their right pointers */                \
+        struct SNAME##_node *head = NULL, *tail = NULL;                        \
+                                                                               \
+        bool sorted = true;                                                    \
+                                                                               \
+        for (size_t i = 0; i < count; i++)                                     \
+        {                                                                      \
+            struct SNAME##_node *node =                                        \
+                PFX##_impl_new_node(_map_, keys[i], values[i]);                \
+                                                                               \
+            if (!node)                                                         \
+            {                                                                  \
+                while (head != NULL)                                           \
+                {                                                              \
+                    tail = head->right;                                        \
+                    _map_->alloc->free(head);                                  \
+                    head = tail;                                               \
+                }                                                              \
+                                                                               \
+                PFX##_free(_map_);                                             \
+                                                                               \
+                return NULL;                                                   \
+            }                                                                  \
+                                                                               \
+            if (tail != NULL)                                                  \
+            {                                                                  \
+                if (_map_->f_key->cmp(tail->key, node->key) >= 0)              \
+                    sorted = false;                                            \
+                                                                               \
+                tail->right = node;                                            \
+            }                                                                  \
+            else                                                               \
+                head = node;                                                   \
+                                                                               \
+            tail = node;                                                       \
+        }                                                                      \
+                                                                               \
+        if (!sorted)                                                           \
+        {                                                                      \
+            head = PFX##_impl_sort_list(_map_, head, count);                   \
+                                                                               \
+            /* The sort is stable so the first of the repeated keys stays */   \
+            for (struct SNAME##_node *scan = head; scan->right != NULL;)       \
+            {                                                                  \
+                struct SNAME##_node *next = scan->right;                       \
+                                                                               \
+                if (_map_->f_key->cmp(scan->key, next->key) == 0)              \
+                {                                                              \
+                    if (_map_->f_key->free)                                    \
+                        _map_->f_key->free(next->key);                         \
+                    if (_map_->f_val->free)                                    \
+                        _map_->f_val->free(next->value);                       \
+                                                                               \
+                    scan->right = next->right;                                 \
+                    _map_->alloc->free(next);                                  \
+                    count--;                                                   \
+                }                                                              \
+                else                                                           \
+                    scan = next;                                               \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        _map_->root = PFX##_impl_build(&head, count);                          \
+        _map_->count = count;                                                  \
+                                                                               \
+        return _map_;                                                          \
+    }                                                                          \
+                                                                               \
     void PFX##_clear(struct SNAME *_map_)                                      \
     {                                                                          \
         struct SNAME##_node *scan = _map_->root;                               \
@@ -490,124 +606,87 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
         if (out_value)                                                         \
             *out_value = node->value;                                          \
                                                                                \
-        struct SNAME##_node *temp = NULL, *unbalanced = NULL;                  \
+        PFX##_impl_remove_node(_map_, node);                                   \
                                                                                \
-        bool is_root = node->parent == NULL;                                   \
+        if (_map_->count == 0)                                                 \
+            _map_->root = NULL;                                                \
                                                                                \
-        if (node->left == NULL && node->right == NULL)                         \
-        {                                                                      \
-            if (is_root)                                                       \
-                _map_->root = NULL;                                            \
-            else                                                               \
-            {                                                                  \
-                unbalanced = node->parent;                                     \
+        _map_->count--;                                                        \
+        _map_->flag = cmc_flags.OK;                                            \
                                                                                \
-                if (node->parent->right == node)                               \
-                    node->parent->right = NULL;                                \
-                else                                                           \
-                    node->parent->left = NULL;                                 \
-            }                                                                  \
+        if (_map_->callbacks && _map_->callbacks->delete)                      \
+            _map_->callbacks->delete ();                                       \
                                                                                \
-            _map_->alloc->free(node);                                          \
-        }                                                                      \
-        else if (node->left == NULL)                                           \
-        {                                                                      \
-            if (is_root)                                                       \
-            {                                                                  \
-                _map_->root = node->right;                                     \
-                _map_->root->parent = NULL;                                    \
-            }                                                                  \
-            else                                                               \
-            {                                                                  \
-                unbalanced = node->parent;                                     \
+        return true;                                                           \
+    }                                                                          \
                                                                                \
-                node->right->parent = node->parent;                            \
+    /* Removes all keys in the range [from, to). Since the removed keys and */ \
+    /* values can't be returned, they are freed with the free functions */     \
+    /* from the function tables, if they are available. Returns the amount */  \
+    /* of keys that were removed. */                                           \
+    size_t PFX##_remove_range(struct SNAME *_map_, K from, K to)               \
+    {                                                                          \
+        _map_->flag = cmc_flags.OK;                                            \
                                                                                \
-                if (node->parent->right == node)                               \
-                    node->parent->right = node->right;                         \
-                else                                                           \
-                    node->parent->left = node->right;                          \
-            }                                                                  \
+        struct SNAME##_node *first = PFX##_impl_ceiling(_map_, from, true);    \
                                                                                \
-            _map_->alloc->free(node);                                          \
-        }                                                                      \
-        else if (node->right == NULL)                                          \
-        {                                                                      \
-            if (is_root)                                                       \
-            {                                                                  \
-                _map_->root = node->left;                                      \
-                _map_->root->parent = NULL;                                    \
-            }                                                                  \
-            else                                                               \
-            {                                                                  \
-                unbalanced = node->parent;                                     \
+        if (!first || _map_->f_key->cmp(first->key, to) >= 0)                  \
+            return 0;                                                          \
                                                                                \
-                node->left->parent = node->parent;                             \
+        struct SNAME##_node *last = PFX##_impl_floor(_map_, to, false);        \
                                                                                \
-                if (node->parent->right == node)                               \
-                    node->parent->right = node->left;                          \
-                else                                                           \
-                    node->parent->left = node->left;                           \
-            }                                                                  \
+        size_t index = PFX##_impl_index_of(first);                             \
+        size_t total = PFX##_impl_index_of(last) - index + 1;                  \
                                                                                \
-            _map_->alloc->free(node);                                          \
+        /* Removing the nodes one by one costs O(k log n) while rebuilding */  \
+        /* the tree costs O(n), so pick whichever is cheaper */                \
+        if (total * PFX##_impl_h(_map_->root) < _map_->count)                  \
+        {                                                                      \
+            for (size_t i = 0; i < total; i++)                                 \
+            {                                                                  \
+                struct SNAME##_node *node =                                    \
+                    PFX##_impl_select(_map_->root, index);                     \
+                                                                               \
+                if (_map_->f_key->free)                                        \
+                    _map_->f_key->free(node->key);                             \
+                if (_map_->f_val->free)                                        \
+                    _map_->f_val->free(node->value);                           \
+                PFX##_impl_remove_node(_map_, node);                           \
+            }                                                                  \
         }                                                                      \
         else                                                                   \
         {                                                                      \
-            temp = node->right;                                                \
-            while (temp->left != NULL)                                         \
-                temp = temp->left;                                             \
+            struct SNAME##_node *head = PFX##_impl_to_list(_map_->root);       \
+            struct SNAME##_node **link = &head;                                \
                                                                                \
-            K temp_key = temp->key;                                            \
-            V temp_val = temp->value;                                          \
+            while (*link != first)                                             \
+                link = &(*link)->right;                                        \
                                                                                \
-            unbalanced = temp->parent;                                         \
-                                                                               \
-            if (temp->left == NULL && temp->right == NULL)                     \
+            for (size_t i = 0; i < total; i++)                                 \
             {                                                                  \
-                if (temp->parent->right == temp)                               \
-                    temp->parent->right = NULL;                                \
-                else                                                           \
-                    temp->parent->left = NULL;                                 \
-            }                                                                  \
-            else if (temp->left == NULL)                                       \
-            {                                                                  \
-                temp->right->parent = temp->parent;                            \
+                struct SNAME##_node *node = *link;                             \
                                                                                \
-                if (temp->parent->right == temp)                               \
-                    temp->parent->right = temp->right;                         \
-                else                                                           \
-                    temp->parent->left = temp->right;                          \
-            }                                                                  \
-            else if (temp->right == NULL)                                      \
-            {                                                                  \
-                temp->left->parent = temp->parent;                             \
+                *link = node->right;                                           \
                                                                                \
-                if (temp->parent->right == temp)                               \
-                    temp->parent->right = temp->left;                          \
-                else                                                           \
-                    temp->parent->left = temp->left;                           \
+                if (_map_->f_key->free)                                        \
+                    _map_->f_key->free(node->key);                             \
+                if (_map_->f_val->free)                                        \
+                    _map_->f_val->free(node->value);                           \
+                _map_->alloc->free(node);                                      \
             }                                                                  \
                                                                                \
-            _map_->alloc->free(temp);                                          \
+            _map_->root = PFX##_impl_build(&head, _map_->count - total);       \
                                                                                \
-            node->key = temp_key;                                              \
-            node->value = temp_val;                                            \
+            if (_map_->root != NULL)                                           \
+                _map_->root->parent = NULL;                                    \
         }                                                                      \
                                                                                \
-        if (unbalanced != NULL)                                                \
-            PFX##_impl_rebalance(_map_, unbalanced);                           \
-                                                                               \
-        if (_map_->count == 0)                                                 \
-            _map_->root = NULL;                                                \
-                                                                               \
-        _map_->count--;                                                        \
-        _map_->flag = cmc_flags.OK;                                            \
+        _map_->count -= total;                                                 \
                                                                                \
         if (_map_->callbacks && _map_->callbacks->delete)                      \
             _map_->callbacks->delete ();                                       \
                                                                                \
-        return true;                                                           \
+        return total;                                                          \
     }                                                                          \
                                                                                \
     bool PFX##_max(struct SNAME *_map_, K *key, V *value)                      \
@@ -710,6 +789,95 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
         return &(node->value);                                                 \
     }                                                                          \
                                                                                \
+    bool PFX##_select(struct SNAME *_map_, size_t index, K *key, V *value)     \
+    {                                                                          \
+        if (PFX##_empty(_map_))                                                \
+        {                                                                      \
+            _map_->flag = cmc_flags.EMPTY;                                     \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (index >= _map_->count)                                             \
+        {                                                                      \
+            _map_->flag = cmc_flags.RANGE;                                     \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        struct SNAME##_node *node = PFX##_impl_select(_map_->root, index);     \
+                                                                               \
+        if (key)                                                               \
+            *key = node->key;                                                  \
+        if (value)                                                             \
+            *value = node->value;                                              \
+                                                                               \
+        _map_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        if (_map_->callbacks && _map_->callbacks->read)                        \
+            _map_->callbacks->read();                                          \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Greatest key that is less than or equal to the given key */             \
+    bool PFX##_floor(struct SNAME *_map_, K key, K *out_key, V *out_value)     \
+    {                                                                          \
+        if (PFX##_empty(_map_))                                                \
+        {                                                                      \
+            _map_->flag = cmc_flags.EMPTY;                                     \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        struct SNAME##_node *node = PFX##_impl_floor(_map_, key, true);        \
+                                                                               \
+        if (!node)                                                             \
+        {                                                                      \
+            _map_->flag = cmc_flags.NOT_FOUND;                                 \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (out_key)                                                           \
+            *out_key = node->key;                                              \
+        if (out_value)                                                         \
+            *out_value = node->value;                                          \
+                                                                               \
+        _map_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        if (_map_->callbacks && _map_->callbacks->read)                        \
+            _map_->callbacks->read();                                          \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Least key that is greater than or equal to the given key */             \
+    bool PFX##_ceiling(struct SNAME *_map_, K key, K *out_key, V *out_value)   \
+    {                                                                          \
+        if (PFX##_empty(_map_))                                                \
+        {                                                                      \
+            _map_->flag = cmc_flags.EMPTY;                                     \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        struct SNAME##_node *node = PFX##_impl_ceiling(_map_, key, true);      \
+                                                                               \
+        if (!node)                                                             \
+        {                                                                      \
+            _map_->flag = cmc_flags.NOT_FOUND;                                 \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (out_key)                                                           \
+            *out_key = node->key;                                              \
+        if (out_value)                                                         \
+            *out_value = node->value;                                          \
+                                                                               \
+        _map_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        if (_map_->callbacks && _map_->callbacks->read)                        \
+            _map_->callbacks->read();                                          \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
     bool PFX##_contains(struct SNAME *_map_, K key)                            \
     {                                                                          \
         bool result = PFX##_impl_get_node(_map_, key) != NULL;                 \
@@ -720,6 +888,31 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
         return result;                                                         \
     }                                                                          \
                                                                                \
+    /* Returns the amount of keys that are less than the given key */          \
+    size_t PFX##_rank(struct SNAME *_map_, K key)                              \
+    {                                                                          \
+        size_t rank = 0;                                                       \
+        struct SNAME##_node *scan = _map_->root;                               \
+                                                                               \
+        while (scan != NULL)                                                   \
+        {                                                                      \
+            if (_map_->f_key->cmp(scan->key, key) < 0)                         \
+            {                                                                  \
+                rank += PFX##_impl_size(scan->left) + 1;                       \
+                scan = scan->right;                                            \
+            }                                                                  \
+            else                                                               \
+                scan = scan->left;                                             \
+        }                                                                      \
+                                                                               \
+        _map_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        if (_map_->callbacks && _map_->callbacks->read)                        \
+            _map_->callbacks->read();                                          \
+                                                                               \
+        return rank;                                                           \
+    }                                                                          \
+                                                                               \
     bool PFX##_empty(struct SNAME *_map_)                                      \
     {                                                                          \
         return _map_->count == 0;                                              \
@@ -906,6 +1099,59 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
         return iter;                                                           \
     }                                                                          \
                                                                                \
+    /* Iterates over the keys that are greater than or equal to key */         \
+    struct SNAME##_iter PFX##_iter_from(struct SNAME *target, K key)           \
+    {                                                                          \
+        struct SNAME##_iter iter = PFX##_iter_start(target);                   \
+                                                                               \
+        iter.first = PFX##_impl_ceiling(target, key, true);                    \
+                                                                               \
+        if (!iter.first)                                                       \
+            iter.last = NULL;                                                  \
+                                                                               \
+        iter.cursor = iter.first;                                              \
+        iter.end = iter.first == NULL;                                         \
+                                                                               \
+        return iter;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Iterates over the keys in the range [from, to) */                       \
+    struct SNAME##_iter PFX##_iter_range(struct SNAME *target, K from, K to)   \
+    {                                                                          \
+        struct SNAME##_iter iter = PFX##_iter_start(target);                   \
+                                                                               \
+        iter.first = PFX##_impl_ceiling(target, from, true);                   \
+        iter.last = PFX##_impl_floor(target, to, false);                       \
+                                                                               \
+        if (!iter.first || !iter.last ||                                       \
+            target->f_key->cmp(iter.first->key, iter.last->key) > 0)           \
+        {                                                                      \
+            iter.first = NULL;                                                 \
+            iter.last = NULL;                                                  \
+        }                                                                      \
+                                                                               \
+        iter.cursor = iter.first;                                              \
+        iter.end = iter.first == NULL;                                         \
+                                                                               \
+        return iter;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Iterator over the whole collection positioned at the first key that */  \
+    /* is greater than or equal to key, or at the end if there is none */      \
+    struct SNAME##_iter PFX##_lower_bound(struct SNAME *target, K key)         \
+    {                                                                          \
+        return PFX##_impl_iter_at(target,                                      \
+                                  PFX##_impl_ceiling(target, key, true));      \
+    }                                                                          \
+                                                                               \
+    /* Iterator over the whole collection positioned at the first key that */  \
+    /* is greater than key, or at the end if there is none */                  \
+    struct SNAME##_iter PFX##_upper_bound(struct SNAME *target, K key)         \
+    {                                                                          \
+        return PFX##_impl_iter_at(target,                                      \
+                                  PFX##_impl_ceiling(target, key, false));     \
+    }                                                                          \
+                                                                               \
     bool PFX##_iter_at_start(struct SNAME##_iter *iter)                        \
     {                                                                          \
         return PFX##_empty(iter->target) || iter->start;                       \
@@ -918,7 +1164,7 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
                                                                                \
     bool PFX##_iter_to_start(struct SNAME##_iter *iter)                        \
     {                                                                          \
-        if (!PFX##_empty(iter->target))                                        \
+        if (iter->first != NULL)                                               \
         {                                                                      \
             iter->index = 0;                                                   \
             iter->start = true;                                                \
@@ -933,9 +1179,10 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
                                                                                \
     bool PFX##_iter_to_end(struct SNAME##_iter *iter)                          \
     {                                                                          \
-        if (!PFX##_empty(iter->target))                                        \
+        if (iter->first != NULL)                                               \
         {                                                                      \
-            iter->index = iter->target->count - 1;                             \
+            iter->index = PFX##_impl_index_of(iter->last) -                    \
+                          PFX##_impl_index_of(iter->first);                    \
             iter->start = PFX##_empty(iter->target);                           \
             iter->end = true;                                                  \
             iter->cursor = iter->last;                                         \
@@ -1038,11 +1285,16 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
             return false;                                                      \
         }                                                                      \
                                                                                \
-        if (steps == 0 || iter->index + steps >= iter->target->count)          \
+        size_t index = PFX##_impl_index_of(iter->cursor);                      \
+                                                                               \
+        /* The iteration might stop before the last node of the tree */        \
+        if (steps == 0 || index + steps > PFX##_impl_index_of(iter->last))     \
             return false;                                                      \
                                                                                \
-        for (size_t i = 0; i < steps; i++)                                     \
-            PFX##_iter_next(iter);                                             \
+        /* Jumps straight to the target node using the subtree sizes */        \
+        iter->cursor = PFX##_impl_select(iter->target->root, index + steps);   \
+        iter->index += steps;                                                  \
+        iter->start = PFX##_empty(iter->target);                               \
                                                                                \
         return true;                                                           \
     }                                                                          \
@@ -1062,8 +1314,12 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
         if (steps == 0 || iter->index < steps)                                 \
             return false;                                                      \
                                                                                \
-        for (size_t i = 0; i < steps; i++)                                     \
-            PFX##_iter_prev(iter);                                             \
+        /* Jumps straight to the target node using the subtree sizes */        \
+        size_t index = PFX##_impl_index_of(iter->cursor) - steps;              \
+                                                                               \
+        iter->cursor = PFX##_impl_select(iter->target->root, index);           \
+        iter->index -= steps;                                                  \
+        iter->end = PFX##_empty(iter->target);                                 \
                                                                                \
         return true;                                                           \
     }                                                                          \
@@ -1085,7 +1341,7 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
                                                                                \
     K PFX##_iter_key(struct SNAME##_iter *iter)                                \
     {                                                                          \
-        if (PFX##_empty(iter->target))                                         \
+        if (iter->cursor == NULL)                                              \
             return (K){ 0 };                                                   \
                                                                                \
         return iter->cursor->key;                                              \
@@ -1093,7 +1349,7 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
                                                                                \
     V PFX##_iter_value(struct SNAME##_iter *iter)                              \
     {                                                                          \
-        if (PFX##_empty(iter->target))                                         \
+        if (iter->cursor == NULL)                                              \
             return (V){ 0 };                                                   \
                                                                                \
         return iter->cursor->value;                                            \
@@ -1101,7 +1357,7 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
                                                                                \
     V *PFX##_iter_rvalue(struct SNAME##_iter *iter)                            \
     {                                                                          \
-        if (PFX##_empty(iter->target))                                         \
+        if (iter->cursor == NULL)                                              \
             return NULL;                                                       \
                                                                                \
         return &(iter->cursor->value);                                         \
@@ -1127,6 +1383,7 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
         node->left = NULL;                                                     \
         node->parent = NULL;                                                   \
         node->height = 0;                                                      \
+        node->size = 1;                                                        \
                                                                                \
         return node;                                                           \
     }                                                                          \
@@ -1149,6 +1406,166 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
         return NULL;                                                           \
     }                                                                          \
                                                                                \
+    /* Node with the greatest key that is less than (or equal to, if */        \
+    /* inclusive) the given key */                                             \
+    static struct SNAME##_node *PFX##_impl_floor(struct SNAME *_map_, K key,   \
+                                                 bool inclusive)               \
+    {                                                                          \
+        struct SNAME##_node *scan = _map_->root, *result = NULL;               \
+                                                                               \
+        while (scan != NULL)                                                   \
+        {                                                                      \
+            int c = _map_->f_key->cmp(scan->key, key);                         \
+                                                                               \
+            if (c < 0 || (c == 0 && inclusive))                                \
+            {                                                                  \
+                result = scan;                                                 \
+                scan = scan->right;                                            \
+            }                                                                  \
+            else                                                               \
+                scan = scan->left;                                             \
+        }                                                                      \
+                                                                               \
+        return result;                                                         \
+    }                                                                          \
+                                                                               \
+    /* Node with the least key that is greater than (or equal to, if */        \
+    /* inclusive) the given key */                                             \
+    static struct SNAME##_node *PFX##_impl_ceiling(struct SNAME *_map_, K key, \
+                                                   bool inclusive)             \
+    {                                                                          \
+        struct SNAME##_node *scan = _map_->root, *result = NULL;               \
+                                                                               \
+        while (scan != NULL)                                                   \
+        {                                                                      \
+            int c = _map_->f_key->cmp(scan->key, key);                         \
+                                                                               \
+            if (c > 0 || (c == 0 && inclusive))                                \
+            {                                                                  \
+                result = scan;                                                 \
+                scan = scan->left;                                             \
+            }                                                                  \
+            else                                                               \
+                scan = scan->right;                                            \
+        }                                                                      \
+                                                                               \
+        return result;                                                         \
+    }                                                                          \
+                                                                               \
+    /* Unlinks a node from the tree and rebalances it. If the node has two */  \
+    /* children its successor is unlinked instead and moved into it. */        \
+    static void PFX##_impl_remove_node(struct SNAME *_map_,                    \
+                                       struct SNAME##_node *node)              \
+    {                                                                          \
+        struct SNAME##_node *temp = NULL, *unbalanced = NULL;                  \
+                                                                               \
+        bool is_root = node->parent == NULL;                                   \
+                                                                               \
+        if (node->left == NULL && node->right == NULL)                         \
+        {                                                                      \
+            if (is_root)                                                       \
+                _map_->root = NULL;                                            \
+            else                                                               \
+            {                                                                  \
+                unbalanced = node->parent;                                     \
+                                                                               \
+                if (node->parent->right == node)                               \
+                    node->parent->right = NULL;                                \
+                else                                                           \
+                    node->parent->left = NULL;                                 \
+            }                                                                  \
+                                                                               \
+            _map_->alloc->free(node);                                          \
+        }                                                                      \
+        else if (node->left == NULL)                                           \
+        {                                                                      \
+            if (is_root)                                                       \
+            {                                                                  \
+                _map_->root = node->right;                                     \
+                _map_->root->parent = NULL;                                    \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                unbalanced = node->parent;                                     \
+                                                                               \
+                node->right->parent = node->parent;                            \
+                                                                               \
+                if (node->parent->right == node)                               \
+                    node->parent->right = node->right;                         \
+                else                                                           \
+                    node->parent->left = node->right;                          \
+            }                                                                  \
+                                                                               \
+            _map_->alloc->free(node);                                          \
+        }                                                                      \
+        else if (node->right == NULL)                                          \
+        {                                                                      \
+            if (is_root)                                                       \
+            {                                                                  \
+                _map_->root = node->left;                                      \
+                _map_->root->parent = NULL;                                    \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                unbalanced = node->parent;                                     \
+                                                                               \
+                node->left->parent = node->parent;                             \
+                                                                               \
+                if (node->parent->right == node)                               \
+                    node->parent->right = node->left;                          \
+                else                                                           \
+                    node->parent->left = node->left;                           \
+            }                                                                  \
+                                                                               \
+            _map_->alloc->free(node);                                          \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            temp = node->right;                                                \
+            while (temp->left != NULL)                                         \
+                temp = temp->left;                                             \
+                                                                               \
+            K temp_key = temp->key;                                            \
+            V temp_val = temp->value;                                          \
+                                                                               \
+            unbalanced = temp->parent;                                         \
+                                                                               \
+            if (temp->left == NULL && temp->right == NULL)                     \
+            {                                                                  \
+                if (temp->parent->right == temp)                               \
+                    temp->parent->right = NULL;                                \
+                else                                                           \
+                    temp->parent->left = NULL;                                 \
+            }                                                                  \
+            else if (temp->left == NULL)                                       \
+            {                                                                  \
+                temp->right->parent = temp->parent;                            \
+                                                                               \
+                if (temp->parent->right == temp)                               \
+                    temp->parent->right = temp->right;                         \
+                else                                                           \
+                    temp->parent->left = temp->right;                          \
+            }                                                                  \
+            else if (temp->right == NULL)                                      \
+            {                                                                  \
+                temp->left->parent = temp->parent;                             \
+                                                                               \
+                if (temp->parent->right == temp)                               \
+                    temp->parent->right = temp->left;                          \
+                else                                                           \
+                    temp->parent->left = temp->left;                           \
+            }                                                                  \
+                                                                               \
+            _map_->alloc->free(temp);                                          \
+                                                                               \
+            node->key = temp_key;                                              \
+            node->value = temp_val;                                            \
+        }                                                                      \
+                                                                               \
+        if (unbalanced != NULL)                                                \
+            PFX##_impl_rebalance(_map_, unbalanced);                           \
+    }                                                                          \
+                                                                               \
     static unsigned char PFX##_impl_h(struct SNAME##_node *node)               \
     {                                                                          \
         if (node == NULL)                                                      \
@@ -1168,6 +1585,176 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
         return 1 + (h_l > h_r ? h_l : h_r);                                    \
     }                                                                          \
                                                                                \
+    static size_t PFX##_impl_size(struct SNAME##_node *node)                   \
+    {                                                                          \
+        if (node == NULL)                                                      \
+            return 0;                                                          \
+                                                                               \
+        return node->size;                                                     \
+    }                                                                          \
+                                                                               \
+    static size_t PFX##_impl_supdate(struct SNAME##_node *node)                \
+    {                                                                          \
+        if (node == NULL)                                                      \
+            return 0;                                                          \
+                                                                               \
+        return 1 + PFX##_impl_size(node->left) + PFX##_impl_size(node->right); \
+    }                                                                          \
+                                                                               \
+    /* Position of a node in the sorted sequence of all nodes of the tree */   \
+    static size_t PFX##_impl_index_of(struct SNAME##_node *node)               \
+    {                                                                          \
+        size_t index = PFX##_impl_size(node->left);                            \
+                                                                               \
+        for (; node->parent != NULL; node = node->parent)                      \
+        {                                                                      \
+            if (node->parent->right == node)                                   \
+                index += PFX##_impl_size(node->parent->left) + 1;              \
+        }                                                                      \
+                                                                               \
+        return index;                                                          \
+    }                                                                          \
+                                                                               \
+    /* Node at the given position in the sorted sequence of the subtree */     \
+    static struct SNAME##_node *PFX##_impl_select(struct SNAME##_node *node,   \
+                                                  size_t index)                \
+    {                                                                          \
+        while (node != NULL)                                                   \
+        {                                                                      \
+            size_t left = PFX##_impl_size(node->left);                         \
+                                                                               \
+            if (index < left)                                                  \
+                node = node->left;                                             \
+            else if (index > left)                                             \
+            {                                                                  \
+                index -= left + 1;                                             \
+                node = node->right;                                            \
+            }                                                                  \
+            else                                                               \
+                break;                                                         \
+        }                                                                      \
+                                                                               \
+        return node;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Flattens a tree into a sorted list linked through the right pointers */ \
+    static struct SNAME##_node *PFX##_impl_to_list(struct SNAME##_node *root)  \
+    {                                                                          \
+        struct SNAME##_node *head = NULL, *tail = NULL, *scan = root;          \
+                                                                               \
+        while (scan != NULL)                                                   \
+        {                                                                      \
+            if (scan->left != NULL)                                            \
+            {                                                                  \
+                /* Rotate to the right until there is no left child */         \
+                struct SNAME##_node *left = scan->left;                        \
+                                                                               \
+                scan->left = left->right;                                      \
+                left->right = scan;                                            \
+                scan = left;                                                   \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                if (tail != NULL)                                              \
+                    tail->right = scan;                                        \
+                else                                                           \
+                    head = scan;                                               \
+                                                                               \
+                tail = scan;                                                   \
+                scan = scan->right;                                            \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        return head;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Builds a perfectly balanced tree out of the first count nodes of a */   \
+    /* sorted list, advancing the list past them */                            \
+    static struct SNAME##_node *PFX##_impl_build(struct SNAME##_node **list,   \
+                                                 size_t count)                 \
+    {                                                                          \
+        if (count == 0)                                                        \
+            return NULL;                                                       \
+                                                                               \
+        struct SNAME##_node *left = PFX##_impl_build(list, count / 2);         \
+        struct SNAME##_node *root = *list;                                     \
+                                                                               \
+        *list = root->right;                                                   \
+                                                                               \
+        root->left = left;                                                     \
+        root->right = PFX##_impl_build(list, count - count / 2 - 1);           \
+                                                                               \
+        if (root->left)                                                        \
+            root->left->parent = root;                                         \
+        if (root->right)                                                       \
+            root->right->parent = root;                                        \
+                                                                               \
+        root->height = PFX##_impl_hupdate(root);                               \
+        root->size = count;                                                    \
+                                                                               \
+        return root;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Stable merge sort of a list of count nodes linked through the right */  \
+    /* pointers */                                                             \
+    static struct SNAME##_node *PFX##_impl_sort_list(                          \
+        struct SNAME *_map_, struct SNAME##_node *head, size_t count)          \
+    {                                                                          \
+        if (count < 2)                                                         \
+            return head;                                                       \
+                                                                               \
+        struct SNAME##_node *middle = head;                                    \
+                                                                               \
+        for (size_t i = 1; i < count / 2; i++)                                 \
+            middle = middle->right;                                            \
+                                                                               \
+        struct SNAME##_node *right = middle->right;                            \
+                                                                               \
+        middle->right = NULL;                                                  \
+                                                                               \
+        struct SNAME##_node *left =                                            \
+            PFX##_impl_sort_list(_map_, head, count / 2);                      \
+                                                                               \
+        right = PFX##_impl_sort_list(_map_, right, count - count / 2);         \
+                                                                               \
+        struct SNAME##_node *result = NULL, **tail = &result;                  \
+                                                                               \
+        while (left != NULL && right != NULL)                                  \
+        {                                                                      \
+            if (_map_->f_key->cmp(right->key, left->key) < 0)                  \
+            {                                                                  \
+                *tail = right;                                                 \
+                right = right->right;                                          \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                *tail = left;                                                  \
+                left = left->right;                                            \
+            }                                                                  \
+                                                                               \
+            tail = &(*tail)->right;                                            \
+        }                                                                      \
+                                                                               \
+        *tail = left != NULL ? left : right;                                   \
+                                                                               \
+        return result;                                                         \
+    }                                                                          \
+                                                                               \
+    static struct SNAME##_iter PFX##_impl_iter_at(struct SNAME *target,        \
+                                                  struct SNAME##_node *node)   \
+    {                                                                          \
+        if (!node)                                                             \
+            return PFX##_iter_end(target);                                     \
+                                                                               \
+        struct SNAME##_iter iter = PFX##_iter_start(target);                   \
+                                                                               \
+        iter.cursor = node;                                                    \
+        iter.index = PFX##_impl_index_of(node);                                \
+        iter.start = iter.index == 0;                                          \
+                                                                               \
+        return iter;                                                           \
+    }                                                                          \
+                                                                               \
     static void PFX##_impl_rotate_right(struct SNAME##_node **Z)               \
     {                                                                          \
         struct SNAME##_node *root = *Z;                                        \
@@ -1194,6 +1781,9 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
         root->height = PFX##_impl_hupdate(root);                               \
         new_root->height = PFX##_impl_hupdate(new_root);                       \
                                                                                \
+        root->size = PFX##_impl_supdate(root);                                 \
+        new_root->size = PFX##_impl_supdate(new_root);                         \
+                                                                               \
         *Z = new_root;                                                         \
     }                                                                          \
                                                                                \
@@ -1223,6 +1813,9 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
         root->height = PFX##_impl_hupdate(root);                               \
         new_root->height = PFX##_impl_hupdate(new_root);                       \
                                                                                \
+        root->size = PFX##_impl_supdate(root);                                 \
+        new_root->size = PFX##_impl_supdate(new_root);                         \
+                                                                               \
         *Z = new_root;                                                         \
     }                                                                          \
                                                                                \
@@ -1240,6 +1833,7 @@ static const char *cmc_string_fmt_treemap = "struct %s<%s, %s> "
                 is_root = true;                                                \
                                                                                \
             scan->height = PFX##_impl_hupdate(scan);                           \
+            scan->size = PFX##_impl_supdate(scan);                             \
             balance = PFX##_impl_h(scan->right) - PFX##_impl_h(scan->left);    \
                                                                                \
             if (balance >= 2)                                                  \
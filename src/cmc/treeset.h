@@ -37,10 +37,23 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
                                             "alloc:%p, "
                                             "callbacks:%p }";
 
+/* Minimum amount of values in both sets for the parallel set operations */
+/* to split the work between threads */
+#ifndef CMC_TREESET_PARALLEL_CUTOFF
+#define CMC_TREESET_PARALLEL_CUTOFF 65536
+#endif /* CMC_TREESET_PARALLEL_CUTOFF */
+
 #define CMC_GENERATE_TREESET(PFX, SNAME, V)    \
     CMC_GENERATE_TREESET_HEADER(PFX, SNAME, V) \
     CMC_GENERATE_TREESET_SOURCE(PFX, SNAME, V)
 
+/* The parallel set operations depend on utl/thread.h, which must be */
+/* included before expanding them, and they must be expanded in the same */
+/* file as the SOURCE part of the TreeSet */
+#define CMC_GENERATE_TREESET_PARALLEL(PFX, SNAME, V)    \
+    CMC_GENERATE_TREESET_PARALLEL_HEADER(PFX, SNAME, V) \
+    CMC_GENERATE_TREESET_PARALLEL_SOURCE(PFX, SNAME, V)
+
 #define CMC_WRAPGEN_TREESET_HEADER(PFX, SNAME, K, V) \
     CMC_GENERATE_TREESET_HEADER(PFX, SNAME, V)
 
@@ -83,6 +96,9 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
         /* Node height used by the AVL tree to keep it strictly balanced */    \
         unsigned char height;                                                  \
                                                                                \
+        /* Amount of nodes in the subtree rooted at this node */               \
+        size_t size;                                                           \
+                                                                               \
         /* Right child node or subtree */                                      \
         struct SNAME##_node *right;                                            \
                                                                                \
@@ -146,6 +162,8 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
     struct SNAME *PFX##_new_custom(struct SNAME##_fval *f_val,                 \
                                    struct cmc_alloc_node *alloc,               \
                                    struct cmc_callbacks *callbacks);           \
+    struct SNAME *PFX##_from_sorted(V *values, size_t count,                   \
+                                    struct SNAME##_fval *f_val);               \
     void PFX##_clear(struct SNAME *_set_);                                     \
     void PFX##_free(struct SNAME *_set_);                                      \
     /* Customization of Allocation and Callbacks */                            \
@@ -154,11 +172,16 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
     /* Collection Input and Output */                                          \
     bool PFX##_insert(struct SNAME *_set_, V value);                           \
     bool PFX##_remove(struct SNAME *_set_, V value);                           \
+    size_t PFX##_remove_range(struct SNAME *_set_, V from, V to);              \
     /* Element Access */                                                       \
     bool PFX##_max(struct SNAME *_set_, V *value);                             \
     bool PFX##_min(struct SNAME *_set_, V *value);                             \
+    bool PFX##_select(struct SNAME *_set_, size_t index, V *value);            \
+    bool PFX##_floor(struct SNAME *_set_, V value, V *out_value);              \
+    bool PFX##_ceiling(struct SNAME *_set_, V value, V *out_value);            \
     /* Collection State */                                                     \
     bool PFX##_contains(struct SNAME *_set_, V value);                         \
+    size_t PFX##_rank(struct SNAME *_set_, V value);                           \
     bool PFX##_empty(struct SNAME *_set_);                                     \
     size_t PFX##_count(struct SNAME *_set_);                                   \
     int PFX##_flag(struct SNAME *_set_);                                       \
@@ -186,6 +209,10 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
     /* Iterator Initialization */                                              \
     struct SNAME##_iter PFX##_iter_start(struct SNAME *target);                \
     struct SNAME##_iter PFX##_iter_end(struct SNAME *target);                  \
+    struct SNAME##_iter PFX##_iter_from(struct SNAME *target, V value);        \
+    struct SNAME##_iter PFX##_iter_range(struct SNAME *target, V from, V to);  \
+    struct SNAME##_iter PFX##_lower_bound(struct SNAME *target, V value);      \
+    struct SNAME##_iter PFX##_upper_bound(struct SNAME *target, V value);      \
     /* Iterator State */                                                       \
     bool PFX##_iter_at_start(struct SNAME##_iter *iter);                       \
     bool PFX##_iter_at_end(struct SNAME##_iter *iter);                         \
@@ -216,13 +243,71 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
  * ------------------------------------------------------------------------- */
 #define CMC_GENERATE_TREESET_SOURCE(PFX, SNAME, V)                             \
                                                                                \
+    /* Merge of two sorted ranges of values into a sorted list of nodes */     \
+    struct SNAME##_impl_merge                                                  \
+    {                                                                          \
+        /* Set where the nodes are allocated */                                \
+        struct SNAME *result;                                                  \
+                                                                               \
+        /* Range of values of the first set */                                 \
+        struct SNAME##_iter iter1;                                             \
+                                                                               \
+        /* Range of values of the second set */                                \
+        struct SNAME##_iter iter2;                                             \
+                                                                               \
+        /* Keep the values that are only in the first set */                   \
+        bool only1;                                                            \
+                                                                               \
+        /* Keep the values that are in both sets */                            \
+        bool both;                                                             \
+                                                                               \
+        /* Keep the values that are only in the second set */                  \
+        bool only2;                                                            \
+                                                                               \
+        /* First node of the resulting list */                                 \
+        struct SNAME##_node *head;                                             \
+                                                                               \
+        /* Last node of the resulting list */                                  \
+        struct SNAME##_node *tail;                                             \
+                                                                               \
+        /* Amount of nodes in the resulting list */                            \
+        size_t count;                                                          \
+    };                                                                         \
+                                                                               \
     /* Implementation Detail Functions */                                      \
     static struct SNAME##_node *PFX##_impl_new_node(struct SNAME *_set_,       \
                                                     V value);                  \
     static struct SNAME##_node *PFX##_impl_get_node(struct SNAME *_set_,       \
                                                     V value);                  \
+    static struct SNAME##_node *PFX##_impl_floor(struct SNAME *_set_, V value, \
+                                                 bool inclusive);              \
+    static struct SNAME##_node *PFX##_impl_ceiling(struct SNAME *_set_,        \
+                                                   V value, bool inclusive);   \
+    static void PFX##_impl_remove_node(struct SNAME *_set_,                    \
+                                       struct SNAME##_node *node);             \
     static unsigned char PFX##_impl_h(struct SNAME##_node *node);              \
     static unsigned char PFX##_impl_hupdate(struct SNAME##_node *node);        \
+    static size_t PFX##_impl_size(struct SNAME##_node *node);                  \
+    static size_t PFX##_impl_supdate(struct SNAME##_node *node);               \
+    static size_t PFX##_impl_index_of(struct SNAME##_node *node);              \
+    static struct SNAME##_node *PFX##_impl_select(struct SNAME##_node *node,   \
+                                                  size_t index);               \
+    static struct SNAME##_node *PFX##_impl_to_list(struct SNAME##_node *root); \
+    static struct SNAME##_node *PFX##_impl_build(struct SNAME##_node **list,   \
+                                                 size_t count);                \
+    static struct SNAME##_node *PFX##_impl_sort_list(                          \
+        struct SNAME *_set_, struct SNAME##_node *head, size_t count);         \
+    static void PFX##_impl_free_list(struct SNAME *_set_,                      \
+                                     struct SNAME##_node *head);               \
+    static struct SNAME##_iter PFX##_impl_iter_at(struct SNAME *target,        \
+                                                  struct SNAME##_node *node);  \
+    static struct SNAME##_iter PFX##_impl_iter_range(                          \
+        struct SNAME *target, struct SNAME##_node *first,                      \
+        struct SNAME##_node *last);                                            \
+    static bool PFX##_impl_merge(struct SNAME##_impl_merge *merge);            \
+    static struct SNAME *PFX##_impl_set_operation(                             \
+        struct SNAME *_set1_, struct SNAME *_set2_, bool only1, bool both,     \
+        bool only2);                                                           \
     static void PFX##_impl_rotate_right(struct SNAME##_node **Z);              \
     static void PFX##_impl_rotate_left(struct SNAME##_node **Z);               \
     static void PFX##_impl_rebalance(struct SNAME *_set_,                      \
@@ -275,6 +360,78 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
         return _set_;                                                          \
     }                                                                          \
                                                                                \
+    /* Creates a tree out of count values. If the values are sorted */         \
+    /* in ascending order the tree is built in O(n), otherwise they are */     \
+    /* sorted first. Repeated values are only added once, like */              \
+    /* PFX##_insert would. The set owns every value given to it, so the */     \
+    /* ones that are not added are passed to the free function of f_val. */    \
+    struct SNAME *PFX##_from_sorted(V *values, size_t count,                   \
+                                    struct SNAME##_fval *f_val)                \
+    {                                                                          \
+        struct SNAME *_set_ = PFX##_new(f_val);                                \
+                                                                               \
+        if (!_set_)                                                            \
+            return NULL;                                                       \
+                                                                               \
+        /* The nodes are linked through their right pointers */                \
+        struct SNAME##_node *head = NULL, *tail = NULL;                        \
+                                                                               \
+        bool sorted = true;                                                    \
+                                                                               \
+        for (size_t i = 0; i < count; i++)                                     \
+        {                                                                      \
+            struct SNAME##_node *node = PFX##_impl_new_node(_set_, values[i]); \
+                                                                               \
+            if (!node)                                                         \
+            {                                                                  \
+                PFX##_impl_free_list(_set_, head);                             \
+                PFX##_free(_set_);                                             \
+                                                                               \
+                return NULL;                                                   \
+            }                                                                  \
+                                                                               \
+            if (tail != NULL)                                                  \
+            {                                                                  \
+                if (_set_->f_val->cmp(tail->value, node->value) >= 0)          \
+                    sorted = false;                                            \
+                                                                               \
+                tail->right = node;                                            \
+            }                                                                  \
+            else                                                               \
+                head = node;                                                   \
+                                                                               \
+            tail = node;                                                       \
+        }                                                                      \
+                                                                               \
+        if (!sorted)                                                           \
+        {                                                                      \
+            head = PFX##_impl_sort_list(_set_, head, count);                   \
+                                                                               \
+            /* The sort is stable so the first of the repeated values stays */ \
+            for (struct SNAME##_node *scan = head; scan->right != NULL;)       \
+            {                                                                  \
+                struct SNAME##_node *next = scan->right;                       \
+                                                                               \
+                if (_set_->f_val->cmp(scan->value, next->value) == 0)          \
+                {                                                              \
+                    if (_set_->f_val->free)                                    \
+                        _set_->f_val->free(next->value);                       \
+                                                                               \
+                    scan->right = next->right;                                 \
+                    _set_->alloc->free(next);                                  \
+                    count--;                                                   \
+                }                                                              \
+                else                                                           \
+                    scan = next;                                               \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        _set_->root = PFX##_impl_build(&head, count);                          \
+        _set_->count = count;                                                  \
+                                                                               \
+        return _set_;                                                          \
+    }                                                                          \
+                                                                               \
     void PFX##_clear(struct SNAME *_set_)                                      \
     {                                                                          \
         struct SNAME##_node *scan = _set_->root;                               \
@@ -446,122 +603,83 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
             return false;                                                      \
         }                                                                      \
                                                                                \
-        struct SNAME##_node *temp = NULL, *unbalanced = NULL;                  \
+        PFX##_impl_remove_node(_set_, node);                                   \
                                                                                \
-        bool is_root = node->parent == NULL;                                   \
+        if (_set_->count == 0)                                                 \
+            _set_->root = NULL;                                                \
                                                                                \
-        if (node->left == NULL && node->right == NULL)                         \
-        {                                                                      \
-            if (is_root)                                                       \
-                _set_->root = NULL;                                            \
-            else                                                               \
-            {                                                                  \
-                unbalanced = node->parent;                                     \
+        _set_->count--;                                                        \
+        _set_->flag = cmc_flags.OK;                                            \
                                                                                \
-                if (node->parent->right == node)                               \
-                    node->parent->right = NULL;                                \
-                else                                                           \
-                    node->parent->left = NULL;                                 \
-            }                                                                  \
+        if (_set_->callbacks && _set_->callbacks->delete)                      \
+            _set_->callbacks->delete ();                                       \
                                                                                \
-            _set_->alloc->free(node);                                          \
-        }                                                                      \
-        else if (node->left == NULL)                                           \
-        {                                                                      \
-            if (is_root)                                                       \
-            {                                                                  \
-                _set_->root = node->right;                                     \
-                _set_->root->parent = NULL;                                    \
-            }                                                                  \
-            else                                                               \
-            {                                                                  \
-                unbalanced = node->parent;                                     \
+        return true;                                                           \
+    }                                                                          \
                                                                                \
-                node->right->parent = node->parent;                            \
+    /* Removes all values in the range [from, to). Since the removed values */ \
+    /* can't be returned, they are freed with the free functions from the */   \
+    /* function tables, if they are available. Returns the amount of values */ \
+    /* that were removed. */                                                   \
+    size_t PFX##_remove_range(struct SNAME *_set_, V from, V to)               \
+    {                                                                          \
+        _set_->flag = cmc_flags.OK;                                            \
                                                                                \
-                if (node->parent->right == node)                               \
-                    node->parent->right = node->right;                         \
-                else                                                           \
-                    node->parent->left = node->right;                          \
-            }                                                                  \
+        struct SNAME##_node *first = PFX##_impl_ceiling(_set_, from, true);    \
                                                                                \
-            _set_->alloc->free(node);                                          \
-        }                                                                      \
-        else if (node->right == NULL)                                          \
+        if (!first || _set_->f_val->cmp(first->value, to) >= 0)                \
+            return 0;                                                          \
+                                                                               \
+        struct SNAME##_node *last = PFX##_impl_floor(_set_, to, false);        \
+                                                                               \
+        size_t index = PFX##_impl_index_of(first);                             \
+        size_t total = PFX##_impl_index_of(last) - index + 1;                  \
+                                                                               \
+        /* Removing the nodes one by one costs O(k log n) while rebuilding */  \
+        /* the tree costs O(n), so pick whichever is cheaper */                \
+        if (total * PFX##_impl_h(_set_->root) < _set_->count)                  \
         {                                                                      \
-            if (is_root)                                                       \
-            {                                                                  \
-                _set_->root = node->left;                                      \
-                _set_->root->parent = NULL;                                    \
-            }                                                                  \
-            else                                                               \
+            for (size_t i = 0; i < total; i++)                                 \
             {                                                                  \
-                unbalanced = node->parent;                                     \
-                                                                               \
-                node->left->parent = node->parent;                             \
+                struct SNAME##_node *node =                                    \
+                    PFX##_impl_select(_set_->root, index);                     \
                                                                                \
-                if (node->parent->right == node)                               \
-                    node->parent->right = node->left;                          \
-                else                                                           \
-                    node->parent->left = node->left;                           \
+                if (_set_->f_val->free)                                        \
+                    _set_->f_val->free(node->value);                           \
+                PFX##_impl_remove_node(_set_, node);                           \
             }                                                                  \
-                                                                               \
-            _set_->alloc->free(node);                                          \
         }                                                                      \
         else                                                                   \
         {                                                                      \
-            temp = node->right;                                                \
-            while (temp->left != NULL)                                         \
-                temp = temp->left;                                             \
-                                                                               \
-            V temp_value = temp->value;                                        \
+            struct SNAME##_node *head = PFX##_impl_to_list(_set_->root);       \
+            struct SNAME##_node **link = &head;                                \
                                                                                \
-            unbalanced = temp->parent;                                         \
+            while (*link != first)                                             \
+                link = &(*link)->right;                                        \
                                                                                \
-            if (temp->left == NULL && temp->right == NULL)                     \
-            {                                                                  \
-                if (temp->parent->right == temp)                               \
-                    temp->parent->right = NULL;                                \
-                else                                                           \
-                    temp->parent->left = NULL;                                 \
-            }                                                                  \
-            else if (temp->left == NULL)                                       \
+            for (size_t i = 0; i < total; i++)                                 \
             {                                                                  \
-                temp->right->parent = temp->parent;                            \
+                struct SNAME##_node *node = *link;                             \
                                                                                \
-                if (temp->parent->right == temp)                               \
-                    temp->parent->right = temp->right;                         \
-                else                                                           \
-                    temp->parent->left = temp->right;                          \
-            }                                                                  \
-            else if (temp->right == NULL)                                      \
-            {                                                                  \
-                temp->left->parent = temp->parent;                             \
+                *link = node->right;                                           \
                                                                                \
-                if (temp->parent->right == temp)                               \
-                    temp->parent->right = temp->left;                          \
-                else                                                           \
-                    temp->parent->left = temp->left;                           \
+                if (_set_->f_val->free)                                        \
+                    _set_->f_val->free(node->value);                           \
+                _set_->alloc->free(node);                                      \
             }                                                                  \
                                                                                \
-            _set_->alloc->free(temp);                                          \
+            _set_->root = PFX##_impl_build(&head, _set_->count - total);       \
                                                                                \
-            node->value = temp_value;                                          \
+            if (_set_->root != NULL)                                           \
+                _set_->root->parent = NULL;                                    \
         }                                                                      \
                                                                                \
-        if (unbalanced != NULL)                                                \
-            PFX##_impl_rebalance(_set_, unbalanced);                           \
-                                                                               \
-        if (_set_->count == 0)                                                 \
-            _set_->root = NULL;                                                \
-                                                                               \
-        _set_->count--;                                                        \
-        _set_->flag = cmc_flags.OK;                                            \
+        _set_->count -= total;                                                 \
                                                                                \
         if (_set_->callbacks && _set_->callbacks->delete)                      \
             _set_->callbacks->delete ();                                       \
                                                                                \
-        return true;                                                           \
+        return total;                                                          \
     }                                                                          \
                                                                                \
     bool PFX##_max(struct SNAME *_set_, V *value)                              \
@@ -612,6 +730,89 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
         return true;                                                           \
     }                                                                          \
                                                                                \
+    bool PFX##_select(struct SNAME *_set_, size_t index, V *value)             \
+    {                                                                          \
+        if (PFX##_empty(_set_))                                                \
+        {                                                                      \
+            _set_->flag = cmc_flags.EMPTY;                                     \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (index >= _set_->count)                                             \
+        {                                                                      \
+            _set_->flag = cmc_flags.RANGE;                                     \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        struct SNAME##_node *node = PFX##_impl_select(_set_->root, index);     \
+                                                                               \
+        if (value)                                                             \
+            *value = node->value;                                              \
+                                                                               \
+        _set_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        if (_set_->callbacks && _set_->callbacks->read)                        \
+            _set_->callbacks->read();                                          \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Greatest value that is less than or equal to the given value */         \
+    bool PFX##_floor(struct SNAME *_set_, V value, V *out_value)               \
+    {                                                                          \
+        if (PFX##_empty(_set_))                                                \
+        {                                                                      \
+            _set_->flag = cmc_flags.EMPTY;                                     \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        struct SNAME##_node *node = PFX##_impl_floor(_set_, value, true);      \
+                                                                               \
+        if (!node)                                                             \
+        {                                                                      \
+            _set_->flag = cmc_flags.NOT_FOUND;                                 \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (out_value)                                                         \
+            *out_value = node->value;                                          \
+                                                                               \
+        _set_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        if (_set_->callbacks && _set_->callbacks->read)                        \
+            _set_->callbacks->read();                                          \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Least value that is greater than or equal to the given value */         \
+    bool PFX##_ceiling(struct SNAME *_set_, V value, V *out_value)             \
+    {                                                                          \
+        if (PFX##_empty(_set_))                                                \
+        {                                                                      \
+            _set_->flag = cmc_flags.EMPTY;                                     \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        struct SNAME##_node *node = PFX##_impl_ceiling(_set_, value, true);    \
+                                                                               \
+        if (!node)                                                             \
+        {                                                                      \
+            _set_->flag = cmc_flags.NOT_FOUND;                                 \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (out_value)                                                         \
+            *out_value = node->value;                                          \
+                                                                               \
+        _set_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        if (_set_->callbacks && _set_->callbacks->read)                        \
+            _set_->callbacks->read();                                          \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
     bool PFX##_contains(struct SNAME *_set_, V value)                          \
     {                                                                          \
         bool result = PFX##_impl_get_node(_set_, value) != NULL;               \
@@ -622,6 +823,31 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
         return result;                                                         \
     }                                                                          \
                                                                                \
+    /* Returns the amount of values that are less than the given value */      \
+    size_t PFX##_rank(struct SNAME *_set_, V value)                            \
+    {                                                                          \
+        size_t rank = 0;                                                       \
+        struct SNAME##_node *scan = _set_->root;                               \
+                                                                               \
+        while (scan != NULL)                                                   \
+        {                                                                      \
+            if (_set_->f_val->cmp(scan->value, value) < 0)                     \
+            {                                                                  \
+                rank += PFX##_impl_size(scan->left) + 1;                       \
+                scan = scan->right;                                            \
+            }                                                                  \
+            else                                                               \
+                scan = scan->left;                                             \
+        }                                                                      \
+                                                                               \
+        _set_->flag = cmc_flags.OK;                                            \
+                                                                               \
+        if (_set_->callbacks && _set_->callbacks->read)                        \
+            _set_->callbacks->read();                                          \
+                                                                               \
+        return rank;                                                           \
+    }                                                                          \
+                                                                               \
     bool PFX##_empty(struct SNAME *_set_)                                      \
     {                                                                          \
         return _set_->count == 0;                                              \
@@ -741,105 +967,24 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
                                                                                \
     struct SNAME *PFX##_union(struct SNAME *_set1_, struct SNAME *_set2_)      \
     {                                                                          \
-        struct SNAME *_set_r_ =                                                \
-            PFX##_new_custom(_set1_->f_val, _set1_->alloc, _set1_->callbacks); \
-                                                                               \
-        if (!_set_r_)                                                          \
-            return NULL;                                                       \
-                                                                               \
-        struct SNAME##_iter iter1 = PFX##_iter_start(_set1_);                  \
-        struct SNAME##_iter iter2 = PFX##_iter_start(_set2_);                  \
-                                                                               \
-        for (; !PFX##_iter_at_end(&iter1); PFX##_iter_next(&iter1))            \
-        {                                                                      \
-            PFX##_insert(_set_r_, PFX##_iter_value(&iter1));                   \
-        }                                                                      \
-                                                                               \
-        for (; !PFX##_iter_at_end(&iter2); PFX##_iter_next(&iter2))            \
-        {                                                                      \
-            PFX##_insert(_set_r_, PFX##_iter_value(&iter2));                   \
-        }                                                                      \
-                                                                               \
-        return _set_r_;                                                        \
+        return PFX##_impl_set_operation(_set1_, _set2_, true, true, true);     \
     }                                                                          \
                                                                                \
     struct SNAME *PFX##_intersection(struct SNAME *_set1_,                     \
                                      struct SNAME *_set2_)                     \
     {                                                                          \
-        struct SNAME *_set_r_ =                                                \
-            PFX##_new_custom(_set1_->f_val, _set1_->alloc, _set1_->callbacks); \
-                                                                               \
-        if (!_set_r_)                                                          \
-            return NULL;                                                       \
-                                                                               \
-        /** TODO Should this compare count or capacity? */                     \
-        struct SNAME *_set_A_ =                                                \
-            _set1_->count < _set2_->count ? _set1_ : _set2_;                   \
-        struct SNAME *_set_B_ = _set_A_ == _set1_ ? _set2_ : _set1_;           \
-                                                                               \
-        struct SNAME##_iter iter = PFX##_iter_start(_set_A_);                  \
-                                                                               \
-        for (; !PFX##_iter_at_end(&iter); PFX##_iter_next(&iter))              \
-        {                                                                      \
-            V value = PFX##_iter_value(&iter);                                 \
-                                                                               \
-            if (PFX##_impl_get_node(_set_B_, value) != NULL)                   \
-                PFX##_insert(_set_r_, value);                                  \
-        }                                                                      \
-                                                                               \
-        return _set_r_;                                                        \
+        return PFX##_impl_set_operation(_set1_, _set2_, false, true, false);   \
     }                                                                          \
                                                                                \
     struct SNAME *PFX##_difference(struct SNAME *_set1_, struct SNAME *_set2_) \
     {                                                                          \
-        struct SNAME *_set_r_ =                                                \
-            PFX##_new_custom(_set1_->f_val, _set1_->alloc, _set1_->callbacks); \
-                                                                               \
-        if (!_set_r_)                                                          \
-            return NULL;                                                       \
-                                                                               \
-        struct SNAME##_iter iter = PFX##_iter_start(_set1_);                   \
-                                                                               \
-        for (; !PFX##_iter_at_end(&iter); PFX##_iter_next(&iter))              \
-        {                                                                      \
-            V value = PFX##_iter_value(&iter);                                 \
-                                                                               \
-            if (PFX##_impl_get_node(_set2_, value) == NULL)                    \
-                PFX##_insert(_set_r_, value);                                  \
-        }                                                                      \
-                                                                               \
-        return _set_r_;                                                        \
+        return PFX##_impl_set_operation(_set1_, _set2_, true, false, false);   \
     }                                                                          \
                                                                                \
     struct SNAME *PFX##_symmetric_difference(struct SNAME *_set1_,             \
                                              struct SNAME *_set2_)             \
     {                                                                          \
-        struct SNAME *_set_r_ =                                                \
-            PFX##_new_custom(_set1_->f_val, _set1_->alloc, _set1_->callbacks); \
-                                                                               \
-        if (!_set_r_)                                                          \
-            return NULL;                                                       \
-                                                                               \
-        struct SNAME##_iter iter1 = PFX##_iter_start(_set1_);                  \
-        struct SNAME##_iter iter2 = PFX##_iter_start(_set2_);                  \
-                                                                               \
-        for (; !PFX##_iter_at_end(&iter1); PFX##_iter_next(&iter1))            \
-        {                                                                      \
-            V value = PFX##_iter_value(&iter1);                                \
-                                                                               \
-            if (PFX##_impl_get_node(_set2_, value) == NULL)                    \
-                PFX##_insert(_set_r_, value);                                  \
-        }                                                                      \
-                                                                               \
-        for (; !PFX##_iter_at_end(&iter2); PFX##_iter_next(&iter2))            \
-        {                                                                      \
-            V value = PFX##_iter_value(&iter2);                                \
-                                                                               \
-            if (PFX##_impl_get_node(_set1_, value) == NULL)                    \
-                PFX##_insert(_set_r_, value);                                  \
-        }                                                                      \
-                                                                               \
-        return _set_r_;                                                        \
+        return PFX##_impl_set_operation(_set1_, _set2_, true, false, true);    \
     }                                                                          \
                                                                                \
     /* Is _set1_ a subset of _set2_ ? */                                       \
@@ -999,6 +1144,46 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
         return iter;                                                           \
     }                                                                          \
                                                                                \
+    /* Iterates over the values that are greater than or equal to value */     \
+    struct SNAME##_iter PFX##_iter_from(struct SNAME *target, V value)         \
+    {                                                                          \
+        struct SNAME##_iter iter = PFX##_iter_start(target);                   \
+                                                                               \
+        iter.first = PFX##_impl_ceiling(target, value, true);                  \
+                                                                               \
+        if (!iter.first)                                                       \
+            iter.last = NULL;                                                  \
+                                                                               \
+        iter.cursor = iter.first;                                              \
+        iter.end = iter.first == NULL;                                         \
+                                                                               \
+        return iter;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Iterates over the values in the range [from, to) */                     \
+    struct SNAME##_iter PFX##_iter_range(struct SNAME *target, V from, V to)   \
+    {                                                                          \
+        return PFX##_impl_iter_range(target,                                   \
+                                     PFX##_impl_ceiling(target, from, true),   \
+                                     PFX##_impl_floor(target, to, false));     \
+    }                                                                          \
+                                                                               \
+    /* Iterator over the whole collection positioned at the first value */     \
+    /* that is not less than value, or at the end if there is none */          \
+    struct SNAME##_iter PFX##_lower_bound(struct SNAME *target, V value)       \
+    {                                                                          \
+        return PFX##_impl_iter_at(target,                                      \
+                                  PFX##_impl_ceiling(target, value, true));    \
+    }                                                                          \
+                                                                               \
+    /* Iterator over the whole collection positioned at the first value */     \
+    /* that is greater than value, or at the end if there is none */           \
+    struct SNAME##_iter PFX##_upper_bound(struct SNAME *target, V value)       \
+    {                                                                          \
+        return PFX##_impl_iter_at(target,                                      \
+                                  PFX##_impl_ceiling(target, value, false));   \
+    }                                                                          \
+                                                                               \
     bool PFX##_iter_at_start(struct SNAME##_iter *iter)                        \
     {                                                                          \
         return PFX##_empty(iter->target) || iter->start;                       \
@@ -1011,7 +1196,7 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
                                                                                \
     bool PFX##_iter_to_start(struct SNAME##_iter *iter)                        \
     {                                                                          \
-        if (!PFX##_empty(iter->target))                                        \
+        if (iter->first != NULL)                                               \
         {                                                                      \
             iter->index = 0;                                                   \
             iter->start = true;                                                \
@@ -1026,9 +1211,10 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
                                                                                \
     bool PFX##_iter_to_end(struct SNAME##_iter *iter)                          \
     {                                                                          \
-        if (!PFX##_empty(iter->target))                                        \
+        if (iter->first != NULL)                                               \
         {                                                                      \
-            iter->index = iter->target->count - 1;                             \
+            iter->index = PFX##_impl_index_of(iter->last) -                    \
+                          PFX##_impl_index_of(iter->first);                    \
             iter->start = PFX##_empty(iter->target);                           \
             iter->end = true;                                                  \
             iter->cursor = iter->last;                                         \
@@ -1131,11 +1317,16 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
             return false;                                                      \
         }                                                                      \
                                                                                \
-        if (steps == 0 || iter->index + steps >= iter->target->count)          \
+        size_t index = PFX##_impl_index_of(iter->cursor);                      \
+                                                                               \
+        /* The iteration might stop before the last node of the tree */        \
+        if (steps == 0 || index + steps > PFX##_impl_index_of(iter->last))     \
             return false;                                                      \
                                                                                \
-        for (size_t i = 0; i < steps; i++)                                     \
-            PFX##_iter_next(iter);                                             \
+        /* Jumps straight to the target node using the subtree sizes */        \
+        iter->cursor = PFX##_impl_select(iter->target->root, index + steps);   \
+        iter->index += steps;                                                  \
+        iter->start = PFX##_empty(iter->target);                               \
                                                                                \
         return true;                                                           \
     }                                                                          \
@@ -1155,8 +1346,12 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
         if (steps == 0 || iter->index < steps)                                 \
             return false;                                                      \
                                                                                \
-        for (size_t i = 0; i < steps; i++)                                     \
-            PFX##_iter_prev(iter);                                             \
+        /* Jumps straight to the target node using the subtree sizes */        \
+        size_t index = PFX##_impl_index_of(iter->cursor) - steps;              \
+                                                                               \
+        iter->cursor = PFX##_impl_select(iter->target->root, index);           \
+        iter->index -= steps;                                                  \
+        iter->end = PFX##_empty(iter->target);                                 \
                                                                                \
         return true;                                                           \
     }                                                                          \
@@ -1178,7 +1373,7 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
                                                                                \
     V PFX##_iter_value(struct SNAME##_iter *iter)                              \
     {                                                                          \
-        if (PFX##_empty(iter->target))                                         \
+        if (iter->cursor == NULL)                                              \
             return (V){ 0 };                                                   \
                                                                                \
         return iter->cursor->value;                                            \
@@ -1203,6 +1398,7 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
         node->left = NULL;                                                     \
         node->parent = NULL;                                                   \
         node->height = 0;                                                      \
+        node->size = 1;                                                        \
                                                                                \
         return node;                                                           \
     }                                                                          \
@@ -1225,6 +1421,164 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
         return NULL;                                                           \
     }                                                                          \
                                                                                \
+    /* Node with the greatest value that is less than (or equal to, if */      \
+    /* inclusive) the given value */                                           \
+    static struct SNAME##_node *PFX##_impl_floor(struct SNAME *_set_, V value, \
+                                                 bool inclusive)               \
+    {                                                                          \
+        struct SNAME##_node *scan = _set_->root, *result = NULL;               \
+                                                                               \
+        while (scan != NULL)                                                   \
+        {                                                                      \
+            int c = _set_->f_val->cmp(scan->value, value);                     \
+                                                                               \
+            if (c < 0 || (c == 0 && inclusive))                                \
+            {                                                                  \
+                result = scan;                                                 \
+                scan = scan->right;                                            \
+            }                                                                  \
+            else                                                               \
+                scan = scan->left;                                             \
+        }                                                                      \
+                                                                               \
+        return result;                                                         \
+    }                                                                          \
+                                                                               \
+    /* Node with the least value that is greater than (or equal to, if */      \
+    /* inclusive) the given value */                                           \
+    static struct SNAME##_node *PFX##_impl_ceiling(struct SNAME *_set_,        \
+                                                   V value, bool inclusive)    \
+    {                                                                          \
+        struct SNAME##_node *scan = _set_->root, *result = NULL;               \
+                                                                               \
+        while (scan != NULL)                                                   \
+        {                                                                      \
+            int c = _set_->f_val->cmp(scan->value, value);                     \
+                                                                               \
+            if (c > 0 || (c == 0 && inclusive))                                \
+            {                                                                  \
+                result = scan;                                                 \
+                scan = scan->left;                                             \
+            }                                                                  \
+            else                                                               \
+                scan = scan->right;                                            \
+        }                                                                      \
+                                                                               \
+        return result;                                                         \
+    }                                                                          \
+                                                                               \
+    /* Unlinks a node from the tree and rebalances it. If the node has two */  \
+    /* children its successor is unlinked instead and moved into it. */        \
+    static void PFX##_impl_remove_node(struct SNAME *_set_,                    \
+                                       struct SNAME##_node *node)              \
+    {                                                                          \
+        struct SNAME##_node *temp = NULL, *unbalanced = NULL;                  \
+                                                                               \
+        bool is_root = node->parent == NULL;                                   \
+                                                                               \
+        if (node->left == NULL && node->right == NULL)                         \
+        {                                                                      \
+            if (is_root)                                                       \
+                _set_->root = NULL;                                            \
+            else                                                               \
+            {                                                                  \
+                unbalanced = node->parent;                                     \
+                                                                               \
+                if (node->parent->right == node)                               \
+                    node->parent->right = NULL;                                \
+                else                                                           \
+                    node->parent->left = NULL;                                 \
+            }                                                                  \
+                                                                               \
+            _set_->alloc->free(node);                                          \
+        }                                                                      \
+        else if (node->left == NULL)                                           \
+        {                                                                      \
+            if (is_root)                                                       \
+            {                                                                  \
+                _set_->root = node->right;                                     \
+                _set_->root->parent = NULL;                                    \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                unbalanced = node->parent;                                     \
+                                                                               \
+                node->right->parent = node->parent;                            \
+                                                                               \
+                if (node->parent->right == node)                               \
+                    node->parent->right = node->right;                         \
+                else                                                           \
+                    node->parent->left = node->right;                          \
+            }                                                                  \
+                                                                               \
+            _set_->alloc->free(node);                                          \
+        }                                                                      \
+        else if (node->right == NULL)                                          \
+        {                                                                      \
+            if (is_root)                                                       \
+            {                                                                  \
+                _set_->root = node->left;                                      \
+                _set_->root->parent = NULL;                                    \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                unbalanced = node->parent;                                     \
+                                                                               \
+                node->left->parent = node->parent;                             \
+                                                                               \
+                if (node->parent->right == node)                               \
+                    node->parent->right = node->left;                          \
+                else                                                           \
+                    node->parent->left = node->left;                           \
+            }                                                                  \
+                                                                               \
+            _set_->alloc->free(node);                                          \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            temp = node->right;                                                \
+            while (temp->left != NULL)                                         \
+                temp = temp->left;                                             \
+                                                                               \
+            V temp_value = temp->value;                                        \
+                                                                               \
+            unbalanced = temp->parent;                                         \
+                                                                               \
+            if (temp->left == NULL && temp->right == NULL)                     \
+            {                                                                  \
+                if (temp->parent->right == temp)                               \
+                    temp->parent->right = NULL;                                \
+                else                                                           \
+                    temp->parent->left = NULL;                                 \
+            }                                                                  \
+            else if (temp->left == NULL)                                       \
+            {                                                                  \
+                temp->right->parent = temp->parent;                            \
+                                                                               \
+                if (temp->parent->right == temp)                               \
+                    temp->parent->right = temp->right;                         \
+                else                                                           \
+                    temp->parent->left = temp->right;                          \
+            }                                                                  \
+            else if (temp->right == NULL)                                      \
+            {                                                                  \
+                temp->left->parent = temp->parent;                             \
+                                                                               \
+                if (temp->parent->right == temp)                               \
+                    temp->parent->right = temp->left;                          \
+                else                                                           \
+                    temp->parent->left = temp->left;                           \
+            }                                                                  \
+                                                                               \
+            _set_->alloc->free(temp);                                          \
+                                                                               \
+            node->value = temp_value;                                          \
+        }                                                                      \
+                                                                               \
+        if (unbalanced != NULL)                                                \
+            PFX##_impl_rebalance(_set_, unbalanced);                           \
+    }                                                                          \
+                                                                               \
     static unsigned char PFX##_impl_h(struct SNAME##_node *node)               \
     {                                                                          \
         if (node == NULL)                                                      \
@@ -1244,6 +1598,324 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
         return 1 + (h_l > h_r ? h_l : h_r);                                    \
     }                                                                          \
                                                                                \
+    static size_t PFX##_impl_size(struct SNAME##_node *node)                   \
+    {                                                                          \
+        if (node == NULL)                                                      \
+            return 0;                                                          \
+                                                                               \
+        return node->size;                                                     \
+    }                                                                          \
+                                                                               \
+    static size_t PFX##_impl_supdate(struct SNAME##_node *node)                \
+    {                                                                          \
+        if (node == NULL)                                                      \
+            return 0;                                                          \
+                                                                               \
+        return 1 + PFX##_impl_size(node->left) + PFX##_impl_size(node->right); \
+    }                                                                          \
+                                                                               \
+    /* Position of a node in the sorted sequence of all nodes of the tree */   \
+    static size_t PFX##_impl_index_of(struct SNAME##_node *node)               \
+    {                                                                          \
+        size_t index = PFX##_impl_size(node->left);                            \
+                                                                               \
+        for (; node->parent != NULL; node = node->parent)                      \
+        {                                                                      \
+            if (node->parent->right == node)                                   \
+                index += PFX##_impl_size(node->parent->left) + 1;              \
+        }                                                                      \
+                                                                               \
+        return index;                                                          \
+    }                                                                          \
+                                                                               \
+    /* Node at the given position in the sorted sequence of the subtree */     \
+    static struct SNAME##_node *PFX##_impl_select(struct SNAME##_node *node,   \
+                                                  size_t index)                \
+    {                                                                          \
+        while (node != NULL)                                                   \
+        {                                                                      \
+            size_t left = PFX##_impl_size(node->left);                         \
+                                                                               \
+            if (index < left)                                                  \
+                node = node->left;                                             \
+            else if (index > left)                                             \
+            {                                                                  \
+                index -= left + 1;                                             \
+                node = node->right;                                            \
+            }                                                                  \
+            else                                                               \
+                break;                                                         \
+        }                                                                      \
+                                                                               \
+        return node;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Flattens a tree into a sorted list linked through the right pointers */ \
+    static struct SNAME##_node *PFX##_impl_to_list(struct SNAME##_node *root)  \
+    {                                                                          \
+        struct SNAME##_node *head = NULL, *tail = NULL, *scan = root;          \
+                                                                               \
+        while (scan != NULL)                                                   \
+        {                                                                      \
+            if (scan->left != NULL)                                            \
+            {                                                                  \
+                /* Rotate to the right until there is no left child */         \
+                struct SNAME##_node *left = scan->left;                        \
+                                                                               \
+                scan->left = left->right;                                      \
+                left->right = scan;                                            \
+                scan = left;                                                   \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                if (tail != NULL)                                              \
+                    tail->right = scan;                                        \
+                else                                                           \
+                    head = scan;                                               \
+                                                                               \
+                tail = scan;                                                   \
+                scan = scan->right;                                            \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        return head;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Builds a perfectly balanced tree out of the first count nodes of a */   \
+    /* sorted list, advancing the list past them */                            \
+    static struct SNAME##_node *PFX##_impl_build(struct SNAME##_node **list,   \
+                                                 size_t count)                 \
+    {                                                                          \
+        if (count == 0)                                                        \
+            return NULL;                                                       \
+                                                                               \
+        struct SNAME##_node *left = PFX##_impl_build(list, count / 2);         \
+        struct SNAME##_node *root = *list;                                     \
+                                                                               \
+        *list = root->right;                                                   \
+                                                                               \
+        root->left = left;                                                     \
+        root->right = PFX##_impl_build(list, count - count / 2 - 1);           \
+                                                                               \
+        if (root->left)                                                        \
+            root->left->parent = root;                                         \
+        if (root->right)                                                       \
+            root->right->parent = root;                                        \
+                                                                               \
+        root->height = PFX##_impl_hupdate(root);                               \
+        root->size = count;                                                    \
+                                                                               \
+        return root;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Stable merge sort of a list of count nodes linked through the right */  \
+    /* pointers */                                                             \
+    static struct SNAME##_node *PFX##_impl_sort_list(                          \
+        struct SNAME *_set_, struct SNAME##_node *head, size_t count)          \
+    {                                                                          \
+        if (count < 2)                                                         \
+            return head;                                                       \
+                                                                               \
+        struct SNAME##_node *middle = head;                                    \
+                                                                               \
+        for (size_t i = 1; i < count / 2; i++)                                 \
+            middle = middle->right;                                            \
+                                                                               \
+        struct SNAME##_node *right = middle->right;                            \
+                                                                               \
+        middle->right = NULL;                                                  \
+                                                                               \
+        struct SNAME##_node *left =                                            \
+            PFX##_impl_sort_list(_set_, head, count / 2);                      \
+                                                                               \
+        right = PFX##_impl_sort_list(_set_, right, count - count / 2);         \
+                                                                               \
+        struct SNAME##_node *result = NULL, **tail = &result;                  \
+                                                                               \
+        while (left != NULL && right != NULL)                                  \
+        {                                                                      \
+            if (_set_->f_val->cmp(right->value, left->value) < 0)              \
+            {                                                                  \
+                *tail = right;                                                 \
+                right = right->right;                                          \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                *tail = left;                                                  \
+                left = left->right;                                            \
+            }                                                                  \
+                                                                               \
+            tail = &(*tail)->right;                                            \
+        }                                                                      \
+                                                                               \
+        *tail = left != NULL ? left : right;                                   \
+                                                                               \
+        return result;                                                         \
+    }                                                                          \
+                                                                               \
+    static struct SNAME##_iter PFX##_impl_iter_at(struct SNAME *target,        \
+                                                  struct SNAME##_node *node)   \
+    {                                                                          \
+        if (!node)                                                             \
+            return PFX##_iter_end(target);                                     \
+                                                                               \
+        struct SNAME##_iter iter = PFX##_iter_start(target);                   \
+                                                                               \
+        iter.cursor = node;                                                    \
+        iter.index = PFX##_impl_index_of(node);                                \
+        iter.start = iter.index == 0;                                          \
+                                                                               \
+        return iter;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Iterator over the values from first to last, which is empty if any */   \
+    /* of them is NULL or if first comes after last */                         \
+    static struct SNAME##_iter PFX##_impl_iter_range(                          \
+        struct SNAME *target, struct SNAME##_node *first,                      \
+        struct SNAME##_node *last)                                             \
+    {                                                                          \
+        struct SNAME##_iter iter = PFX##_iter_start(target);                   \
+                                                                               \
+        iter.first = first;                                                    \
+        iter.last = last;                                                      \
+                                                                               \
+        if (!first || !last ||                                                 \
+            target->f_val->cmp(first->value, last->value) > 0)                 \
+        {                                                                      \
+            iter.first = NULL;                                                 \
+            iter.last = NULL;                                                  \
+        }                                                                      \
+                                                                               \
+        iter.cursor = iter.first;                                              \
+        iter.end = iter.first == NULL;                                         \
+                                                                               \
+        return iter;                                                           \
+    }                                                                          \
+                                                                               \
+    static void PFX##_impl_free_list(struct SNAME *_set_,                      \
+                                     struct SNAME##_node *head)                \
+    {                                                                          \
+        while (head != NULL)                                                   \
+        {                                                                      \
+            struct SNAME##_node *next = head->right;                           \
+                                                                               \
+            _set_->alloc->free(head);                                          \
+                                                                               \
+            head = next;                                                       \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    /* Walks both ranges in order, like the merge step of a merge sort, */     \
+    /* copying the kept values into a list of new nodes in O(n + m) */         \
+    static bool PFX##_impl_merge(struct SNAME##_impl_merge *merge)             \
+    {                                                                          \
+        struct SNAME##_iter *iter1 = &(merge->iter1);                          \
+        struct SNAME##_iter *iter2 = &(merge->iter2);                          \
+                                                                               \
+        merge->head = NULL;                                                    \
+        merge->tail = NULL;                                                    \
+        merge->count = 0;                                                      \
+                                                                               \
+        while (true)                                                           \
+        {                                                                      \
+            bool end1 = PFX##_iter_at_end(iter1);                              \
+            bool end2 = PFX##_iter_at_end(iter2);                              \
+                                                                               \
+            /* Stop as soon as there are no values left that can be kept */    \
+            if ((end1 && end2) || (end1 && !merge->only2) ||                   \
+                (end2 && !merge->only1))                                       \
+                break;                                                         \
+                                                                               \
+            int cmp;                                                           \
+                                                                               \
+            if (end1)                                                          \
+                cmp = 1;                                                       \
+            else if (end2)                                                     \
+                cmp = -1;                                                      \
+            else                                                               \
+                cmp = merge->result->f_val->cmp(PFX##_iter_value(iter1),       \
+                                                PFX##_iter_value(iter2));      \
+                                                                               \
+            V value;                                                           \
+            bool keep;                                                         \
+                                                                               \
+            if (cmp < 0)                                                       \
+            {                                                                  \
+                value = PFX##_iter_value(iter1);                               \
+                keep = merge->only1;                                           \
+                                                                               \
+                PFX##_iter_next(iter1);                                        \
+            }                                                                  \
+            else if (cmp > 0)                                                  \
+            {                                                                  \
+                value = PFX##_iter_value(iter2);                               \
+                keep = merge->only2;                                           \
+                                                                               \
+                PFX##_iter_next(iter2);                                        \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                value = PFX##_iter_value(iter1);                               \
+                keep = merge->both;                                            \
+                                                                               \
+                PFX##_iter_next(iter1);                                        \
+                PFX##_iter_next(iter2);                                        \
+            }                                                                  \
+                                                                               \
+            if (!keep)                                                         \
+                continue;                                                      \
+                                                                               \
+            struct SNAME##_node *node =                                        \
+                PFX##_impl_new_node(merge->result, value);                     \
+                                                                               \
+            if (!node)                                                         \
+                return false;                                                  \
+                                                                               \
+            if (merge->tail != NULL)                                           \
+                merge->tail->right = node;                                     \
+            else                                                               \
+                merge->head = node;                                            \
+                                                                               \
+            merge->tail = node;                                                \
+            merge->count++;                                                    \
+        }                                                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    static struct SNAME *PFX##_impl_set_operation(                             \
+        struct SNAME *_set1_, struct SNAME *_set2_, bool only1, bool both,     \
+        bool only2)                                                            \
+    {                                                                          \
+        struct SNAME *_set_r_ =                                                \
+            PFX##_new_custom(_set1_->f_val, _set1_->alloc, _set1_->callbacks); \
+                                                                               \
+        if (!_set_r_)                                                          \
+            return NULL;                                                       \
+                                                                               \
+        struct SNAME##_impl_merge merge;                                       \
+                                                                               \
+        merge.result = _set_r_;                                                \
+        merge.iter1 = PFX##_iter_start(_set1_);                                \
+        merge.iter2 = PFX##_iter_start(_set2_);                                \
+        merge.only1 = only1;                                                   \
+        merge.both = both;                                                     \
+        merge.only2 = only2;                                                   \
+                                                                               \
+        if (!PFX##_impl_merge(&merge))                                         \
+        {                                                                      \
+            PFX##_impl_free_list(_set_r_, merge.head);                         \
+            PFX##_free(_set_r_);                                               \
+                                                                               \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        _set_r_->root = PFX##_impl_build(&(merge.head), merge.count);          \
+        _set_r_->count = merge.count;                                          \
+                                                                               \
+        return _set_r_;                                                        \
+    }                                                                          \
+                                                                               \
     static void PFX##_impl_rotate_right(struct SNAME##_node **Z)               \
     {                                                                          \
         struct SNAME##_node *root = *Z;                                        \
@@ -1270,6 +1942,9 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
         root->height = PFX##_impl_hupdate(root);                               \
         new_root->height = PFX##_impl_hupdate(new_root);                       \
                                                                                \
+        root->size = PFX##_impl_supdate(root);                                 \
+        new_root->size = PFX##_impl_supdate(new_root);                         \
+                                                                               \
         *Z = new_root;                                                         \
     }                                                                          \
                                                                                \
@@ -1299,6 +1974,9 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
         root->height = PFX##_impl_hupdate(root);                               \
         new_root->height = PFX##_impl_hupdate(new_root);                       \
                                                                                \
+        root->size = PFX##_impl_supdate(root);                                 \
+        new_root->size = PFX##_impl_supdate(new_root);                         \
+                                                                               \
         *Z = new_root;                                                         \
     }                                                                          \
                                                                                \
@@ -1316,6 +1994,7 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
                 is_root = true;                                                \
                                                                                \
             scan->height = PFX##_impl_hupdate(scan);                           \
+            scan->size = PFX##_impl_supdate(scan);                             \
             balance = PFX##_impl_h(scan->right) - PFX##_impl_h(scan->left);    \
                                                                                \
             if (balance >= 2)                                                  \
@@ -1347,4 +2026,185 @@ static const char *cmc_string_fmt_treeset = "struct %s<%s> "
         }                                                                      \
     }
 
+/* -------------------------------------------------------------------------
+ * Parallel Set Operations
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_TREESET_PARALLEL_HEADER(PFX, SNAME, V)                   \
+                                                                              \
+    /* Set Operations using up to the given amount of threads. The */         \
+    /* allocator of the first set must be thread-safe. */                     \
+    struct SNAME *PFX##_union_parallel(struct SNAME *_set1_,                  \
+                                       struct SNAME *_set2_, size_t threads); \
+    struct SNAME *PFX##_intersection_parallel(                                \
+        struct SNAME *_set1_, struct SNAME *_set2_, size_t threads);          \
+    struct SNAME *PFX##_difference_parallel(                                  \
+        struct SNAME *_set1_, struct SNAME *_set2_, size_t threads);          \
+    struct SNAME *PFX##_symmetric_difference_parallel(                        \
+        struct SNAME *_set1_, struct SNAME *_set2_, size_t threads);
+
+#define CMC_GENERATE_TREESET_PARALLEL_SOURCE(PFX, SNAME, V)                    \
+                                                                               \
+    static int PFX##_impl_merge_thread(void *args);                            \
+    static struct SNAME *PFX##_impl_set_operation_parallel(                    \
+        struct SNAME *_set1_, struct SNAME *_set2_, bool only1, bool both,     \
+        bool only2, size_t threads);                                           \
+                                                                               \
+    struct SNAME *PFX##_union_parallel(struct SNAME *_set1_,                   \
+                                       struct SNAME *_set2_, size_t threads)   \
+    {                                                                          \
+        return PFX##_impl_set_operation_parallel(_set1_, _set2_, true, true,   \
+                                                 true, threads);               \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_intersection_parallel(                                 \
+        struct SNAME *_set1_, struct SNAME *_set2_, size_t threads)            \
+    {                                                                          \
+        return PFX##_impl_set_operation_parallel(_set1_, _set2_, false, true,  \
+                                                 false, threads);              \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_difference_parallel(                                   \
+        struct SNAME *_set1_, struct SNAME *_set2_, size_t threads)            \
+    {                                                                          \
+        return PFX##_impl_set_operation_parallel(_set1_, _set2_, true, false,  \
+                                                 false, threads);              \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_symmetric_difference_parallel(                         \
+        struct SNAME *_set1_, struct SNAME *_set2_, size_t threads)            \
+    {                                                                          \
+        return PFX##_impl_set_operation_parallel(_set1_, _set2_, true, false,  \
+                                                 true, threads);               \
+    }                                                                          \
+                                                                               \
+    static int PFX##_impl_merge_thread(void *args)                             \
+    {                                                                          \
+        return PFX##_impl_merge((struct SNAME##_impl_merge *)args) ? 0 : 1;    \
+    }                                                                          \
+                                                                               \
+    /* Splits both sets into ranges of values using pivots taken from the */   \
+    /* largest set. Each range is merged by a different thread and the */      \
+    /* resulting lists are joined, in order, into a balanced tree. */          \
+    static struct SNAME *PFX##_impl_set_operation_parallel(                    \
+        struct SNAME *_set1_, struct SNAME *_set2_, bool only1, bool both,     \
+        bool only2, size_t threads)                                            \
+    {                                                                          \
+        struct SNAME *_set_L_ =                                                \
+            _set1_->count > _set2_->count ? _set1_ : _set2_;                   \
+                                                                               \
+        if (threads > _set_L_->count)                                          \
+            threads = _set_L_->count;                                          \
+                                                                               \
+        if (threads < 2 ||                                                     \
+            _set1_->count + _set2_->count < CMC_TREESET_PARALLEL_CUTOFF)       \
+            return PFX##_impl_set_operation(_set1_, _set2_, only1, both,       \
+                                            only2);                            \
+                                                                               \
+        struct SNAME *_set_r_ =                                                \
+            PFX##_new_custom(_set1_->f_val, _set1_->alloc, _set1_->callbacks); \
+                                                                               \
+        if (!_set_r_)                                                          \
+            return NULL;                                                       \
+                                                                               \
+        struct SNAME##_impl_merge *merges = _set_r_->alloc->malloc(            \
+            sizeof(struct SNAME##_impl_merge) * threads);                      \
+        struct cmc_thread *thrds =                                             \
+            _set_r_->alloc->malloc(sizeof(struct cmc_thread) * threads);       \
+                                                                               \
+        if (!merges || !thrds)                                                 \
+        {                                                                      \
+            _set_r_->alloc->free(merges);                                      \
+            _set_r_->alloc->free(thrds);                                       \
+            PFX##_free(_set_r_);                                               \
+                                                                               \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        struct SNAME##_iter all1 = PFX##_iter_start(_set1_);                   \
+        struct SNAME##_iter all2 = PFX##_iter_start(_set2_);                   \
+                                                                               \
+        for (size_t i = 0; i < threads; i++)                                   \
+        {                                                                      \
+            /* The range [from, to) of the values merged by this thread */     \
+            struct SNAME##_node *from = PFX##_impl_select(                     \
+                _set_L_->root, _set_L_->count * i / threads);                  \
+            struct SNAME##_node *to = PFX##_impl_select(                       \
+                _set_L_->root, _set_L_->count * (i + 1) / threads);            \
+                                                                               \
+            struct SNAME##_node *first1 = all1.first, *last1 = all1.last;      \
+            struct SNAME##_node *first2 = all2.first, *last2 = all2.last;      \
+                                                                               \
+            if (i > 0)                                                         \
+            {                                                                  \
+                first1 = PFX##_impl_ceiling(_set1_, from->value, true);        \
+                first2 = PFX##_impl_ceiling(_set2_, from->value, true);        \
+            }                                                                  \
+                                                                               \
+            if (i < threads - 1)                                               \
+            {                                                                  \
+                last1 = PFX##_impl_floor(_set1_, to->value, false);            \
+                last2 = PFX##_impl_floor(_set2_, to->value, false);            \
+            }                                                                  \
+                                                                               \
+            merges[i].result = _set_r_;                                        \
+            merges[i].iter1 = PFX##_impl_iter_range(_set1_, first1, last1);    \
+            merges[i].iter2 = PFX##_impl_iter_range(_set2_, first2, last2);    \
+            merges[i].only1 = only1;                                           \
+            merges[i].both = both;                                             \
+            merges[i].only2 = only2;                                           \
+        }                                                                      \
+                                                                               \
+        /* The first range is merged by the calling thread */                  \
+        for (size_t i = 1; i < threads; i++)                                   \
+            cmc_thrd_create(&thrds[i], PFX##_impl_merge_thread, &merges[i]);   \
+                                                                               \
+        bool success = PFX##_impl_merge(&merges[0]);                           \
+                                                                               \
+        for (size_t i = 1; i < threads; i++)                                   \
+        {                                                                      \
+            int result = 1;                                                    \
+                                                                               \
+            if (thrds[i].flag == cmc_flags.OK)                                 \
+                cmc_thrd_join(&thrds[i], &result);                             \
+            else                                                               \
+                result = PFX##_impl_merge_thread(&merges[i]);                  \
+                                                                               \
+            success = success && result == 0;                                  \
+        }                                                                      \
+                                                                               \
+        /* Join the lists of every range */                                    \
+        struct SNAME##_node *head = NULL, *tail = NULL;                        \
+        size_t count = 0;                                                      \
+                                                                               \
+        for (size_t i = 0; i < threads; i++)                                   \
+        {                                                                      \
+            if (merges[i].head == NULL)                                        \
+                continue;                                                      \
+                                                                               \
+            if (tail != NULL)                                                  \
+                tail->right = merges[i].head;                                  \
+            else                                                               \
+                head = merges[i].head;                                         \
+                                                                               \
+            tail = merges[i].tail;                                             \
+            count += merges[i].count;                                          \
+        }                                                                      \
+                                                                               \
+        _set_r_->alloc->free(merges);                                          \
+        _set_r_->alloc->free(thrds);                                           \
+                                                                               \
+        if (!success)                                                          \
+        {                                                                      \
+            PFX##_impl_free_list(_set_r_, head);                               \
+            PFX##_free(_set_r_);                                               \
+                                                                               \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        _set_r_->root = PFX##_impl_build(&head, count);                        \
+        _set_r_->count = count;                                                \
+                                                                               \
+        return _set_r_;                                                        \
+    }
+
 #endif /* CMC_TREESET_H */
@@ -0,0 +1,1293 @@
+/**
+ * unrolledlist.h
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * UnrolledList
+ *
+ * An UnrolledList is a LinkedList (see linkedlist.h) where each node holds a
+ * small array of values instead of a single one. Iterating over it touches
+ * about as many cache lines as iterating over an array and most of its memory
+ * is used by the values themselves instead of by pointers, while inserting or
+ * removing an element in the middle of it still only changes a single node.
+ *
+ * Implementation
+ *
+ * Nodes hold up to CMC_UNROLLEDLIST_NODE_CAPACITY(V) values, which is computed
+ * so that a node takes about CMC_UNROLLEDLIST_NODE_BYTES bytes. Inserting into
+ * a full node splits it in two halves, except when inserting at either end of
+ * it, where a new node is created for the value alone. That way pushing values
+ * at the ends of the list fills every node. When a node ends up less than half
+ * full after a removal it is merged with one of its neighbours if they fit in
+ * a single node.
+ *
+ * Pushing and popping at both ends is O(1) and accessing an index is O(N / C),
+ * where C is the capacity of the nodes. The iterator can also insert and remove
+ * elements around its cursor, which only changes the node under the cursor.
+ */
+
+#ifndef CMC_UNROLLEDLIST_H
+#define CMC_UNROLLEDLIST_H
+
+/* -------------------------------------------------------------------------
+ * Core functionalities of the C Macro Collections Library
+ * ------------------------------------------------------------------------- */
+#include "../cor/core.h"
+
+/* -------------------------------------------------------------------------
+ * UnrolledList specific
+ * ------------------------------------------------------------------------- */
+/* to_string format */
+static const char *cmc_string_fmt_unrolledlist = "struct %s<%s> "
+                                                 "at %p { "
+                                                 "count:%" PRIuMAX ", "
+                                                 "nodes:%" PRIuMAX ", "
+                                                 "head:%p, "
+                                                 "tail:%p, "
+                                                 "flag:%d, "
+                                                 "f_val:%p, "
+                                                 "alloc:%p, "
+                                                 "callbacks:%p }";
+
+/* Approximate size in bytes of each node, which is two cache lines */
+#ifndef CMC_UNROLLEDLIST_NODE_BYTES
+#define CMC_UNROLLEDLIST_NODE_BYTES 128
+#endif /* CMC_UNROLLEDLIST_NODE_BYTES */
+
+/* Amount of values in each node. The two pointers and the count of the node */
+/* are subtracted from its size and there are at least 4 values per node. */
+#define CMC_UNROLLEDLIST_NODE_CAPACITY(V)                                 \
+    ((CMC_UNROLLEDLIST_NODE_BYTES - 3 * sizeof(void *)) / sizeof(V) > 4   \
+         ? (CMC_UNROLLEDLIST_NODE_BYTES - 3 * sizeof(void *)) / sizeof(V) \
+         : 4)
+
+#define CMC_GENERATE_UNROLLEDLIST(PFX, SNAME, V)    \
+    CMC_GENERATE_UNROLLEDLIST_HEADER(PFX, SNAME, V) \
+    CMC_GENERATE_UNROLLEDLIST_SOURCE(PFX, SNAME, V)
+
+#define CMC_WRAPGEN_UNROLLEDLIST_HEADER(PFX, SNAME, K, V) \
+    CMC_GENERATE_UNROLLEDLIST_HEADER(PFX, SNAME, V)
+
+#define CMC_WRAPGEN_UNROLLEDLIST_SOURCE(PFX, SNAME, K, V) \
+    CMC_GENERATE_UNROLLEDLIST_SOURCE(PFX, SNAME, V)
+
+/* -------------------------------------------------------------------------
+ * Header
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_UNROLLEDLIST_HEADER(PFX, SNAME, V)                      \
+                                                                             \
+    /* Unrolled List Structure */                                            \
+    struct SNAME                                                             \
+    {                                                                        \
+        /* First node in the list */                                         \
+        struct SNAME##_node *head;                                           \
+                                                                             \
+        /* Last node in the list */                                          \
+        struct SNAME##_node *tail;                                           \
+                                                                             \
+        /* Current amount of elements in the list */                         \
+        size_t count;                                                        \
+                                                                             \
+        /* Current amount of nodes in the list */                            \
+        size_t nodes;                                                        \
+                                                                             \
+        /* Flags indicating errors or success */                             \
+        int flag;                                                            \
+                                                                             \
+        /* Value function table */                                           \
+        struct SNAME##_fval *f_val;                                          \
+                                                                             \
+        /* Custom allocation functions */                                    \
+        struct cmc_alloc_node *alloc;                                        \
+                                                                             \
+        /* Custom callback functions */                                      \
+        struct cmc_callbacks *callbacks;                                     \
+    };                                                                       \
+                                                                             \
+    /* Unrolled list node */                                                 \
+    struct SNAME##_node                                                      \
+    {                                                                        \
+        /* Pointer to the next node on the unrolled list */                  \
+        struct SNAME##_node *next;                                           \
+                                                                             \
+        /* Pointer to the previous node on the unrolled list */              \
+        struct SNAME##_node *prev;                                           \
+                                                                             \
+        /* Current amount of values in this node */                          \
+        size_t count;                                                        \
+                                                                             \
+        /* Values of this node, in order */                                  \
+        V values[CMC_UNROLLEDLIST_NODE_CAPACITY(V)];                         \
+    };                                                                       \
+                                                                             \
+    /* Value struct function table */                                        \
+    struct SNAME##_fval                                                      \
+    {                                                                        \
+        /* Comparator function */                                            \
+        int (*cmp)(V, V);                                                    \
+                                                                             \
+        /* Copy function */                                                  \
+        V (*cpy)(V);                                                         \
+                                                                             \
+        /* To string function */                                             \
+        bool (*str)(FILE *, V);                                              \
+                                                                             \
+        /* Free from memory function */                                      \
+        void (*free)(V);                                                     \
+                                                                             \
+        /* Hash function */                                                  \
+        size_t (*hash)(V);                                                   \
+                                                                             \
+        /* Priority function */                                              \
+        int (*pri)(V, V);                                                    \
+    };                                                                       \
+                                                                             \
+    /* Unrolled List Iterator */                                             \
+    struct SNAME##_iter                                                      \
+    {                                                                        \
+        /* Target Unrolled List */                                           \
+        struct SNAME *target;                                                \
+                                                                             \
+        /* Cursor's current node */                                          \
+        struct SNAME##_node *cursor;                                         \
+                                                                             \
+        /* Cursor's position inside of its node */                           \
+        size_t position;                                                     \
+                                                                             \
+        /* Keeps track of relative index to the iteration of elements */     \
+        size_t index;                                                        \
+                                                                             \
+        /* If the iterator has reached the start of the iteration */         \
+        bool start;                                                          \
+                                                                             \
+        /* If the iterator has reached the end of the iteration */           \
+        bool end;                                                            \
+    };                                                                       \
+                                                                             \
+    /* Collection Functions */                                               \
+    /* Collection Allocation and Deallocation */                             \
+    struct SNAME *PFX##_new(struct SNAME##_fval *f_val);                     \
+    struct SNAME *PFX##_new_custom(struct SNAME##_fval *f_val,               \
+                                   struct cmc_alloc_node *alloc,             \
+                                   struct cmc_callbacks *callbacks);         \
+    void PFX##_clear(struct SNAME *_list_);                                  \
+    void PFX##_free(struct SNAME *_list_);                                   \
+    /* Customization of Allocation and Callbacks */                          \
+    void PFX##_customize(struct SNAME *_list_, struct cmc_alloc_node *alloc, \
+                         struct cmc_callbacks *callbacks);                   \
+    /* Collection Input and Output */                                        \
+    bool PFX##_push_front(struct SNAME *_list_, V value);                    \
+    bool PFX##_push_at(struct SNAME *_list_, V value, size_t index);         \
+    bool PFX##_push_back(struct SNAME *_list_, V value);                     \
+    bool PFX##_pop_front(struct SNAME *_list_);                              \
+    bool PFX##_pop_at(struct SNAME *_list_, size_t index);                   \
+    bool PFX##_pop_back(struct SNAME *_list_);                               \
+    /* Element Access */                                                     \
+    V PFX##_front(struct SNAME *_list_);                                     \
+    V PFX##_get(struct SNAME *_list_, size_t index);                         \
+    V *PFX##_get_ref(struct SNAME *_list_, size_t index);                    \
+    V PFX##_back(struct SNAME *_list_);                                      \
+    /* Collection State */                                                   \
+    bool PFX##_contains(struct SNAME *_list_, V value);                      \
+    bool PFX##_empty(struct SNAME *_list_);                                  \
+    size_t PFX##_count(struct SNAME *_list_);                                \
+    int PFX##_flag(struct SNAME *_list_);                                    \
+    /* Collection Utility */                                                 \
+    struct SNAME *PFX##_copy_of(struct SNAME *_list_);                       \
+    bool PFX##_equals(struct SNAME *_list1_, struct SNAME *_list2_);         \
+    struct cmc_string PFX##_to_string(struct SNAME *_list_);                 \
+    bool PFX##_print(struct SNAME *_list_, FILE *fptr);                      \
+                                                                             \
+    /* Iterator Functions */                                                 \
+    /* Iterator Initialization */                                            \
+    struct SNAME##_iter PFX##_iter_start(struct SNAME *target);              \
+    struct SNAME##_iter PFX##_iter_end(struct SNAME *target);                \
+    /* Iterator State */                                                     \
+    bool PFX##_iter_at_start(struct SNAME##_iter *iter);                     \
+    bool PFX##_iter_at_end(struct SNAME##_iter *iter);                       \
+    /* Iterator Movement */                                                  \
+    bool PFX##_iter_to_start(struct SNAME##_iter *iter);                     \
+    bool PFX##_iter_to_end(struct SNAME##_iter *iter);                       \
+    bool PFX##_iter_next(struct SNAME##_iter *iter);                         \
+    bool PFX##_iter_prev(struct SNAME##_iter *iter);                         \
+    bool PFX##_iter_advance(struct SNAME##_iter *iter, size_t steps);        \
+    bool PFX##_iter_rewind(struct SNAME##_iter *iter, size_t steps);         \
+    bool PFX##_iter_go_to(struct SNAME##_iter *iter, size_t index);          \
+    /* Iterator Access */                                                    \
+    V PFX##_iter_value(struct SNAME##_iter *iter);                           \
+    V *PFX##_iter_rvalue(struct SNAME##_iter *iter);                         \
+    size_t PFX##_iter_index(struct SNAME##_iter *iter);                      \
+    /* Input and Output Relative to the Cursor */                            \
+    bool PFX##_iter_add_next(struct SNAME##_iter *iter, V value);            \
+    bool PFX##_iter_add_prev(struct SNAME##_iter *iter, V value);            \
+    bool PFX##_iter_del_curr(struct SNAME##_iter *iter);
+
+/* -------------------------------------------------------------------------
+ * Source
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_UNROLLEDLIST_SOURCE(PFX, SNAME, V)                        \
+                                                                               \
+    /* Implementation Detail Functions */                                      \
+    static struct SNAME##_node *PFX##_impl_new_node(struct SNAME *_list_);     \
+    static void PFX##_impl_link_after(struct SNAME *_list_,                    \
+                                      struct SNAME##_node *node,               \
+                                      struct SNAME##_node *new_node);          \
+    static void PFX##_impl_unlink(struct SNAME *_list_,                        \
+                                  struct SNAME##_node *node);                  \
+    static struct SNAME##_node *PFX##_impl_locate(                             \
+        struct SNAME *_list_, size_t index, size_t *position);                 \
+    static bool PFX##_impl_insert(struct SNAME *_list_,                        \
+                                  struct SNAME##_node **node,                  \
+                                  size_t *position, V value);                  \
+    static void PFX##_impl_remove(                                             \
+        struct SNAME *_list_, struct SNAME##_node **node, size_t *position);   \
+                                                                               \
+    struct SNAME *PFX##_new(struct SNAME##_fval *f_val)                        \
+    {                                                                          \
+        if (!f_val)                                                            \
+            return NULL;                                                       \
+                                                                               \
+        struct cmc_alloc_node *alloc = &cmc_alloc_node_default;                \
+                                                                               \
+        struct SNAME *_list_ = alloc->malloc(sizeof(struct SNAME));            \
+                                                                               \
+        if (!_list_)                                                           \
+            return NULL;                                                       \
+                                                                               \
+        _list_->count = 0;                                                     \
+        _list_->nodes = 0;                                                     \
+        _list_->head = NULL;                                                   \
+        _list_->tail = NULL;                                                   \
+        _list_->flag = cmc_flags.OK;                                           \
+        _list_->f_val = f_val;                                                 \
+        _list_->alloc = alloc;                                                 \
+        _list_->callbacks = NULL;                                              \
+                                                                               \
+        return _list_;                                                         \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_new_custom(struct SNAME##_fval *f_val,                 \
+                                   struct cmc_alloc_node *alloc,               \
+                                   struct cmc_callbacks *callbacks)            \
+    {                                                                          \
+        if (!f_val)                                                            \
+            return NULL;                                                       \
+                                                                               \
+        if (!alloc)                                                            \
+            alloc = &cmc_alloc_node_default;                                   \
+                                                                               \
+        struct SNAME *_list_ = alloc->malloc(sizeof(struct SNAME));            \
+                                                                               \
+        if (!_list_)                                                           \
+            return NULL;                                                       \
+                                                                               \
+        _list_->count = 0;                                                     \
+        _list_->nodes = 0;                                                     \
+        _list_->head = NULL;                                                   \
+        _list_->tail = NULL;                                                   \
+        _list_->flag = cmc_flags.OK;                                           \
+        _list_->f_val = f_val;                                                 \
+        _list_->alloc = alloc;                                                 \
+        _list_->callbacks = callbacks;                                         \
+                                                                               \
+        return _list_;                                                         \
+    }                                                                          \
+                                                                               \
+    void PFX##_clear(struct SNAME *_list_)                                     \
+    {                                                                          \
+        struct SNAME##_node *scan = _list_->head;                              \
+                                                                               \
+        while (scan != NULL)                                                   \
+        {                                                                      \
+            struct SNAME##_node *next = scan->next;                            \
+                                                                               \
+            if (_list_->f_val->free)                                           \
+            {                                                                  \
+                for (size_t i = 0; i < scan->count; i++)                       \
+                    _list_->f_val->free(scan->values[i]);                      \
+            }                                                                  \
+                                                                               \
+            _list_->alloc->free(scan);                                         \
+                                                                               \
+            scan = next;                                                       \
+        }                                                                      \
+                                                                               \
+        _list_->count = 0;                                                     \
+        _list_->nodes = 0;                                                     \
+        _list_->head = NULL;                                                   \
+        _list_->tail = NULL;                                                   \
+        _list_->flag = cmc_flags.OK;                                           \
+    }                                                                          \
+                                                                               \
+    void PFX##_free(struct SNAME *_list_)                                      \
+    {                                                                          \
+        PFX##_clear(_list_);                                                   \
+                                                                               \
+        _list_->alloc->free(_list_);                                           \
+    }                                                                          \
+                                                                               \
+    void PFX##_customize(struct SNAME *_list_, struct cmc_alloc_node *alloc,   \
+                         struct cmc_callbacks *callbacks)                      \
+    {                                                                          \
+        if (!alloc)                                                            \
+            _list_->alloc = &cmc_alloc_node_default;                           \
+        else                                                                   \
+            _list_->alloc = alloc;                                             \
+                                                                               \
+        _list_->callbacks = callbacks;                                         \
+                                                                               \
+        _list_->flag = cmc_flags.OK;                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_push_front(struct SNAME *_list_, V value)                       \
+    {                                                                          \
+        struct SNAME##_node *node = _list_->head;                              \
+        size_t position = 0;                                                   \
+                                                                               \
+        if (!PFX##_impl_insert(_list_, &node, &position, value))               \
+            return false;                                                      \
+                                                                               \
+        _list_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_list_->callbacks && _list_->callbacks->create)                    \
+            _list_->callbacks->create();                                       \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_push_at(struct SNAME *_list_, V value, size_t index)            \
+    {                                                                          \
+        if (index > _list_->count)                                             \
+        {                                                                      \
+            _list_->flag = cmc_flags.RANGE;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (index == 0)                                                        \
+        {                                                                      \
+            return PFX##_push_front(_list_, value);                            \
+        }                                                                      \
+        else if (index == _list_->count)                                       \
+        {                                                                      \
+            return PFX##_push_back(_list_, value);                             \
+        }                                                                      \
+                                                                               \
+        size_t position;                                                       \
+        struct SNAME##_node *node =                                            \
+            PFX##_impl_locate(_list_, index, &position);                       \
+                                                                               \
+        /* Appending to the previous node is cheaper when it has room */       \
+        if (position == 0 &&                                                   \
+            node->prev->count < CMC_UNROLLEDLIST_NODE_CAPACITY(V))             \
+        {                                                                      \
+            node = node->prev;                                                 \
+            position = node->count;                                            \
+        }                                                                      \
+                                                                               \
+        if (!PFX##_impl_insert(_list_, &node, &position, value))               \
+            return false;                                                      \
+                                                                               \
+        _list_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_list_->callbacks && _list_->callbacks->create)                    \
+            _list_->callbacks->create();                                       \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_push_back(struct SNAME *_list_, V value)                        \
+    {                                                                          \
+        struct SNAME##_node *node = _list_->tail;                              \
+        size_t position = node ? node->count : 0;                              \
+                                                                               \
+        if (!PFX##_impl_insert(_list_, &node, &position, value))               \
+            return false;                                                      \
+                                                                               \
+        _list_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_list_->callbacks && _list_->callbacks->create)                    \
+            _list_->callbacks->create();                                       \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_pop_front(struct SNAME *_list_)                                 \
+    {                                                                          \
+        if (PFX##_empty(_list_))                                               \
+        {                                                                      \
+            _list_->flag = cmc_flags.EMPTY;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        struct SNAME##_node *node = _list_->head;                              \
+        size_t position = 0;                                                   \
+                                                                               \
+        PFX##_impl_remove(_list_, &node, &position);                           \
+                                                                               \
+        _list_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_list_->callbacks && _list_->callbacks->delete)                    \
+            _list_->callbacks->delete ();                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_pop_at(struct SNAME *_list_, size_t index)                      \
+    {                                                                          \
+        if (PFX##_empty(_list_))                                               \
+        {                                                                      \
+            _list_->flag = cmc_flags.EMPTY;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (index >= _list_->count)                                            \
+        {                                                                      \
+            _list_->flag = cmc_flags.RANGE;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        size_t position;                                                       \
+        struct SNAME##_node *node =                                            \
+            PFX##_impl_locate(_list_, index, &position);                       \
+                                                                               \
+        PFX##_impl_remove(_list_, &node, &position);                           \
+                                                                               \
+        _list_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_list_->callbacks && _list_->callbacks->delete)                    \
+            _list_->callbacks->delete ();                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_pop_back(struct SNAME *_list_)                                  \
+    {                                                                          \
+        if (PFX##_empty(_list_))                                               \
+        {                                                                      \
+            _list_->flag = cmc_flags.EMPTY;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        struct SNAME##_node *node = _list_->tail;                              \
+        size_t position = node->count - 1;                                     \
+                                                                               \
+        PFX##_impl_remove(_list_, &node, &position);                           \
+                                                                               \
+        _list_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_list_->callbacks && _list_->callbacks->delete)                    \
+            _list_->callbacks->delete ();                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    V PFX##_front(struct SNAME *_list_)                                        \
+    {                                                                          \
+        if (PFX##_empty(_list_))                                               \
+        {                                                                      \
+            _list_->flag = cmc_flags.EMPTY;                                    \
+            return (V){ 0 };                                                   \
+        }                                                                      \
+                                                                               \
+        _list_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_list_->callbacks && _list_->callbacks->read)                      \
+            _list_->callbacks->read();                                         \
+                                                                               \
+        return _list_->head->values[0];                                        \
+    }                                                                          \
+                                                                               \
+    V PFX##_get(struct SNAME *_list_, size_t index)                            \
+    {                                                                          \
+        if (PFX##_empty(_list_))                                               \
+        {                                                                      \
+            _list_->flag = cmc_flags.EMPTY;                                    \
+            return (V){ 0 };                                                   \
+        }                                                                      \
+                                                                               \
+        if (index >= _list_->count)                                            \
+        {                                                                      \
+            _list_->flag = cmc_flags.RANGE;                                    \
+            return (V){ 0 };                                                   \
+        }                                                                      \
+                                                                               \
+        size_t position;                                                       \
+        struct SNAME##_node *node =                                            \
+            PFX##_impl_locate(_list_, index, &position);                       \
+                                                                               \
+        _list_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_list_->callbacks && _list_->callbacks->read)                      \
+            _list_->callbacks->read();                                         \
+                                                                               \
+        return node->values[position];                                         \
+    }                                                                          \
+                                                                               \
+    V *PFX##_get_ref(struct SNAME *_list_, size_t index)                       \
+    {                                                                          \
+        if (PFX##_empty(_list_))                                               \
+        {                                                                      \
+            _list_->flag = cmc_flags.EMPTY;                                    \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        if (index >= _list_->count)                                            \
+        {                                                                      \
+            _list_->flag = cmc_flags.RANGE;                                    \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        size_t position;                                                       \
+        struct SNAME##_node *node =                                            \
+            PFX##_impl_locate(_list_, index, &position);                       \
+                                                                               \
+        _list_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_list_->callbacks && _list_->callbacks->read)                      \
+            _list_->callbacks->read();                                         \
+                                                                               \
+        return &(node->values[position]);                                      \
+    }                                                                          \
+                                                                               \
+    V PFX##_back(struct SNAME *_list_)                                         \
+    {                                                                          \
+        if (PFX##_empty(_list_))                                               \
+        {                                                                      \
+            _list_->flag = cmc_flags.EMPTY;                                    \
+            return (V){ 0 };                                                   \
+        }                                                                      \
+                                                                               \
+        _list_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_list_->callbacks && _list_->callbacks->read)                      \
+            _list_->callbacks->read();                                         \
+                                                                               \
+        return _list_->tail->values[_list_->tail->count - 1];                  \
+    }                                                                          \
+                                                                               \
+    bool PFX##_contains(struct SNAME *_list_, V value)                         \
+    {                                                                          \
+        _list_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        bool result = false;                                                   \
+                                                                               \
+        for (struct SNAME##_node *scan = _list_->head; scan && !result;        \
+             scan = scan->next)                                                \
+        {                                                                      \
+            for (size_t i = 0; i < scan->count; i++)                           \
+            {                                                                  \
+                if (_list_->f_val->cmp(scan->values[i], value) == 0)           \
+                {                                                              \
+                    result = true;                                             \
+                    break;                                                     \
+                }                                                              \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        if (_list_->callbacks && _list_->callbacks->read)                      \
+            _list_->callbacks->read();                                         \
+                                                                               \
+        return result;                                                         \
+    }                                                                          \
+                                                                               \
+    bool PFX##_empty(struct SNAME *_list_)                                     \
+    {                                                                          \
+        return _list_->count == 0;                                             \
+    }                                                                          \
+                                                                               \
+    size_t PFX##_count(struct SNAME *_list_)                                   \
+    {                                                                          \
+        return _list_->count;                                                  \
+    }                                                                          \
+                                                                               \
+    int PFX##_flag(struct SNAME *_list_)                                       \
+    {                                                                          \
+        return _list_->flag;                                                   \
+    }                                                                          \
+                                                                               \
+    struct SNAME *PFX##_copy_of(struct SNAME *_list_)                          \
+    {                                                                          \
+        struct SNAME *result =                                                 \
+            PFX##_new_custom(_list_->f_val, _list_->alloc, _list_->callbacks); \
+                                                                               \
+        if (!result)                                                           \
+        {                                                                      \
+            _list_->flag = cmc_flags.ALLOC;                                    \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        for (struct SNAME##_node *scan = _list_->head; scan != NULL;           \
+             scan = scan->next)                                                \
+        {                                                                      \
+            struct SNAME##_node *new_node = PFX##_impl_new_node(result);       \
+                                                                               \
+            if (!new_node)                                                     \
+            {                                                                  \
+                PFX##_free(result);                                            \
+                                                                               \
+                _list_->flag = cmc_flags.ALLOC;                                \
+                return NULL;                                                   \
+            }                                                                  \
+                                                                               \
+            if (_list_->f_val->cpy)                                            \
+            {                                                                  \
+                for (size_t i = 0; i < scan->count; i++)                       \
+                    new_node->values[i] = _list_->f_val->cpy(scan->values[i]); \
+            }                                                                  \
+            else                                                               \
+                memcpy(new_node->values, scan->values,                         \
+                       sizeof(V) * scan->count);                               \
+                                                                               \
+            new_node->count = scan->count;                                     \
+                                                                               \
+            PFX##_impl_link_after(result, result->tail, new_node);             \
+        }                                                                      \
+                                                                               \
+        result->count = _list_->count;                                         \
+                                                                               \
+        _list_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        return result;                                                         \
+    }                                                                          \
+                                                                               \
+    bool PFX##_equals(struct SNAME *_list1_, struct SNAME *_list2_)            \
+    {                                                                          \
+        _list1_->flag = cmc_flags.OK;                                          \
+        _list2_->flag = cmc_flags.OK;                                          \
+                                                                               \
+        if (_list1_->count != _list2_->count)                                  \
+            return false;                                                      \
+                                                                               \
+        struct SNAME##_iter iter1 = PFX##_iter_start(_list1_);                 \
+        struct SNAME##_iter iter2 = PFX##_iter_start(_list2_);                 \
+                                                                               \
+        for (size_t i = 0; i < _list1_->count; i++)                            \
+        {                                                                      \
+            if (_list1_->f_val->cmp(PFX##_iter_value(&iter1),                  \
+                                    PFX##_iter_value(&iter2)) != 0)            \
+                return false;                                                  \
+                                                                               \
+            PFX##_iter_next(&iter1);                                           \
+            PFX##_iter_next(&iter2);                                           \
+        }                                                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    struct cmc_string PFX##_to_string(struct SNAME *_list_)                    \
+    {                                                                          \
+        struct cmc_string str;                                                 \
+        struct SNAME *l_ = _list_;                                             \
+                                                                               \
+        int n =                                                                \
+            snprintf(str.s, cmc_string_len, cmc_string_fmt_unrolledlist,       \
+                     #SNAME, #V, l_, l_->count, l_->nodes, l_->head, l_->tail, \
+                     l_->flag, l_->f_val, l_->alloc, l_->callbacks);           \
+                                                                               \
+        return n >= 0 ? str : (struct cmc_string){ 0 };                        \
+    }                                                                          \
+                                                                               \
+    bool PFX##_print(struct SNAME *_list_, FILE *fptr)                         \
+    {                                                                          \
+        for (struct SNAME##_node *scan = _list_->head; scan != NULL;           \
+             scan = scan->next)                                                \
+        {                                                                      \
+            for (size_t i = 0; i < scan->count; i++)                           \
+            {                                                                  \
+                if (!_list_->f_val->str(fptr, scan->values[i]))                \
+                    return false;                                              \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    struct SNAME##_iter PFX##_iter_start(struct SNAME *target)                 \
+    {                                                                          \
+        struct SNAME##_iter iter;                                              \
+                                                                               \
+        iter.target = target;                                                  \
+        iter.cursor = target->head;                                            \
+        iter.position = 0;                                                     \
+        iter.index = 0;                                                        \
+        iter.start = true;                                                     \
+        iter.end = PFX##_empty(target);                                        \
+                                                                               \
+        return iter;                                                           \
+    }                                                                          \
+                                                                               \
+    struct SNAME##_iter PFX##_iter_end(struct SNAME *target)                   \
+    {                                                                          \
+        struct SNAME##_iter iter;                                              \
+                                                                               \
+        iter.target = target;                                                  \
+        iter.cursor = target->tail;                                            \
+        iter.position = 0;                                                     \
+        iter.index = 0;                                                        \
+        iter.start = PFX##_empty(target);                                      \
+        iter.end = true;                                                       \
+                                                                               \
+        if (!PFX##_empty(target))                                              \
+        {                                                                      \
+            iter.position = target->tail->count - 1;                           \
+            iter.index = target->count - 1;                                    \
+        }                                                                      \
+                                                                               \
+        return iter;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_at_start(struct SNAME##_iter *iter)                        \
+    {                                                                          \
+        return PFX##_empty(iter->target) || iter->start;                       \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_at_end(struct SNAME##_iter *iter)                          \
+    {                                                                          \
+        return PFX##_empty(iter->target) || iter->end;                         \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_to_start(struct SNAME##_iter *iter)                        \
+    {                                                                          \
+        if (!PFX##_empty(iter->target))                                        \
+        {                                                                      \
+            iter->cursor = iter->target->head;                                 \
+            iter->position = 0;                                                \
+            iter->index = 0;                                                   \
+            iter->start = true;                                                \
+            iter->end = PFX##_empty(iter->target);                             \
+                                                                               \
+            return true;                                                       \
+        }                                                                      \
+                                                                               \
+        return false;                                                          \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_to_end(struct SNAME##_iter *iter)                          \
+    {                                                                          \
+        if (!PFX##_empty(iter->target))                                        \
+        {                                                                      \
+            iter->cursor = iter->target->tail;                                 \
+            iter->position = iter->target->tail->count - 1;                    \
+            iter->index = iter->target->count - 1;                             \
+            iter->start = PFX##_empty(iter->target);                           \
+            iter->end = true;                                                  \
+                                                                               \
+            return true;                                                       \
+        }                                                                      \
+                                                                               \
+        return false;                                                          \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_next(struct SNAME##_iter *iter)                            \
+    {                                                                          \
+        if (iter->end)                                                         \
+            return false;                                                      \
+                                                                               \
+        if (iter->index + 1 >= iter->target->count)                            \
+        {                                                                      \
+            iter->end = true;                                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        iter->start = PFX##_empty(iter->target);                               \
+                                                                               \
+        if (++iter->position == iter->cursor->count)                           \
+        {                                                                      \
+            iter->cursor = iter->cursor->next;                                 \
+            iter->position = 0;                                                \
+        }                                                                      \
+                                                                               \
+        iter->index++;                                                         \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    bool PFX##_iter_prev(struct SNAME##_iter *iter)                            \
+    {                                                                          \
+        if (iter->start)                                                       \
+            return false;                                                      \
+                                                                               \
+        if (iter->index == 0)                                                  \
+        {                                                                      \
+            iter->start = true;                                                \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        iter->end = PFX##_empty(iter->target);                                 \
+                                                                               \
+        if (iter->position == 0)                                               \
+        {                                                                      \
+            iter->cursor = iter->cursor->prev;                                 \
+            iter->position = iter->cursor->count;                              \
+        }                                                                      \
+                                                                               \
+        iter->position--;                                                      \
+        iter->index--;                                                         \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Returns true only if the iterator moved */                              \
+    bool PFX##_iter_advance(struct SNAME##_iter *iter, size_t steps)           \
+    {                                                                          \
+        if (iter->end)                                                         \
+            return false;                                                      \
+                                                                               \
+        if (iter->index + 1 >= iter->target->count)                            \
+        {                                                                      \
+            iter->end = true;                                                  \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (steps == 0 || iter->index + steps >= iter->target->count)          \
+            return false;                                                      \
+                                                                               \
+        iter->start = PFX##_empty(iter->target);                               \
+                                                                               \
+        iter->index += steps;                                                  \
+        iter->position += steps;                                               \
+                                                                               \
+        /* Skips whole nodes at a time */                                      \
+        while (iter->position >= iter->cursor->count)                          \
+        {                                                                      \
+            iter->position -= iter->cursor->count;                             \
+            iter->cursor = iter->cursor->next;                                 \
+        }                                                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Returns true only if the iterator moved */                              \
+    bool PFX##_iter_rewind(struct SNAME##_iter *iter, size_t steps)            \
+    {                                                                          \
+        if (iter->start)                                                       \
+            return false;                                                      \
+                                                                               \
+        if (iter->index == 0)                                                  \
+        {                                                                      \
+            iter->start = true;                                                \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        if (steps == 0 || iter->index < steps)                                 \
+            return false;                                                      \
+                                                                               \
+        iter->end = PFX##_empty(iter->target);                                 \
+                                                                               \
+        iter->index -= steps;                                                  \
+                                                                               \
+        /* Skips whole nodes at a time */                                      \
+        while (steps > iter->position)                                         \
+        {                                                                      \
+            steps -= iter->position + 1;                                       \
+            iter->cursor = iter->cursor->prev;                                 \
+            iter->position = iter->cursor->count - 1;                          \
+        }                                                                      \
+                                                                               \
+        iter->position -= steps;                                               \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Returns true only if the iterator was able to be positioned at the */   \
+    /* given index */                                                          \
+    bool PFX##_iter_go_to(struct SNAME##_iter *iter, size_t index)             \
+    {                                                                          \
+        if (index >= iter->target->count)                                      \
+            return false;                                                      \
+                                                                               \
+        if (iter->index > index)                                               \
+            return PFX##_iter_rewind(iter, iter->index - index);               \
+        else if (iter->index < index)                                          \
+            return PFX##_iter_advance(iter, index - iter->index);              \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    V PFX##_iter_value(struct SNAME##_iter *iter)                              \
+    {                                                                          \
+        if (PFX##_empty(iter->target))                                         \
+            return (V){ 0 };                                                   \
+                                                                               \
+        return iter->cursor->values[iter->position];                           \
+    }                                                                          \
+                                                                               \
+    V *PFX##_iter_rvalue(struct SNAME##_iter *iter)                            \
+    {                                                                          \
+        if (PFX##_empty(iter->target))                                         \
+            return NULL;                                                       \
+                                                                               \
+        return &(iter->cursor->values[iter->position]);                        \
+    }                                                                          \
+                                                                               \
+    size_t PFX##_iter_index(struct SNAME##_iter *iter)                         \
+    {                                                                          \
+        return iter->index;                                                    \
+    }                                                                          \
+                                                                               \
+    /* Inserts a value right after the cursor, which stays at its element */   \
+    bool PFX##_iter_add_next(struct SNAME##_iter *iter, V value)               \
+    {                                                                          \
+        struct SNAME *_list_ = iter->target;                                   \
+                                                                               \
+        if (PFX##_empty(_list_))                                               \
+        {                                                                      \
+            _list_->flag = cmc_flags.EMPTY;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        struct SNAME##_node *node = iter->cursor;                              \
+        size_t position = iter->position + 1;                                  \
+                                                                               \
+        if (!PFX##_impl_insert(_list_, &node, &position, value))               \
+            return false;                                                      \
+                                                                               \
+        /* The node of the cursor might have been split */                     \
+        if (position > 0)                                                      \
+        {                                                                      \
+            iter->cursor = node;                                               \
+            iter->position = position - 1;                                     \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            iter->cursor = node->prev;                                         \
+            iter->position = node->prev->count - 1;                            \
+        }                                                                      \
+                                                                               \
+        /* There is now an element after the cursor */                         \
+        iter->end = false;                                                     \
+                                                                               \
+        _list_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_list_->callbacks && _list_->callbacks->create)                    \
+            _list_->callbacks->create();                                       \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Inserts a value right before the cursor, which stays at its element */  \
+    bool PFX##_iter_add_prev(struct SNAME##_iter *iter, V value)               \
+    {                                                                          \
+        struct SNAME *_list_ = iter->target;                                   \
+                                                                               \
+        if (PFX##_empty(_list_))                                               \
+        {                                                                      \
+            _list_->flag = cmc_flags.EMPTY;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        struct SNAME##_node *node = iter->cursor;                              \
+        size_t position = iter->position;                                      \
+                                                                               \
+        if (!PFX##_impl_insert(_list_, &node, &position, value))               \
+            return false;                                                      \
+                                                                               \
+        /* The node of the cursor might have been split */                     \
+        if (position + 1 < node->count)                                        \
+        {                                                                      \
+            iter->cursor = node;                                               \
+            iter->position = position + 1;                                     \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            iter->cursor = node->next;                                         \
+            iter->position = 0;                                                \
+        }                                                                      \
+                                                                               \
+        /* There is now an element before the cursor */                        \
+        iter->index++;                                                         \
+        iter->start = false;                                                   \
+                                                                               \
+        _list_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_list_->callbacks && _list_->callbacks->create)                    \
+            _list_->callbacks->create();                                       \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Removes the element under the cursor, which is moved to the next */     \
+    /* element or to the previous one if there is no next element */           \
+    bool PFX##_iter_del_curr(struct SNAME##_iter *iter)                        \
+    {                                                                          \
+        struct SNAME *_list_ = iter->target;                                   \
+                                                                               \
+        if (PFX##_empty(_list_))                                               \
+        {                                                                      \
+            _list_->flag = cmc_flags.EMPTY;                                    \
+            return false;                                                      \
+        }                                                                      \
+                                                                               \
+        struct SNAME##_node *node = iter->cursor;                              \
+        size_t position = iter->position;                                      \
+                                                                               \
+        PFX##_impl_remove(_list_, &node, &position);                           \
+                                                                               \
+        if (node != NULL)                                                      \
+        {                                                                      \
+            iter->cursor = node;                                               \
+            iter->position = position;                                         \
+        }                                                                      \
+        else if (!PFX##_empty(_list_))                                         \
+        {                                                                      \
+            iter->cursor = _list_->tail;                                       \
+            iter->position = _list_->tail->count - 1;                          \
+            iter->index--;                                                     \
+            iter->end = true;                                                  \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            iter->cursor = NULL;                                               \
+            iter->position = 0;                                                \
+            iter->index = 0;                                                   \
+        }                                                                      \
+                                                                               \
+        _list_->flag = cmc_flags.OK;                                           \
+                                                                               \
+        if (_list_->callbacks && _list_->callbacks->delete)                    \
+            _list_->callbacks->delete ();                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    static struct SNAME##_node *PFX##_impl_new_node(struct SNAME *_list_)      \
+    {                                                                          \
+        struct SNAME##_node *node =                                            \
+            _list_->alloc->malloc(sizeof(struct SNAME##_node));                \
+                                                                               \
+        if (!node)                                                             \
+        {                                                                      \
+            _list_->flag = cmc_flags.ALLOC;                                    \
+            return NULL;                                                       \
+        }                                                                      \
+                                                                               \
+        node->next = NULL;                                                     \
+        node->prev = NULL;                                                     \
+        node->count = 0;                                                       \
+                                                                               \
+        return node;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Links new_node after node or at the head of the list if node is NULL */ \
+    static void PFX##_impl_link_after(struct SNAME *_list_,                    \
+                                      struct SNAME##_node *node,               \
+                                      struct SNAME##_node *new_node)           \
+    {                                                                          \
+        new_node->prev = node;                                                 \
+        new_node->next = node ? node->next : _list_->head;                     \
+                                                                               \
+        if (new_node->next != NULL)                                            \
+            new_node->next->prev = new_node;                                   \
+        else                                                                   \
+            _list_->tail = new_node;                                           \
+                                                                               \
+        if (node != NULL)                                                      \
+            node->next = new_node;                                             \
+        else                                                                   \
+            _list_->head = new_node;                                           \
+                                                                               \
+        _list_->nodes++;                                                       \
+    }                                                                          \
+                                                                               \
+    static void PFX##_impl_unlink(struct SNAME *_list_,                        \
+                                  struct SNAME##_node *node)                   \
+    {                                                                          \
+        if (node->prev != NULL)                                                \
+            node->prev->next = node->next;                                     \
+        else                                                                   \
+            _list_->head = node->next;                                         \
+                                                                               \
+        if (node->next != NULL)                                                \
+            node->next->prev = node->prev;                                     \
+        else                                                                   \
+            _list_->tail = node->prev;                                         \
+                                                                               \
+        _list_->nodes--;                                                       \
+        _list_->alloc->free(node);                                             \
+    }                                                                          \
+                                                                               \
+    /* Finds the node of an element and its position in that node, starting */ \
+    /* from whichever end of the list is closer */                             \
+    static struct SNAME##_node *PFX##_impl_locate(                             \
+        struct SNAME *_list_, size_t index, size_t *position)                  \
+    {                                                                          \
+        struct SNAME##_node *node;                                             \
+                                                                               \
+        if (index < _list_->count / 2)                                         \
+        {                                                                      \
+            node = _list_->head;                                               \
+                                                                               \
+            while (index >= node->count)                                       \
+            {                                                                  \
+                index -= node->count;                                          \
+                node = node->next;                                             \
+            }                                                                  \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            node = _list_->tail;                                               \
+                                                                               \
+            /* Index of the first element of the node */                       \
+            size_t first = _list_->count - node->count;                        \
+                                                                               \
+            while (index < first)                                              \
+            {                                                                  \
+                node = node->prev;                                             \
+                first -= node->count;                                          \
+            }                                                                  \
+                                                                               \
+            index -= first;                                                    \
+        }                                                                      \
+                                                                               \
+        *position = index;                                                     \
+                                                                               \
+        return node;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Inserts a value at a position of a node, which is NULL if the list */   \
+    /* is empty. The node and the position are updated to where the value */   \
+    /* ends up, since a full node is split to make room for it. */             \
+    static bool PFX##_impl_insert(struct SNAME *_list_,                        \
+                                  struct SNAME##_node **node,                  \
+                                  size_t *position, V value)                   \
+    {                                                                          \
+        const size_t capacity = CMC_UNROLLEDLIST_NODE_CAPACITY(V);             \
+                                                                               \
+        struct SNAME##_node *target = *node;                                   \
+        size_t index = *position;                                              \
+                                                                               \
+        if (target == NULL || target->count == capacity)                       \
+        {                                                                      \
+            struct SNAME##_node *new_node = PFX##_impl_new_node(_list_);       \
+                                                                               \
+            if (!new_node)                                                     \
+                return false;                                                  \
+                                                                               \
+            if (target == NULL)                                                \
+            {                                                                  \
+                PFX##_impl_link_after(_list_, NULL, new_node);                 \
+                target = new_node;                                             \
+            }                                                                  \
+            else if (index == capacity)                                        \
+            {                                                                  \
+                PFX##_impl_link_after(_list_, target, new_node);               \
+                target = new_node;                                             \
+                index = 0;                                                     \
+            }                                                                  \
+            else if (index == 0)                                               \
+            {                                                                  \
+                PFX##_impl_link_after(_list_, target->prev, new_node);         \
+                target = new_node;                                             \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                size_t half = capacity / 2;                                    \
+                                                                               \
+                memcpy(new_node->values, target->values + half,                \
+                       (capacity - half) * sizeof(V));                         \
+                                                                               \
+                new_node->count = capacity - half;                             \
+                target->count = half;                                          \
+                                                                               \
+                PFX##_impl_link_after(_list_, target, new_node);               \
+                                                                               \
+                if (index > half)                                              \
+                {                                                              \
+                    target = new_node;                                         \
+                    index -= half;                                             \
+                }                                                              \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        memmove(target->values + index + 1, target->values + index,            \
+                (target->count - index) * sizeof(V));                          \
+                                                                               \
+        target->values[index] = value;                                         \
+        target->count++;                                                       \
+                                                                               \
+        _list_->count++;                                                       \
+                                                                               \
+        *node = target;                                                        \
+        *position = index;                                                     \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    /* Removes the value at a position of a node. The node and the position */ \
+    /* are updated to where the following value ends up, or the node is set */ \
+    /* to NULL if there is no following value. */                              \
+    static void PFX##_impl_remove(                                             \
+        struct SNAME *_list_, struct SNAME##_node **node, size_t *position)    \
+    {                                                                          \
+        const size_t capacity = CMC_UNROLLEDLIST_NODE_CAPACITY(V);             \
+                                                                               \
+        struct SNAME##_node *target = *node;                                   \
+        size_t index = *position;                                              \
+                                                                               \
+        memmove(target->values + index, target->values + index + 1,            \
+                (target->count - index - 1) * sizeof(V));                      \
+                                                                               \
+        target->count--;                                                       \
+                                                                               \
+        _list_->count--;                                                       \
+                                                                               \
+        struct SNAME##_node *following = target;                               \
+                                                                               \
+        if (index == target->count)                                            \
+        {                                                                      \
+            following = target->next;                                          \
+            index = 0;                                                         \
+        }                                                                      \
+                                                                               \
+        /* Merges the node with one of its neighbours once it is less than */  \
+        /* half full, which also removes it if it became empty */              \
+        if (target->count < capacity / 2)                                      \
+        {                                                                      \
+            struct SNAME##_node *next = target->next;                          \
+            struct SNAME##_node *prev = target->prev;                          \
+                                                                               \
+            if (next != NULL && target->count + next->count <= capacity)       \
+            {                                                                  \
+                memcpy(target->values + target->count, next->values,           \
+                       next->count * sizeof(V));                               \
+                                                                               \
+                if (following == next)                                         \
+                {                                                              \
+                    following = target;                                        \
+                    index += target->count;                                    \
+                }                                                              \
+                                                                               \
+                target->count += next->count;                                  \
+                                                                               \
+                PFX##_impl_unlink(_list_, next);                               \
+            }                                                                  \
+            else if (prev != NULL && prev->count + target->count <= capacity)  \
+            {                                                                  \
+                memcpy(prev->values + prev->count, target->values,             \
+                       target->count * sizeof(V));                             \
+                                                                               \
+                if (following == target)                                       \
+                {                                                              \
+                    following = prev;                                          \
+                    index += prev->count;                                      \
+                }                                                              \
+                                                                               \
+                prev->count += target->count;                                  \
+                                                                               \
+                PFX##_impl_unlink(_list_, target);                             \
+            }                                                                  \
+            else if (target->count == 0)                                       \
+                PFX##_impl_unlink(_list_, target);                             \
+        }                                                                      \
+                                                                               \
+        *node = following;                                                     \
+        *position = index;                                                     \
+    }
+
+#endif /* CMC_UNROLLEDLIST_H */
@@ -0,0 +1,33 @@
+/**
+ * btree.h
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * Things commonly used by B-Tree based collections.
+ */
+
+#ifndef CMC_COR_BTREE_H
+#define CMC_COR_BTREE_H
+
+/* Defines the maximum amount of children of an inner node. It should be an */
+/* even number greater than or equal to 4. The value that is defined when a */
+/* collection is generated is the one used by it, so it can be redefined */
+/* between two different collections. Use the same value for both HEADER */
+/* and SOURCE parts of a collection. */
+#ifndef CMC_BTREE_ORDER
+#define CMC_BTREE_ORDER 32
+#endif /* CMC_BTREE_ORDER */
+
+/* Maximum amount of keys stored in a node */
+#define CMC_BTREE_MAX_KEYS (((CMC_BTREE_ORDER) / 2) * 2 - 1)
+
+/* Minimum amount of keys stored in a node that is not the root */
+#define CMC_BTREE_MIN_KEYS ((CMC_BTREE_ORDER) / 2 - 1)
+
+#endif /* CMC_COR_BTREE_H */
@@ -15,6 +15,7 @@
  *     struct cmc_string
  *     struct cmc_alloc_node
  *     struct cmc_callbacks
+ *     struct cmc_growth
  *     cmc_flags
  */
 
@@ -78,4 +79,49 @@ struct cmc_callbacks
     void (*resize)(void);
 };
 
+/**
+ * struct cmc_growth
+ *
+ * Growth policy of the collections that store their elements in a buffer.
+ * When the buffer is full its capacity is multiplied by factor, but it grows
+ * by at most max_chunk elements at a time (0 means there is no limit). Huge
+ * buffers can then grow in fixed steps instead of doubling. If grow is set it
+ * is used instead of factor and max_chunk, receiving the current capacity and
+ * the minimum capacity required. The resulting capacity is never less than the
+ * required one.
+ */
+struct cmc_growth
+{
+    double factor;
+    size_t max_chunk;
+    size_t (*grow)(size_t capacity, size_t required);
+};
+
+/* Used by the collections when no growth policy was set */
+static const struct cmc_growth cmc_growth_default = { 2.0, 0, NULL };
+
+static inline size_t cmc_growth_capacity(const struct cmc_growth *growth,
+                                         size_t capacity, size_t required)
+{
+    if (!growth)
+        growth = &cmc_growth_default;
+
+    size_t result;
+
+    if (growth->grow)
+        result = growth->grow(capacity, required);
+    else
+    {
+        double grown = (double)capacity * growth->factor;
+
+        result = grown < (double)SIZE_MAX ? (size_t)grown : SIZE_MAX;
+
+        if (growth->max_chunk > 0 && result > capacity &&
+            result - capacity > growth->max_chunk)
+            result = capacity + growth->max_chunk;
+    }
+
+    return result < required ? required : result;
+}
+
 #endif /* CMC_CORE_H */
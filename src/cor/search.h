@@ -0,0 +1,357 @@
+/**
+ * search.h
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * Linear search used by collections that are backed by an array.
+ *
+ * By default, collections search for an element by calling the comparator of
+ * their f_val on every element. The functions are generated with the
+ * collection that uses them through the CMC_GENERATE_SEARCH macro.
+ *
+ * Collections of plain old data types whose equality is the same as the
+ * equality of their bytes (integers, pointers, structs without padding, etc)
+ * can instead use CMC_GENERATE_SEARCH_POD, which compares the bytes of the
+ * elements directly and never calls the comparator. Note that this is not the
+ * case for floating point numbers when the collection might hold NaN, 0.0 or
+ * -0.0. For elements of 1, 2, 4 or 8 bytes on x86 the comparison is done 16
+ * or 32 bytes at a time using SSE2 or AVX2, chosen at runtime depending on
+ * what the processor supports.
+ *
+ * Functions
+ *  - cmc_search_eq
+ *  - cmc_search_eq_last
+ */
+
+#ifndef CMC_COR_SEARCH_H
+#define CMC_COR_SEARCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__SSE2__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define CMC_SEARCH_X86
+#include <immintrin.h>
+#endif
+
+/* -------------------------------------------------------------------------
+ * Search kernels
+ * ------------------------------------------------------------------------- */
+
+/* Generates NAME##_first and NAME##_last, which return the index of the */
+/* first or last element of an array of UINT equal to value, or count if */
+/* there is none. The array is read WIDTH bytes at a time by LOAD, compared */
+/* with CMPEQ and converted to a bit mask, one bit per byte, by MOVEMASK. */
+#define CMC_SEARCH_GENERATE_KERNEL(NAME, ATTR, UINT, VEC, WIDTH, LOAD, SET1, \
+                                   CMPEQ, MOVEMASK)                          \
+                                                                             \
+    ATTR static size_t NAME##_first(const char *bytes, size_t count,         \
+                                    UINT value)                              \
+    {                                                                        \
+        const size_t step = WIDTH / sizeof(UINT);                            \
+        const VEC needle = SET1(value);                                      \
+                                                                             \
+        size_t i = 0;                                                        \
+                                                                             \
+        for (; i + step <= count; i += step)                                 \
+        {                                                                    \
+            VEC block = LOAD((const VEC *)(bytes + i * sizeof(UINT)));       \
+            unsigned mask = (unsigned)MOVEMASK(CMPEQ(block, needle));        \
+                                                                             \
+            if (mask)                                                        \
+                return i + (size_t)__builtin_ctz(mask) / sizeof(UINT);       \
+        }                                                                    \
+                                                                             \
+        for (; i < count; i++)                                               \
+        {                                                                    \
+            UINT element;                                                    \
+            memcpy(&element, bytes + i * sizeof(UINT), sizeof(UINT));        \
+                                                                             \
+            if (element == value)                                            \
+                return i;                                                    \
+        }                                                                    \
+                                                                             \
+        return count;                                                        \
+    }                                                                        \
+                                                                             \
+    ATTR static size_t NAME##_last(const char *bytes, size_t count,          \
+                                   UINT value)                               \
+    {                                                                        \
+        const size_t step = WIDTH / sizeof(UINT);                            \
+        const VEC needle = SET1(value);                                      \
+                                                                             \
+        size_t i = count;                                                    \
+                                                                             \
+        for (; i >= step; i -= step)                                         \
+        {                                                                    \
+            VEC block =                                                      \
+                LOAD((const VEC *)(bytes + (i - step) * sizeof(UINT)));      \
+            unsigned mask = (unsigned)MOVEMASK(CMPEQ(block, needle));        \
+                                                                             \
+            if (mask)                                                        \
+                return i - step +                                            \
+                       (size_t)(31 - __builtin_clz(mask)) / sizeof(UINT);    \
+        }                                                                    \
+                                                                             \
+        for (; i > 0; i--)                                                   \
+        {                                                                    \
+            UINT element;                                                    \
+            memcpy(&element, bytes + (i - 1) * sizeof(UINT), sizeof(UINT));  \
+                                                                             \
+            if (element == value)                                            \
+                return i - 1;                                                \
+        }                                                                    \
+                                                                             \
+        return count;                                                        \
+    }
+
+#if defined(CMC_SEARCH_X86)
+
+/* SSE2 has no 64-bit comparison so both halves are compared separately */
+static inline __m128i cmc_search_cmpeq_epi64_sse2(__m128i a, __m128i b)
+{
+    __m128i eq = _mm_cmpeq_epi32(a, b);
+
+    return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+#define CMC_SEARCH_AVX2 __attribute__((target("avx2")))
+
+CMC_SEARCH_GENERATE_KERNEL(cmc_search_sse2_8, , uint8_t, __m128i, 16,
+                           _mm_loadu_si128, _mm_set1_epi8, _mm_cmpeq_epi8,
+                           _mm_movemask_epi8)
+CMC_SEARCH_GENERATE_KERNEL(cmc_search_sse2_16, , uint16_t, __m128i, 16,
+                           _mm_loadu_si128, _mm_set1_epi16, _mm_cmpeq_epi16,
+                           _mm_movemask_epi8)
+CMC_SEARCH_GENERATE_KERNEL(cmc_search_sse2_32, , uint32_t, __m128i, 16,
+                           _mm_loadu_si128, _mm_set1_epi32, _mm_cmpeq_epi32,
+                           _mm_movemask_epi8)
+CMC_SEARCH_GENERATE_KERNEL(cmc_search_sse2_64, , uint64_t, __m128i, 16,
+                           _mm_loadu_si128, _mm_set1_epi64x,
+                           cmc_search_cmpeq_epi64_sse2, _mm_movemask_epi8)
+
+CMC_SEARCH_GENERATE_KERNEL(cmc_search_avx2_8, CMC_SEARCH_AVX2, uint8_t, __m256i,
+                           32, _mm256_loadu_si256, _mm256_set1_epi8,
+                           _mm256_cmpeq_epi8, _mm256_movemask_epi8)
+CMC_SEARCH_GENERATE_KERNEL(cmc_search_avx2_16, CMC_SEARCH_AVX2, uint16_t,
+                           __m256i, 32, _mm256_loadu_si256, _mm256_set1_epi16,
+                           _mm256_cmpeq_epi16, _mm256_movemask_epi8)
+CMC_SEARCH_GENERATE_KERNEL(cmc_search_avx2_32, CMC_SEARCH_AVX2, uint32_t,
+                           __m256i, 32, _mm256_loadu_si256, _mm256_set1_epi32,
+                           _mm256_cmpeq_epi32, _mm256_movemask_epi8)
+CMC_SEARCH_GENERATE_KERNEL(cmc_search_avx2_64, CMC_SEARCH_AVX2, uint64_t,
+                           __m256i, 32, _mm256_loadu_si256, _mm256_set1_epi64x,
+                           _mm256_cmpeq_epi64, _mm256_movemask_epi8)
+
+/* Picks the kernel supported by the processor */
+#define CMC_SEARCH_DISPATCH(BITS, DIRECTION, bytes, count, value)    \
+    (__builtin_cpu_supports("avx2")                                  \
+         ? cmc_search_avx2_##BITS##_##DIRECTION(bytes, count, value) \
+         : cmc_search_sse2_##BITS##_##DIRECTION(bytes, count, value))
+
+#else
+
+/* Generates NAME##_first and NAME##_last for platforms without SIMD */
+#define CMC_SEARCH_GENERATE_SCALAR(NAME, UINT)                              \
+                                                                            \
+    static size_t NAME##_first(const char *bytes, size_t count, UINT value) \
+    {                                                                       \
+        for (size_t i = 0; i < count; i++)                                  \
+        {                                                                   \
+            UINT element;                                                   \
+            memcpy(&element, bytes + i * sizeof(UINT), sizeof(UINT));       \
+                                                                            \
+            if (element == value)                                           \
+                return i;                                                   \
+        }                                                                   \
+                                                                            \
+        return count;                                                       \
+    }                                                                       \
+                                                                            \
+    static size_t NAME##_last(const char *bytes, size_t count, UINT value)  \
+    {                                                                       \
+        for (size_t i = count; i > 0; i--)                                  \
+        {                                                                   \
+            UINT element;                                                   \
+            memcpy(&element, bytes + (i - 1) * sizeof(UINT), sizeof(UINT)); \
+                                                                            \
+            if (element == value)                                           \
+                return i - 1;                                               \
+        }                                                                   \
+                                                                            \
+        return count;                                                       \
+    }
+
+CMC_SEARCH_GENERATE_SCALAR(cmc_search_scalar_8, uint8_t)
+CMC_SEARCH_GENERATE_SCALAR(cmc_search_scalar_16, uint16_t)
+CMC_SEARCH_GENERATE_SCALAR(cmc_search_scalar_32, uint32_t)
+CMC_SEARCH_GENERATE_SCALAR(cmc_search_scalar_64, uint64_t)
+
+#define CMC_SEARCH_DISPATCH(BITS, DIRECTION, bytes, count, value) \
+    cmc_search_scalar_##BITS##_##DIRECTION(bytes, count, value)
+
+#endif /* CMC_SEARCH_X86 */
+
+/* -------------------------------------------------------------------------
+ * Search functions
+ * ------------------------------------------------------------------------- */
+
+/**
+ * Searches for the first element of an array that has the same bytes as the
+ * given value.
+ * \param array An array of count elements.
+ * \param count Amount of elements in the array.
+ * \param size  Size in bytes of each element.
+ * \param value Pointer to the value being searched for.
+ * \return The index of the first element equal to value or count if there is
+ *         none.
+ */
+static inline size_t cmc_search_eq(const void *array, size_t count, size_t size,
+                                   const void *value)
+{
+    const char *bytes = array;
+
+    if (size == 1)
+    {
+        uint8_t v;
+        memcpy(&v, value, sizeof(v));
+        return CMC_SEARCH_DISPATCH(8, first, bytes, count, v);
+    }
+    else if (size == 2)
+    {
+        uint16_t v;
+        memcpy(&v, value, sizeof(v));
+        return CMC_SEARCH_DISPATCH(16, first, bytes, count, v);
+    }
+    else if (size == 4)
+    {
+        uint32_t v;
+        memcpy(&v, value, sizeof(v));
+        return CMC_SEARCH_DISPATCH(32, first, bytes, count, v);
+    }
+    else if (size == 8)
+    {
+        uint64_t v;
+        memcpy(&v, value, sizeof(v));
+        return CMC_SEARCH_DISPATCH(64, first, bytes, count, v);
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (memcmp(bytes + i * size, value, size) == 0)
+            return i;
+    }
+
+    return count;
+}
+
+/**
+ * Searches for the last element of an array that has the same bytes as the
+ * given value.
+ * \param array An array of count elements.
+ * \param count Amount of elements in the array.
+ * \param size  Size in bytes of each element.
+ * \param value Pointer to the value being searched for.
+ * \return The index of the last element equal to value or count if there is
+ *         none.
+ */
+static inline size_t cmc_search_eq_last(const void *array, size_t count,
+                                        size_t size, const void *value)
+{
+    const char *bytes = array;
+
+    if (size == 1)
+    {
+        uint8_t v;
+        memcpy(&v, value, sizeof(v));
+        return CMC_SEARCH_DISPATCH(8, last, bytes, count, v);
+    }
+    else if (size == 2)
+    {
+        uint16_t v;
+        memcpy(&v, value, sizeof(v));
+        return CMC_SEARCH_DISPATCH(16, last, bytes, count, v);
+    }
+    else if (size == 4)
+    {
+        uint32_t v;
+        memcpy(&v, value, sizeof(v));
+        return CMC_SEARCH_DISPATCH(32, last, bytes, count, v);
+    }
+    else if (size == 8)
+    {
+        uint64_t v;
+        memcpy(&v, value, sizeof(v));
+        return CMC_SEARCH_DISPATCH(64, last, bytes, count, v);
+    }
+
+    for (size_t i = count; i > 0; i--)
+    {
+        if (memcmp(bytes + (i - 1) * size, value, size) == 0)
+            return i - 1;
+    }
+
+    return count;
+}
+
+/* -------------------------------------------------------------------------
+ * Source
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_SEARCH(PFX, V)                                           \
+                                                                              \
+    /* Index of the first element equal to value or count if there is none */ \
+    static inline size_t PFX##_impl_search(V *array, size_t count,            \
+                                           V value, int (*cmp)(V, V))         \
+    {                                                                         \
+        for (size_t i = 0; i < count; i++)                                    \
+        {                                                                     \
+            if (cmp(array[i], value) == 0)                                    \
+                return i;                                                     \
+        }                                                                     \
+                                                                              \
+        return count;                                                         \
+    }                                                                         \
+                                                                              \
+    /* Index of the last element equal to value or count if there is none */  \
+    static inline size_t PFX##_impl_search_last(V *array, size_t count,       \
+                                                V value, int (*cmp)(V, V))    \
+    {                                                                         \
+        for (size_t i = count; i > 0; i--)                                    \
+        {                                                                     \
+            if (cmp(array[i - 1], value) == 0)                                \
+                return i - 1;                                                 \
+        }                                                                     \
+                                                                              \
+        return count;                                                         \
+    }
+
+#define CMC_GENERATE_SEARCH_POD(PFX, V)                                       \
+                                                                              \
+    /* Index of the first element equal to value or count if there is none */ \
+    static inline size_t PFX##_impl_search(V *array, size_t count,            \
+                                           V value, int (*cmp)(V, V))         \
+    {                                                                         \
+        (void)cmp;                                                            \
+                                                                              \
+        return cmc_search_eq(array, count, sizeof(V), &value);                \
+    }                                                                         \
+                                                                              \
+    /* Index of the last element equal to value or count if there is none */  \
+    static inline size_t PFX##_impl_search_last(V *array, size_t count,       \
+                                                V value, int (*cmp)(V, V))    \
+    {                                                                         \
+        (void)cmp;                                                            \
+                                                                              \
+        return cmc_search_eq_last(array, count, sizeof(V), &value);           \
+    }
+
+#endif /* CMC_COR_SEARCH_H */
@@ -0,0 +1,992 @@
+/**
+ * sort.h
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * Sorting algorithms used by collections that are backed by an array.
+ *
+ * The main sorting algorithm is a pattern-defeating quicksort (pdqsort),
+ * which is an introsort that:
+ *  - uses insertion sort for small partitions;
+ *  - uses a median of three, or a median of medians of three (ninther) for
+ *    large partitions, as the pivot;
+ *  - partitions the elements equal to the pivot to the left when the pivot
+ *    is equal to the pivot of the parent partition, sorting many duplicates
+ *    in linear time;
+ *  - detects partitions that are already sorted and finishes them with an
+ *    insertion sort that gives up after a few moves;
+ *  - shuffles some elements of highly unbalanced partitions to break
+ *    adversarial patterns and, after log2(n) of them, falls back to heapsort
+ *    which guarantees O(n log n) in the worst case.
+ *
+ * The functions are generated with the collection that uses them through the
+ * CMC_GENERATE_SORT macro.
+ *
+ * Collections of integers, floating point numbers or elements that can be
+ * ordered by one of them can also be sorted with an LSD radix sort, generated
+ * by the CMC_GENERATE_SORT_RADIX macro. It takes an unsigned integer type K and
+ * a function or macro KEY that maps an element V to a K such that the order of
+ * the keys is the same as the one defined by the comparator. The functions
+ * cmc_*_key below map the standard types to such keys. The radix sort makes
+ * one pass per byte of K, skipping the bytes that are equal for every key, and
+ * never calls the comparator. It needs an auxiliary buffer of count elements
+ * and falls back to the comparison sort when it can't be allocated or when the
+ * array is too small.
+ *
+ * The parallel sort, generated by CMC_GENERATE_SORT_PARALLEL, splits the array
+ * into one chunk per thread, sorts each chunk with the collection's sort and
+ * then merges pairs of sorted runs until a single one is left. Every merge is
+ * also split between the threads by searching for the position where each
+ * part of the output starts in both runs. The chunks and the parts of each
+ * merge only depend on the amount of elements and threads, so the result does
+ * not depend on how the threads are scheduled and, if the collection's sort is
+ * stable, it is also stable. The threads are started once per sort and wait on
+ * a condition variable between the steps. It depends on utl/thread.h and
+ * utl/condvar.h, which must be included before expanding it.
+ */
+
+#ifndef CMC_COR_SORT_H
+#define CMC_COR_SORT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "core.h"
+
+/* Partitions with less elements than this are sorted with insertion sort. */
+/* It must be at least 8. */
+#ifndef CMC_SORT_INSERTION_THRESHOLD
+#define CMC_SORT_INSERTION_THRESHOLD 24
+#endif /* CMC_SORT_INSERTION_THRESHOLD */
+
+/* Partitions with more elements than this use the ninther as their pivot */
+#ifndef CMC_SORT_NINTHER_THRESHOLD
+#define CMC_SORT_NINTHER_THRESHOLD 128
+#endif /* CMC_SORT_NINTHER_THRESHOLD */
+
+/* Maximum amount of elements moved by the insertion sort that tries to */
+/* finish partitions that seem to be already sorted */
+#ifndef CMC_SORT_PARTIAL_INSERTION_LIMIT
+#define CMC_SORT_PARTIAL_INSERTION_LIMIT 8
+#endif /* CMC_SORT_PARTIAL_INSERTION_LIMIT */
+
+/* Arrays with less elements than this are sorted with the comparison sort */
+/* when using the radix sort */
+#ifndef CMC_SORT_RADIX_THRESHOLD
+#define CMC_SORT_RADIX_THRESHOLD 256
+#endif /* CMC_SORT_RADIX_THRESHOLD */
+
+/* Minimum amount of elements sorted by each thread in the parallel sort. */
+/* Smaller arrays are sorted by the calling thread alone. */
+#ifndef CMC_SORT_PARALLEL_CUTOFF
+#define CMC_SORT_PARALLEL_CUTOFF 16384
+#endif /* CMC_SORT_PARALLEL_CUTOFF */
+
+/* -------------------------------------------------------------------------
+ * Radix sort keys
+ * ------------------------------------------------------------------------- */
+static inline uint64_t cmc_u64_key(uint64_t x)
+{
+    return x;
+}
+
+static inline uint32_t cmc_u32_key(uint32_t x)
+{
+    return x;
+}
+
+static inline uint64_t cmc_size_key(size_t x)
+{
+    return (uint64_t)x;
+}
+
+/* Flipping the sign bit maps the two's complement order to the unsigned one */
+static inline uint64_t cmc_i64_key(int64_t x)
+{
+    return (uint64_t)x ^ UINT64_C(0x8000000000000000);
+}
+
+static inline uint32_t cmc_i32_key(int32_t x)
+{
+    return (uint32_t)x ^ UINT32_C(0x80000000);
+}
+
+/* Positive numbers get their sign bit flipped and negative numbers get all */
+/* their bits flipped, which maps the IEEE 754 order to the unsigned one */
+static inline uint64_t cmc_double_key(double x)
+{
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+
+    if (bits & UINT64_C(0x8000000000000000))
+        return ~bits;
+
+    return bits ^ UINT64_C(0x8000000000000000);
+}
+
+static inline uint32_t cmc_float_key(float x)
+{
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+
+    if (bits & UINT32_C(0x80000000))
+        return ~bits;
+
+    return bits ^ UINT32_C(0x80000000);
+}
+
+/* -------------------------------------------------------------------------
+ * Source
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_SORT(PFX, V)                                              \
+                                                                               \
+    static void PFX##_impl_sort_swap(V *a, V *b)                               \
+    {                                                                          \
+        V tmp = *a;                                                            \
+        *a = *b;                                                               \
+        *b = tmp;                                                              \
+    }                                                                          \
+                                                                               \
+    /* Sorts the range [begin, end) */                                         \
+    static void PFX##_impl_sort_insertion(V *begin, V *end, int (*cmp)(V, V))  \
+    {                                                                          \
+        if (begin == end)                                                      \
+            return;                                                            \
+                                                                               \
+        for (V *cur = begin + 1; cur != end; cur++)                            \
+        {                                                                      \
+            V *sift = cur;                                                     \
+            V *sift_1 = cur - 1;                                               \
+                                                                               \
+            if (cmp(*sift, *sift_1) < 0)                                       \
+            {                                                                  \
+                V tmp = *sift;                                                 \
+                                                                               \
+                do                                                             \
+                {                                                              \
+                    *sift-- = *sift_1;                                         \
+                } while (sift != begin && cmp(tmp, *--sift_1) < 0);            \
+                                                                               \
+                *sift = tmp;                                                   \
+            }                                                                  \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    /* Sorts the range [begin, end) assuming that the element before begin */  \
+    /* is less than or equal to every element in the range */                  \
+    static void PFX##_impl_sort_insertion_unguarded(V *begin, V *end,          \
+                                                    int (*cmp)(V, V))          \
+    {                                                                          \
+        if (begin == end)                                                      \
+            return;                                                            \
+                                                                               \
+        for (V *cur = begin + 1; cur != end; cur++)                            \
+        {                                                                      \
+            V *sift = cur;                                                     \
+            V *sift_1 = cur - 1;                                               \
+                                                                               \
+            if (cmp(*sift, *sift_1) < 0)                                       \
+            {                                                                  \
+                V tmp = *sift;                                                 \
+                                                                               \
+                do                                                             \
+                {                                                              \
+                    *sift-- = *sift_1;                                         \
+                } while (cmp(tmp, *--sift_1) < 0);                             \
+                                                                               \
+                *sift = tmp;                                                   \
+            }                                                                  \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    /* Tries to sort the range [begin, end) with insertion sort, giving up */  \
+    /* if too many elements have to be moved. Returns true if it succeeded. */ \
+    static bool PFX##_impl_sort_insertion_partial(V *begin, V *end,            \
+                                                  int (*cmp)(V, V))            \
+    {                                                                          \
+        if (begin == end)                                                      \
+            return true;                                                       \
+                                                                               \
+        size_t moves = 0;                                                      \
+                                                                               \
+        for (V *cur = begin + 1; cur != end; cur++)                            \
+        {                                                                      \
+            V *sift = cur;                                                     \
+            V *sift_1 = cur - 1;                                               \
+                                                                               \
+            if (cmp(*sift, *sift_1) < 0)                                       \
+            {                                                                  \
+                V tmp = *sift;                                                 \
+                                                                               \
+                do                                                             \
+                {                                                              \
+                    *sift-- = *sift_1;                                         \
+                } while (sift != begin && cmp(tmp, *--sift_1) < 0);            \
+                                                                               \
+                *sift = tmp;                                                   \
+                                                                               \
+                moves += (size_t)(cur - sift);                                 \
+            }                                                                  \
+                                                                               \
+            if (moves > CMC_SORT_PARTIAL_INSERTION_LIMIT)                      \
+                return false;                                                  \
+        }                                                                      \
+                                                                               \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    static void PFX##_impl_sort_heapsort_sift(V *array, size_t root,           \
+                                              size_t count, int (*cmp)(V, V))  \
+    {                                                                          \
+        V value = array[root];                                                 \
+                                                                               \
+        while (root * 2 + 1 < count)                                           \
+        {                                                                      \
+            size_t child = root * 2 + 1;                                       \
+                                                                               \
+            if (child + 1 < count && cmp(array[child], array[child + 1]) < 0)  \
+                child++;                                                       \
+                                                                               \
+            if (cmp(value, array[child]) >= 0)                                 \
+                break;                                                         \
+                                                                               \
+            array[root] = array[child];                                        \
+            root = child;                                                      \
+        }                                                                      \
+                                                                               \
+        array[root] = value;                                                   \
+    }                                                                          \
+                                                                               \
+    /* Sorts the range [begin, end) in O(n log n) */                           \
+    static void PFX##_impl_sort_heapsort(V *begin, V *end, int (*cmp)(V, V))   \
+    {                                                                          \
+        size_t count = (size_t)(end - begin);                                  \
+                                                                               \
+        for (size_t i = count / 2; i > 0; i--)                                 \
+            PFX##_impl_sort_heapsort_sift(begin, i - 1, count, cmp);           \
+                                                                               \
+        for (size_t i = count; i > 1; i--)                                     \
+        {                                                                      \
+            PFX##_impl_sort_swap(begin, begin + i - 1);                        \
+            PFX##_impl_sort_heapsort_sift(begin, 0, i - 1, cmp);               \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static void PFX##_impl_sort_sort2(V *a, V *b, int (*cmp)(V, V))            \
+    {                                                                          \
+        if (cmp(*b, *a) < 0)                                                   \
+            PFX##_impl_sort_swap(a, b);                                        \
+    }                                                                          \
+                                                                               \
+    static void PFX##_impl_sort_sort3(V *a, V *b, V *c, int (*cmp)(V, V))      \
+    {                                                                          \
+        PFX##_impl_sort_sort2(a, b, cmp);                                      \
+        PFX##_impl_sort_sort2(b, c, cmp);                                      \
+        PFX##_impl_sort_sort2(a, b, cmp);                                      \
+    }                                                                          \
+                                                                               \
+    /* Partitions [begin, end) around the pivot at begin. Elements equal to */ \
+    /* the pivot go to the right. Returns the final position of the pivot. */  \
+    static V *PFX##_impl_sort_partition_right(                                 \
+        V *begin, V *end, int (*cmp)(V, V), bool *already_partitioned)         \
+    {                                                                          \
+        V pivot = *begin;                                                      \
+        V *first = begin;                                                      \
+        V *last = end;                                                         \
+                                                                               \
+        /* There is at least one element greater than or equal to the pivot */ \
+        /* because of the median of three */                                   \
+        while (cmp(*++first, pivot) < 0)                                       \
+            ;                                                                  \
+                                                                               \
+        if (first - 1 == begin)                                                \
+        {                                                                      \
+            while (first < last && cmp(*--last, pivot) >= 0)                   \
+                ;                                                              \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            while (cmp(*--last, pivot) >= 0)                                   \
+                ;                                                              \
+        }                                                                      \
+                                                                               \
+        /* No swaps are needed if the first pair of elements is crossed */     \
+        *already_partitioned = first >= last;                                  \
+                                                                               \
+        while (first < last)                                                   \
+        {                                                                      \
+            PFX##_impl_sort_swap(first, last);                                 \
+                                                                               \
+            while (cmp(*++first, pivot) < 0)                                   \
+                ;                                                              \
+            while (cmp(*--last, pivot) >= 0)                                   \
+                ;                                                              \
+        }                                                                      \
+                                                                               \
+        V *pivot_pos = first - 1;                                              \
+                                                                               \
+        *begin = *pivot_pos;                                                   \
+        *pivot_pos = pivot;                                                    \
+                                                                               \
+        return pivot_pos;                                                      \
+    }                                                                          \
+                                                                               \
+    /* Partitions [begin, end) around the pivot at begin. Elements equal to */ \
+    /* the pivot go to the left. Returns the final position of the pivot. */   \
+    static V *PFX##_impl_sort_partition_left(V *begin, V *end,                 \
+                                             int (*cmp)(V, V))                 \
+    {                                                                          \
+        V pivot = *begin;                                                      \
+        V *first = begin;                                                      \
+        V *last = end;                                                         \
+                                                                               \
+        while (cmp(pivot, *--last) < 0)                                        \
+            ;                                                                  \
+                                                                               \
+        if (last + 1 == end)                                                   \
+        {                                                                      \
+            while (first < last && cmp(pivot, *++first) >= 0)                  \
+                ;                                                              \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            while (cmp(pivot, *++first) >= 0)                                  \
+                ;                                                              \
+        }                                                                      \
+                                                                               \
+        while (first < last)                                                   \
+        {                                                                      \
+            PFX##_impl_sort_swap(first, last);                                 \
+                                                                               \
+            while (cmp(pivot, *--last) < 0)                                    \
+                ;                                                              \
+            while (cmp(pivot, *++first) >= 0)                                  \
+                ;                                                              \
+        }                                                                      \
+                                                                               \
+        V *pivot_pos = last;                                                   \
+                                                                               \
+        *begin = *pivot_pos;                                                   \
+        *pivot_pos = pivot;                                                    \
+                                                                               \
+        return pivot_pos;                                                      \
+    }                                                                          \
+                                                                               \
+    /* Sorts the range [begin, end). If it is not the leftmost partition */    \
+    /* then the element before begin is less than or equal to all elements */  \
+    /* in the range. */                                                        \
+    static void PFX##_impl_sort_pdqsort(V *begin, V *end, int (*cmp)(V, V),    \
+                                        size_t bad_allowed, bool leftmost)     \
+    {                                                                          \
+        while (true)                                                           \
+        {                                                                      \
+            size_t size = (size_t)(end - begin);                               \
+                                                                               \
+            if (size < CMC_SORT_INSERTION_THRESHOLD)                           \
+            {                                                                  \
+                if (leftmost)                                                  \
+                    PFX##_impl_sort_insertion(begin, end, cmp);                \
+                else                                                           \
+                    PFX##_impl_sort_insertion_unguarded(begin, end, cmp);      \
+                                                                               \
+                return;                                                        \
+            }                                                                  \
+                                                                               \
+            /* Move the chosen pivot to begin */                               \
+            size_t s2 = size / 2;                                              \
+                                                                               \
+            if (size > CMC_SORT_NINTHER_THRESHOLD)                             \
+            {                                                                  \
+                PFX##_impl_sort_sort3(begin, begin + s2, end - 1, cmp);        \
+                PFX##_impl_sort_sort3(begin + 1, begin + (s2 - 1), end - 2,    \
+                                      cmp);                                    \
+                PFX##_impl_sort_sort3(begin + 2, begin + (s2 + 1), end - 3,    \
+                                      cmp);                                    \
+                PFX##_impl_sort_sort3(begin + (s2 - 1), begin + s2,            \
+                                      begin + (s2 + 1), cmp);                  \
+                PFX##_impl_sort_swap(begin, begin + s2);                       \
+            }                                                                  \
+            else                                                               \
+                PFX##_impl_sort_sort3(begin + s2, begin, end - 1, cmp);        \
+                                                                               \
+            /* If the pivot is equal to the element before this partition, */  \
+            /* which was a previous pivot, there is no element less than */    \
+            /* it so put all elements equal to it to the left and skip them */ \
+            if (!leftmost && cmp(*(begin - 1), *begin) >= 0)                   \
+            {                                                                  \
+                begin = PFX##_impl_sort_partition_left(begin, end, cmp) + 1;   \
+                continue;                                                      \
+            }                                                                  \
+                                                                               \
+            bool already_partitioned;                                          \
+                                                                               \
+            V *pivot_pos = PFX##_impl_sort_partition_right(                    \
+                begin, end, cmp, &already_partitioned);                        \
+                                                                               \
+            size_t l_size = (size_t)(pivot_pos - begin);                       \
+            size_t r_size = (size_t)(end - (pivot_pos + 1));                   \
+                                                                               \
+            if (l_size < size / 8 || r_size < size / 8)                        \
+            {                                                                  \
+                /* Too many bad partitions, switch to heapsort */              \
+                if (--bad_allowed == 0)                                        \
+                {                                                              \
+                    PFX##_impl_sort_heapsort(begin, end, cmp);                 \
+                    return;                                                    \
+                }                                                              \
+                                                                               \
+                /* Break patterns that might cause bad partitions */           \
+                if (l_size >= CMC_SORT_INSERTION_THRESHOLD)                    \
+                {                                                              \
+                    size_t q = l_size / 4;                                     \
+                                                                               \
+                    PFX##_impl_sort_swap(begin, begin + q);                    \
+                    PFX##_impl_sort_swap(pivot_pos - 1, pivot_pos - q);        \
+                                                                               \
+                    if (l_size > CMC_SORT_NINTHER_THRESHOLD)                   \
+                    {                                                          \
+                        PFX##_impl_sort_swap(begin + 1, begin + (q + 1));      \
+                        PFX##_impl_sort_swap(begin + 2, begin + (q + 2));      \
+                        PFX##_impl_sort_swap(pivot_pos - 2,                    \
+                                             pivot_pos - (q + 1));             \
+                        PFX##_impl_sort_swap(pivot_pos - 3,                    \
+                                             pivot_pos - (q + 2));             \
+                    }                                                          \
+                }                                                              \
+                                                                               \
+                if (r_size >= CMC_SORT_INSERTION_THRESHOLD)                    \
+                {                                                              \
+                    size_t q = r_size / 4;                                     \
+                                                                               \
+                    PFX##_impl_sort_swap(pivot_pos + 1, pivot_pos + (1 + q));  \
+                    PFX##_impl_sort_swap(end - 1, end - q);                    \
+                                                                               \
+                    if (r_size > CMC_SORT_NINTHER_THRESHOLD)                   \
+                    {                                                          \
+                        PFX##_impl_sort_swap(pivot_pos + 2,                    \
+                                             pivot_pos + (2 + q));             \
+                        PFX##_impl_sort_swap(pivot_pos + 3,                    \
+                                             pivot_pos + (3 + q));             \
+                        PFX##_impl_sort_swap(end - 2, end - (1 + q));          \
+                        PFX##_impl_sort_swap(end - 3, end - (2 + q));          \
+                    }                                                          \
+                }                                                              \
+            }                                                                  \
+            else if (already_partitioned &&                                    \
+                     PFX##_impl_sort_insertion_partial(begin, pivot_pos,       \
+                                                       cmp) &&                 \
+                     PFX##_impl_sort_insertion_partial(pivot_pos + 1, end,     \
+                                                       cmp))                   \
+            {                                                                  \
+                /* The partition seems to be sorted already */                 \
+                return;                                                        \
+            }                                                                  \
+                                                                               \
+            /* Recurse into the left partition and loop over the right one */  \
+            PFX##_impl_sort_pdqsort(begin, pivot_pos, cmp, bad_allowed,        \
+                                    leftmost);                                 \
+                                                                               \
+            begin = pivot_pos + 1;                                             \
+            leftmost = false;                                                  \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    /* Sorts an array of count elements in ascending order */                  \
+    static void PFX##_impl_sort(V *array, size_t count, int (*cmp)(V, V))      \
+    {                                                                          \
+        if (count < 2)                                                         \
+            return;                                                            \
+                                                                               \
+        /* Amount of bad partitions allowed before switching to heapsort */    \
+        size_t bad_allowed = 0;                                                \
+                                                                               \
+        for (size_t n = count; n > 1; n >>= 1)                                 \
+            bad_allowed++;                                                     \
+                                                                               \
+        PFX##_impl_sort_pdqsort(array, array + count, cmp, bad_allowed, true); \
+    }
+
+/* -------------------------------------------------------------------------
+ * Radix Sort Source
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_SORT_RADIX(PFX, V, K, KEY)                               \
+                                                                              \
+    CMC_GENERATE_SORT(PFX, V)                                                 \
+                                                                              \
+    /* Sorts an array of count elements in ascending order of their keys */   \
+    /* using aux as a buffer of the same size. The sort is stable. */         \
+    static void PFX##_impl_sort_radix_lsd(V *array, V *aux, size_t count)     \
+    {                                                                         \
+        /* Histograms of every byte of the keys, computed in a single pass */ \
+        size_t histogram[sizeof(K)][256];                                     \
+                                                                              \
+        memset(histogram, 0, sizeof(histogram));                              \
+                                                                              \
+        K first = KEY(array[0]);                                              \
+        K previous = first;                                                   \
+        bool sorted = true;                                                   \
+                                                                              \
+        for (size_t i = 0; i < count; i++)                                    \
+        {                                                                     \
+            K key = KEY(array[i]);                                            \
+                                                                              \
+            for (size_t d = 0; d < sizeof(K); d++)                            \
+                histogram[d][(key >> (d * 8)) & 0xFF]++;                      \
+                                                                              \
+            if (key < previous)                                               \
+                sorted = false;                                               \
+                                                                              \
+            previous = key;                                                   \
+        }                                                                     \
+                                                                              \
+        if (sorted)                                                           \
+            return;                                                           \
+        V *source = array;                                                    \
+        V *target = aux;                                                      \
+                                                                              \
+        for (size_t d = 0; d < sizeof(K); d++)                                \
+        {                                                                     \
+            size_t *offsets = histogram[d];                                   \
+                                                                              \
+            /* Every key has the same byte so this pass wouldn't move them */ \
+            if (offsets[(first >> (d * 8)) & 0xFF] == count)                  \
+                continue;                                                     \
+                                                                              \
+            size_t sum = 0;                                                   \
+                                                                              \
+            for (size_t b = 0; b < 256; b++)                                  \
+            {                                                                 \
+                size_t n = offsets[b];                                        \
+                offsets[b] = sum;                                             \
+                sum += n;                                                     \
+            }                                                                 \
+                                                                              \
+            for (size_t i = 0; i < count; i++)                                \
+                target[offsets[(KEY(source[i]) >> (d * 8)) & 0xFF]++] =       \
+                    source[i];                                                \
+                                                                              \
+            V *tmp = source;                                                  \
+            source = target;                                                  \
+            target = tmp;                                                     \
+        }                                                                     \
+                                                                              \
+        if (source != array)                                                  \
+            memcpy(array, source, sizeof(V) * count);                         \
+    }                                                                         \
+                                                                              \
+    /* Sorts an array of count elements in ascending order with a radix */    \
+    /* sort, or with the comparison sort if it is too small or if the */      \
+    /* auxiliary buffer can't be allocated */                                 \
+    static void PFX##_impl_sort_radix(V *array, size_t count,                 \
+                                      struct cmc_alloc_node *alloc,           \
+                                      int (*cmp)(V, V))                       \
+    {                                                                         \
+        if (count < CMC_SORT_RADIX_THRESHOLD)                                 \
+        {                                                                     \
+            PFX##_impl_sort(array, count, cmp);                               \
+            return;                                                           \
+        }                                                                     \
+                                                                              \
+        V *aux = alloc->malloc(sizeof(V) * count);                            \
+                                                                              \
+        if (!aux)                                                             \
+        {                                                                     \
+            PFX##_impl_sort(array, count, cmp);                               \
+            return;                                                           \
+        }                                                                     \
+                                                                              \
+        PFX##_impl_sort_radix_lsd(array, aux, count);                         \
+                                                                              \
+        alloc->free(aux);                                                     \
+    }
+
+/* -------------------------------------------------------------------------
+ * Parallel Sort Source
+ * ------------------------------------------------------------------------- */
+#define CMC_GENERATE_SORT_PARALLEL(PFX, SNAME, V)                             \
+                                                                              \
+    /* A chunk to be sorted or a part of the merge of two sorted runs */      \
+    struct SNAME##_impl_sort_task                                             \
+    {                                                                         \
+        /* First run, or the chunk to be sorted */                            \
+        V *run1;                                                              \
+        size_t count1;                                                        \
+                                                                              \
+        /* Second run */                                                      \
+        V *run2;                                                              \
+        size_t count2;                                                        \
+                                                                              \
+        /* Where the merge of both runs is written to */                      \
+        V *target;                                                            \
+                                                                              \
+        /* The part [from, to) of the merge done by this task */              \
+        size_t from;                                                          \
+        size_t to;                                                            \
+                                                                              \
+        /* Comparator function */                                             \
+        int (*cmp)(V, V);                                                     \
+                                                                              \
+        /* Sorts a chunk, or NULL if the task is a merge */                   \
+        void (*sort)(V *, size_t, void *);                                    \
+        void *args;                                                           \
+    };                                                                        \
+                                                                              \
+    /* Threads that run the tasks of every step of a parallel sort. They */   \
+    /* are started once per sort and wait for each step on a condition */     \
+    /* variable instead of being created and joined for every step. */        \
+    struct SNAME##_impl_sort_pool                                             \
+    {                                                                         \
+        /* Tasks of the current step, the first one is run by the caller */   \
+        struct SNAME##_impl_sort_task *tasks;                                 \
+        size_t total;                                                         \
+                                                                              \
+        /* Amount of threads that were started */                             \
+        size_t workers;                                                       \
+                                                                              \
+        /* Incremented when a new step starts */                              \
+        size_t step;                                                          \
+                                                                              \
+        /* Threads that haven't finished the current step */                  \
+        size_t pending;                                                       \
+                                                                              \
+        /* If the threads should return */                                    \
+        bool stop;                                                            \
+                                                                              \
+        struct cmc_mutex mutex;                                               \
+                                                                              \
+        /* Signaled when a step starts and when it is finished */             \
+        struct cmc_condvar start;                                             \
+        struct cmc_condvar done;                                              \
+    };                                                                        \
+                                                                              \
+    /* Arguments of each thread of the pool */                                \
+    struct SNAME##_impl_sort_worker                                           \
+    {                                                                         \
+        struct SNAME##_impl_sort_pool *pool;                                  \
+                                                                              \
+        /* Index of the task run by this thread on every step */              \
+        size_t index;                                                         \
+    };                                                                        \
+                                                                              \
+    /* Amount of elements of run1 that come before the index-th element of */ \
+    /* the merge of both runs. Elements of run1 come first if equal. */       \
+    static size_t PFX##_impl_sort_split(struct SNAME##_impl_sort_task *task,  \
+                                        size_t index)                         \
+    {                                                                         \
+        size_t lo = index > task->count2 ? index - task->count2 : 0;          \
+        size_t hi = index < task->count1 ? index : task->count1;              \
+                                                                              \
+        while (lo < hi)                                                       \
+        {                                                                     \
+            size_t i = lo + (hi - lo) / 2;                                    \
+                                                                              \
+            if (task->cmp(task->run1[i], task->run2[index - i - 1]) <= 0)     \
+                lo = i + 1;                                                   \
+            else                                                              \
+                hi = i;                                                       \
+        }                                                                     \
+                                                                              \
+        return lo;                                                            \
+    }                                                                         \
+                                                                              \
+    static int PFX##_impl_sort_task_thread(void *args)                        \
+    {                                                                         \
+        struct SNAME##_impl_sort_task *task = args;                           \
+                                                                              \
+        if (task->sort)                                                       \
+        {                                                                     \
+            task->sort(task->run1, task->count1, task->args);                 \
+            return 0;                                                         \
+        }                                                                     \
+                                                                              \
+        size_t i = PFX##_impl_sort_split(task, task->from);                   \
+        size_t j = task->from - i;                                            \
+        size_t i_end = PFX##_impl_sort_split(task, task->to);                 \
+        size_t j_end = task->to - i_end;                                      \
+                                                                              \
+        V *target = task->target + task->from;                                \
+                                                                              \
+        while (i < i_end && j < j_end)                                        \
+        {                                                                     \
+            if (task->cmp(task->run2[j], task->run1[i]) < 0)                  \
+                *target++ = task->run2[j++];                                  \
+            else                                                              \
+                *target++ = task->run1[i++];                                  \
+        }                                                                     \
+                                                                              \
+        while (i < i_end)                                                     \
+            *target++ = task->run1[i++];                                      \
+                                                                              \
+        while (j < j_end)                                                     \
+            *target++ = task->run2[j++];                                      \
+                                                                              \
+        return 0;                                                             \
+    }                                                                         \
+                                                                              \
+    static int PFX##_impl_sort_worker_thread(void *args)                      \
+    {                                                                         \
+        struct SNAME##_impl_sort_worker *worker = args;                       \
+        struct SNAME##_impl_sort_pool *pool = worker->pool;                   \
+                                                                              \
+        size_t step = 0;                                                      \
+                                                                              \
+        cmc_mtx_lock(&pool->mutex);                                           \
+                                                                              \
+        while (true)                                                          \
+        {                                                                     \
+            while (pool->step == step && !pool->stop)                         \
+                cmc_cnd_wait(&pool->start, &pool->mutex);                     \
+                                                                              \
+            if (pool->stop)                                                   \
+                break;                                                        \
+                                                                              \
+            step = pool->step;                                                \
+                                                                              \
+            if (worker->index < pool->total)                                  \
+            {                                                                 \
+                cmc_mtx_unlock(&pool->mutex);                                 \
+                                                                              \
+                PFX##_impl_sort_task_thread(&pool->tasks[worker->index]);     \
+                                                                              \
+                cmc_mtx_lock(&pool->mutex);                                   \
+            }                                                                 \
+                                                                              \
+            if (--pool->pending == 0)                                         \
+                cmc_cnd_signal(&pool->done);                                  \
+        }                                                                     \
+                                                                              \
+        cmc_mtx_unlock(&pool->mutex);                                         \
+                                                                              \
+        return 0;                                                             \
+    }                                                                         \
+                                                                              \
+    /* Starts up to threads - 1 threads. The tasks of the threads that */     \
+    /* could not be started are run by the caller. */                         \
+    static void PFX##_impl_sort_start(                                        \
+        struct SNAME##_impl_sort_pool *pool,                                  \
+        struct SNAME##_impl_sort_worker *workers, struct cmc_thread *thrds,   \
+        size_t threads)                                                       \
+    {                                                                         \
+        pool->total = 0;                                                      \
+        pool->workers = 0;                                                    \
+        pool->step = 0;                                                       \
+        pool->pending = 0;                                                    \
+        pool->stop = false;                                                   \
+                                                                              \
+        if (!cmc_mtx_init(&pool->mutex))                                      \
+            return;                                                           \
+                                                                              \
+        if (!cmc_cnd_init(&pool->start))                                      \
+        {                                                                     \
+            cmc_mtx_destroy(&pool->mutex);                                    \
+            return;                                                           \
+        }                                                                     \
+                                                                              \
+        if (!cmc_cnd_init(&pool->done))                                       \
+        {                                                                     \
+            cmc_cnd_destroy(&pool->start);                                    \
+            cmc_mtx_destroy(&pool->mutex);                                    \
+            return;                                                           \
+        }                                                                     \
+                                                                              \
+        for (size_t i = 1; i < threads; i++)                                  \
+        {                                                                     \
+            workers[i].pool = pool;                                           \
+            workers[i].index = i;                                             \
+                                                                              \
+            if (!cmc_thrd_create(&thrds[i], PFX##_impl_sort_worker_thread,    \
+                                 &workers[i]))                                \
+                break;                                                        \
+                                                                              \
+            pool->workers++;                                                  \
+        }                                                                     \
+                                                                              \
+        if (pool->workers == 0)                                               \
+        {                                                                     \
+            cmc_cnd_destroy(&pool->done);                                     \
+            cmc_cnd_destroy(&pool->start);                                    \
+            cmc_mtx_destroy(&pool->mutex);                                    \
+        }                                                                     \
+    }                                                                         \
+                                                                              \
+    /* Runs the first count tasks as one step, the first one in the */        \
+    /* calling thread, and waits until every thread is done with it */        \
+    static void PFX##_impl_sort_run(struct SNAME##_impl_sort_pool *pool,      \
+                                    size_t count)                             \
+    {                                                                         \
+        if (pool->workers > 0)                                                \
+        {                                                                     \
+            cmc_mtx_lock(&pool->mutex);                                       \
+                                                                              \
+            pool->total = count;                                              \
+            pool->pending = pool->workers;                                    \
+            pool->step++;                                                     \
+                                                                              \
+            cmc_cnd_broadcast(&pool->start);                                  \
+            cmc_mtx_unlock(&pool->mutex);                                     \
+        }                                                                     \
+                                                                              \
+        PFX##_impl_sort_task_thread(&pool->tasks[0]);                         \
+                                                                              \
+        /* Tasks of the threads that could not be started */                  \
+        for (size_t i = pool->workers + 1; i < count; i++)                    \
+            PFX##_impl_sort_task_thread(&pool->tasks[i]);                     \
+                                                                              \
+        if (pool->workers > 0)                                                \
+        {                                                                     \
+            cmc_mtx_lock(&pool->mutex);                                       \
+                                                                              \
+            while (pool->pending > 0)                                         \
+                cmc_cnd_wait(&pool->done, &pool->mutex);                      \
+                                                                              \
+            cmc_mtx_unlock(&pool->mutex);                                     \
+        }                                                                     \
+    }                                                                         \
+                                                                              \
+    /* Stops and joins every thread of the pool */                            \
+    static void PFX##_impl_sort_stop(struct SNAME##_impl_sort_pool *pool,     \
+                                     struct cmc_thread *thrds)                \
+    {                                                                         \
+        if (pool->workers == 0)                                               \
+            return;                                                           \
+                                                                              \
+        cmc_mtx_lock(&pool->mutex);                                           \
+                                                                              \
+        pool->stop = true;                                                    \
+                                                                              \
+        cmc_cnd_broadcast(&pool->start);                                      \
+        cmc_mtx_unlock(&pool->mutex);                                         \
+                                                                              \
+        for (size_t i = 1; i <= pool->workers; i++)                           \
+            cmc_thrd_join(&thrds[i], NULL);                                   \
+                                                                              \
+        cmc_cnd_destroy(&pool->done);                                         \
+        cmc_cnd_destroy(&pool->start);                                        \
+        cmc_mtx_destroy(&pool->mutex);                                        \
+    }                                                                         \
+                                                                              \
+    /* Sorts an array of count elements using up to the given amount of */    \
+    /* threads. Each chunk is sorted by sort(chunk, size, args) and the */    \
+    /* chunks are merged using cmp. Returns false if the buffers could not */ \
+    /* be allocated, leaving the array untouched. */                          \
+    static bool PFX##_impl_sort_parallel(                                     \
+        V *array, size_t count, size_t threads, struct cmc_alloc_node *alloc, \
+        int (*cmp)(V, V), void (*sort)(V *, size_t, void *), void *args)      \
+    {                                                                         \
+        if (threads > count / CMC_SORT_PARALLEL_CUTOFF)                       \
+            threads = count / CMC_SORT_PARALLEL_CUTOFF;                       \
+                                                                              \
+        if (threads < 2)                                                      \
+        {                                                                     \
+            sort(array, count, args);                                         \
+            return true;                                                      \
+        }                                                                     \
+                                                                              \
+        V *aux = alloc->malloc(sizeof(V) * count);                            \
+        size_t *bounds = alloc->malloc(sizeof(size_t) * (threads + 1));       \
+        struct SNAME##_impl_sort_task *tasks =                                \
+            alloc->malloc(sizeof(struct SNAME##_impl_sort_task) * threads);   \
+        struct SNAME##_impl_sort_worker *workers =                            \
+            alloc->malloc(sizeof(struct SNAME##_impl_sort_worker) * threads); \
+        struct cmc_thread *thrds =                                            \
+            alloc->malloc(sizeof(struct cmc_thread) * threads);               \
+                                                                              \
+        if (!aux || !bounds || !tasks || !workers || !thrds)                  \
+        {                                                                     \
+            alloc->free(aux);                                                 \
+            alloc->free(bounds);                                              \
+            alloc->free(tasks);                                               \
+            alloc->free(workers);                                             \
+            alloc->free(thrds);                                               \
+                                                                              \
+            return false;                                                     \
+        }                                                                     \
+                                                                              \
+        struct SNAME##_impl_sort_pool pool;                                   \
+        pool.tasks = tasks;                                                   \
+                                                                              \
+        PFX##_impl_sort_start(&pool, workers, thrds, threads);                \
+                                                                              \
+        /* Sort every chunk */                                                \
+        for (size_t i = 0; i <= threads; i++)                                 \
+            bounds[i] = count * i / threads;                                  \
+                                                                              \
+        for (size_t i = 0; i < threads; i++)                                  \
+        {                                                                     \
+            tasks[i] = (struct SNAME##_impl_sort_task){ 0 };                  \
+            tasks[i].run1 = array + bounds[i];                                \
+            tasks[i].count1 = bounds[i + 1] - bounds[i];                      \
+            tasks[i].sort = sort;                                             \
+            tasks[i].args = args;                                             \
+        }                                                                     \
+                                                                              \
+        PFX##_impl_sort_run(&pool, threads);                                  \
+                                                                              \
+        /* Merge pairs of runs until there is only one left */                \
+        V *source = array;                                                    \
+        V *target = aux;                                                      \
+        size_t runs = threads;                                                \
+                                                                              \
+        while (runs > 1)                                                      \
+        {                                                                     \
+            size_t pairs = (runs + 1) / 2;                                    \
+            size_t parts = threads / pairs;                                   \
+            size_t total = 0;                                                 \
+                                                                              \
+            for (size_t p = 0; p < pairs; p++)                                \
+            {                                                                 \
+                size_t begin = bounds[2 * p];                                 \
+                size_t middle = bounds[2 * p + 1];                            \
+                size_t end = 2 * p + 2 <= runs ? bounds[2 * p + 2] : middle;  \
+                                                                              \
+                for (size_t k = 0; k < parts; k++)                            \
+                {                                                             \
+                    struct SNAME##_impl_sort_task *task = &tasks[total++];    \
+                                                                              \
+                    *task = (struct SNAME##_impl_sort_task){ 0 };             \
+                    task->run1 = source + begin;                              \
+                    task->count1 = middle - begin;                            \
+                    task->run2 = source + middle;                             \
+                    task->count2 = end - middle;                              \
+                    task->target = target + begin;                            \
+                    task->from = (end - begin) * k / parts;                   \
+                    task->to = (end - begin) * (k + 1) / parts;               \
+                    task->cmp = cmp;                                          \
+                }                                                             \
+                                                                              \
+                bounds[p] = begin;                                            \
+            }                                                                 \
+                                                                              \
+            bounds[pairs] = count;                                            \
+                                                                              \
+            PFX##_impl_sort_run(&pool, total);                                \
+                                                                              \
+            V *tmp = source;                                                  \
+            source = target;                                                  \
+            target = tmp;                                                     \
+            runs = pairs;                                                     \
+        }                                                                     \
+                                                                              \
+        PFX##_impl_sort_stop(&pool, thrds);                                   \
+                                                                              \
+        if (source != array)                                                  \
+            memcpy(array, source, sizeof(V) * count);                         \
+                                                                              \
+        alloc->free(aux);                                                     \
+        alloc->free(bounds);                                                  \
+        alloc->free(tasks);                                                   \
+        alloc->free(workers);                                                 \
+        alloc->free(thrds);                                                   \
+                                                                              \
+        return true;                                                          \
+    }
+
+#endif /* CMC_COR_SORT_H */
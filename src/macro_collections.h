@@ -26,31 +26,47 @@
     CMC_CONCAT(C, SOURCE)(PFX, SNAME, K, V)
 
 #include "cor/bitset.h"       /* Added in 20/05/2020 */
+#include "cor/btree.h"        /* Added in 19/10/2026 */
 #include "cor/core.h"         /* Added in 17/03/2020 */
 #include "cor/flags.h"        /* Added in 14/05/2020 */
 #include "cor/hashtable.h"    /* Added in 17/03/2020 */
+#include "cor/heap.h"         /* Added in 19/10/2026 */
+#include "cor/search.h"       /* Added in 19/10/2026 */
+#include "cor/sort.h"         /* Added in 19/10/2026 */
 
 #include "cmc/bitset.h"       /* Added in 30/04/2020 */
+#include "cmc/btreemap.h"     /* Added in 19/10/2026 */
+#include "cmc/btreeset.h"     /* Added in 19/10/2026 */
 #include "cmc/deque.h"        /* Added in 20/03/2019 */
+#include "cmc/gapbuffer.h"    /* Added in 19/10/2026 */
 #include "cmc/hashbidimap.h"  /* Added in 26/09/2019 */
 #include "cmc/hashmap.h"      /* Added in 03/04/2019 */
 #include "cmc/hashmultimap.h" /* Added in 26/04/2019 */
 #include "cmc/hashmultiset.h" /* Added in 10/04/2019 */
 #include "cmc/hashset.h"      /* Added in 01/04/2019 */
 #include "cmc/heap.h"         /* Added in 25/03/2019 */
+#include "cmc/indexheap.h"    /* Added in 19/10/2026 */
 #include "cmc/intervalheap.h" /* Added in 06/07/2019 */
+#include "cmc/lfstack.h"      /* Added in 19/10/2026 */
 #include "cmc/linkedlist.h"   /* Added in 22/03/2019 */
 #include "cmc/list.h"         /* Added in 12/02/2019 */
+#include "cmc/mpmcqueue.h"    /* Added in 19/10/2026 */
 #include "cmc/queue.h"        /* Added in 15/02/2019 */
+#include "cmc/radixheap.h"    /* Added in 19/10/2026 */
+#include "cmc/segdeque.h"     /* Added in 19/10/2026 */
+#include "cmc/smallvec.h"     /* Added in 19/10/2026 */
 #include "cmc/sortedlist.h"   /* Added in 17/09/2019 */
+#include "cmc/spscqueue.h"    /* Added in 19/10/2026 */
 #include "cmc/stack.h"        /* Added in 14/02/2019 */
 #include "cmc/treemap.h"      /* Added in 28/03/2019 */
 #include "cmc/treeset.h"      /* Added in 27/03/2019 */
+#include "cmc/unrolledlist.h" /* Added in 19/10/2026 */
 
 #include "sac/queue.h"
 #include "sac/stack.h"
 
 #include "utl/assert.h"       /* Added in 27/06/2019 */
+#include "utl/condvar.h"      /* Added in 19/10/2026 */
 #include "utl/foreach.h"      /* Added in 25/02/2019 */
 #include "utl/futils.h"       /* Added in 15/04/2020 */
 #include "utl/log.h"          /* Added in 21/06/2019 */
@@ -91,6 +91,8 @@
     /* Collection Input and Output */                                             \
     FMOD bool PFX##_enqueue(SNAME *_queue_, V element);                           \
     FMOD bool PFX##_dequeue(SNAME *_queue_);                                      \
+    FMOD bool PFX##_enqueue_n(SNAME *_queue_, V *elements, size_t n);             \
+    FMOD size_t PFX##_dequeue_n(SNAME *_queue_, V *elements, size_t n);           \
     /* Conditional Input and Output */                                            \
     FMOD bool PFX##_enqueue_if(SNAME *_queue_, V element, bool condition);        \
     FMOD bool PFX##_dequeue_if(SNAME *_queue_, bool condition);                   \
@@ -183,6 +185,54 @@
         return true;                                                                                  \
     }                                                                                                 \
                                                                                                       \
+    /* Enqueues n elements if they all fit, copying them in at most two */                            \
+    /* parts split where the buffer wraps around */                                                   \
+    FMOD bool PFX##_enqueue_n(SNAME *_queue_, V *elements, size_t n)                                  \
+    {                                                                                                 \
+        if (n > SIZE - _queue_->count)                                                                \
+            return false;                                                                             \
+                                                                                                      \
+        size_t count1 = SIZE - _queue_->rear;                                                         \
+                                                                                                      \
+        if (count1 > n)                                                                               \
+            count1 = n;                                                                               \
+                                                                                                      \
+        memcpy(_queue_->buffer + _queue_->rear, elements, sizeof(V) * count1);                        \
+        memcpy(_queue_->buffer, elements + count1, sizeof(V) * (n - count1));                         \
+                                                                                                      \
+        _queue_->rear = (_queue_->rear + n) % SIZE;                                                   \
+        _queue_->count += n;                                                                          \
+                                                                                                      \
+        return true;                                                                                  \
+    }                                                                                                 \
+                                                                                                      \
+    /* Dequeues up to n elements, copying them to elements if it is not */                            \
+    /* NULL, and returns how many were dequeued */                                                    \
+    FMOD size_t PFX##_dequeue_n(SNAME *_queue_, V *elements, size_t n)                                \
+    {                                                                                                 \
+        if (n > _queue_->count)                                                                       \
+            n = _queue_->count;                                                                       \
+                                                                                                      \
+        size_t count1 = SIZE - _queue_->front;                                                        \
+                                                                                                      \
+        if (count1 > n)                                                                               \
+            count1 = n;                                                                               \
+                                                                                                      \
+        if (elements)                                                                                 \
+        {                                                                                             \
+            memcpy(elements, _queue_->buffer + _queue_->front, sizeof(V) * count1);                   \
+            memcpy(elements + count1, _queue_->buffer, sizeof(V) * (n - count1));                     \
+        }                                                                                             \
+                                                                                                      \
+        for (size_t i = 0; i < n; i++)                                                                \
+            _queue_->buffer[(_queue_->front + i) % SIZE] = PFX##_impl_default_value();                \
+                                                                                                      \
+        _queue_->front = (_queue_->front + n) % SIZE;                                                 \
+        _queue_->count -= n;                                                                          \
+                                                                                                      \
+        return n;                                                                                     \
+    }                                                                                                 \
+                                                                                                      \
     FMOD bool PFX##_enqueue_if(SNAME *_queue_, V element, bool condition)                             \
     {                                                                                                 \
         if (condition)                                                                                \
@@ -670,8 +670,8 @@ static uintmax_t cmc_assert_failed = 0;
     {                                                                                 \
         cmc_assert_total++;                                                           \
         const char *str = #actual;                                                    \
-        void *expected__ = (expected);                                                \
-        void *actual__ = (actual);                                                    \
+        const void *expected__ = (expected);                                          \
+        const void *actual__ = (actual);                                              \
                                                                                       \
         if (expected__ != actual__)                                                   \
         {                                                                             \
@@ -1001,8 +1001,8 @@ static uintmax_t cmc_assert_failed = 0;
     {                                                                                     \
         cmc_assert_total++;                                                               \
         const char *str = #actual;                                                        \
-        void *not_expected__ = (not_expected);                                            \
-        void *actual__ = (actual);                                                        \
+        const void *not_expected__ = (not_expected);                                      \
+        const void *actual__ = (actual);                                                  \
                                                                                           \
         if (not_expected__ == actual__)                                                   \
         {                                                                                 \
@@ -0,0 +1,250 @@
+/**
+ * condvar.h
+ *
+ * Creation Date: 19/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * A very simple, header-only and minimalistic cross-platform condition
+ * variable that works together with a cmc_mutex (see mutex.h)
+ *
+ * Types
+ *  - cmc_condvar
+ *
+ * Functions
+ *  - cmc_cnd_init
+ *  - cmc_cnd_destroy
+ *  - cmc_cnd_wait
+ *  - cmc_cnd_signal
+ *  - cmc_cnd_broadcast
+ *
+ * A thread may wake up from cmc_cnd_wait without being signaled, so the
+ * condition it is waiting for must always be checked again in a loop. The
+ * functions cmc_cnd_signal and cmc_cnd_broadcast must be called with the
+ * mutex used by the waiting threads locked.
+ */
+
+#ifndef CMC_CONDVAR_H
+#define CMC_CONDVAR_H
+
+#include <stdbool.h>
+
+#include "../cor/flags.h"
+#include "mutex.h"
+
+#if defined(_WIN32)
+#define CMC_CONDVAR_WINDOWS
+#elif defined(__unix__)
+#define CMC_CONDVAR_UNIX
+#else
+#error "Unknown platform for CMC Condition Variable"
+#endif
+
+/* Platform specific includes */
+#if defined(CMC_CONDVAR_WINDOWS)
+#include <limits.h>
+#include <windows.h>
+#elif defined(CMC_CONDVAR_UNIX)
+#include <pthread.h>
+#endif
+
+/**
+ * struct cmc_condvar
+ *
+ * A condition variable wrapper.
+ */
+struct cmc_condvar
+{
+#if defined(CMC_CONDVAR_WINDOWS)
+    /* The mutex of a cmc_mutex is a HANDLE, which can't be used with */
+    /* CONDITION_VARIABLE, so waiting threads sleep on a semaphore */
+    HANDLE semaphore;
+    long waiters;
+#elif defined(CMC_CONDVAR_UNIX)
+    pthread_cond_t cond;
+#endif
+    int flag;
+};
+
+/**
+ * Acquire resources for a condition variable.
+ *
+ * \param cnd An uninitialized condition variable wrapper.
+ * \return True or false if the condition variable was successfully
+ * initialized.
+ */
+static inline bool cmc_cnd_init(struct cmc_condvar *cnd)
+{
+#if defined(CMC_CONDVAR_WINDOWS)
+    cnd->waiters = 0;
+    cnd->semaphore = CreateSemaphore(NULL, 0, LONG_MAX, NULL);
+
+    if (cnd->semaphore == NULL)
+        cnd->flag = cmc_flags.THREAD;
+    else
+        cnd->flag = cmc_flags.OK;
+
+    return cnd->semaphore != NULL;
+
+#elif defined(CMC_CONDVAR_UNIX)
+    int err = pthread_cond_init(&(cnd->cond), NULL);
+
+    if (err != 0)
+        cnd->flag = cmc_flags.THREAD;
+    else
+        cnd->flag = cmc_flags.OK;
+
+    return err == 0;
+#endif
+}
+
+/**
+ * Release all resources from a condition variable. Calling this function
+ * while there are threads waiting on it causes undefined behavior.
+ *
+ * \param cnd A condition variable to be destroyed.
+ * \return True or false if the condition variable was successfully destroyed.
+ */
+static inline bool cmc_cnd_destroy(struct cmc_condvar *cnd)
+{
+#if defined(CMC_CONDVAR_WINDOWS)
+    if (!CloseHandle(cnd->semaphore))
+    {
+        cnd->flag = cmc_flags.THREAD;
+        return false;
+    }
+
+    cnd->flag = cmc_flags.OK;
+    return true;
+
+#elif defined(CMC_CONDVAR_UNIX)
+    if (pthread_cond_destroy(&(cnd->cond)) != 0)
+    {
+        cnd->flag = cmc_flags.THREAD;
+        return false;
+    }
+
+    cnd->flag = cmc_flags.OK;
+    return true;
+#endif
+}
+
+/**
+ * Unlocks the mutex and blocks the current thread until the condition
+ * variable is signaled, then locks the mutex again before returning. The
+ * mutex must be locked by the current thread.
+ *
+ * \param cnd The condition variable to wait on.
+ * \param mtx A mutex locked by the current thread.
+ * \return True or false if the thread successfully waited on the condition
+ * variable.
+ */
+static inline bool cmc_cnd_wait(struct cmc_condvar *cnd, struct cmc_mutex *mtx)
+{
+#if defined(CMC_CONDVAR_WINDOWS)
+    cnd->waiters++;
+
+    /* Unlocks the mutex and starts waiting in a single step, so a signal */
+    /* sent right after the mutex is unlocked is not lost */
+    DWORD result =
+        SignalObjectAndWait(mtx->mutex, cnd->semaphore, INFINITE, FALSE);
+
+    if (!cmc_mtx_lock(mtx) || result == WAIT_FAILED)
+    {
+        cnd->flag = cmc_flags.THREAD;
+        return false;
+    }
+
+    cnd->flag = cmc_flags.OK;
+    return true;
+
+#elif defined(CMC_CONDVAR_UNIX)
+    if (pthread_cond_wait(&(cnd->cond), &(mtx->mutex)) != 0)
+    {
+        cnd->flag = cmc_flags.THREAD;
+        return false;
+    }
+
+    cnd->flag = cmc_flags.OK;
+    return true;
+#endif
+}
+
+/**
+ * Wakes up at least one of the threads waiting on the condition variable, if
+ * there are any.
+ *
+ * \param cnd The condition variable to be signaled.
+ * \return True or false if the condition variable was successfully signaled.
+ */
+static inline bool cmc_cnd_signal(struct cmc_condvar *cnd)
+{
+#if defined(CMC_CONDVAR_WINDOWS)
+    if (cnd->waiters > 0)
+    {
+        cnd->waiters--;
+
+        if (!ReleaseSemaphore(cnd->semaphore, 1, NULL))
+        {
+            cnd->flag = cmc_flags.THREAD;
+            return false;
+        }
+    }
+
+    cnd->flag = cmc_flags.OK;
+    return true;
+
+#elif defined(CMC_CONDVAR_UNIX)
+    if (pthread_cond_signal(&(cnd->cond)) != 0)
+    {
+        cnd->flag = cmc_flags.THREAD;
+        return false;
+    }
+
+    cnd->flag = cmc_flags.OK;
+    return true;
+#endif
+}
+
+/**
+ * Wakes up all threads waiting on the condition variable.
+ *
+ * \param cnd The condition variable to be signaled.
+ * \return True or false if the condition variable was successfully signaled.
+ */
+static inline bool cmc_cnd_broadcast(struct cmc_condvar *cnd)
+{
+#if defined(CMC_CONDVAR_WINDOWS)
+    if (cnd->waiters > 0)
+    {
+        long waiters = cnd->waiters;
+
+        cnd->waiters = 0;
+
+        if (!ReleaseSemaphore(cnd->semaphore, waiters, NULL))
+        {
+            cnd->flag = cmc_flags.THREAD;
+            return false;
+        }
+    }
+
+    cnd->flag = cmc_flags.OK;
+    return true;
+
+#elif defined(CMC_CONDVAR_UNIX)
+    if (pthread_cond_broadcast(&(cnd->cond)) != 0)
+    {
+        cnd->flag = cmc_flags.THREAD;
+        return false;
+    }
+
+    cnd->flag = cmc_flags.OK;
+    return true;
+#endif
+}
+
+#endif /* CMC_CONDVAR_H */
@@ -163,21 +163,27 @@ static inline bool cmc_mtx_lock(struct cmc_mutex *mtx)
  */
 static inline bool cmc_mtx_unlock(struct cmc_mutex *mtx)
 {
+    /* The flag is written while the mutex is still locked since another */
+    /* thread might lock it right after it is unlocked */
+    mtx->flag = cmc_flags.OK;
+
 #if defined(CMC_MUTEX_WINDOWS)
     if (!ReleaseMutex(mtx->mutex))
+    {
         mtx->flag = cmc_flags.MUTEX;
-    else
-        mtx->flag = cmc_flags.OK;
+        return false;
+    }
 
-    return mtx->flag == cmc_flags.OK;
+    return true;
 
 #elif defined(CMC_MUTEX_UNIX)
     if (pthread_mutex_unlock(&mtx->mutex) != 0)
+    {
         mtx->flag = cmc_flags.MUTEX;
-    else
-        mtx->flag = cmc_flags.OK;
+        return false;
+    }
 
-    return mtx->flag == cmc_flags.OK;
+    return true;
 #endif
 }
 
@@ -199,15 +205,20 @@ static inline bool cmc_mtx_trylock(struct cmc_mutex *mtx)
         return false;
     }
 
+    /* Only the thread that holds the mutex may write to its flag */
+    if (result == WAIT_TIMEOUT)
+        return false;
+
     mtx->flag = cmc_flags.OK;
-    return result != WAIT_TIMEOUT;
+    return true;
 
 #elif defined(CMC_MUTEX_UNIX)
     int err = pthread_mutex_trylock(&mtx->mutex);
 
     if (err == EINVAL || err == EFAULT)
         mtx->flag = cmc_flags.MUTEX;
-    else
+    /* Only the thread that holds the mutex may write to its flag */
+    else if (err == 0)
         mtx->flag = cmc_flags.OK;
 
     return err == 0;
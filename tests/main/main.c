@@ -1,21 +1,33 @@
 #include "utl/timer.h"
 
 #include "unt/bitset.c"
+#include "unt/btreemap.c"
+#include "unt/btreeset.c"
 #include "unt/deque.c"
+#include "unt/gapbuffer.c"
 #include "unt/hashbidimap.c"
 #include "unt/hashmap.c"
 #include "unt/hashmultimap.c"
 #include "unt/hashmultiset.c"
 #include "unt/hashset.c"
 #include "unt/heap.c"
+#include "unt/indexheap.c"
 #include "unt/intervalheap.c"
+#include "unt/lfstack.c"
 #include "unt/linkedlist.c"
 #include "unt/list.c"
+#include "unt/mpmcqueue.c"
 #include "unt/queue.c"
+#include "unt/radixheap.c"
+#include "unt/sacqueue.c"
+#include "unt/segdeque.c"
+#include "unt/smallvec.c"
+#include "unt/spscqueue.c"
 #include "unt/sortedlist.c"
 #include "unt/stack.c"
 #include "unt/treemap.c"
 #include "unt/treeset.c"
+#include "unt/unrolledlist.c"
 
 #include "unt/foreach.c"
 
@@ -51,8 +63,14 @@ int main(void)
 
     cmc_run(BitSet, units, tests);
     cmc_run(BitSetIter, units, tests);
+    cmc_run(BTreeMap, units, tests);
+    cmc_run(BTreeMapIter, units, tests);
+    cmc_run(BTreeSet, units, tests);
+    cmc_run(BTreeSetIter, units, tests);
     cmc_run(Deque, units, tests);
     cmc_run(DequeIter, units, tests);
+    cmc_run(GapBuffer, units, tests);
+    cmc_run(GapBufferIter, units, tests);
     cmc_run(HashBidiMap, units, tests);
     cmc_run(HashBidiMapIter, units, tests);
     cmc_run(HashMap, units, tests);
@@ -65,14 +83,24 @@ int main(void)
     cmc_run(HashSetIter, units, tests);
     cmc_run(Heap, units, tests);
     cmc_run(HeapIter, units, tests);
+    cmc_run(IndexHeap, units, tests);
     cmc_run(IntervalHeap, units, tests);
     cmc_run(IntervalHeapIter, units, tests);
+    cmc_run(LFStack, units, tests);
     cmc_run(LinkedList, units, tests);
     cmc_run(LinkedListIter, units, tests);
     cmc_run(List, units, tests);
     cmc_run(ListIter, units, tests);
+    cmc_run(MPMCQueue, units, tests);
     cmc_run(Queue, units, tests);
     cmc_run(QueueIter, units, tests);
+    cmc_run(RadixHeap, units, tests);
+    cmc_run(SACQueue, units, tests);
+    cmc_run(SegDeque, units, tests);
+    cmc_run(SegDequeIter, units, tests);
+    cmc_run(SmallVec, units, tests);
+    cmc_run(SmallVecIter, units, tests);
+    cmc_run(SPSCQueue, units, tests);
     cmc_run(SortedList, units, tests);
     cmc_run(SortedListIter, units, tests);
     cmc_run(Stack, units, tests);
@@ -81,6 +109,8 @@ int main(void)
     cmc_run(TreeMapIter, units, tests);
     cmc_run(TreeSet, units, tests);
     cmc_run(TreeSetIter, units, tests);
+    cmc_run(UnrolledList, units, tests);
+    cmc_run(UnrolledListIter, units, tests);
 
     cmc_run(ForEach, units, tests);
 
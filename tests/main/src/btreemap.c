@@ -0,0 +1,927 @@
+#ifndef CMC_TEST_SRC_BTREEMAP
+#define CMC_TEST_SRC_BTREEMAP
+
+#include "cmc/btreemap.h"
+
+struct btreemap
+{
+    struct btreemap_node *root;
+    struct btreemap_leaf *head;
+    struct btreemap_leaf *tail;
+    size_t count;
+    int flag;
+    struct btreemap_fkey *f_key;
+    struct btreemap_fval *f_val;
+    struct cmc_alloc_node *alloc;
+    struct cmc_callbacks *callbacks;
+};
+struct btreemap_node
+{
+    size_t length;
+    _Bool leaf;
+    size_t keys[(((32) / 2) * 2 - 1)];
+};
+struct btreemap_leaf
+{
+    struct btreemap_node node;
+    size_t values[(((32) / 2) * 2 - 1)];
+    struct btreemap_leaf *prev;
+    struct btreemap_leaf *next;
+};
+struct btreemap_inner
+{
+    struct btreemap_node node;
+    struct btreemap_node *children[(((32) / 2) * 2 - 1) + 1];
+};
+struct btreemap_fkey
+{
+    int (*cmp)(size_t, size_t);
+    size_t (*cpy)(size_t);
+    _Bool (*str)(FILE *, size_t);
+    void (*free)(size_t);
+    size_t (*hash)(size_t);
+    int (*pri)(size_t, size_t);
+};
+struct btreemap_fval
+{
+    int (*cmp)(size_t, size_t);
+    size_t (*cpy)(size_t);
+    _Bool (*str)(FILE *, size_t);
+    void (*free)(size_t);
+    size_t (*hash)(size_t);
+    int (*pri)(size_t, size_t);
+};
+struct btreemap_iter
+{
+    struct btreemap *target;
+    struct btreemap_leaf *cursor;
+    size_t position;
+    size_t index;
+    _Bool start;
+    _Bool end;
+};
+struct btreemap *btm_new(struct btreemap_fkey *f_key,
+                         struct btreemap_fval *f_val);
+struct btreemap *btm_new_custom(struct btreemap_fkey *f_key,
+                                struct btreemap_fval *f_val,
+                                struct cmc_alloc_node *alloc,
+                                struct cmc_callbacks *callbacks);
+void btm_clear(struct btreemap *_map_);
+void btm_free(struct btreemap *_map_);
+void btm_customize(struct btreemap *_map_, struct cmc_alloc_node *alloc,
+                   struct cmc_callbacks *callbacks);
+_Bool btm_insert(struct btreemap *_map_, size_t key, size_t value);
+_Bool btm_update(struct btreemap *_map_, size_t key, size_t new_value,
+                 size_t *old_value);
+_Bool btm_remove(struct btreemap *_map_, size_t key, size_t *out_value);
+_Bool btm_max(struct btreemap *_map_, size_t *key, size_t *value);
+_Bool btm_min(struct btreemap *_map_, size_t *key, size_t *value);
+size_t btm_get(struct btreemap *_map_, size_t key);
+size_t *btm_get_ref(struct btreemap *_map_, size_t key);
+_Bool btm_contains(struct btreemap *_map_, size_t key);
+_Bool btm_empty(struct btreemap *_map_);
+size_t btm_count(struct btreemap *_map_);
+int btm_flag(struct btreemap *_map_);
+struct btreemap *btm_copy_of(struct btreemap *_map_);
+_Bool btm_equals(struct btreemap *_map1_, struct btreemap *_map2_);
+struct cmc_string btm_to_string(struct btreemap *_map_);
+_Bool btm_print(struct btreemap *_map_, FILE *fptr);
+struct btreemap_iter btm_iter_start(struct btreemap *target);
+struct btreemap_iter btm_iter_end(struct btreemap *target);
+_Bool btm_iter_at_start(struct btreemap_iter *iter);
+_Bool btm_iter_at_end(struct btreemap_iter *iter);
+_Bool btm_iter_to_start(struct btreemap_iter *iter);
+_Bool btm_iter_to_end(struct btreemap_iter *iter);
+_Bool btm_iter_next(struct btreemap_iter *iter);
+_Bool btm_iter_prev(struct btreemap_iter *iter);
+_Bool btm_iter_advance(struct btreemap_iter *iter, size_t steps);
+_Bool btm_iter_rewind(struct btreemap_iter *iter, size_t steps);
+_Bool btm_iter_go_to(struct btreemap_iter *iter, size_t index);
+size_t btm_iter_key(struct btreemap_iter *iter);
+size_t btm_iter_value(struct btreemap_iter *iter);
+size_t *btm_iter_rvalue(struct btreemap_iter *iter);
+size_t btm_iter_index(struct btreemap_iter *iter);
+static struct btreemap_leaf *btm_impl_new_leaf(struct btreemap *_map_);
+static struct btreemap_inner *btm_impl_new_inner(struct btreemap *_map_);
+static void btm_impl_free_node(struct btreemap *_map_,
+                               struct btreemap_node *node);
+static size_t btm_impl_lower(struct btreemap *_map_, struct btreemap_node *node,
+                             size_t key);
+static size_t btm_impl_upper(struct btreemap *_map_, struct btreemap_node *node,
+                             size_t key);
+static struct btreemap_leaf *btm_impl_get_leaf(struct btreemap *_map_,
+                                               size_t key, size_t *index);
+static _Bool btm_impl_split_child(struct btreemap *_map_,
+                                  struct btreemap_inner *parent, size_t index);
+static size_t btm_impl_fill_child(struct btreemap *_map_,
+                                  struct btreemap_inner *parent, size_t index);
+static void btm_impl_merge_children(struct btreemap *_map_,
+                                    struct btreemap_inner *parent,
+                                    size_t index);
+static void btm_impl_replace_separator(struct btreemap *_map_, size_t key,
+                                       size_t successor);
+struct btreemap *btm_new(struct btreemap_fkey *f_key,
+                         struct btreemap_fval *f_val)
+{
+    return btm_new_custom(f_key, f_val, ((void *)0), ((void *)0));
+}
+struct btreemap *btm_new_custom(struct btreemap_fkey *f_key,
+                                struct btreemap_fval *f_val,
+                                struct cmc_alloc_node *alloc,
+                                struct cmc_callbacks *callbacks)
+{
+    if (!f_key || !f_val)
+        return ((void *)0);
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+    struct btreemap *_map_ = alloc->malloc(sizeof(struct btreemap));
+    if (!_map_)
+        return ((void *)0);
+    _map_->root = ((void *)0);
+    _map_->head = ((void *)0);
+    _map_->tail = ((void *)0);
+    _map_->count = 0;
+    _map_->flag = cmc_flags.OK;
+    _map_->f_key = f_key;
+    _map_->f_val = f_val;
+    _map_->alloc = alloc;
+    _map_->callbacks = callbacks;
+    return _map_;
+}
+void btm_clear(struct btreemap *_map_)
+{
+    if (_map_->f_key->free || _map_->f_val->free)
+    {
+        struct btreemap_leaf *leaf = _map_->head;
+        for (; leaf != ((void *)0); leaf = leaf->next)
+        {
+            for (size_t i = 0; i < leaf->node.length; i++)
+            {
+                if (_map_->f_key->free)
+                    _map_->f_key->free(leaf->node.keys[i]);
+                if (_map_->f_val->free)
+                    _map_->f_val->free(leaf->values[i]);
+            }
+        }
+    }
+    if (_map_->root)
+        btm_impl_free_node(_map_, _map_->root);
+    _map_->root = ((void *)0);
+    _map_->head = ((void *)0);
+    _map_->tail = ((void *)0);
+    _map_->count = 0;
+    _map_->flag = cmc_flags.OK;
+}
+void btm_free(struct btreemap *_map_)
+{
+    btm_clear(_map_);
+    _map_->alloc->free(_map_);
+}
+void btm_customize(struct btreemap *_map_, struct cmc_alloc_node *alloc,
+                   struct cmc_callbacks *callbacks)
+{
+    if (!alloc)
+        _map_->alloc = &cmc_alloc_node_default;
+    else
+        _map_->alloc = alloc;
+    _map_->callbacks = callbacks;
+    _map_->flag = cmc_flags.OK;
+}
+_Bool btm_insert(struct btreemap *_map_, size_t key, size_t value)
+{
+    if (_map_->root == ((void *)0))
+    {
+        struct btreemap_leaf *leaf = btm_impl_new_leaf(_map_);
+        if (!leaf)
+        {
+            _map_->flag = cmc_flags.ALLOC;
+            return 0;
+        }
+        _map_->root = &(leaf->node);
+        _map_->head = leaf;
+        _map_->tail = leaf;
+    }
+    else if (_map_->root->length == (((32) / 2) * 2 - 1))
+    {
+        struct btreemap_inner *root = btm_impl_new_inner(_map_);
+        if (!root)
+        {
+            _map_->flag = cmc_flags.ALLOC;
+            return 0;
+        }
+        root->children[0] = _map_->root;
+        if (!btm_impl_split_child(_map_, root, 0))
+        {
+            _map_->alloc->free(root);
+            _map_->flag = cmc_flags.ALLOC;
+            return 0;
+        }
+        _map_->root = &(root->node);
+    }
+    struct btreemap_node *scan = _map_->root;
+    while (!scan->leaf)
+    {
+        struct btreemap_inner *inner = (struct btreemap_inner *)scan;
+        size_t i = btm_impl_upper(_map_, scan, key);
+        if (inner->children[i]->length == (((32) / 2) * 2 - 1))
+        {
+            if (!btm_impl_split_child(_map_, inner, i))
+            {
+                _map_->flag = cmc_flags.ALLOC;
+                return 0;
+            }
+            if (_map_->f_key->cmp(scan->keys[i], key) <= 0)
+                i++;
+        }
+        scan = inner->children[i];
+    }
+    struct btreemap_leaf *leaf = (struct btreemap_leaf *)scan;
+    size_t i = btm_impl_lower(_map_, scan, key);
+    if (i < scan->length && _map_->f_key->cmp(scan->keys[i], key) == 0)
+    {
+        _map_->flag = cmc_flags.DUPLICATE;
+        return 0;
+    }
+    memmove(scan->keys + i + 1, scan->keys + i,
+            (scan->length - i) * sizeof(size_t));
+    memmove(leaf->values + i + 1, leaf->values + i,
+            (scan->length - i) * sizeof(size_t));
+    scan->keys[i] = key;
+    leaf->values[i] = value;
+    scan->length++;
+    _map_->count++;
+    _map_->flag = cmc_flags.OK;
+    if (_map_->callbacks && _map_->callbacks->create)
+        _map_->callbacks->create();
+    return 1;
+}
+_Bool btm_update(struct btreemap *_map_, size_t key, size_t new_value,
+                 size_t *old_value)
+{
+    size_t index;
+    struct btreemap_leaf *leaf = btm_impl_get_leaf(_map_, key, &index);
+    if (!leaf)
+    {
+        _map_->flag = cmc_flags.NOT_FOUND;
+        return 0;
+    }
+    if (old_value)
+        *old_value = leaf->values[index];
+    leaf->values[index] = new_value;
+    _map_->flag = cmc_flags.OK;
+    if (_map_->callbacks && _map_->callbacks->update)
+        _map_->callbacks->update();
+    return 1;
+}
+_Bool btm_remove(struct btreemap *_map_, size_t key, size_t *out_value)
+{
+    if (btm_empty(_map_))
+    {
+        _map_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    struct btreemap_node *scan = _map_->root;
+    while (!scan->leaf)
+    {
+        struct btreemap_inner *inner = (struct btreemap_inner *)scan;
+        size_t i = btm_impl_upper(_map_, scan, key);
+        if (inner->children[i]->length == ((32) / 2 - 1))
+            i = btm_impl_fill_child(_map_, inner, i);
+        struct btreemap_node *child = inner->children[i];
+        if (scan->length == 0)
+        {
+            _map_->root = child;
+            _map_->alloc->free(inner);
+        }
+        scan = child;
+    }
+    struct btreemap_leaf *leaf = (struct btreemap_leaf *)scan;
+    size_t i = btm_impl_lower(_map_, scan, key);
+    if (i == scan->length || _map_->f_key->cmp(scan->keys[i], key) != 0)
+    {
+        _map_->flag = cmc_flags.NOT_FOUND;
+        return 0;
+    }
+    if (out_value)
+        *out_value = leaf->values[i];
+    memmove(scan->keys + i, scan->keys + i + 1,
+            (scan->length - i - 1) * sizeof(size_t));
+    memmove(leaf->values + i, leaf->values + i + 1,
+            (scan->length - i - 1) * sizeof(size_t));
+    scan->length--;
+    _map_->count--;
+    if (i == 0 && scan->length > 0)
+        btm_impl_replace_separator(_map_, key, scan->keys[0]);
+    if (_map_->count == 0)
+    {
+        _map_->alloc->free(leaf);
+        _map_->root = ((void *)0);
+        _map_->head = ((void *)0);
+        _map_->tail = ((void *)0);
+    }
+    _map_->flag = cmc_flags.OK;
+    if (_map_->callbacks && _map_->callbacks->delete)
+        _map_->callbacks->delete ();
+    return 1;
+}
+_Bool btm_max(struct btreemap *_map_, size_t *key, size_t *value)
+{
+    if (btm_empty(_map_))
+    {
+        _map_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    struct btreemap_leaf *leaf = _map_->tail;
+    if (key)
+        *key = leaf->node.keys[leaf->node.length - 1];
+    if (value)
+        *value = leaf->values[leaf->node.length - 1];
+    _map_->flag = cmc_flags.OK;
+    if (_map_->callbacks && _map_->callbacks->read)
+        _map_->callbacks->read();
+    return 1;
+}
+_Bool btm_min(struct btreemap *_map_, size_t *key, size_t *value)
+{
+    if (btm_empty(_map_))
+    {
+        _map_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    struct btreemap_leaf *leaf = _map_->head;
+    if (key)
+        *key = leaf->node.keys[0];
+    if (value)
+        *value = leaf->values[0];
+    _map_->flag = cmc_flags.OK;
+    if (_map_->callbacks && _map_->callbacks->read)
+        _map_->callbacks->read();
+    return 1;
+}
+size_t btm_get(struct btreemap *_map_, size_t key)
+{
+    if (btm_empty(_map_))
+    {
+        _map_->flag = cmc_flags.EMPTY;
+        return (size_t){ 0 };
+    }
+    size_t index;
+    struct btreemap_leaf *leaf = btm_impl_get_leaf(_map_, key, &index);
+    if (!leaf)
+    {
+        _map_->flag = cmc_flags.NOT_FOUND;
+        return (size_t){ 0 };
+    }
+    _map_->flag = cmc_flags.OK;
+    if (_map_->callbacks && _map_->callbacks->read)
+        _map_->callbacks->read();
+    return leaf->values[index];
+}
+size_t *btm_get_ref(struct btreemap *_map_, size_t key)
+{
+    if (btm_empty(_map_))
+    {
+        _map_->flag = cmc_flags.EMPTY;
+        return ((void *)0);
+    }
+    size_t index;
+    struct btreemap_leaf *leaf = btm_impl_get_leaf(_map_, key, &index);
+    if (!leaf)
+    {
+        _map_->flag = cmc_flags.NOT_FOUND;
+        return ((void *)0);
+    }
+    _map_->flag = cmc_flags.OK;
+    if (_map_->callbacks && _map_->callbacks->read)
+        _map_->callbacks->read();
+    return &(leaf->values[index]);
+}
+_Bool btm_contains(struct btreemap *_map_, size_t key)
+{
+    size_t index;
+    _Bool result = btm_impl_get_leaf(_map_, key, &index) != ((void *)0);
+    _map_->flag = cmc_flags.OK;
+    if (_map_->callbacks && _map_->callbacks->read)
+        _map_->callbacks->read();
+    return result;
+}
+_Bool btm_empty(struct btreemap *_map_)
+{
+    return _map_->count == 0;
+}
+size_t btm_count(struct btreemap *_map_)
+{
+    return _map_->count;
+}
+int btm_flag(struct btreemap *_map_)
+{
+    return _map_->flag;
+}
+struct btreemap *btm_copy_of(struct btreemap *_map_)
+{
+    struct btreemap *result =
+        btm_new_custom(_map_->f_key, _map_->f_val, _map_->alloc, ((void *)0));
+    if (!result)
+    {
+        _map_->flag = cmc_flags.ERROR;
+        return ((void *)0);
+    }
+    struct btreemap_leaf *leaf = _map_->head;
+    for (; leaf != ((void *)0); leaf = leaf->next)
+    {
+        for (size_t i = 0; i < leaf->node.length; i++)
+        {
+            size_t key = leaf->node.keys[i];
+            size_t value = leaf->values[i];
+            if (_map_->f_key->cpy)
+                key = _map_->f_key->cpy(key);
+            if (_map_->f_val->cpy)
+                value = _map_->f_val->cpy(value);
+            if (!btm_insert(result, key, value))
+            {
+                btm_free(result);
+                _map_->flag = cmc_flags.ALLOC;
+                return ((void *)0);
+            }
+        }
+    }
+    result->callbacks = _map_->callbacks;
+    _map_->flag = cmc_flags.OK;
+    return result;
+}
+_Bool btm_equals(struct btreemap *_map1_, struct btreemap *_map2_)
+{
+    _map1_->flag = cmc_flags.OK;
+    _map2_->flag = cmc_flags.OK;
+    if (_map1_->count != _map2_->count)
+        return 0;
+    struct btreemap_iter iter1 = btm_iter_start(_map1_);
+    struct btreemap_iter iter2 = btm_iter_start(_map2_);
+    for (; !btm_iter_at_end(&iter1);
+         btm_iter_next(&iter1), btm_iter_next(&iter2))
+    {
+        if (_map1_->f_key->cmp(btm_iter_key(&iter1), btm_iter_key(&iter2)) != 0)
+            return 0;
+        if (_map1_->f_val->cmp(btm_iter_value(&iter1),
+                               btm_iter_value(&iter2)) != 0)
+            return 0;
+    }
+    return 1;
+}
+struct cmc_string btm_to_string(struct btreemap *_map_)
+{
+    struct cmc_string str;
+    struct btreemap *m_ = _map_;
+    int n = snprintf(str.s, cmc_string_len, cmc_string_fmt_btreemap, "btreemap",
+                     "size_t", "size_t", m_, m_->root, m_->head, m_->tail,
+                     m_->count, m_->flag, m_->f_key, m_->f_val, m_->alloc,
+                     m_->callbacks);
+    return n >= 0 ? str : (struct cmc_string){ 0 };
+}
+_Bool btm_print(struct btreemap *_map_, FILE *fptr)
+{
+    struct btreemap_leaf *leaf = _map_->head;
+    for (; leaf != ((void *)0); leaf = leaf->next)
+    {
+        for (size_t i = 0; i < leaf->node.length; i++)
+        {
+            if (!_map_->f_key->str(fptr, leaf->node.keys[i]) ||
+                !_map_->f_val->str(fptr, leaf->values[i]))
+                return 0;
+        }
+    }
+    return 1;
+}
+struct btreemap_iter btm_iter_start(struct btreemap *target)
+{
+    struct btreemap_iter iter;
+    iter.target = target;
+    iter.cursor = target->head;
+    iter.position = 0;
+    iter.index = 0;
+    iter.start = 1;
+    iter.end = btm_empty(target);
+    return iter;
+}
+struct btreemap_iter btm_iter_end(struct btreemap *target)
+{
+    struct btreemap_iter iter;
+    iter.target = target;
+    iter.cursor = target->tail;
+    iter.position = 0;
+    iter.index = 0;
+    iter.start = btm_empty(target);
+    iter.end = 1;
+    if (!btm_empty(target))
+    {
+        iter.position = target->tail->node.length - 1;
+        iter.index = target->count - 1;
+    }
+    return iter;
+}
+_Bool btm_iter_at_start(struct btreemap_iter *iter)
+{
+    return btm_empty(iter->target) || iter->start;
+}
+_Bool btm_iter_at_end(struct btreemap_iter *iter)
+{
+    return btm_empty(iter->target) || iter->end;
+}
+_Bool btm_iter_to_start(struct btreemap_iter *iter)
+{
+    if (!btm_empty(iter->target))
+    {
+        iter->cursor = iter->target->head;
+        iter->position = 0;
+        iter->index = 0;
+        iter->start = 1;
+        iter->end = btm_empty(iter->target);
+        return 1;
+    }
+    return 0;
+}
+_Bool btm_iter_to_end(struct btreemap_iter *iter)
+{
+    if (!btm_empty(iter->target))
+    {
+        iter->cursor = iter->target->tail;
+        iter->position = iter->cursor->node.length - 1;
+        iter->index = iter->target->count - 1;
+        iter->start = btm_empty(iter->target);
+        iter->end = 1;
+        return 1;
+    }
+    return 0;
+}
+_Bool btm_iter_next(struct btreemap_iter *iter)
+{
+    if (iter->end)
+        return 0;
+    if (iter->index + 1 == iter->target->count)
+    {
+        iter->end = 1;
+        return 0;
+    }
+    iter->start = btm_empty(iter->target);
+    if (++iter->position == iter->cursor->node.length)
+    {
+        iter->cursor = iter->cursor->next;
+        iter->position = 0;
+    }
+    iter->index++;
+    return 1;
+}
+_Bool btm_iter_prev(struct btreemap_iter *iter)
+{
+    if (iter->start)
+        return 0;
+    if (iter->index == 0)
+    {
+        iter->start = 1;
+        return 0;
+    }
+    iter->end = btm_empty(iter->target);
+    if (iter->position == 0)
+    {
+        iter->cursor = iter->cursor->prev;
+        iter->position = iter->cursor->node.length - 1;
+    }
+    else
+        iter->position--;
+    iter->index--;
+    return 1;
+}
+_Bool btm_iter_advance(struct btreemap_iter *iter, size_t steps)
+{
+    if (iter->end)
+        return 0;
+    if (iter->index + 1 == iter->target->count)
+    {
+        iter->end = 1;
+        return 0;
+    }
+    if (steps == 0 || iter->index + steps >= iter->target->count)
+        return 0;
+    iter->start = btm_empty(iter->target);
+    iter->index += steps;
+    steps += iter->position;
+    while (steps >= iter->cursor->node.length)
+    {
+        steps -= iter->cursor->node.length;
+        iter->cursor = iter->cursor->next;
+    }
+    iter->position = steps;
+    return 1;
+}
+_Bool btm_iter_rewind(struct btreemap_iter *iter, size_t steps)
+{
+    if (iter->start)
+        return 0;
+    if (iter->index == 0)
+    {
+        iter->start = 1;
+        return 0;
+    }
+    if (steps == 0 || iter->index < steps)
+        return 0;
+    iter->end = btm_empty(iter->target);
+    iter->index -= steps;
+    while (steps > iter->position)
+    {
+        steps -= iter->position + 1;
+        iter->cursor = iter->cursor->prev;
+        iter->position = iter->cursor->node.length - 1;
+    }
+    iter->position -= steps;
+    return 1;
+}
+_Bool btm_iter_go_to(struct btreemap_iter *iter, size_t index)
+{
+    if (index >= iter->target->count)
+        return 0;
+    if (iter->index > index)
+        return btm_iter_rewind(iter, iter->index - index);
+    else if (iter->index < index)
+        return btm_iter_advance(iter, index - iter->index);
+    return 1;
+}
+size_t btm_iter_key(struct btreemap_iter *iter)
+{
+    if (btm_empty(iter->target))
+        return (size_t){ 0 };
+    return iter->cursor->node.keys[iter->position];
+}
+size_t btm_iter_value(struct btreemap_iter *iter)
+{
+    if (btm_empty(iter->target))
+        return (size_t){ 0 };
+    return iter->cursor->values[iter->position];
+}
+size_t *btm_iter_rvalue(struct btreemap_iter *iter)
+{
+    if (btm_empty(iter->target))
+        return ((void *)0);
+    return &(iter->cursor->values[iter->position]);
+}
+size_t btm_iter_index(struct btreemap_iter *iter)
+{
+    return iter->index;
+}
+static struct btreemap_leaf *btm_impl_new_leaf(struct btreemap *_map_)
+{
+    struct btreemap_leaf *leaf =
+        _map_->alloc->malloc(sizeof(struct btreemap_leaf));
+    if (!leaf)
+        return ((void *)0);
+    leaf->node.length = 0;
+    leaf->node.leaf = 1;
+    leaf->prev = ((void *)0);
+    leaf->next = ((void *)0);
+    return leaf;
+}
+static struct btreemap_inner *btm_impl_new_inner(struct btreemap *_map_)
+{
+    struct btreemap_inner *inner =
+        _map_->alloc->malloc(sizeof(struct btreemap_inner));
+    if (!inner)
+        return ((void *)0);
+    inner->node.length = 0;
+    inner->node.leaf = 0;
+    return inner;
+}
+static void btm_impl_free_node(struct btreemap *_map_,
+                               struct btreemap_node *node)
+{
+    if (!node->leaf)
+    {
+        struct btreemap_inner *inner = (struct btreemap_inner *)node;
+        for (size_t i = 0; i <= node->length; i++)
+            btm_impl_free_node(_map_, inner->children[i]);
+    }
+    _map_->alloc->free(node);
+}
+static size_t btm_impl_lower(struct btreemap *_map_, struct btreemap_node *node,
+                             size_t key)
+{
+    size_t low = 0, high = node->length;
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        if (_map_->f_key->cmp(node->keys[mid], key) < 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+static size_t btm_impl_upper(struct btreemap *_map_, struct btreemap_node *node,
+                             size_t key)
+{
+    size_t low = 0, high = node->length;
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        if (_map_->f_key->cmp(node->keys[mid], key) <= 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+static struct btreemap_leaf *btm_impl_get_leaf(struct btreemap *_map_,
+                                               size_t key, size_t *index)
+{
+    struct btreemap_node *scan = _map_->root;
+    if (!scan)
+        return ((void *)0);
+    while (!scan->leaf)
+    {
+        struct btreemap_inner *inner = (struct btreemap_inner *)scan;
+        scan = inner->children[btm_impl_upper(_map_, scan, key)];
+    }
+    size_t i = btm_impl_lower(_map_, scan, key);
+    if (i == scan->length || _map_->f_key->cmp(scan->keys[i], key) != 0)
+        return ((void *)0);
+    *index = i;
+    return (struct btreemap_leaf *)scan;
+}
+static _Bool btm_impl_split_child(struct btreemap *_map_,
+                                  struct btreemap_inner *parent, size_t index)
+{
+    struct btreemap_node *child = parent->children[index];
+    struct btreemap_node *sibling;
+    size_t separator;
+    if (child->leaf)
+    {
+        struct btreemap_leaf *left = (struct btreemap_leaf *)child;
+        struct btreemap_leaf *right = btm_impl_new_leaf(_map_);
+        if (!right)
+            return 0;
+        size_t from = ((32) / 2 - 1) + 1;
+        size_t length = child->length - from;
+        memcpy(right->node.keys, child->keys + from, length * sizeof(size_t));
+        memcpy(right->values, left->values + from, length * sizeof(size_t));
+        right->node.length = length;
+        child->length = from;
+        right->prev = left;
+        right->next = left->next;
+        if (left->next)
+            left->next->prev = right;
+        else
+            _map_->tail = right;
+        left->next = right;
+        separator = right->node.keys[0];
+        sibling = &(right->node);
+    }
+    else
+    {
+        struct btreemap_inner *left = (struct btreemap_inner *)child;
+        struct btreemap_inner *right = btm_impl_new_inner(_map_);
+        if (!right)
+            return 0;
+        size_t from = ((32) / 2 - 1) + 1;
+        size_t length = child->length - from;
+        memcpy(right->node.keys, child->keys + from, length * sizeof(size_t));
+        memcpy(right->children, left->children + from,
+               (length + 1) * sizeof(struct btreemap_node *));
+        right->node.length = length;
+        child->length = ((32) / 2 - 1);
+        separator = child->keys[((32) / 2 - 1)];
+        sibling = &(right->node);
+    }
+    struct btreemap_node *node = &(parent->node);
+    memmove(node->keys + index + 1, node->keys + index,
+            (node->length - index) * sizeof(size_t));
+    memmove(parent->children + index + 2, parent->children + index + 1,
+            (node->length - index) * sizeof(struct btreemap_node *));
+    node->keys[index] = separator;
+    parent->children[index + 1] = sibling;
+    node->length++;
+    return 1;
+}
+static size_t btm_impl_fill_child(struct btreemap *_map_,
+                                  struct btreemap_inner *parent, size_t index)
+{
+    struct btreemap_node *node = &(parent->node);
+    struct btreemap_node *child = parent->children[index];
+    struct btreemap_node *left = ((void *)0), *right = ((void *)0);
+    if (index > 0)
+        left = parent->children[index - 1];
+    if (index < node->length)
+        right = parent->children[index + 1];
+    if (left && left->length > ((32) / 2 - 1))
+    {
+        memmove(child->keys + 1, child->keys, child->length * sizeof(size_t));
+        if (child->leaf)
+        {
+            struct btreemap_leaf *c = (struct btreemap_leaf *)child;
+            struct btreemap_leaf *l = (struct btreemap_leaf *)left;
+            memmove(c->values + 1, c->values, child->length * sizeof(size_t));
+            child->keys[0] = left->keys[left->length - 1];
+            c->values[0] = l->values[left->length - 1];
+            node->keys[index - 1] = child->keys[0];
+        }
+        else
+        {
+            struct btreemap_inner *c = (struct btreemap_inner *)child;
+            struct btreemap_inner *l = (struct btreemap_inner *)left;
+            memmove(c->children + 1, c->children,
+                    (child->length + 1) * sizeof(struct btreemap_node *));
+            child->keys[0] = node->keys[index - 1];
+            c->children[0] = l->children[left->length];
+            node->keys[index - 1] = left->keys[left->length - 1];
+        }
+        child->length++;
+        left->length--;
+    }
+    else if (right && right->length > ((32) / 2 - 1))
+    {
+        if (child->leaf)
+        {
+            struct btreemap_leaf *c = (struct btreemap_leaf *)child;
+            struct btreemap_leaf *r = (struct btreemap_leaf *)right;
+            child->keys[child->length] = right->keys[0];
+            c->values[child->length] = r->values[0];
+            memmove(right->keys, right->keys + 1,
+                    (right->length - 1) * sizeof(size_t));
+            memmove(r->values, r->values + 1,
+                    (right->length - 1) * sizeof(size_t));
+            node->keys[index] = right->keys[0];
+        }
+        else
+        {
+            struct btreemap_inner *c = (struct btreemap_inner *)child;
+            struct btreemap_inner *r = (struct btreemap_inner *)right;
+            child->keys[child->length] = node->keys[index];
+            c->children[child->length + 1] = r->children[0];
+            node->keys[index] = right->keys[0];
+            memmove(right->keys, right->keys + 1,
+                    (right->length - 1) * sizeof(size_t));
+            memmove(r->children, r->children + 1,
+                    right->length * sizeof(struct btreemap_node *));
+        }
+        child->length++;
+        right->length--;
+    }
+    else if (right)
+        btm_impl_merge_children(_map_, parent, index);
+    else
+        btm_impl_merge_children(_map_, parent, --index);
+    return index;
+}
+static void btm_impl_merge_children(struct btreemap *_map_,
+                                    struct btreemap_inner *parent, size_t index)
+{
+    struct btreemap_node *node = &(parent->node);
+    struct btreemap_node *left = parent->children[index];
+    struct btreemap_node *right = parent->children[index + 1];
+    if (left->leaf)
+    {
+        struct btreemap_leaf *l = (struct btreemap_leaf *)left;
+        struct btreemap_leaf *r = (struct btreemap_leaf *)right;
+        memcpy(left->keys + left->length, right->keys,
+               right->length * sizeof(size_t));
+        memcpy(l->values + left->length, r->values,
+               right->length * sizeof(size_t));
+        left->length += right->length;
+        l->next = r->next;
+        if (r->next)
+            r->next->prev = l;
+        else
+            _map_->tail = l;
+    }
+    else
+    {
+        struct btreemap_inner *l = (struct btreemap_inner *)left;
+        struct btreemap_inner *r = (struct btreemap_inner *)right;
+        left->keys[left->length] = node->keys[index];
+        memcpy(left->keys + left->length + 1, right->keys,
+               right->length * sizeof(size_t));
+        memcpy(l->children + left->length + 1, r->children,
+               (right->length + 1) * sizeof(struct btreemap_node *));
+        left->length += right->length + 1;
+    }
+    memmove(node->keys + index, node->keys + index + 1,
+            (node->length - index - 1) * sizeof(size_t));
+    memmove(parent->children + index + 1, parent->children + index + 2,
+            (node->length - index - 1) * sizeof(struct btreemap_node *));
+    node->length--;
+    _map_->alloc->free(right);
+}
+static void btm_impl_replace_separator(struct btreemap *_map_, size_t key,
+                                       size_t successor)
+{
+    struct btreemap_node *scan = _map_->root;
+    while (!scan->leaf)
+    {
+        size_t i = btm_impl_upper(_map_, scan, key);
+        if (i > 0 && _map_->f_key->cmp(scan->keys[i - 1], key) == 0)
+        {
+            scan->keys[i - 1] = successor;
+            return;
+        }
+        scan = ((struct btreemap_inner *)scan)->children[i];
+    }
+}
+
+#endif /* CMC_TEST_SRC_BTREEMAP */
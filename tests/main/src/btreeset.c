@@ -0,0 +1,1010 @@
+#ifndef CMC_TEST_SRC_BTREESET
+#define CMC_TEST_SRC_BTREESET
+
+#include "cmc/btreeset.h"
+
+struct btreeset
+{
+    struct btreeset_node *root;
+    struct btreeset_leaf *head;
+    struct btreeset_leaf *tail;
+    size_t count;
+    int flag;
+    struct btreeset_fval *f_val;
+    struct cmc_alloc_node *alloc;
+    struct cmc_callbacks *callbacks;
+};
+struct btreeset_node
+{
+    size_t length;
+    _Bool leaf;
+    size_t values[(((32) / 2) * 2 - 1)];
+};
+struct btreeset_leaf
+{
+    struct btreeset_node node;
+    struct btreeset_leaf *prev;
+    struct btreeset_leaf *next;
+};
+struct btreeset_inner
+{
+    struct btreeset_node node;
+    struct btreeset_node *children[(((32) / 2) * 2 - 1) + 1];
+};
+struct btreeset_fval
+{
+    int (*cmp)(size_t, size_t);
+    size_t (*cpy)(size_t);
+    _Bool (*str)(FILE *, size_t);
+    void (*free)(size_t);
+    size_t (*hash)(size_t);
+    int (*pri)(size_t, size_t);
+};
+struct btreeset_iter
+{
+    struct btreeset *target;
+    struct btreeset_leaf *cursor;
+    size_t position;
+    size_t index;
+    _Bool start;
+    _Bool end;
+};
+struct btreeset *bts_new(struct btreeset_fval *f_val);
+struct btreeset *bts_new_custom(struct btreeset_fval *f_val,
+                                struct cmc_alloc_node *alloc,
+                                struct cmc_callbacks *callbacks);
+void bts_clear(struct btreeset *_set_);
+void bts_free(struct btreeset *_set_);
+void bts_customize(struct btreeset *_set_, struct cmc_alloc_node *alloc,
+                   struct cmc_callbacks *callbacks);
+_Bool bts_insert(struct btreeset *_set_, size_t value);
+_Bool bts_remove(struct btreeset *_set_, size_t value);
+_Bool bts_max(struct btreeset *_set_, size_t *value);
+_Bool bts_min(struct btreeset *_set_, size_t *value);
+_Bool bts_contains(struct btreeset *_set_, size_t value);
+_Bool bts_empty(struct btreeset *_set_);
+size_t bts_count(struct btreeset *_set_);
+int bts_flag(struct btreeset *_set_);
+struct btreeset *bts_copy_of(struct btreeset *_set_);
+_Bool bts_equals(struct btreeset *_set1_, struct btreeset *_set2_);
+struct cmc_string bts_to_string(struct btreeset *_set_);
+_Bool bts_print(struct btreeset *_set_, FILE *fptr);
+struct btreeset *bts_union(struct btreeset *_set1_, struct btreeset *_set2_);
+struct btreeset *bts_intersection(struct btreeset *_set1_,
+                                  struct btreeset *_set2_);
+struct btreeset *bts_difference(struct btreeset *_set1_,
+                                struct btreeset *_set2_);
+struct btreeset *bts_symmetric_difference(struct btreeset *_set1_,
+                                          struct btreeset *_set2_);
+_Bool bts_is_subset(struct btreeset *_set1_, struct btreeset *_set2_);
+_Bool bts_is_superset(struct btreeset *_set1_, struct btreeset *_set2_);
+_Bool bts_is_proper_subset(struct btreeset *_set1_, struct btreeset *_set2_);
+_Bool bts_is_proper_superset(struct btreeset *_set1_, struct btreeset *_set2_);
+_Bool bts_is_disjointset(struct btreeset *_set1_, struct btreeset *_set2_);
+struct btreeset_iter bts_iter_start(struct btreeset *target);
+struct btreeset_iter bts_iter_end(struct btreeset *target);
+_Bool bts_iter_at_start(struct btreeset_iter *iter);
+_Bool bts_iter_at_end(struct btreeset_iter *iter);
+_Bool bts_iter_to_start(struct btreeset_iter *iter);
+_Bool bts_iter_to_end(struct btreeset_iter *iter);
+_Bool bts_iter_next(struct btreeset_iter *iter);
+_Bool bts_iter_prev(struct btreeset_iter *iter);
+_Bool bts_iter_advance(struct btreeset_iter *iter, size_t steps);
+_Bool bts_iter_rewind(struct btreeset_iter *iter, size_t steps);
+_Bool bts_iter_go_to(struct btreeset_iter *iter, size_t index);
+size_t bts_iter_value(struct btreeset_iter *iter);
+size_t bts_iter_index(struct btreeset_iter *iter);
+static struct btreeset_leaf *bts_impl_new_leaf(struct btreeset *_set_);
+static struct btreeset_inner *bts_impl_new_inner(struct btreeset *_set_);
+static void bts_impl_free_node(struct btreeset *_set_,
+                               struct btreeset_node *node);
+static size_t bts_impl_lower(struct btreeset *_set_, struct btreeset_node *node,
+                             size_t value);
+static size_t bts_impl_upper(struct btreeset *_set_, struct btreeset_node *node,
+                             size_t value);
+static struct btreeset_leaf *bts_impl_get_leaf(struct btreeset *_set_,
+                                               size_t value, size_t *index);
+static _Bool bts_impl_split_child(struct btreeset *_set_,
+                                  struct btreeset_inner *parent, size_t index);
+static size_t bts_impl_fill_child(struct btreeset *_set_,
+                                  struct btreeset_inner *parent, size_t index);
+static void bts_impl_merge_children(struct btreeset *_set_,
+                                    struct btreeset_inner *parent,
+                                    size_t index);
+static void bts_impl_replace_separator(struct btreeset *_set_, size_t value,
+                                       size_t successor);
+struct btreeset *bts_new(struct btreeset_fval *f_val)
+{
+    return bts_new_custom(f_val, ((void *)0), ((void *)0));
+}
+struct btreeset *bts_new_custom(struct btreeset_fval *f_val,
+                                struct cmc_alloc_node *alloc,
+                                struct cmc_callbacks *callbacks)
+{
+    if (!f_val)
+        return ((void *)0);
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+    struct btreeset *_set_ = alloc->malloc(sizeof(struct btreeset));
+    if (!_set_)
+        return ((void *)0);
+    _set_->root = ((void *)0);
+    _set_->head = ((void *)0);
+    _set_->tail = ((void *)0);
+    _set_->count = 0;
+    _set_->flag = cmc_flags.OK;
+    _set_->f_val = f_val;
+    _set_->alloc = alloc;
+    _set_->callbacks = callbacks;
+    return _set_;
+}
+void bts_clear(struct btreeset *_set_)
+{
+    if (_set_->f_val->free)
+    {
+        struct btreeset_leaf *leaf = _set_->head;
+        for (; leaf != ((void *)0); leaf = leaf->next)
+        {
+            for (size_t i = 0; i < leaf->node.length; i++)
+                _set_->f_val->free(leaf->node.values[i]);
+        }
+    }
+    if (_set_->root)
+        bts_impl_free_node(_set_, _set_->root);
+    _set_->root = ((void *)0);
+    _set_->head = ((void *)0);
+    _set_->tail = ((void *)0);
+    _set_->count = 0;
+    _set_->flag = cmc_flags.OK;
+}
+void bts_free(struct btreeset *_set_)
+{
+    bts_clear(_set_);
+    _set_->alloc->free(_set_);
+}
+void bts_customize(struct btreeset *_set_, struct cmc_alloc_node *alloc,
+                   struct cmc_callbacks *callbacks)
+{
+    if (!alloc)
+        _set_->alloc = &cmc_alloc_node_default;
+    else
+        _set_->alloc = alloc;
+    _set_->callbacks = callbacks;
+    _set_->flag = cmc_flags.OK;
+}
+_Bool bts_insert(struct btreeset *_set_, size_t value)
+{
+    if (_set_->root == ((void *)0))
+    {
+        struct btreeset_leaf *leaf = bts_impl_new_leaf(_set_);
+        if (!leaf)
+        {
+            _set_->flag = cmc_flags.ALLOC;
+            return 0;
+        }
+        _set_->root = &(leaf->node);
+        _set_->head = leaf;
+        _set_->tail = leaf;
+    }
+    else if (_set_->root->length == (((32) / 2) * 2 - 1))
+    {
+        struct btreeset_inner *root = bts_impl_new_inner(_set_);
+        if (!root)
+        {
+            _set_->flag = cmc_flags.ALLOC;
+            return 0;
+        }
+        root->children[0] = _set_->root;
+        if (!bts_impl_split_child(_set_, root, 0))
+        {
+            _set_->alloc->free(root);
+            _set_->flag = cmc_flags.ALLOC;
+            return 0;
+        }
+        _set_->root = &(root->node);
+    }
+    struct btreeset_node *scan = _set_->root;
+    while (!scan->leaf)
+    {
+        struct btreeset_inner *inner = (struct btreeset_inner *)scan;
+        size_t i = bts_impl_upper(_set_, scan, value);
+        if (inner->children[i]->length == (((32) / 2) * 2 - 1))
+        {
+            if (!bts_impl_split_child(_set_, inner, i))
+            {
+                _set_->flag = cmc_flags.ALLOC;
+                return 0;
+            }
+            if (_set_->f_val->cmp(scan->values[i], value) <= 0)
+                i++;
+        }
+        scan = inner->children[i];
+    }
+    size_t i = bts_impl_lower(_set_, scan, value);
+    if (i < scan->length && _set_->f_val->cmp(scan->values[i], value) == 0)
+    {
+        _set_->flag = cmc_flags.DUPLICATE;
+        return 0;
+    }
+    memmove(scan->values + i + 1, scan->values + i,
+            (scan->length - i) * sizeof(size_t));
+    scan->values[i] = value;
+    scan->length++;
+    _set_->count++;
+    _set_->flag = cmc_flags.OK;
+    if (_set_->callbacks && _set_->callbacks->create)
+        _set_->callbacks->create();
+    return 1;
+}
+_Bool bts_remove(struct btreeset *_set_, size_t value)
+{
+    if (bts_empty(_set_))
+    {
+        _set_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    struct btreeset_node *scan = _set_->root;
+    while (!scan->leaf)
+    {
+        struct btreeset_inner *inner = (struct btreeset_inner *)scan;
+        size_t i = bts_impl_upper(_set_, scan, value);
+        if (inner->children[i]->length == ((32) / 2 - 1))
+            i = bts_impl_fill_child(_set_, inner, i);
+        struct btreeset_node *child = inner->children[i];
+        if (scan->length == 0)
+        {
+            _set_->root = child;
+            _set_->alloc->free(inner);
+        }
+        scan = child;
+    }
+    size_t i = bts_impl_lower(_set_, scan, value);
+    if (i == scan->length || _set_->f_val->cmp(scan->values[i], value) != 0)
+    {
+        _set_->flag = cmc_flags.NOT_FOUND;
+        return 0;
+    }
+    memmove(scan->values + i, scan->values + i + 1,
+            (scan->length - i - 1) * sizeof(size_t));
+    scan->length--;
+    _set_->count--;
+    if (i == 0 && scan->length > 0)
+        bts_impl_replace_separator(_set_, value, scan->values[0]);
+    if (_set_->count == 0)
+    {
+        _set_->alloc->free(scan);
+        _set_->root = ((void *)0);
+        _set_->head = ((void *)0);
+        _set_->tail = ((void *)0);
+    }
+    _set_->flag = cmc_flags.OK;
+    if (_set_->callbacks && _set_->callbacks->delete)
+        _set_->callbacks->delete ();
+    return 1;
+}
+_Bool bts_max(struct btreeset *_set_, size_t *value)
+{
+    if (bts_empty(_set_))
+    {
+        _set_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    if (value)
+        *value = _set_->tail->node.values[_set_->tail->node.length - 1];
+    _set_->flag = cmc_flags.OK;
+    if (_set_->callbacks && _set_->callbacks->read)
+        _set_->callbacks->read();
+    return 1;
+}
+_Bool bts_min(struct btreeset *_set_, size_t *value)
+{
+    if (bts_empty(_set_))
+    {
+        _set_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    if (value)
+        *value = _set_->head->node.values[0];
+    _set_->flag = cmc_flags.OK;
+    if (_set_->callbacks && _set_->callbacks->read)
+        _set_->callbacks->read();
+    return 1;
+}
+_Bool bts_contains(struct btreeset *_set_, size_t value)
+{
+    size_t index;
+    _Bool result = bts_impl_get_leaf(_set_, value, &index) != ((void *)0);
+    _set_->flag = cmc_flags.OK;
+    if (_set_->callbacks && _set_->callbacks->read)
+        _set_->callbacks->read();
+    return result;
+}
+_Bool bts_empty(struct btreeset *_set_)
+{
+    return _set_->count == 0;
+}
+size_t bts_count(struct btreeset *_set_)
+{
+    return _set_->count;
+}
+int bts_flag(struct btreeset *_set_)
+{
+    return _set_->flag;
+}
+struct btreeset *bts_copy_of(struct btreeset *_set_)
+{
+    struct btreeset *result =
+        bts_new_custom(_set_->f_val, _set_->alloc, ((void *)0));
+    if (!result)
+    {
+        _set_->flag = cmc_flags.ERROR;
+        return ((void *)0);
+    }
+    struct btreeset_leaf *leaf = _set_->head;
+    for (; leaf != ((void *)0); leaf = leaf->next)
+    {
+        for (size_t i = 0; i < leaf->node.length; i++)
+        {
+            size_t value = leaf->node.values[i];
+            if (_set_->f_val->cpy)
+                value = _set_->f_val->cpy(value);
+            if (!bts_insert(result, value))
+            {
+                bts_free(result);
+                _set_->flag = cmc_flags.ALLOC;
+                return ((void *)0);
+            }
+        }
+    }
+    result->callbacks = _set_->callbacks;
+    _set_->flag = cmc_flags.OK;
+    return result;
+}
+_Bool bts_equals(struct btreeset *_set1_, struct btreeset *_set2_)
+{
+    _set1_->flag = cmc_flags.OK;
+    _set2_->flag = cmc_flags.OK;
+    if (_set1_->count != _set2_->count)
+        return 0;
+    struct btreeset_iter iter1 = bts_iter_start(_set1_);
+    struct btreeset_iter iter2 = bts_iter_start(_set2_);
+    for (; !bts_iter_at_end(&iter1);
+         bts_iter_next(&iter1), bts_iter_next(&iter2))
+    {
+        if (_set1_->f_val->cmp(bts_iter_value(&iter1),
+                               bts_iter_value(&iter2)) != 0)
+            return 0;
+    }
+    return 1;
+}
+struct cmc_string bts_to_string(struct btreeset *_set_)
+{
+    struct cmc_string str;
+    struct btreeset *s_ = _set_;
+    int n = snprintf(str.s, cmc_string_len, cmc_string_fmt_btreeset, "btreeset",
+                     "size_t", s_, s_->root, s_->head, s_->tail, s_->count,
+                     s_->flag, s_->f_val, s_->alloc, s_->callbacks);
+    return n >= 0 ? str : (struct cmc_string){ 0 };
+}
+_Bool bts_print(struct btreeset *_set_, FILE *fptr)
+{
+    struct btreeset_leaf *leaf = _set_->head;
+    for (; leaf != ((void *)0); leaf = leaf->next)
+    {
+        for (size_t i = 0; i < leaf->node.length; i++)
+        {
+            if (!_set_->f_val->str(fptr, leaf->node.values[i]))
+                return 0;
+        }
+    }
+    return 1;
+}
+struct btreeset *bts_union(struct btreeset *_set1_, struct btreeset *_set2_)
+{
+    struct btreeset *_set_r_ =
+        bts_new_custom(_set1_->f_val, _set1_->alloc, _set1_->callbacks);
+    if (!_set_r_)
+        return ((void *)0);
+    struct btreeset_iter iter1 = bts_iter_start(_set1_);
+    struct btreeset_iter iter2 = bts_iter_start(_set2_);
+    while (!bts_iter_at_end(&iter1) || !bts_iter_at_end(&iter2))
+    {
+        if (bts_iter_at_end(&iter1))
+        {
+            bts_insert(_set_r_, bts_iter_value(&iter2));
+            bts_iter_next(&iter2);
+            continue;
+        }
+        if (bts_iter_at_end(&iter2))
+        {
+            bts_insert(_set_r_, bts_iter_value(&iter1));
+            bts_iter_next(&iter1);
+            continue;
+        }
+        size_t value1 = bts_iter_value(&iter1);
+        size_t value2 = bts_iter_value(&iter2);
+        int c = _set1_->f_val->cmp(value1, value2);
+        if (c <= 0)
+        {
+            bts_insert(_set_r_, value1);
+            bts_iter_next(&iter1);
+            if (c == 0)
+                bts_iter_next(&iter2);
+        }
+        else
+        {
+            bts_insert(_set_r_, value2);
+            bts_iter_next(&iter2);
+        }
+    }
+    return _set_r_;
+}
+struct btreeset *bts_intersection(struct btreeset *_set1_,
+                                  struct btreeset *_set2_)
+{
+    struct btreeset *_set_r_ =
+        bts_new_custom(_set1_->f_val, _set1_->alloc, _set1_->callbacks);
+    if (!_set_r_)
+        return ((void *)0);
+    struct btreeset_iter iter1 = bts_iter_start(_set1_);
+    struct btreeset_iter iter2 = bts_iter_start(_set2_);
+    while (!bts_iter_at_end(&iter1) && !bts_iter_at_end(&iter2))
+    {
+        size_t value1 = bts_iter_value(&iter1);
+        size_t value2 = bts_iter_value(&iter2);
+        int c = _set1_->f_val->cmp(value1, value2);
+        if (c == 0)
+        {
+            bts_insert(_set_r_, value1);
+            bts_iter_next(&iter1);
+            bts_iter_next(&iter2);
+        }
+        else if (c < 0)
+            bts_iter_next(&iter1);
+        else
+            bts_iter_next(&iter2);
+    }
+    return _set_r_;
+}
+struct btreeset *bts_difference(struct btreeset *_set1_,
+                                struct btreeset *_set2_)
+{
+    struct btreeset *_set_r_ =
+        bts_new_custom(_set1_->f_val, _set1_->alloc, _set1_->callbacks);
+    if (!_set_r_)
+        return ((void *)0);
+    struct btreeset_iter iter1 = bts_iter_start(_set1_);
+    struct btreeset_iter iter2 = bts_iter_start(_set2_);
+    while (!bts_iter_at_end(&iter1))
+    {
+        size_t value1 = bts_iter_value(&iter1);
+        if (bts_iter_at_end(&iter2))
+        {
+            bts_insert(_set_r_, value1);
+            bts_iter_next(&iter1);
+            continue;
+        }
+        int c = _set1_->f_val->cmp(value1, bts_iter_value(&iter2));
+        if (c < 0)
+        {
+            bts_insert(_set_r_, value1);
+            bts_iter_next(&iter1);
+        }
+        else
+        {
+            if (c == 0)
+                bts_iter_next(&iter1);
+            bts_iter_next(&iter2);
+        }
+    }
+    return _set_r_;
+}
+struct btreeset *bts_symmetric_difference(struct btreeset *_set1_,
+                                          struct btreeset *_set2_)
+{
+    struct btreeset *_set_r_ =
+        bts_new_custom(_set1_->f_val, _set1_->alloc, _set1_->callbacks);
+    if (!_set_r_)
+        return ((void *)0);
+    struct btreeset_iter iter1 = bts_iter_start(_set1_);
+    struct btreeset_iter iter2 = bts_iter_start(_set2_);
+    while (!bts_iter_at_end(&iter1) || !bts_iter_at_end(&iter2))
+    {
+        if (bts_iter_at_end(&iter1))
+        {
+            bts_insert(_set_r_, bts_iter_value(&iter2));
+            bts_iter_next(&iter2);
+            continue;
+        }
+        if (bts_iter_at_end(&iter2))
+        {
+            bts_insert(_set_r_, bts_iter_value(&iter1));
+            bts_iter_next(&iter1);
+            continue;
+        }
+        size_t value1 = bts_iter_value(&iter1);
+        size_t value2 = bts_iter_value(&iter2);
+        int c = _set1_->f_val->cmp(value1, value2);
+        if (c == 0)
+        {
+            bts_iter_next(&iter1);
+            bts_iter_next(&iter2);
+        }
+        else if (c < 0)
+        {
+            bts_insert(_set_r_, value1);
+            bts_iter_next(&iter1);
+        }
+        else
+        {
+            bts_insert(_set_r_, value2);
+            bts_iter_next(&iter2);
+        }
+    }
+    return _set_r_;
+}
+_Bool bts_is_subset(struct btreeset *_set1_, struct btreeset *_set2_)
+{
+    if (_set1_->count > _set2_->count)
+        return 0;
+    if (bts_empty(_set1_))
+        return 1;
+    struct btreeset_iter iter1 = bts_iter_start(_set1_);
+    struct btreeset_iter iter2 = bts_iter_start(_set2_);
+    while (!bts_iter_at_end(&iter1))
+    {
+        if (bts_iter_at_end(&iter2))
+            return 0;
+        int c =
+            _set1_->f_val->cmp(bts_iter_value(&iter1), bts_iter_value(&iter2));
+        if (c < 0)
+            return 0;
+        if (c == 0)
+            bts_iter_next(&iter1);
+        bts_iter_next(&iter2);
+    }
+    return 1;
+}
+_Bool bts_is_superset(struct btreeset *_set1_, struct btreeset *_set2_)
+{
+    return bts_is_subset(_set2_, _set1_);
+}
+_Bool bts_is_proper_subset(struct btreeset *_set1_, struct btreeset *_set2_)
+{
+    if (_set1_->count >= _set2_->count)
+        return 0;
+    return bts_is_subset(_set1_, _set2_);
+}
+_Bool bts_is_proper_superset(struct btreeset *_set1_, struct btreeset *_set2_)
+{
+    return bts_is_proper_subset(_set2_, _set1_);
+}
+_Bool bts_is_disjointset(struct btreeset *_set1_, struct btreeset *_set2_)
+{
+    struct btreeset_iter iter1 = bts_iter_start(_set1_);
+    struct btreeset_iter iter2 = bts_iter_start(_set2_);
+    while (!bts_iter_at_end(&iter1) && !bts_iter_at_end(&iter2))
+    {
+        int c =
+            _set1_->f_val->cmp(bts_iter_value(&iter1), bts_iter_value(&iter2));
+        if (c == 0)
+            return 0;
+        else if (c < 0)
+            bts_iter_next(&iter1);
+        else
+            bts_iter_next(&iter2);
+    }
+    return 1;
+}
+struct btreeset_iter bts_iter_start(struct btreeset *target)
+{
+    struct btreeset_iter iter;
+    iter.target = target;
+    iter.cursor = target->head;
+    iter.position = 0;
+    iter.index = 0;
+    iter.start = 1;
+    iter.end = bts_empty(target);
+    return iter;
+}
+struct btreeset_iter bts_iter_end(struct btreeset *target)
+{
+    struct btreeset_iter iter;
+    iter.target = target;
+    iter.cursor = target->tail;
+    iter.position = 0;
+    iter.index = 0;
+    iter.start = bts_empty(target);
+    iter.end = 1;
+    if (!bts_empty(target))
+    {
+        iter.position = target->tail->node.length - 1;
+        iter.index = target->count - 1;
+    }
+    return iter;
+}
+_Bool bts_iter_at_start(struct btreeset_iter *iter)
+{
+    return bts_empty(iter->target) || iter->start;
+}
+_Bool bts_iter_at_end(struct btreeset_iter *iter)
+{
+    return bts_empty(iter->target) || iter->end;
+}
+_Bool bts_iter_to_start(struct btreeset_iter *iter)
+{
+    if (!bts_empty(iter->target))
+    {
+        iter->cursor = iter->target->head;
+        iter->position = 0;
+        iter->index = 0;
+        iter->start = 1;
+        iter->end = bts_empty(iter->target);
+        return 1;
+    }
+    return 0;
+}
+_Bool bts_iter_to_end(struct btreeset_iter *iter)
+{
+    if (!bts_empty(iter->target))
+    {
+        iter->cursor = iter->target->tail;
+        iter->position = iter->cursor->node.length - 1;
+        iter->index = iter->target->count - 1;
+        iter->start = bts_empty(iter->target);
+        iter->end = 1;
+        return 1;
+    }
+    return 0;
+}
+_Bool bts_iter_next(struct btreeset_iter *iter)
+{
+    if (iter->end)
+        return 0;
+    if (iter->index + 1 == iter->target->count)
+    {
+        iter->end = 1;
+        return 0;
+    }
+    iter->start = bts_empty(iter->target);
+    if (++iter->position == iter->cursor->node.length)
+    {
+        iter->cursor = iter->cursor->next;
+        iter->position = 0;
+    }
+    iter->index++;
+    return 1;
+}
+_Bool bts_iter_prev(struct btreeset_iter *iter)
+{
+    if (iter->start)
+        return 0;
+    if (iter->index == 0)
+    {
+        iter->start = 1;
+        return 0;
+    }
+    iter->end = bts_empty(iter->target);
+    if (iter->position == 0)
+    {
+        iter->cursor = iter->cursor->prev;
+        iter->position = iter->cursor->node.length - 1;
+    }
+    else
+        iter->position--;
+    iter->index--;
+    return 1;
+}
+_Bool bts_iter_advance(struct btreeset_iter *iter, size_t steps)
+{
+    if (iter->end)
+        return 0;
+    if (iter->index + 1 == iter->target->count)
+    {
+        iter->end = 1;
+        return 0;
+    }
+    if (steps == 0 || iter->index + steps >= iter->target->count)
+        return 0;
+    iter->start = bts_empty(iter->target);
+    iter->index += steps;
+    steps += iter->position;
+    while (steps >= iter->cursor->node.length)
+    {
+        steps -= iter->cursor->node.length;
+        iter->cursor = iter->cursor->next;
+    }
+    iter->position = steps;
+    return 1;
+}
+_Bool bts_iter_rewind(struct btreeset_iter *iter, size_t steps)
+{
+    if (iter->start)
+        return 0;
+    if (iter->index == 0)
+    {
+        iter->start = 1;
+        return 0;
+    }
+    if (steps == 0 || iter->index < steps)
+        return 0;
+    iter->end = bts_empty(iter->target);
+    iter->index -= steps;
+    while (steps > iter->position)
+    {
+        steps -= iter->position + 1;
+        iter->cursor = iter->cursor->prev;
+        iter->position = iter->cursor->node.length - 1;
+    }
+    iter->position -= steps;
+    return 1;
+}
+_Bool bts_iter_go_to(struct btreeset_iter *iter, size_t index)
+{
+    if (index >= iter->target->count)
+        return 0;
+    if (iter->index > index)
+        return bts_iter_rewind(iter, iter->index - index);
+    else if (iter->index < index)
+        return bts_iter_advance(iter, index - iter->index);
+    return 1;
+}
+size_t bts_iter_value(struct btreeset_iter *iter)
+{
+    if (bts_empty(iter->target))
+        return (size_t){ 0 };
+    return iter->cursor->node.values[iter->position];
+}
+size_t bts_iter_index(struct btreeset_iter *iter)
+{
+    return iter->index;
+}
+static struct btreeset_leaf *bts_impl_new_leaf(struct btreeset *_set_)
+{
+    struct btreeset_leaf *leaf =
+        _set_->alloc->malloc(sizeof(struct btreeset_leaf));
+    if (!leaf)
+        return ((void *)0);
+    leaf->node.length = 0;
+    leaf->node.leaf = 1;
+    leaf->prev = ((void *)0);
+    leaf->next = ((void *)0);
+    return leaf;
+}
+static struct btreeset_inner *bts_impl_new_inner(struct btreeset *_set_)
+{
+    struct btreeset_inner *inner =
+        _set_->alloc->malloc(sizeof(struct btreeset_inner));
+    if (!inner)
+        return ((void *)0);
+    inner->node.length = 0;
+    inner->node.leaf = 0;
+    return inner;
+}
+static void bts_impl_free_node(struct btreeset *_set_,
+                               struct btreeset_node *node)
+{
+    if (!node->leaf)
+    {
+        struct btreeset_inner *inner = (struct btreeset_inner *)node;
+        for (size_t i = 0; i <= node->length; i++)
+            bts_impl_free_node(_set_, inner->children[i]);
+    }
+    _set_->alloc->free(node);
+}
+static size_t bts_impl_lower(struct btreeset *_set_, struct btreeset_node *node,
+                             size_t value)
+{
+    size_t low = 0, high = node->length;
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        if (_set_->f_val->cmp(node->values[mid], value) < 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+static size_t bts_impl_upper(struct btreeset *_set_, struct btreeset_node *node,
+                             size_t value)
+{
+    size_t low = 0, high = node->length;
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+        if (_set_->f_val->cmp(node->values[mid], value) <= 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+static struct btreeset_leaf *bts_impl_get_leaf(struct btreeset *_set_,
+                                               size_t value, size_t *index)
+{
+    struct btreeset_node *scan = _set_->root;
+    if (!scan)
+        return ((void *)0);
+    while (!scan->leaf)
+    {
+        struct btreeset_inner *inner = (struct btreeset_inner *)scan;
+        scan = inner->children[bts_impl_upper(_set_, scan, value)];
+    }
+    size_t i = bts_impl_lower(_set_, scan, value);
+    if (i == scan->length || _set_->f_val->cmp(scan->values[i], value) != 0)
+        return ((void *)0);
+    *index = i;
+    return (struct btreeset_leaf *)scan;
+}
+static _Bool bts_impl_split_child(struct btreeset *_set_,
+                                  struct btreeset_inner *parent, size_t index)
+{
+    struct btreeset_node *child = parent->children[index];
+    struct btreeset_node *sibling;
+    size_t separator;
+    if (child->leaf)
+    {
+        struct btreeset_leaf *left = (struct btreeset_leaf *)child;
+        struct btreeset_leaf *right = bts_impl_new_leaf(_set_);
+        if (!right)
+            return 0;
+        size_t from = ((32) / 2 - 1) + 1;
+        size_t length = child->length - from;
+        memcpy(right->node.values, child->values + from,
+               length * sizeof(size_t));
+        right->node.length = length;
+        child->length = from;
+        right->prev = left;
+        right->next = left->next;
+        if (left->next)
+            left->next->prev = right;
+        else
+            _set_->tail = right;
+        left->next = right;
+        separator = right->node.values[0];
+        sibling = &(right->node);
+    }
+    else
+    {
+        struct btreeset_inner *left = (struct btreeset_inner *)child;
+        struct btreeset_inner *right = bts_impl_new_inner(_set_);
+        if (!right)
+            return 0;
+        size_t from = ((32) / 2 - 1) + 1;
+        size_t length = child->length - from;
+        memcpy(right->node.values, child->values + from,
+               length * sizeof(size_t));
+        memcpy(right->children, left->children + from,
+               (length + 1) * sizeof(struct btreeset_node *));
+        right->node.length = length;
+        child->length = ((32) / 2 - 1);
+        separator = child->values[((32) / 2 - 1)];
+        sibling = &(right->node);
+    }
+    struct btreeset_node *node = &(parent->node);
+    memmove(node->values + index + 1, node->values + index,
+            (node->length - index) * sizeof(size_t));
+    memmove(parent->children + index + 2, parent->children + index + 1,
+            (node->length - index) * sizeof(struct btreeset_node *));
+    node->values[index] = separator;
+    parent->children[index + 1] = sibling;
+    node->length++;
+    return 1;
+}
+static size_t bts_impl_fill_child(struct btreeset *_set_,
+                                  struct btreeset_inner *parent, size_t index)
+{
+    struct btreeset_node *node = &(parent->node);
+    struct btreeset_node *child = parent->children[index];
+    struct btreeset_node *left = ((void *)0), *right = ((void *)0);
+    if (index > 0)
+        left = parent->children[index - 1];
+    if (index < node->length)
+        right = parent->children[index + 1];
+    if (left && left->length > ((32) / 2 - 1))
+    {
+        memmove(child->values + 1, child->values,
+                child->length * sizeof(size_t));
+        if (child->leaf)
+        {
+            child->values[0] = left->values[left->length - 1];
+            node->values[index - 1] = child->values[0];
+        }
+        else
+        {
+            struct btreeset_inner *c = (struct btreeset_inner *)child;
+            struct btreeset_inner *l = (struct btreeset_inner *)left;
+            memmove(c->children + 1, c->children,
+                    (child->length + 1) * sizeof(struct btreeset_node *));
+            child->values[0] = node->values[index - 1];
+            c->children[0] = l->children[left->length];
+            node->values[index - 1] = left->values[left->length - 1];
+        }
+        child->length++;
+        left->length--;
+    }
+    else if (right && right->length > ((32) / 2 - 1))
+    {
+        if (child->leaf)
+        {
+            child->values[child->length] = right->values[0];
+            memmove(right->values, right->values + 1,
+                    (right->length - 1) * sizeof(size_t));
+            node->values[index] = right->values[0];
+        }
+        else
+        {
+            struct btreeset_inner *c = (struct btreeset_inner *)child;
+            struct btreeset_inner *r = (struct btreeset_inner *)right;
+            child->values[child->length] = node->values[index];
+            c->children[child->length + 1] = r->children[0];
+            node->values[index] = right->values[0];
+            memmove(right->values, right->values + 1,
+                    (right->length - 1) * sizeof(size_t));
+            memmove(r->children, r->children + 1,
+                    right->length * sizeof(struct btreeset_node *));
+        }
+        child->length++;
+        right->length--;
+    }
+    else if (right)
+        bts_impl_merge_children(_set_, parent, index);
+    else
+        bts_impl_merge_children(_set_, parent, --index);
+    return index;
+}
+static void bts_impl_merge_children(struct btreeset *_set_,
+                                    struct btreeset_inner *parent, size_t index)
+{
+    struct btreeset_node *node = &(parent->node);
+    struct btreeset_node *left = parent->children[index];
+    struct btreeset_node *right = parent->children[index + 1];
+    if (left->leaf)
+    {
+        struct btreeset_leaf *l = (struct btreeset_leaf *)left;
+        struct btreeset_leaf *r = (struct btreeset_leaf *)right;
+        memcpy(left->values + left->length, right->values,
+               right->length * sizeof(size_t));
+        left->length += right->length;
+        l->next = r->next;
+        if (r->next)
+            r->next->prev = l;
+        else
+            _set_->tail = l;
+    }
+    else
+    {
+        struct btreeset_inner *l = (struct btreeset_inner *)left;
+        struct btreeset_inner *r = (struct btreeset_inner *)right;
+        left->values[left->length] = node->values[index];
+        memcpy(left->values + left->length + 1, right->values,
+               right->length * sizeof(size_t));
+        memcpy(l->children + left->length + 1, r->children,
+               (right->length + 1) * sizeof(struct btreeset_node *));
+        left->length += right->length + 1;
+    }
+    memmove(node->values + index, node->values + index + 1,
+            (node->length - index - 1) * sizeof(size_t));
+    memmove(parent->children + index + 1, parent->children + index + 2,
+            (node->length - index - 1) * sizeof(struct btreeset_node *));
+    node->length--;
+    _set_->alloc->free(right);
+}
+static void bts_impl_replace_separator(struct btreeset *_set_, size_t value,
+                                       size_t successor)
+{
+    struct btreeset_node *scan = _set_->root;
+    while (!scan->leaf)
+    {
+        size_t i = bts_impl_upper(_set_, scan, value);
+        if (i > 0 && _set_->f_val->cmp(scan->values[i - 1], value) == 0)
+        {
+            scan->values[i - 1] = successor;
+            return;
+        }
+        scan = ((struct btreeset_inner *)scan)->children[i];
+    }
+}
+
+#endif /* CMC_TEST_SRC_BTREESET */
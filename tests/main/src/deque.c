@@ -14,6 +14,7 @@ struct deque
     struct deque_fval *f_val;
     struct cmc_alloc_node *alloc;
     struct cmc_callbacks *callbacks;
+    const struct cmc_growth *growth;
 };
 struct deque_fval
 {
@@ -45,10 +46,13 @@ void d_free(struct deque *_deque_);
 void d_release(struct deque _deque_);
 void d_customize(struct deque *_deque_, struct cmc_alloc_node *alloc,
                  struct cmc_callbacks *callbacks);
+void d_set_growth(struct deque *_deque_, const struct cmc_growth *growth);
 _Bool d_push_front(struct deque *_deque_, size_t value);
 _Bool d_push_back(struct deque *_deque_, size_t value);
 _Bool d_pop_front(struct deque *_deque_);
 _Bool d_pop_back(struct deque *_deque_);
+_Bool d_push_back_n(struct deque *_deque_, size_t *values, size_t n);
+size_t d_pop_front_n(struct deque *_deque_, size_t *out, size_t n);
 size_t d_front(struct deque *_deque_);
 size_t d_back(struct deque *_deque_);
 _Bool d_contains(struct deque *_deque_, size_t value);
@@ -58,6 +62,8 @@ size_t d_count(struct deque *_deque_);
 size_t d_capacity(struct deque *_deque_);
 int d_flag(struct deque *_deque_);
 _Bool d_resize(struct deque *_deque_, size_t capacity);
+_Bool d_reserve(struct deque *_deque_, size_t size);
+_Bool d_shrink_to_fit(struct deque *_deque_);
 struct deque *d_copy_of(struct deque *_deque_);
 _Bool d_equals(struct deque *_deque1_, struct deque *_deque2_);
 struct cmc_string d_to_string(struct deque *_deque_);
@@ -76,6 +82,27 @@ _Bool d_iter_go_to(struct deque_iter *iter, size_t index);
 size_t d_iter_value(struct deque_iter *iter);
 size_t *d_iter_rvalue(struct deque_iter *iter);
 size_t d_iter_index(struct deque_iter *iter);
+static inline size_t d_impl_search(size_t *array, size_t count, size_t value,
+                                   int (*cmp)(size_t, size_t))
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (cmp(array[i], value) == 0)
+            return i;
+    }
+    return count;
+}
+static inline size_t d_impl_search_last(size_t *array, size_t count,
+                                        size_t value,
+                                        int (*cmp)(size_t, size_t))
+{
+    for (size_t i = count; i > 0; i--)
+    {
+        if (cmp(array[i - 1], value) == 0)
+            return i - 1;
+    }
+    return count;
+}
 struct deque *d_new(size_t capacity, struct deque_fval *f_val)
 {
     return d_new_custom(capacity, f_val, ((void *)0), ((void *)0));
@@ -107,6 +134,7 @@ struct deque *d_new_custom(size_t capacity, struct deque_fval *f_val,
     _deque_->f_val = f_val;
     _deque_->alloc = alloc;
     _deque_->callbacks = callbacks;
+    _deque_->growth = ((void *)0);
     return _deque_;
 }
 struct deque d_init(size_t capacity, struct deque_fval *f_val)
@@ -135,6 +163,7 @@ struct deque d_init_custom(size_t capacity, struct deque_fval *f_val,
     _deque_.f_val = f_val;
     _deque_.alloc = alloc;
     _deque_.callbacks = callbacks;
+    _deque_.growth = ((void *)0);
     return _deque_;
 }
 void d_clear(struct deque *_deque_)
@@ -188,11 +217,16 @@ void d_customize(struct deque *_deque_, struct cmc_alloc_node *alloc,
     _deque_->callbacks = callbacks;
     _deque_->flag = cmc_flags.OK;
 }
+void d_set_growth(struct deque *_deque_, const struct cmc_growth *growth)
+{
+    _deque_->growth = growth;
+    _deque_->flag = cmc_flags.OK;
+}
 _Bool d_push_front(struct deque *_deque_, size_t value)
 {
     if (d_full(_deque_))
     {
-        if (!d_resize(_deque_, _deque_->capacity * 2))
+        if (!d_reserve(_deque_, 1))
             return 0;
     }
     _deque_->front =
@@ -208,7 +242,7 @@ _Bool d_push_back(struct deque *_deque_, size_t value)
 {
     if (d_full(_deque_))
     {
-        if (!d_resize(_deque_, _deque_->capacity * 2))
+        if (!d_reserve(_deque_, 1))
             return 0;
     }
     _deque_->buffer[_deque_->back] = value;
@@ -252,6 +286,53 @@ _Bool d_pop_back(struct deque *_deque_)
         _deque_->callbacks->delete ();
     return 1;
 }
+_Bool d_push_back_n(struct deque *_deque_, size_t *values, size_t n)
+{
+    if (n == 0)
+    {
+        _deque_->flag = cmc_flags.OK;
+        return 1;
+    }
+    if (!d_reserve(_deque_, n))
+        return 0;
+    size_t count1 = _deque_->capacity - _deque_->back;
+    if (count1 > n)
+        count1 = n;
+    memcpy(_deque_->buffer + _deque_->back, values, sizeof(size_t) * count1);
+    memcpy(_deque_->buffer, values + count1, sizeof(size_t) * (n - count1));
+    _deque_->back = (_deque_->back + n) % _deque_->capacity;
+    _deque_->count += n;
+    _deque_->flag = cmc_flags.OK;
+    if (_deque_->callbacks && _deque_->callbacks->create)
+        _deque_->callbacks->create();
+    return 1;
+}
+size_t d_pop_front_n(struct deque *_deque_, size_t *out, size_t n)
+{
+    if (d_empty(_deque_))
+    {
+        _deque_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    if (n > _deque_->count)
+        n = _deque_->count;
+    size_t count1 = _deque_->capacity - _deque_->front;
+    if (count1 > n)
+        count1 = n;
+    if (out)
+    {
+        memcpy(out, _deque_->buffer + _deque_->front, sizeof(size_t) * count1);
+        memcpy(out + count1, _deque_->buffer, sizeof(size_t) * (n - count1));
+    }
+    memset(_deque_->buffer + _deque_->front, 0, sizeof(size_t) * count1);
+    memset(_deque_->buffer, 0, sizeof(size_t) * (n - count1));
+    _deque_->front = (_deque_->front + n) % _deque_->capacity;
+    _deque_->count -= n;
+    _deque_->flag = cmc_flags.OK;
+    if (_deque_->callbacks && _deque_->callbacks->delete)
+        _deque_->callbacks->delete ();
+    return n;
+}
 size_t d_front(struct deque *_deque_)
 {
     if (d_empty(_deque_))
@@ -280,16 +361,16 @@ size_t d_back(struct deque *_deque_)
 _Bool d_contains(struct deque *_deque_, size_t value)
 {
     _deque_->flag = cmc_flags.OK;
-    _Bool result = 0;
-    for (size_t i = _deque_->front, j = 0; j < _deque_->count; j++)
-    {
-        if (_deque_->f_val->cmp(_deque_->buffer[i], value) == 0)
-        {
-            result = 1;
-            break;
-        }
-        i = (i + 1) % _deque_->capacity;
-    }
+    size_t count1 = _deque_->capacity - _deque_->front;
+    size_t count2 = 0;
+    if (count1 >= _deque_->count)
+        count1 = _deque_->count;
+    else
+        count2 = _deque_->count - count1;
+    _Bool result = d_impl_search(_deque_->buffer + _deque_->front, count1,
+                                 value, _deque_->f_val->cmp) < count1 ||
+                   d_impl_search(_deque_->buffer, count2, value,
+                                 _deque_->f_val->cmp) < count2;
     if (_deque_->callbacks && _deque_->callbacks->read)
         _deque_->callbacks->read();
     return result;
@@ -324,27 +405,76 @@ _Bool d_resize(struct deque *_deque_, size_t capacity)
         _deque_->flag = cmc_flags.INVALID;
         return 0;
     }
-    size_t *new_buffer = _deque_->alloc->malloc(sizeof(size_t) * capacity);
-    if (!new_buffer)
+    if (capacity > _deque_->capacity)
     {
-        _deque_->flag = cmc_flags.ALLOC;
-        return 0;
+        size_t *new_buffer =
+            _deque_->alloc->realloc(_deque_->buffer, sizeof(size_t) * capacity);
+        if (!new_buffer)
+        {
+            _deque_->flag = cmc_flags.ALLOC;
+            return 0;
+        }
+        size_t old_capacity = _deque_->capacity;
+        if (_deque_->front + _deque_->count > old_capacity)
+        {
+            size_t tail = old_capacity - _deque_->front;
+            size_t head = _deque_->count - tail;
+            if (head < tail && head <= capacity - old_capacity)
+                memcpy(new_buffer + old_capacity, new_buffer,
+                       sizeof(size_t) * head);
+            else
+            {
+                memmove(new_buffer + capacity - tail,
+                        new_buffer + _deque_->front, sizeof(size_t) * tail);
+                _deque_->front = capacity - tail;
+            }
+        }
+        _deque_->buffer = new_buffer;
+        _deque_->capacity = capacity;
+        _deque_->back = (_deque_->front + _deque_->count) % capacity;
     }
-    for (size_t i = _deque_->front, j = 0; j < _deque_->count; j++)
+    else
     {
-        new_buffer[j] = _deque_->buffer[i];
-        i = (i + 1) % _deque_->capacity;
+        size_t *new_buffer = _deque_->alloc->malloc(sizeof(size_t) * capacity);
+        if (!new_buffer)
+        {
+            _deque_->flag = cmc_flags.ALLOC;
+            return 0;
+        }
+        for (size_t i = _deque_->front, j = 0; j < _deque_->count; j++)
+        {
+            new_buffer[j] = _deque_->buffer[i];
+            i = (i + 1) % _deque_->capacity;
+        }
+        _deque_->alloc->free(_deque_->buffer);
+        _deque_->buffer = new_buffer;
+        _deque_->capacity = capacity;
+        _deque_->front = 0;
+        _deque_->back = _deque_->count % capacity;
     }
-    _deque_->alloc->free(_deque_->buffer);
-    _deque_->buffer = new_buffer;
-    _deque_->capacity = capacity;
-    _deque_->front = 0;
-    _deque_->back = _deque_->count;
 success:
     if (_deque_->callbacks && _deque_->callbacks->resize)
         _deque_->callbacks->resize();
     return 1;
 }
+_Bool d_reserve(struct deque *_deque_, size_t size)
+{
+    _deque_->flag = cmc_flags.OK;
+    if (size <= _deque_->capacity - _deque_->count)
+        return 1;
+    if (size > (18446744073709551615UL) - _deque_->count)
+    {
+        _deque_->flag = cmc_flags.ERROR;
+        return 0;
+    }
+    return d_resize(_deque_,
+                    cmc_growth_capacity(_deque_->growth, _deque_->capacity,
+                                        _deque_->count + size));
+}
+_Bool d_shrink_to_fit(struct deque *_deque_)
+{
+    return d_resize(_deque_, _deque_->count > 0 ? _deque_->count : 1);
+}
 struct deque *d_copy_of(struct deque *_deque_)
 {
     struct deque *result = d_new_custom(_deque_->capacity, _deque_->f_val,
@@ -371,6 +501,7 @@ struct deque *d_copy_of(struct deque *_deque_)
         }
     }
     result->count = _deque_->count;
+    result->growth = _deque_->growth;
     result->front = 0;
     result->back = _deque_->count;
     _deque_->flag = cmc_flags.OK;
@@ -0,0 +1,1090 @@
+#ifndef CMC_TEST_SRC_GAPBUFFER
+#define CMC_TEST_SRC_GAPBUFFER
+
+#include "cmc/gapbuffer.h"
+
+struct gapbuffer
+{
+    size_t *buffer;
+    size_t capacity;
+    size_t count;
+    size_t gap;
+    int flag;
+    struct gapbuffer_fval *f_val;
+    struct cmc_alloc_node *alloc;
+    struct cmc_callbacks *callbacks;
+    const struct cmc_growth *growth;
+};
+struct gapbuffer_fval
+{
+    int (*cmp)(size_t, size_t);
+    size_t (*cpy)(size_t);
+    _Bool (*str)(FILE *, size_t);
+    void (*free)(size_t);
+    size_t (*hash)(size_t);
+    int (*pri)(size_t, size_t);
+};
+struct gapbuffer_iter
+{
+    struct gapbuffer *target;
+    size_t cursor;
+    _Bool start;
+    _Bool end;
+};
+struct gapbuffer *gb_new(size_t capacity, struct gapbuffer_fval *f_val);
+struct gapbuffer *gb_new_custom(size_t capacity, struct gapbuffer_fval *f_val,
+                                struct cmc_alloc_node *alloc,
+                                struct cmc_callbacks *callbacks);
+void gb_clear(struct gapbuffer *_gbuf_);
+void gb_free(struct gapbuffer *_gbuf_);
+void gb_customize(struct gapbuffer *_gbuf_, struct cmc_alloc_node *alloc,
+                  struct cmc_callbacks *callbacks);
+void gb_set_growth(struct gapbuffer *_gbuf_, const struct cmc_growth *growth);
+_Bool gb_push_front(struct gapbuffer *_gbuf_, size_t value);
+_Bool gb_push_at(struct gapbuffer *_gbuf_, size_t value, size_t index);
+_Bool gb_push_back(struct gapbuffer *_gbuf_, size_t value);
+_Bool gb_pop_front(struct gapbuffer *_gbuf_);
+_Bool gb_pop_at(struct gapbuffer *_gbuf_, size_t index);
+_Bool gb_pop_back(struct gapbuffer *_gbuf_);
+_Bool gb_seq_push_front(struct gapbuffer *_gbuf_, size_t *values, size_t size);
+_Bool gb_seq_push_at(struct gapbuffer *_gbuf_, size_t *values, size_t size,
+                     size_t index);
+_Bool gb_seq_push_back(struct gapbuffer *_gbuf_, size_t *values, size_t size);
+_Bool gb_seq_pop_at(struct gapbuffer *_gbuf_, size_t from, size_t to);
+struct gapbuffer *gb_seq_sublist(struct gapbuffer *_gbuf_, size_t from,
+                                 size_t to);
+size_t gb_front(struct gapbuffer *_gbuf_);
+size_t gb_get(struct gapbuffer *_gbuf_, size_t index);
+size_t *gb_get_ref(struct gapbuffer *_gbuf_, size_t index);
+size_t gb_back(struct gapbuffer *_gbuf_);
+size_t gb_index_of(struct gapbuffer *_gbuf_, size_t value, _Bool from_start);
+_Bool gb_contains(struct gapbuffer *_gbuf_, size_t value);
+_Bool gb_empty(struct gapbuffer *_gbuf_);
+_Bool gb_full(struct gapbuffer *_gbuf_);
+size_t gb_count(struct gapbuffer *_gbuf_);
+_Bool gb_fits(struct gapbuffer *_gbuf_, size_t size);
+size_t gb_capacity(struct gapbuffer *_gbuf_);
+size_t gb_gap_index(struct gapbuffer *_gbuf_);
+int gb_flag(struct gapbuffer *_gbuf_);
+_Bool gb_move_gap(struct gapbuffer *_gbuf_, size_t index);
+_Bool gb_resize(struct gapbuffer *_gbuf_, size_t capacity);
+_Bool gb_reserve(struct gapbuffer *_gbuf_, size_t size);
+_Bool gb_shrink_to_fit(struct gapbuffer *_gbuf_);
+void gb_sort(struct gapbuffer *_gbuf_);
+_Bool gb_sort_range(struct gapbuffer *_gbuf_, size_t from, size_t to);
+struct gapbuffer *gb_copy_of(struct gapbuffer *_gbuf_);
+_Bool gb_equals(struct gapbuffer *_gbuf1_, struct gapbuffer *_gbuf2_);
+struct cmc_string gb_to_string(struct gapbuffer *_gbuf_);
+_Bool gb_print(struct gapbuffer *_gbuf_, FILE *fptr);
+struct gapbuffer_iter gb_iter_start(struct gapbuffer *target);
+struct gapbuffer_iter gb_iter_end(struct gapbuffer *target);
+_Bool gb_iter_at_start(struct gapbuffer_iter *iter);
+_Bool gb_iter_at_end(struct gapbuffer_iter *iter);
+_Bool gb_iter_to_start(struct gapbuffer_iter *iter);
+_Bool gb_iter_to_end(struct gapbuffer_iter *iter);
+_Bool gb_iter_next(struct gapbuffer_iter *iter);
+_Bool gb_iter_prev(struct gapbuffer_iter *iter);
+_Bool gb_iter_advance(struct gapbuffer_iter *iter, size_t steps);
+_Bool gb_iter_rewind(struct gapbuffer_iter *iter, size_t steps);
+_Bool gb_iter_go_to(struct gapbuffer_iter *iter, size_t index);
+size_t gb_iter_value(struct gapbuffer_iter *iter);
+size_t *gb_iter_rvalue(struct gapbuffer_iter *iter);
+size_t gb_iter_index(struct gapbuffer_iter *iter);
+static inline size_t gb_impl_search(size_t *array, size_t count, size_t value,
+                                    int (*cmp)(size_t, size_t))
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (cmp(array[i], value) == 0)
+            return i;
+    }
+    return count;
+}
+static inline size_t gb_impl_search_last(size_t *array, size_t count,
+                                         size_t value,
+                                         int (*cmp)(size_t, size_t))
+{
+    for (size_t i = count; i > 0; i--)
+    {
+        if (cmp(array[i - 1], value) == 0)
+            return i - 1;
+    }
+    return count;
+}
+static size_t gb_impl_position(struct gapbuffer *_gbuf_, size_t index);
+static void gb_impl_sort_array(struct gapbuffer *_gbuf_, size_t *array,
+                               size_t count);
+struct gapbuffer *gb_new(size_t capacity, struct gapbuffer_fval *f_val)
+{
+    struct cmc_alloc_node *alloc = &cmc_alloc_node_default;
+    if (capacity < 1)
+        return ((void *)0);
+    struct gapbuffer *_gbuf_ = alloc->malloc(sizeof(struct gapbuffer));
+    if (!_gbuf_)
+        return ((void *)0);
+    _gbuf_->buffer = alloc->calloc(capacity, sizeof(size_t));
+    if (!_gbuf_->buffer)
+    {
+        alloc->free(_gbuf_);
+        return ((void *)0);
+    }
+    _gbuf_->capacity = capacity;
+    _gbuf_->count = 0;
+    _gbuf_->gap = 0;
+    _gbuf_->flag = cmc_flags.OK;
+    _gbuf_->f_val = f_val;
+    _gbuf_->alloc = alloc;
+    _gbuf_->callbacks = ((void *)0);
+    _gbuf_->growth = ((void *)0);
+    return _gbuf_;
+}
+struct gapbuffer *gb_new_custom(size_t capacity, struct gapbuffer_fval *f_val,
+                                struct cmc_alloc_node *alloc,
+                                struct cmc_callbacks *callbacks)
+{
+    if (capacity < 1)
+        return ((void *)0);
+    if (!f_val)
+        return ((void *)0);
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+    struct gapbuffer *_gbuf_ = alloc->malloc(sizeof(struct gapbuffer));
+    if (!_gbuf_)
+        return ((void *)0);
+    _gbuf_->buffer = alloc->calloc(capacity, sizeof(size_t));
+    if (!_gbuf_->buffer)
+    {
+        alloc->free(_gbuf_);
+        return ((void *)0);
+    }
+    _gbuf_->capacity = capacity;
+    _gbuf_->count = 0;
+    _gbuf_->gap = 0;
+    _gbuf_->flag = cmc_flags.OK;
+    _gbuf_->f_val = f_val;
+    _gbuf_->alloc = alloc;
+    _gbuf_->callbacks = callbacks;
+    _gbuf_->growth = ((void *)0);
+    return _gbuf_;
+}
+void gb_clear(struct gapbuffer *_gbuf_)
+{
+    if (_gbuf_->f_val->free)
+    {
+        for (size_t i = 0; i < _gbuf_->count; i++)
+            _gbuf_->f_val->free(_gbuf_->buffer[gb_impl_position(_gbuf_, i)]);
+    }
+    memset(_gbuf_->buffer, 0, sizeof(size_t) * _gbuf_->capacity);
+    _gbuf_->count = 0;
+    _gbuf_->gap = 0;
+    _gbuf_->flag = cmc_flags.OK;
+}
+void gb_free(struct gapbuffer *_gbuf_)
+{
+    if (_gbuf_->f_val->free)
+    {
+        for (size_t i = 0; i < _gbuf_->count; i++)
+            _gbuf_->f_val->free(_gbuf_->buffer[gb_impl_position(_gbuf_, i)]);
+    }
+    _gbuf_->alloc->free(_gbuf_->buffer);
+    _gbuf_->alloc->free(_gbuf_);
+}
+void gb_customize(struct gapbuffer *_gbuf_, struct cmc_alloc_node *alloc,
+                  struct cmc_callbacks *callbacks)
+{
+    if (!alloc)
+        _gbuf_->alloc = &cmc_alloc_node_default;
+    else
+        _gbuf_->alloc = alloc;
+    _gbuf_->callbacks = callbacks;
+    _gbuf_->flag = cmc_flags.OK;
+}
+void gb_set_growth(struct gapbuffer *_gbuf_, const struct cmc_growth *growth)
+{
+    _gbuf_->growth = growth;
+    _gbuf_->flag = cmc_flags.OK;
+}
+_Bool gb_push_front(struct gapbuffer *_gbuf_, size_t value)
+{
+    return gb_push_at(_gbuf_, value, 0);
+}
+_Bool gb_push_at(struct gapbuffer *_gbuf_, size_t value, size_t index)
+{
+    if (index > _gbuf_->count)
+    {
+        _gbuf_->flag = cmc_flags.RANGE;
+        return 0;
+    }
+    if (gb_full(_gbuf_))
+    {
+        if (!gb_reserve(_gbuf_, 1))
+            return 0;
+    }
+    gb_move_gap(_gbuf_, index);
+    _gbuf_->buffer[_gbuf_->gap++] = value;
+    _gbuf_->count++;
+    _gbuf_->flag = cmc_flags.OK;
+    if (_gbuf_->callbacks && _gbuf_->callbacks->create)
+        _gbuf_->callbacks->create();
+    return 1;
+}
+_Bool gb_push_back(struct gapbuffer *_gbuf_, size_t value)
+{
+    return gb_push_at(_gbuf_, value, _gbuf_->count);
+}
+_Bool gb_pop_front(struct gapbuffer *_gbuf_)
+{
+    return gb_pop_at(_gbuf_, 0);
+}
+_Bool gb_pop_at(struct gapbuffer *_gbuf_, size_t index)
+{
+    if (gb_empty(_gbuf_))
+    {
+        _gbuf_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    if (index >= _gbuf_->count)
+    {
+        _gbuf_->flag = cmc_flags.RANGE;
+        return 0;
+    }
+    if (index < _gbuf_->gap)
+    {
+        gb_move_gap(_gbuf_, index + 1);
+        _gbuf_->buffer[--_gbuf_->gap] = (size_t){ 0 };
+    }
+    else
+    {
+        gb_move_gap(_gbuf_, index);
+        _gbuf_->buffer[index + _gbuf_->capacity - _gbuf_->count] =
+            (size_t){ 0 };
+    }
+    _gbuf_->count--;
+    _gbuf_->flag = cmc_flags.OK;
+    if (_gbuf_->callbacks && _gbuf_->callbacks->delete)
+        _gbuf_->callbacks->delete ();
+    return 1;
+}
+_Bool gb_pop_back(struct gapbuffer *_gbuf_)
+{
+    if (gb_empty(_gbuf_))
+        return 0;
+    return gb_pop_at(_gbuf_, _gbuf_->count - 1);
+}
+_Bool gb_seq_push_front(struct gapbuffer *_gbuf_, size_t *values, size_t size)
+{
+    return gb_seq_push_at(_gbuf_, values, size, 0);
+}
+_Bool gb_seq_push_at(struct gapbuffer *_gbuf_, size_t *values, size_t size,
+                     size_t index)
+{
+    if (size == 0)
+    {
+        _gbuf_->flag = cmc_flags.INVALID;
+        return 0;
+    }
+    if (index > _gbuf_->count)
+    {
+        _gbuf_->flag = cmc_flags.RANGE;
+        return 0;
+    }
+    if (!gb_fits(_gbuf_, size))
+    {
+        if (!gb_reserve(_gbuf_, size))
+            return 0;
+    }
+    gb_move_gap(_gbuf_, index);
+    memcpy(_gbuf_->buffer + _gbuf_->gap, values, size * sizeof(size_t));
+    _gbuf_->gap += size;
+    _gbuf_->count += size;
+    _gbuf_->flag = cmc_flags.OK;
+    if (_gbuf_->callbacks && _gbuf_->callbacks->create)
+        _gbuf_->callbacks->create();
+    return 1;
+}
+_Bool gb_seq_push_back(struct gapbuffer *_gbuf_, size_t *values, size_t size)
+{
+    return gb_seq_push_at(_gbuf_, values, size, _gbuf_->count);
+}
+_Bool gb_seq_pop_at(struct gapbuffer *_gbuf_, size_t from, size_t to)
+{
+    if (from > to)
+    {
+        _gbuf_->flag = cmc_flags.INVALID;
+        return 0;
+    }
+    if (to >= _gbuf_->count)
+    {
+        _gbuf_->flag = cmc_flags.RANGE;
+        return 0;
+    }
+    size_t length = to - from + 1;
+    gb_move_gap(_gbuf_, from);
+    memset(_gbuf_->buffer + from + _gbuf_->capacity - _gbuf_->count, 0,
+           length * sizeof(size_t));
+    _gbuf_->count -= length;
+    _gbuf_->flag = cmc_flags.OK;
+    if (_gbuf_->callbacks && _gbuf_->callbacks->delete)
+        _gbuf_->callbacks->delete ();
+    return 1;
+}
+struct gapbuffer *gb_seq_sublist(struct gapbuffer *_gbuf_, size_t from,
+                                 size_t to)
+{
+    if (from > to)
+    {
+        _gbuf_->flag = cmc_flags.INVALID;
+        return ((void *)0);
+    }
+    if (to >= _gbuf_->count)
+    {
+        _gbuf_->flag = cmc_flags.RANGE;
+        return ((void *)0);
+    }
+    size_t length = to - from + 1;
+    struct gapbuffer *result =
+        gb_new_custom(length, _gbuf_->f_val, _gbuf_->alloc, _gbuf_->callbacks);
+    if (!result)
+    {
+        _gbuf_->flag = cmc_flags.ALLOC;
+        return ((void *)0);
+    }
+    gb_move_gap(_gbuf_, from);
+    size_t *values = _gbuf_->buffer + from + _gbuf_->capacity - _gbuf_->count;
+    memcpy(result->buffer, values, length * sizeof(size_t));
+    memset(values, 0, length * sizeof(size_t));
+    _gbuf_->count -= length;
+    result->count = length;
+    result->gap = length;
+    _gbuf_->flag = cmc_flags.OK;
+    if (_gbuf_->callbacks && _gbuf_->callbacks->delete)
+        _gbuf_->callbacks->delete ();
+    return result;
+}
+size_t gb_front(struct gapbuffer *_gbuf_)
+{
+    if (gb_empty(_gbuf_))
+    {
+        _gbuf_->flag = cmc_flags.EMPTY;
+        return (size_t){ 0 };
+    }
+    _gbuf_->flag = cmc_flags.OK;
+    if (_gbuf_->callbacks && _gbuf_->callbacks->read)
+        _gbuf_->callbacks->read();
+    return _gbuf_->buffer[gb_impl_position(_gbuf_, 0)];
+}
+size_t gb_get(struct gapbuffer *_gbuf_, size_t index)
+{
+    if (gb_empty(_gbuf_))
+    {
+        _gbuf_->flag = cmc_flags.EMPTY;
+        return (size_t){ 0 };
+    }
+    if (index >= _gbuf_->count)
+    {
+        _gbuf_->flag = cmc_flags.RANGE;
+        return (size_t){ 0 };
+    }
+    _gbuf_->flag = cmc_flags.OK;
+    if (_gbuf_->callbacks && _gbuf_->callbacks->read)
+        _gbuf_->callbacks->read();
+    return _gbuf_->buffer[gb_impl_position(_gbuf_, index)];
+}
+size_t *gb_get_ref(struct gapbuffer *_gbuf_, size_t index)
+{
+    if (gb_empty(_gbuf_))
+    {
+        _gbuf_->flag = cmc_flags.EMPTY;
+        return ((void *)0);
+    }
+    if (index >= _gbuf_->count)
+    {
+        _gbuf_->flag = cmc_flags.RANGE;
+        return ((void *)0);
+    }
+    _gbuf_->flag = cmc_flags.OK;
+    if (_gbuf_->callbacks && _gbuf_->callbacks->read)
+        _gbuf_->callbacks->read();
+    return &(_gbuf_->buffer[gb_impl_position(_gbuf_, index)]);
+}
+size_t gb_back(struct gapbuffer *_gbuf_)
+{
+    if (gb_empty(_gbuf_))
+    {
+        _gbuf_->flag = cmc_flags.EMPTY;
+        return (size_t){ 0 };
+    }
+    _gbuf_->flag = cmc_flags.OK;
+    if (_gbuf_->callbacks && _gbuf_->callbacks->read)
+        _gbuf_->callbacks->read();
+    return _gbuf_->buffer[gb_impl_position(_gbuf_, _gbuf_->count - 1)];
+}
+size_t gb_index_of(struct gapbuffer *_gbuf_, size_t value, _Bool from_start)
+{
+    _gbuf_->flag = cmc_flags.OK;
+    size_t gap = _gbuf_->gap;
+    size_t after = _gbuf_->count - gap;
+    size_t *tail = _gbuf_->buffer + _gbuf_->capacity - after;
+    size_t result;
+    if (from_start)
+    {
+        result = gb_impl_search(_gbuf_->buffer, gap, value, _gbuf_->f_val->cmp);
+        if (result == gap)
+            result += gb_impl_search(tail, after, value, _gbuf_->f_val->cmp);
+    }
+    else
+    {
+        result = gb_impl_search_last(tail, after, value, _gbuf_->f_val->cmp);
+        if (result < after)
+            result += gap;
+        else
+        {
+            result = gb_impl_search_last(_gbuf_->buffer, gap, value,
+                                         _gbuf_->f_val->cmp);
+            if (result == gap)
+                result = _gbuf_->count;
+        }
+    }
+    if (_gbuf_->callbacks && _gbuf_->callbacks->read)
+        _gbuf_->callbacks->read();
+    return result;
+}
+_Bool gb_contains(struct gapbuffer *_gbuf_, size_t value)
+{
+    _gbuf_->flag = cmc_flags.OK;
+    size_t gap = _gbuf_->gap;
+    size_t after = _gbuf_->count - gap;
+    size_t *tail = _gbuf_->buffer + _gbuf_->capacity - after;
+    _Bool result =
+        gb_impl_search(_gbuf_->buffer, gap, value, _gbuf_->f_val->cmp) < gap ||
+        gb_impl_search(tail, after, value, _gbuf_->f_val->cmp) < after;
+    if (_gbuf_->callbacks && _gbuf_->callbacks->read)
+        _gbuf_->callbacks->read();
+    return result;
+}
+_Bool gb_empty(struct gapbuffer *_gbuf_)
+{
+    return _gbuf_->count == 0;
+}
+_Bool gb_full(struct gapbuffer *_gbuf_)
+{
+    return _gbuf_->count >= _gbuf_->capacity;
+}
+size_t gb_count(struct gapbuffer *_gbuf_)
+{
+    return _gbuf_->count;
+}
+_Bool gb_fits(struct gapbuffer *_gbuf_, size_t size)
+{
+    return _gbuf_->count + size <= _gbuf_->capacity;
+}
+size_t gb_capacity(struct gapbuffer *_gbuf_)
+{
+    return _gbuf_->capacity;
+}
+size_t gb_gap_index(struct gapbuffer *_gbuf_)
+{
+    return _gbuf_->gap;
+}
+int gb_flag(struct gapbuffer *_gbuf_)
+{
+    return _gbuf_->flag;
+}
+_Bool gb_move_gap(struct gapbuffer *_gbuf_, size_t index)
+{
+    if (index > _gbuf_->count)
+    {
+        _gbuf_->flag = cmc_flags.RANGE;
+        return 0;
+    }
+    size_t *buffer = _gbuf_->buffer;
+    size_t gap = _gbuf_->gap;
+    size_t size = _gbuf_->capacity - _gbuf_->count;
+    if (index < gap)
+    {
+        size_t length = gap - index;
+        memmove(buffer + index + size, buffer + index, length * sizeof(size_t));
+        memset(buffer + index, 0,
+               (length < size ? length : size) * sizeof(size_t));
+    }
+    else if (index > gap)
+    {
+        size_t length = index - gap;
+        size_t start = index > gap + size ? index : gap + size;
+        memmove(buffer + gap, buffer + gap + size, length * sizeof(size_t));
+        memset(buffer + start, 0, (index + size - start) * sizeof(size_t));
+    }
+    _gbuf_->gap = index;
+    _gbuf_->flag = cmc_flags.OK;
+    return 1;
+}
+_Bool gb_resize(struct gapbuffer *_gbuf_, size_t capacity)
+{
+    _gbuf_->flag = cmc_flags.OK;
+    if (_gbuf_->capacity == capacity)
+        return 1;
+    if (capacity < _gbuf_->count)
+    {
+        _gbuf_->flag = cmc_flags.INVALID;
+        return 0;
+    }
+    size_t old_capacity = _gbuf_->capacity;
+    size_t after = _gbuf_->count - _gbuf_->gap;
+    if (capacity < old_capacity)
+    {
+        memmove(_gbuf_->buffer + capacity - after,
+                _gbuf_->buffer + old_capacity - after, after * sizeof(size_t));
+    }
+    size_t *new_buffer =
+        _gbuf_->alloc->realloc(_gbuf_->buffer, sizeof(size_t) * capacity);
+    if (!new_buffer)
+    {
+        if (capacity < old_capacity)
+        {
+            memmove(_gbuf_->buffer + old_capacity - after,
+                    _gbuf_->buffer + capacity - after, after * sizeof(size_t));
+            memset(_gbuf_->buffer + _gbuf_->gap, 0,
+                   (old_capacity - _gbuf_->count) * sizeof(size_t));
+        }
+        _gbuf_->flag = cmc_flags.ALLOC;
+        return 0;
+    }
+    if (capacity > old_capacity)
+    {
+        memmove(new_buffer + capacity - after,
+                new_buffer + old_capacity - after, after * sizeof(size_t));
+    }
+    memset(new_buffer + _gbuf_->gap, 0,
+           (capacity - _gbuf_->count) * sizeof(size_t));
+    _gbuf_->buffer = new_buffer;
+    _gbuf_->capacity = capacity;
+    if (_gbuf_->callbacks && _gbuf_->callbacks->resize)
+        _gbuf_->callbacks->resize();
+    return 1;
+}
+_Bool gb_reserve(struct gapbuffer *_gbuf_, size_t size)
+{
+    _gbuf_->flag = cmc_flags.OK;
+    if (size <= _gbuf_->capacity - _gbuf_->count)
+        return 1;
+    if (size > (18446744073709551615UL) - _gbuf_->count)
+    {
+        _gbuf_->flag = cmc_flags.ERROR;
+        return 0;
+    }
+    return gb_resize(_gbuf_,
+                     cmc_growth_capacity(_gbuf_->growth, _gbuf_->capacity,
+                                         _gbuf_->count + size));
+}
+_Bool gb_shrink_to_fit(struct gapbuffer *_gbuf_)
+{
+    return gb_resize(_gbuf_, _gbuf_->count > 0 ? _gbuf_->count : 1);
+}
+void gb_sort(struct gapbuffer *_gbuf_)
+{
+    gb_move_gap(_gbuf_, _gbuf_->count);
+    gb_impl_sort_array(_gbuf_, _gbuf_->buffer, _gbuf_->count);
+    _gbuf_->flag = cmc_flags.OK;
+    if (_gbuf_->callbacks && _gbuf_->callbacks->update)
+        _gbuf_->callbacks->update();
+}
+_Bool gb_sort_range(struct gapbuffer *_gbuf_, size_t from, size_t to)
+{
+    if (from > to)
+    {
+        _gbuf_->flag = cmc_flags.INVALID;
+        return 0;
+    }
+    if (to >= _gbuf_->count)
+    {
+        _gbuf_->flag = cmc_flags.RANGE;
+        return 0;
+    }
+    if (_gbuf_->gap > from && _gbuf_->gap <= to)
+        gb_move_gap(_gbuf_, to + 1);
+    gb_impl_sort_array(_gbuf_, _gbuf_->buffer + gb_impl_position(_gbuf_, from),
+                       to - from + 1);
+    _gbuf_->flag = cmc_flags.OK;
+    if (_gbuf_->callbacks && _gbuf_->callbacks->update)
+        _gbuf_->callbacks->update();
+    return 1;
+}
+struct gapbuffer *gb_copy_of(struct gapbuffer *_gbuf_)
+{
+    struct gapbuffer *result = gb_new_custom(_gbuf_->capacity, _gbuf_->f_val,
+                                             _gbuf_->alloc, _gbuf_->callbacks);
+    if (!result)
+    {
+        _gbuf_->flag = cmc_flags.ALLOC;
+        return ((void *)0);
+    }
+    size_t after = _gbuf_->count - _gbuf_->gap;
+    size_t tail = _gbuf_->capacity - after;
+    if (_gbuf_->f_val->cpy)
+    {
+        for (size_t i = 0; i < _gbuf_->count; i++)
+        {
+            size_t j = gb_impl_position(_gbuf_, i);
+            result->buffer[j] = _gbuf_->f_val->cpy(_gbuf_->buffer[j]);
+        }
+    }
+    else
+    {
+        memcpy(result->buffer, _gbuf_->buffer, sizeof(size_t) * _gbuf_->gap);
+        memcpy(result->buffer + tail, _gbuf_->buffer + tail,
+               sizeof(size_t) * after);
+    }
+    result->count = _gbuf_->count;
+    result->gap = _gbuf_->gap;
+    result->growth = _gbuf_->growth;
+    _gbuf_->flag = cmc_flags.OK;
+    return result;
+}
+_Bool gb_equals(struct gapbuffer *_gbuf1_, struct gapbuffer *_gbuf2_)
+{
+    _gbuf1_->flag = cmc_flags.OK;
+    _gbuf2_->flag = cmc_flags.OK;
+    if (_gbuf1_->count != _gbuf2_->count)
+        return 0;
+    for (size_t i = 0; i < _gbuf1_->count; i++)
+    {
+        size_t value1 = _gbuf1_->buffer[gb_impl_position(_gbuf1_, i)];
+        size_t value2 = _gbuf2_->buffer[gb_impl_position(_gbuf2_, i)];
+        if (_gbuf1_->f_val->cmp(value1, value2) != 0)
+            return 0;
+    }
+    return 1;
+}
+struct cmc_string gb_to_string(struct gapbuffer *_gbuf_)
+{
+    struct cmc_string str;
+    struct gapbuffer *g_ = _gbuf_;
+    int n =
+        snprintf(str.s, cmc_string_len, cmc_string_fmt_gapbuffer, "gapbuffer",
+                 "size_t", g_, g_->buffer, g_->capacity, g_->count, g_->gap,
+                 g_->flag, g_->f_val, g_->alloc, g_->callbacks);
+    return n >= 0 ? str : (struct cmc_string){ 0 };
+}
+_Bool gb_print(struct gapbuffer *_gbuf_, FILE *fptr)
+{
+    for (size_t i = 0; i < _gbuf_->count; i++)
+    {
+        size_t value = _gbuf_->buffer[gb_impl_position(_gbuf_, i)];
+        if (!_gbuf_->f_val->str(fptr, value))
+            return 0;
+    }
+    return 1;
+}
+struct gapbuffer_iter gb_iter_start(struct gapbuffer *target)
+{
+    struct gapbuffer_iter iter;
+    iter.target = target;
+    iter.cursor = 0;
+    iter.start = 1;
+    iter.end = gb_empty(target);
+    return iter;
+}
+struct gapbuffer_iter gb_iter_end(struct gapbuffer *target)
+{
+    struct gapbuffer_iter iter;
+    iter.target = target;
+    iter.cursor = 0;
+    iter.start = gb_empty(target);
+    iter.end = 1;
+    if (!gb_empty(target))
+        iter.cursor = target->count - 1;
+    return iter;
+}
+_Bool gb_iter_at_start(struct gapbuffer_iter *iter)
+{
+    return gb_empty(iter->target) || iter->start;
+}
+_Bool gb_iter_at_end(struct gapbuffer_iter *iter)
+{
+    return gb_empty(iter->target) || iter->end;
+}
+_Bool gb_iter_to_start(struct gapbuffer_iter *iter)
+{
+    if (!gb_empty(iter->target))
+    {
+        iter->cursor = 0;
+        iter->start = 1;
+        iter->end = gb_empty(iter->target);
+        return 1;
+    }
+    return 0;
+}
+_Bool gb_iter_to_end(struct gapbuffer_iter *iter)
+{
+    if (!gb_empty(iter->target))
+    {
+        iter->start = gb_empty(iter->target);
+        iter->cursor = iter->target->count - 1;
+        iter->end = 1;
+        return 1;
+    }
+    return 0;
+}
+_Bool gb_iter_next(struct gapbuffer_iter *iter)
+{
+    if (iter->end)
+        return 0;
+    if (iter->cursor + 1 == iter->target->count)
+    {
+        iter->end = 1;
+        return 0;
+    }
+    iter->start = gb_empty(iter->target);
+    iter->cursor++;
+    return 1;
+}
+_Bool gb_iter_prev(struct gapbuffer_iter *iter)
+{
+    if (iter->start)
+        return 0;
+    if (iter->cursor == 0)
+    {
+        iter->start = 1;
+        return 0;
+    }
+    iter->end = gb_empty(iter->target);
+    iter->cursor--;
+    return 1;
+}
+_Bool gb_iter_advance(struct gapbuffer_iter *iter, size_t steps)
+{
+    if (iter->end)
+        return 0;
+    if (iter->cursor + 1 == iter->target->count)
+    {
+        iter->end = 1;
+        return 0;
+    }
+    if (steps == 0 || iter->cursor + steps >= iter->target->count)
+        return 0;
+    iter->start = gb_empty(iter->target);
+    iter->cursor += steps;
+    return 1;
+}
+_Bool gb_iter_rewind(struct gapbuffer_iter *iter, size_t steps)
+{
+    if (iter->start)
+        return 0;
+    if (iter->cursor == 0)
+    {
+        iter->start = 1;
+        return 0;
+    }
+    if (steps == 0 || iter->cursor < steps)
+        return 0;
+    iter->end = gb_empty(iter->target);
+    iter->cursor -= steps;
+    return 1;
+}
+_Bool gb_iter_go_to(struct gapbuffer_iter *iter, size_t index)
+{
+    if (index >= iter->target->count)
+        return 0;
+    if (iter->cursor > index)
+        return gb_iter_rewind(iter, iter->cursor - index);
+    else if (iter->cursor < index)
+        return gb_iter_advance(iter, index - iter->cursor);
+    return 1;
+}
+size_t gb_iter_value(struct gapbuffer_iter *iter)
+{
+    if (gb_empty(iter->target))
+        return (size_t){ 0 };
+    return iter->target->buffer[gb_impl_position(iter->target, iter->cursor)];
+}
+size_t *gb_iter_rvalue(struct gapbuffer_iter *iter)
+{
+    if (gb_empty(iter->target))
+        return ((void *)0);
+    return &(
+        iter->target->buffer[gb_impl_position(iter->target, iter->cursor)]);
+}
+size_t gb_iter_index(struct gapbuffer_iter *iter)
+{
+    return iter->cursor;
+}
+static size_t gb_impl_position(struct gapbuffer *_gbuf_, size_t index)
+{
+    if (index < _gbuf_->gap)
+        return index;
+    return index + _gbuf_->capacity - _gbuf_->count;
+}
+static void gb_impl_sort_swap(size_t *a, size_t *b)
+{
+    size_t tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+static void gb_impl_sort_insertion(size_t *begin, size_t *end,
+                                   int (*cmp)(size_t, size_t))
+{
+    if (begin == end)
+        return;
+    for (size_t *cur = begin + 1; cur != end; cur++)
+    {
+        size_t *sift = cur;
+        size_t *sift_1 = cur - 1;
+        if (cmp(*sift, *sift_1) < 0)
+        {
+            size_t tmp = *sift;
+            do
+            {
+                *sift-- = *sift_1;
+            } while (sift != begin && cmp(tmp, *--sift_1) < 0);
+            *sift = tmp;
+        }
+    }
+}
+static void gb_impl_sort_insertion_unguarded(size_t *begin, size_t *end,
+                                             int (*cmp)(size_t, size_t))
+{
+    if (begin == end)
+        return;
+    for (size_t *cur = begin + 1; cur != end; cur++)
+    {
+        size_t *sift = cur;
+        size_t *sift_1 = cur - 1;
+        if (cmp(*sift, *sift_1) < 0)
+        {
+            size_t tmp = *sift;
+            do
+            {
+                *sift-- = *sift_1;
+            } while (cmp(tmp, *--sift_1) < 0);
+            *sift = tmp;
+        }
+    }
+}
+static _Bool gb_impl_sort_insertion_partial(size_t *begin, size_t *end,
+                                            int (*cmp)(size_t, size_t))
+{
+    if (begin == end)
+        return 1;
+    size_t moves = 0;
+    for (size_t *cur = begin + 1; cur != end; cur++)
+    {
+        size_t *sift = cur;
+        size_t *sift_1 = cur - 1;
+        if (cmp(*sift, *sift_1) < 0)
+        {
+            size_t tmp = *sift;
+            do
+            {
+                *sift-- = *sift_1;
+            } while (sift != begin && cmp(tmp, *--sift_1) < 0);
+            *sift = tmp;
+            moves += (size_t)(cur - sift);
+        }
+        if (moves > 8)
+            return 0;
+    }
+    return 1;
+}
+static void gb_impl_sort_heapsort_sift(size_t *array, size_t root, size_t count,
+                                       int (*cmp)(size_t, size_t))
+{
+    size_t value = array[root];
+    while (root * 2 + 1 < count)
+    {
+        size_t child = root * 2 + 1;
+        if (child + 1 < count && cmp(array[child], array[child + 1]) < 0)
+            child++;
+        if (cmp(value, array[child]) >= 0)
+            break;
+        array[root] = array[child];
+        root = child;
+    }
+    array[root] = value;
+}
+static void gb_impl_sort_heapsort(size_t *begin, size_t *end,
+                                  int (*cmp)(size_t, size_t))
+{
+    size_t count = (size_t)(end - begin);
+    for (size_t i = count / 2; i > 0; i--)
+        gb_impl_sort_heapsort_sift(begin, i - 1, count, cmp);
+    for (size_t i = count; i > 1; i--)
+    {
+        gb_impl_sort_swap(begin, begin + i - 1);
+        gb_impl_sort_heapsort_sift(begin, 0, i - 1, cmp);
+    }
+}
+static void gb_impl_sort_sort2(size_t *a, size_t *b, int (*cmp)(size_t, size_t))
+{
+    if (cmp(*b, *a) < 0)
+        gb_impl_sort_swap(a, b);
+}
+static void gb_impl_sort_sort3(size_t *a, size_t *b, size_t *c,
+                               int (*cmp)(size_t, size_t))
+{
+    gb_impl_sort_sort2(a, b, cmp);
+    gb_impl_sort_sort2(b, c, cmp);
+    gb_impl_sort_sort2(a, b, cmp);
+}
+static size_t *gb_impl_sort_partition_right(size_t *begin, size_t *end,
+                                            int (*cmp)(size_t, size_t),
+                                            _Bool *already_partitioned)
+{
+    size_t pivot = *begin;
+    size_t *first = begin;
+    size_t *last = end;
+    while (cmp(*++first, pivot) < 0)
+        ;
+    if (first - 1 == begin)
+    {
+        while (first < last && cmp(*--last, pivot) >= 0)
+            ;
+    }
+    else
+    {
+        while (cmp(*--last, pivot) >= 0)
+            ;
+    }
+    *already_partitioned = first >= last;
+    while (first < last)
+    {
+        gb_impl_sort_swap(first, last);
+        while (cmp(*++first, pivot) < 0)
+            ;
+        while (cmp(*--last, pivot) >= 0)
+            ;
+    }
+    size_t *pivot_pos = first - 1;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+static size_t *gb_impl_sort_partition_left(size_t *begin, size_t *end,
+                                           int (*cmp)(size_t, size_t))
+{
+    size_t pivot = *begin;
+    size_t *first = begin;
+    size_t *last = end;
+    while (cmp(pivot, *--last) < 0)
+        ;
+    if (last + 1 == end)
+    {
+        while (first < last && cmp(pivot, *++first) >= 0)
+            ;
+    }
+    else
+    {
+        while (cmp(pivot, *++first) >= 0)
+            ;
+    }
+    while (first < last)
+    {
+        gb_impl_sort_swap(first, last);
+        while (cmp(pivot, *--last) < 0)
+            ;
+        while (cmp(pivot, *++first) >= 0)
+            ;
+    }
+    size_t *pivot_pos = last;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+static void gb_impl_sort_pdqsort(size_t *begin, size_t *end,
+                                 int (*cmp)(size_t, size_t), size_t bad_allowed,
+                                 _Bool leftmost)
+{
+    while (1)
+    {
+        size_t size = (size_t)(end - begin);
+        if (size < 24)
+        {
+            if (leftmost)
+                gb_impl_sort_insertion(begin, end, cmp);
+            else
+                gb_impl_sort_insertion_unguarded(begin, end, cmp);
+            return;
+        }
+        size_t s2 = size / 2;
+        if (size > 128)
+        {
+            gb_impl_sort_sort3(begin, begin + s2, end - 1, cmp);
+            gb_impl_sort_sort3(begin + 1, begin + (s2 - 1), end - 2, cmp);
+            gb_impl_sort_sort3(begin + 2, begin + (s2 + 1), end - 3, cmp);
+            gb_impl_sort_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1),
+                               cmp);
+            gb_impl_sort_swap(begin, begin + s2);
+        }
+        else
+            gb_impl_sort_sort3(begin + s2, begin, end - 1, cmp);
+        if (!leftmost && cmp(*(begin - 1), *begin) >= 0)
+        {
+            begin = gb_impl_sort_partition_left(begin, end, cmp) + 1;
+            continue;
+        }
+        _Bool already_partitioned;
+        size_t *pivot_pos =
+            gb_impl_sort_partition_right(begin, end, cmp, &already_partitioned);
+        size_t l_size = (size_t)(pivot_pos - begin);
+        size_t r_size = (size_t)(end - (pivot_pos + 1));
+        if (l_size < size / 8 || r_size < size / 8)
+        {
+            if (--bad_allowed == 0)
+            {
+                gb_impl_sort_heapsort(begin, end, cmp);
+                return;
+            }
+            if (l_size >= 24)
+            {
+                size_t q = l_size / 4;
+                gb_impl_sort_swap(begin, begin + q);
+                gb_impl_sort_swap(pivot_pos - 1, pivot_pos - q);
+                if (l_size > 128)
+                {
+                    gb_impl_sort_swap(begin + 1, begin + (q + 1));
+                    gb_impl_sort_swap(begin + 2, begin + (q + 2));
+                    gb_impl_sort_swap(pivot_pos - 2, pivot_pos - (q + 1));
+                    gb_impl_sort_swap(pivot_pos - 3, pivot_pos - (q + 2));
+                }
+            }
+            if (r_size >= 24)
+            {
+                size_t q = r_size / 4;
+                gb_impl_sort_swap(pivot_pos + 1, pivot_pos + (1 + q));
+                gb_impl_sort_swap(end - 1, end - q);
+                if (r_size > 128)
+                {
+                    gb_impl_sort_swap(pivot_pos + 2, pivot_pos + (2 + q));
+                    gb_impl_sort_swap(pivot_pos + 3, pivot_pos + (3 + q));
+                    gb_impl_sort_swap(end - 2, end - (1 + q));
+                    gb_impl_sort_swap(end - 3, end - (2 + q));
+                }
+            }
+        }
+        else if (already_partitioned &&
+                 gb_impl_sort_insertion_partial(begin, pivot_pos, cmp) &&
+                 gb_impl_sort_insertion_partial(pivot_pos + 1, end, cmp))
+        {
+            return;
+        }
+        gb_impl_sort_pdqsort(begin, pivot_pos, cmp, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = 0;
+    }
+}
+static void gb_impl_sort(size_t *array, size_t count,
+                         int (*cmp)(size_t, size_t))
+{
+    if (count < 2)
+        return;
+    size_t bad_allowed = 0;
+    for (size_t n = count; n > 1; n >>= 1)
+        bad_allowed++;
+    gb_impl_sort_pdqsort(array, array + count, cmp, bad_allowed, 1);
+}
+static void gb_impl_sort_array(struct gapbuffer *_gbuf_, size_t *array,
+                               size_t count)
+{
+    gb_impl_sort(array, count, _gbuf_->f_val->cmp);
+}
+
+#endif /* CMC_TEST_SRC_GAPBUFFER */
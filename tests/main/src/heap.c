@@ -13,6 +13,7 @@ struct heap
     struct heap_fval *f_val;
     struct cmc_alloc_node *alloc;
     struct cmc_callbacks *callbacks;
+    const struct cmc_growth *growth;
 };
 struct heap_fval
 {
@@ -35,11 +36,15 @@ struct heap *h_new(size_t capacity, enum cmc_heap_order HO,
 struct heap *h_new_custom(size_t capacity, enum cmc_heap_order HO,
                           struct heap_fval *f_val, struct cmc_alloc_node *alloc,
                           struct cmc_callbacks *callbacks);
+struct heap *h_from_array(size_t *values, size_t count, enum cmc_heap_order HO,
+                          struct heap_fval *f_val);
 void h_clear(struct heap *_heap_);
 void h_free(struct heap *_heap_);
 void h_customize(struct heap *_heap_, struct cmc_alloc_node *alloc,
                  struct cmc_callbacks *callbacks);
+void h_set_growth(struct heap *_heap_, const struct cmc_growth *growth);
 _Bool h_insert(struct heap *_heap_, size_t value);
+_Bool h_insert_many(struct heap *_heap_, size_t *values, size_t count);
 _Bool h_remove(struct heap *_heap_);
 size_t h_peek(struct heap *_heap_);
 _Bool h_contains(struct heap *_heap_, size_t value);
@@ -49,6 +54,10 @@ size_t h_count(struct heap *_heap_);
 size_t h_capacity(struct heap *_heap_);
 int h_flag(struct heap *_heap_);
 _Bool h_resize(struct heap *_heap_, size_t capacity);
+_Bool h_reserve(struct heap *_heap_, size_t size);
+_Bool h_shrink_to_fit(struct heap *_heap_);
+void h_heap_sort(struct heap *_heap_);
+size_t h_drain_sorted(struct heap *_heap_, size_t *out);
 struct heap *h_copy_of(struct heap *_heap_);
 _Bool h_equals(struct heap *_heap1_, struct heap *_heap2_);
 struct cmc_string h_to_string(struct heap *_heap_);
@@ -68,6 +77,8 @@ size_t h_iter_value(struct heap_iter *iter);
 size_t h_iter_index(struct heap_iter *iter);
 static void h_impl_float_up(struct heap *_heap_, size_t index);
 static void h_impl_float_down(struct heap *_heap_, size_t index);
+static void h_impl_heapify(struct heap *_heap_);
+static void h_impl_sort(struct heap *_heap_);
 struct heap *h_new(size_t capacity, enum cmc_heap_order HO,
                    struct heap_fval *f_val)
 {
@@ -94,6 +105,7 @@ struct heap *h_new(size_t capacity, enum cmc_heap_order HO,
     _heap_->f_val = f_val;
     _heap_->alloc = alloc;
     _heap_->callbacks = ((void *)0);
+    _heap_->growth = ((void *)0);
     return _heap_;
 }
 struct heap *h_new_custom(size_t capacity, enum cmc_heap_order HO,
@@ -124,6 +136,19 @@ struct heap *h_new_custom(size_t capacity, enum cmc_heap_order HO,
     _heap_->f_val = f_val;
     _heap_->alloc = alloc;
     _heap_->callbacks = callbacks;
+    _heap_->growth = ((void *)0);
+    return _heap_;
+}
+struct heap *h_from_array(size_t *values, size_t count, enum cmc_heap_order HO,
+                          struct heap_fval *f_val)
+{
+    struct heap *_heap_ = h_new(count > 0 ? count : 1, HO, f_val);
+    if (!_heap_)
+        return ((void *)0);
+    if (count > 0)
+        memcpy(_heap_->buffer, values, sizeof(size_t) * count);
+    _heap_->count = count;
+    h_impl_heapify(_heap_);
     return _heap_;
 }
 void h_clear(struct heap *_heap_)
@@ -161,11 +186,16 @@ void h_customize(struct heap *_heap_, struct cmc_alloc_node *alloc,
     _heap_->callbacks = callbacks;
     _heap_->flag = cmc_flags.OK;
 }
+void h_set_growth(struct heap *_heap_, const struct cmc_growth *growth)
+{
+    _heap_->growth = growth;
+    _heap_->flag = cmc_flags.OK;
+}
 _Bool h_insert(struct heap *_heap_, size_t value)
 {
     if (h_full(_heap_))
     {
-        if (!h_resize(_heap_, _heap_->count * 2))
+        if (!h_reserve(_heap_, 1))
             return 0;
     }
     _heap_->buffer[_heap_->count++] = value;
@@ -178,6 +208,29 @@ _Bool h_insert(struct heap *_heap_, size_t value)
         _heap_->callbacks->create();
     return 1;
 }
+_Bool h_insert_many(struct heap *_heap_, size_t *values, size_t count)
+{
+    if (!h_reserve(_heap_, count))
+        return 0;
+    if (count == 0)
+        return 1;
+    size_t start = _heap_->count;
+    memcpy(_heap_->buffer + start, values, sizeof(size_t) * count);
+    if (count >= start)
+    {
+        _heap_->count += count;
+        h_impl_heapify(_heap_);
+    }
+    else
+    {
+        for (size_t i = 0; i < count; i++)
+            h_impl_float_up(_heap_, _heap_->count++);
+    }
+    _heap_->flag = cmc_flags.OK;
+    if (_heap_->callbacks && _heap_->callbacks->create)
+        _heap_->callbacks->create();
+    return 1;
+}
 _Bool h_remove(struct heap *_heap_)
 {
     if (h_empty(_heap_))
@@ -266,6 +319,48 @@ success:
         _heap_->callbacks->resize();
     return 1;
 }
+_Bool h_reserve(struct heap *_heap_, size_t size)
+{
+    _heap_->flag = cmc_flags.OK;
+    if (size <= _heap_->capacity - _heap_->count)
+        return 1;
+    if (size > (18446744073709551615UL) - _heap_->count)
+    {
+        _heap_->flag = cmc_flags.ERROR;
+        return 0;
+    }
+    return h_resize(_heap_,
+                    cmc_growth_capacity(_heap_->growth, _heap_->capacity,
+                                        _heap_->count + size));
+}
+_Bool h_shrink_to_fit(struct heap *_heap_)
+{
+    return h_resize(_heap_, _heap_->count > 0 ? _heap_->count : 1);
+}
+void h_heap_sort(struct heap *_heap_)
+{
+    h_impl_sort(_heap_);
+    _heap_->flag = cmc_flags.OK;
+    if (_heap_->callbacks && _heap_->callbacks->update)
+        _heap_->callbacks->update();
+}
+size_t h_drain_sorted(struct heap *_heap_, size_t *out)
+{
+    size_t count = _heap_->count;
+    if (count == 0)
+    {
+        _heap_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    h_impl_sort(_heap_);
+    memcpy(out, _heap_->buffer, sizeof(size_t) * count);
+    memset(_heap_->buffer, 0, sizeof(size_t) * count);
+    _heap_->count = 0;
+    _heap_->flag = cmc_flags.OK;
+    if (_heap_->callbacks && _heap_->callbacks->delete)
+        _heap_->callbacks->delete ();
+    return count;
+}
 struct heap *h_copy_of(struct heap *_heap_)
 {
     struct heap *result =
@@ -284,6 +379,7 @@ struct heap *h_copy_of(struct heap *_heap_)
     else
         memcpy(result->buffer, _heap_->buffer, sizeof(size_t) * _heap_->count);
     result->count = _heap_->count;
+    result->growth = _heap_->growth;
     _heap_->flag = cmc_flags.OK;
     return result;
 }
@@ -449,49 +545,68 @@ size_t h_iter_index(struct heap_iter *iter)
 }
 static void h_impl_float_up(struct heap *_heap_, size_t index)
 {
-    size_t C = index;
-    size_t child = _heap_->buffer[C];
-    size_t parent = _heap_->buffer[(index - 1) / 2];
     int mod = _heap_->HO;
-    while (C > 0 && _heap_->f_val->cmp(child, parent) * mod > 0)
+    size_t value = _heap_->buffer[index];
+    while (index > 0)
     {
-        size_t tmp = _heap_->buffer[C];
-        _heap_->buffer[C] = _heap_->buffer[(C - 1) / 2];
-        _heap_->buffer[(C - 1) / 2] = tmp;
-        C = (C - 1) / 2;
-        if (C == 0)
+        size_t P = (index - 1) / (2);
+        if (_heap_->f_val->cmp(value, _heap_->buffer[P]) * mod <= 0)
             break;
-        child = _heap_->buffer[C];
-        parent = _heap_->buffer[(C - 1) / 2];
+        _heap_->buffer[index] = _heap_->buffer[P];
+        index = P;
     }
+    _heap_->buffer[index] = value;
 }
 static void h_impl_float_down(struct heap *_heap_, size_t index)
 {
     int mod = _heap_->HO;
-    while (index < _heap_->count)
+    if (index >= _heap_->count)
+        return;
+    size_t value = _heap_->buffer[index];
+    while (1)
     {
-        size_t L = 2 * index + 1;
-        size_t R = 2 * index + 2;
-        size_t C = index;
-        if (L < _heap_->count &&
-            _heap_->f_val->cmp(_heap_->buffer[L], _heap_->buffer[C]) * mod > 0)
-        {
-            C = L;
-        }
-        if (R < _heap_->count &&
-            _heap_->f_val->cmp(_heap_->buffer[R], _heap_->buffer[C]) * mod > 0)
-        {
-            C = R;
-        }
-        if (C != index)
+        size_t first = index * (2) + 1;
+        if (first >= _heap_->count)
+            break;
+        size_t last = _heap_->count - first > (2) ? first + (2) : _heap_->count;
+        size_t C = first;
+        for (size_t i = first + 1; i < last; i++)
         {
-            size_t tmp = _heap_->buffer[index];
-            _heap_->buffer[index] = _heap_->buffer[C];
-            _heap_->buffer[C] = tmp;
-            index = C;
+            if (_heap_->f_val->cmp(_heap_->buffer[i], _heap_->buffer[C]) * mod >
+                0)
+                C = i;
         }
-        else
+        if (_heap_->f_val->cmp(_heap_->buffer[C], value) * mod <= 0)
             break;
+        _heap_->buffer[index] = _heap_->buffer[C];
+        index = C;
+    }
+    _heap_->buffer[index] = value;
+}
+static void h_impl_heapify(struct heap *_heap_)
+{
+    if (_heap_->count < 2)
+        return;
+    for (size_t i = (_heap_->count - 2) / (2) + 1; i > 0; i--)
+        h_impl_float_down(_heap_, i - 1);
+}
+static void h_impl_sort(struct heap *_heap_)
+{
+    size_t count = _heap_->count;
+    while (_heap_->count > 1)
+    {
+        size_t tmp = _heap_->buffer[0];
+        _heap_->buffer[0] = _heap_->buffer[_heap_->count - 1];
+        _heap_->buffer[_heap_->count - 1] = tmp;
+        _heap_->count--;
+        h_impl_float_down(_heap_, 0);
+    }
+    _heap_->count = count;
+    for (size_t i = 0, j = count; i + 1 < j; i++, j--)
+    {
+        size_t tmp = _heap_->buffer[i];
+        _heap_->buffer[i] = _heap_->buffer[j - 1];
+        _heap_->buffer[j - 1] = tmp;
     }
 }
 
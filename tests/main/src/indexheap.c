@@ -0,0 +1,434 @@
+#ifndef CMC_TEST_SRC_INDEXHEAP
+#define CMC_TEST_SRC_INDEXHEAP
+
+#include "cmc/indexheap.h"
+
+struct indexheap
+{
+    size_t *values;
+    size_t *handles;
+    size_t *positions;
+    size_t capacity;
+    size_t count;
+    enum cmc_heap_order HO;
+    int flag;
+    struct indexheap_fval *f_val;
+    struct cmc_alloc_node *alloc;
+    struct cmc_callbacks *callbacks;
+    const struct cmc_growth *growth;
+};
+struct indexheap_fval
+{
+    int (*cmp)(size_t, size_t);
+    size_t (*cpy)(size_t);
+    _Bool (*str)(FILE *, size_t);
+    void (*free)(size_t);
+    size_t (*hash)(size_t);
+    int (*pri)(size_t, size_t);
+};
+struct indexheap *ixh_new(size_t capacity, enum cmc_heap_order HO,
+                          struct indexheap_fval *f_val);
+struct indexheap *ixh_new_custom(size_t capacity, enum cmc_heap_order HO,
+                                 struct indexheap_fval *f_val,
+                                 struct cmc_alloc_node *alloc,
+                                 struct cmc_callbacks *callbacks);
+void ixh_clear(struct indexheap *_heap_);
+void ixh_free(struct indexheap *_heap_);
+void ixh_customize(struct indexheap *_heap_, struct cmc_alloc_node *alloc,
+                   struct cmc_callbacks *callbacks);
+void ixh_set_growth(struct indexheap *_heap_, const struct cmc_growth *growth);
+_Bool ixh_insert(struct indexheap *_heap_, size_t value, size_t *handle);
+_Bool ixh_remove(struct indexheap *_heap_);
+_Bool ixh_remove_handle(struct indexheap *_heap_, size_t handle);
+_Bool ixh_update(struct indexheap *_heap_, size_t handle, size_t value);
+size_t ixh_peek(struct indexheap *_heap_);
+size_t ixh_peek_handle(struct indexheap *_heap_);
+size_t ixh_get(struct indexheap *_heap_, size_t handle);
+_Bool ixh_contains(struct indexheap *_heap_, size_t handle);
+_Bool ixh_empty(struct indexheap *_heap_);
+_Bool ixh_full(struct indexheap *_heap_);
+size_t ixh_count(struct indexheap *_heap_);
+size_t ixh_capacity(struct indexheap *_heap_);
+int ixh_flag(struct indexheap *_heap_);
+_Bool ixh_resize(struct indexheap *_heap_, size_t capacity);
+_Bool ixh_reserve(struct indexheap *_heap_, size_t size);
+struct cmc_string ixh_to_string(struct indexheap *_heap_);
+_Bool ixh_print(struct indexheap *_heap_, FILE *fptr);
+static void ixh_impl_remove_at(struct indexheap *_heap_, size_t index);
+static void ixh_impl_float_up(struct indexheap *_heap_, size_t index);
+static void ixh_impl_float_down(struct indexheap *_heap_, size_t index);
+struct indexheap *ixh_new(size_t capacity, enum cmc_heap_order HO,
+                          struct indexheap_fval *f_val)
+{
+    return ixh_new_custom(capacity, HO, f_val, ((void *)0), ((void *)0));
+}
+struct indexheap *ixh_new_custom(size_t capacity, enum cmc_heap_order HO,
+                                 struct indexheap_fval *f_val,
+                                 struct cmc_alloc_node *alloc,
+                                 struct cmc_callbacks *callbacks)
+{
+    if (capacity < 1)
+        return ((void *)0);
+    if (HO != cmc_min_heap && HO != cmc_max_heap)
+        return ((void *)0);
+    if (!f_val)
+        return ((void *)0);
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+    struct indexheap *_heap_ = alloc->malloc(sizeof(struct indexheap));
+    if (!_heap_)
+        return ((void *)0);
+    _heap_->values = alloc->calloc(capacity, sizeof(size_t));
+    _heap_->handles = alloc->calloc(capacity, sizeof(size_t));
+    _heap_->positions = alloc->calloc(capacity, sizeof(size_t));
+    if (!_heap_->values || !_heap_->handles || !_heap_->positions)
+    {
+        alloc->free(_heap_->values);
+        alloc->free(_heap_->handles);
+        alloc->free(_heap_->positions);
+        alloc->free(_heap_);
+        return ((void *)0);
+    }
+    for (size_t i = 0; i < capacity; i++)
+    {
+        _heap_->handles[i] = i;
+        _heap_->positions[i] = i;
+    }
+    _heap_->capacity = capacity;
+    _heap_->count = 0;
+    _heap_->HO = HO;
+    _heap_->flag = cmc_flags.OK;
+    _heap_->f_val = f_val;
+    _heap_->alloc = alloc;
+    _heap_->callbacks = callbacks;
+    _heap_->growth = ((void *)0);
+    return _heap_;
+}
+void ixh_clear(struct indexheap *_heap_)
+{
+    if (_heap_->f_val->free)
+    {
+        for (size_t i = 0; i < _heap_->count; i++)
+        {
+            _heap_->f_val->free(_heap_->values[_heap_->handles[i]]);
+        }
+    }
+    memset(_heap_->values, 0, sizeof(size_t) * _heap_->capacity);
+    _heap_->count = 0;
+    _heap_->flag = cmc_flags.OK;
+}
+void ixh_free(struct indexheap *_heap_)
+{
+    if (_heap_->f_val->free)
+    {
+        for (size_t i = 0; i < _heap_->count; i++)
+        {
+            _heap_->f_val->free(_heap_->values[_heap_->handles[i]]);
+        }
+    }
+    _heap_->alloc->free(_heap_->values);
+    _heap_->alloc->free(_heap_->handles);
+    _heap_->alloc->free(_heap_->positions);
+    _heap_->alloc->free(_heap_);
+}
+void ixh_customize(struct indexheap *_heap_, struct cmc_alloc_node *alloc,
+                   struct cmc_callbacks *callbacks)
+{
+    if (!alloc)
+        _heap_->alloc = &cmc_alloc_node_default;
+    else
+        _heap_->alloc = alloc;
+    _heap_->callbacks = callbacks;
+    _heap_->flag = cmc_flags.OK;
+}
+void ixh_set_growth(struct indexheap *_heap_, const struct cmc_growth *growth)
+{
+    _heap_->growth = growth;
+    _heap_->flag = cmc_flags.OK;
+}
+_Bool ixh_insert(struct indexheap *_heap_, size_t value, size_t *handle)
+{
+    if (ixh_full(_heap_))
+    {
+        if (!ixh_reserve(_heap_, 1))
+            return 0;
+    }
+    size_t H = _heap_->handles[_heap_->count++];
+    _heap_->values[H] = value;
+    ixh_impl_float_up(_heap_, _heap_->count - 1);
+    if (handle)
+        *handle = H;
+    _heap_->flag = cmc_flags.OK;
+    if (_heap_->callbacks && _heap_->callbacks->create)
+        _heap_->callbacks->create();
+    return 1;
+}
+_Bool ixh_remove(struct indexheap *_heap_)
+{
+    if (ixh_empty(_heap_))
+    {
+        _heap_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    ixh_impl_remove_at(_heap_, 0);
+    _heap_->flag = cmc_flags.OK;
+    if (_heap_->callbacks && _heap_->callbacks->delete)
+        _heap_->callbacks->delete ();
+    return 1;
+}
+_Bool ixh_remove_handle(struct indexheap *_heap_, size_t handle)
+{
+    if (!ixh_contains(_heap_, handle))
+    {
+        _heap_->flag = cmc_flags.INVALID;
+        return 0;
+    }
+    ixh_impl_remove_at(_heap_, _heap_->positions[handle]);
+    _heap_->flag = cmc_flags.OK;
+    if (_heap_->callbacks && _heap_->callbacks->delete)
+        _heap_->callbacks->delete ();
+    return 1;
+}
+_Bool ixh_update(struct indexheap *_heap_, size_t handle, size_t value)
+{
+    if (!ixh_contains(_heap_, handle))
+    {
+        _heap_->flag = cmc_flags.INVALID;
+        return 0;
+    }
+    _heap_->values[handle] = value;
+    ixh_impl_float_up(_heap_, _heap_->positions[handle]);
+    ixh_impl_float_down(_heap_, _heap_->positions[handle]);
+    _heap_->flag = cmc_flags.OK;
+    if (_heap_->callbacks && _heap_->callbacks->update)
+        _heap_->callbacks->update();
+    return 1;
+}
+size_t ixh_peek(struct indexheap *_heap_)
+{
+    if (ixh_empty(_heap_))
+    {
+        _heap_->flag = cmc_flags.EMPTY;
+        return (size_t){ 0 };
+    }
+    _heap_->flag = cmc_flags.OK;
+    if (_heap_->callbacks && _heap_->callbacks->read)
+        _heap_->callbacks->read();
+    return _heap_->values[_heap_->handles[0]];
+}
+size_t ixh_peek_handle(struct indexheap *_heap_)
+{
+    if (ixh_empty(_heap_))
+    {
+        _heap_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    _heap_->flag = cmc_flags.OK;
+    if (_heap_->callbacks && _heap_->callbacks->read)
+        _heap_->callbacks->read();
+    return _heap_->handles[0];
+}
+size_t ixh_get(struct indexheap *_heap_, size_t handle)
+{
+    if (!ixh_contains(_heap_, handle))
+    {
+        _heap_->flag = cmc_flags.INVALID;
+        return (size_t){ 0 };
+    }
+    _heap_->flag = cmc_flags.OK;
+    if (_heap_->callbacks && _heap_->callbacks->read)
+        _heap_->callbacks->read();
+    return _heap_->values[handle];
+}
+_Bool ixh_contains(struct indexheap *_heap_, size_t handle)
+{
+    return handle < _heap_->capacity &&
+           _heap_->positions[handle] < _heap_->count;
+}
+_Bool ixh_empty(struct indexheap *_heap_)
+{
+    return _heap_->count == 0;
+}
+_Bool ixh_full(struct indexheap *_heap_)
+{
+    return _heap_->count >= _heap_->capacity;
+}
+size_t ixh_count(struct indexheap *_heap_)
+{
+    return _heap_->count;
+}
+size_t ixh_capacity(struct indexheap *_heap_)
+{
+    return _heap_->capacity;
+}
+int ixh_flag(struct indexheap *_heap_)
+{
+    return _heap_->flag;
+}
+_Bool ixh_resize(struct indexheap *_heap_, size_t capacity)
+{
+    _heap_->flag = cmc_flags.OK;
+    if (_heap_->capacity == capacity)
+        goto success;
+    if (capacity < _heap_->count)
+    {
+        _heap_->flag = cmc_flags.INVALID;
+        return 0;
+    }
+    if (capacity > (18446744073709551615UL) / sizeof(size_t) ||
+        capacity > (18446744073709551615UL) / sizeof(size_t))
+    {
+        _heap_->flag = cmc_flags.ERROR;
+        return 0;
+    }
+    if (capacity < _heap_->capacity)
+    {
+        for (size_t i = 0; i < _heap_->count; i++)
+        {
+            if (_heap_->handles[i] >= capacity)
+            {
+                _heap_->flag = cmc_flags.INVALID;
+                return 0;
+            }
+        }
+        for (size_t H = _heap_->capacity, end = H; H > capacity; H--, end--)
+        {
+            size_t P = _heap_->positions[H - 1];
+            size_t last = _heap_->handles[end - 1];
+            _heap_->handles[P] = last;
+            _heap_->positions[last] = P;
+            _heap_->handles[end - 1] = H - 1;
+            _heap_->positions[H - 1] = end - 1;
+        }
+    }
+    size_t *new_values = _heap_->alloc->malloc(sizeof(size_t) * capacity);
+    size_t *new_handles = _heap_->alloc->malloc(sizeof(size_t) * capacity);
+    size_t *new_positions = _heap_->alloc->malloc(sizeof(size_t) * capacity);
+    if (!new_values || !new_handles || !new_positions)
+    {
+        _heap_->alloc->free(new_values);
+        _heap_->alloc->free(new_handles);
+        _heap_->alloc->free(new_positions);
+        _heap_->flag = cmc_flags.ALLOC;
+        return 0;
+    }
+    size_t kept = capacity < _heap_->capacity ? capacity : _heap_->capacity;
+    memcpy(new_values, _heap_->values, sizeof(size_t) * kept);
+    memcpy(new_handles, _heap_->handles, sizeof(size_t) * kept);
+    memcpy(new_positions, _heap_->positions, sizeof(size_t) * kept);
+    _heap_->alloc->free(_heap_->values);
+    _heap_->alloc->free(_heap_->handles);
+    _heap_->alloc->free(_heap_->positions);
+    _heap_->values = new_values;
+    _heap_->handles = new_handles;
+    _heap_->positions = new_positions;
+    for (size_t i = _heap_->capacity; i < capacity; i++)
+    {
+        _heap_->values[i] = (size_t){ 0 };
+        _heap_->handles[i] = i;
+        _heap_->positions[i] = i;
+    }
+    _heap_->capacity = capacity;
+success:
+    if (_heap_->callbacks && _heap_->callbacks->resize)
+        _heap_->callbacks->resize();
+    return 1;
+}
+_Bool ixh_reserve(struct indexheap *_heap_, size_t size)
+{
+    _heap_->flag = cmc_flags.OK;
+    if (size <= _heap_->capacity - _heap_->count)
+        return 1;
+    if (size > (18446744073709551615UL) - _heap_->count)
+    {
+        _heap_->flag = cmc_flags.ERROR;
+        return 0;
+    }
+    return ixh_resize(_heap_,
+                      cmc_growth_capacity(_heap_->growth, _heap_->capacity,
+                                          _heap_->count + size));
+}
+struct cmc_string ixh_to_string(struct indexheap *_heap_)
+{
+    struct cmc_string str;
+    struct indexheap *h_ = _heap_;
+    const char *t = h_->HO == 1 ? "MaxHeap" : "MinHeap";
+    int n = snprintf(str.s, cmc_string_len, cmc_string_fmt_indexheap,
+                     "indexheap", "size_t", h_, h_->values, h_->handles,
+                     h_->positions, h_->capacity, h_->count, t, h_->flag,
+                     h_->f_val, h_->alloc, h_->callbacks);
+    return n >= 0 ? str : (struct cmc_string){ 0 };
+}
+_Bool ixh_print(struct indexheap *_heap_, FILE *fptr)
+{
+    for (size_t i = 0; i < _heap_->count; i++)
+    {
+        if (!_heap_->f_val->str(fptr, _heap_->values[_heap_->handles[i]]))
+            return 0;
+    }
+    return 1;
+}
+static void ixh_impl_remove_at(struct indexheap *_heap_, size_t index)
+{
+    size_t H = _heap_->handles[index];
+    size_t last = _heap_->handles[_heap_->count - 1];
+    _heap_->handles[index] = last;
+    _heap_->positions[last] = index;
+    _heap_->handles[_heap_->count - 1] = H;
+    _heap_->positions[H] = _heap_->count - 1;
+    _heap_->values[H] = (size_t){ 0 };
+    _heap_->count--;
+    if (index < _heap_->count)
+    {
+        ixh_impl_float_up(_heap_, index);
+        ixh_impl_float_down(_heap_, _heap_->positions[last]);
+    }
+}
+static void ixh_impl_float_up(struct indexheap *_heap_, size_t index)
+{
+    int mod = _heap_->HO;
+    size_t H = _heap_->handles[index];
+    size_t value = _heap_->values[H];
+    while (index > 0)
+    {
+        size_t P = (index - 1) / 2;
+        size_t parent = _heap_->handles[P];
+        if (_heap_->f_val->cmp(value, _heap_->values[parent]) * mod <= 0)
+            break;
+        _heap_->handles[index] = parent;
+        _heap_->positions[parent] = index;
+        index = P;
+    }
+    _heap_->handles[index] = H;
+    _heap_->positions[H] = index;
+}
+static void ixh_impl_float_down(struct indexheap *_heap_, size_t index)
+{
+    int mod = _heap_->HO;
+    if (index >= _heap_->count)
+        return;
+    size_t H = _heap_->handles[index];
+    size_t value = _heap_->values[H];
+    while (1)
+    {
+        size_t C = index * 2 + 1;
+        if (C >= _heap_->count)
+            break;
+        if (C + 1 < _heap_->count &&
+            _heap_->f_val->cmp(_heap_->values[_heap_->handles[C + 1]],
+                               _heap_->values[_heap_->handles[C]]) *
+                    mod >
+                0)
+            C++;
+        size_t child = _heap_->handles[C];
+        if (_heap_->f_val->cmp(_heap_->values[child], value) * mod <= 0)
+            break;
+        _heap_->handles[index] = child;
+        _heap_->positions[child] = index;
+        index = C;
+    }
+    _heap_->handles[index] = H;
+    _heap_->positions[H] = index;
+}
+
+#endif /* CMC_TEST_SRC_INDEXHEAP */
@@ -9,10 +9,12 @@ struct intervalheap
     size_t capacity;
     size_t size;
     size_t count;
+    size_t bound;
     int flag;
     struct intervalheap_fval *f_val;
     struct cmc_alloc_node *alloc;
     struct cmc_callbacks *callbacks;
+    const struct cmc_growth *growth;
 };
 struct intervalheap_fval
 {
@@ -35,13 +37,22 @@ struct intervalheap *ih_new_custom(size_t capacity,
                                    struct intervalheap_fval *f_val,
                                    struct cmc_alloc_node *alloc,
                                    struct cmc_callbacks *callbacks);
+struct intervalheap *ih_new_bounded(size_t bound,
+                                    struct intervalheap_fval *f_val);
+struct intervalheap *ih_from_array(size_t *values, size_t count,
+                                   struct intervalheap_fval *f_val);
 void ih_clear(struct intervalheap *_heap_);
 void ih_free(struct intervalheap *_heap_);
 void ih_customize(struct intervalheap *_heap_, struct cmc_alloc_node *alloc,
                   struct cmc_callbacks *callbacks);
+void ih_set_growth(struct intervalheap *_heap_,
+                   const struct cmc_growth *growth);
 _Bool ih_insert(struct intervalheap *_heap_, size_t value);
+_Bool ih_insert_many(struct intervalheap *_heap_, size_t *values, size_t count);
 _Bool ih_remove_max(struct intervalheap *_heap_);
 _Bool ih_remove_min(struct intervalheap *_heap_);
+_Bool ih_offer_max(struct intervalheap *_heap_, size_t value);
+_Bool ih_offer_min(struct intervalheap *_heap_, size_t value);
 _Bool ih_update_max(struct intervalheap *_heap_, size_t value);
 _Bool ih_update_min(struct intervalheap *_heap_, size_t value);
 size_t ih_max(struct intervalheap *_heap_);
@@ -53,6 +64,9 @@ size_t ih_count(struct intervalheap *_heap_);
 size_t ih_capacity(struct intervalheap *_heap_);
 int ih_flag(struct intervalheap *_heap_);
 _Bool ih_resize(struct intervalheap *_heap_, size_t capacity);
+_Bool ih_reserve(struct intervalheap *_heap_, size_t size);
+_Bool ih_shrink_to_fit(struct intervalheap *_heap_);
+size_t ih_drain_sorted(struct intervalheap *_heap_, size_t *out);
 struct intervalheap *ih_copy_of(struct intervalheap *_set_);
 _Bool ih_equals(struct intervalheap *_heap1_, struct intervalheap *_heap2_);
 struct cmc_string ih_to_string(struct intervalheap *_heap_);
@@ -72,12 +86,13 @@ size_t ih_iter_value(struct intervalheap_iter *iter);
 size_t ih_iter_index(struct intervalheap_iter *iter);
 static void ih_impl_float_up_max(struct intervalheap *_heap_);
 static void ih_impl_float_up_min(struct intervalheap *_heap_);
-static void ih_impl_float_down_max(struct intervalheap *_heap_);
-static void ih_impl_float_down_min(struct intervalheap *_heap_);
+static void ih_impl_float_down_max(struct intervalheap *_heap_, size_t index);
+static void ih_impl_float_down_min(struct intervalheap *_heap_, size_t index);
+static void ih_impl_heapify(struct intervalheap *_heap_);
 struct intervalheap *ih_new(size_t capacity, struct intervalheap_fval *f_val)
 {
     struct cmc_alloc_node *alloc = &cmc_alloc_node_default;
-    if (capacity == 0 || capacity == 0xffffffffffffffffULL)
+    if (capacity == 0 || capacity == (18446744073709551615UL))
         return ((void *)0);
     if (!f_val)
         return ((void *)0);
@@ -94,10 +109,12 @@ struct intervalheap *ih_new(size_t capacity, struct intervalheap_fval *f_val)
     _heap_->capacity = capacity;
     _heap_->size = 0;
     _heap_->count = 0;
+    _heap_->bound = 0;
     _heap_->flag = cmc_flags.OK;
     _heap_->f_val = f_val;
     _heap_->alloc = alloc;
     _heap_->callbacks = ((void *)0);
+    _heap_->growth = ((void *)0);
     return _heap_;
 }
 struct intervalheap *ih_new_custom(size_t capacity,
@@ -105,7 +122,7 @@ struct intervalheap *ih_new_custom(size_t capacity,
                                    struct cmc_alloc_node *alloc,
                                    struct cmc_callbacks *callbacks)
 {
-    if (capacity == 0 || capacity == 0xffffffffffffffffULL)
+    if (capacity == 0 || capacity == (18446744073709551615UL))
         return ((void *)0);
     if (!f_val)
         return ((void *)0);
@@ -124,10 +141,34 @@ struct intervalheap *ih_new_custom(size_t capacity,
     _heap_->capacity = capacity;
     _heap_->size = 0;
     _heap_->count = 0;
+    _heap_->bound = 0;
     _heap_->flag = cmc_flags.OK;
     _heap_->f_val = f_val;
     _heap_->alloc = alloc;
     _heap_->callbacks = callbacks;
+    _heap_->growth = ((void *)0);
+    return _heap_;
+}
+struct intervalheap *ih_new_bounded(size_t bound,
+                                    struct intervalheap_fval *f_val)
+{
+    struct intervalheap *_heap_ = ih_new(bound, f_val);
+    if (!_heap_)
+        return ((void *)0);
+    _heap_->bound = bound;
+    return _heap_;
+}
+struct intervalheap *ih_from_array(size_t *values, size_t count,
+                                   struct intervalheap_fval *f_val)
+{
+    struct intervalheap *_heap_ = ih_new(count > 0 ? count : 1, f_val);
+    if (!_heap_)
+        return ((void *)0);
+    for (size_t i = 0; i < count; i++)
+        _heap_->buffer[i / 2][i % 2] = values[i];
+    _heap_->count = count;
+    _heap_->size = count / 2 + count % 2;
+    ih_impl_heapify(_heap_);
     return _heap_;
 }
 void ih_clear(struct intervalheap *_heap_)
@@ -166,11 +207,21 @@ void ih_customize(struct intervalheap *_heap_, struct cmc_alloc_node *alloc,
     _heap_->callbacks = callbacks;
     _heap_->flag = cmc_flags.OK;
 }
+void ih_set_growth(struct intervalheap *_heap_, const struct cmc_growth *growth)
+{
+    _heap_->growth = growth;
+    _heap_->flag = cmc_flags.OK;
+}
 _Bool ih_insert(struct intervalheap *_heap_, size_t value)
 {
+    if (_heap_->bound != 0 && _heap_->count >= _heap_->bound)
+    {
+        _heap_->flag = cmc_flags.INVALID;
+        return 0;
+    }
     if (ih_full(_heap_))
     {
-        if (!ih_resize(_heap_, _heap_->capacity * 4))
+        if (!ih_reserve(_heap_, 1))
             return 0;
     }
     if (_heap_->count % 2 == 0)
@@ -196,7 +247,7 @@ _Bool ih_insert(struct intervalheap *_heap_, size_t value)
     _heap_->flag = cmc_flags.OK;
     if (_heap_->count > 2)
     {
-        size_t(*parent)[2] = &(_heap_->buffer[(_heap_->size - 2) / 2]);
+        size_t(*parent)[2] = &(_heap_->buffer[(_heap_->size - 2) / (2)]);
         if (_heap_->f_val->cmp((*parent)[0], value) > 0)
             ih_impl_float_up_min(_heap_);
         else if (_heap_->f_val->cmp((*parent)[1], value) < 0)
@@ -206,6 +257,41 @@ _Bool ih_insert(struct intervalheap *_heap_, size_t value)
         _heap_->callbacks->create();
     return 1;
 }
+_Bool ih_insert_many(struct intervalheap *_heap_, size_t *values, size_t count)
+{
+    if (_heap_->bound != 0 && count > _heap_->bound - _heap_->count)
+    {
+        _heap_->flag = cmc_flags.INVALID;
+        return 0;
+    }
+    if (!ih_reserve(_heap_, count))
+        return 0;
+    if (count == 0)
+        return 1;
+    if (count >= _heap_->count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t j = _heap_->count + i;
+            _heap_->buffer[j / 2][j % 2] = values[i];
+        }
+        _heap_->count += count;
+        _heap_->size = _heap_->count / 2 + _heap_->count % 2;
+        ih_impl_heapify(_heap_);
+    }
+    else
+    {
+        struct cmc_callbacks *callbacks = _heap_->callbacks;
+        _heap_->callbacks = ((void *)0);
+        for (size_t i = 0; i < count; i++)
+            ih_insert(_heap_, values[i]);
+        _heap_->callbacks = callbacks;
+    }
+    _heap_->flag = cmc_flags.OK;
+    if (_heap_->callbacks && _heap_->callbacks->create)
+        _heap_->callbacks->create();
+    return 1;
+}
 _Bool ih_remove_max(struct intervalheap *_heap_)
 {
     if (ih_empty(_heap_))
@@ -233,7 +319,7 @@ _Bool ih_remove_max(struct intervalheap *_heap_)
         (*last_node)[1] = (size_t){ 0 };
     }
     _heap_->count--;
-    ih_impl_float_down_max(_heap_);
+    ih_impl_float_down_max(_heap_, 0);
 success:
     _heap_->flag = cmc_flags.OK;
     if (_heap_->callbacks && _heap_->callbacks->delete)
@@ -267,13 +353,32 @@ _Bool ih_remove_min(struct intervalheap *_heap_)
         (*last_node)[1] = (size_t){ 0 };
     }
     _heap_->count--;
-    ih_impl_float_down_min(_heap_);
+    ih_impl_float_down_min(_heap_, 0);
 success:
     _heap_->flag = cmc_flags.OK;
     if (_heap_->callbacks && _heap_->callbacks->delete)
         _heap_->callbacks->delete ();
     return 1;
 }
+_Bool ih_offer_max(struct intervalheap *_heap_, size_t value)
+{
+    if (_heap_->bound == 0 || _heap_->count < _heap_->bound)
+        return ih_insert(_heap_, value);
+    _heap_->flag = cmc_flags.OK;
+    if (_heap_->f_val->cmp(value, _heap_->buffer[0][0]) <= 0)
+        return 0;
+    return ih_update_min(_heap_, value);
+}
+_Bool ih_offer_min(struct intervalheap *_heap_, size_t value)
+{
+    if (_heap_->bound == 0 || _heap_->count < _heap_->bound)
+        return ih_insert(_heap_, value);
+    _heap_->flag = cmc_flags.OK;
+    size_t j = _heap_->count == 1 ? 0 : 1;
+    if (_heap_->f_val->cmp(value, _heap_->buffer[0][j]) >= 0)
+        return 0;
+    return ih_update_max(_heap_, value);
+}
 _Bool ih_update_max(struct intervalheap *_heap_, size_t value)
 {
     if (ih_empty(_heap_))
@@ -289,12 +394,12 @@ _Bool ih_update_max(struct intervalheap *_heap_, size_t value)
     {
         _heap_->buffer[0][1] = _heap_->buffer[0][0];
         _heap_->buffer[0][0] = value;
-        ih_impl_float_down_max(_heap_);
+        ih_impl_float_down_max(_heap_, 0);
     }
     else
     {
         _heap_->buffer[0][1] = value;
-        ih_impl_float_down_max(_heap_);
+        ih_impl_float_down_max(_heap_, 0);
     }
     _heap_->flag = cmc_flags.OK;
     if (_heap_->callbacks && _heap_->callbacks->update)
@@ -316,12 +421,12 @@ _Bool ih_update_min(struct intervalheap *_heap_, size_t value)
     {
         _heap_->buffer[0][0] = _heap_->buffer[0][1];
         _heap_->buffer[0][1] = value;
-        ih_impl_float_down_min(_heap_);
+        ih_impl_float_down_min(_heap_, 0);
     }
     else
     {
         _heap_->buffer[0][0] = value;
-        ih_impl_float_down_min(_heap_);
+        ih_impl_float_down_min(_heap_, 0);
     }
     _heap_->flag = cmc_flags.OK;
     if (_heap_->callbacks && _heap_->callbacks->update)
@@ -394,12 +499,12 @@ _Bool ih_resize(struct intervalheap *_heap_, size_t capacity)
 {
     if (_heap_->capacity == capacity)
         goto success;
-    if (capacity < _heap_->count)
+    if (capacity < _heap_->size)
     {
         _heap_->flag = cmc_flags.INVALID;
         return 0;
     }
-    if (capacity == 0xffffffffffffffffULL)
+    if (capacity == (18446744073709551615UL))
     {
         _heap_->flag = cmc_flags.ERROR;
         return 0;
@@ -425,6 +530,51 @@ success:
         _heap_->callbacks->resize();
     return 1;
 }
+_Bool ih_reserve(struct intervalheap *_heap_, size_t size)
+{
+    _heap_->flag = cmc_flags.OK;
+    if (size <= _heap_->capacity * 2 - _heap_->count)
+        return 1;
+    if (size > (18446744073709551615UL) - _heap_->count)
+    {
+        _heap_->flag = cmc_flags.ERROR;
+        return 0;
+    }
+    size_t required = _heap_->count + size;
+    size_t nodes = required / 2 + required % 2;
+    return ih_resize(
+        _heap_, cmc_growth_capacity(_heap_->growth, _heap_->capacity, nodes));
+}
+_Bool ih_shrink_to_fit(struct intervalheap *_heap_)
+{
+    return ih_resize(_heap_, _heap_->size > 0 ? _heap_->size : 1);
+}
+size_t ih_drain_sorted(struct intervalheap *_heap_, size_t *out)
+{
+    size_t count = _heap_->count;
+    if (count == 0)
+    {
+        _heap_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    struct cmc_callbacks *callbacks = _heap_->callbacks;
+    _heap_->callbacks = ((void *)0);
+    for (size_t i = 0, j = count; i < j; i++, j--)
+    {
+        out[i] = _heap_->buffer[0][0];
+        ih_remove_min(_heap_);
+        if (i + 1 < j)
+        {
+            out[j - 1] = _heap_->buffer[0][_heap_->count == 1 ? 0 : 1];
+            ih_remove_max(_heap_);
+        }
+    }
+    _heap_->callbacks = callbacks;
+    _heap_->flag = cmc_flags.OK;
+    if (_heap_->callbacks && _heap_->callbacks->delete)
+        _heap_->callbacks->delete ();
+    return count;
+}
 struct intervalheap *ih_copy_of(struct intervalheap *_heap_)
 {
     struct intervalheap *result =
@@ -630,7 +780,7 @@ static void ih_impl_float_up_max(struct intervalheap *_heap_)
     size_t(*curr_node)[2] = &(_heap_->buffer[index]);
     while (index > 0)
     {
-        size_t P_index = (index - 1) / 2;
+        size_t P_index = (index - 1) / (2);
         size_t(*parent)[2] = &(_heap_->buffer[P_index]);
         if (index == _heap_->size - 1 && _heap_->count % 2 != 0)
         {
@@ -658,7 +808,7 @@ static void ih_impl_float_up_min(struct intervalheap *_heap_)
     size_t(*curr_node)[2] = &(_heap_->buffer[index]);
     while (index > 0)
     {
-        size_t P_index = (index - 1) / 2;
+        size_t P_index = (index - 1) / (2);
         size_t(*parent)[2] = &(_heap_->buffer[P_index]);
         if (_heap_->f_val->cmp((*curr_node)[0], (*parent)[0]) >= 0)
             break;
@@ -669,30 +819,23 @@ static void ih_impl_float_up_min(struct intervalheap *_heap_)
         curr_node = parent;
     }
 }
-static void ih_impl_float_down_max(struct intervalheap *_heap_)
+static void ih_impl_float_down_max(struct intervalheap *_heap_, size_t index)
 {
-    size_t index = 0;
     size_t(*curr_node)[2] = &(_heap_->buffer[index]);
     while (1)
     {
-        if (2 * index + 1 >= _heap_->size)
+        size_t first = index * (2) + 1;
+        if (first >= _heap_->size)
             break;
-        size_t child;
-        size_t L_index = index * 2 + 1;
-        size_t R_index = index * 2 + 2;
-        if (R_index < _heap_->size)
+        size_t last = _heap_->size - first > (2) ? first + (2) : _heap_->size;
+        size_t child = first;
+        for (size_t i = first + 1; i < last; i++)
         {
-            size_t(*L)[2] = &(_heap_->buffer[L_index]);
-            size_t(*R)[2] = &(_heap_->buffer[R_index]);
-            if (R_index == _heap_->size - 1 && _heap_->count % 2 != 0)
-                child = _heap_->f_val->cmp((*L)[1], (*R)[0]) > 0 ? L_index
-                                                                 : R_index;
-            else
-                child = _heap_->f_val->cmp((*L)[1], (*R)[1]) > 0 ? L_index
-                                                                 : R_index;
+            int j = i == _heap_->size - 1 && _heap_->count % 2 != 0 ? 0 : 1;
+            if (_heap_->f_val->cmp(_heap_->buffer[child][1],
+                                   _heap_->buffer[i][j]) <= 0)
+                child = i;
         }
-        else
-            child = L_index;
         size_t(*child_node)[2] = &(_heap_->buffer[child]);
         if (child == _heap_->size - 1 && _heap_->count % 2 != 0)
         {
@@ -720,26 +863,22 @@ static void ih_impl_float_down_max(struct intervalheap *_heap_)
         curr_node = child_node;
     }
 }
-static void ih_impl_float_down_min(struct intervalheap *_heap_)
+static void ih_impl_float_down_min(struct intervalheap *_heap_, size_t index)
 {
-    size_t index = 0;
     size_t(*curr_node)[2] = &(_heap_->buffer[index]);
     while (1)
     {
-        if (2 * index + 1 >= _heap_->size)
+        size_t first = index * (2) + 1;
+        if (first >= _heap_->size)
             break;
-        size_t child;
-        size_t L_index = index * 2 + 1;
-        size_t R_index = index * 2 + 2;
-        if (R_index < _heap_->size)
+        size_t last = _heap_->size - first > (2) ? first + (2) : _heap_->size;
+        size_t child = first;
+        for (size_t i = first + 1; i < last; i++)
         {
-            size_t(*L)[2] = &(_heap_->buffer[L_index]);
-            size_t(*R)[2] = &(_heap_->buffer[R_index]);
-            child =
-                _heap_->f_val->cmp((*L)[0], (*R)[0]) < 0 ? L_index : R_index;
+            if (_heap_->f_val->cmp(_heap_->buffer[child][0],
+                                   _heap_->buffer[i][0]) >= 0)
+                child = i;
         }
-        else
-            child = L_index;
         size_t(*child_node)[2] = &(_heap_->buffer[child]);
         if (_heap_->f_val->cmp((*curr_node)[0], (*child_node)[0]) < 0)
             break;
@@ -759,5 +898,25 @@ static void ih_impl_float_down_min(struct intervalheap *_heap_)
         curr_node = child_node;
     }
 }
+static void ih_impl_heapify(struct intervalheap *_heap_)
+{
+    size_t full = _heap_->count / 2;
+    for (size_t i = 0; i < full; i++)
+    {
+        if (_heap_->f_val->cmp(_heap_->buffer[i][0], _heap_->buffer[i][1]) > 0)
+        {
+            size_t tmp = _heap_->buffer[i][0];
+            _heap_->buffer[i][0] = _heap_->buffer[i][1];
+            _heap_->buffer[i][1] = tmp;
+        }
+    }
+    if (_heap_->size < 2)
+        return;
+    for (size_t i = (_heap_->size - 2) / (2) + 1; i > 0; i--)
+    {
+        ih_impl_float_down_min(_heap_, i - 1);
+        ih_impl_float_down_max(_heap_, i - 1);
+    }
+}
 
 #endif /* CMC_TEST_SRC_INTERVALHEAP */
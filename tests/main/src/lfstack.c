@@ -0,0 +1,639 @@
+#ifndef CMC_TEST_SRC_LFSTACK
+#define CMC_TEST_SRC_LFSTACK
+
+#include "cmc/lfstack.h"
+
+struct lfstack
+{
+    char pad_0[64];
+    _Atomic uint64_t head;
+    char pad_1[64];
+    _Atomic uint64_t free_head;
+    char pad_2[64];
+    _Atomic size_t nodes;
+    _Atomic(struct lfstack_node *) chunks[32];
+    size_t chunk_size;
+    int flag;
+    struct lfstack_fval *f_val;
+    struct cmc_alloc_node *alloc;
+    struct cmc_callbacks *callbacks;
+};
+struct lfstack_node
+{
+    _Atomic uint32_t next;
+    size_t value;
+};
+struct lfstack_magazine
+{
+    struct lfstack *target;
+    size_t count;
+    size_t values[32];
+};
+struct lfstack_fval
+{
+    int (*cmp)(size_t, size_t);
+    size_t (*cpy)(size_t);
+    _Bool (*str)(FILE *, size_t);
+    void (*free)(size_t);
+    size_t (*hash)(size_t);
+    int (*pri)(size_t, size_t);
+};
+struct lfstack *lfs_new(size_t capacity, struct lfstack_fval *f_val);
+struct lfstack *lfs_new_custom(size_t capacity, struct lfstack_fval *f_val,
+                               struct cmc_alloc_node *alloc,
+                               struct cmc_callbacks *callbacks);
+void lfs_clear(struct lfstack *_stack_);
+void lfs_free(struct lfstack *_stack_);
+void lfs_customize(struct lfstack *_stack_, struct cmc_alloc_node *alloc,
+                   struct cmc_callbacks *callbacks);
+_Bool lfs_push(struct lfstack *_stack_, size_t value);
+_Bool lfs_pop(struct lfstack *_stack_, size_t *out);
+_Bool lfs_push_n(struct lfstack *_stack_, size_t *values, size_t n);
+size_t lfs_pop_n(struct lfstack *_stack_, size_t *out, size_t n);
+size_t lfs_pop_all(struct lfstack *_stack_, void (*consume)(size_t, void *),
+                   void *args);
+void lfs_mag_init(struct lfstack_magazine *mag, struct lfstack *target);
+_Bool lfs_mag_push(struct lfstack_magazine *mag, size_t value);
+_Bool lfs_mag_pop(struct lfstack_magazine *mag, size_t *out);
+_Bool lfs_mag_flush(struct lfstack_magazine *mag);
+_Bool lfs_empty(struct lfstack *_stack_);
+int lfs_flag(struct lfstack *_stack_);
+struct cmc_string lfs_to_string(struct lfstack *_stack_);
+_Bool lfs_print(struct lfstack *_stack_, FILE *fptr);
+static struct lfstack_node *lfs_impl_node(struct lfstack *_stack_,
+                                          uint32_t ref);
+static size_t lfs_impl_pop_chain(struct lfstack *_stack_, _Atomic uint64_t *top,
+                                 size_t n, uint32_t *first, uint32_t *last);
+static void lfs_impl_push_chain(struct lfstack *_stack_, _Atomic uint64_t *top,
+                                uint32_t first, uint32_t last);
+static _Bool lfs_impl_alloc_chain(struct lfstack *_stack_, size_t n,
+                                  uint32_t *first, uint32_t *last);
+struct lfstack *lfs_new(size_t capacity, struct lfstack_fval *f_val)
+{
+    return lfs_new_custom(capacity, f_val, ((void *)0), ((void *)0));
+}
+struct lfstack *lfs_new_custom(size_t capacity, struct lfstack_fval *f_val,
+                               struct cmc_alloc_node *alloc,
+                               struct cmc_callbacks *callbacks)
+{
+    if (capacity < 1 || capacity > (4294967295U) - 1)
+        return ((void *)0);
+    if (!f_val)
+        return ((void *)0);
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+    size_t chunk_size = 16;
+    while (chunk_size < capacity)
+        chunk_size *= 2;
+    struct lfstack *_stack_ = alloc->malloc(sizeof(struct lfstack));
+    if (!_stack_)
+        return ((void *)0);
+    struct lfstack_node *chunk =
+        alloc->malloc(chunk_size * sizeof(struct lfstack_node));
+    if (!chunk)
+    {
+        alloc->free(_stack_);
+        return ((void *)0);
+    }
+    __extension__({
+        __auto_type __atomic_store_ptr = (&_stack_->head);
+        __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp = (0);
+        __atomic_store(__atomic_store_ptr, &__atomic_store_tmp, (0));
+    });
+    __extension__({
+        __auto_type __atomic_store_ptr = (&_stack_->free_head);
+        __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp = (0);
+        __atomic_store(__atomic_store_ptr, &__atomic_store_tmp, (0));
+    });
+    __extension__({
+        __auto_type __atomic_store_ptr = (&_stack_->nodes);
+        __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp = (0);
+        __atomic_store(__atomic_store_ptr, &__atomic_store_tmp, (0));
+    });
+    __extension__({
+        __auto_type __atomic_store_ptr = (&_stack_->chunks[0]);
+        __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp = (chunk);
+        __atomic_store(__atomic_store_ptr, &__atomic_store_tmp, (0));
+    });
+    for (size_t i = 1; i < 32; i++)
+        __extension__({
+            __auto_type __atomic_store_ptr = (&_stack_->chunks[i]);
+            __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp =
+                (((void *)0));
+            __atomic_store(__atomic_store_ptr, &__atomic_store_tmp, (0));
+        });
+    _stack_->chunk_size = chunk_size;
+    _stack_->flag = cmc_flags.OK;
+    _stack_->f_val = f_val;
+    _stack_->alloc = alloc;
+    _stack_->callbacks = callbacks;
+    return _stack_;
+}
+void lfs_clear(struct lfstack *_stack_)
+{
+    uint64_t head = __extension__({
+        __auto_type __atomic_load_ptr = (&_stack_->head);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    uint32_t ref = (uint32_t)head;
+    uint32_t last = 0;
+    if (ref != 0)
+    {
+        for (uint32_t r = ref; r != 0;)
+        {
+            struct lfstack_node *node = lfs_impl_node(_stack_, r);
+            if (_stack_->f_val->free)
+                _stack_->f_val->free(node->value);
+            last = r;
+            r = __extension__({
+                __auto_type __atomic_load_ptr = (&node->next);
+                __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+                __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                              (memory_order_relaxed));
+                __atomic_load_tmp;
+            });
+        }
+        lfs_impl_push_chain(_stack_, &_stack_->free_head, ref, last);
+        __extension__({
+            __auto_type __atomic_store_ptr = (&_stack_->head);
+            __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp =
+                (((head >> 32) + 1) << 32);
+            __atomic_store(__atomic_store_ptr, &__atomic_store_tmp,
+                           (memory_order_relaxed));
+        });
+    }
+    _stack_->flag = cmc_flags.OK;
+}
+void lfs_free(struct lfstack *_stack_)
+{
+    if (_stack_->f_val->free)
+    {
+        uint64_t head = __extension__({
+            __auto_type __atomic_load_ptr = (&_stack_->head);
+            __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+            __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                          (memory_order_relaxed));
+            __atomic_load_tmp;
+        });
+        for (uint32_t r = (uint32_t)head; r != 0;)
+        {
+            struct lfstack_node *node = lfs_impl_node(_stack_, r);
+            _stack_->f_val->free(node->value);
+            r = __extension__({
+                __auto_type __atomic_load_ptr = (&node->next);
+                __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+                __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                              (memory_order_relaxed));
+                __atomic_load_tmp;
+            });
+        }
+    }
+    for (size_t i = 0; i < 32; i++)
+    {
+        struct lfstack_node *chunk = __extension__(
+            {
+                __auto_type __atomic_load_ptr = (&_stack_->chunks[i]);
+                __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+                __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                              (memory_order_relaxed));
+                __atomic_load_tmp;
+            });
+        if (chunk)
+            _stack_->alloc->free(chunk);
+    }
+    _stack_->alloc->free(_stack_);
+}
+void lfs_customize(struct lfstack *_stack_, struct cmc_alloc_node *alloc,
+                   struct cmc_callbacks *callbacks)
+{
+    if (!alloc)
+        _stack_->alloc = &cmc_alloc_node_default;
+    else
+        _stack_->alloc = alloc;
+    _stack_->callbacks = callbacks;
+    _stack_->flag = cmc_flags.OK;
+}
+_Bool lfs_push(struct lfstack *_stack_, size_t value)
+{
+    uint32_t ref, last;
+    if (!lfs_impl_alloc_chain(_stack_, 1, &ref, &last))
+        return 0;
+    lfs_impl_node(_stack_, ref)->value = value;
+    lfs_impl_push_chain(_stack_, &_stack_->head, ref, ref);
+    if (_stack_->callbacks && _stack_->callbacks->create)
+        _stack_->callbacks->create();
+    return 1;
+}
+_Bool lfs_pop(struct lfstack *_stack_, size_t *out)
+{
+    uint32_t ref, last;
+    if (lfs_impl_pop_chain(_stack_, &_stack_->head, 1, &ref, &last) == 0)
+        return 0;
+    if (out)
+        *out = lfs_impl_node(_stack_, ref)->value;
+    lfs_impl_push_chain(_stack_, &_stack_->free_head, ref, ref);
+    if (_stack_->callbacks && _stack_->callbacks->delete)
+        _stack_->callbacks->delete ();
+    return 1;
+}
+_Bool lfs_push_n(struct lfstack *_stack_, size_t *values, size_t n)
+{
+    if (n == 0)
+        return 1;
+    uint32_t first, last;
+    if (!lfs_impl_alloc_chain(_stack_, n, &first, &last))
+        return 0;
+    uint32_t ref = first;
+    for (size_t i = n; i > 0; i--)
+    {
+        struct lfstack_node *node = lfs_impl_node(_stack_, ref);
+        node->value = values[i - 1];
+        ref = __extension__({
+            __auto_type __atomic_load_ptr = (&node->next);
+            __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+            __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                          (memory_order_relaxed));
+            __atomic_load_tmp;
+        });
+    }
+    lfs_impl_push_chain(_stack_, &_stack_->head, first, last);
+    if (_stack_->callbacks && _stack_->callbacks->create)
+        _stack_->callbacks->create();
+    return 1;
+}
+size_t lfs_pop_n(struct lfstack *_stack_, size_t *out, size_t n)
+{
+    uint32_t first, last;
+    size_t count =
+        lfs_impl_pop_chain(_stack_, &_stack_->head, n, &first, &last);
+    if (count == 0)
+        return 0;
+    if (out)
+    {
+        uint32_t ref = first;
+        for (size_t i = 0; i < count; i++)
+        {
+            struct lfstack_node *node = lfs_impl_node(_stack_, ref);
+            out[i] = node->value;
+            ref = __extension__({
+                __auto_type __atomic_load_ptr = (&node->next);
+                __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+                __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                              (memory_order_relaxed));
+                __atomic_load_tmp;
+            });
+        }
+    }
+    lfs_impl_push_chain(_stack_, &_stack_->free_head, first, last);
+    if (_stack_->callbacks && _stack_->callbacks->delete)
+        _stack_->callbacks->delete ();
+    return count;
+}
+size_t lfs_pop_all(struct lfstack *_stack_, void (*consume)(size_t, void *),
+                   void *args)
+{
+    uint64_t head = __extension__({
+        __auto_type __atomic_load_ptr = (&_stack_->head);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_acquire));
+        __atomic_load_tmp;
+    });
+    do
+    {
+        if ((uint32_t)head == 0)
+            return 0;
+    } while (!__extension__({
+        __auto_type __atomic_compare_exchange_ptr = (&_stack_->head);
+        __typeof__((void)0, *__atomic_compare_exchange_ptr)
+            __atomic_compare_exchange_tmp = (((head >> 32) + 1) << 32);
+        __atomic_compare_exchange(__atomic_compare_exchange_ptr, (&head),
+                                  &__atomic_compare_exchange_tmp, 1,
+                                  (memory_order_acquire),
+                                  (memory_order_acquire));
+    }));
+    uint32_t first = (uint32_t)head;
+    uint32_t last = 0;
+    size_t count = 0;
+    for (uint32_t ref = first; ref != 0; count++)
+    {
+        struct lfstack_node *node = lfs_impl_node(_stack_, ref);
+        if (consume)
+            consume(node->value, args);
+        last = ref;
+        ref = __extension__({
+            __auto_type __atomic_load_ptr = (&node->next);
+            __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+            __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                          (memory_order_relaxed));
+            __atomic_load_tmp;
+        });
+    }
+    lfs_impl_push_chain(_stack_, &_stack_->free_head, first, last);
+    if (_stack_->callbacks && _stack_->callbacks->delete)
+        _stack_->callbacks->delete ();
+    return count;
+}
+void lfs_mag_init(struct lfstack_magazine *mag, struct lfstack *target)
+{
+    mag->target = target;
+    mag->count = 0;
+}
+_Bool lfs_mag_push(struct lfstack_magazine *mag, size_t value)
+{
+    if (mag->count == 32)
+    {
+        size_t half = 32 / 2;
+        if (!lfs_push_n(mag->target, mag->values + half, 32 - half))
+            return 0;
+        mag->count = half;
+    }
+    mag->values[mag->count++] = value;
+    return 1;
+}
+_Bool lfs_mag_pop(struct lfstack_magazine *mag, size_t *out)
+{
+    if (mag->count == 0)
+    {
+        mag->count = lfs_pop_n(mag->target, mag->values, 32 / 2);
+        if (mag->count == 0)
+            return 0;
+    }
+    mag->count--;
+    if (out)
+        *out = mag->values[mag->count];
+    return 1;
+}
+_Bool lfs_mag_flush(struct lfstack_magazine *mag)
+{
+    if (!lfs_push_n(mag->target, mag->values, mag->count))
+        return 0;
+    mag->count = 0;
+    return 1;
+}
+_Bool lfs_empty(struct lfstack *_stack_)
+{
+    return (uint32_t) __extension__({
+               __auto_type __atomic_load_ptr = (&_stack_->head);
+               __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+               __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                             (memory_order_acquire));
+               __atomic_load_tmp;
+           }) == 0;
+}
+int lfs_flag(struct lfstack *_stack_)
+{
+    return _stack_->flag;
+}
+struct cmc_string lfs_to_string(struct lfstack *_stack_)
+{
+    struct cmc_string str;
+    struct lfstack *s_ = _stack_;
+    int n =
+        snprintf(str.s, cmc_string_len, cmc_string_fmt_lfstack, "lfstack",
+                 "size_t", s_, (uintmax_t)(uint32_t) __extension__({
+                     __auto_type __atomic_load_ptr = (&s_->head);
+                     __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+                     __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                                   (memory_order_relaxed));
+                     __atomic_load_tmp;
+                 }),
+                 (uintmax_t)(uint32_t) __extension__({
+                     __auto_type __atomic_load_ptr = (&s_->free_head);
+                     __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+                     __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                                   (memory_order_relaxed));
+                     __atomic_load_tmp;
+                 }),
+                 (uintmax_t) __extension__({
+                     __auto_type __atomic_load_ptr = (&s_->nodes);
+                     __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+                     __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                                   (memory_order_relaxed));
+                     __atomic_load_tmp;
+                 }),
+                 s_->chunk_size, s_->flag, s_->f_val, s_->alloc, s_->callbacks);
+    return n >= 0 ? str : (struct cmc_string){ 0 };
+}
+_Bool lfs_print(struct lfstack *_stack_, FILE *fptr)
+{
+    uint64_t head = __extension__({
+        __auto_type __atomic_load_ptr = (&_stack_->head);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    for (uint32_t ref = (uint32_t)head; ref != 0;)
+    {
+        struct lfstack_node *node = lfs_impl_node(_stack_, ref);
+        if (!_stack_->f_val->str(fptr, node->value))
+            return 0;
+        ref = __extension__({
+            __auto_type __atomic_load_ptr = (&node->next);
+            __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+            __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                          (memory_order_relaxed));
+            __atomic_load_tmp;
+        });
+    }
+    return 1;
+}
+static struct lfstack_node *lfs_impl_node(struct lfstack *_stack_, uint32_t ref)
+{
+    size_t index = ref - 1;
+    size_t size = _stack_->chunk_size;
+    size_t k = 0;
+    while (index >= size)
+    {
+        index -= size;
+        size *= 2;
+        k++;
+    }
+    return __extension__({
+               __auto_type __atomic_load_ptr = (&_stack_->chunks[k]);
+               __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+               __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                             (memory_order_acquire));
+               __atomic_load_tmp;
+           }) +
+           index;
+}
+static size_t lfs_impl_pop_chain(struct lfstack *_stack_, _Atomic uint64_t *top,
+                                 size_t n, uint32_t *first, uint32_t *last)
+{
+    if (n == 0)
+        return 0;
+    uint64_t old = __extension__({
+        __auto_type __atomic_load_ptr = (top);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_acquire));
+        __atomic_load_tmp;
+    });
+    for (;;)
+    {
+        uint32_t ref = (uint32_t)old;
+        if (ref == 0)
+            return 0;
+        uint32_t end = ref;
+        size_t count = 1;
+        uint32_t next = __extension__({
+            __auto_type __atomic_load_ptr =
+                (&lfs_impl_node(_stack_, end)->next);
+            __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+            __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                          (memory_order_acquire));
+            __atomic_load_tmp;
+        });
+        while (count < n && next != 0)
+        {
+            end = next;
+            count++;
+            next = __extension__({
+                __auto_type __atomic_load_ptr =
+                    (&lfs_impl_node(_stack_, end)->next);
+                __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+                __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                              (memory_order_acquire));
+                __atomic_load_tmp;
+            });
+        }
+        uint64_t new_top = (((old >> 32) + 1) << 32) | next;
+        if (__extension__({
+                __auto_type __atomic_compare_exchange_ptr = (top);
+                __typeof__((void)0, *__atomic_compare_exchange_ptr)
+                    __atomic_compare_exchange_tmp = (new_top);
+                __atomic_compare_exchange(__atomic_compare_exchange_ptr, (&old),
+                                          &__atomic_compare_exchange_tmp, 1,
+                                          (memory_order_acquire),
+                                          (memory_order_acquire));
+            }))
+        {
+            *first = ref;
+            *last = end;
+            return count;
+        }
+    }
+}
+static void lfs_impl_push_chain(struct lfstack *_stack_, _Atomic uint64_t *top,
+                                uint32_t first, uint32_t last)
+{
+    struct lfstack_node *node = lfs_impl_node(_stack_, last);
+    uint64_t old = __extension__({
+        __auto_type __atomic_load_ptr = (top);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    uint64_t new_top;
+    do
+    {
+        __extension__({
+            __auto_type __atomic_store_ptr = (&node->next);
+            __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp =
+                ((uint32_t)old);
+            __atomic_store(__atomic_store_ptr, &__atomic_store_tmp,
+                           (memory_order_release));
+        });
+        new_top = (((old >> 32) + 1) << 32) | first;
+    } while (!__extension__({
+        __auto_type __atomic_compare_exchange_ptr = (top);
+        __typeof__((void)0, *__atomic_compare_exchange_ptr)
+            __atomic_compare_exchange_tmp = (new_top);
+        __atomic_compare_exchange(__atomic_compare_exchange_ptr, (&old),
+                                  &__atomic_compare_exchange_tmp, 1,
+                                  (memory_order_release),
+                                  (memory_order_relaxed));
+    }));
+}
+static _Bool lfs_impl_alloc_chain(struct lfstack *_stack_, size_t n,
+                                  uint32_t *first, uint32_t *last)
+{
+    size_t count =
+        lfs_impl_pop_chain(_stack_, &_stack_->free_head, n, first, last);
+    if (count == n)
+        return 1;
+    size_t m = n - count;
+    size_t start =
+        __atomic_fetch_add((&_stack_->nodes), (m), (memory_order_relaxed));
+    size_t reserved = start + m;
+    if (start + m > (4294967295U) - 1 || start + m < start)
+        goto error;
+    size_t begin = 0;
+    size_t size = _stack_->chunk_size;
+    for (size_t k = 0; begin < start + m; k++)
+    {
+        if (begin + size > start && !__extension__({
+                __auto_type __atomic_load_ptr = (&_stack_->chunks[k]);
+                __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+                __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                              (memory_order_acquire));
+                __atomic_load_tmp;
+            }))
+        {
+            struct lfstack_node *chunk =
+                _stack_->alloc->malloc(size * sizeof(struct lfstack_node));
+            if (!chunk)
+                goto error;
+            struct lfstack_node *expected = ((void *)0);
+            if (!__extension__({
+                    __auto_type __atomic_compare_exchange_ptr =
+                        (&_stack_->chunks[k]);
+                    __typeof__((void)0, *__atomic_compare_exchange_ptr)
+                        __atomic_compare_exchange_tmp = (chunk);
+                    __atomic_compare_exchange(
+                        __atomic_compare_exchange_ptr, (&expected),
+                        &__atomic_compare_exchange_tmp, 0,
+                        (memory_order_release), (memory_order_acquire));
+                }))
+                _stack_->alloc->free(chunk);
+        }
+        begin += size;
+        size *= 2;
+    }
+    for (size_t i = 0; i < m; i++)
+    {
+        uint32_t ref = (uint32_t)(start + i + 1);
+        __extension__({
+            __auto_type __atomic_store_ptr =
+                (&lfs_impl_node(_stack_, ref)->next);
+            __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp =
+                (i + 1 < m ? ref + 1 : 0);
+            __atomic_store(__atomic_store_ptr, &__atomic_store_tmp,
+                           (memory_order_relaxed));
+        });
+    }
+    if (count == 0)
+        *first = (uint32_t)(start + 1);
+    else
+        __extension__({
+            __auto_type __atomic_store_ptr =
+                (&lfs_impl_node(_stack_, *last)->next);
+            __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp =
+                ((uint32_t)(start + 1));
+            __atomic_store(__atomic_store_ptr, &__atomic_store_tmp,
+                           (memory_order_release));
+        });
+    *last = (uint32_t)(start + m);
+    return 1;
+error:
+    __extension__({
+        __auto_type __atomic_compare_exchange_ptr = (&_stack_->nodes);
+        __typeof__((void)0, *__atomic_compare_exchange_ptr)
+            __atomic_compare_exchange_tmp = (start);
+        __atomic_compare_exchange(__atomic_compare_exchange_ptr, (&reserved),
+                                  &__atomic_compare_exchange_tmp, 0,
+                                  (memory_order_relaxed),
+                                  (memory_order_relaxed));
+    });
+    if (count > 0)
+        lfs_impl_push_chain(_stack_, &_stack_->free_head, *first, *last);
+    return 0;
+}
+
+#endif /* CMC_TEST_SRC_LFSTACK */
@@ -12,6 +12,9 @@ struct linkedlist
     struct linkedlist_fval *f_val;
     struct cmc_alloc_node *alloc;
     struct cmc_callbacks *callbacks;
+    struct linkedlist_node *pool;
+    struct linkedlist_chunk *chunks;
+    size_t chunk_size;
 };
 struct linkedlist_node
 {
@@ -19,6 +22,11 @@ struct linkedlist_node
     struct linkedlist_node *next;
     struct linkedlist_node *prev;
 };
+struct linkedlist_chunk
+{
+    struct linkedlist_chunk *next;
+    struct linkedlist_node nodes[];
+};
 struct linkedlist_fval
 {
     int (*cmp)(size_t, size_t);
@@ -44,6 +52,7 @@ void ll_clear(struct linkedlist *_list_);
 void ll_free(struct linkedlist *_list_);
 void ll_customize(struct linkedlist *_list_, struct cmc_alloc_node *alloc,
                   struct cmc_callbacks *callbacks);
+_Bool ll_set_pool(struct linkedlist *_list_, size_t chunk_size);
 _Bool ll_push_front(struct linkedlist *_list_, size_t value);
 _Bool ll_push_at(struct linkedlist *_list_, size_t value, size_t index);
 _Bool ll_push_back(struct linkedlist *_list_, size_t value);
@@ -91,6 +100,7 @@ size_t ll_iter_value(struct linkedlist_iter *iter);
 size_t *ll_iter_rvalue(struct linkedlist_iter *iter);
 size_t ll_iter_index(struct linkedlist_iter *iter);
 struct linkedlist_node *ll_iter_node(struct linkedlist_iter *iter);
+static void ll_impl_release_chunks(struct linkedlist *_list_);
 struct linkedlist *ll_new(struct linkedlist_fval *f_val)
 {
     if (!f_val)
@@ -106,6 +116,9 @@ struct linkedlist *ll_new(struct linkedlist_fval *f_val)
     _list_->f_val = f_val;
     _list_->alloc = alloc;
     _list_->callbacks = ((void *)0);
+    _list_->pool = ((void *)0);
+    _list_->chunks = ((void *)0);
+    _list_->chunk_size = 0;
     return _list_;
 }
 struct linkedlist *ll_new_custom(struct linkedlist_fval *f_val,
@@ -126,10 +139,32 @@ struct linkedlist *ll_new_custom(struct linkedlist_fval *f_val,
     _list_->f_val = f_val;
     _list_->alloc = alloc;
     _list_->callbacks = callbacks;
+    _list_->pool = ((void *)0);
+    _list_->chunks = ((void *)0);
+    _list_->chunk_size = 0;
     return _list_;
 }
 void ll_clear(struct linkedlist *_list_)
 {
+    if (_list_->chunk_size > 0)
+    {
+        if (_list_->f_val->free)
+        {
+            for (struct linkedlist_node *scan = _list_->head;
+                 scan != ((void *)0); scan = scan->next)
+                _list_->f_val->free(scan->value);
+        }
+        if (_list_->tail != ((void *)0))
+        {
+            _list_->tail->next = _list_->pool;
+            _list_->pool = _list_->head;
+        }
+        _list_->count = 0;
+        _list_->head = ((void *)0);
+        _list_->tail = ((void *)0);
+        _list_->flag = cmc_flags.OK;
+        return;
+    }
     struct linkedlist_node *scan = _list_->head;
     while (_list_->head != ((void *)0))
     {
@@ -149,6 +184,7 @@ void ll_clear(struct linkedlist *_list_)
 void ll_free(struct linkedlist *_list_)
 {
     ll_clear(_list_);
+    ll_impl_release_chunks(_list_);
     _list_->alloc->free(_list_);
 }
 void ll_customize(struct linkedlist *_list_, struct cmc_alloc_node *alloc,
@@ -161,6 +197,25 @@ void ll_customize(struct linkedlist *_list_, struct cmc_alloc_node *alloc,
     _list_->callbacks = callbacks;
     _list_->flag = cmc_flags.OK;
 }
+_Bool ll_set_pool(struct linkedlist *_list_, size_t chunk_size)
+{
+    if (!ll_empty(_list_))
+    {
+        _list_->flag = cmc_flags.INVALID;
+        return 0;
+    }
+    if (chunk_size >
+        ((18446744073709551615UL) - sizeof(struct linkedlist_chunk)) /
+            sizeof(struct linkedlist_node))
+    {
+        _list_->flag = cmc_flags.ERROR;
+        return 0;
+    }
+    ll_impl_release_chunks(_list_);
+    _list_->chunk_size = chunk_size;
+    _list_->flag = cmc_flags.OK;
+    return 1;
+}
 _Bool ll_push_front(struct linkedlist *_list_, size_t value)
 {
     struct linkedlist_node *_node_ = ll_new_node(_list_, value);
@@ -243,7 +298,7 @@ _Bool ll_pop_front(struct linkedlist *_list_)
     }
     struct linkedlist_node *_node_ = _list_->head;
     _list_->head = _list_->head->next;
-    _list_->alloc->free(_node_);
+    ll_free_node(_list_, _node_);
     if (_list_->head == ((void *)0))
         _list_->tail = ((void *)0);
     else
@@ -279,7 +334,7 @@ _Bool ll_pop_at(struct linkedlist *_list_, size_t index)
         return 0;
     _node_->next->prev = _node_->prev;
     _node_->prev->next = _node_->next;
-    _list_->alloc->free(_node_);
+    ll_free_node(_list_, _node_);
     _list_->count--;
     _list_->flag = cmc_flags.OK;
     if (_list_->callbacks && _list_->callbacks->delete)
@@ -295,7 +350,7 @@ _Bool ll_pop_back(struct linkedlist *_list_)
     }
     struct linkedlist_node *_node_ = _list_->tail;
     _list_->tail = _list_->tail->prev;
-    _list_->alloc->free(_node_);
+    ll_free_node(_list_, _node_);
     if (_list_->tail == ((void *)0))
         _list_->head = ((void *)0);
     else
@@ -404,14 +459,15 @@ struct linkedlist *ll_copy_of(struct linkedlist *_list_)
         ll_new_custom(_list_->f_val, _list_->alloc, _list_->callbacks);
     if (!result)
         return ((void *)0);
+    ll_set_pool(result, _list_->chunk_size);
     struct linkedlist_node *scan = _list_->head;
     while (scan != ((void *)0))
     {
         struct linkedlist_node *new_node;
         if (_list_->f_val->cpy)
-            new_node = ll_new_node(_list_, _list_->f_val->cpy(scan->value));
+            new_node = ll_new_node(result, _list_->f_val->cpy(scan->value));
         else
-            new_node = ll_new_node(_list_, scan->value);
+            new_node = ll_new_node(result, scan->value);
         if (!result->head)
         {
             result->head = new_node;
@@ -468,12 +524,38 @@ _Bool ll_print(struct linkedlist *_list_, FILE *fptr)
 }
 struct linkedlist_node *ll_new_node(struct linkedlist *_list_, size_t value)
 {
-    struct linkedlist_node *_node_ =
-        _list_->alloc->malloc(sizeof(struct linkedlist_node));
-    if (!_node_)
+    struct linkedlist_node *_node_;
+    if (_list_->chunk_size == 0)
     {
-        _list_->flag = cmc_flags.ALLOC;
-        return ((void *)0);
+        _node_ = _list_->alloc->malloc(sizeof(struct linkedlist_node));
+        if (!_node_)
+        {
+            _list_->flag = cmc_flags.ALLOC;
+            return ((void *)0);
+        }
+    }
+    else
+    {
+        if (!_list_->pool)
+        {
+            struct linkedlist_chunk *chunk = _list_->alloc->malloc(
+                sizeof(struct linkedlist_chunk) +
+                sizeof(struct linkedlist_node) * _list_->chunk_size);
+            if (!chunk)
+            {
+                _list_->flag = cmc_flags.ALLOC;
+                return ((void *)0);
+            }
+            chunk->next = _list_->chunks;
+            _list_->chunks = chunk;
+            for (size_t i = _list_->chunk_size; i > 0; i--)
+            {
+                chunk->nodes[i - 1].next = _list_->pool;
+                _list_->pool = &chunk->nodes[i - 1];
+            }
+        }
+        _node_ = _list_->pool;
+        _list_->pool = _node_->next;
     }
     _node_->value = value;
     _node_->next = ((void *)0);
@@ -482,7 +564,13 @@ struct linkedlist_node *ll_new_node(struct linkedlist *_list_, size_t value)
 }
 void ll_free_node(struct linkedlist *_list_, struct linkedlist_node *_node_)
 {
-    _list_->alloc->free(_node_);
+    if (_list_->chunk_size == 0)
+        _list_->alloc->free(_node_);
+    else
+    {
+        _node_->next = _list_->pool;
+        _list_->pool = _node_;
+    }
 }
 struct linkedlist_node *ll_head(struct linkedlist *_list_)
 {
@@ -571,7 +659,7 @@ _Bool ll_del_next(struct linkedlist *_owner_, struct linkedlist_node *_node_)
         tmp->next->prev = _node_;
     else
         _owner_->tail = _node_;
-    _owner_->alloc->free(tmp);
+    ll_free_node(_owner_, tmp);
     _owner_->count--;
     _owner_->flag = cmc_flags.OK;
     return 1;
@@ -586,7 +674,7 @@ _Bool ll_del_curr(struct linkedlist *_owner_, struct linkedlist_node *_node_)
         _node_->next->prev = _node_->prev;
     else
         _owner_->tail = _node_->prev;
-    _owner_->alloc->free(_node_);
+    ll_free_node(_owner_, _node_);
     _owner_->count--;
     _owner_->flag = cmc_flags.OK;
     return 1;
@@ -604,7 +692,7 @@ _Bool ll_del_prev(struct linkedlist *_owner_, struct linkedlist_node *_node_)
         tmp->prev->next = _node_;
     else
         _owner_->head = _node_;
-    _owner_->alloc->free(tmp);
+    ll_free_node(_owner_, tmp);
     _owner_->count--;
     _owner_->flag = cmc_flags.OK;
     return 1;
@@ -763,5 +851,17 @@ struct linkedlist_node *ll_iter_node(struct linkedlist_iter *iter)
 {
     return iter->cursor;
 }
+static void ll_impl_release_chunks(struct linkedlist *_list_)
+{
+    struct linkedlist_chunk *chunk = _list_->chunks;
+    while (chunk != ((void *)0))
+    {
+        struct linkedlist_chunk *next = chunk->next;
+        _list_->alloc->free(chunk);
+        chunk = next;
+    }
+    _list_->pool = ((void *)0);
+    _list_->chunks = ((void *)0);
+}
 
 #endif /* CMC_TEST_SRC_LINKEDLIST */
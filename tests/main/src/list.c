@@ -12,6 +12,7 @@ struct list
     struct list_fval *f_val;
     struct cmc_alloc_node *alloc;
     struct cmc_callbacks *callbacks;
+    const struct cmc_growth *growth;
 };
 struct list_fval
 {
@@ -37,6 +38,7 @@ void l_clear(struct list *_list_);
 void l_free(struct list *_list_);
 void l_customize(struct list *_list_, struct cmc_alloc_node *alloc,
                  struct cmc_callbacks *callbacks);
+void l_set_growth(struct list *_list_, const struct cmc_growth *growth);
 _Bool l_push_front(struct list *_list_, size_t value);
 _Bool l_push_at(struct list *_list_, size_t value, size_t index);
 _Bool l_push_back(struct list *_list_, size_t value);
@@ -62,6 +64,10 @@ _Bool l_fits(struct list *_list_, size_t size);
 size_t l_capacity(struct list *_list_);
 int l_flag(struct list *_list_);
 _Bool l_resize(struct list *_list_, size_t capacity);
+_Bool l_reserve(struct list *_list_, size_t size);
+_Bool l_shrink_to_fit(struct list *_list_);
+void l_sort(struct list *_list_);
+_Bool l_sort_range(struct list *_list_, size_t from, size_t to);
 struct list *l_copy_of(struct list *_list_);
 _Bool l_equals(struct list *_list1_, struct list *_list2_);
 struct cmc_string l_to_string(struct list *_list_);
@@ -80,6 +86,28 @@ _Bool l_iter_go_to(struct list_iter *iter, size_t index);
 size_t l_iter_value(struct list_iter *iter);
 size_t *l_iter_rvalue(struct list_iter *iter);
 size_t l_iter_index(struct list_iter *iter);
+static inline size_t l_impl_search(size_t *array, size_t count, size_t value,
+                                   int (*cmp)(size_t, size_t))
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (cmp(array[i], value) == 0)
+            return i;
+    }
+    return count;
+}
+static inline size_t l_impl_search_last(size_t *array, size_t count,
+                                        size_t value,
+                                        int (*cmp)(size_t, size_t))
+{
+    for (size_t i = count; i > 0; i--)
+    {
+        if (cmp(array[i - 1], value) == 0)
+            return i - 1;
+    }
+    return count;
+}
+static void l_impl_sort_array(struct list *_list_, size_t *array, size_t count);
 struct list *l_new(size_t capacity, struct list_fval *f_val)
 {
     struct cmc_alloc_node *alloc = &cmc_alloc_node_default;
@@ -100,6 +128,7 @@ struct list *l_new(size_t capacity, struct list_fval *f_val)
     _list_->f_val = f_val;
     _list_->alloc = alloc;
     _list_->callbacks = ((void *)0);
+    _list_->growth = ((void *)0);
     return _list_;
 }
 struct list *l_new_custom(size_t capacity, struct list_fval *f_val,
@@ -127,6 +156,7 @@ struct list *l_new_custom(size_t capacity, struct list_fval *f_val,
     _list_->f_val = f_val;
     _list_->alloc = alloc;
     _list_->callbacks = callbacks;
+    _list_->growth = ((void *)0);
     return _list_;
 }
 void l_clear(struct list *_list_)
@@ -160,11 +190,16 @@ void l_customize(struct list *_list_, struct cmc_alloc_node *alloc,
     _list_->callbacks = callbacks;
     _list_->flag = cmc_flags.OK;
 }
+void l_set_growth(struct list *_list_, const struct cmc_growth *growth)
+{
+    _list_->growth = growth;
+    _list_->flag = cmc_flags.OK;
+}
 _Bool l_push_front(struct list *_list_, size_t value)
 {
     if (l_full(_list_))
     {
-        if (!l_resize(_list_, _list_->count * 2))
+        if (!l_reserve(_list_, 1))
             return 0;
     }
     if (!l_empty(_list_))
@@ -188,7 +223,7 @@ _Bool l_push_at(struct list *_list_, size_t value, size_t index)
     }
     if (l_full(_list_))
     {
-        if (!l_resize(_list_, _list_->count * 2))
+        if (!l_reserve(_list_, 1))
             return 0;
     }
     memmove(_list_->buffer + index + 1, _list_->buffer + index,
@@ -204,7 +239,7 @@ _Bool l_push_back(struct list *_list_, size_t value)
 {
     if (l_full(_list_))
     {
-        if (!l_resize(_list_, _list_->count * 2))
+        if (!l_reserve(_list_, 1))
             return 0;
     }
     _list_->buffer[_list_->count++] = value;
@@ -267,7 +302,7 @@ _Bool l_seq_push_front(struct list *_list_, size_t *values, size_t size)
     }
     if (!l_fits(_list_, size))
     {
-        if (!l_resize(_list_, _list_->count + size))
+        if (!l_reserve(_list_, size))
             return 0;
     }
     memmove(_list_->buffer + size, _list_->buffer,
@@ -298,7 +333,7 @@ _Bool l_seq_push_at(struct list *_list_, size_t *values, size_t size,
         return l_seq_push_back(_list_, values, size);
     if (!l_fits(_list_, size))
     {
-        if (!l_resize(_list_, _list_->count + size))
+        if (!l_reserve(_list_, size))
             return 0;
     }
     memmove(_list_->buffer + index + size, _list_->buffer + index,
@@ -319,7 +354,7 @@ _Bool l_seq_push_back(struct list *_list_, size_t *values, size_t size)
     }
     if (!l_fits(_list_, size))
     {
-        if (!l_resize(_list_, _list_->count + size))
+        if (!l_reserve(_list_, size))
             return 0;
     }
     memcpy(_list_->buffer + _list_->count, values, size * sizeof(size_t));
@@ -443,29 +478,13 @@ size_t l_back(struct list *_list_)
 size_t l_index_of(struct list *_list_, size_t value, _Bool from_start)
 {
     _list_->flag = cmc_flags.OK;
-    size_t result = _list_->count;
+    size_t result;
     if (from_start)
-    {
-        for (size_t i = 0; i < _list_->count; i++)
-        {
-            if (_list_->f_val->cmp(_list_->buffer[i], value) == 0)
-            {
-                result = i;
-                break;
-            }
-        }
-    }
+        result = l_impl_search(_list_->buffer, _list_->count, value,
+                               _list_->f_val->cmp);
     else
-    {
-        for (size_t i = _list_->count; i > 0; i--)
-        {
-            if (_list_->f_val->cmp(_list_->buffer[i - 1], value) == 0)
-            {
-                result = i - 1;
-                break;
-            }
-        }
-    }
+        result = l_impl_search_last(_list_->buffer, _list_->count, value,
+                                    _list_->f_val->cmp);
     if (_list_->callbacks && _list_->callbacks->read)
         _list_->callbacks->read();
     return result;
@@ -473,15 +492,8 @@ size_t l_index_of(struct list *_list_, size_t value, _Bool from_start)
 _Bool l_contains(struct list *_list_, size_t value)
 {
     _list_->flag = cmc_flags.OK;
-    _Bool result = 0;
-    for (size_t i = 0; i < _list_->count; i++)
-    {
-        if (_list_->f_val->cmp(_list_->buffer[i], value) == 0)
-        {
-            result = 1;
-            break;
-        }
-    }
+    _Bool result = l_impl_search(_list_->buffer, _list_->count, value,
+                                 _list_->f_val->cmp) < _list_->count;
     if (_list_->callbacks && _list_->callbacks->read)
         _list_->callbacks->read();
     return result;
@@ -533,6 +545,49 @@ _Bool l_resize(struct list *_list_, size_t capacity)
         _list_->callbacks->resize();
     return 1;
 }
+_Bool l_reserve(struct list *_list_, size_t size)
+{
+    _list_->flag = cmc_flags.OK;
+    if (size <= _list_->capacity - _list_->count)
+        return 1;
+    if (size > (18446744073709551615UL) - _list_->count)
+    {
+        _list_->flag = cmc_flags.ERROR;
+        return 0;
+    }
+    return l_resize(_list_,
+                    cmc_growth_capacity(_list_->growth, _list_->capacity,
+                                        _list_->count + size));
+}
+_Bool l_shrink_to_fit(struct list *_list_)
+{
+    return l_resize(_list_, _list_->count > 0 ? _list_->count : 1);
+}
+void l_sort(struct list *_list_)
+{
+    l_impl_sort_array(_list_, _list_->buffer, _list_->count);
+    _list_->flag = cmc_flags.OK;
+    if (_list_->callbacks && _list_->callbacks->update)
+        _list_->callbacks->update();
+}
+_Bool l_sort_range(struct list *_list_, size_t from, size_t to)
+{
+    if (from > to)
+    {
+        _list_->flag = cmc_flags.INVALID;
+        return 0;
+    }
+    if (to >= _list_->count)
+    {
+        _list_->flag = cmc_flags.RANGE;
+        return 0;
+    }
+    l_impl_sort_array(_list_, _list_->buffer + from, to - from + 1);
+    _list_->flag = cmc_flags.OK;
+    if (_list_->callbacks && _list_->callbacks->update)
+        _list_->callbacks->update();
+    return 1;
+}
 struct list *l_copy_of(struct list *_list_)
 {
     struct list *result = l_new_custom(_list_->capacity, _list_->f_val,
@@ -550,6 +605,7 @@ struct list *l_copy_of(struct list *_list_)
     else
         memcpy(result->buffer, _list_->buffer, sizeof(size_t) * _list_->count);
     result->count = _list_->count;
+    result->growth = _list_->growth;
     _list_->flag = cmc_flags.OK;
     return result;
 }
@@ -716,5 +772,275 @@ size_t l_iter_index(struct list_iter *iter)
 {
     return iter->cursor;
 }
+static void l_impl_sort_swap(size_t *a, size_t *b)
+{
+    size_t tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+static void l_impl_sort_insertion(size_t *begin, size_t *end,
+                                  int (*cmp)(size_t, size_t))
+{
+    if (begin == end)
+        return;
+    for (size_t *cur = begin + 1; cur != end; cur++)
+    {
+        size_t *sift = cur;
+        size_t *sift_1 = cur - 1;
+        if (cmp(*sift, *sift_1) < 0)
+        {
+            size_t tmp = *sift;
+            do
+            {
+                *sift-- = *sift_1;
+            } while (sift != begin && cmp(tmp, *--sift_1) < 0);
+            *sift = tmp;
+        }
+    }
+}
+static void l_impl_sort_insertion_unguarded(size_t *begin, size_t *end,
+                                            int (*cmp)(size_t, size_t))
+{
+    if (begin == end)
+        return;
+    for (size_t *cur = begin + 1; cur != end; cur++)
+    {
+        size_t *sift = cur;
+        size_t *sift_1 = cur - 1;
+        if (cmp(*sift, *sift_1) < 0)
+        {
+            size_t tmp = *sift;
+            do
+            {
+                *sift-- = *sift_1;
+            } while (cmp(tmp, *--sift_1) < 0);
+            *sift = tmp;
+        }
+    }
+}
+static _Bool l_impl_sort_insertion_partial(size_t *begin, size_t *end,
+                                           int (*cmp)(size_t, size_t))
+{
+    if (begin == end)
+        return 1;
+    size_t moves = 0;
+    for (size_t *cur = begin + 1; cur != end; cur++)
+    {
+        size_t *sift = cur;
+        size_t *sift_1 = cur - 1;
+        if (cmp(*sift, *sift_1) < 0)
+        {
+            size_t tmp = *sift;
+            do
+            {
+                *sift-- = *sift_1;
+            } while (sift != begin && cmp(tmp, *--sift_1) < 0);
+            *sift = tmp;
+            moves += (size_t)(cur - sift);
+        }
+        if (moves > 8)
+            return 0;
+    }
+    return 1;
+}
+static void l_impl_sort_heapsort_sift(size_t *array, size_t root, size_t count,
+                                      int (*cmp)(size_t, size_t))
+{
+    size_t value = array[root];
+    while (root * 2 + 1 < count)
+    {
+        size_t child = root * 2 + 1;
+        if (child + 1 < count && cmp(array[child], array[child + 1]) < 0)
+            child++;
+        if (cmp(value, array[child]) >= 0)
+            break;
+        array[root] = array[child];
+        root = child;
+    }
+    array[root] = value;
+}
+static void l_impl_sort_heapsort(size_t *begin, size_t *end,
+                                 int (*cmp)(size_t, size_t))
+{
+    size_t count = (size_t)(end - begin);
+    for (size_t i = count / 2; i > 0; i--)
+        l_impl_sort_heapsort_sift(begin, i - 1, count, cmp);
+    for (size_t i = count; i > 1; i--)
+    {
+        l_impl_sort_swap(begin, begin + i - 1);
+        l_impl_sort_heapsort_sift(begin, 0, i - 1, cmp);
+    }
+}
+static void l_impl_sort_sort2(size_t *a, size_t *b, int (*cmp)(size_t, size_t))
+{
+    if (cmp(*b, *a) < 0)
+        l_impl_sort_swap(a, b);
+}
+static void l_impl_sort_sort3(size_t *a, size_t *b, size_t *c,
+                              int (*cmp)(size_t, size_t))
+{
+    l_impl_sort_sort2(a, b, cmp);
+    l_impl_sort_sort2(b, c, cmp);
+    l_impl_sort_sort2(a, b, cmp);
+}
+static size_t *l_impl_sort_partition_right(size_t *begin, size_t *end,
+                                           int (*cmp)(size_t, size_t),
+                                           _Bool *already_partitioned)
+{
+    size_t pivot = *begin;
+    size_t *first = begin;
+    size_t *last = end;
+    while (cmp(*++first, pivot) < 0)
+        ;
+    if (first - 1 == begin)
+    {
+        while (first < last && cmp(*--last, pivot) >= 0)
+            ;
+    }
+    else
+    {
+        while (cmp(*--last, pivot) >= 0)
+            ;
+    }
+    *already_partitioned = first >= last;
+    while (first < last)
+    {
+        l_impl_sort_swap(first, last);
+        while (cmp(*++first, pivot) < 0)
+            ;
+        while (cmp(*--last, pivot) >= 0)
+            ;
+    }
+    size_t *pivot_pos = first - 1;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+static size_t *l_impl_sort_partition_left(size_t *begin, size_t *end,
+                                          int (*cmp)(size_t, size_t))
+{
+    size_t pivot = *begin;
+    size_t *first = begin;
+    size_t *last = end;
+    while (cmp(pivot, *--last) < 0)
+        ;
+    if (last + 1 == end)
+    {
+        while (first < last && cmp(pivot, *++first) >= 0)
+            ;
+    }
+    else
+    {
+        while (cmp(pivot, *++first) >= 0)
+            ;
+    }
+    while (first < last)
+    {
+        l_impl_sort_swap(first, last);
+        while (cmp(pivot, *--last) < 0)
+            ;
+        while (cmp(pivot, *++first) >= 0)
+            ;
+    }
+    size_t *pivot_pos = last;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+static void l_impl_sort_pdqsort(size_t *begin, size_t *end,
+                                int (*cmp)(size_t, size_t), size_t bad_allowed,
+                                _Bool leftmost)
+{
+    while (1)
+    {
+        size_t size = (size_t)(end - begin);
+        if (size < 24)
+        {
+            if (leftmost)
+                l_impl_sort_insertion(begin, end, cmp);
+            else
+                l_impl_sort_insertion_unguarded(begin, end, cmp);
+            return;
+        }
+        size_t s2 = size / 2;
+        if (size > 128)
+        {
+            l_impl_sort_sort3(begin, begin + s2, end - 1, cmp);
+            l_impl_sort_sort3(begin + 1, begin + (s2 - 1), end - 2, cmp);
+            l_impl_sort_sort3(begin + 2, begin + (s2 + 1), end - 3, cmp);
+            l_impl_sort_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1),
+                              cmp);
+            l_impl_sort_swap(begin, begin + s2);
+        }
+        else
+            l_impl_sort_sort3(begin + s2, begin, end - 1, cmp);
+        if (!leftmost && cmp(*(begin - 1), *begin) >= 0)
+        {
+            begin = l_impl_sort_partition_left(begin, end, cmp) + 1;
+            continue;
+        }
+        _Bool already_partitioned;
+        size_t *pivot_pos =
+            l_impl_sort_partition_right(begin, end, cmp, &already_partitioned);
+        size_t l_size = (size_t)(pivot_pos - begin);
+        size_t r_size = (size_t)(end - (pivot_pos + 1));
+        if (l_size < size / 8 || r_size < size / 8)
+        {
+            if (--bad_allowed == 0)
+            {
+                l_impl_sort_heapsort(begin, end, cmp);
+                return;
+            }
+            if (l_size >= 24)
+            {
+                size_t q = l_size / 4;
+                l_impl_sort_swap(begin, begin + q);
+                l_impl_sort_swap(pivot_pos - 1, pivot_pos - q);
+                if (l_size > 128)
+                {
+                    l_impl_sort_swap(begin + 1, begin + (q + 1));
+                    l_impl_sort_swap(begin + 2, begin + (q + 2));
+                    l_impl_sort_swap(pivot_pos - 2, pivot_pos - (q + 1));
+                    l_impl_sort_swap(pivot_pos - 3, pivot_pos - (q + 2));
+                }
+            }
+            if (r_size >= 24)
+            {
+                size_t q = r_size / 4;
+                l_impl_sort_swap(pivot_pos + 1, pivot_pos + (1 + q));
+                l_impl_sort_swap(end - 1, end - q);
+                if (r_size > 128)
+                {
+                    l_impl_sort_swap(pivot_pos + 2, pivot_pos + (2 + q));
+                    l_impl_sort_swap(pivot_pos + 3, pivot_pos + (3 + q));
+                    l_impl_sort_swap(end - 2, end - (1 + q));
+                    l_impl_sort_swap(end - 3, end - (2 + q));
+                }
+            }
+        }
+        else if (already_partitioned &&
+                 l_impl_sort_insertion_partial(begin, pivot_pos, cmp) &&
+                 l_impl_sort_insertion_partial(pivot_pos + 1, end, cmp))
+        {
+            return;
+        }
+        l_impl_sort_pdqsort(begin, pivot_pos, cmp, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = 0;
+    }
+}
+static void l_impl_sort(size_t *array, size_t count, int (*cmp)(size_t, size_t))
+{
+    if (count < 2)
+        return;
+    size_t bad_allowed = 0;
+    for (size_t n = count; n > 1; n >>= 1)
+        bad_allowed++;
+    l_impl_sort_pdqsort(array, array + count, cmp, bad_allowed, 1);
+}
+static void l_impl_sort_array(struct list *_list_, size_t *array, size_t count)
+{
+    l_impl_sort(array, count, _list_->f_val->cmp);
+}
 
 #endif /* CMC_TEST_SRC_LIST */
@@ -0,0 +1,517 @@
+#ifndef CMC_TEST_SRC_MPMCQUEUE
+#define CMC_TEST_SRC_MPMCQUEUE
+
+#include "cmc/mpmcqueue.h"
+
+struct mpmcqueue
+{
+    char pad_0[64];
+    _Atomic size_t enqueue_pos;
+    char pad_1[64];
+    _Atomic size_t dequeue_pos;
+    char pad_2[64];
+    struct mpmcqueue_cell *buffer;
+    size_t capacity;
+    _Atomic size_t sleeping_producers;
+    _Atomic size_t sleeping_consumers;
+    struct cmc_mutex mutex;
+    struct cmc_condvar not_full;
+    struct cmc_condvar not_empty;
+    int flag;
+    struct mpmcqueue_fval *f_val;
+    struct cmc_alloc_node *alloc;
+    struct cmc_callbacks *callbacks;
+};
+struct mpmcqueue_cell
+{
+    _Atomic size_t sequence;
+    size_t value;
+};
+struct mpmcqueue_fval
+{
+    int (*cmp)(size_t, size_t);
+    size_t (*cpy)(size_t);
+    _Bool (*str)(FILE *, size_t);
+    void (*free)(size_t);
+    size_t (*hash)(size_t);
+    int (*pri)(size_t, size_t);
+};
+struct mpmcqueue *mpq_new(size_t capacity, struct mpmcqueue_fval *f_val);
+struct mpmcqueue *mpq_new_custom(size_t capacity, struct mpmcqueue_fval *f_val,
+                                 struct cmc_alloc_node *alloc,
+                                 struct cmc_callbacks *callbacks);
+void mpq_clear(struct mpmcqueue *_queue_);
+void mpq_free(struct mpmcqueue *_queue_);
+void mpq_customize(struct mpmcqueue *_queue_, struct cmc_alloc_node *alloc,
+                   struct cmc_callbacks *callbacks);
+_Bool mpq_try_enqueue(struct mpmcqueue *_queue_, size_t value);
+_Bool mpq_try_dequeue(struct mpmcqueue *_queue_, size_t *out);
+_Bool mpq_enqueue(struct mpmcqueue *_queue_, size_t value);
+_Bool mpq_dequeue(struct mpmcqueue *_queue_, size_t *out);
+_Bool mpq_empty(struct mpmcqueue *_queue_);
+_Bool mpq_full(struct mpmcqueue *_queue_);
+size_t mpq_count(struct mpmcqueue *_queue_);
+size_t mpq_capacity(struct mpmcqueue *_queue_);
+int mpq_flag(struct mpmcqueue *_queue_);
+struct cmc_string mpq_to_string(struct mpmcqueue *_queue_);
+_Bool mpq_print(struct mpmcqueue *_queue_, FILE *fptr);
+static size_t mpq_impl_capacity(size_t capacity);
+static _Bool mpq_impl_try_enqueue(struct mpmcqueue *_queue_, size_t value);
+static _Bool mpq_impl_try_dequeue(struct mpmcqueue *_queue_, size_t *out);
+static void mpq_impl_wake(struct mpmcqueue *_queue_, _Atomic size_t *sleeping,
+                          struct cmc_condvar *cond);
+struct mpmcqueue *mpq_new(size_t capacity, struct mpmcqueue_fval *f_val)
+{
+    return mpq_new_custom(capacity, f_val, ((void *)0), ((void *)0));
+}
+struct mpmcqueue *mpq_new_custom(size_t capacity, struct mpmcqueue_fval *f_val,
+                                 struct cmc_alloc_node *alloc,
+                                 struct cmc_callbacks *callbacks)
+{
+    if (capacity < 1)
+        return ((void *)0);
+    if (!f_val)
+        return ((void *)0);
+    capacity = mpq_impl_capacity(capacity);
+    if (capacity == 0)
+        return ((void *)0);
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+    struct mpmcqueue *_queue_ = alloc->malloc(sizeof(struct mpmcqueue));
+    if (!_queue_)
+        return ((void *)0);
+    _queue_->buffer = alloc->calloc(capacity, sizeof(struct mpmcqueue_cell));
+    if (!_queue_->buffer)
+    {
+        alloc->free(_queue_);
+        return ((void *)0);
+    }
+    if (!cmc_mtx_init(&_queue_->mutex))
+        goto mutex_error;
+    if (!cmc_cnd_init(&_queue_->not_full))
+        goto not_full_error;
+    if (!cmc_cnd_init(&_queue_->not_empty))
+        goto not_empty_error;
+    for (size_t i = 0; i < capacity; i++)
+        __extension__({
+            __auto_type __atomic_store_ptr = (&_queue_->buffer[i].sequence);
+            __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp = (i);
+            __atomic_store(__atomic_store_ptr, &__atomic_store_tmp, (0));
+        });
+    __extension__({
+        __auto_type __atomic_store_ptr = (&_queue_->enqueue_pos);
+        __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp = (0);
+        __atomic_store(__atomic_store_ptr, &__atomic_store_tmp, (0));
+    });
+    __extension__({
+        __auto_type __atomic_store_ptr = (&_queue_->dequeue_pos);
+        __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp = (0);
+        __atomic_store(__atomic_store_ptr, &__atomic_store_tmp, (0));
+    });
+    __extension__({
+        __auto_type __atomic_store_ptr = (&_queue_->sleeping_producers);
+        __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp = (0);
+        __atomic_store(__atomic_store_ptr, &__atomic_store_tmp, (0));
+    });
+    __extension__({
+        __auto_type __atomic_store_ptr = (&_queue_->sleeping_consumers);
+        __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp = (0);
+        __atomic_store(__atomic_store_ptr, &__atomic_store_tmp, (0));
+    });
+    _queue_->capacity = capacity;
+    _queue_->flag = cmc_flags.OK;
+    _queue_->f_val = f_val;
+    _queue_->alloc = alloc;
+    _queue_->callbacks = callbacks;
+    return _queue_;
+not_empty_error:
+    cmc_cnd_destroy(&_queue_->not_full);
+not_full_error:
+    cmc_mtx_destroy(&_queue_->mutex);
+mutex_error:
+    alloc->free(_queue_->buffer);
+    alloc->free(_queue_);
+    return ((void *)0);
+}
+void mpq_clear(struct mpmcqueue *_queue_)
+{
+    size_t front = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->dequeue_pos);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    size_t back = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->enqueue_pos);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    if (_queue_->f_val->free)
+    {
+        for (size_t i = front; i != back; i++)
+            _queue_->f_val->free(
+                _queue_->buffer[i & (_queue_->capacity - 1)].value);
+    }
+    for (size_t i = 0; i < _queue_->capacity; i++)
+    {
+        __extension__({
+            __auto_type __atomic_store_ptr = (&_queue_->buffer[i].sequence);
+            __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp = (i);
+            __atomic_store(__atomic_store_ptr, &__atomic_store_tmp,
+                           (memory_order_relaxed));
+        });
+        memset(&_queue_->buffer[i].value, 0, sizeof(size_t));
+    }
+    __extension__({
+        __auto_type __atomic_store_ptr = (&_queue_->enqueue_pos);
+        __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp = (0);
+        __atomic_store(__atomic_store_ptr, &__atomic_store_tmp,
+                       (memory_order_relaxed));
+    });
+    __extension__({
+        __auto_type __atomic_store_ptr = (&_queue_->dequeue_pos);
+        __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp = (0);
+        __atomic_store(__atomic_store_ptr, &__atomic_store_tmp,
+                       (memory_order_relaxed));
+    });
+    _queue_->flag = cmc_flags.OK;
+}
+void mpq_free(struct mpmcqueue *_queue_)
+{
+    size_t front = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->dequeue_pos);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    size_t back = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->enqueue_pos);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    if (_queue_->f_val->free)
+    {
+        for (size_t i = front; i != back; i++)
+            _queue_->f_val->free(
+                _queue_->buffer[i & (_queue_->capacity - 1)].value);
+    }
+    cmc_cnd_destroy(&_queue_->not_empty);
+    cmc_cnd_destroy(&_queue_->not_full);
+    cmc_mtx_destroy(&_queue_->mutex);
+    _queue_->alloc->free(_queue_->buffer);
+    _queue_->alloc->free(_queue_);
+}
+void mpq_customize(struct mpmcqueue *_queue_, struct cmc_alloc_node *alloc,
+                   struct cmc_callbacks *callbacks)
+{
+    if (!alloc)
+        _queue_->alloc = &cmc_alloc_node_default;
+    else
+        _queue_->alloc = alloc;
+    _queue_->callbacks = callbacks;
+    _queue_->flag = cmc_flags.OK;
+}
+_Bool mpq_try_enqueue(struct mpmcqueue *_queue_, size_t value)
+{
+    if (!mpq_impl_try_enqueue(_queue_, value))
+        return 0;
+    mpq_impl_wake(_queue_, &_queue_->sleeping_consumers, &_queue_->not_empty);
+    if (_queue_->callbacks && _queue_->callbacks->create)
+        _queue_->callbacks->create();
+    return 1;
+}
+_Bool mpq_try_dequeue(struct mpmcqueue *_queue_, size_t *out)
+{
+    if (!mpq_impl_try_dequeue(_queue_, out))
+        return 0;
+    mpq_impl_wake(_queue_, &_queue_->sleeping_producers, &_queue_->not_full);
+    if (_queue_->callbacks && _queue_->callbacks->delete)
+        _queue_->callbacks->delete ();
+    return 1;
+}
+_Bool mpq_enqueue(struct mpmcqueue *_queue_, size_t value)
+{
+    for (size_t i = 0; i < 256; i++)
+    {
+        if (mpq_try_enqueue(_queue_, value))
+            return 1;
+    }
+    if (!cmc_mtx_lock(&_queue_->mutex))
+        return 0;
+    __atomic_fetch_add((&_queue_->sleeping_producers), (1), 5);
+    __atomic_thread_fence(memory_order_seq_cst);
+    _Bool result = 1;
+    while (!mpq_impl_try_enqueue(_queue_, value))
+    {
+        if (!cmc_cnd_wait(&_queue_->not_full, &_queue_->mutex))
+        {
+            result = 0;
+            break;
+        }
+    }
+    __atomic_fetch_sub((&_queue_->sleeping_producers), (1), 5);
+    cmc_mtx_unlock(&_queue_->mutex);
+    if (!result)
+        return 0;
+    mpq_impl_wake(_queue_, &_queue_->sleeping_consumers, &_queue_->not_empty);
+    if (_queue_->callbacks && _queue_->callbacks->create)
+        _queue_->callbacks->create();
+    return 1;
+}
+_Bool mpq_dequeue(struct mpmcqueue *_queue_, size_t *out)
+{
+    for (size_t i = 0; i < 256; i++)
+    {
+        if (mpq_try_dequeue(_queue_, out))
+            return 1;
+    }
+    if (!cmc_mtx_lock(&_queue_->mutex))
+        return 0;
+    __atomic_fetch_add((&_queue_->sleeping_consumers), (1), 5);
+    __atomic_thread_fence(memory_order_seq_cst);
+    _Bool result = 1;
+    while (!mpq_impl_try_dequeue(_queue_, out))
+    {
+        if (!cmc_cnd_wait(&_queue_->not_empty, &_queue_->mutex))
+        {
+            result = 0;
+            break;
+        }
+    }
+    __atomic_fetch_sub((&_queue_->sleeping_consumers), (1), 5);
+    cmc_mtx_unlock(&_queue_->mutex);
+    if (!result)
+        return 0;
+    mpq_impl_wake(_queue_, &_queue_->sleeping_producers, &_queue_->not_full);
+    if (_queue_->callbacks && _queue_->callbacks->delete)
+        _queue_->callbacks->delete ();
+    return 1;
+}
+_Bool mpq_empty(struct mpmcqueue *_queue_)
+{
+    return mpq_count(_queue_) == 0;
+}
+_Bool mpq_full(struct mpmcqueue *_queue_)
+{
+    return mpq_count(_queue_) >= _queue_->capacity;
+}
+size_t mpq_count(struct mpmcqueue *_queue_)
+{
+    size_t front = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->dequeue_pos);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_acquire));
+        __atomic_load_tmp;
+    });
+    size_t back = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->enqueue_pos);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_acquire));
+        __atomic_load_tmp;
+    });
+    return back - front > _queue_->capacity ? _queue_->capacity : back - front;
+}
+size_t mpq_capacity(struct mpmcqueue *_queue_)
+{
+    return _queue_->capacity;
+}
+int mpq_flag(struct mpmcqueue *_queue_)
+{
+    return _queue_->flag;
+}
+struct cmc_string mpq_to_string(struct mpmcqueue *_queue_)
+{
+    struct cmc_string str;
+    struct mpmcqueue *q_ = _queue_;
+    int n =
+        snprintf(str.s, cmc_string_len, cmc_string_fmt_mpmcqueue, "mpmcqueue",
+                 "size_t", q_, q_->buffer, q_->capacity, __extension__({
+                     __auto_type __atomic_load_ptr = (&q_->enqueue_pos);
+                     __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+                     __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                                   (memory_order_relaxed));
+                     __atomic_load_tmp;
+                 }),
+                 __extension__({
+                     __auto_type __atomic_load_ptr = (&q_->dequeue_pos);
+                     __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+                     __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                                   (memory_order_relaxed));
+                     __atomic_load_tmp;
+                 }),
+                 q_->flag, q_->f_val, q_->alloc, q_->callbacks);
+    return n >= 0 ? str : (struct cmc_string){ 0 };
+}
+_Bool mpq_print(struct mpmcqueue *_queue_, FILE *fptr)
+{
+    size_t front = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->dequeue_pos);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    size_t back = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->enqueue_pos);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    for (size_t i = front; i != back; i++)
+    {
+        if (!_queue_->f_val->str(
+                fptr, _queue_->buffer[i & (_queue_->capacity - 1)].value))
+            return 0;
+    }
+    return 1;
+}
+static size_t mpq_impl_capacity(size_t capacity)
+{
+    size_t result = 2;
+    while (result < capacity)
+    {
+        if (result > (18446744073709551615UL) / 2)
+            return 0;
+        result *= 2;
+    }
+    return result;
+}
+static _Bool mpq_impl_try_enqueue(struct mpmcqueue *_queue_, size_t value)
+{
+    struct mpmcqueue_cell *cell;
+    size_t pos = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->enqueue_pos);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    for (;;)
+    {
+        cell = &_queue_->buffer[pos & (_queue_->capacity - 1)];
+        size_t seq = __extension__({
+            __auto_type __atomic_load_ptr = (&cell->sequence);
+            __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+            __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                          (memory_order_acquire));
+            __atomic_load_tmp;
+        });
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0)
+        {
+            if (__extension__({
+                    __auto_type __atomic_compare_exchange_ptr =
+                        (&_queue_->enqueue_pos);
+                    __typeof__((void)0, *__atomic_compare_exchange_ptr)
+                        __atomic_compare_exchange_tmp = (pos + 1);
+                    __atomic_compare_exchange(
+                        __atomic_compare_exchange_ptr, (&pos),
+                        &__atomic_compare_exchange_tmp, 1,
+                        (memory_order_relaxed), (memory_order_relaxed));
+                }))
+                break;
+        }
+        else if (diff < 0)
+            return 0;
+        else
+            pos = __extension__({
+                __auto_type __atomic_load_ptr = (&_queue_->enqueue_pos);
+                __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+                __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                              (memory_order_relaxed));
+                __atomic_load_tmp;
+            });
+    }
+    cell->value = value;
+    __extension__({
+        __auto_type __atomic_store_ptr = (&cell->sequence);
+        __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp = (pos + 1);
+        __atomic_store(__atomic_store_ptr, &__atomic_store_tmp,
+                       (memory_order_release));
+    });
+    return 1;
+}
+static _Bool mpq_impl_try_dequeue(struct mpmcqueue *_queue_, size_t *out)
+{
+    struct mpmcqueue_cell *cell;
+    size_t pos = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->dequeue_pos);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    for (;;)
+    {
+        cell = &_queue_->buffer[pos & (_queue_->capacity - 1)];
+        size_t seq = __extension__({
+            __auto_type __atomic_load_ptr = (&cell->sequence);
+            __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+            __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                          (memory_order_acquire));
+            __atomic_load_tmp;
+        });
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (diff == 0)
+        {
+            if (__extension__({
+                    __auto_type __atomic_compare_exchange_ptr =
+                        (&_queue_->dequeue_pos);
+                    __typeof__((void)0, *__atomic_compare_exchange_ptr)
+                        __atomic_compare_exchange_tmp = (pos + 1);
+                    __atomic_compare_exchange(
+                        __atomic_compare_exchange_ptr, (&pos),
+                        &__atomic_compare_exchange_tmp, 1,
+                        (memory_order_relaxed), (memory_order_relaxed));
+                }))
+                break;
+        }
+        else if (diff < 0)
+            return 0;
+        else
+            pos = __extension__({
+                __auto_type __atomic_load_ptr = (&_queue_->dequeue_pos);
+                __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+                __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                              (memory_order_relaxed));
+                __atomic_load_tmp;
+            });
+    }
+    if (out)
+        *out = cell->value;
+    __extension__({
+        __auto_type __atomic_store_ptr = (&cell->sequence);
+        __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp =
+            (pos + _queue_->capacity);
+        __atomic_store(__atomic_store_ptr, &__atomic_store_tmp,
+                       (memory_order_release));
+    });
+    return 1;
+}
+static void mpq_impl_wake(struct mpmcqueue *_queue_, _Atomic size_t *sleeping,
+                          struct cmc_condvar *cond)
+{
+    __atomic_thread_fence(memory_order_seq_cst);
+    if (__extension__({
+            __auto_type __atomic_load_ptr = (sleeping);
+            __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+            __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                          (memory_order_relaxed));
+            __atomic_load_tmp;
+        }) == 0)
+        return;
+    cmc_mtx_lock(&_queue_->mutex);
+    cmc_cnd_signal(cond);
+    cmc_mtx_unlock(&_queue_->mutex);
+}
+
+#endif /* CMC_TEST_SRC_MPMCQUEUE */
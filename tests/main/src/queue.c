@@ -14,6 +14,7 @@ struct queue
     struct queue_fval *f_val;
     struct cmc_alloc_node *alloc;
     struct cmc_callbacks *callbacks;
+    const struct cmc_growth *growth;
 };
 struct queue_fval
 {
@@ -40,8 +41,11 @@ void q_clear(struct queue *_queue_);
 void q_free(struct queue *_queue_);
 void q_customize(struct queue *_queue_, struct cmc_alloc_node *alloc,
                  struct cmc_callbacks *callbacks);
+void q_set_growth(struct queue *_queue_, const struct cmc_growth *growth);
 _Bool q_enqueue(struct queue *_queue_, size_t value);
 _Bool q_dequeue(struct queue *_queue_);
+_Bool q_enqueue_n(struct queue *_queue_, size_t *values, size_t n);
+size_t q_dequeue_n(struct queue *_queue_, size_t *out, size_t n);
 size_t q_peek(struct queue *_queue_);
 _Bool q_contains(struct queue *_queue_, size_t value);
 _Bool q_empty(struct queue *_queue_);
@@ -50,6 +54,8 @@ size_t q_count(struct queue *_queue_);
 size_t q_capacity(struct queue *_queue_);
 int q_flag(struct queue *_queue_);
 _Bool q_resize(struct queue *_queue_, size_t capacity);
+_Bool q_reserve(struct queue *_queue_, size_t size);
+_Bool q_shrink_to_fit(struct queue *_queue_);
 struct queue *q_copy_of(struct queue *_queue_);
 _Bool q_equals(struct queue *_queue1_, struct queue *_queue2_);
 struct cmc_string q_to_string(struct queue *_queue_);
@@ -68,6 +74,27 @@ _Bool q_iter_go_to(struct queue_iter *iter, size_t index);
 size_t q_iter_value(struct queue_iter *iter);
 size_t *q_iter_rvalue(struct queue_iter *iter);
 size_t q_iter_index(struct queue_iter *iter);
+static inline size_t q_impl_search(size_t *array, size_t count, size_t value,
+                                   int (*cmp)(size_t, size_t))
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (cmp(array[i], value) == 0)
+            return i;
+    }
+    return count;
+}
+static inline size_t q_impl_search_last(size_t *array, size_t count,
+                                        size_t value,
+                                        int (*cmp)(size_t, size_t))
+{
+    for (size_t i = count; i > 0; i--)
+    {
+        if (cmp(array[i - 1], value) == 0)
+            return i - 1;
+    }
+    return count;
+}
 struct queue *q_new(size_t capacity, struct queue_fval *f_val)
 {
     struct cmc_alloc_node *alloc = &cmc_alloc_node_default;
@@ -92,6 +119,7 @@ struct queue *q_new(size_t capacity, struct queue_fval *f_val)
     _queue_->f_val = f_val;
     _queue_->alloc = alloc;
     _queue_->callbacks = ((void *)0);
+    _queue_->growth = ((void *)0);
     return _queue_;
 }
 struct queue *q_new_custom(size_t capacity, struct queue_fval *f_val,
@@ -121,6 +149,7 @@ struct queue *q_new_custom(size_t capacity, struct queue_fval *f_val,
     _queue_->f_val = f_val;
     _queue_->alloc = alloc;
     _queue_->callbacks = callbacks;
+    _queue_->growth = ((void *)0);
     return _queue_;
 }
 void q_clear(struct queue *_queue_)
@@ -162,11 +191,16 @@ void q_customize(struct queue *_queue_, struct cmc_alloc_node *alloc,
     _queue_->callbacks = callbacks;
     _queue_->flag = cmc_flags.OK;
 }
+void q_set_growth(struct queue *_queue_, const struct cmc_growth *growth)
+{
+    _queue_->growth = growth;
+    _queue_->flag = cmc_flags.OK;
+}
 _Bool q_enqueue(struct queue *_queue_, size_t value)
 {
     if (q_full(_queue_))
     {
-        if (!q_resize(_queue_, _queue_->capacity * 2))
+        if (!q_reserve(_queue_, 1))
             return 0;
     }
     _queue_->buffer[_queue_->back] = value;
@@ -194,6 +228,53 @@ _Bool q_dequeue(struct queue *_queue_)
         _queue_->callbacks->delete ();
     return 1;
 }
+_Bool q_enqueue_n(struct queue *_queue_, size_t *values, size_t n)
+{
+    if (n == 0)
+    {
+        _queue_->flag = cmc_flags.OK;
+        return 1;
+    }
+    if (!q_reserve(_queue_, n))
+        return 0;
+    size_t count1 = _queue_->capacity - _queue_->back;
+    if (count1 > n)
+        count1 = n;
+    memcpy(_queue_->buffer + _queue_->back, values, sizeof(size_t) * count1);
+    memcpy(_queue_->buffer, values + count1, sizeof(size_t) * (n - count1));
+    _queue_->back = (_queue_->back + n) % _queue_->capacity;
+    _queue_->count += n;
+    _queue_->flag = cmc_flags.OK;
+    if (_queue_->callbacks && _queue_->callbacks->create)
+        _queue_->callbacks->create();
+    return 1;
+}
+size_t q_dequeue_n(struct queue *_queue_, size_t *out, size_t n)
+{
+    if (q_empty(_queue_))
+    {
+        _queue_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    if (n > _queue_->count)
+        n = _queue_->count;
+    size_t count1 = _queue_->capacity - _queue_->front;
+    if (count1 > n)
+        count1 = n;
+    if (out)
+    {
+        memcpy(out, _queue_->buffer + _queue_->front, sizeof(size_t) * count1);
+        memcpy(out + count1, _queue_->buffer, sizeof(size_t) * (n - count1));
+    }
+    memset(_queue_->buffer + _queue_->front, 0, sizeof(size_t) * count1);
+    memset(_queue_->buffer, 0, sizeof(size_t) * (n - count1));
+    _queue_->front = (_queue_->front + n) % _queue_->capacity;
+    _queue_->count -= n;
+    _queue_->flag = cmc_flags.OK;
+    if (_queue_->callbacks && _queue_->callbacks->delete)
+        _queue_->callbacks->delete ();
+    return n;
+}
 size_t q_peek(struct queue *_queue_)
 {
     if (q_empty(_queue_))
@@ -209,16 +290,16 @@ size_t q_peek(struct queue *_queue_)
 _Bool q_contains(struct queue *_queue_, size_t value)
 {
     _queue_->flag = cmc_flags.OK;
-    _Bool result = 0;
-    for (size_t i = _queue_->front, j = 0; j < _queue_->count; j++)
-    {
-        if (_queue_->f_val->cmp(_queue_->buffer[i], value) == 0)
-        {
-            result = 1;
-            break;
-        }
-        i = (i + 1) % _queue_->capacity;
-    }
+    size_t count1 = _queue_->capacity - _queue_->front;
+    size_t count2 = 0;
+    if (count1 >= _queue_->count)
+        count1 = _queue_->count;
+    else
+        count2 = _queue_->count - count1;
+    _Bool result = q_impl_search(_queue_->buffer + _queue_->front, count1,
+                                 value, _queue_->f_val->cmp) < count1 ||
+                   q_impl_search(_queue_->buffer, count2, value,
+                                 _queue_->f_val->cmp) < count2;
     if (_queue_->callbacks && _queue_->callbacks->read)
         _queue_->callbacks->read();
     return result;
@@ -252,28 +333,77 @@ _Bool q_resize(struct queue *_queue_, size_t capacity)
         _queue_->flag = cmc_flags.INVALID;
         return 0;
     }
-    size_t *new_buffer = _queue_->alloc->malloc(sizeof(size_t) * capacity);
-    if (!new_buffer)
+    if (capacity > _queue_->capacity)
     {
-        _queue_->flag = cmc_flags.ALLOC;
-        return 0;
+        size_t *new_buffer =
+            _queue_->alloc->realloc(_queue_->buffer, sizeof(size_t) * capacity);
+        if (!new_buffer)
+        {
+            _queue_->flag = cmc_flags.ALLOC;
+            return 0;
+        }
+        size_t old_capacity = _queue_->capacity;
+        if (_queue_->front + _queue_->count > old_capacity)
+        {
+            size_t tail = old_capacity - _queue_->front;
+            size_t head = _queue_->count - tail;
+            if (head < tail && head <= capacity - old_capacity)
+                memcpy(new_buffer + old_capacity, new_buffer,
+                       sizeof(size_t) * head);
+            else
+            {
+                memmove(new_buffer + capacity - tail,
+                        new_buffer + _queue_->front, sizeof(size_t) * tail);
+                _queue_->front = capacity - tail;
+            }
+        }
+        _queue_->buffer = new_buffer;
+        _queue_->capacity = capacity;
+        _queue_->back = (_queue_->front + _queue_->count) % capacity;
     }
-    for (size_t i = _queue_->front, j = 0; j < _queue_->count; j++)
+    else
     {
-        new_buffer[j] = _queue_->buffer[i];
-        i = (i + 1) % _queue_->capacity;
+        size_t *new_buffer = _queue_->alloc->malloc(sizeof(size_t) * capacity);
+        if (!new_buffer)
+        {
+            _queue_->flag = cmc_flags.ALLOC;
+            return 0;
+        }
+        for (size_t i = _queue_->front, j = 0; j < _queue_->count; j++)
+        {
+            new_buffer[j] = _queue_->buffer[i];
+            i = (i + 1) % _queue_->capacity;
+        }
+        _queue_->alloc->free(_queue_->buffer);
+        _queue_->buffer = new_buffer;
+        _queue_->capacity = capacity;
+        _queue_->front = 0;
+        _queue_->back = _queue_->count % capacity;
     }
-    _queue_->alloc->free(_queue_->buffer);
-    _queue_->buffer = new_buffer;
-    _queue_->capacity = capacity;
-    _queue_->front = 0;
-    _queue_->back = _queue_->count;
 success:
     _queue_->flag = cmc_flags.OK;
     if (_queue_->callbacks && _queue_->callbacks->resize)
         _queue_->callbacks->resize();
     return 1;
 }
+_Bool q_reserve(struct queue *_queue_, size_t size)
+{
+    _queue_->flag = cmc_flags.OK;
+    if (size <= _queue_->capacity - _queue_->count)
+        return 1;
+    if (size > (18446744073709551615UL) - _queue_->count)
+    {
+        _queue_->flag = cmc_flags.ERROR;
+        return 0;
+    }
+    return q_resize(_queue_,
+                    cmc_growth_capacity(_queue_->growth, _queue_->capacity,
+                                        _queue_->count + size));
+}
+_Bool q_shrink_to_fit(struct queue *_queue_)
+{
+    return q_resize(_queue_, _queue_->count > 0 ? _queue_->count : 1);
+}
 struct queue *q_copy_of(struct queue *_queue_)
 {
     struct queue *result = q_new_custom(_queue_->capacity, _queue_->f_val,
@@ -300,6 +430,7 @@ struct queue *q_copy_of(struct queue *_queue_)
         }
     }
     result->count = _queue_->count;
+    result->growth = _queue_->growth;
     result->front = 0;
     result->back = _queue_->count;
     _queue_->flag = cmc_flags.OK;
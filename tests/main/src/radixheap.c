@@ -0,0 +1,285 @@
+#ifndef CMC_TEST_SRC_RADIXHEAP
+#define CMC_TEST_SRC_RADIXHEAP
+
+#include "cmc/radixheap.h"
+
+struct radixheap_entry
+{
+    size_t key;
+    size_t value;
+};
+struct radixheap_bucket
+{
+    struct radixheap_entry *buffer;
+    size_t capacity;
+    size_t count;
+};
+struct radixheap
+{
+    struct radixheap_bucket buckets[sizeof(size_t) * 8 + 1];
+    size_t last;
+    size_t count;
+    int flag;
+    struct radixheap_fval *f_val;
+    struct cmc_alloc_node *alloc;
+    struct cmc_callbacks *callbacks;
+};
+struct radixheap_fval
+{
+    int (*cmp)(size_t, size_t);
+    size_t (*cpy)(size_t);
+    _Bool (*str)(FILE *, size_t);
+    void (*free)(size_t);
+    size_t (*hash)(size_t);
+    int (*pri)(size_t, size_t);
+};
+struct radixheap *rh_new(struct radixheap_fval *f_val);
+struct radixheap *rh_new_custom(struct radixheap_fval *f_val,
+                                struct cmc_alloc_node *alloc,
+                                struct cmc_callbacks *callbacks);
+void rh_clear(struct radixheap *_heap_);
+void rh_free(struct radixheap *_heap_);
+void rh_customize(struct radixheap *_heap_, struct cmc_alloc_node *alloc,
+                  struct cmc_callbacks *callbacks);
+_Bool rh_push(struct radixheap *_heap_, size_t key, size_t value);
+_Bool rh_pop_min(struct radixheap *_heap_, size_t *key, size_t *value);
+_Bool rh_peek(struct radixheap *_heap_, size_t *key, size_t *value);
+size_t rh_last(struct radixheap *_heap_);
+_Bool rh_empty(struct radixheap *_heap_);
+size_t rh_count(struct radixheap *_heap_);
+int rh_flag(struct radixheap *_heap_);
+struct cmc_string rh_to_string(struct radixheap *_heap_);
+_Bool rh_print(struct radixheap *_heap_, FILE *fptr);
+static size_t rh_impl_bucket(size_t key, size_t last);
+static _Bool rh_impl_grow(struct radixheap *_heap_,
+                          struct radixheap_bucket *bucket, size_t size);
+static _Bool rh_impl_refill(struct radixheap *_heap_);
+struct radixheap *rh_new(struct radixheap_fval *f_val)
+{
+    return rh_new_custom(f_val, ((void *)0), ((void *)0));
+}
+struct radixheap *rh_new_custom(struct radixheap_fval *f_val,
+                                struct cmc_alloc_node *alloc,
+                                struct cmc_callbacks *callbacks)
+{
+    if (!f_val)
+        return ((void *)0);
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+    struct radixheap *_heap_ = alloc->malloc(sizeof(struct radixheap));
+    if (!_heap_)
+        return ((void *)0);
+    for (size_t i = 0; i < sizeof(size_t) * 8 + 1; i++)
+        _heap_->buckets[i] = (struct radixheap_bucket){ ((void *)0), 0, 0 };
+    _heap_->last = 0;
+    _heap_->count = 0;
+    _heap_->flag = cmc_flags.OK;
+    _heap_->f_val = f_val;
+    _heap_->alloc = alloc;
+    _heap_->callbacks = callbacks;
+    return _heap_;
+}
+void rh_clear(struct radixheap *_heap_)
+{
+    for (size_t i = 0; i < sizeof(size_t) * 8 + 1; i++)
+    {
+        struct radixheap_bucket *bucket = &(_heap_->buckets[i]);
+        if (_heap_->f_val->free)
+        {
+            for (size_t j = 0; j < bucket->count; j++)
+                _heap_->f_val->free(bucket->buffer[j].value);
+        }
+        bucket->count = 0;
+    }
+    _heap_->last = 0;
+    _heap_->count = 0;
+    _heap_->flag = cmc_flags.OK;
+}
+void rh_free(struct radixheap *_heap_)
+{
+    for (size_t i = 0; i < sizeof(size_t) * 8 + 1; i++)
+    {
+        struct radixheap_bucket *bucket = &(_heap_->buckets[i]);
+        if (_heap_->f_val->free)
+        {
+            for (size_t j = 0; j < bucket->count; j++)
+                _heap_->f_val->free(bucket->buffer[j].value);
+        }
+        if (bucket->buffer)
+            _heap_->alloc->free(bucket->buffer);
+    }
+    _heap_->alloc->free(_heap_);
+}
+void rh_customize(struct radixheap *_heap_, struct cmc_alloc_node *alloc,
+                  struct cmc_callbacks *callbacks)
+{
+    if (!alloc)
+        _heap_->alloc = &cmc_alloc_node_default;
+    else
+        _heap_->alloc = alloc;
+    _heap_->callbacks = callbacks;
+    _heap_->flag = cmc_flags.OK;
+}
+_Bool rh_push(struct radixheap *_heap_, size_t key, size_t value)
+{
+    if (key < _heap_->last)
+    {
+        _heap_->flag = cmc_flags.INVALID;
+        return 0;
+    }
+    struct radixheap_bucket *bucket =
+        &(_heap_->buckets[rh_impl_bucket(key, _heap_->last)]);
+    if (bucket->count == bucket->capacity)
+    {
+        if (!rh_impl_grow(_heap_, bucket, 1))
+            return 0;
+    }
+    bucket->buffer[bucket->count++] = (struct radixheap_entry){ key, value };
+    _heap_->count++;
+    _heap_->flag = cmc_flags.OK;
+    if (_heap_->callbacks && _heap_->callbacks->create)
+        _heap_->callbacks->create();
+    return 1;
+}
+_Bool rh_pop_min(struct radixheap *_heap_, size_t *key, size_t *value)
+{
+    if (rh_empty(_heap_))
+    {
+        _heap_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    if (!rh_impl_refill(_heap_))
+        return 0;
+    struct radixheap_bucket *bucket = &(_heap_->buckets[0]);
+    struct radixheap_entry entry = bucket->buffer[--bucket->count];
+    if (key)
+        *key = entry.key;
+    if (value)
+        *value = entry.value;
+    _heap_->count--;
+    _heap_->flag = cmc_flags.OK;
+    if (_heap_->callbacks && _heap_->callbacks->delete)
+        _heap_->callbacks->delete ();
+    return 1;
+}
+_Bool rh_peek(struct radixheap *_heap_, size_t *key, size_t *value)
+{
+    if (rh_empty(_heap_))
+    {
+        _heap_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    if (!rh_impl_refill(_heap_))
+        return 0;
+    struct radixheap_bucket *bucket = &(_heap_->buckets[0]);
+    if (key)
+        *key = bucket->buffer[bucket->count - 1].key;
+    if (value)
+        *value = bucket->buffer[bucket->count - 1].value;
+    _heap_->flag = cmc_flags.OK;
+    if (_heap_->callbacks && _heap_->callbacks->read)
+        _heap_->callbacks->read();
+    return 1;
+}
+size_t rh_last(struct radixheap *_heap_)
+{
+    return _heap_->last;
+}
+_Bool rh_empty(struct radixheap *_heap_)
+{
+    return _heap_->count == 0;
+}
+size_t rh_count(struct radixheap *_heap_)
+{
+    return _heap_->count;
+}
+int rh_flag(struct radixheap *_heap_)
+{
+    return _heap_->flag;
+}
+struct cmc_string rh_to_string(struct radixheap *_heap_)
+{
+    struct cmc_string str;
+    struct radixheap *h_ = _heap_;
+    int n = snprintf(str.s, cmc_string_len, cmc_string_fmt_radixheap,
+                     "radixheap", "size_t", "size_t", h_, (uintmax_t)h_->last,
+                     h_->count, h_->flag, h_->f_val, h_->alloc, h_->callbacks);
+    return n >= 0 ? str : (struct cmc_string){ 0 };
+}
+_Bool rh_print(struct radixheap *_heap_, FILE *fptr)
+{
+    for (size_t i = 0; i < sizeof(size_t) * 8 + 1; i++)
+    {
+        struct radixheap_bucket *bucket = &(_heap_->buckets[i]);
+        for (size_t j = 0; j < bucket->count; j++)
+        {
+            if (fprintf(fptr,
+                        "%"
+                        "l"
+                        "u"
+                        ":",
+                        (uintmax_t)bucket->buffer[j].key) < 0)
+                return 0;
+            if (!_heap_->f_val->str(fptr, bucket->buffer[j].value))
+                return 0;
+        }
+    }
+    return 1;
+}
+static size_t rh_impl_bucket(size_t key, size_t last)
+{
+    return cmc_radixheap_bit_length((uintmax_t)(key ^ last));
+}
+static _Bool rh_impl_grow(struct radixheap *_heap_,
+                          struct radixheap_bucket *bucket, size_t size)
+{
+    if (size <= bucket->capacity - bucket->count)
+        return 1;
+    size_t capacity = bucket->capacity == 0 ? 16 : bucket->capacity * 2;
+    if (capacity < bucket->count + size)
+        capacity = bucket->count + size;
+    struct radixheap_entry *new_buffer = _heap_->alloc->realloc(
+        bucket->buffer, sizeof(struct radixheap_entry) * capacity);
+    if (!new_buffer)
+    {
+        _heap_->flag = cmc_flags.ALLOC;
+        return 0;
+    }
+    bucket->buffer = new_buffer;
+    bucket->capacity = capacity;
+    return 1;
+}
+static _Bool rh_impl_refill(struct radixheap *_heap_)
+{
+    if (_heap_->buckets[0].count > 0)
+        return 1;
+    size_t i = 1;
+    while (_heap_->buckets[i].count == 0)
+        i++;
+    struct radixheap_bucket *bucket = &(_heap_->buckets[i]);
+    size_t last = bucket->buffer[0].key;
+    for (size_t j = 1; j < bucket->count; j++)
+    {
+        if (bucket->buffer[j].key < last)
+            last = bucket->buffer[j].key;
+    }
+    size_t sizes[sizeof(size_t) * 8 + 1] = { 0 };
+    for (size_t j = 0; j < bucket->count; j++)
+        sizes[rh_impl_bucket(bucket->buffer[j].key, last)]++;
+    for (size_t j = 0; j < i; j++)
+    {
+        if (!rh_impl_grow(_heap_, &(_heap_->buckets[j]), sizes[j]))
+            return 0;
+    }
+    for (size_t j = 0; j < bucket->count; j++)
+    {
+        struct radixheap_bucket *target =
+            &(_heap_->buckets[rh_impl_bucket(bucket->buffer[j].key, last)]);
+        target->buffer[target->count++] = bucket->buffer[j];
+    }
+    bucket->count = 0;
+    _heap_->last = last;
+    return 1;
+}
+
+#endif /* CMC_TEST_SRC_RADIXHEAP */
@@ -0,0 +1,916 @@
+#ifndef CMC_TEST_SRC_SEGDEQUE
+#define CMC_TEST_SRC_SEGDEQUE
+
+#include "cmc/segdeque.h"
+
+struct segdeque
+{
+    size_t **map;
+    size_t map_capacity;
+    size_t first;
+    size_t blocks;
+    size_t front;
+    size_t capacity;
+    size_t count;
+    int flag;
+    struct segdeque_fval *f_val;
+    struct cmc_alloc_node *alloc;
+    struct cmc_callbacks *callbacks;
+    const struct cmc_growth *growth;
+};
+struct segdeque_fval
+{
+    int (*cmp)(size_t, size_t);
+    size_t (*cpy)(size_t);
+    _Bool (*str)(FILE *, size_t);
+    void (*free)(size_t);
+    size_t (*hash)(size_t);
+    int (*pri)(size_t, size_t);
+};
+struct segdeque_iter
+{
+    struct segdeque *target;
+    size_t block;
+    size_t offset;
+    size_t index;
+    _Bool start;
+    _Bool end;
+};
+struct segdeque *sd_new(size_t capacity, struct segdeque_fval *f_val);
+struct segdeque *sd_new_custom(size_t capacity, struct segdeque_fval *f_val,
+                               struct cmc_alloc_node *alloc,
+                               struct cmc_callbacks *callbacks);
+struct segdeque sd_init(size_t capacity, struct segdeque_fval *f_val);
+struct segdeque sd_init_custom(size_t capacity, struct segdeque_fval *f_val,
+                               struct cmc_alloc_node *alloc,
+                               struct cmc_callbacks *callbacks);
+void sd_clear(struct segdeque *_deque_);
+void sd_free(struct segdeque *_deque_);
+void sd_release(struct segdeque _deque_);
+void sd_customize(struct segdeque *_deque_, struct cmc_alloc_node *alloc,
+                  struct cmc_callbacks *callbacks);
+void sd_set_growth(struct segdeque *_deque_, const struct cmc_growth *growth);
+_Bool sd_push_front(struct segdeque *_deque_, size_t value);
+_Bool sd_push_back(struct segdeque *_deque_, size_t value);
+_Bool sd_pop_front(struct segdeque *_deque_);
+_Bool sd_pop_back(struct segdeque *_deque_);
+_Bool sd_push_back_n(struct segdeque *_deque_, size_t *values, size_t n);
+size_t sd_pop_front_n(struct segdeque *_deque_, size_t *out, size_t n);
+size_t sd_front(struct segdeque *_deque_);
+size_t sd_back(struct segdeque *_deque_);
+size_t sd_get(struct segdeque *_deque_, size_t index);
+size_t *sd_get_ref(struct segdeque *_deque_, size_t index);
+_Bool sd_contains(struct segdeque *_deque_, size_t value);
+_Bool sd_empty(struct segdeque *_deque_);
+_Bool sd_full(struct segdeque *_deque_);
+size_t sd_count(struct segdeque *_deque_);
+size_t sd_capacity(struct segdeque *_deque_);
+int sd_flag(struct segdeque *_deque_);
+_Bool sd_resize(struct segdeque *_deque_, size_t capacity);
+_Bool sd_reserve(struct segdeque *_deque_, size_t size);
+_Bool sd_shrink_to_fit(struct segdeque *_deque_);
+struct segdeque *sd_copy_of(struct segdeque *_deque_);
+_Bool sd_equals(struct segdeque *_deque1_, struct segdeque *_deque2_);
+struct cmc_string sd_to_string(struct segdeque *_deque_);
+_Bool sd_print(struct segdeque *_deque_, FILE *fptr);
+struct segdeque_iter sd_iter_start(struct segdeque *target);
+struct segdeque_iter sd_iter_end(struct segdeque *target);
+_Bool sd_iter_at_start(struct segdeque_iter *iter);
+_Bool sd_iter_at_end(struct segdeque_iter *iter);
+_Bool sd_iter_to_start(struct segdeque_iter *iter);
+_Bool sd_iter_to_end(struct segdeque_iter *iter);
+_Bool sd_iter_next(struct segdeque_iter *iter);
+_Bool sd_iter_prev(struct segdeque_iter *iter);
+_Bool sd_iter_advance(struct segdeque_iter *iter, size_t steps);
+_Bool sd_iter_rewind(struct segdeque_iter *iter, size_t steps);
+_Bool sd_iter_go_to(struct segdeque_iter *iter, size_t index);
+size_t sd_iter_value(struct segdeque_iter *iter);
+size_t *sd_iter_rvalue(struct segdeque_iter *iter);
+size_t sd_iter_index(struct segdeque_iter *iter);
+static inline size_t sd_impl_search(size_t *array, size_t count, size_t value,
+                                    int (*cmp)(size_t, size_t))
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (cmp(array[i], value) == 0)
+            return i;
+    }
+    return count;
+}
+static inline size_t sd_impl_search_last(size_t *array, size_t count,
+                                         size_t value,
+                                         int (*cmp)(size_t, size_t))
+{
+    for (size_t i = count; i > 0; i--)
+    {
+        if (cmp(array[i - 1], value) == 0)
+            return i - 1;
+    }
+    return count;
+}
+static size_t *sd_impl_at(struct segdeque *_deque_, size_t index);
+static _Bool sd_impl_block(struct segdeque *_deque_, size_t index);
+static _Bool sd_impl_remap(struct segdeque *_deque_, size_t map_capacity);
+static _Bool sd_impl_grow_map(struct segdeque *_deque_);
+static void sd_impl_iter_seek(struct segdeque_iter *iter, size_t index);
+struct segdeque *sd_new(size_t capacity, struct segdeque_fval *f_val)
+{
+    return sd_new_custom(capacity, f_val, ((void *)0), ((void *)0));
+}
+struct segdeque *sd_new_custom(size_t capacity, struct segdeque_fval *f_val,
+                               struct cmc_alloc_node *alloc,
+                               struct cmc_callbacks *callbacks)
+{
+    if (capacity < 1)
+        return ((void *)0);
+    if (!f_val)
+        return ((void *)0);
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+    struct segdeque *_deque_ = alloc->malloc(sizeof(struct segdeque));
+    if (!_deque_)
+        return ((void *)0);
+    *_deque_ = sd_init_custom(capacity, f_val, alloc, callbacks);
+    if (!_deque_->map)
+    {
+        alloc->free(_deque_);
+        return ((void *)0);
+    }
+    return _deque_;
+}
+struct segdeque sd_init(size_t capacity, struct segdeque_fval *f_val)
+{
+    return sd_init_custom(capacity, f_val, ((void *)0), ((void *)0));
+}
+struct segdeque sd_init_custom(size_t capacity, struct segdeque_fval *f_val,
+                               struct cmc_alloc_node *alloc,
+                               struct cmc_callbacks *callbacks)
+{
+    struct segdeque _deque_ = { 0 };
+    if (capacity < 1)
+        return _deque_;
+    if (!f_val)
+        return _deque_;
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+    const size_t block_size =
+        (4096 / sizeof(size_t) > 16 ? 4096 / sizeof(size_t) : 16);
+    size_t blocks = (capacity - 1) / block_size + 1;
+    _deque_.map = alloc->calloc(blocks + 2, sizeof(size_t *));
+    if (!_deque_.map)
+        return _deque_;
+    for (size_t i = 1; i <= blocks; i++)
+    {
+        _deque_.map[i] = alloc->malloc(sizeof(size_t) * block_size);
+        if (!_deque_.map[i])
+        {
+            for (size_t j = 1; j < i; j++)
+                alloc->free(_deque_.map[j]);
+            alloc->free(_deque_.map);
+            return (struct segdeque){ 0 };
+        }
+    }
+    _deque_.map_capacity = blocks + 2;
+    _deque_.first = 1;
+    _deque_.blocks = 0;
+    _deque_.front = 0;
+    _deque_.capacity = blocks * block_size;
+    _deque_.count = 0;
+    _deque_.flag = cmc_flags.OK;
+    _deque_.f_val = f_val;
+    _deque_.alloc = alloc;
+    _deque_.callbacks = callbacks;
+    _deque_.growth = ((void *)0);
+    return _deque_;
+}
+void sd_clear(struct segdeque *_deque_)
+{
+    if (_deque_->f_val->free)
+    {
+        for (size_t i = 0; i < _deque_->count; i++)
+            _deque_->f_val->free(*sd_impl_at(_deque_, i));
+    }
+    _deque_->blocks = 0;
+    _deque_->front = 0;
+    _deque_->count = 0;
+    _deque_->flag = cmc_flags.OK;
+}
+void sd_free(struct segdeque *_deque_)
+{
+    struct cmc_alloc_node *alloc = _deque_->alloc;
+    sd_release(*_deque_);
+    alloc->free(_deque_);
+}
+void sd_release(struct segdeque _deque_)
+{
+    if (_deque_.f_val->free)
+    {
+        for (size_t i = 0; i < _deque_.count; i++)
+            _deque_.f_val->free(*sd_impl_at(&_deque_, i));
+    }
+    for (size_t i = 0; i < _deque_.map_capacity; i++)
+    {
+        if (_deque_.map[i])
+            _deque_.alloc->free(_deque_.map[i]);
+    }
+    _deque_.alloc->free(_deque_.map);
+}
+void sd_customize(struct segdeque *_deque_, struct cmc_alloc_node *alloc,
+                  struct cmc_callbacks *callbacks)
+{
+    if (!alloc)
+        _deque_->alloc = &cmc_alloc_node_default;
+    else
+        _deque_->alloc = alloc;
+    _deque_->callbacks = callbacks;
+    _deque_->flag = cmc_flags.OK;
+}
+void sd_set_growth(struct segdeque *_deque_, const struct cmc_growth *growth)
+{
+    _deque_->growth = growth;
+    _deque_->flag = cmc_flags.OK;
+}
+_Bool sd_push_front(struct segdeque *_deque_, size_t value)
+{
+    const size_t block_size =
+        (4096 / sizeof(size_t) > 16 ? 4096 / sizeof(size_t) : 16);
+    if (sd_empty(_deque_))
+    {
+        if (!sd_impl_block(_deque_, _deque_->first))
+            return 0;
+        _deque_->blocks = 1;
+        _deque_->front = block_size;
+    }
+    else if (_deque_->front == 0)
+    {
+        if (_deque_->first == 0 && !sd_impl_grow_map(_deque_))
+            return 0;
+        if (!sd_impl_block(_deque_, _deque_->first - 1))
+            return 0;
+        _deque_->first--;
+        _deque_->blocks++;
+        _deque_->front = block_size;
+    }
+    _deque_->front--;
+    _deque_->map[_deque_->first][_deque_->front] = value;
+    _deque_->count++;
+    _deque_->flag = cmc_flags.OK;
+    if (_deque_->callbacks && _deque_->callbacks->create)
+        _deque_->callbacks->create();
+    return 1;
+}
+_Bool sd_push_back(struct segdeque *_deque_, size_t value)
+{
+    const size_t block_size =
+        (4096 / sizeof(size_t) > 16 ? 4096 / sizeof(size_t) : 16);
+    if (sd_empty(_deque_))
+    {
+        if (!sd_impl_block(_deque_, _deque_->first))
+            return 0;
+        _deque_->blocks = 1;
+        _deque_->front = 0;
+    }
+    else if (_deque_->front + _deque_->count == _deque_->blocks * block_size)
+    {
+        if (_deque_->first + _deque_->blocks == _deque_->map_capacity &&
+            !sd_impl_grow_map(_deque_))
+            return 0;
+        if (!sd_impl_block(_deque_, _deque_->first + _deque_->blocks))
+            return 0;
+        _deque_->blocks++;
+    }
+    *sd_impl_at(_deque_, _deque_->count) = value;
+    _deque_->count++;
+    _deque_->flag = cmc_flags.OK;
+    if (_deque_->callbacks && _deque_->callbacks->create)
+        _deque_->callbacks->create();
+    return 1;
+}
+_Bool sd_pop_front(struct segdeque *_deque_)
+{
+    if (sd_empty(_deque_))
+    {
+        _deque_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    _deque_->count--;
+    if (sd_empty(_deque_))
+    {
+        _deque_->blocks = 0;
+        _deque_->front = 0;
+    }
+    else if (++_deque_->front ==
+             (4096 / sizeof(size_t) > 16 ? 4096 / sizeof(size_t) : 16))
+    {
+        _deque_->first++;
+        _deque_->blocks--;
+        _deque_->front = 0;
+    }
+    _deque_->flag = cmc_flags.OK;
+    if (_deque_->callbacks && _deque_->callbacks->delete)
+        _deque_->callbacks->delete ();
+    return 1;
+}
+_Bool sd_pop_back(struct segdeque *_deque_)
+{
+    if (sd_empty(_deque_))
+    {
+        _deque_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    _deque_->count--;
+    if (sd_empty(_deque_))
+    {
+        _deque_->blocks = 0;
+        _deque_->front = 0;
+    }
+    else if ((_deque_->front + _deque_->count) %
+                 (4096 / sizeof(size_t) > 16 ? 4096 / sizeof(size_t) : 16) ==
+             0)
+    {
+        _deque_->blocks--;
+    }
+    _deque_->flag = cmc_flags.OK;
+    if (_deque_->callbacks && _deque_->callbacks->delete)
+        _deque_->callbacks->delete ();
+    return 1;
+}
+_Bool sd_push_back_n(struct segdeque *_deque_, size_t *values, size_t n)
+{
+    const size_t block_size =
+        (4096 / sizeof(size_t) > 16 ? 4096 / sizeof(size_t) : 16);
+    _deque_->flag = cmc_flags.OK;
+    if (n == 0)
+        return 1;
+    if (n > (18446744073709551615UL) - _deque_->front - _deque_->count)
+    {
+        _deque_->flag = cmc_flags.ERROR;
+        return 0;
+    }
+    if (sd_empty(_deque_))
+        _deque_->front = 0;
+    size_t position = _deque_->front + _deque_->count;
+    size_t blocks = (position + n - 1) / block_size + 1;
+    if (_deque_->first + blocks > _deque_->map_capacity)
+    {
+        size_t allocated = _deque_->capacity / block_size;
+        size_t required = blocks * 2 > allocated ? blocks * 2 : allocated;
+        if (!sd_impl_remap(_deque_, cmc_growth_capacity(_deque_->growth,
+                                                        _deque_->map_capacity,
+                                                        required)))
+            return 0;
+    }
+    for (size_t i = _deque_->first + _deque_->blocks;
+         i < _deque_->first + blocks; i++)
+    {
+        if (!sd_impl_block(_deque_, i))
+            return 0;
+    }
+    for (size_t remaining = n; remaining > 0;)
+    {
+        size_t offset = position % block_size;
+        size_t count = block_size - offset;
+        if (count > remaining)
+            count = remaining;
+        memcpy(_deque_->map[_deque_->first + position / block_size] + offset,
+               values, sizeof(size_t) * count);
+        values += count;
+        position += count;
+        remaining -= count;
+    }
+    _deque_->blocks = blocks;
+    _deque_->count += n;
+    if (_deque_->callbacks && _deque_->callbacks->create)
+        _deque_->callbacks->create();
+    return 1;
+}
+size_t sd_pop_front_n(struct segdeque *_deque_, size_t *out, size_t n)
+{
+    const size_t block_size =
+        (4096 / sizeof(size_t) > 16 ? 4096 / sizeof(size_t) : 16);
+    if (sd_empty(_deque_))
+    {
+        _deque_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    if (n > _deque_->count)
+        n = _deque_->count;
+    for (size_t remaining = n; remaining > 0;)
+    {
+        if (_deque_->front == block_size)
+        {
+            _deque_->first++;
+            _deque_->blocks--;
+            _deque_->front = 0;
+        }
+        size_t count = block_size - _deque_->front;
+        if (count > remaining)
+            count = remaining;
+        if (out)
+        {
+            memcpy(out, _deque_->map[_deque_->first] + _deque_->front,
+                   sizeof(size_t) * count);
+            out += count;
+        }
+        _deque_->front += count;
+        remaining -= count;
+    }
+    _deque_->count -= n;
+    if (sd_empty(_deque_))
+    {
+        _deque_->blocks = 0;
+        _deque_->front = 0;
+    }
+    else if (_deque_->front == block_size)
+    {
+        _deque_->first++;
+        _deque_->blocks--;
+        _deque_->front = 0;
+    }
+    _deque_->flag = cmc_flags.OK;
+    if (_deque_->callbacks && _deque_->callbacks->delete)
+        _deque_->callbacks->delete ();
+    return n;
+}
+size_t sd_front(struct segdeque *_deque_)
+{
+    if (sd_empty(_deque_))
+    {
+        _deque_->flag = cmc_flags.EMPTY;
+        return (size_t){ 0 };
+    }
+    _deque_->flag = cmc_flags.OK;
+    if (_deque_->callbacks && _deque_->callbacks->read)
+        _deque_->callbacks->read();
+    return _deque_->map[_deque_->first][_deque_->front];
+}
+size_t sd_back(struct segdeque *_deque_)
+{
+    if (sd_empty(_deque_))
+    {
+        _deque_->flag = cmc_flags.EMPTY;
+        return (size_t){ 0 };
+    }
+    _deque_->flag = cmc_flags.OK;
+    if (_deque_->callbacks && _deque_->callbacks->read)
+        _deque_->callbacks->read();
+    return *sd_impl_at(_deque_, _deque_->count - 1);
+}
+size_t sd_get(struct segdeque *_deque_, size_t index)
+{
+    if (sd_empty(_deque_))
+    {
+        _deque_->flag = cmc_flags.EMPTY;
+        return (size_t){ 0 };
+    }
+    if (index >= _deque_->count)
+    {
+        _deque_->flag = cmc_flags.RANGE;
+        return (size_t){ 0 };
+    }
+    _deque_->flag = cmc_flags.OK;
+    if (_deque_->callbacks && _deque_->callbacks->read)
+        _deque_->callbacks->read();
+    return *sd_impl_at(_deque_, index);
+}
+size_t *sd_get_ref(struct segdeque *_deque_, size_t index)
+{
+    if (sd_empty(_deque_))
+    {
+        _deque_->flag = cmc_flags.EMPTY;
+        return ((void *)0);
+    }
+    if (index >= _deque_->count)
+    {
+        _deque_->flag = cmc_flags.RANGE;
+        return ((void *)0);
+    }
+    _deque_->flag = cmc_flags.OK;
+    if (_deque_->callbacks && _deque_->callbacks->read)
+        _deque_->callbacks->read();
+    return sd_impl_at(_deque_, index);
+}
+_Bool sd_contains(struct segdeque *_deque_, size_t value)
+{
+    _deque_->flag = cmc_flags.OK;
+    _Bool result = 0;
+    size_t position = _deque_->front;
+    size_t remaining = _deque_->count;
+    for (size_t i = _deque_->first; remaining > 0; i++)
+    {
+        size_t count =
+            (4096 / sizeof(size_t) > 16 ? 4096 / sizeof(size_t) : 16) -
+            position;
+        if (count > remaining)
+            count = remaining;
+        if (sd_impl_search(_deque_->map[i] + position, count, value,
+                           _deque_->f_val->cmp) < count)
+        {
+            result = 1;
+            break;
+        }
+        remaining -= count;
+        position = 0;
+    }
+    if (_deque_->callbacks && _deque_->callbacks->read)
+        _deque_->callbacks->read();
+    return result;
+}
+_Bool sd_empty(struct segdeque *_deque_)
+{
+    return _deque_->count == 0;
+}
+_Bool sd_full(struct segdeque *_deque_)
+{
+    return _deque_->count >= _deque_->capacity;
+}
+size_t sd_count(struct segdeque *_deque_)
+{
+    return _deque_->count;
+}
+size_t sd_capacity(struct segdeque *_deque_)
+{
+    return _deque_->capacity;
+}
+int sd_flag(struct segdeque *_deque_)
+{
+    return _deque_->flag;
+}
+_Bool sd_resize(struct segdeque *_deque_, size_t capacity)
+{
+    _deque_->flag = cmc_flags.OK;
+    const size_t block_size =
+        (4096 / sizeof(size_t) > 16 ? 4096 / sizeof(size_t) : 16);
+    if (capacity < _deque_->count)
+    {
+        _deque_->flag = cmc_flags.INVALID;
+        return 0;
+    }
+    size_t required = capacity == 0 ? 1 : (capacity - 1) / block_size + 1;
+    size_t allocated = _deque_->capacity / block_size;
+    if (required < _deque_->blocks)
+        required = _deque_->blocks;
+    if (required > allocated)
+    {
+        if (_deque_->map_capacity < required + 2 &&
+            !sd_impl_remap(_deque_, required + 2))
+            return 0;
+        for (size_t i = _deque_->first + _deque_->blocks;
+             i < _deque_->map_capacity && allocated < required; i++)
+        {
+            if (!_deque_->map[i])
+            {
+                if (!sd_impl_block(_deque_, i))
+                    return 0;
+                allocated++;
+            }
+        }
+        for (size_t i = _deque_->first; i > 0 && allocated < required; i--)
+        {
+            if (!_deque_->map[i - 1])
+            {
+                if (!sd_impl_block(_deque_, i - 1))
+                    return 0;
+                allocated++;
+            }
+        }
+    }
+    else if (required < allocated)
+    {
+        for (size_t i = 0; i < _deque_->first && allocated > required; i++)
+        {
+            if (_deque_->map[i])
+            {
+                _deque_->alloc->free(_deque_->map[i]);
+                _deque_->map[i] = ((void *)0);
+                allocated--;
+            }
+        }
+        for (size_t i = _deque_->map_capacity;
+             i > _deque_->first + _deque_->blocks && allocated > required; i--)
+        {
+            if (_deque_->map[i - 1])
+            {
+                _deque_->alloc->free(_deque_->map[i - 1]);
+                _deque_->map[i - 1] = ((void *)0);
+                allocated--;
+            }
+        }
+        _deque_->capacity = allocated * block_size;
+    }
+    if (_deque_->callbacks && _deque_->callbacks->resize)
+        _deque_->callbacks->resize();
+    return 1;
+}
+_Bool sd_reserve(struct segdeque *_deque_, size_t size)
+{
+    _deque_->flag = cmc_flags.OK;
+    if (size <= _deque_->capacity - _deque_->count)
+        return 1;
+    if (size > (18446744073709551615UL) - _deque_->count)
+    {
+        _deque_->flag = cmc_flags.ERROR;
+        return 0;
+    }
+    return sd_resize(_deque_, _deque_->count + size);
+}
+_Bool sd_shrink_to_fit(struct segdeque *_deque_)
+{
+    if (!sd_resize(_deque_, _deque_->count))
+        return 0;
+    size_t allocated =
+        _deque_->capacity /
+        (4096 / sizeof(size_t) > 16 ? 4096 / sizeof(size_t) : 16);
+    if (_deque_->map_capacity > allocated + 2)
+        return sd_impl_remap(_deque_, allocated + 2);
+    return 1;
+}
+struct segdeque *sd_copy_of(struct segdeque *_deque_)
+{
+    const size_t block_size =
+        (4096 / sizeof(size_t) > 16 ? 4096 / sizeof(size_t) : 16);
+    struct segdeque *result = sd_new_custom(_deque_->capacity, _deque_->f_val,
+                                            _deque_->alloc, _deque_->callbacks);
+    if (!result)
+    {
+        _deque_->flag = cmc_flags.ERROR;
+        return ((void *)0);
+    }
+    for (size_t i = 0; i < _deque_->count; i++)
+    {
+        size_t value = *sd_impl_at(_deque_, i);
+        if (_deque_->f_val->cpy)
+            value = _deque_->f_val->cpy(value);
+        result->map[1 + i / block_size][i % block_size] = value;
+    }
+    result->count = _deque_->count;
+    result->blocks =
+        _deque_->count == 0 ? 0 : (_deque_->count - 1) / block_size + 1;
+    result->growth = _deque_->growth;
+    _deque_->flag = cmc_flags.OK;
+    return result;
+}
+_Bool sd_equals(struct segdeque *_deque1_, struct segdeque *_deque2_)
+{
+    _deque1_->flag = cmc_flags.OK;
+    _deque2_->flag = cmc_flags.OK;
+    if (_deque1_->count != _deque2_->count)
+        return 0;
+    for (size_t i = 0; i < _deque1_->count; i++)
+    {
+        if (_deque1_->f_val->cmp(*sd_impl_at(_deque1_, i),
+                                 *sd_impl_at(_deque2_, i)) != 0)
+            return 0;
+    }
+    return 1;
+}
+struct cmc_string sd_to_string(struct segdeque *_deque_)
+{
+    struct cmc_string str;
+    struct segdeque *d_ = _deque_;
+    int n = snprintf(str.s, cmc_string_len, cmc_string_fmt_segdeque, "segdeque",
+                     "size_t", d_, d_->map, d_->map_capacity, d_->first,
+                     d_->blocks, d_->front, d_->capacity, d_->count, d_->flag,
+                     d_->f_val, d_->alloc, d_->callbacks);
+    return n >= 0 ? str : (struct cmc_string){ 0 };
+}
+_Bool sd_print(struct segdeque *_deque_, FILE *fptr)
+{
+    for (size_t i = 0; i < _deque_->count; i++)
+    {
+        if (!_deque_->f_val->str(fptr, *sd_impl_at(_deque_, i)))
+            return 0;
+    }
+    return 1;
+}
+struct segdeque_iter sd_iter_start(struct segdeque *target)
+{
+    struct segdeque_iter iter;
+    iter.target = target;
+    iter.block = target->first;
+    iter.offset = target->front;
+    iter.index = 0;
+    iter.start = 1;
+    iter.end = sd_empty(target);
+    return iter;
+}
+struct segdeque_iter sd_iter_end(struct segdeque *target)
+{
+    struct segdeque_iter iter;
+    iter.target = target;
+    if (!sd_empty(target))
+        sd_impl_iter_seek(&iter, target->count - 1);
+    else
+    {
+        iter.block = target->first;
+        iter.offset = target->front;
+        iter.index = 0;
+    }
+    iter.start = sd_empty(target);
+    iter.end = 1;
+    return iter;
+}
+_Bool sd_iter_at_start(struct segdeque_iter *iter)
+{
+    return sd_empty(iter->target) || iter->start;
+}
+_Bool sd_iter_at_end(struct segdeque_iter *iter)
+{
+    return sd_empty(iter->target) || iter->end;
+}
+_Bool sd_iter_to_start(struct segdeque_iter *iter)
+{
+    if (!sd_empty(iter->target))
+    {
+        iter->block = iter->target->first;
+        iter->offset = iter->target->front;
+        iter->index = 0;
+        iter->start = 1;
+        iter->end = 0;
+        return 1;
+    }
+    return 0;
+}
+_Bool sd_iter_to_end(struct segdeque_iter *iter)
+{
+    if (!sd_empty(iter->target))
+    {
+        sd_impl_iter_seek(iter, iter->target->count - 1);
+        iter->start = 0;
+        iter->end = 1;
+        return 1;
+    }
+    return 0;
+}
+_Bool sd_iter_next(struct segdeque_iter *iter)
+{
+    if (iter->end)
+        return 0;
+    if (iter->index + 1 == iter->target->count)
+    {
+        iter->end = 1;
+        return 0;
+    }
+    iter->start = sd_empty(iter->target);
+    if (++iter->offset ==
+        (4096 / sizeof(size_t) > 16 ? 4096 / sizeof(size_t) : 16))
+    {
+        iter->block++;
+        iter->offset = 0;
+    }
+    iter->index++;
+    return 1;
+}
+_Bool sd_iter_prev(struct segdeque_iter *iter)
+{
+    if (iter->start)
+        return 0;
+    if (iter->index == 0)
+    {
+        iter->start = 1;
+        return 0;
+    }
+    iter->end = sd_empty(iter->target);
+    if (iter->offset == 0)
+    {
+        iter->block--;
+        iter->offset =
+            (4096 / sizeof(size_t) > 16 ? 4096 / sizeof(size_t) : 16);
+    }
+    iter->offset--;
+    iter->index--;
+    return 1;
+}
+_Bool sd_iter_advance(struct segdeque_iter *iter, size_t steps)
+{
+    if (iter->end)
+        return 0;
+    if (iter->index + 1 == iter->target->count)
+    {
+        iter->end = 1;
+        return 0;
+    }
+    if (steps == 0 || iter->index + steps >= iter->target->count)
+        return 0;
+    iter->start = sd_empty(iter->target);
+    sd_impl_iter_seek(iter, iter->index + steps);
+    return 1;
+}
+_Bool sd_iter_rewind(struct segdeque_iter *iter, size_t steps)
+{
+    if (iter->start)
+        return 0;
+    if (iter->index == 0)
+    {
+        iter->start = 1;
+        return 0;
+    }
+    if (steps == 0 || iter->index < steps)
+        return 0;
+    iter->end = sd_empty(iter->target);
+    sd_impl_iter_seek(iter, iter->index - steps);
+    return 1;
+}
+_Bool sd_iter_go_to(struct segdeque_iter *iter, size_t index)
+{
+    if (index >= iter->target->count)
+        return 0;
+    if (iter->index > index)
+        return sd_iter_rewind(iter, iter->index - index);
+    else if (iter->index < index)
+        return sd_iter_advance(iter, index - iter->index);
+    return 1;
+}
+size_t sd_iter_value(struct segdeque_iter *iter)
+{
+    if (sd_empty(iter->target))
+        return (size_t){ 0 };
+    return iter->target->map[iter->block][iter->offset];
+}
+size_t *sd_iter_rvalue(struct segdeque_iter *iter)
+{
+    if (sd_empty(iter->target))
+        return ((void *)0);
+    return &(iter->target->map[iter->block][iter->offset]);
+}
+size_t sd_iter_index(struct segdeque_iter *iter)
+{
+    return iter->index;
+}
+static size_t *sd_impl_at(struct segdeque *_deque_, size_t index)
+{
+    size_t position = _deque_->front + index;
+    return _deque_->map[_deque_->first + position / (4096 / sizeof(size_t) > 16
+                                                         ? 4096 / sizeof(size_t)
+                                                         : 16)] +
+           position % (4096 / sizeof(size_t) > 16 ? 4096 / sizeof(size_t) : 16);
+}
+static _Bool sd_impl_block(struct segdeque *_deque_, size_t index)
+{
+    if (_deque_->map[index])
+        return 1;
+    size_t *block = _deque_->alloc->malloc(
+        sizeof(size_t) *
+        (4096 / sizeof(size_t) > 16 ? 4096 / sizeof(size_t) : 16));
+    if (!block)
+    {
+        _deque_->flag = cmc_flags.ALLOC;
+        return 0;
+    }
+    _deque_->map[index] = block;
+    _deque_->capacity +=
+        (4096 / sizeof(size_t) > 16 ? 4096 / sizeof(size_t) : 16);
+    return 1;
+}
+static _Bool sd_impl_remap(struct segdeque *_deque_, size_t map_capacity)
+{
+    size_t **new_map = _deque_->alloc->calloc(map_capacity, sizeof(size_t *));
+    if (!new_map)
+    {
+        _deque_->flag = cmc_flags.ALLOC;
+        return 0;
+    }
+    size_t first = (map_capacity - _deque_->blocks) / 2;
+    memcpy(new_map + first, _deque_->map + _deque_->first,
+           sizeof(size_t *) * _deque_->blocks);
+    size_t after = first + _deque_->blocks;
+    size_t before = first;
+    for (size_t i = 0; i < _deque_->map_capacity; i++)
+    {
+        if (i >= _deque_->first && i < _deque_->first + _deque_->blocks)
+            continue;
+        if (!_deque_->map[i])
+            continue;
+        if (after < map_capacity)
+            new_map[after++] = _deque_->map[i];
+        else
+            new_map[--before] = _deque_->map[i];
+    }
+    _deque_->alloc->free(_deque_->map);
+    _deque_->map = new_map;
+    _deque_->map_capacity = map_capacity;
+    _deque_->first = first;
+    return 1;
+}
+static _Bool sd_impl_grow_map(struct segdeque *_deque_)
+{
+    size_t map_capacity = _deque_->map_capacity;
+    if (_deque_->blocks > map_capacity / 2)
+    {
+        map_capacity = cmc_growth_capacity(_deque_->growth, map_capacity,
+                                           _deque_->blocks + 2);
+    }
+    return sd_impl_remap(_deque_, map_capacity);
+}
+static void sd_impl_iter_seek(struct segdeque_iter *iter, size_t index)
+{
+    size_t position = iter->target->front + index;
+    iter->block =
+        iter->target->first +
+        position / (4096 / sizeof(size_t) > 16 ? 4096 / sizeof(size_t) : 16);
+    iter->offset =
+        position % (4096 / sizeof(size_t) > 16 ? 4096 / sizeof(size_t) : 16);
+    iter->index = index;
+}
+
+#endif /* CMC_TEST_SRC_SEGDEQUE */
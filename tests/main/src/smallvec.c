@@ -0,0 +1,1109 @@
+#ifndef CMC_TEST_SRC_SMALLVEC
+#define CMC_TEST_SRC_SMALLVEC
+
+#include "cmc/smallvec.h"
+
+struct smallvec
+{
+    size_t *buffer;
+    size_t capacity;
+    size_t count;
+    int flag;
+    struct smallvec_fval *f_val;
+    struct cmc_alloc_node *alloc;
+    struct cmc_callbacks *callbacks;
+    const struct cmc_growth *growth;
+    size_t storage[8];
+};
+struct smallvec_fval
+{
+    int (*cmp)(size_t, size_t);
+    size_t (*cpy)(size_t);
+    _Bool (*str)(FILE *, size_t);
+    void (*free)(size_t);
+    size_t (*hash)(size_t);
+    int (*pri)(size_t, size_t);
+};
+struct smallvec_iter
+{
+    struct smallvec *target;
+    size_t cursor;
+    _Bool start;
+    _Bool end;
+};
+struct smallvec *sv_new(size_t capacity, struct smallvec_fval *f_val);
+struct smallvec *sv_new_custom(size_t capacity, struct smallvec_fval *f_val,
+                               struct cmc_alloc_node *alloc,
+                               struct cmc_callbacks *callbacks);
+struct smallvec sv_init(size_t capacity, struct smallvec_fval *f_val);
+struct smallvec sv_init_custom(size_t capacity, struct smallvec_fval *f_val,
+                               struct cmc_alloc_node *alloc,
+                               struct cmc_callbacks *callbacks);
+void sv_clear(struct smallvec *_vec_);
+void sv_free(struct smallvec *_vec_);
+void sv_release(struct smallvec _vec_);
+void sv_customize(struct smallvec *_vec_, struct cmc_alloc_node *alloc,
+                  struct cmc_callbacks *callbacks);
+void sv_set_growth(struct smallvec *_vec_, const struct cmc_growth *growth);
+_Bool sv_push_front(struct smallvec *_vec_, size_t value);
+_Bool sv_push_at(struct smallvec *_vec_, size_t value, size_t index);
+_Bool sv_push_back(struct smallvec *_vec_, size_t value);
+_Bool sv_pop_front(struct smallvec *_vec_);
+_Bool sv_pop_at(struct smallvec *_vec_, size_t index);
+_Bool sv_pop_back(struct smallvec *_vec_);
+_Bool sv_seq_push_front(struct smallvec *_vec_, size_t *values, size_t size);
+_Bool sv_seq_push_at(struct smallvec *_vec_, size_t *values, size_t size,
+                     size_t index);
+_Bool sv_seq_push_back(struct smallvec *_vec_, size_t *values, size_t size);
+_Bool sv_seq_pop_at(struct smallvec *_vec_, size_t from, size_t to);
+struct smallvec *sv_seq_sublist(struct smallvec *_vec_, size_t from, size_t to);
+size_t sv_front(struct smallvec *_vec_);
+size_t sv_get(struct smallvec *_vec_, size_t index);
+size_t *sv_get_ref(struct smallvec *_vec_, size_t index);
+size_t sv_back(struct smallvec *_vec_);
+size_t sv_index_of(struct smallvec *_vec_, size_t value, _Bool from_start);
+_Bool sv_contains(struct smallvec *_vec_, size_t value);
+_Bool sv_empty(struct smallvec *_vec_);
+_Bool sv_full(struct smallvec *_vec_);
+size_t sv_count(struct smallvec *_vec_);
+_Bool sv_fits(struct smallvec *_vec_, size_t size);
+size_t sv_capacity(struct smallvec *_vec_);
+_Bool sv_is_inline(struct smallvec *_vec_);
+int sv_flag(struct smallvec *_vec_);
+_Bool sv_resize(struct smallvec *_vec_, size_t capacity);
+_Bool sv_reserve(struct smallvec *_vec_, size_t size);
+_Bool sv_shrink_to_fit(struct smallvec *_vec_);
+void sv_sort(struct smallvec *_vec_);
+_Bool sv_sort_range(struct smallvec *_vec_, size_t from, size_t to);
+struct smallvec *sv_copy_of(struct smallvec *_vec_);
+_Bool sv_equals(struct smallvec *_vec1_, struct smallvec *_vec2_);
+struct cmc_string sv_to_string(struct smallvec *_vec_);
+_Bool sv_print(struct smallvec *_vec_, FILE *fptr);
+struct smallvec_iter sv_iter_start(struct smallvec *target);
+struct smallvec_iter sv_iter_end(struct smallvec *target);
+_Bool sv_iter_at_start(struct smallvec_iter *iter);
+_Bool sv_iter_at_end(struct smallvec_iter *iter);
+_Bool sv_iter_to_start(struct smallvec_iter *iter);
+_Bool sv_iter_to_end(struct smallvec_iter *iter);
+_Bool sv_iter_next(struct smallvec_iter *iter);
+_Bool sv_iter_prev(struct smallvec_iter *iter);
+_Bool sv_iter_advance(struct smallvec_iter *iter, size_t steps);
+_Bool sv_iter_rewind(struct smallvec_iter *iter, size_t steps);
+_Bool sv_iter_go_to(struct smallvec_iter *iter, size_t index);
+size_t sv_iter_value(struct smallvec_iter *iter);
+size_t *sv_iter_rvalue(struct smallvec_iter *iter);
+size_t sv_iter_index(struct smallvec_iter *iter);
+static inline size_t sv_impl_search(size_t *array, size_t count, size_t value,
+                                    int (*cmp)(size_t, size_t))
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (cmp(array[i], value) == 0)
+            return i;
+    }
+    return count;
+}
+static inline size_t sv_impl_search_last(size_t *array, size_t count,
+                                         size_t value,
+                                         int (*cmp)(size_t, size_t))
+{
+    for (size_t i = count; i > 0; i--)
+    {
+        if (cmp(array[i - 1], value) == 0)
+            return i - 1;
+    }
+    return count;
+}
+static size_t *sv_impl_buffer(struct smallvec *_vec_);
+static void sv_impl_sort_array(struct smallvec *_vec_, size_t *array,
+                               size_t count);
+struct smallvec *sv_new(size_t capacity, struct smallvec_fval *f_val)
+{
+    return sv_new_custom(capacity, f_val, ((void *)0), ((void *)0));
+}
+struct smallvec *sv_new_custom(size_t capacity, struct smallvec_fval *f_val,
+                               struct cmc_alloc_node *alloc,
+                               struct cmc_callbacks *callbacks)
+{
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+    struct smallvec *_vec_ = alloc->malloc(sizeof(struct smallvec));
+    if (!_vec_)
+        return ((void *)0);
+    *_vec_ = sv_init_custom(capacity, f_val, alloc, callbacks);
+    if (!_vec_->f_val)
+    {
+        alloc->free(_vec_);
+        return ((void *)0);
+    }
+    return _vec_;
+}
+struct smallvec sv_init(size_t capacity, struct smallvec_fval *f_val)
+{
+    return sv_init_custom(capacity, f_val, ((void *)0), ((void *)0));
+}
+struct smallvec sv_init_custom(size_t capacity, struct smallvec_fval *f_val,
+                               struct cmc_alloc_node *alloc,
+                               struct cmc_callbacks *callbacks)
+{
+    struct smallvec _vec_ = { 0 };
+    if (capacity < 1)
+        return _vec_;
+    if (!f_val)
+        return _vec_;
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+    if (capacity > 8)
+    {
+        _vec_.buffer = alloc->calloc(capacity, sizeof(size_t));
+        if (!_vec_.buffer)
+            return _vec_;
+    }
+    else
+        capacity = 8;
+    _vec_.capacity = capacity;
+    _vec_.count = 0;
+    _vec_.flag = cmc_flags.OK;
+    _vec_.f_val = f_val;
+    _vec_.alloc = alloc;
+    _vec_.callbacks = callbacks;
+    _vec_.growth = ((void *)0);
+    return _vec_;
+}
+void sv_clear(struct smallvec *_vec_)
+{
+    size_t *buffer = sv_impl_buffer(_vec_);
+    if (_vec_->f_val->free)
+    {
+        for (size_t i = 0; i < _vec_->count; i++)
+            _vec_->f_val->free(buffer[i]);
+    }
+    memset(buffer, 0, sizeof(size_t) * _vec_->capacity);
+    _vec_->count = 0;
+    _vec_->flag = cmc_flags.OK;
+}
+void sv_free(struct smallvec *_vec_)
+{
+    sv_release(*_vec_);
+    _vec_->alloc->free(_vec_);
+}
+void sv_release(struct smallvec _vec_)
+{
+    size_t *buffer = sv_impl_buffer(&_vec_);
+    if (_vec_.f_val->free)
+    {
+        for (size_t i = 0; i < _vec_.count; i++)
+            _vec_.f_val->free(buffer[i]);
+    }
+    if (_vec_.capacity > 8)
+        _vec_.alloc->free(_vec_.buffer);
+}
+void sv_customize(struct smallvec *_vec_, struct cmc_alloc_node *alloc,
+                  struct cmc_callbacks *callbacks)
+{
+    if (!alloc)
+        _vec_->alloc = &cmc_alloc_node_default;
+    else
+        _vec_->alloc = alloc;
+    _vec_->callbacks = callbacks;
+    _vec_->flag = cmc_flags.OK;
+}
+void sv_set_growth(struct smallvec *_vec_, const struct cmc_growth *growth)
+{
+    _vec_->growth = growth;
+    _vec_->flag = cmc_flags.OK;
+}
+_Bool sv_push_front(struct smallvec *_vec_, size_t value)
+{
+    if (sv_full(_vec_))
+    {
+        if (!sv_reserve(_vec_, 1))
+            return 0;
+    }
+    size_t *buffer = sv_impl_buffer(_vec_);
+    if (!sv_empty(_vec_))
+        memmove(buffer + 1, buffer, _vec_->count * sizeof(size_t));
+    buffer[0] = value;
+    _vec_->count++;
+    _vec_->flag = cmc_flags.OK;
+    if (_vec_->callbacks && _vec_->callbacks->create)
+        _vec_->callbacks->create();
+    return 1;
+}
+_Bool sv_push_at(struct smallvec *_vec_, size_t value, size_t index)
+{
+    if (index > _vec_->count)
+    {
+        _vec_->flag = cmc_flags.RANGE;
+        return 0;
+    }
+    if (sv_full(_vec_))
+    {
+        if (!sv_reserve(_vec_, 1))
+            return 0;
+    }
+    size_t *buffer = sv_impl_buffer(_vec_);
+    memmove(buffer + index + 1, buffer + index,
+            (_vec_->count - index) * sizeof(size_t));
+    buffer[index] = value;
+    _vec_->count++;
+    _vec_->flag = cmc_flags.OK;
+    if (_vec_->callbacks && _vec_->callbacks->create)
+        _vec_->callbacks->create();
+    return 1;
+}
+_Bool sv_push_back(struct smallvec *_vec_, size_t value)
+{
+    if (sv_full(_vec_))
+    {
+        if (!sv_reserve(_vec_, 1))
+            return 0;
+    }
+    sv_impl_buffer(_vec_)[_vec_->count++] = value;
+    _vec_->flag = cmc_flags.OK;
+    if (_vec_->callbacks && _vec_->callbacks->create)
+        _vec_->callbacks->create();
+    return 1;
+}
+_Bool sv_pop_front(struct smallvec *_vec_)
+{
+    if (sv_empty(_vec_))
+    {
+        _vec_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    size_t *buffer = sv_impl_buffer(_vec_);
+    memmove(buffer, buffer + 1, (_vec_->count - 1) * sizeof(size_t));
+    buffer[--_vec_->count] = (size_t){ 0 };
+    _vec_->flag = cmc_flags.OK;
+    if (_vec_->callbacks && _vec_->callbacks->delete)
+        _vec_->callbacks->delete ();
+    return 1;
+}
+_Bool sv_pop_at(struct smallvec *_vec_, size_t index)
+{
+    if (sv_empty(_vec_))
+    {
+        _vec_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    if (index >= _vec_->count)
+    {
+        _vec_->flag = cmc_flags.RANGE;
+        return 0;
+    }
+    size_t *buffer = sv_impl_buffer(_vec_);
+    memmove(buffer + index, buffer + index + 1,
+            (_vec_->count - index - 1) * sizeof(size_t));
+    buffer[--_vec_->count] = (size_t){ 0 };
+    _vec_->flag = cmc_flags.OK;
+    if (_vec_->callbacks && _vec_->callbacks->delete)
+        _vec_->callbacks->delete ();
+    return 1;
+}
+_Bool sv_pop_back(struct smallvec *_vec_)
+{
+    if (sv_empty(_vec_))
+    {
+        _vec_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    sv_impl_buffer(_vec_)[--_vec_->count] = (size_t){ 0 };
+    _vec_->flag = cmc_flags.OK;
+    if (_vec_->callbacks && _vec_->callbacks->delete)
+        _vec_->callbacks->delete ();
+    return 1;
+}
+_Bool sv_seq_push_front(struct smallvec *_vec_, size_t *values, size_t size)
+{
+    if (size == 0)
+    {
+        _vec_->flag = cmc_flags.INVALID;
+        return 0;
+    }
+    if (!sv_fits(_vec_, size))
+    {
+        if (!sv_reserve(_vec_, size))
+            return 0;
+    }
+    size_t *buffer = sv_impl_buffer(_vec_);
+    memmove(buffer + size, buffer, _vec_->count * sizeof(size_t));
+    memcpy(buffer, values, size * sizeof(size_t));
+    _vec_->count += size;
+    _vec_->flag = cmc_flags.OK;
+    if (_vec_->callbacks && _vec_->callbacks->create)
+        _vec_->callbacks->create();
+    return 1;
+}
+_Bool sv_seq_push_at(struct smallvec *_vec_, size_t *values, size_t size,
+                     size_t index)
+{
+    if (size == 0)
+    {
+        _vec_->flag = cmc_flags.INVALID;
+        return 0;
+    }
+    if (index > _vec_->count)
+    {
+        _vec_->flag = cmc_flags.RANGE;
+        return 0;
+    }
+    if (index == 0)
+        return sv_seq_push_front(_vec_, values, size);
+    else if (index == _vec_->count)
+        return sv_seq_push_back(_vec_, values, size);
+    if (!sv_fits(_vec_, size))
+    {
+        if (!sv_reserve(_vec_, size))
+            return 0;
+    }
+    size_t *buffer = sv_impl_buffer(_vec_);
+    memmove(buffer + index + size, buffer + index,
+            (_vec_->count - index) * sizeof(size_t));
+    memcpy(buffer + index, values, size * sizeof(size_t));
+    _vec_->count += size;
+    _vec_->flag = cmc_flags.OK;
+    if (_vec_->callbacks && _vec_->callbacks->create)
+        _vec_->callbacks->create();
+    return 1;
+}
+_Bool sv_seq_push_back(struct smallvec *_vec_, size_t *values, size_t size)
+{
+    if (size == 0)
+    {
+        _vec_->flag = cmc_flags.INVALID;
+        return 0;
+    }
+    if (!sv_fits(_vec_, size))
+    {
+        if (!sv_reserve(_vec_, size))
+            return 0;
+    }
+    memcpy(sv_impl_buffer(_vec_) + _vec_->count, values, size * sizeof(size_t));
+    _vec_->count += size;
+    _vec_->flag = cmc_flags.OK;
+    if (_vec_->callbacks && _vec_->callbacks->create)
+        _vec_->callbacks->create();
+    return 1;
+}
+_Bool sv_seq_pop_at(struct smallvec *_vec_, size_t from, size_t to)
+{
+    if (from > to)
+    {
+        _vec_->flag = cmc_flags.INVALID;
+        return 0;
+    }
+    if (to >= _vec_->count)
+    {
+        _vec_->flag = cmc_flags.RANGE;
+        return 0;
+    }
+    size_t *buffer = sv_impl_buffer(_vec_);
+    size_t length = (to - from + 1);
+    memmove(buffer + from, buffer + to + 1,
+            (_vec_->count - to - 1) * sizeof(size_t));
+    memset(buffer + _vec_->count - length, 0, length * sizeof(size_t));
+    _vec_->count -= length;
+    _vec_->flag = cmc_flags.OK;
+    if (_vec_->callbacks && _vec_->callbacks->delete)
+        _vec_->callbacks->delete ();
+    return 1;
+}
+struct smallvec *sv_seq_sublist(struct smallvec *_vec_, size_t from, size_t to)
+{
+    if (from > to)
+    {
+        _vec_->flag = cmc_flags.INVALID;
+        return ((void *)0);
+    }
+    if (to >= _vec_->count)
+    {
+        _vec_->flag = cmc_flags.RANGE;
+        return ((void *)0);
+    }
+    size_t length = to - from + 1;
+    struct smallvec *result =
+        sv_new_custom(length, _vec_->f_val, _vec_->alloc, _vec_->callbacks);
+    if (!result)
+    {
+        _vec_->flag = cmc_flags.ALLOC;
+        return ((void *)0);
+    }
+    size_t *buffer = sv_impl_buffer(_vec_);
+    memcpy(sv_impl_buffer(result), buffer + from, length * sizeof(size_t));
+    memmove(buffer + from, buffer + to + 1,
+            (_vec_->count - to - 1) * sizeof(size_t));
+    memset(buffer + _vec_->count - length, 0, length * sizeof(size_t));
+    _vec_->count -= length;
+    result->count = length;
+    _vec_->flag = cmc_flags.OK;
+    if (_vec_->callbacks && _vec_->callbacks->delete)
+        _vec_->callbacks->delete ();
+    return result;
+}
+size_t sv_front(struct smallvec *_vec_)
+{
+    if (sv_empty(_vec_))
+    {
+        _vec_->flag = cmc_flags.EMPTY;
+        return (size_t){ 0 };
+    }
+    _vec_->flag = cmc_flags.OK;
+    if (_vec_->callbacks && _vec_->callbacks->read)
+        _vec_->callbacks->read();
+    return sv_impl_buffer(_vec_)[0];
+}
+size_t sv_get(struct smallvec *_vec_, size_t index)
+{
+    if (sv_empty(_vec_))
+    {
+        _vec_->flag = cmc_flags.EMPTY;
+        return (size_t){ 0 };
+    }
+    if (index >= _vec_->count)
+    {
+        _vec_->flag = cmc_flags.RANGE;
+        return (size_t){ 0 };
+    }
+    _vec_->flag = cmc_flags.OK;
+    if (_vec_->callbacks && _vec_->callbacks->read)
+        _vec_->callbacks->read();
+    return sv_impl_buffer(_vec_)[index];
+}
+size_t *sv_get_ref(struct smallvec *_vec_, size_t index)
+{
+    if (sv_empty(_vec_))
+    {
+        _vec_->flag = cmc_flags.EMPTY;
+        return ((void *)0);
+    }
+    if (index >= _vec_->count)
+    {
+        _vec_->flag = cmc_flags.RANGE;
+        return ((void *)0);
+    }
+    _vec_->flag = cmc_flags.OK;
+    if (_vec_->callbacks && _vec_->callbacks->read)
+        _vec_->callbacks->read();
+    return &(sv_impl_buffer(_vec_)[index]);
+}
+size_t sv_back(struct smallvec *_vec_)
+{
+    if (sv_empty(_vec_))
+    {
+        _vec_->flag = cmc_flags.EMPTY;
+        return (size_t){ 0 };
+    }
+    _vec_->flag = cmc_flags.OK;
+    if (_vec_->callbacks && _vec_->callbacks->read)
+        _vec_->callbacks->read();
+    return sv_impl_buffer(_vec_)[_vec_->count - 1];
+}
+size_t sv_index_of(struct smallvec *_vec_, size_t value, _Bool from_start)
+{
+    _vec_->flag = cmc_flags.OK;
+    size_t *buffer = sv_impl_buffer(_vec_);
+    size_t result;
+    if (from_start)
+        result = sv_impl_search(buffer, _vec_->count, value, _vec_->f_val->cmp);
+    else
+        result =
+            sv_impl_search_last(buffer, _vec_->count, value, _vec_->f_val->cmp);
+    if (_vec_->callbacks && _vec_->callbacks->read)
+        _vec_->callbacks->read();
+    return result;
+}
+_Bool sv_contains(struct smallvec *_vec_, size_t value)
+{
+    _vec_->flag = cmc_flags.OK;
+    _Bool result = sv_impl_search(sv_impl_buffer(_vec_), _vec_->count, value,
+                                  _vec_->f_val->cmp) < _vec_->count;
+    if (_vec_->callbacks && _vec_->callbacks->read)
+        _vec_->callbacks->read();
+    return result;
+}
+_Bool sv_empty(struct smallvec *_vec_)
+{
+    return _vec_->count == 0;
+}
+_Bool sv_full(struct smallvec *_vec_)
+{
+    return _vec_->count >= _vec_->capacity;
+}
+size_t sv_count(struct smallvec *_vec_)
+{
+    return _vec_->count;
+}
+_Bool sv_fits(struct smallvec *_vec_, size_t size)
+{
+    return _vec_->count + size <= _vec_->capacity;
+}
+size_t sv_capacity(struct smallvec *_vec_)
+{
+    return _vec_->capacity;
+}
+_Bool sv_is_inline(struct smallvec *_vec_)
+{
+    return _vec_->capacity <= 8;
+}
+int sv_flag(struct smallvec *_vec_)
+{
+    return _vec_->flag;
+}
+_Bool sv_resize(struct smallvec *_vec_, size_t capacity)
+{
+    _vec_->flag = cmc_flags.OK;
+    if (capacity < 8)
+        capacity = 8;
+    if (_vec_->capacity == capacity)
+        return 1;
+    if (capacity < _vec_->count)
+    {
+        _vec_->flag = cmc_flags.INVALID;
+        return 0;
+    }
+    if (capacity == 8)
+    {
+        memcpy(_vec_->storage, _vec_->buffer, sizeof(size_t) * _vec_->count);
+        memset(_vec_->storage + _vec_->count, 0,
+               sizeof(size_t) * (8 - _vec_->count));
+        _vec_->alloc->free(_vec_->buffer);
+        _vec_->buffer = ((void *)0);
+    }
+    else if (_vec_->capacity == 8)
+    {
+        size_t *new_buffer = _vec_->alloc->malloc(sizeof(size_t) * capacity);
+        if (!new_buffer)
+        {
+            _vec_->flag = cmc_flags.ALLOC;
+            return 0;
+        }
+        memcpy(new_buffer, _vec_->storage, sizeof(size_t) * _vec_->count);
+        _vec_->buffer = new_buffer;
+    }
+    else
+    {
+        size_t *new_buffer =
+            _vec_->alloc->realloc(_vec_->buffer, sizeof(size_t) * capacity);
+        if (!new_buffer)
+        {
+            _vec_->flag = cmc_flags.ALLOC;
+            return 0;
+        }
+        _vec_->buffer = new_buffer;
+    }
+    _vec_->capacity = capacity;
+    if (_vec_->callbacks && _vec_->callbacks->resize)
+        _vec_->callbacks->resize();
+    return 1;
+}
+_Bool sv_reserve(struct smallvec *_vec_, size_t size)
+{
+    _vec_->flag = cmc_flags.OK;
+    if (size <= _vec_->capacity - _vec_->count)
+        return 1;
+    if (size > (18446744073709551615UL) - _vec_->count)
+    {
+        _vec_->flag = cmc_flags.ERROR;
+        return 0;
+    }
+    return sv_resize(_vec_, cmc_growth_capacity(_vec_->growth, _vec_->capacity,
+                                                _vec_->count + size));
+}
+_Bool sv_shrink_to_fit(struct smallvec *_vec_)
+{
+    return sv_resize(_vec_, _vec_->count > 0 ? _vec_->count : 1);
+}
+void sv_sort(struct smallvec *_vec_)
+{
+    sv_impl_sort_array(_vec_, sv_impl_buffer(_vec_), _vec_->count);
+    _vec_->flag = cmc_flags.OK;
+    if (_vec_->callbacks && _vec_->callbacks->update)
+        _vec_->callbacks->update();
+}
+_Bool sv_sort_range(struct smallvec *_vec_, size_t from, size_t to)
+{
+    if (from > to)
+    {
+        _vec_->flag = cmc_flags.INVALID;
+        return 0;
+    }
+    if (to >= _vec_->count)
+    {
+        _vec_->flag = cmc_flags.RANGE;
+        return 0;
+    }
+    sv_impl_sort_array(_vec_, sv_impl_buffer(_vec_) + from, to - from + 1);
+    _vec_->flag = cmc_flags.OK;
+    if (_vec_->callbacks && _vec_->callbacks->update)
+        _vec_->callbacks->update();
+    return 1;
+}
+struct smallvec *sv_copy_of(struct smallvec *_vec_)
+{
+    struct smallvec *result = sv_new_custom(_vec_->capacity, _vec_->f_val,
+                                            _vec_->alloc, _vec_->callbacks);
+    if (!result)
+    {
+        _vec_->flag = cmc_flags.ALLOC;
+        return ((void *)0);
+    }
+    size_t *buffer = sv_impl_buffer(_vec_);
+    size_t *result_buffer = sv_impl_buffer(result);
+    if (_vec_->f_val->cpy)
+    {
+        for (size_t i = 0; i < _vec_->count; i++)
+            result_buffer[i] = _vec_->f_val->cpy(buffer[i]);
+    }
+    else
+        memcpy(result_buffer, buffer, sizeof(size_t) * _vec_->count);
+    result->count = _vec_->count;
+    result->growth = _vec_->growth;
+    _vec_->flag = cmc_flags.OK;
+    return result;
+}
+_Bool sv_equals(struct smallvec *_vec1_, struct smallvec *_vec2_)
+{
+    _vec1_->flag = cmc_flags.OK;
+    _vec2_->flag = cmc_flags.OK;
+    if (_vec1_->count != _vec2_->count)
+        return 0;
+    size_t *buffer1 = sv_impl_buffer(_vec1_);
+    size_t *buffer2 = sv_impl_buffer(_vec2_);
+    for (size_t i = 0; i < _vec1_->count; i++)
+    {
+        if (_vec1_->f_val->cmp(buffer1[i], buffer2[i]) != 0)
+            return 0;
+    }
+    return 1;
+}
+struct cmc_string sv_to_string(struct smallvec *_vec_)
+{
+    struct cmc_string str;
+    struct smallvec *v_ = _vec_;
+    int n = snprintf(str.s, cmc_string_len, cmc_string_fmt_smallvec, "smallvec",
+                     "size_t", v_, sv_impl_buffer(v_), sv_is_inline(v_),
+                     v_->capacity, v_->count, v_->flag, v_->f_val, v_->alloc,
+                     v_->callbacks);
+    return n >= 0 ? str : (struct cmc_string){ 0 };
+}
+_Bool sv_print(struct smallvec *_vec_, FILE *fptr)
+{
+    size_t *buffer = sv_impl_buffer(_vec_);
+    for (size_t i = 0; i < _vec_->count; i++)
+    {
+        if (!_vec_->f_val->str(fptr, buffer[i]))
+            return 0;
+    }
+    return 1;
+}
+struct smallvec_iter sv_iter_start(struct smallvec *target)
+{
+    struct smallvec_iter iter;
+    iter.target = target;
+    iter.cursor = 0;
+    iter.start = 1;
+    iter.end = sv_empty(target);
+    return iter;
+}
+struct smallvec_iter sv_iter_end(struct smallvec *target)
+{
+    struct smallvec_iter iter;
+    iter.target = target;
+    iter.cursor = 0;
+    iter.start = sv_empty(target);
+    iter.end = 1;
+    if (!sv_empty(target))
+        iter.cursor = target->count - 1;
+    return iter;
+}
+_Bool sv_iter_at_start(struct smallvec_iter *iter)
+{
+    return sv_empty(iter->target) || iter->start;
+}
+_Bool sv_iter_at_end(struct smallvec_iter *iter)
+{
+    return sv_empty(iter->target) || iter->end;
+}
+_Bool sv_iter_to_start(struct smallvec_iter *iter)
+{
+    if (!sv_empty(iter->target))
+    {
+        iter->cursor = 0;
+        iter->start = 1;
+        iter->end = sv_empty(iter->target);
+        return 1;
+    }
+    return 0;
+}
+_Bool sv_iter_to_end(struct smallvec_iter *iter)
+{
+    if (!sv_empty(iter->target))
+    {
+        iter->start = sv_empty(iter->target);
+        iter->cursor = iter->target->count - 1;
+        iter->end = 1;
+        return 1;
+    }
+    return 0;
+}
+_Bool sv_iter_next(struct smallvec_iter *iter)
+{
+    if (iter->end)
+        return 0;
+    if (iter->cursor + 1 == iter->target->count)
+    {
+        iter->end = 1;
+        return 0;
+    }
+    iter->start = sv_empty(iter->target);
+    iter->cursor++;
+    return 1;
+}
+_Bool sv_iter_prev(struct smallvec_iter *iter)
+{
+    if (iter->start)
+        return 0;
+    if (iter->cursor == 0)
+    {
+        iter->start = 1;
+        return 0;
+    }
+    iter->end = sv_empty(iter->target);
+    iter->cursor--;
+    return 1;
+}
+_Bool sv_iter_advance(struct smallvec_iter *iter, size_t steps)
+{
+    if (iter->end)
+        return 0;
+    if (iter->cursor + 1 == iter->target->count)
+    {
+        iter->end = 1;
+        return 0;
+    }
+    if (steps == 0 || iter->cursor + steps >= iter->target->count)
+        return 0;
+    iter->start = sv_empty(iter->target);
+    iter->cursor += steps;
+    return 1;
+}
+_Bool sv_iter_rewind(struct smallvec_iter *iter, size_t steps)
+{
+    if (iter->start)
+        return 0;
+    if (iter->cursor == 0)
+    {
+        iter->start = 1;
+        return 0;
+    }
+    if (steps == 0 || iter->cursor < steps)
+        return 0;
+    iter->end = sv_empty(iter->target);
+    iter->cursor -= steps;
+    return 1;
+}
+_Bool sv_iter_go_to(struct smallvec_iter *iter, size_t index)
+{
+    if (index >= iter->target->count)
+        return 0;
+    if (iter->cursor > index)
+        return sv_iter_rewind(iter, iter->cursor - index);
+    else if (iter->cursor < index)
+        return sv_iter_advance(iter, index - iter->cursor);
+    return 1;
+}
+size_t sv_iter_value(struct smallvec_iter *iter)
+{
+    if (sv_empty(iter->target))
+        return (size_t){ 0 };
+    return sv_impl_buffer(iter->target)[iter->cursor];
+}
+size_t *sv_iter_rvalue(struct smallvec_iter *iter)
+{
+    if (sv_empty(iter->target))
+        return ((void *)0);
+    return &(sv_impl_buffer(iter->target)[iter->cursor]);
+}
+size_t sv_iter_index(struct smallvec_iter *iter)
+{
+    return iter->cursor;
+}
+static size_t *sv_impl_buffer(struct smallvec *_vec_)
+{
+    return _vec_->capacity > 8 ? _vec_->buffer : _vec_->storage;
+}
+static void sv_impl_sort_swap(size_t *a, size_t *b)
+{
+    size_t tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+static void sv_impl_sort_insertion(size_t *begin, size_t *end,
+                                   int (*cmp)(size_t, size_t))
+{
+    if (begin == end)
+        return;
+    for (size_t *cur = begin + 1; cur != end; cur++)
+    {
+        size_t *sift = cur;
+        size_t *sift_1 = cur - 1;
+        if (cmp(*sift, *sift_1) < 0)
+        {
+            size_t tmp = *sift;
+            do
+            {
+                *sift-- = *sift_1;
+            } while (sift != begin && cmp(tmp, *--sift_1) < 0);
+            *sift = tmp;
+        }
+    }
+}
+static void sv_impl_sort_insertion_unguarded(size_t *begin, size_t *end,
+                                             int (*cmp)(size_t, size_t))
+{
+    if (begin == end)
+        return;
+    for (size_t *cur = begin + 1; cur != end; cur++)
+    {
+        size_t *sift = cur;
+        size_t *sift_1 = cur - 1;
+        if (cmp(*sift, *sift_1) < 0)
+        {
+            size_t tmp = *sift;
+            do
+            {
+                *sift-- = *sift_1;
+            } while (cmp(tmp, *--sift_1) < 0);
+            *sift = tmp;
+        }
+    }
+}
+static _Bool sv_impl_sort_insertion_partial(size_t *begin, size_t *end,
+                                            int (*cmp)(size_t, size_t))
+{
+    if (begin == end)
+        return 1;
+    size_t moves = 0;
+    for (size_t *cur = begin + 1; cur != end; cur++)
+    {
+        size_t *sift = cur;
+        size_t *sift_1 = cur - 1;
+        if (cmp(*sift, *sift_1) < 0)
+        {
+            size_t tmp = *sift;
+            do
+            {
+                *sift-- = *sift_1;
+            } while (sift != begin && cmp(tmp, *--sift_1) < 0);
+            *sift = tmp;
+            moves += (size_t)(cur - sift);
+        }
+        if (moves > 8)
+            return 0;
+    }
+    return 1;
+}
+static void sv_impl_sort_heapsort_sift(size_t *array, size_t root, size_t count,
+                                       int (*cmp)(size_t, size_t))
+{
+    size_t value = array[root];
+    while (root * 2 + 1 < count)
+    {
+        size_t child = root * 2 + 1;
+        if (child + 1 < count && cmp(array[child], array[child + 1]) < 0)
+            child++;
+        if (cmp(value, array[child]) >= 0)
+            break;
+        array[root] = array[child];
+        root = child;
+    }
+    array[root] = value;
+}
+static void sv_impl_sort_heapsort(size_t *begin, size_t *end,
+                                  int (*cmp)(size_t, size_t))
+{
+    size_t count = (size_t)(end - begin);
+    for (size_t i = count / 2; i > 0; i--)
+        sv_impl_sort_heapsort_sift(begin, i - 1, count, cmp);
+    for (size_t i = count; i > 1; i--)
+    {
+        sv_impl_sort_swap(begin, begin + i - 1);
+        sv_impl_sort_heapsort_sift(begin, 0, i - 1, cmp);
+    }
+}
+static void sv_impl_sort_sort2(size_t *a, size_t *b, int (*cmp)(size_t, size_t))
+{
+    if (cmp(*b, *a) < 0)
+        sv_impl_sort_swap(a, b);
+}
+static void sv_impl_sort_sort3(size_t *a, size_t *b, size_t *c,
+                               int (*cmp)(size_t, size_t))
+{
+    sv_impl_sort_sort2(a, b, cmp);
+    sv_impl_sort_sort2(b, c, cmp);
+    sv_impl_sort_sort2(a, b, cmp);
+}
+static size_t *sv_impl_sort_partition_right(size_t *begin, size_t *end,
+                                            int (*cmp)(size_t, size_t),
+                                            _Bool *already_partitioned)
+{
+    size_t pivot = *begin;
+    size_t *first = begin;
+    size_t *last = end;
+    while (cmp(*++first, pivot) < 0)
+        ;
+    if (first - 1 == begin)
+    {
+        while (first < last && cmp(*--last, pivot) >= 0)
+            ;
+    }
+    else
+    {
+        while (cmp(*--last, pivot) >= 0)
+            ;
+    }
+    *already_partitioned = first >= last;
+    while (first < last)
+    {
+        sv_impl_sort_swap(first, last);
+        while (cmp(*++first, pivot) < 0)
+            ;
+        while (cmp(*--last, pivot) >= 0)
+            ;
+    }
+    size_t *pivot_pos = first - 1;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+static size_t *sv_impl_sort_partition_left(size_t *begin, size_t *end,
+                                           int (*cmp)(size_t, size_t))
+{
+    size_t pivot = *begin;
+    size_t *first = begin;
+    size_t *last = end;
+    while (cmp(pivot, *--last) < 0)
+        ;
+    if (last + 1 == end)
+    {
+        while (first < last && cmp(pivot, *++first) >= 0)
+            ;
+    }
+    else
+    {
+        while (cmp(pivot, *++first) >= 0)
+            ;
+    }
+    while (first < last)
+    {
+        sv_impl_sort_swap(first, last);
+        while (cmp(pivot, *--last) < 0)
+            ;
+        while (cmp(pivot, *++first) >= 0)
+            ;
+    }
+    size_t *pivot_pos = last;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+static void sv_impl_sort_pdqsort(size_t *begin, size_t *end,
+                                 int (*cmp)(size_t, size_t), size_t bad_allowed,
+                                 _Bool leftmost)
+{
+    while (1)
+    {
+        size_t size = (size_t)(end - begin);
+        if (size < 24)
+        {
+            if (leftmost)
+                sv_impl_sort_insertion(begin, end, cmp);
+            else
+                sv_impl_sort_insertion_unguarded(begin, end, cmp);
+            return;
+        }
+        size_t s2 = size / 2;
+        if (size > 128)
+        {
+            sv_impl_sort_sort3(begin, begin + s2, end - 1, cmp);
+            sv_impl_sort_sort3(begin + 1, begin + (s2 - 1), end - 2, cmp);
+            sv_impl_sort_sort3(begin + 2, begin + (s2 + 1), end - 3, cmp);
+            sv_impl_sort_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1),
+                               cmp);
+            sv_impl_sort_swap(begin, begin + s2);
+        }
+        else
+            sv_impl_sort_sort3(begin + s2, begin, end - 1, cmp);
+        if (!leftmost && cmp(*(begin - 1), *begin) >= 0)
+        {
+            begin = sv_impl_sort_partition_left(begin, end, cmp) + 1;
+            continue;
+        }
+        _Bool already_partitioned;
+        size_t *pivot_pos =
+            sv_impl_sort_partition_right(begin, end, cmp, &already_partitioned);
+        size_t l_size = (size_t)(pivot_pos - begin);
+        size_t r_size = (size_t)(end - (pivot_pos + 1));
+        if (l_size < size / 8 || r_size < size / 8)
+        {
+            if (--bad_allowed == 0)
+            {
+                sv_impl_sort_heapsort(begin, end, cmp);
+                return;
+            }
+            if (l_size >= 24)
+            {
+                size_t q = l_size / 4;
+                sv_impl_sort_swap(begin, begin + q);
+                sv_impl_sort_swap(pivot_pos - 1, pivot_pos - q);
+                if (l_size > 128)
+                {
+                    sv_impl_sort_swap(begin + 1, begin + (q + 1));
+                    sv_impl_sort_swap(begin + 2, begin + (q + 2));
+                    sv_impl_sort_swap(pivot_pos - 2, pivot_pos - (q + 1));
+                    sv_impl_sort_swap(pivot_pos - 3, pivot_pos - (q + 2));
+                }
+            }
+            if (r_size >= 24)
+            {
+                size_t q = r_size / 4;
+                sv_impl_sort_swap(pivot_pos + 1, pivot_pos + (1 + q));
+                sv_impl_sort_swap(end - 1, end - q);
+                if (r_size > 128)
+                {
+                    sv_impl_sort_swap(pivot_pos + 2, pivot_pos + (2 + q));
+                    sv_impl_sort_swap(pivot_pos + 3, pivot_pos + (3 + q));
+                    sv_impl_sort_swap(end - 2, end - (1 + q));
+                    sv_impl_sort_swap(end - 3, end - (2 + q));
+                }
+            }
+        }
+        else if (already_partitioned &&
+                 sv_impl_sort_insertion_partial(begin, pivot_pos, cmp) &&
+                 sv_impl_sort_insertion_partial(pivot_pos + 1, end, cmp))
+        {
+            return;
+        }
+        sv_impl_sort_pdqsort(begin, pivot_pos, cmp, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = 0;
+    }
+}
+static void sv_impl_sort(size_t *array, size_t count,
+                         int (*cmp)(size_t, size_t))
+{
+    if (count < 2)
+        return;
+    size_t bad_allowed = 0;
+    for (size_t n = count; n > 1; n >>= 1)
+        bad_allowed++;
+    sv_impl_sort_pdqsort(array, array + count, cmp, bad_allowed, 1);
+}
+static void sv_impl_sort_array(struct smallvec *_vec_, size_t *array,
+                               size_t count)
+{
+    sv_impl_sort(array, count, _vec_->f_val->cmp);
+}
+
+#endif /* CMC_TEST_SRC_SMALLVEC */
@@ -9,10 +9,13 @@ struct sortedlist
     size_t capacity;
     size_t count;
     _Bool is_sorted;
+    size_t sorted;
+    _Bool eager;
     int flag;
     struct sortedlist_fval *f_val;
     struct cmc_alloc_node *alloc;
     struct cmc_callbacks *callbacks;
+    const struct cmc_growth *growth;
 };
 struct sortedlist_fval
 {
@@ -38,6 +41,7 @@ void sl_clear(struct sortedlist *_list_);
 void sl_free(struct sortedlist *_list_);
 void sl_customize(struct sortedlist *_list_, struct cmc_alloc_node *alloc,
                   struct cmc_callbacks *callbacks);
+void sl_set_growth(struct sortedlist *_list_, const struct cmc_growth *growth);
 _Bool sl_insert(struct sortedlist *_list_, size_t value);
 _Bool sl_remove(struct sortedlist *_list_, size_t index);
 size_t sl_max(struct sortedlist *_list_);
@@ -51,7 +55,10 @@ size_t sl_count(struct sortedlist *_list_);
 size_t sl_capacity(struct sortedlist *_list_);
 int sl_flag(struct sortedlist *_list_);
 _Bool sl_resize(struct sortedlist *_list_, size_t capacity);
+_Bool sl_reserve(struct sortedlist *_list_, size_t size);
+_Bool sl_shrink_to_fit(struct sortedlist *_list_);
 void sl_sort(struct sortedlist *_list_);
+void sl_set_eager(struct sortedlist *_list_, _Bool eager);
 struct sortedlist *sl_copy_of(struct sortedlist *_list_);
 _Bool sl_equals(struct sortedlist *_list1_, struct sortedlist *_list2_);
 struct cmc_string sl_to_string(struct sortedlist *_list_);
@@ -73,10 +80,11 @@ static size_t sl_impl_binary_search_first(struct sortedlist *_list_,
                                           size_t value);
 static size_t sl_impl_binary_search_last(struct sortedlist *_list_,
                                          size_t value);
-void sl_impl_sort_quicksort(size_t *array, int (*cmp)(size_t, size_t),
-                            size_t low, size_t high);
-void sl_impl_sort_insertion(size_t *array, int (*cmp)(size_t, size_t),
-                            size_t low, size_t high);
+static void sl_impl_sort_array(struct sortedlist *_list_, size_t *array,
+                               size_t count);
+static size_t sl_impl_gallop(size_t *array, size_t end, size_t value,
+                             int (*cmp)(size_t, size_t));
+static void sl_impl_merge_tail(struct sortedlist *_list_);
 struct sortedlist *sl_new(size_t capacity, struct sortedlist_fval *f_val)
 {
     struct cmc_alloc_node *alloc = &cmc_alloc_node_default;
@@ -96,10 +104,13 @@ struct sortedlist *sl_new(size_t capacity, struct sortedlist_fval *f_val)
     _list_->capacity = capacity;
     _list_->count = 0;
     _list_->is_sorted = 0;
+    _list_->sorted = 0;
+    _list_->eager = 0;
     _list_->flag = cmc_flags.OK;
     _list_->f_val = f_val;
     _list_->alloc = alloc;
     _list_->callbacks = ((void *)0);
+    _list_->growth = ((void *)0);
     return _list_;
 }
 struct sortedlist *sl_new_custom(size_t capacity, struct sortedlist_fval *f_val,
@@ -122,10 +133,13 @@ struct sortedlist *sl_new_custom(size_t capacity, struct sortedlist_fval *f_val,
     _list_->capacity = capacity;
     _list_->count = 0;
     _list_->is_sorted = 0;
+    _list_->sorted = 0;
+    _list_->eager = 0;
     _list_->flag = cmc_flags.OK;
     _list_->f_val = f_val;
     _list_->alloc = alloc;
     _list_->callbacks = callbacks;
+    _list_->growth = ((void *)0);
     return _list_;
 }
 void sl_clear(struct sortedlist *_list_)
@@ -137,6 +151,7 @@ void sl_clear(struct sortedlist *_list_)
     }
     memset(_list_->buffer, 0, sizeof(size_t) * _list_->capacity);
     _list_->count = 0;
+    _list_->sorted = 0;
     _list_->flag = cmc_flags.OK;
 }
 void sl_free(struct sortedlist *_list_)
@@ -159,15 +174,36 @@ void sl_customize(struct sortedlist *_list_, struct cmc_alloc_node *alloc,
     _list_->callbacks = callbacks;
     _list_->flag = cmc_flags.OK;
 }
+void sl_set_growth(struct sortedlist *_list_, const struct cmc_growth *growth)
+{
+    _list_->growth = growth;
+    _list_->flag = cmc_flags.OK;
+}
 _Bool sl_insert(struct sortedlist *_list_, size_t value)
 {
     if (sl_full(_list_))
     {
-        if (!sl_resize(_list_, _list_->capacity * 2))
+        if (!sl_reserve(_list_, 1))
             return 0;
     }
-    _list_->buffer[_list_->count++] = value;
-    _list_->is_sorted = 0;
+    size_t *buffer = _list_->buffer;
+    int (*cmp)(size_t, size_t) = _list_->f_val->cmp;
+    if (_list_->eager)
+    {
+        sl_sort(_list_);
+        size_t index = sl_impl_gallop(buffer, _list_->count, value, cmp);
+        memmove(buffer + index + 1, buffer + index,
+                (_list_->count - index) * sizeof(size_t));
+        buffer[index] = value;
+    }
+    else
+        buffer[_list_->count] = value;
+    if (_list_->sorted == _list_->count &&
+        (_list_->sorted == 0 || _list_->eager ||
+         cmp(buffer[_list_->sorted - 1], value) <= 0))
+        _list_->sorted++;
+    _list_->count++;
+    _list_->is_sorted = _list_->sorted == _list_->count;
     _list_->flag = cmc_flags.OK;
     if (_list_->callbacks && _list_->callbacks->create)
         _list_->callbacks->create();
@@ -186,8 +222,11 @@ _Bool sl_remove(struct sortedlist *_list_, size_t index)
         return 0;
     }
     memmove(_list_->buffer + index, _list_->buffer + index + 1,
-            (_list_->count - index) * sizeof(size_t));
+            (_list_->count - index - 1) * sizeof(size_t));
     _list_->buffer[--_list_->count] = (size_t){ 0 };
+    if (index < _list_->sorted)
+        _list_->sorted--;
+    _list_->is_sorted = _list_->sorted == _list_->count;
     _list_->flag = cmc_flags.OK;
     if (_list_->callbacks && _list_->callbacks->delete)
         _list_->callbacks->delete ();
@@ -303,15 +342,36 @@ success:
         _list_->callbacks->resize();
     return 1;
 }
-void sl_sort(struct sortedlist *_list_)
+_Bool sl_reserve(struct sortedlist *_list_, size_t size)
 {
     _list_->flag = cmc_flags.OK;
-    if (!_list_->is_sorted && _list_->count > 1)
+    if (size <= _list_->capacity - _list_->count)
+        return 1;
+    if (size > (18446744073709551615UL) - _list_->count)
     {
-        sl_impl_sort_quicksort(_list_->buffer, _list_->f_val->cmp, 0,
-                               _list_->count - 1);
-        _list_->is_sorted = 1;
+        _list_->flag = cmc_flags.ERROR;
+        return 0;
     }
+    return sl_resize(_list_,
+                     cmc_growth_capacity(_list_->growth, _list_->capacity,
+                                         _list_->count + size));
+}
+_Bool sl_shrink_to_fit(struct sortedlist *_list_)
+{
+    return sl_resize(_list_, _list_->count > 0 ? _list_->count : 1);
+}
+void sl_sort(struct sortedlist *_list_)
+{
+    _list_->flag = cmc_flags.OK;
+    if (!_list_->is_sorted && _list_->count > 1)
+        sl_impl_merge_tail(_list_);
+    _list_->sorted = _list_->count;
+    _list_->is_sorted = 1;
+}
+void sl_set_eager(struct sortedlist *_list_, _Bool eager)
+{
+    _list_->eager = eager;
+    _list_->flag = cmc_flags.OK;
 }
 struct sortedlist *sl_copy_of(struct sortedlist *_list_)
 {
@@ -330,6 +390,10 @@ struct sortedlist *sl_copy_of(struct sortedlist *_list_)
     else
         memcpy(result->buffer, _list_->buffer, sizeof(size_t) * _list_->count);
     result->count = _list_->count;
+    result->growth = _list_->growth;
+    result->is_sorted = _list_->is_sorted;
+    result->sorted = _list_->sorted;
+    result->eager = _list_->eager;
     _list_->flag = cmc_flags.OK;
     return result;
 }
@@ -532,60 +596,348 @@ static size_t sl_impl_binary_search_last(struct sortedlist *_list_,
         return L - 1;
     return _list_->count;
 }
-void sl_impl_sort_quicksort(size_t *array, int (*cmp)(size_t, size_t),
-                            size_t low, size_t high)
+static size_t sl_impl_gallop(size_t *array, size_t end, size_t value,
+                             int (*cmp)(size_t, size_t))
 {
-    while (low < high)
+    size_t L = 0;
+    size_t R = end;
+    size_t step = 1;
+    while (L < R)
     {
-        if (high - low < 10)
+        size_t probe = R > step ? R - step : 0;
+        if (cmp(array[probe], value) <= 0)
         {
-            sl_impl_sort_insertion(array, cmp, low, high);
+            L = probe + 1;
             break;
         }
+        R = probe;
+        step *= 2;
+    }
+    while (L < R)
+    {
+        size_t M = L + (R - L) / 2;
+        if (cmp(array[M], value) > 0)
+            R = M;
         else
+            L = M + 1;
+    }
+    return L;
+}
+static void sl_impl_merge_tail(struct sortedlist *_list_)
+{
+    size_t *buffer = _list_->buffer;
+    size_t sorted = _list_->sorted;
+    size_t tail = _list_->count - sorted;
+    int (*cmp)(size_t, size_t) = _list_->f_val->cmp;
+    sl_impl_sort_array(_list_, buffer + sorted, tail);
+    if (sorted == 0 || cmp(buffer[sorted - 1], buffer[sorted]) <= 0)
+        return;
+    size_t *aux = _list_->alloc->malloc(sizeof(size_t) * tail);
+    if (!aux)
+    {
+        sl_impl_sort_array(_list_, buffer, _list_->count);
+        return;
+    }
+    memcpy(aux, buffer + sorted, sizeof(size_t) * tail);
+    size_t i = sorted;
+    size_t j = tail;
+    size_t k = _list_->count;
+    if (sorted / 8 > tail)
+    {
+        while (j > 0)
+        {
+            size_t index = sl_impl_gallop(buffer, i, aux[j - 1], cmp);
+            k -= i - index;
+            memmove(buffer + k, buffer + index, (i - index) * sizeof(size_t));
+            buffer[--k] = aux[--j];
+            i = index;
+        }
+    }
+    else
+    {
+        while (i > 0 && j > 0)
+        {
+            if (cmp(aux[j - 1], buffer[i - 1]) < 0)
+                buffer[--k] = buffer[--i];
+            else
+                buffer[--k] = aux[--j];
+        }
+        while (j > 0)
+            buffer[--k] = aux[--j];
+    }
+    _list_->alloc->free(aux);
+}
+static void sl_impl_sort_swap(size_t *a, size_t *b)
+{
+    size_t tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+static void sl_impl_sort_insertion(size_t *begin, size_t *end,
+                                   int (*cmp)(size_t, size_t))
+{
+    if (begin == end)
+        return;
+    for (size_t *cur = begin + 1; cur != end; cur++)
+    {
+        size_t *sift = cur;
+        size_t *sift_1 = cur - 1;
+        if (cmp(*sift, *sift_1) < 0)
         {
-            size_t pivot = array[high];
-            size_t pindex = low;
-            for (size_t i = low; i < high; i++)
+            size_t tmp = *sift;
+            do
             {
-                if (cmp(array[i], pivot) <= 0)
-                {
-                    size_t _tmp_ = array[i];
-                    array[i] = array[pindex];
-                    array[pindex] = _tmp_;
-                    pindex++;
-                }
-            }
-            size_t _tmp_ = array[pindex];
-            array[pindex] = array[high];
-            array[high] = _tmp_;
-            if (pindex - low < high - pindex)
+                *sift-- = *sift_1;
+            } while (sift != begin && cmp(tmp, *--sift_1) < 0);
+            *sift = tmp;
+        }
+    }
+}
+static void sl_impl_sort_insertion_unguarded(size_t *begin, size_t *end,
+                                             int (*cmp)(size_t, size_t))
+{
+    if (begin == end)
+        return;
+    for (size_t *cur = begin + 1; cur != end; cur++)
+    {
+        size_t *sift = cur;
+        size_t *sift_1 = cur - 1;
+        if (cmp(*sift, *sift_1) < 0)
+        {
+            size_t tmp = *sift;
+            do
             {
-                sl_impl_sort_quicksort(array, cmp, low, pindex - 1);
-                low = pindex + 1;
-            }
-            else
+                *sift-- = *sift_1;
+            } while (cmp(tmp, *--sift_1) < 0);
+            *sift = tmp;
+        }
+    }
+}
+static _Bool sl_impl_sort_insertion_partial(size_t *begin, size_t *end,
+                                            int (*cmp)(size_t, size_t))
+{
+    if (begin == end)
+        return 1;
+    size_t moves = 0;
+    for (size_t *cur = begin + 1; cur != end; cur++)
+    {
+        size_t *sift = cur;
+        size_t *sift_1 = cur - 1;
+        if (cmp(*sift, *sift_1) < 0)
+        {
+            size_t tmp = *sift;
+            do
             {
-                sl_impl_sort_quicksort(array, cmp, pindex + 1, high);
-                high = pindex - 1;
-            }
+                *sift-- = *sift_1;
+            } while (sift != begin && cmp(tmp, *--sift_1) < 0);
+            *sift = tmp;
+            moves += (size_t)(cur - sift);
         }
+        if (moves > 8)
+            return 0;
+    }
+    return 1;
+}
+static void sl_impl_sort_heapsort_sift(size_t *array, size_t root, size_t count,
+                                       int (*cmp)(size_t, size_t))
+{
+    size_t value = array[root];
+    while (root * 2 + 1 < count)
+    {
+        size_t child = root * 2 + 1;
+        if (child + 1 < count && cmp(array[child], array[child + 1]) < 0)
+            child++;
+        if (cmp(value, array[child]) >= 0)
+            break;
+        array[root] = array[child];
+        root = child;
     }
+    array[root] = value;
 }
-void sl_impl_sort_insertion(size_t *array, int (*cmp)(size_t, size_t),
-                            size_t low, size_t high)
+static void sl_impl_sort_heapsort(size_t *begin, size_t *end,
+                                  int (*cmp)(size_t, size_t))
 {
-    for (size_t i = low + 1; i <= high; i++)
+    size_t count = (size_t)(end - begin);
+    for (size_t i = count / 2; i > 0; i--)
+        sl_impl_sort_heapsort_sift(begin, i - 1, count, cmp);
+    for (size_t i = count; i > 1; i--)
+    {
+        sl_impl_sort_swap(begin, begin + i - 1);
+        sl_impl_sort_heapsort_sift(begin, 0, i - 1, cmp);
+    }
+}
+static void sl_impl_sort_sort2(size_t *a, size_t *b, int (*cmp)(size_t, size_t))
+{
+    if (cmp(*b, *a) < 0)
+        sl_impl_sort_swap(a, b);
+}
+static void sl_impl_sort_sort3(size_t *a, size_t *b, size_t *c,
+                               int (*cmp)(size_t, size_t))
+{
+    sl_impl_sort_sort2(a, b, cmp);
+    sl_impl_sort_sort2(b, c, cmp);
+    sl_impl_sort_sort2(a, b, cmp);
+}
+static size_t *sl_impl_sort_partition_right(size_t *begin, size_t *end,
+                                            int (*cmp)(size_t, size_t),
+                                            _Bool *already_partitioned)
+{
+    size_t pivot = *begin;
+    size_t *first = begin;
+    size_t *last = end;
+    while (cmp(*++first, pivot) < 0)
+        ;
+    if (first - 1 == begin)
+    {
+        while (first < last && cmp(*--last, pivot) >= 0)
+            ;
+    }
+    else
+    {
+        while (cmp(*--last, pivot) >= 0)
+            ;
+    }
+    *already_partitioned = first >= last;
+    while (first < last)
+    {
+        sl_impl_sort_swap(first, last);
+        while (cmp(*++first, pivot) < 0)
+            ;
+        while (cmp(*--last, pivot) >= 0)
+            ;
+    }
+    size_t *pivot_pos = first - 1;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+static size_t *sl_impl_sort_partition_left(size_t *begin, size_t *end,
+                                           int (*cmp)(size_t, size_t))
+{
+    size_t pivot = *begin;
+    size_t *first = begin;
+    size_t *last = end;
+    while (cmp(pivot, *--last) < 0)
+        ;
+    if (last + 1 == end)
+    {
+        while (first < last && cmp(pivot, *++first) >= 0)
+            ;
+    }
+    else
     {
-        size_t _tmp_ = array[i];
-        size_t j = i;
-        while (j > low && cmp(array[j - 1], _tmp_) > 0)
+        while (cmp(pivot, *++first) >= 0)
+            ;
+    }
+    while (first < last)
+    {
+        sl_impl_sort_swap(first, last);
+        while (cmp(pivot, *--last) < 0)
+            ;
+        while (cmp(pivot, *++first) >= 0)
+            ;
+    }
+    size_t *pivot_pos = last;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+static void sl_impl_sort_pdqsort(size_t *begin, size_t *end,
+                                 int (*cmp)(size_t, size_t), size_t bad_allowed,
+                                 _Bool leftmost)
+{
+    while (1)
+    {
+        size_t size = (size_t)(end - begin);
+        if (size < 24)
+        {
+            if (leftmost)
+                sl_impl_sort_insertion(begin, end, cmp);
+            else
+                sl_impl_sort_insertion_unguarded(begin, end, cmp);
+            return;
+        }
+        size_t s2 = size / 2;
+        if (size > 128)
+        {
+            sl_impl_sort_sort3(begin, begin + s2, end - 1, cmp);
+            sl_impl_sort_sort3(begin + 1, begin + (s2 - 1), end - 2, cmp);
+            sl_impl_sort_sort3(begin + 2, begin + (s2 + 1), end - 3, cmp);
+            sl_impl_sort_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1),
+                               cmp);
+            sl_impl_sort_swap(begin, begin + s2);
+        }
+        else
+            sl_impl_sort_sort3(begin + s2, begin, end - 1, cmp);
+        if (!leftmost && cmp(*(begin - 1), *begin) >= 0)
+        {
+            begin = sl_impl_sort_partition_left(begin, end, cmp) + 1;
+            continue;
+        }
+        _Bool already_partitioned;
+        size_t *pivot_pos =
+            sl_impl_sort_partition_right(begin, end, cmp, &already_partitioned);
+        size_t l_size = (size_t)(pivot_pos - begin);
+        size_t r_size = (size_t)(end - (pivot_pos + 1));
+        if (l_size < size / 8 || r_size < size / 8)
+        {
+            if (--bad_allowed == 0)
+            {
+                sl_impl_sort_heapsort(begin, end, cmp);
+                return;
+            }
+            if (l_size >= 24)
+            {
+                size_t q = l_size / 4;
+                sl_impl_sort_swap(begin, begin + q);
+                sl_impl_sort_swap(pivot_pos - 1, pivot_pos - q);
+                if (l_size > 128)
+                {
+                    sl_impl_sort_swap(begin + 1, begin + (q + 1));
+                    sl_impl_sort_swap(begin + 2, begin + (q + 2));
+                    sl_impl_sort_swap(pivot_pos - 2, pivot_pos - (q + 1));
+                    sl_impl_sort_swap(pivot_pos - 3, pivot_pos - (q + 2));
+                }
+            }
+            if (r_size >= 24)
+            {
+                size_t q = r_size / 4;
+                sl_impl_sort_swap(pivot_pos + 1, pivot_pos + (1 + q));
+                sl_impl_sort_swap(end - 1, end - q);
+                if (r_size > 128)
+                {
+                    sl_impl_sort_swap(pivot_pos + 2, pivot_pos + (2 + q));
+                    sl_impl_sort_swap(pivot_pos + 3, pivot_pos + (3 + q));
+                    sl_impl_sort_swap(end - 2, end - (1 + q));
+                    sl_impl_sort_swap(end - 3, end - (2 + q));
+                }
+            }
+        }
+        else if (already_partitioned &&
+                 sl_impl_sort_insertion_partial(begin, pivot_pos, cmp) &&
+                 sl_impl_sort_insertion_partial(pivot_pos + 1, end, cmp))
         {
-            array[j] = array[j - 1];
-            j--;
+            return;
         }
-        array[j] = _tmp_;
+        sl_impl_sort_pdqsort(begin, pivot_pos, cmp, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = 0;
     }
 }
+static void sl_impl_sort(size_t *array, size_t count,
+                         int (*cmp)(size_t, size_t))
+{
+    if (count < 2)
+        return;
+    size_t bad_allowed = 0;
+    for (size_t n = count; n > 1; n >>= 1)
+        bad_allowed++;
+    sl_impl_sort_pdqsort(array, array + count, cmp, bad_allowed, 1);
+}
+static void sl_impl_sort_array(struct sortedlist *_list_, size_t *array,
+                               size_t count)
+{
+    sl_impl_sort(array, count, _list_->f_val->cmp);
+}
 
 #endif /* CMC_TEST_SRC_SORTEDLIST */
@@ -0,0 +1,442 @@
+#ifndef CMC_TEST_SRC_SPSCQUEUE
+#define CMC_TEST_SRC_SPSCQUEUE
+
+#include "cmc/spscqueue.h"
+
+struct spscqueue
+{
+    char pad_0[64];
+    _Atomic size_t tail;
+    size_t head_cache;
+    char pad_1[64];
+    _Atomic size_t head;
+    size_t tail_cache;
+    char pad_2[64];
+    size_t *buffer;
+    size_t capacity;
+    int flag;
+    struct spscqueue_fval *f_val;
+    struct cmc_alloc_node *alloc;
+    struct cmc_callbacks *callbacks;
+};
+struct spscqueue_fval
+{
+    int (*cmp)(size_t, size_t);
+    size_t (*cpy)(size_t);
+    _Bool (*str)(FILE *, size_t);
+    void (*free)(size_t);
+    size_t (*hash)(size_t);
+    int (*pri)(size_t, size_t);
+};
+struct spscqueue *spq_new(size_t capacity, struct spscqueue_fval *f_val);
+struct spscqueue *spq_new_custom(size_t capacity, struct spscqueue_fval *f_val,
+                                 struct cmc_alloc_node *alloc,
+                                 struct cmc_callbacks *callbacks);
+void spq_clear(struct spscqueue *_queue_);
+void spq_free(struct spscqueue *_queue_);
+void spq_customize(struct spscqueue *_queue_, struct cmc_alloc_node *alloc,
+                   struct cmc_callbacks *callbacks);
+_Bool spq_try_enqueue(struct spscqueue *_queue_, size_t value);
+size_t spq_try_enqueue_n(struct spscqueue *_queue_, size_t *values, size_t n);
+_Bool spq_try_dequeue(struct spscqueue *_queue_, size_t *out);
+size_t spq_try_dequeue_n(struct spscqueue *_queue_, size_t *out, size_t n);
+_Bool spq_try_peek(struct spscqueue *_queue_, size_t *out);
+_Bool spq_empty(struct spscqueue *_queue_);
+_Bool spq_full(struct spscqueue *_queue_);
+size_t spq_count(struct spscqueue *_queue_);
+size_t spq_capacity(struct spscqueue *_queue_);
+int spq_flag(struct spscqueue *_queue_);
+struct cmc_string spq_to_string(struct spscqueue *_queue_);
+_Bool spq_print(struct spscqueue *_queue_, FILE *fptr);
+static size_t spq_impl_capacity(size_t capacity);
+struct spscqueue *spq_new(size_t capacity, struct spscqueue_fval *f_val)
+{
+    return spq_new_custom(capacity, f_val, ((void *)0), ((void *)0));
+}
+struct spscqueue *spq_new_custom(size_t capacity, struct spscqueue_fval *f_val,
+                                 struct cmc_alloc_node *alloc,
+                                 struct cmc_callbacks *callbacks)
+{
+    if (capacity < 1)
+        return ((void *)0);
+    if (!f_val)
+        return ((void *)0);
+    capacity = spq_impl_capacity(capacity);
+    if (capacity == 0)
+        return ((void *)0);
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+    struct spscqueue *_queue_ = alloc->malloc(sizeof(struct spscqueue));
+    if (!_queue_)
+        return ((void *)0);
+    _queue_->buffer = alloc->calloc(capacity, sizeof(size_t));
+    if (!_queue_->buffer)
+    {
+        alloc->free(_queue_);
+        return ((void *)0);
+    }
+    __extension__({
+        __auto_type __atomic_store_ptr = (&_queue_->tail);
+        __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp = (0);
+        __atomic_store(__atomic_store_ptr, &__atomic_store_tmp, (0));
+    });
+    __extension__({
+        __auto_type __atomic_store_ptr = (&_queue_->head);
+        __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp = (0);
+        __atomic_store(__atomic_store_ptr, &__atomic_store_tmp, (0));
+    });
+    _queue_->head_cache = 0;
+    _queue_->tail_cache = 0;
+    _queue_->capacity = capacity;
+    _queue_->flag = cmc_flags.OK;
+    _queue_->f_val = f_val;
+    _queue_->alloc = alloc;
+    _queue_->callbacks = callbacks;
+    return _queue_;
+}
+void spq_clear(struct spscqueue *_queue_)
+{
+    size_t head = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->head);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    size_t tail = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->tail);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    if (_queue_->f_val->free)
+    {
+        for (size_t i = head; i != tail; i++)
+            _queue_->f_val->free(_queue_->buffer[i & (_queue_->capacity - 1)]);
+    }
+    memset(_queue_->buffer, 0, sizeof(size_t) * _queue_->capacity);
+    __extension__({
+        __auto_type __atomic_store_ptr = (&_queue_->tail);
+        __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp = (0);
+        __atomic_store(__atomic_store_ptr, &__atomic_store_tmp,
+                       (memory_order_relaxed));
+    });
+    __extension__({
+        __auto_type __atomic_store_ptr = (&_queue_->head);
+        __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp = (0);
+        __atomic_store(__atomic_store_ptr, &__atomic_store_tmp,
+                       (memory_order_relaxed));
+    });
+    _queue_->head_cache = 0;
+    _queue_->tail_cache = 0;
+    _queue_->flag = cmc_flags.OK;
+}
+void spq_free(struct spscqueue *_queue_)
+{
+    size_t head = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->head);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    size_t tail = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->tail);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    if (_queue_->f_val->free)
+    {
+        for (size_t i = head; i != tail; i++)
+            _queue_->f_val->free(_queue_->buffer[i & (_queue_->capacity - 1)]);
+    }
+    _queue_->alloc->free(_queue_->buffer);
+    _queue_->alloc->free(_queue_);
+}
+void spq_customize(struct spscqueue *_queue_, struct cmc_alloc_node *alloc,
+                   struct cmc_callbacks *callbacks)
+{
+    if (!alloc)
+        _queue_->alloc = &cmc_alloc_node_default;
+    else
+        _queue_->alloc = alloc;
+    _queue_->callbacks = callbacks;
+    _queue_->flag = cmc_flags.OK;
+}
+_Bool spq_try_enqueue(struct spscqueue *_queue_, size_t value)
+{
+    size_t tail = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->tail);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    if (tail - _queue_->head_cache == _queue_->capacity)
+    {
+        _queue_->head_cache = __extension__({
+            __auto_type __atomic_load_ptr = (&_queue_->head);
+            __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+            __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                          (memory_order_acquire));
+            __atomic_load_tmp;
+        });
+        if (tail - _queue_->head_cache == _queue_->capacity)
+            return 0;
+    }
+    _queue_->buffer[tail & (_queue_->capacity - 1)] = value;
+    __extension__({
+        __auto_type __atomic_store_ptr = (&_queue_->tail);
+        __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp =
+            (tail + 1);
+        __atomic_store(__atomic_store_ptr, &__atomic_store_tmp,
+                       (memory_order_release));
+    });
+    if (_queue_->callbacks && _queue_->callbacks->create)
+        _queue_->callbacks->create();
+    return 1;
+}
+size_t spq_try_enqueue_n(struct spscqueue *_queue_, size_t *values, size_t n)
+{
+    size_t tail = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->tail);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    size_t space = _queue_->capacity - (tail - _queue_->head_cache);
+    if (space < n)
+    {
+        _queue_->head_cache = __extension__({
+            __auto_type __atomic_load_ptr = (&_queue_->head);
+            __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+            __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                          (memory_order_acquire));
+            __atomic_load_tmp;
+        });
+        space = _queue_->capacity - (tail - _queue_->head_cache);
+    }
+    if (n > space)
+        n = space;
+    if (n == 0)
+        return 0;
+    size_t index = tail & (_queue_->capacity - 1);
+    size_t count1 = _queue_->capacity - index;
+    if (count1 > n)
+        count1 = n;
+    memcpy(_queue_->buffer + index, values, count1 * sizeof(size_t));
+    memcpy(_queue_->buffer, values + count1, (n - count1) * sizeof(size_t));
+    __extension__({
+        __auto_type __atomic_store_ptr = (&_queue_->tail);
+        __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp =
+            (tail + n);
+        __atomic_store(__atomic_store_ptr, &__atomic_store_tmp,
+                       (memory_order_release));
+    });
+    if (_queue_->callbacks && _queue_->callbacks->create)
+        _queue_->callbacks->create();
+    return n;
+}
+_Bool spq_try_dequeue(struct spscqueue *_queue_, size_t *out)
+{
+    size_t head = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->head);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    if (head == _queue_->tail_cache)
+    {
+        _queue_->tail_cache = __extension__({
+            __auto_type __atomic_load_ptr = (&_queue_->tail);
+            __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+            __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                          (memory_order_acquire));
+            __atomic_load_tmp;
+        });
+        if (head == _queue_->tail_cache)
+            return 0;
+    }
+    if (out)
+        *out = _queue_->buffer[head & (_queue_->capacity - 1)];
+    __extension__({
+        __auto_type __atomic_store_ptr = (&_queue_->head);
+        __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp =
+            (head + 1);
+        __atomic_store(__atomic_store_ptr, &__atomic_store_tmp,
+                       (memory_order_release));
+    });
+    if (_queue_->callbacks && _queue_->callbacks->delete)
+        _queue_->callbacks->delete ();
+    return 1;
+}
+size_t spq_try_dequeue_n(struct spscqueue *_queue_, size_t *out, size_t n)
+{
+    size_t head = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->head);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    size_t available = _queue_->tail_cache - head;
+    if (available < n)
+    {
+        _queue_->tail_cache = __extension__({
+            __auto_type __atomic_load_ptr = (&_queue_->tail);
+            __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+            __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                          (memory_order_acquire));
+            __atomic_load_tmp;
+        });
+        available = _queue_->tail_cache - head;
+    }
+    if (n > available)
+        n = available;
+    if (n == 0)
+        return 0;
+    if (out)
+    {
+        size_t index = head & (_queue_->capacity - 1);
+        size_t count1 = _queue_->capacity - index;
+        if (count1 > n)
+            count1 = n;
+        memcpy(out, _queue_->buffer + index, count1 * sizeof(size_t));
+        memcpy(out + count1, _queue_->buffer, (n - count1) * sizeof(size_t));
+    }
+    __extension__({
+        __auto_type __atomic_store_ptr = (&_queue_->head);
+        __typeof__((void)0, *__atomic_store_ptr) __atomic_store_tmp =
+            (head + n);
+        __atomic_store(__atomic_store_ptr, &__atomic_store_tmp,
+                       (memory_order_release));
+    });
+    if (_queue_->callbacks && _queue_->callbacks->delete)
+        _queue_->callbacks->delete ();
+    return n;
+}
+_Bool spq_try_peek(struct spscqueue *_queue_, size_t *out)
+{
+    size_t head = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->head);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    if (head == _queue_->tail_cache)
+    {
+        _queue_->tail_cache = __extension__({
+            __auto_type __atomic_load_ptr = (&_queue_->tail);
+            __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+            __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                          (memory_order_acquire));
+            __atomic_load_tmp;
+        });
+        if (head == _queue_->tail_cache)
+            return 0;
+    }
+    *out = _queue_->buffer[head & (_queue_->capacity - 1)];
+    if (_queue_->callbacks && _queue_->callbacks->read)
+        _queue_->callbacks->read();
+    return 1;
+}
+_Bool spq_empty(struct spscqueue *_queue_)
+{
+    return spq_count(_queue_) == 0;
+}
+_Bool spq_full(struct spscqueue *_queue_)
+{
+    return spq_count(_queue_) >= _queue_->capacity;
+}
+size_t spq_count(struct spscqueue *_queue_)
+{
+    size_t head = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->head);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_acquire));
+        __atomic_load_tmp;
+    });
+    size_t tail = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->tail);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_acquire));
+        __atomic_load_tmp;
+    });
+    return tail - head > _queue_->capacity ? _queue_->capacity : tail - head;
+}
+size_t spq_capacity(struct spscqueue *_queue_)
+{
+    return _queue_->capacity;
+}
+int spq_flag(struct spscqueue *_queue_)
+{
+    return _queue_->flag;
+}
+struct cmc_string spq_to_string(struct spscqueue *_queue_)
+{
+    struct cmc_string str;
+    struct spscqueue *q_ = _queue_;
+    int n =
+        snprintf(str.s, cmc_string_len, cmc_string_fmt_spscqueue, "spscqueue",
+                 "size_t", q_, q_->buffer, q_->capacity, __extension__({
+                     __auto_type __atomic_load_ptr = (&q_->head);
+                     __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+                     __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                                   (memory_order_relaxed));
+                     __atomic_load_tmp;
+                 }),
+                 __extension__({
+                     __auto_type __atomic_load_ptr = (&q_->tail);
+                     __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+                     __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                                   (memory_order_relaxed));
+                     __atomic_load_tmp;
+                 }),
+                 q_->flag, q_->f_val, q_->alloc, q_->callbacks);
+    return n >= 0 ? str : (struct cmc_string){ 0 };
+}
+_Bool spq_print(struct spscqueue *_queue_, FILE *fptr)
+{
+    size_t head = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->head);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    size_t tail = __extension__({
+        __auto_type __atomic_load_ptr = (&_queue_->tail);
+        __typeof__((void)0, *__atomic_load_ptr) __atomic_load_tmp;
+        __atomic_load(__atomic_load_ptr, &__atomic_load_tmp,
+                      (memory_order_relaxed));
+        __atomic_load_tmp;
+    });
+    for (size_t i = head; i != tail; i++)
+    {
+        if (!_queue_->f_val->str(fptr,
+                                 _queue_->buffer[i & (_queue_->capacity - 1)]))
+            return 0;
+    }
+    return 1;
+}
+static size_t spq_impl_capacity(size_t capacity)
+{
+    size_t result = 1;
+    while (result < capacity)
+    {
+        if (result > (18446744073709551615UL) / 2)
+            return 0;
+        result *= 2;
+    }
+    return result;
+}
+
+#endif /* CMC_TEST_SRC_SPSCQUEUE */
@@ -12,6 +12,7 @@ struct stack
     struct stack_fval *f_val;
     struct cmc_alloc_node *alloc;
     struct cmc_callbacks *callbacks;
+    const struct cmc_growth *growth;
 };
 struct stack_fval
 {
@@ -37,6 +38,7 @@ void s_clear(struct stack *_stack_);
 void s_free(struct stack *_stack_);
 void s_customize(struct stack *_stack_, struct cmc_alloc_node *alloc,
                  struct cmc_callbacks *callbacks);
+void s_set_growth(struct stack *_stack_, const struct cmc_growth *growth);
 _Bool s_push(struct stack *_stack_, size_t value);
 _Bool s_pop(struct stack *_stack_);
 size_t s_top(struct stack *_stack_);
@@ -47,6 +49,8 @@ size_t s_count(struct stack *_stack_);
 size_t s_capacity(struct stack *_stack_);
 int s_flag(struct stack *_stack_);
 _Bool s_resize(struct stack *_stack_, size_t capacity);
+_Bool s_reserve(struct stack *_stack_, size_t size);
+_Bool s_shrink_to_fit(struct stack *_stack_);
 struct stack *s_copy_of(struct stack *_stack_);
 _Bool s_equals(struct stack *_stack1_, struct stack *_stack2_);
 struct cmc_string s_to_string(struct stack *_stack_);
@@ -65,6 +69,27 @@ _Bool s_iter_go_to(struct stack_iter *iter, size_t index);
 size_t s_iter_value(struct stack_iter *iter);
 size_t *s_iter_rvalue(struct stack_iter *iter);
 size_t s_iter_index(struct stack_iter *iter);
+static inline size_t s_impl_search(size_t *array, size_t count, size_t value,
+                                   int (*cmp)(size_t, size_t))
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (cmp(array[i], value) == 0)
+            return i;
+    }
+    return count;
+}
+static inline size_t s_impl_search_last(size_t *array, size_t count,
+                                        size_t value,
+                                        int (*cmp)(size_t, size_t))
+{
+    for (size_t i = count; i > 0; i--)
+    {
+        if (cmp(array[i - 1], value) == 0)
+            return i - 1;
+    }
+    return count;
+}
 struct stack *s_new(size_t capacity, struct stack_fval *f_val)
 {
     struct cmc_alloc_node *alloc = &cmc_alloc_node_default;
@@ -87,6 +112,7 @@ struct stack *s_new(size_t capacity, struct stack_fval *f_val)
     _stack_->f_val = f_val;
     _stack_->alloc = alloc;
     _stack_->callbacks = ((void *)0);
+    _stack_->growth = ((void *)0);
     return _stack_;
 }
 struct stack *s_new_custom(size_t capacity, struct stack_fval *f_val,
@@ -114,6 +140,7 @@ struct stack *s_new_custom(size_t capacity, struct stack_fval *f_val,
     _stack_->f_val = f_val;
     _stack_->alloc = alloc;
     _stack_->callbacks = callbacks;
+    _stack_->growth = ((void *)0);
     return _stack_;
 }
 void s_clear(struct stack *_stack_)
@@ -147,11 +174,16 @@ void s_customize(struct stack *_stack_, struct cmc_alloc_node *alloc,
     _stack_->callbacks = callbacks;
     _stack_->flag = cmc_flags.OK;
 }
+void s_set_growth(struct stack *_stack_, const struct cmc_growth *growth)
+{
+    _stack_->growth = growth;
+    _stack_->flag = cmc_flags.OK;
+}
 _Bool s_push(struct stack *_stack_, size_t value)
 {
     if (s_full(_stack_))
     {
-        if (!s_resize(_stack_, _stack_->capacity * 2))
+        if (!s_reserve(_stack_, 1))
             return 0;
     }
     _stack_->buffer[_stack_->count++] = value;
@@ -188,15 +220,8 @@ size_t s_top(struct stack *_stack_)
 _Bool s_contains(struct stack *_stack_, size_t value)
 {
     _stack_->flag = cmc_flags.OK;
-    _Bool result = 0;
-    for (size_t i = 0; i < _stack_->count; i++)
-    {
-        if (_stack_->f_val->cmp(_stack_->buffer[i], value) == 0)
-        {
-            result = 1;
-            break;
-        }
-    }
+    _Bool result = s_impl_search(_stack_->buffer, _stack_->count, value,
+                                 _stack_->f_val->cmp) < _stack_->count;
     if (_stack_->callbacks && _stack_->callbacks->read)
         _stack_->callbacks->read();
     return result;
@@ -245,6 +270,24 @@ success:
         _stack_->callbacks->resize();
     return 1;
 }
+_Bool s_reserve(struct stack *_stack_, size_t size)
+{
+    _stack_->flag = cmc_flags.OK;
+    if (size <= _stack_->capacity - _stack_->count)
+        return 1;
+    if (size > (18446744073709551615UL) - _stack_->count)
+    {
+        _stack_->flag = cmc_flags.ERROR;
+        return 0;
+    }
+    return s_resize(_stack_,
+                    cmc_growth_capacity(_stack_->growth, _stack_->capacity,
+                                        _stack_->count + size));
+}
+_Bool s_shrink_to_fit(struct stack *_stack_)
+{
+    return s_resize(_stack_, _stack_->count > 0 ? _stack_->count : 1);
+}
 struct stack *s_copy_of(struct stack *_stack_)
 {
     struct stack *result = s_new_custom(_stack_->capacity, _stack_->f_val,
@@ -263,6 +306,7 @@ struct stack *s_copy_of(struct stack *_stack_)
         memcpy(result->buffer, _stack_->buffer,
                sizeof(size_t) * _stack_->count);
     result->count = _stack_->count;
+    result->growth = _stack_->growth;
     _stack_->flag = cmc_flags.OK;
     return result;
 }
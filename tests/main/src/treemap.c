@@ -18,6 +18,7 @@ struct treemap_node
     size_t key;
     size_t value;
     unsigned char height;
+    size_t size;
     struct treemap_node *right;
     struct treemap_node *left;
     struct treemap_node *parent;
@@ -55,6 +56,9 @@ struct treemap *tm_new_custom(struct treemap_fkey *f_key,
                               struct treemap_fval *f_val,
                               struct cmc_alloc_node *alloc,
                               struct cmc_callbacks *callbacks);
+struct treemap *tm_from_sorted(size_t *keys, size_t *values, size_t count,
+                               struct treemap_fkey *f_key,
+                               struct treemap_fval *f_val);
 void tm_clear(struct treemap *_map_);
 void tm_free(struct treemap *_map_);
 void tm_customize(struct treemap *_map_, struct cmc_alloc_node *alloc,
@@ -63,11 +67,19 @@ _Bool tm_insert(struct treemap *_map_, size_t key, size_t value);
 _Bool tm_update(struct treemap *_map_, size_t key, size_t new_value,
                 size_t *old_value);
 _Bool tm_remove(struct treemap *_map_, size_t key, size_t *out_value);
+size_t tm_remove_range(struct treemap *_map_, size_t from, size_t to);
 _Bool tm_max(struct treemap *_map_, size_t *key, size_t *value);
 _Bool tm_min(struct treemap *_map_, size_t *key, size_t *value);
 size_t tm_get(struct treemap *_map_, size_t key);
 size_t *tm_get_ref(struct treemap *_map_, size_t key);
+_Bool tm_select(struct treemap *_map_, size_t index, size_t *key,
+                size_t *value);
+_Bool tm_floor(struct treemap *_map_, size_t key, size_t *out_key,
+               size_t *out_value);
+_Bool tm_ceiling(struct treemap *_map_, size_t key, size_t *out_key,
+                 size_t *out_value);
 _Bool tm_contains(struct treemap *_map_, size_t key);
+size_t tm_rank(struct treemap *_map_, size_t key);
 _Bool tm_empty(struct treemap *_map_);
 size_t tm_count(struct treemap *_map_);
 int tm_flag(struct treemap *_map_);
@@ -77,6 +89,11 @@ struct cmc_string tm_to_string(struct treemap *_map_);
 _Bool tm_print(struct treemap *_map_, FILE *fptr);
 struct treemap_iter tm_iter_start(struct treemap *target);
 struct treemap_iter tm_iter_end(struct treemap *target);
+struct treemap_iter tm_iter_from(struct treemap *target, size_t key);
+struct treemap_iter tm_iter_range(struct treemap *target, size_t from,
+                                  size_t to);
+struct treemap_iter tm_lower_bound(struct treemap *target, size_t key);
+struct treemap_iter tm_upper_bound(struct treemap *target, size_t key);
 _Bool tm_iter_at_start(struct treemap_iter *iter);
 _Bool tm_iter_at_end(struct treemap_iter *iter);
 _Bool tm_iter_to_start(struct treemap_iter *iter);
@@ -93,8 +110,27 @@ size_t tm_iter_index(struct treemap_iter *iter);
 static struct treemap_node *tm_impl_new_node(struct treemap *_map_, size_t key,
                                              size_t value);
 static struct treemap_node *tm_impl_get_node(struct treemap *_map_, size_t key);
+static struct treemap_node *tm_impl_floor(struct treemap *_map_, size_t key,
+                                          _Bool inclusive);
+static struct treemap_node *tm_impl_ceiling(struct treemap *_map_, size_t key,
+                                            _Bool inclusive);
+static void tm_impl_remove_node(struct treemap *_map_,
+                                struct treemap_node *node);
 static unsigned char tm_impl_h(struct treemap_node *node);
 static unsigned char tm_impl_hupdate(struct treemap_node *node);
+static size_t tm_impl_size(struct treemap_node *node);
+static size_t tm_impl_supdate(struct treemap_node *node);
+static size_t tm_impl_index_of(struct treemap_node *node);
+static struct treemap_node *tm_impl_select(struct treemap_node *node,
+                                           size_t index);
+static struct treemap_node *tm_impl_to_list(struct treemap_node *root);
+static struct treemap_node *tm_impl_build(struct treemap_node **list,
+                                          size_t count);
+static struct treemap_node *tm_impl_sort_list(struct treemap *_map_,
+                                              struct treemap_node *head,
+                                              size_t count);
+static struct treemap_iter tm_impl_iter_at(struct treemap *target,
+                                           struct treemap_node *node);
 static void tm_impl_rotate_right(struct treemap_node **Z);
 static void tm_impl_rotate_left(struct treemap_node **Z);
 static void tm_impl_rebalance(struct treemap *_map_, struct treemap_node *node);
@@ -136,6 +172,63 @@ struct treemap *tm_new_custom(struct treemap_fkey *f_key,
     _map_->callbacks = callbacks;
     return _map_;
 }
+struct treemap *tm_from_sorted(size_t *keys, size_t *values, size_t count,
+                               struct treemap_fkey *f_key,
+                               struct treemap_fval *f_val)
+{
+    struct treemap *_map_ = tm_new(f_key, f_val);
+    if (!_map_)
+        return ((void *)0);
+    struct treemap_node *head = ((void *)0), *tail = ((void *)0);
+    _Bool sorted = 1;
+    for (size_t i = 0; i < count; i++)
+    {
+        struct treemap_node *node = tm_impl_new_node(_map_, keys[i], values[i]);
+        if (!node)
+        {
+            while (head != ((void *)0))
+            {
+                tail = head->right;
+                _map_->alloc->free(head);
+                head = tail;
+            }
+            tm_free(_map_);
+            return ((void *)0);
+        }
+        if (tail != ((void *)0))
+        {
+            if (_map_->f_key->cmp(tail->key, node->key) >= 0)
+                sorted = 0;
+            tail->right = node;
+        }
+        else
+            head = node;
+        tail = node;
+    }
+    if (!sorted)
+    {
+        head = tm_impl_sort_list(_map_, head, count);
+        for (struct treemap_node *scan = head; scan->right != ((void *)0);)
+        {
+            struct treemap_node *next = scan->right;
+            if (_map_->f_key->cmp(scan->key, next->key) == 0)
+            {
+                if (_map_->f_key->free)
+                    _map_->f_key->free(next->key);
+                if (_map_->f_val->free)
+                    _map_->f_val->free(next->value);
+                scan->right = next->right;
+                _map_->alloc->free(next);
+                count--;
+            }
+            else
+                scan = next;
+        }
+    }
+    _map_->root = tm_impl_build(&head, count);
+    _map_->count = count;
+    return _map_;
+}
 void tm_clear(struct treemap *_map_)
 {
     struct treemap_node *scan = _map_->root;
@@ -299,102 +392,60 @@ _Bool tm_remove(struct treemap *_map_, size_t key, size_t *out_value)
     }
     if (out_value)
         *out_value = node->value;
-    struct treemap_node *temp = ((void *)0), *unbalanced = ((void *)0);
-    _Bool is_root = node->parent == ((void *)0);
-    if (node->left == ((void *)0) && node->right == ((void *)0))
-    {
-        if (is_root)
-            _map_->root = ((void *)0);
-        else
-        {
-            unbalanced = node->parent;
-            if (node->parent->right == node)
-                node->parent->right = ((void *)0);
-            else
-                node->parent->left = ((void *)0);
-        }
-        _map_->alloc->free(node);
-    }
-    else if (node->left == ((void *)0))
-    {
-        if (is_root)
-        {
-            _map_->root = node->right;
-            _map_->root->parent = ((void *)0);
-        }
-        else
-        {
-            unbalanced = node->parent;
-            node->right->parent = node->parent;
-            if (node->parent->right == node)
-                node->parent->right = node->right;
-            else
-                node->parent->left = node->right;
-        }
-        _map_->alloc->free(node);
-    }
-    else if (node->right == ((void *)0))
+    tm_impl_remove_node(_map_, node);
+    if (_map_->count == 0)
+        _map_->root = ((void *)0);
+    _map_->count--;
+    _map_->flag = cmc_flags.OK;
+    if (_map_->callbacks && _map_->callbacks->delete)
+        _map_->callbacks->delete ();
+    return 1;
+}
+size_t tm_remove_range(struct treemap *_map_, size_t from, size_t to)
+{
+    _map_->flag = cmc_flags.OK;
+    struct treemap_node *first = tm_impl_ceiling(_map_, from, 1);
+    if (!first || _map_->f_key->cmp(first->key, to) >= 0)
+        return 0;
+    struct treemap_node *last = tm_impl_floor(_map_, to, 0);
+    size_t index = tm_impl_index_of(first);
+    size_t total = tm_impl_index_of(last) - index + 1;
+    if (total * tm_impl_h(_map_->root) < _map_->count)
     {
-        if (is_root)
+        for (size_t i = 0; i < total; i++)
         {
-            _map_->root = node->left;
-            _map_->root->parent = ((void *)0);
-        }
-        else
-        {
-            unbalanced = node->parent;
-            node->left->parent = node->parent;
-            if (node->parent->right == node)
-                node->parent->right = node->left;
-            else
-                node->parent->left = node->left;
+            struct treemap_node *node = tm_impl_select(_map_->root, index);
+            if (_map_->f_key->free)
+                _map_->f_key->free(node->key);
+            if (_map_->f_val->free)
+                _map_->f_val->free(node->value);
+            tm_impl_remove_node(_map_, node);
         }
-        _map_->alloc->free(node);
     }
     else
     {
-        temp = node->right;
-        while (temp->left != ((void *)0))
-            temp = temp->left;
-        size_t temp_key = temp->key;
-        size_t temp_val = temp->value;
-        unbalanced = temp->parent;
-        if (temp->left == ((void *)0) && temp->right == ((void *)0))
-        {
-            if (temp->parent->right == temp)
-                temp->parent->right = ((void *)0);
-            else
-                temp->parent->left = ((void *)0);
-        }
-        else if (temp->left == ((void *)0))
-        {
-            temp->right->parent = temp->parent;
-            if (temp->parent->right == temp)
-                temp->parent->right = temp->right;
-            else
-                temp->parent->left = temp->right;
-        }
-        else if (temp->right == ((void *)0))
+        struct treemap_node *head = tm_impl_to_list(_map_->root);
+        struct treemap_node **link = &head;
+        while (*link != first)
+            link = &(*link)->right;
+        for (size_t i = 0; i < total; i++)
         {
-            temp->left->parent = temp->parent;
-            if (temp->parent->right == temp)
-                temp->parent->right = temp->left;
-            else
-                temp->parent->left = temp->left;
+            struct treemap_node *node = *link;
+            *link = node->right;
+            if (_map_->f_key->free)
+                _map_->f_key->free(node->key);
+            if (_map_->f_val->free)
+                _map_->f_val->free(node->value);
+            _map_->alloc->free(node);
         }
-        _map_->alloc->free(temp);
-        node->key = temp_key;
-        node->value = temp_val;
+        _map_->root = tm_impl_build(&head, _map_->count - total);
+        if (_map_->root != ((void *)0))
+            _map_->root->parent = ((void *)0);
     }
-    if (unbalanced != ((void *)0))
-        tm_impl_rebalance(_map_, unbalanced);
-    if (_map_->count == 0)
-        _map_->root = ((void *)0);
-    _map_->count--;
-    _map_->flag = cmc_flags.OK;
+    _map_->count -= total;
     if (_map_->callbacks && _map_->callbacks->delete)
         _map_->callbacks->delete ();
-    return 1;
+    return total;
 }
 _Bool tm_max(struct treemap *_map_, size_t *key, size_t *value)
 {
@@ -470,6 +521,74 @@ size_t *tm_get_ref(struct treemap *_map_, size_t key)
         _map_->callbacks->read();
     return &(node->value);
 }
+_Bool tm_select(struct treemap *_map_, size_t index, size_t *key, size_t *value)
+{
+    if (tm_empty(_map_))
+    {
+        _map_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    if (index >= _map_->count)
+    {
+        _map_->flag = cmc_flags.RANGE;
+        return 0;
+    }
+    struct treemap_node *node = tm_impl_select(_map_->root, index);
+    if (key)
+        *key = node->key;
+    if (value)
+        *value = node->value;
+    _map_->flag = cmc_flags.OK;
+    if (_map_->callbacks && _map_->callbacks->read)
+        _map_->callbacks->read();
+    return 1;
+}
+_Bool tm_floor(struct treemap *_map_, size_t key, size_t *out_key,
+               size_t *out_value)
+{
+    if (tm_empty(_map_))
+    {
+        _map_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    struct treemap_node *node = tm_impl_floor(_map_, key, 1);
+    if (!node)
+    {
+        _map_->flag = cmc_flags.NOT_FOUND;
+        return 0;
+    }
+    if (out_key)
+        *out_key = node->key;
+    if (out_value)
+        *out_value = node->value;
+    _map_->flag = cmc_flags.OK;
+    if (_map_->callbacks && _map_->callbacks->read)
+        _map_->callbacks->read();
+    return 1;
+}
+_Bool tm_ceiling(struct treemap *_map_, size_t key, size_t *out_key,
+                 size_t *out_value)
+{
+    if (tm_empty(_map_))
+    {
+        _map_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    struct treemap_node *node = tm_impl_ceiling(_map_, key, 1);
+    if (!node)
+    {
+        _map_->flag = cmc_flags.NOT_FOUND;
+        return 0;
+    }
+    if (out_key)
+        *out_key = node->key;
+    if (out_value)
+        *out_value = node->value;
+    _map_->flag = cmc_flags.OK;
+    if (_map_->callbacks && _map_->callbacks->read)
+        _map_->callbacks->read();
+    return 1;
+}
 _Bool tm_contains(struct treemap *_map_, size_t key)
 {
     _Bool result = tm_impl_get_node(_map_, key) != ((void *)0);
@@ -477,6 +596,25 @@ _Bool tm_contains(struct treemap *_map_, size_t key)
         _map_->callbacks->read();
     return result;
 }
+size_t tm_rank(struct treemap *_map_, size_t key)
+{
+    size_t rank = 0;
+    struct treemap_node *scan = _map_->root;
+    while (scan != ((void *)0))
+    {
+        if (_map_->f_key->cmp(scan->key, key) < 0)
+        {
+            rank += tm_impl_size(scan->left) + 1;
+            scan = scan->right;
+        }
+        else
+            scan = scan->left;
+    }
+    _map_->flag = cmc_flags.OK;
+    if (_map_->callbacks && _map_->callbacks->read)
+        _map_->callbacks->read();
+    return rank;
+}
 _Bool tm_empty(struct treemap *_map_)
 {
     return _map_->count == 0;
@@ -616,6 +754,40 @@ struct treemap_iter tm_iter_end(struct treemap *target)
     }
     return iter;
 }
+struct treemap_iter tm_iter_from(struct treemap *target, size_t key)
+{
+    struct treemap_iter iter = tm_iter_start(target);
+    iter.first = tm_impl_ceiling(target, key, 1);
+    if (!iter.first)
+        iter.last = ((void *)0);
+    iter.cursor = iter.first;
+    iter.end = iter.first == ((void *)0);
+    return iter;
+}
+struct treemap_iter tm_iter_range(struct treemap *target, size_t from,
+                                  size_t to)
+{
+    struct treemap_iter iter = tm_iter_start(target);
+    iter.first = tm_impl_ceiling(target, from, 1);
+    iter.last = tm_impl_floor(target, to, 0);
+    if (!iter.first || !iter.last ||
+        target->f_key->cmp(iter.first->key, iter.last->key) > 0)
+    {
+        iter.first = ((void *)0);
+        iter.last = ((void *)0);
+    }
+    iter.cursor = iter.first;
+    iter.end = iter.first == ((void *)0);
+    return iter;
+}
+struct treemap_iter tm_lower_bound(struct treemap *target, size_t key)
+{
+    return tm_impl_iter_at(target, tm_impl_ceiling(target, key, 1));
+}
+struct treemap_iter tm_upper_bound(struct treemap *target, size_t key)
+{
+    return tm_impl_iter_at(target, tm_impl_ceiling(target, key, 0));
+}
 _Bool tm_iter_at_start(struct treemap_iter *iter)
 {
     return tm_empty(iter->target) || iter->start;
@@ -626,7 +798,7 @@ _Bool tm_iter_at_end(struct treemap_iter *iter)
 }
 _Bool tm_iter_to_start(struct treemap_iter *iter)
 {
-    if (!tm_empty(iter->target))
+    if (iter->first != ((void *)0))
     {
         iter->index = 0;
         iter->start = 1;
@@ -638,9 +810,10 @@ _Bool tm_iter_to_start(struct treemap_iter *iter)
 }
 _Bool tm_iter_to_end(struct treemap_iter *iter)
 {
-    if (!tm_empty(iter->target))
+    if (iter->first != ((void *)0))
     {
-        iter->index = iter->target->count - 1;
+        iter->index =
+            tm_impl_index_of(iter->last) - tm_impl_index_of(iter->first);
         iter->start = tm_empty(iter->target);
         iter->end = 1;
         iter->cursor = iter->last;
@@ -715,10 +888,12 @@ _Bool tm_iter_advance(struct treemap_iter *iter, size_t steps)
         iter->end = 1;
         return 0;
     }
-    if (steps == 0 || iter->index + steps >= iter->target->count)
+    size_t index = tm_impl_index_of(iter->cursor);
+    if (steps == 0 || index + steps > tm_impl_index_of(iter->last))
         return 0;
-    for (size_t i = 0; i < steps; i++)
-        tm_iter_next(iter);
+    iter->cursor = tm_impl_select(iter->target->root, index + steps);
+    iter->index += steps;
+    iter->start = tm_empty(iter->target);
     return 1;
 }
 _Bool tm_iter_rewind(struct treemap_iter *iter, size_t steps)
@@ -732,8 +907,10 @@ _Bool tm_iter_rewind(struct treemap_iter *iter, size_t steps)
     }
     if (steps == 0 || iter->index < steps)
         return 0;
-    for (size_t i = 0; i < steps; i++)
-        tm_iter_prev(iter);
+    size_t index = tm_impl_index_of(iter->cursor) - steps;
+    iter->cursor = tm_impl_select(iter->target->root, index);
+    iter->index -= steps;
+    iter->end = tm_empty(iter->target);
     return 1;
 }
 _Bool tm_iter_go_to(struct treemap_iter *iter, size_t index)
@@ -748,19 +925,19 @@ _Bool tm_iter_go_to(struct treemap_iter *iter, size_t index)
 }
 size_t tm_iter_key(struct treemap_iter *iter)
 {
-    if (tm_empty(iter->target))
+    if (iter->cursor == ((void *)0))
         return (size_t){ 0 };
     return iter->cursor->key;
 }
 size_t tm_iter_value(struct treemap_iter *iter)
 {
-    if (tm_empty(iter->target))
+    if (iter->cursor == ((void *)0))
         return (size_t){ 0 };
     return iter->cursor->value;
 }
 size_t *tm_iter_rvalue(struct treemap_iter *iter)
 {
-    if (tm_empty(iter->target))
+    if (iter->cursor == ((void *)0))
         return ((void *)0);
     return &(iter->cursor->value);
 }
@@ -781,6 +958,7 @@ static struct treemap_node *tm_impl_new_node(struct treemap *_map_, size_t key,
     node->left = ((void *)0);
     node->parent = ((void *)0);
     node->height = 0;
+    node->size = 1;
     return node;
 }
 static struct treemap_node *tm_impl_get_node(struct treemap *_map_, size_t key)
@@ -797,6 +975,133 @@ static struct treemap_node *tm_impl_get_node(struct treemap *_map_, size_t key)
     }
     return ((void *)0);
 }
+static struct treemap_node *tm_impl_floor(struct treemap *_map_, size_t key,
+                                          _Bool inclusive)
+{
+    struct treemap_node *scan = _map_->root, *result = ((void *)0);
+    while (scan != ((void *)0))
+    {
+        int c = _map_->f_key->cmp(scan->key, key);
+        if (c < 0 || (c == 0 && inclusive))
+        {
+            result = scan;
+            scan = scan->right;
+        }
+        else
+            scan = scan->left;
+    }
+    return result;
+}
+static struct treemap_node *tm_impl_ceiling(struct treemap *_map_, size_t key,
+                                            _Bool inclusive)
+{
+    struct treemap_node *scan = _map_->root, *result = ((void *)0);
+    while (scan != ((void *)0))
+    {
+        int c = _map_->f_key->cmp(scan->key, key);
+        if (c > 0 || (c == 0 && inclusive))
+        {
+            result = scan;
+            scan = scan->left;
+        }
+        else
+            scan = scan->right;
+    }
+    return result;
+}
+static void tm_impl_remove_node(struct treemap *_map_,
+                                struct treemap_node *node)
+{
+    struct treemap_node *temp = ((void *)0), *unbalanced = ((void *)0);
+    _Bool is_root = node->parent == ((void *)0);
+    if (node->left == ((void *)0) && node->right == ((void *)0))
+    {
+        if (is_root)
+            _map_->root = ((void *)0);
+        else
+        {
+            unbalanced = node->parent;
+            if (node->parent->right == node)
+                node->parent->right = ((void *)0);
+            else
+                node->parent->left = ((void *)0);
+        }
+        _map_->alloc->free(node);
+    }
+    else if (node->left == ((void *)0))
+    {
+        if (is_root)
+        {
+            _map_->root = node->right;
+            _map_->root->parent = ((void *)0);
+        }
+        else
+        {
+            unbalanced = node->parent;
+            node->right->parent = node->parent;
+            if (node->parent->right == node)
+                node->parent->right = node->right;
+            else
+                node->parent->left = node->right;
+        }
+        _map_->alloc->free(node);
+    }
+    else if (node->right == ((void *)0))
+    {
+        if (is_root)
+        {
+            _map_->root = node->left;
+            _map_->root->parent = ((void *)0);
+        }
+        else
+        {
+            unbalanced = node->parent;
+            node->left->parent = node->parent;
+            if (node->parent->right == node)
+                node->parent->right = node->left;
+            else
+                node->parent->left = node->left;
+        }
+        _map_->alloc->free(node);
+    }
+    else
+    {
+        temp = node->right;
+        while (temp->left != ((void *)0))
+            temp = temp->left;
+        size_t temp_key = temp->key;
+        size_t temp_val = temp->value;
+        unbalanced = temp->parent;
+        if (temp->left == ((void *)0) && temp->right == ((void *)0))
+        {
+            if (temp->parent->right == temp)
+                temp->parent->right = ((void *)0);
+            else
+                temp->parent->left = ((void *)0);
+        }
+        else if (temp->left == ((void *)0))
+        {
+            temp->right->parent = temp->parent;
+            if (temp->parent->right == temp)
+                temp->parent->right = temp->right;
+            else
+                temp->parent->left = temp->right;
+        }
+        else if (temp->right == ((void *)0))
+        {
+            temp->left->parent = temp->parent;
+            if (temp->parent->right == temp)
+                temp->parent->right = temp->left;
+            else
+                temp->parent->left = temp->left;
+        }
+        _map_->alloc->free(temp);
+        node->key = temp_key;
+        node->value = temp_val;
+    }
+    if (unbalanced != ((void *)0))
+        tm_impl_rebalance(_map_, unbalanced);
+}
 static unsigned char tm_impl_h(struct treemap_node *node)
 {
     if (node == ((void *)0))
@@ -811,6 +1116,130 @@ static unsigned char tm_impl_hupdate(struct treemap_node *node)
     unsigned char h_r = tm_impl_h(node->right);
     return 1 + (h_l > h_r ? h_l : h_r);
 }
+static size_t tm_impl_size(struct treemap_node *node)
+{
+    if (node == ((void *)0))
+        return 0;
+    return node->size;
+}
+static size_t tm_impl_supdate(struct treemap_node *node)
+{
+    if (node == ((void *)0))
+        return 0;
+    return 1 + tm_impl_size(node->left) + tm_impl_size(node->right);
+}
+static size_t tm_impl_index_of(struct treemap_node *node)
+{
+    size_t index = tm_impl_size(node->left);
+    for (; node->parent != ((void *)0); node = node->parent)
+    {
+        if (node->parent->right == node)
+            index += tm_impl_size(node->parent->left) + 1;
+    }
+    return index;
+}
+static struct treemap_node *tm_impl_select(struct treemap_node *node,
+                                           size_t index)
+{
+    while (node != ((void *)0))
+    {
+        size_t left = tm_impl_size(node->left);
+        if (index < left)
+            node = node->left;
+        else if (index > left)
+        {
+            index -= left + 1;
+            node = node->right;
+        }
+        else
+            break;
+    }
+    return node;
+}
+static struct treemap_node *tm_impl_to_list(struct treemap_node *root)
+{
+    struct treemap_node *head = ((void *)0), *tail = ((void *)0), *scan = root;
+    while (scan != ((void *)0))
+    {
+        if (scan->left != ((void *)0))
+        {
+            struct treemap_node *left = scan->left;
+            scan->left = left->right;
+            left->right = scan;
+            scan = left;
+        }
+        else
+        {
+            if (tail != ((void *)0))
+                tail->right = scan;
+            else
+                head = scan;
+            tail = scan;
+            scan = scan->right;
+        }
+    }
+    return head;
+}
+static struct treemap_node *tm_impl_build(struct treemap_node **list,
+                                          size_t count)
+{
+    if (count == 0)
+        return ((void *)0);
+    struct treemap_node *left = tm_impl_build(list, count / 2);
+    struct treemap_node *root = *list;
+    *list = root->right;
+    root->left = left;
+    root->right = tm_impl_build(list, count - count / 2 - 1);
+    if (root->left)
+        root->left->parent = root;
+    if (root->right)
+        root->right->parent = root;
+    root->height = tm_impl_hupdate(root);
+    root->size = count;
+    return root;
+}
+static struct treemap_node *tm_impl_sort_list(struct treemap *_map_,
+                                              struct treemap_node *head,
+                                              size_t count)
+{
+    if (count < 2)
+        return head;
+    struct treemap_node *middle = head;
+    for (size_t i = 1; i < count / 2; i++)
+        middle = middle->right;
+    struct treemap_node *right = middle->right;
+    middle->right = ((void *)0);
+    struct treemap_node *left = tm_impl_sort_list(_map_, head, count / 2);
+    right = tm_impl_sort_list(_map_, right, count - count / 2);
+    struct treemap_node *result = ((void *)0), **tail = &result;
+    while (left != ((void *)0) && right != ((void *)0))
+    {
+        if (_map_->f_key->cmp(right->key, left->key) < 0)
+        {
+            *tail = right;
+            right = right->right;
+        }
+        else
+        {
+            *tail = left;
+            left = left->right;
+        }
+        tail = &(*tail)->right;
+    }
+    *tail = left != ((void *)0) ? left : right;
+    return result;
+}
+static struct treemap_iter tm_impl_iter_at(struct treemap *target,
+                                           struct treemap_node *node)
+{
+    if (!node)
+        return tm_iter_end(target);
+    struct treemap_iter iter = tm_iter_start(target);
+    iter.cursor = node;
+    iter.index = tm_impl_index_of(node);
+    iter.start = iter.index == 0;
+    return iter;
+}
 static void tm_impl_rotate_right(struct treemap_node **Z)
 {
     struct treemap_node *root = *Z;
@@ -830,6 +1259,8 @@ static void tm_impl_rotate_right(struct treemap_node **Z)
     new_root->right = root;
     root->height = tm_impl_hupdate(root);
     new_root->height = tm_impl_hupdate(new_root);
+    root->size = tm_impl_supdate(root);
+    new_root->size = tm_impl_supdate(new_root);
     *Z = new_root;
 }
 static void tm_impl_rotate_left(struct treemap_node **Z)
@@ -851,6 +1282,8 @@ static void tm_impl_rotate_left(struct treemap_node **Z)
     new_root->left = root;
     root->height = tm_impl_hupdate(root);
     new_root->height = tm_impl_hupdate(new_root);
+    root->size = tm_impl_supdate(root);
+    new_root->size = tm_impl_supdate(new_root);
     *Z = new_root;
 }
 static void tm_impl_rebalance(struct treemap *_map_, struct treemap_node *node)
@@ -863,6 +1296,7 @@ static void tm_impl_rebalance(struct treemap *_map_, struct treemap_node *node)
         if (scan->parent == ((void *)0))
             is_root = 1;
         scan->height = tm_impl_hupdate(scan);
+        scan->size = tm_impl_supdate(scan);
         balance = tm_impl_h(scan->right) - tm_impl_h(scan->left);
         if (balance >= 2)
         {
@@ -16,6 +16,7 @@ struct treeset_node
 {
     size_t value;
     unsigned char height;
+    size_t size;
     struct treeset_node *right;
     struct treeset_node *left;
     struct treeset_node *parent;
@@ -43,15 +44,22 @@ struct treeset *ts_new(struct treeset_fval *f_val);
 struct treeset *ts_new_custom(struct treeset_fval *f_val,
                               struct cmc_alloc_node *alloc,
                               struct cmc_callbacks *callbacks);
+struct treeset *ts_from_sorted(size_t *values, size_t count,
+                               struct treeset_fval *f_val);
 void ts_clear(struct treeset *_set_);
 void ts_free(struct treeset *_set_);
 void ts_customize(struct treeset *_set_, struct cmc_alloc_node *alloc,
                   struct cmc_callbacks *callbacks);
 _Bool ts_insert(struct treeset *_set_, size_t value);
 _Bool ts_remove(struct treeset *_set_, size_t value);
+size_t ts_remove_range(struct treeset *_set_, size_t from, size_t to);
 _Bool ts_max(struct treeset *_set_, size_t *value);
 _Bool ts_min(struct treeset *_set_, size_t *value);
+_Bool ts_select(struct treeset *_set_, size_t index, size_t *value);
+_Bool ts_floor(struct treeset *_set_, size_t value, size_t *out_value);
+_Bool ts_ceiling(struct treeset *_set_, size_t value, size_t *out_value);
 _Bool ts_contains(struct treeset *_set_, size_t value);
+size_t ts_rank(struct treeset *_set_, size_t value);
 _Bool ts_empty(struct treeset *_set_);
 size_t ts_count(struct treeset *_set_);
 int ts_flag(struct treeset *_set_);
@@ -71,6 +79,11 @@ _Bool ts_is_proper_superset(struct treeset *_set1_, struct treeset *_set2_);
 _Bool ts_is_disjointset(struct treeset *_set1_, struct treeset *_set2_);
 struct treeset_iter ts_iter_start(struct treeset *target);
 struct treeset_iter ts_iter_end(struct treeset *target);
+struct treeset_iter ts_iter_from(struct treeset *target, size_t value);
+struct treeset_iter ts_iter_range(struct treeset *target, size_t from,
+                                  size_t to);
+struct treeset_iter ts_lower_bound(struct treeset *target, size_t value);
+struct treeset_iter ts_upper_bound(struct treeset *target, size_t value);
 _Bool ts_iter_at_start(struct treeset_iter *iter);
 _Bool ts_iter_at_end(struct treeset_iter *iter);
 _Bool ts_iter_to_start(struct treeset_iter *iter);
@@ -88,12 +101,52 @@ static inline size_t ts_impl_default_value(void)
     memset(&_empty_value_, 0, sizeof(size_t));
     return _empty_value_;
 }
+struct treeset_impl_merge
+{
+    struct treeset *result;
+    struct treeset_iter iter1;
+    struct treeset_iter iter2;
+    _Bool only1;
+    _Bool both;
+    _Bool only2;
+    struct treeset_node *head;
+    struct treeset_node *tail;
+    size_t count;
+};
 static struct treeset_node *ts_impl_new_node(struct treeset *_set_,
                                              size_t value);
 static struct treeset_node *ts_impl_get_node(struct treeset *_set_,
                                              size_t value);
+static struct treeset_node *ts_impl_floor(struct treeset *_set_, size_t value,
+                                          _Bool inclusive);
+static struct treeset_node *ts_impl_ceiling(struct treeset *_set_, size_t value,
+                                            _Bool inclusive);
+static void ts_impl_remove_node(struct treeset *_set_,
+                                struct treeset_node *node);
 static unsigned char ts_impl_h(struct treeset_node *node);
 static unsigned char ts_impl_hupdate(struct treeset_node *node);
+static size_t ts_impl_size(struct treeset_node *node);
+static size_t ts_impl_supdate(struct treeset_node *node);
+static size_t ts_impl_index_of(struct treeset_node *node);
+static struct treeset_node *ts_impl_select(struct treeset_node *node,
+                                           size_t index);
+static struct treeset_node *ts_impl_to_list(struct treeset_node *root);
+static struct treeset_node *ts_impl_build(struct treeset_node **list,
+                                          size_t count);
+static struct treeset_node *ts_impl_sort_list(struct treeset *_set_,
+                                              struct treeset_node *head,
+                                              size_t count);
+static void ts_impl_free_list(struct treeset *_set_, struct treeset_node *head);
+static struct treeset_iter ts_impl_iter_at(struct treeset *target,
+                                           struct treeset_node *node);
+static struct treeset_iter ts_impl_iter_range(struct treeset *target,
+                                              struct treeset_node *first,
+                                              struct treeset_node *last);
+static _Bool ts_impl_merge(struct treeset_impl_merge *merge);
+static struct treeset *ts_impl_set_operation(struct treeset *_set1_,
+                                             struct treeset *_set2_,
+                                             _Bool only1, _Bool both,
+                                             _Bool only2);
 static void ts_impl_rotate_right(struct treeset_node **Z);
 static void ts_impl_rotate_left(struct treeset_node **Z);
 static void ts_impl_rebalance(struct treeset *_set_, struct treeset_node *node);
@@ -132,6 +185,55 @@ struct treeset *ts_new_custom(struct treeset_fval *f_val,
     _set_->callbacks = callbacks;
     return _set_;
 }
+struct treeset *ts_from_sorted(size_t *values, size_t count,
+                               struct treeset_fval *f_val)
+{
+    struct treeset *_set_ = ts_new(f_val);
+    if (!_set_)
+        return ((void *)0);
+    struct treeset_node *head = ((void *)0), *tail = ((void *)0);
+    _Bool sorted = 1;
+    for (size_t i = 0; i < count; i++)
+    {
+        struct treeset_node *node = ts_impl_new_node(_set_, values[i]);
+        if (!node)
+        {
+            ts_impl_free_list(_set_, head);
+            ts_free(_set_);
+            return ((void *)0);
+        }
+        if (tail != ((void *)0))
+        {
+            if (_set_->f_val->cmp(tail->value, node->value) >= 0)
+                sorted = 0;
+            tail->right = node;
+        }
+        else
+            head = node;
+        tail = node;
+    }
+    if (!sorted)
+    {
+        head = ts_impl_sort_list(_set_, head, count);
+        for (struct treeset_node *scan = head; scan->right != ((void *)0);)
+        {
+            struct treeset_node *next = scan->right;
+            if (_set_->f_val->cmp(scan->value, next->value) == 0)
+            {
+                if (_set_->f_val->free)
+                    _set_->f_val->free(next->value);
+                scan->right = next->right;
+                _set_->alloc->free(next);
+                count--;
+            }
+            else
+                scan = next;
+        }
+    }
+    _set_->root = ts_impl_build(&head, count);
+    _set_->count = count;
+    return _set_;
+}
 void ts_clear(struct treeset *_set_)
 {
     struct treeset_node *scan = _set_->root;
@@ -272,100 +374,56 @@ _Bool ts_remove(struct treeset *_set_, size_t value)
         _set_->flag = cmc_flags.NOT_FOUND;
         return 0;
     }
-    struct treeset_node *temp = ((void *)0), *unbalanced = ((void *)0);
-    _Bool is_root = node->parent == ((void *)0);
-    if (node->left == ((void *)0) && node->right == ((void *)0))
-    {
-        if (is_root)
-            _set_->root = ((void *)0);
-        else
-        {
-            unbalanced = node->parent;
-            if (node->parent->right == node)
-                node->parent->right = ((void *)0);
-            else
-                node->parent->left = ((void *)0);
-        }
-        _set_->alloc->free(node);
-    }
-    else if (node->left == ((void *)0))
-    {
-        if (is_root)
-        {
-            _set_->root = node->right;
-            _set_->root->parent = ((void *)0);
-        }
-        else
-        {
-            unbalanced = node->parent;
-            node->right->parent = node->parent;
-            if (node->parent->right == node)
-                node->parent->right = node->right;
-            else
-                node->parent->left = node->right;
-        }
-        _set_->alloc->free(node);
-    }
-    else if (node->right == ((void *)0))
+    ts_impl_remove_node(_set_, node);
+    if (_set_->count == 0)
+        _set_->root = ((void *)0);
+    _set_->count--;
+    _set_->flag = cmc_flags.OK;
+    if (_set_->callbacks && _set_->callbacks->delete)
+        _set_->callbacks->delete ();
+    return 1;
+}
+size_t ts_remove_range(struct treeset *_set_, size_t from, size_t to)
+{
+    _set_->flag = cmc_flags.OK;
+    struct treeset_node *first = ts_impl_ceiling(_set_, from, 1);
+    if (!first || _set_->f_val->cmp(first->value, to) >= 0)
+        return 0;
+    struct treeset_node *last = ts_impl_floor(_set_, to, 0);
+    size_t index = ts_impl_index_of(first);
+    size_t total = ts_impl_index_of(last) - index + 1;
+    if (total * ts_impl_h(_set_->root) < _set_->count)
     {
-        if (is_root)
+        for (size_t i = 0; i < total; i++)
         {
-            _set_->root = node->left;
-            _set_->root->parent = ((void *)0);
+            struct treeset_node *node = ts_impl_select(_set_->root, index);
+            if (_set_->f_val->free)
+                _set_->f_val->free(node->value);
+            ts_impl_remove_node(_set_, node);
         }
-        else
-        {
-            unbalanced = node->parent;
-            node->left->parent = node->parent;
-            if (node->parent->right == node)
-                node->parent->right = node->left;
-            else
-                node->parent->left = node->left;
-        }
-        _set_->alloc->free(node);
     }
     else
     {
-        temp = node->right;
-        while (temp->left != ((void *)0))
-            temp = temp->left;
-        size_t temp_value = temp->value;
-        unbalanced = temp->parent;
-        if (temp->left == ((void *)0) && temp->right == ((void *)0))
+        struct treeset_node *head = ts_impl_to_list(_set_->root);
+        struct treeset_node **link = &head;
+        while (*link != first)
+            link = &(*link)->right;
+        for (size_t i = 0; i < total; i++)
         {
-            if (temp->parent->right == temp)
-                temp->parent->right = ((void *)0);
-            else
-                temp->parent->left = ((void *)0);
+            struct treeset_node *node = *link;
+            *link = node->right;
+            if (_set_->f_val->free)
+                _set_->f_val->free(node->value);
+            _set_->alloc->free(node);
         }
-        else if (temp->left == ((void *)0))
-        {
-            temp->right->parent = temp->parent;
-            if (temp->parent->right == temp)
-                temp->parent->right = temp->right;
-            else
-                temp->parent->left = temp->right;
-        }
-        else if (temp->right == ((void *)0))
-        {
-            temp->left->parent = temp->parent;
-            if (temp->parent->right == temp)
-                temp->parent->right = temp->left;
-            else
-                temp->parent->left = temp->left;
-        }
-        _set_->alloc->free(temp);
-        node->value = temp_value;
+        _set_->root = ts_impl_build(&head, _set_->count - total);
+        if (_set_->root != ((void *)0))
+            _set_->root->parent = ((void *)0);
     }
-    if (unbalanced != ((void *)0))
-        ts_impl_rebalance(_set_, unbalanced);
-    if (_set_->count == 0)
-        _set_->root = ((void *)0);
-    _set_->count--;
-    _set_->flag = cmc_flags.OK;
+    _set_->count -= total;
     if (_set_->callbacks && _set_->callbacks->delete)
         _set_->callbacks->delete ();
-    return 1;
+    return total;
 }
 _Bool ts_max(struct treeset *_set_, size_t *value)
 {
@@ -401,6 +459,66 @@ _Bool ts_min(struct treeset *_set_, size_t *value)
         _set_->callbacks->read();
     return 1;
 }
+_Bool ts_select(struct treeset *_set_, size_t index, size_t *value)
+{
+    if (ts_empty(_set_))
+    {
+        _set_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    if (index >= _set_->count)
+    {
+        _set_->flag = cmc_flags.RANGE;
+        return 0;
+    }
+    struct treeset_node *node = ts_impl_select(_set_->root, index);
+    if (value)
+        *value = node->value;
+    _set_->flag = cmc_flags.OK;
+    if (_set_->callbacks && _set_->callbacks->read)
+        _set_->callbacks->read();
+    return 1;
+}
+_Bool ts_floor(struct treeset *_set_, size_t value, size_t *out_value)
+{
+    if (ts_empty(_set_))
+    {
+        _set_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    struct treeset_node *node = ts_impl_floor(_set_, value, 1);
+    if (!node)
+    {
+        _set_->flag = cmc_flags.NOT_FOUND;
+        return 0;
+    }
+    if (out_value)
+        *out_value = node->value;
+    _set_->flag = cmc_flags.OK;
+    if (_set_->callbacks && _set_->callbacks->read)
+        _set_->callbacks->read();
+    return 1;
+}
+_Bool ts_ceiling(struct treeset *_set_, size_t value, size_t *out_value)
+{
+    if (ts_empty(_set_))
+    {
+        _set_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    struct treeset_node *node = ts_impl_ceiling(_set_, value, 1);
+    if (!node)
+    {
+        _set_->flag = cmc_flags.NOT_FOUND;
+        return 0;
+    }
+    if (out_value)
+        *out_value = node->value;
+    _set_->flag = cmc_flags.OK;
+    if (_set_->callbacks && _set_->callbacks->read)
+        _set_->callbacks->read();
+    return 1;
+}
 _Bool ts_contains(struct treeset *_set_, size_t value)
 {
     _Bool result = ts_impl_get_node(_set_, value) != ((void *)0);
@@ -408,6 +526,25 @@ _Bool ts_contains(struct treeset *_set_, size_t value)
         _set_->callbacks->read();
     return result;
 }
+size_t ts_rank(struct treeset *_set_, size_t value)
+{
+    size_t rank = 0;
+    struct treeset_node *scan = _set_->root;
+    while (scan != ((void *)0))
+    {
+        if (_set_->f_val->cmp(scan->value, value) < 0)
+        {
+            rank += ts_impl_size(scan->left) + 1;
+            scan = scan->right;
+        }
+        else
+            scan = scan->left;
+    }
+    _set_->flag = cmc_flags.OK;
+    if (_set_->callbacks && _set_->callbacks->read)
+        _set_->callbacks->read();
+    return rank;
+}
 _Bool ts_empty(struct treeset *_set_)
 {
     return _set_->count == 0;
@@ -500,76 +637,20 @@ _Bool ts_print(struct treeset *_set_, FILE *fptr)
 }
 struct treeset *ts_union(struct treeset *_set1_, struct treeset *_set2_)
 {
-    struct treeset *_set_r_ =
-        ts_new_custom(_set1_->f_val, _set1_->alloc, _set1_->callbacks);
-    if (!_set_r_)
-        return ((void *)0);
-    struct treeset_iter iter1 = ts_iter_start(_set1_);
-    struct treeset_iter iter2 = ts_iter_start(_set2_);
-    for (; !ts_iter_at_end(&iter1); ts_iter_next(&iter1))
-    {
-        ts_insert(_set_r_, ts_iter_value(&iter1));
-    }
-    for (; !ts_iter_at_end(&iter2); ts_iter_next(&iter2))
-    {
-        ts_insert(_set_r_, ts_iter_value(&iter2));
-    }
-    return _set_r_;
+    return ts_impl_set_operation(_set1_, _set2_, 1, 1, 1);
 }
 struct treeset *ts_intersection(struct treeset *_set1_, struct treeset *_set2_)
 {
-    struct treeset *_set_r_ =
-        ts_new_custom(_set1_->f_val, _set1_->alloc, _set1_->callbacks);
-    if (!_set_r_)
-        return ((void *)0);
-    struct treeset *_set_A_ = _set1_->count < _set2_->count ? _set1_ : _set2_;
-    struct treeset *_set_B_ = _set_A_ == _set1_ ? _set2_ : _set1_;
-    struct treeset_iter iter = ts_iter_start(_set_A_);
-    for (; !ts_iter_at_end(&iter); ts_iter_next(&iter))
-    {
-        size_t value = ts_iter_value(&iter);
-        if (ts_impl_get_node(_set_B_, value) != ((void *)0))
-            ts_insert(_set_r_, value);
-    }
-    return _set_r_;
+    return ts_impl_set_operation(_set1_, _set2_, 0, 1, 0);
 }
 struct treeset *ts_difference(struct treeset *_set1_, struct treeset *_set2_)
 {
-    struct treeset *_set_r_ =
-        ts_new_custom(_set1_->f_val, _set1_->alloc, _set1_->callbacks);
-    if (!_set_r_)
-        return ((void *)0);
-    struct treeset_iter iter = ts_iter_start(_set1_);
-    for (; !ts_iter_at_end(&iter); ts_iter_next(&iter))
-    {
-        size_t value = ts_iter_value(&iter);
-        if (ts_impl_get_node(_set2_, value) == ((void *)0))
-            ts_insert(_set_r_, value);
-    }
-    return _set_r_;
+    return ts_impl_set_operation(_set1_, _set2_, 1, 0, 0);
 }
 struct treeset *ts_symmetric_difference(struct treeset *_set1_,
                                         struct treeset *_set2_)
 {
-    struct treeset *_set_r_ =
-        ts_new_custom(_set1_->f_val, _set1_->alloc, _set1_->callbacks);
-    if (!_set_r_)
-        return ((void *)0);
-    struct treeset_iter iter1 = ts_iter_start(_set1_);
-    struct treeset_iter iter2 = ts_iter_start(_set2_);
-    for (; !ts_iter_at_end(&iter1); ts_iter_next(&iter1))
-    {
-        size_t value = ts_iter_value(&iter1);
-        if (ts_impl_get_node(_set2_, value) == ((void *)0))
-            ts_insert(_set_r_, value);
-    }
-    for (; !ts_iter_at_end(&iter2); ts_iter_next(&iter2))
-    {
-        size_t value = ts_iter_value(&iter2);
-        if (ts_impl_get_node(_set1_, value) == ((void *)0))
-            ts_insert(_set_r_, value);
-    }
-    return _set_r_;
+    return ts_impl_set_operation(_set1_, _set2_, 1, 0, 1);
 }
 _Bool ts_is_subset(struct treeset *_set1_, struct treeset *_set2_)
 {
@@ -670,6 +751,30 @@ struct treeset_iter ts_iter_end(struct treeset *target)
     }
     return iter;
 }
+struct treeset_iter ts_iter_from(struct treeset *target, size_t value)
+{
+    struct treeset_iter iter = ts_iter_start(target);
+    iter.first = ts_impl_ceiling(target, value, 1);
+    if (!iter.first)
+        iter.last = ((void *)0);
+    iter.cursor = iter.first;
+    iter.end = iter.first == ((void *)0);
+    return iter;
+}
+struct treeset_iter ts_iter_range(struct treeset *target, size_t from,
+                                  size_t to)
+{
+    return ts_impl_iter_range(target, ts_impl_ceiling(target, from, 1),
+                              ts_impl_floor(target, to, 0));
+}
+struct treeset_iter ts_lower_bound(struct treeset *target, size_t value)
+{
+    return ts_impl_iter_at(target, ts_impl_ceiling(target, value, 1));
+}
+struct treeset_iter ts_upper_bound(struct treeset *target, size_t value)
+{
+    return ts_impl_iter_at(target, ts_impl_ceiling(target, value, 0));
+}
 _Bool ts_iter_at_start(struct treeset_iter *iter)
 {
     return ts_empty(iter->target) || iter->start;
@@ -680,7 +785,7 @@ _Bool ts_iter_at_end(struct treeset_iter *iter)
 }
 _Bool ts_iter_to_start(struct treeset_iter *iter)
 {
-    if (!ts_empty(iter->target))
+    if (iter->first != ((void *)0))
     {
         iter->index = 0;
         iter->start = 1;
@@ -692,9 +797,10 @@ _Bool ts_iter_to_start(struct treeset_iter *iter)
 }
 _Bool ts_iter_to_end(struct treeset_iter *iter)
 {
-    if (!ts_empty(iter->target))
+    if (iter->first != ((void *)0))
     {
-        iter->index = iter->target->count - 1;
+        iter->index =
+            ts_impl_index_of(iter->last) - ts_impl_index_of(iter->first);
         iter->start = ts_empty(iter->target);
         iter->end = 1;
         iter->cursor = iter->last;
@@ -769,10 +875,12 @@ _Bool ts_iter_advance(struct treeset_iter *iter, size_t steps)
         iter->end = 1;
         return 0;
     }
-    if (steps == 0 || iter->index + steps >= iter->target->count)
+    size_t index = ts_impl_index_of(iter->cursor);
+    if (steps == 0 || index + steps > ts_impl_index_of(iter->last))
         return 0;
-    for (size_t i = 0; i < steps; i++)
-        ts_iter_next(iter);
+    iter->cursor = ts_impl_select(iter->target->root, index + steps);
+    iter->index += steps;
+    iter->start = ts_empty(iter->target);
     return 1;
 }
 _Bool ts_iter_rewind(struct treeset_iter *iter, size_t steps)
@@ -786,8 +894,10 @@ _Bool ts_iter_rewind(struct treeset_iter *iter, size_t steps)
     }
     if (steps == 0 || iter->index < steps)
         return 0;
-    for (size_t i = 0; i < steps; i++)
-        ts_iter_prev(iter);
+    size_t index = ts_impl_index_of(iter->cursor) - steps;
+    iter->cursor = ts_impl_select(iter->target->root, index);
+    iter->index -= steps;
+    iter->end = ts_empty(iter->target);
     return 1;
 }
 _Bool ts_iter_go_to(struct treeset_iter *iter, size_t index)
@@ -802,7 +912,7 @@ _Bool ts_iter_go_to(struct treeset_iter *iter, size_t index)
 }
 size_t ts_iter_value(struct treeset_iter *iter)
 {
-    if (ts_empty(iter->target))
+    if (iter->cursor == ((void *)0))
         return (size_t){ 0 };
     return iter->cursor->value;
 }
@@ -822,6 +932,7 @@ static struct treeset_node *ts_impl_new_node(struct treeset *_set_,
     node->left = ((void *)0);
     node->parent = ((void *)0);
     node->height = 0;
+    node->size = 1;
     return node;
 }
 static struct treeset_node *ts_impl_get_node(struct treeset *_set_,
@@ -839,6 +950,131 @@ static struct treeset_node *ts_impl_get_node(struct treeset *_set_,
     }
     return ((void *)0);
 }
+static struct treeset_node *ts_impl_floor(struct treeset *_set_, size_t value,
+                                          _Bool inclusive)
+{
+    struct treeset_node *scan = _set_->root, *result = ((void *)0);
+    while (scan != ((void *)0))
+    {
+        int c = _set_->f_val->cmp(scan->value, value);
+        if (c < 0 || (c == 0 && inclusive))
+        {
+            result = scan;
+            scan = scan->right;
+        }
+        else
+            scan = scan->left;
+    }
+    return result;
+}
+static struct treeset_node *ts_impl_ceiling(struct treeset *_set_, size_t value,
+                                            _Bool inclusive)
+{
+    struct treeset_node *scan = _set_->root, *result = ((void *)0);
+    while (scan != ((void *)0))
+    {
+        int c = _set_->f_val->cmp(scan->value, value);
+        if (c > 0 || (c == 0 && inclusive))
+        {
+            result = scan;
+            scan = scan->left;
+        }
+        else
+            scan = scan->right;
+    }
+    return result;
+}
+static void ts_impl_remove_node(struct treeset *_set_,
+                                struct treeset_node *node)
+{
+    struct treeset_node *temp = ((void *)0), *unbalanced = ((void *)0);
+    _Bool is_root = node->parent == ((void *)0);
+    if (node->left == ((void *)0) && node->right == ((void *)0))
+    {
+        if (is_root)
+            _set_->root = ((void *)0);
+        else
+        {
+            unbalanced = node->parent;
+            if (node->parent->right == node)
+                node->parent->right = ((void *)0);
+            else
+                node->parent->left = ((void *)0);
+        }
+        _set_->alloc->free(node);
+    }
+    else if (node->left == ((void *)0))
+    {
+        if (is_root)
+        {
+            _set_->root = node->right;
+            _set_->root->parent = ((void *)0);
+        }
+        else
+        {
+            unbalanced = node->parent;
+            node->right->parent = node->parent;
+            if (node->parent->right == node)
+                node->parent->right = node->right;
+            else
+                node->parent->left = node->right;
+        }
+        _set_->alloc->free(node);
+    }
+    else if (node->right == ((void *)0))
+    {
+        if (is_root)
+        {
+            _set_->root = node->left;
+            _set_->root->parent = ((void *)0);
+        }
+        else
+        {
+            unbalanced = node->parent;
+            node->left->parent = node->parent;
+            if (node->parent->right == node)
+                node->parent->right = node->left;
+            else
+                node->parent->left = node->left;
+        }
+        _set_->alloc->free(node);
+    }
+    else
+    {
+        temp = node->right;
+        while (temp->left != ((void *)0))
+            temp = temp->left;
+        size_t temp_value = temp->value;
+        unbalanced = temp->parent;
+        if (temp->left == ((void *)0) && temp->right == ((void *)0))
+        {
+            if (temp->parent->right == temp)
+                temp->parent->right = ((void *)0);
+            else
+                temp->parent->left = ((void *)0);
+        }
+        else if (temp->left == ((void *)0))
+        {
+            temp->right->parent = temp->parent;
+            if (temp->parent->right == temp)
+                temp->parent->right = temp->right;
+            else
+                temp->parent->left = temp->right;
+        }
+        else if (temp->right == ((void *)0))
+        {
+            temp->left->parent = temp->parent;
+            if (temp->parent->right == temp)
+                temp->parent->right = temp->left;
+            else
+                temp->parent->left = temp->left;
+        }
+        _set_->alloc->free(temp);
+        node->value = temp_value;
+    }
+    if (unbalanced != ((void *)0))
+        ts_impl_rebalance(_set_, unbalanced);
+}
 static unsigned char ts_impl_h(struct treeset_node *node)
 {
     if (node == ((void *)0))
@@ -853,6 +1089,238 @@ static unsigned char ts_impl_hupdate(struct treeset_node *node)
     unsigned char h_r = ts_impl_h(node->right);
     return 1 + (h_l > h_r ? h_l : h_r);
 }
+static size_t ts_impl_size(struct treeset_node *node)
+{
+    if (node == ((void *)0))
+        return 0;
+    return node->size;
+}
+static size_t ts_impl_supdate(struct treeset_node *node)
+{
+    if (node == ((void *)0))
+        return 0;
+    return 1 + ts_impl_size(node->left) + ts_impl_size(node->right);
+}
+static size_t ts_impl_index_of(struct treeset_node *node)
+{
+    size_t index = ts_impl_size(node->left);
+    for (; node->parent != ((void *)0); node = node->parent)
+    {
+        if (node->parent->right == node)
+            index += ts_impl_size(node->parent->left) + 1;
+    }
+    return index;
+}
+static struct treeset_node *ts_impl_select(struct treeset_node *node,
+                                           size_t index)
+{
+    while (node != ((void *)0))
+    {
+        size_t left = ts_impl_size(node->left);
+        if (index < left)
+            node = node->left;
+        else if (index > left)
+        {
+            index -= left + 1;
+            node = node->right;
+        }
+        else
+            break;
+    }
+    return node;
+}
+static struct treeset_node *ts_impl_to_list(struct treeset_node *root)
+{
+    struct treeset_node *head = ((void *)0), *tail = ((void *)0), *scan = root;
+    while (scan != ((void *)0))
+    {
+        if (scan->left != ((void *)0))
+        {
+            struct treeset_node *left = scan->left;
+            scan->left = left->right;
+            left->right = scan;
+            scan = left;
+        }
+        else
+        {
+            if (tail != ((void *)0))
+                tail->right = scan;
+            else
+                head = scan;
+            tail = scan;
+            scan = scan->right;
+        }
+    }
+    return head;
+}
+static struct treeset_node *ts_impl_build(struct treeset_node **list,
+                                          size_t count)
+{
+    if (count == 0)
+        return ((void *)0);
+    struct treeset_node *left = ts_impl_build(list, count / 2);
+    struct treeset_node *root = *list;
+    *list = root->right;
+    root->left = left;
+    root->right = ts_impl_build(list, count - count / 2 - 1);
+    if (root->left)
+        root->left->parent = root;
+    if (root->right)
+        root->right->parent = root;
+    root->height = ts_impl_hupdate(root);
+    root->size = count;
+    return root;
+}
+static struct treeset_node *ts_impl_sort_list(struct treeset *_set_,
+                                              struct treeset_node *head,
+                                              size_t count)
+{
+    if (count < 2)
+        return head;
+    struct treeset_node *middle = head;
+    for (size_t i = 1; i < count / 2; i++)
+        middle = middle->right;
+    struct treeset_node *right = middle->right;
+    middle->right = ((void *)0);
+    struct treeset_node *left = ts_impl_sort_list(_set_, head, count / 2);
+    right = ts_impl_sort_list(_set_, right, count - count / 2);
+    struct treeset_node *result = ((void *)0), **tail = &result;
+    while (left != ((void *)0) && right != ((void *)0))
+    {
+        if (_set_->f_val->cmp(right->value, left->value) < 0)
+        {
+            *tail = right;
+            right = right->right;
+        }
+        else
+        {
+            *tail = left;
+            left = left->right;
+        }
+        tail = &(*tail)->right;
+    }
+    *tail = left != ((void *)0) ? left : right;
+    return result;
+}
+static struct treeset_iter ts_impl_iter_at(struct treeset *target,
+                                           struct treeset_node *node)
+{
+    if (!node)
+        return ts_iter_end(target);
+    struct treeset_iter iter = ts_iter_start(target);
+    iter.cursor = node;
+    iter.index = ts_impl_index_of(node);
+    iter.start = iter.index == 0;
+    return iter;
+}
+static struct treeset_iter ts_impl_iter_range(struct treeset *target,
+                                              struct treeset_node *first,
+                                              struct treeset_node *last)
+{
+    struct treeset_iter iter = ts_iter_start(target);
+    iter.first = first;
+    iter.last = last;
+    if (!first || !last || target->f_val->cmp(first->value, last->value) > 0)
+    {
+        iter.first = ((void *)0);
+        iter.last = ((void *)0);
+    }
+    iter.cursor = iter.first;
+    iter.end = iter.first == ((void *)0);
+    return iter;
+}
+static void ts_impl_free_list(struct treeset *_set_, struct treeset_node *head)
+{
+    while (head != ((void *)0))
+    {
+        struct treeset_node *next = head->right;
+        _set_->alloc->free(head);
+        head = next;
+    }
+}
+static _Bool ts_impl_merge(struct treeset_impl_merge *merge)
+{
+    struct treeset_iter *iter1 = &(merge->iter1);
+    struct treeset_iter *iter2 = &(merge->iter2);
+    merge->head = ((void *)0);
+    merge->tail = ((void *)0);
+    merge->count = 0;
+    while (1)
+    {
+        _Bool end1 = ts_iter_at_end(iter1);
+        _Bool end2 = ts_iter_at_end(iter2);
+        if ((end1 && end2) || (end1 && !merge->only2) ||
+            (end2 && !merge->only1))
+            break;
+        int cmp;
+        if (end1)
+            cmp = 1;
+        else if (end2)
+            cmp = -1;
+        else
+            cmp = merge->result->f_val->cmp(ts_iter_value(iter1),
+                                            ts_iter_value(iter2));
+        size_t value;
+        _Bool keep;
+        if (cmp < 0)
+        {
+            value = ts_iter_value(iter1);
+            keep = merge->only1;
+            ts_iter_next(iter1);
+        }
+        else if (cmp > 0)
+        {
+            value = ts_iter_value(iter2);
+            keep = merge->only2;
+            ts_iter_next(iter2);
+        }
+        else
+        {
+            value = ts_iter_value(iter1);
+            keep = merge->both;
+            ts_iter_next(iter1);
+            ts_iter_next(iter2);
+        }
+        if (!keep)
+            continue;
+        struct treeset_node *node = ts_impl_new_node(merge->result, value);
+        if (!node)
+            return 0;
+        if (merge->tail != ((void *)0))
+            merge->tail->right = node;
+        else
+            merge->head = node;
+        merge->tail = node;
+        merge->count++;
+    }
+    return 1;
+}
+static struct treeset *ts_impl_set_operation(struct treeset *_set1_,
+                                             struct treeset *_set2_,
+                                             _Bool only1, _Bool both,
+                                             _Bool only2)
+{
+    struct treeset *_set_r_ =
+        ts_new_custom(_set1_->f_val, _set1_->alloc, _set1_->callbacks);
+    if (!_set_r_)
+        return ((void *)0);
+    struct treeset_impl_merge merge;
+    merge.result = _set_r_;
+    merge.iter1 = ts_iter_start(_set1_);
+    merge.iter2 = ts_iter_start(_set2_);
+    merge.only1 = only1;
+    merge.both = both;
+    merge.only2 = only2;
+    if (!ts_impl_merge(&merge))
+    {
+        ts_impl_free_list(_set_r_, merge.head);
+        ts_free(_set_r_);
+        return ((void *)0);
+    }
+    _set_r_->root = ts_impl_build(&(merge.head), merge.count);
+    _set_r_->count = merge.count;
+    return _set_r_;
+}
 static void ts_impl_rotate_right(struct treeset_node **Z)
 {
     struct treeset_node *root = *Z;
@@ -872,6 +1340,8 @@ static void ts_impl_rotate_right(struct treeset_node **Z)
     new_root->right = root;
     root->height = ts_impl_hupdate(root);
     new_root->height = ts_impl_hupdate(new_root);
+    root->size = ts_impl_supdate(root);
+    new_root->size = ts_impl_supdate(new_root);
     *Z = new_root;
 }
 static void ts_impl_rotate_left(struct treeset_node **Z)
@@ -893,6 +1363,8 @@ static void ts_impl_rotate_left(struct treeset_node **Z)
     new_root->left = root;
     root->height = ts_impl_hupdate(root);
     new_root->height = ts_impl_hupdate(new_root);
+    root->size = ts_impl_supdate(root);
+    new_root->size = ts_impl_supdate(new_root);
     *Z = new_root;
 }
 static void ts_impl_rebalance(struct treeset *_set_, struct treeset_node *node)
@@ -905,6 +1377,7 @@ static void ts_impl_rebalance(struct treeset *_set_, struct treeset_node *node)
         if (scan->parent == ((void *)0))
             is_root = 1;
         scan->height = ts_impl_hupdate(scan);
+        scan->size = ts_impl_supdate(scan);
         balance = ts_impl_h(scan->right) - ts_impl_h(scan->left);
         if (balance >= 2)
         {
@@ -0,0 +1,883 @@
+#ifndef CMC_TEST_SRC_UNROLLEDLIST
+#define CMC_TEST_SRC_UNROLLEDLIST
+
+#include "cmc/unrolledlist.h"
+
+struct unrolledlist
+{
+    struct unrolledlist_node *head;
+    struct unrolledlist_node *tail;
+    size_t count;
+    size_t nodes;
+    int flag;
+    struct unrolledlist_fval *f_val;
+    struct cmc_alloc_node *alloc;
+    struct cmc_callbacks *callbacks;
+};
+struct unrolledlist_node
+{
+    struct unrolledlist_node *next;
+    struct unrolledlist_node *prev;
+    size_t count;
+    size_t values[((128 - 3 * sizeof(void *)) / sizeof(size_t) > 4
+                       ? (128 - 3 * sizeof(void *)) / sizeof(size_t)
+                       : 4)];
+};
+struct unrolledlist_fval
+{
+    int (*cmp)(size_t, size_t);
+    size_t (*cpy)(size_t);
+    _Bool (*str)(FILE *, size_t);
+    void (*free)(size_t);
+    size_t (*hash)(size_t);
+    int (*pri)(size_t, size_t);
+};
+struct unrolledlist_iter
+{
+    struct unrolledlist *target;
+    struct unrolledlist_node *cursor;
+    size_t position;
+    size_t index;
+    _Bool start;
+    _Bool end;
+};
+struct unrolledlist *ul_new(struct unrolledlist_fval *f_val);
+struct unrolledlist *ul_new_custom(struct unrolledlist_fval *f_val,
+                                   struct cmc_alloc_node *alloc,
+                                   struct cmc_callbacks *callbacks);
+void ul_clear(struct unrolledlist *_list_);
+void ul_free(struct unrolledlist *_list_);
+void ul_customize(struct unrolledlist *_list_, struct cmc_alloc_node *alloc,
+                  struct cmc_callbacks *callbacks);
+_Bool ul_push_front(struct unrolledlist *_list_, size_t value);
+_Bool ul_push_at(struct unrolledlist *_list_, size_t value, size_t index);
+_Bool ul_push_back(struct unrolledlist *_list_, size_t value);
+_Bool ul_pop_front(struct unrolledlist *_list_);
+_Bool ul_pop_at(struct unrolledlist *_list_, size_t index);
+_Bool ul_pop_back(struct unrolledlist *_list_);
+size_t ul_front(struct unrolledlist *_list_);
+size_t ul_get(struct unrolledlist *_list_, size_t index);
+size_t *ul_get_ref(struct unrolledlist *_list_, size_t index);
+size_t ul_back(struct unrolledlist *_list_);
+_Bool ul_contains(struct unrolledlist *_list_, size_t value);
+_Bool ul_empty(struct unrolledlist *_list_);
+size_t ul_count(struct unrolledlist *_list_);
+int ul_flag(struct unrolledlist *_list_);
+struct unrolledlist *ul_copy_of(struct unrolledlist *_list_);
+_Bool ul_equals(struct unrolledlist *_list1_, struct unrolledlist *_list2_);
+struct cmc_string ul_to_string(struct unrolledlist *_list_);
+_Bool ul_print(struct unrolledlist *_list_, FILE *fptr);
+struct unrolledlist_iter ul_iter_start(struct unrolledlist *target);
+struct unrolledlist_iter ul_iter_end(struct unrolledlist *target);
+_Bool ul_iter_at_start(struct unrolledlist_iter *iter);
+_Bool ul_iter_at_end(struct unrolledlist_iter *iter);
+_Bool ul_iter_to_start(struct unrolledlist_iter *iter);
+_Bool ul_iter_to_end(struct unrolledlist_iter *iter);
+_Bool ul_iter_next(struct unrolledlist_iter *iter);
+_Bool ul_iter_prev(struct unrolledlist_iter *iter);
+_Bool ul_iter_advance(struct unrolledlist_iter *iter, size_t steps);
+_Bool ul_iter_rewind(struct unrolledlist_iter *iter, size_t steps);
+_Bool ul_iter_go_to(struct unrolledlist_iter *iter, size_t index);
+size_t ul_iter_value(struct unrolledlist_iter *iter);
+size_t *ul_iter_rvalue(struct unrolledlist_iter *iter);
+size_t ul_iter_index(struct unrolledlist_iter *iter);
+_Bool ul_iter_add_next(struct unrolledlist_iter *iter, size_t value);
+_Bool ul_iter_add_prev(struct unrolledlist_iter *iter, size_t value);
+_Bool ul_iter_del_curr(struct unrolledlist_iter *iter);
+static struct unrolledlist_node *ul_impl_new_node(struct unrolledlist *_list_);
+static void ul_impl_link_after(struct unrolledlist *_list_,
+                               struct unrolledlist_node *node,
+                               struct unrolledlist_node *new_node);
+static void ul_impl_unlink(struct unrolledlist *_list_,
+                           struct unrolledlist_node *node);
+static struct unrolledlist_node *ul_impl_locate(struct unrolledlist *_list_,
+                                                size_t index, size_t *position);
+static _Bool ul_impl_insert(struct unrolledlist *_list_,
+                            struct unrolledlist_node **node, size_t *position,
+                            size_t value);
+static void ul_impl_remove(struct unrolledlist *_list_,
+                           struct unrolledlist_node **node, size_t *position);
+struct unrolledlist *ul_new(struct unrolledlist_fval *f_val)
+{
+    if (!f_val)
+        return ((void *)0);
+    struct cmc_alloc_node *alloc = &cmc_alloc_node_default;
+    struct unrolledlist *_list_ = alloc->malloc(sizeof(struct unrolledlist));
+    if (!_list_)
+        return ((void *)0);
+    _list_->count = 0;
+    _list_->nodes = 0;
+    _list_->head = ((void *)0);
+    _list_->tail = ((void *)0);
+    _list_->flag = cmc_flags.OK;
+    _list_->f_val = f_val;
+    _list_->alloc = alloc;
+    _list_->callbacks = ((void *)0);
+    return _list_;
+}
+struct unrolledlist *ul_new_custom(struct unrolledlist_fval *f_val,
+                                   struct cmc_alloc_node *alloc,
+                                   struct cmc_callbacks *callbacks)
+{
+    if (!f_val)
+        return ((void *)0);
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+    struct unrolledlist *_list_ = alloc->malloc(sizeof(struct unrolledlist));
+    if (!_list_)
+        return ((void *)0);
+    _list_->count = 0;
+    _list_->nodes = 0;
+    _list_->head = ((void *)0);
+    _list_->tail = ((void *)0);
+    _list_->flag = cmc_flags.OK;
+    _list_->f_val = f_val;
+    _list_->alloc = alloc;
+    _list_->callbacks = callbacks;
+    return _list_;
+}
+void ul_clear(struct unrolledlist *_list_)
+{
+    struct unrolledlist_node *scan = _list_->head;
+    while (scan != ((void *)0))
+    {
+        struct unrolledlist_node *next = scan->next;
+        if (_list_->f_val->free)
+        {
+            for (size_t i = 0; i < scan->count; i++)
+                _list_->f_val->free(scan->values[i]);
+        }
+        _list_->alloc->free(scan);
+        scan = next;
+    }
+    _list_->count = 0;
+    _list_->nodes = 0;
+    _list_->head = ((void *)0);
+    _list_->tail = ((void *)0);
+    _list_->flag = cmc_flags.OK;
+}
+void ul_free(struct unrolledlist *_list_)
+{
+    ul_clear(_list_);
+    _list_->alloc->free(_list_);
+}
+void ul_customize(struct unrolledlist *_list_, struct cmc_alloc_node *alloc,
+                  struct cmc_callbacks *callbacks)
+{
+    if (!alloc)
+        _list_->alloc = &cmc_alloc_node_default;
+    else
+        _list_->alloc = alloc;
+    _list_->callbacks = callbacks;
+    _list_->flag = cmc_flags.OK;
+}
+_Bool ul_push_front(struct unrolledlist *_list_, size_t value)
+{
+    struct unrolledlist_node *node = _list_->head;
+    size_t position = 0;
+    if (!ul_impl_insert(_list_, &node, &position, value))
+        return 0;
+    _list_->flag = cmc_flags.OK;
+    if (_list_->callbacks && _list_->callbacks->create)
+        _list_->callbacks->create();
+    return 1;
+}
+_Bool ul_push_at(struct unrolledlist *_list_, size_t value, size_t index)
+{
+    if (index > _list_->count)
+    {
+        _list_->flag = cmc_flags.RANGE;
+        return 0;
+    }
+    if (index == 0)
+    {
+        return ul_push_front(_list_, value);
+    }
+    else if (index == _list_->count)
+    {
+        return ul_push_back(_list_, value);
+    }
+    size_t position;
+    struct unrolledlist_node *node = ul_impl_locate(_list_, index, &position);
+    if (position == 0 &&
+        node->prev->count < ((128 - 3 * sizeof(void *)) / sizeof(size_t) > 4
+                                 ? (128 - 3 * sizeof(void *)) / sizeof(size_t)
+                                 : 4))
+    {
+        node = node->prev;
+        position = node->count;
+    }
+    if (!ul_impl_insert(_list_, &node, &position, value))
+        return 0;
+    _list_->flag = cmc_flags.OK;
+    if (_list_->callbacks && _list_->callbacks->create)
+        _list_->callbacks->create();
+    return 1;
+}
+_Bool ul_push_back(struct unrolledlist *_list_, size_t value)
+{
+    struct unrolledlist_node *node = _list_->tail;
+    size_t position = node ? node->count : 0;
+    if (!ul_impl_insert(_list_, &node, &position, value))
+        return 0;
+    _list_->flag = cmc_flags.OK;
+    if (_list_->callbacks && _list_->callbacks->create)
+        _list_->callbacks->create();
+    return 1;
+}
+_Bool ul_pop_front(struct unrolledlist *_list_)
+{
+    if (ul_empty(_list_))
+    {
+        _list_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    struct unrolledlist_node *node = _list_->head;
+    size_t position = 0;
+    ul_impl_remove(_list_, &node, &position);
+    _list_->flag = cmc_flags.OK;
+    if (_list_->callbacks && _list_->callbacks->delete)
+        _list_->callbacks->delete ();
+    return 1;
+}
+_Bool ul_pop_at(struct unrolledlist *_list_, size_t index)
+{
+    if (ul_empty(_list_))
+    {
+        _list_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    if (index >= _list_->count)
+    {
+        _list_->flag = cmc_flags.RANGE;
+        return 0;
+    }
+    size_t position;
+    struct unrolledlist_node *node = ul_impl_locate(_list_, index, &position);
+    ul_impl_remove(_list_, &node, &position);
+    _list_->flag = cmc_flags.OK;
+    if (_list_->callbacks && _list_->callbacks->delete)
+        _list_->callbacks->delete ();
+    return 1;
+}
+_Bool ul_pop_back(struct unrolledlist *_list_)
+{
+    if (ul_empty(_list_))
+    {
+        _list_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    struct unrolledlist_node *node = _list_->tail;
+    size_t position = node->count - 1;
+    ul_impl_remove(_list_, &node, &position);
+    _list_->flag = cmc_flags.OK;
+    if (_list_->callbacks && _list_->callbacks->delete)
+        _list_->callbacks->delete ();
+    return 1;
+}
+size_t ul_front(struct unrolledlist *_list_)
+{
+    if (ul_empty(_list_))
+    {
+        _list_->flag = cmc_flags.EMPTY;
+        return (size_t){ 0 };
+    }
+    _list_->flag = cmc_flags.OK;
+    if (_list_->callbacks && _list_->callbacks->read)
+        _list_->callbacks->read();
+    return _list_->head->values[0];
+}
+size_t ul_get(struct unrolledlist *_list_, size_t index)
+{
+    if (ul_empty(_list_))
+    {
+        _list_->flag = cmc_flags.EMPTY;
+        return (size_t){ 0 };
+    }
+    if (index >= _list_->count)
+    {
+        _list_->flag = cmc_flags.RANGE;
+        return (size_t){ 0 };
+    }
+    size_t position;
+    struct unrolledlist_node *node = ul_impl_locate(_list_, index, &position);
+    _list_->flag = cmc_flags.OK;
+    if (_list_->callbacks && _list_->callbacks->read)
+        _list_->callbacks->read();
+    return node->values[position];
+}
+size_t *ul_get_ref(struct unrolledlist *_list_, size_t index)
+{
+    if (ul_empty(_list_))
+    {
+        _list_->flag = cmc_flags.EMPTY;
+        return ((void *)0);
+    }
+    if (index >= _list_->count)
+    {
+        _list_->flag = cmc_flags.RANGE;
+        return ((void *)0);
+    }
+    size_t position;
+    struct unrolledlist_node *node = ul_impl_locate(_list_, index, &position);
+    _list_->flag = cmc_flags.OK;
+    if (_list_->callbacks && _list_->callbacks->read)
+        _list_->callbacks->read();
+    return &(node->values[position]);
+}
+size_t ul_back(struct unrolledlist *_list_)
+{
+    if (ul_empty(_list_))
+    {
+        _list_->flag = cmc_flags.EMPTY;
+        return (size_t){ 0 };
+    }
+    _list_->flag = cmc_flags.OK;
+    if (_list_->callbacks && _list_->callbacks->read)
+        _list_->callbacks->read();
+    return _list_->tail->values[_list_->tail->count - 1];
+}
+_Bool ul_contains(struct unrolledlist *_list_, size_t value)
+{
+    _list_->flag = cmc_flags.OK;
+    _Bool result = 0;
+    for (struct unrolledlist_node *scan = _list_->head; scan && !result;
+         scan = scan->next)
+    {
+        for (size_t i = 0; i < scan->count; i++)
+        {
+            if (_list_->f_val->cmp(scan->values[i], value) == 0)
+            {
+                result = 1;
+                break;
+            }
+        }
+    }
+    if (_list_->callbacks && _list_->callbacks->read)
+        _list_->callbacks->read();
+    return result;
+}
+_Bool ul_empty(struct unrolledlist *_list_)
+{
+    return _list_->count == 0;
+}
+size_t ul_count(struct unrolledlist *_list_)
+{
+    return _list_->count;
+}
+int ul_flag(struct unrolledlist *_list_)
+{
+    return _list_->flag;
+}
+struct unrolledlist *ul_copy_of(struct unrolledlist *_list_)
+{
+    struct unrolledlist *result =
+        ul_new_custom(_list_->f_val, _list_->alloc, _list_->callbacks);
+    if (!result)
+    {
+        _list_->flag = cmc_flags.ALLOC;
+        return ((void *)0);
+    }
+    for (struct unrolledlist_node *scan = _list_->head; scan != ((void *)0);
+         scan = scan->next)
+    {
+        struct unrolledlist_node *new_node = ul_impl_new_node(result);
+        if (!new_node)
+        {
+            ul_free(result);
+            _list_->flag = cmc_flags.ALLOC;
+            return ((void *)0);
+        }
+        if (_list_->f_val->cpy)
+        {
+            for (size_t i = 0; i < scan->count; i++)
+                new_node->values[i] = _list_->f_val->cpy(scan->values[i]);
+        }
+        else
+            memcpy(new_node->values, scan->values,
+                   sizeof(size_t) * scan->count);
+        new_node->count = scan->count;
+        ul_impl_link_after(result, result->tail, new_node);
+    }
+    result->count = _list_->count;
+    _list_->flag = cmc_flags.OK;
+    return result;
+}
+_Bool ul_equals(struct unrolledlist *_list1_, struct unrolledlist *_list2_)
+{
+    _list1_->flag = cmc_flags.OK;
+    _list2_->flag = cmc_flags.OK;
+    if (_list1_->count != _list2_->count)
+        return 0;
+    struct unrolledlist_iter iter1 = ul_iter_start(_list1_);
+    struct unrolledlist_iter iter2 = ul_iter_start(_list2_);
+    for (size_t i = 0; i < _list1_->count; i++)
+    {
+        if (_list1_->f_val->cmp(ul_iter_value(&iter1), ul_iter_value(&iter2)) !=
+            0)
+            return 0;
+        ul_iter_next(&iter1);
+        ul_iter_next(&iter2);
+    }
+    return 1;
+}
+struct cmc_string ul_to_string(struct unrolledlist *_list_)
+{
+    struct cmc_string str;
+    struct unrolledlist *l_ = _list_;
+    int n =
+        snprintf(str.s, cmc_string_len, cmc_string_fmt_unrolledlist,
+                 "unrolledlist", "size_t", l_, l_->count, l_->nodes, l_->head,
+                 l_->tail, l_->flag, l_->f_val, l_->alloc, l_->callbacks);
+    return n >= 0 ? str : (struct cmc_string){ 0 };
+}
+_Bool ul_print(struct unrolledlist *_list_, FILE *fptr)
+{
+    for (struct unrolledlist_node *scan = _list_->head; scan != ((void *)0);
+         scan = scan->next)
+    {
+        for (size_t i = 0; i < scan->count; i++)
+        {
+            if (!_list_->f_val->str(fptr, scan->values[i]))
+                return 0;
+        }
+    }
+    return 1;
+}
+struct unrolledlist_iter ul_iter_start(struct unrolledlist *target)
+{
+    struct unrolledlist_iter iter;
+    iter.target = target;
+    iter.cursor = target->head;
+    iter.position = 0;
+    iter.index = 0;
+    iter.start = 1;
+    iter.end = ul_empty(target);
+    return iter;
+}
+struct unrolledlist_iter ul_iter_end(struct unrolledlist *target)
+{
+    struct unrolledlist_iter iter;
+    iter.target = target;
+    iter.cursor = target->tail;
+    iter.position = 0;
+    iter.index = 0;
+    iter.start = ul_empty(target);
+    iter.end = 1;
+    if (!ul_empty(target))
+    {
+        iter.position = target->tail->count - 1;
+        iter.index = target->count - 1;
+    }
+    return iter;
+}
+_Bool ul_iter_at_start(struct unrolledlist_iter *iter)
+{
+    return ul_empty(iter->target) || iter->start;
+}
+_Bool ul_iter_at_end(struct unrolledlist_iter *iter)
+{
+    return ul_empty(iter->target) || iter->end;
+}
+_Bool ul_iter_to_start(struct unrolledlist_iter *iter)
+{
+    if (!ul_empty(iter->target))
+    {
+        iter->cursor = iter->target->head;
+        iter->position = 0;
+        iter->index = 0;
+        iter->start = 1;
+        iter->end = ul_empty(iter->target);
+        return 1;
+    }
+    return 0;
+}
+_Bool ul_iter_to_end(struct unrolledlist_iter *iter)
+{
+    if (!ul_empty(iter->target))
+    {
+        iter->cursor = iter->target->tail;
+        iter->position = iter->target->tail->count - 1;
+        iter->index = iter->target->count - 1;
+        iter->start = ul_empty(iter->target);
+        iter->end = 1;
+        return 1;
+    }
+    return 0;
+}
+_Bool ul_iter_next(struct unrolledlist_iter *iter)
+{
+    if (iter->end)
+        return 0;
+    if (iter->index + 1 >= iter->target->count)
+    {
+        iter->end = 1;
+        return 0;
+    }
+    iter->start = ul_empty(iter->target);
+    if (++iter->position == iter->cursor->count)
+    {
+        iter->cursor = iter->cursor->next;
+        iter->position = 0;
+    }
+    iter->index++;
+    return 1;
+}
+_Bool ul_iter_prev(struct unrolledlist_iter *iter)
+{
+    if (iter->start)
+        return 0;
+    if (iter->index == 0)
+    {
+        iter->start = 1;
+        return 0;
+    }
+    iter->end = ul_empty(iter->target);
+    if (iter->position == 0)
+    {
+        iter->cursor = iter->cursor->prev;
+        iter->position = iter->cursor->count;
+    }
+    iter->position--;
+    iter->index--;
+    return 1;
+}
+_Bool ul_iter_advance(struct unrolledlist_iter *iter, size_t steps)
+{
+    if (iter->end)
+        return 0;
+    if (iter->index + 1 >= iter->target->count)
+    {
+        iter->end = 1;
+        return 0;
+    }
+    if (steps == 0 || iter->index + steps >= iter->target->count)
+        return 0;
+    iter->start = ul_empty(iter->target);
+    iter->index += steps;
+    iter->position += steps;
+    while (iter->position >= iter->cursor->count)
+    {
+        iter->position -= iter->cursor->count;
+        iter->cursor = iter->cursor->next;
+    }
+    return 1;
+}
+_Bool ul_iter_rewind(struct unrolledlist_iter *iter, size_t steps)
+{
+    if (iter->start)
+        return 0;
+    if (iter->index == 0)
+    {
+        iter->start = 1;
+        return 0;
+    }
+    if (steps == 0 || iter->index < steps)
+        return 0;
+    iter->end = ul_empty(iter->target);
+    iter->index -= steps;
+    while (steps > iter->position)
+    {
+        steps -= iter->position + 1;
+        iter->cursor = iter->cursor->prev;
+        iter->position = iter->cursor->count - 1;
+    }
+    iter->position -= steps;
+    return 1;
+}
+_Bool ul_iter_go_to(struct unrolledlist_iter *iter, size_t index)
+{
+    if (index >= iter->target->count)
+        return 0;
+    if (iter->index > index)
+        return ul_iter_rewind(iter, iter->index - index);
+    else if (iter->index < index)
+        return ul_iter_advance(iter, index - iter->index);
+    return 1;
+}
+size_t ul_iter_value(struct unrolledlist_iter *iter)
+{
+    if (ul_empty(iter->target))
+        return (size_t){ 0 };
+    return iter->cursor->values[iter->position];
+}
+size_t *ul_iter_rvalue(struct unrolledlist_iter *iter)
+{
+    if (ul_empty(iter->target))
+        return ((void *)0);
+    return &(iter->cursor->values[iter->position]);
+}
+size_t ul_iter_index(struct unrolledlist_iter *iter)
+{
+    return iter->index;
+}
+_Bool ul_iter_add_next(struct unrolledlist_iter *iter, size_t value)
+{
+    struct unrolledlist *_list_ = iter->target;
+    if (ul_empty(_list_))
+    {
+        _list_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    struct unrolledlist_node *node = iter->cursor;
+    size_t position = iter->position + 1;
+    if (!ul_impl_insert(_list_, &node, &position, value))
+        return 0;
+    if (position > 0)
+    {
+        iter->cursor = node;
+        iter->position = position - 1;
+    }
+    else
+    {
+        iter->cursor = node->prev;
+        iter->position = node->prev->count - 1;
+    }
+    iter->end = 0;
+    _list_->flag = cmc_flags.OK;
+    if (_list_->callbacks && _list_->callbacks->create)
+        _list_->callbacks->create();
+    return 1;
+}
+_Bool ul_iter_add_prev(struct unrolledlist_iter *iter, size_t value)
+{
+    struct unrolledlist *_list_ = iter->target;
+    if (ul_empty(_list_))
+    {
+        _list_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    struct unrolledlist_node *node = iter->cursor;
+    size_t position = iter->position;
+    if (!ul_impl_insert(_list_, &node, &position, value))
+        return 0;
+    if (position + 1 < node->count)
+    {
+        iter->cursor = node;
+        iter->position = position + 1;
+    }
+    else
+    {
+        iter->cursor = node->next;
+        iter->position = 0;
+    }
+    iter->index++;
+    iter->start = 0;
+    _list_->flag = cmc_flags.OK;
+    if (_list_->callbacks && _list_->callbacks->create)
+        _list_->callbacks->create();
+    return 1;
+}
+_Bool ul_iter_del_curr(struct unrolledlist_iter *iter)
+{
+    struct unrolledlist *_list_ = iter->target;
+    if (ul_empty(_list_))
+    {
+        _list_->flag = cmc_flags.EMPTY;
+        return 0;
+    }
+    struct unrolledlist_node *node = iter->cursor;
+    size_t position = iter->position;
+    ul_impl_remove(_list_, &node, &position);
+    if (node != ((void *)0))
+    {
+        iter->cursor = node;
+        iter->position = position;
+    }
+    else if (!ul_empty(_list_))
+    {
+        iter->cursor = _list_->tail;
+        iter->position = _list_->tail->count - 1;
+        iter->index--;
+        iter->end = 1;
+    }
+    else
+    {
+        iter->cursor = ((void *)0);
+        iter->position = 0;
+        iter->index = 0;
+    }
+    _list_->flag = cmc_flags.OK;
+    if (_list_->callbacks && _list_->callbacks->delete)
+        _list_->callbacks->delete ();
+    return 1;
+}
+static struct unrolledlist_node *ul_impl_new_node(struct unrolledlist *_list_)
+{
+    struct unrolledlist_node *node =
+        _list_->alloc->malloc(sizeof(struct unrolledlist_node));
+    if (!node)
+    {
+        _list_->flag = cmc_flags.ALLOC;
+        return ((void *)0);
+    }
+    node->next = ((void *)0);
+    node->prev = ((void *)0);
+    node->count = 0;
+    return node;
+}
+static void ul_impl_link_after(struct unrolledlist *_list_,
+                               struct unrolledlist_node *node,
+                               struct unrolledlist_node *new_node)
+{
+    new_node->prev = node;
+    new_node->next = node ? node->next : _list_->head;
+    if (new_node->next != ((void *)0))
+        new_node->next->prev = new_node;
+    else
+        _list_->tail = new_node;
+    if (node != ((void *)0))
+        node->next = new_node;
+    else
+        _list_->head = new_node;
+    _list_->nodes++;
+}
+static void ul_impl_unlink(struct unrolledlist *_list_,
+                           struct unrolledlist_node *node)
+{
+    if (node->prev != ((void *)0))
+        node->prev->next = node->next;
+    else
+        _list_->head = node->next;
+    if (node->next != ((void *)0))
+        node->next->prev = node->prev;
+    else
+        _list_->tail = node->prev;
+    _list_->nodes--;
+    _list_->alloc->free(node);
+}
+static struct unrolledlist_node *ul_impl_locate(struct unrolledlist *_list_,
+                                                size_t index, size_t *position)
+{
+    struct unrolledlist_node *node;
+    if (index < _list_->count / 2)
+    {
+        node = _list_->head;
+        while (index >= node->count)
+        {
+            index -= node->count;
+            node = node->next;
+        }
+    }
+    else
+    {
+        node = _list_->tail;
+        size_t first = _list_->count - node->count;
+        while (index < first)
+        {
+            node = node->prev;
+            first -= node->count;
+        }
+        index -= first;
+    }
+    *position = index;
+    return node;
+}
+static _Bool ul_impl_insert(struct unrolledlist *_list_,
+                            struct unrolledlist_node **node, size_t *position,
+                            size_t value)
+{
+    const size_t capacity = ((128 - 3 * sizeof(void *)) / sizeof(size_t) > 4
+                                 ? (128 - 3 * sizeof(void *)) / sizeof(size_t)
+                                 : 4);
+    struct unrolledlist_node *target = *node;
+    size_t index = *position;
+    if (target == ((void *)0) || target->count == capacity)
+    {
+        struct unrolledlist_node *new_node = ul_impl_new_node(_list_);
+        if (!new_node)
+            return 0;
+        if (target == ((void *)0))
+        {
+            ul_impl_link_after(_list_, ((void *)0), new_node);
+            target = new_node;
+        }
+        else if (index == capacity)
+        {
+            ul_impl_link_after(_list_, target, new_node);
+            target = new_node;
+            index = 0;
+        }
+        else if (index == 0)
+        {
+            ul_impl_link_after(_list_, target->prev, new_node);
+            target = new_node;
+        }
+        else
+        {
+            size_t half = capacity / 2;
+            memcpy(new_node->values, target->values + half,
+                   (capacity - half) * sizeof(size_t));
+            new_node->count = capacity - half;
+            target->count = half;
+            ul_impl_link_after(_list_, target, new_node);
+            if (index > half)
+            {
+                target = new_node;
+                index -= half;
+            }
+        }
+    }
+    memmove(target->values + index + 1, target->values + index,
+            (target->count - index) * sizeof(size_t));
+    target->values[index] = value;
+    target->count++;
+    _list_->count++;
+    *node = target;
+    *position = index;
+    return 1;
+}
+static void ul_impl_remove(struct unrolledlist *_list_,
+                           struct unrolledlist_node **node, size_t *position)
+{
+    const size_t capacity = ((128 - 3 * sizeof(void *)) / sizeof(size_t) > 4
+                                 ? (128 - 3 * sizeof(void *)) / sizeof(size_t)
+                                 : 4);
+    struct unrolledlist_node *target = *node;
+    size_t index = *position;
+    memmove(target->values + index, target->values + index + 1,
+            (target->count - index - 1) * sizeof(size_t));
+    target->count--;
+    _list_->count--;
+    struct unrolledlist_node *following = target;
+    if (index == target->count)
+    {
+        following = target->next;
+        index = 0;
+    }
+    if (target->count < capacity / 2)
+    {
+        struct unrolledlist_node *next = target->next;
+        struct unrolledlist_node *prev = target->prev;
+        if (next != ((void *)0) && target->count + next->count <= capacity)
+        {
+            memcpy(target->values + target->count, next->values,
+                   next->count * sizeof(size_t));
+            if (following == next)
+            {
+                following = target;
+                index += target->count;
+            }
+            target->count += next->count;
+            ul_impl_unlink(_list_, next);
+        }
+        else if (prev != ((void *)0) && prev->count + target->count <= capacity)
+        {
+            memcpy(prev->values + prev->count, target->values,
+                   target->count * sizeof(size_t));
+            if (following == target)
+            {
+                following = prev;
+                index += prev->count;
+            }
+            prev->count += target->count;
+            ul_impl_unlink(_list_, target);
+        }
+        else if (target->count == 0)
+            ul_impl_unlink(_list_, target);
+    }
+    *node = following;
+    *position = index;
+}
+
+#endif /* CMC_TEST_SRC_UNROLLEDLIST */
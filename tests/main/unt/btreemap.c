@@ -0,0 +1,785 @@
+#include "utl.c"
+#include "utl/assert.h"
+#include "utl/test.h"
+
+#include "../src/btreemap.c"
+
+struct btreemap_fkey *btm_fkey = &(struct btreemap_fkey){ .cmp = cmc_size_cmp,
+                                                          .cpy = NULL,
+                                                          .str = cmc_size_str,
+                                                          .free = NULL,
+                                                          .hash = cmc_size_hash,
+                                                          .pri = cmc_size_cmp };
+
+struct btreemap_fval *btm_fval = &(struct btreemap_fval){ .cmp = cmc_size_cmp,
+                                                          .cpy = NULL,
+                                                          .str = cmc_size_str,
+                                                          .free = NULL,
+                                                          .hash = cmc_size_hash,
+                                                          .pri = cmc_size_cmp };
+
+CMC_GENERATE_BTREEMAP(btms, btreemap_str, char *, size_t)
+
+struct btreemap_str_fkey *btms_fkey =
+    &(struct btreemap_str_fkey){ .cmp = cmc_str_cmp,
+                                 .cpy = NULL,
+                                 .str = cmc_str_str,
+                                 .free = NULL,
+                                 .hash = cmc_str_hash_djb2,
+                                 .pri = cmc_str_cmp };
+
+struct btreemap_str_fval *btms_fval =
+    &(struct btreemap_str_fval){ .cmp = cmc_size_cmp,
+                                 .cpy = NULL,
+                                 .str = cmc_size_str,
+                                 .free = NULL,
+                                 .hash = cmc_size_hash,
+                                 .pri = cmc_size_cmp };
+
+CMC_CREATE_UNIT(BTreeMap, true, {
+    CMC_CREATE_TEST(new, {
+        struct btreemap *map = btm_new(btm_fkey, btm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        btm_free(map);
+    });
+
+    CMC_CREATE_TEST(clear[count], {
+        struct btreemap *map = btm_new(btm_fkey, btm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 0; i < 50; i++)
+            btm_insert(map, i, i);
+
+        cmc_assert_equals(size_t, 50, btm_count(map));
+
+        btm_clear(map);
+
+        cmc_assert_equals(size_t, 0, btm_count(map));
+        cmc_assert_equals(ptr, NULL, map->root);
+
+        btm_free(map);
+    });
+
+    CMC_CREATE_TEST(flags, {
+        struct btreemap *map = btm_new(btm_fkey, btm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+        cmc_assert_equals(int32_t, cmc_flags.OK, btm_flag(map));
+
+        // clear
+        map->flag = cmc_flags.ERROR;
+        btm_clear(map);
+        cmc_assert_equals(int32_t, cmc_flags.OK, btm_flag(map));
+
+        // insert
+        map->flag = cmc_flags.ERROR;
+        cmc_assert(btm_insert(map, 1, 1));
+        cmc_assert_equals(int32_t, cmc_flags.OK, btm_flag(map));
+
+        cmc_assert(!btm_insert(map, 1, 2));
+        cmc_assert_equals(int32_t, cmc_flags.DUPLICATE, btm_flag(map));
+
+        // update
+        cmc_assert(!btm_update(map, 2, 2, NULL));
+        cmc_assert_equals(int32_t, cmc_flags.NOT_FOUND, btm_flag(map));
+
+        cmc_assert(btm_update(map, 1, 2, NULL));
+        cmc_assert_equals(int32_t, cmc_flags.OK, btm_flag(map));
+
+        // remove
+        cmc_assert(!btm_remove(map, 2, NULL));
+        cmc_assert_equals(int32_t, cmc_flags.NOT_FOUND, btm_flag(map));
+
+        cmc_assert(btm_remove(map, 1, NULL));
+        cmc_assert_equals(int32_t, cmc_flags.OK, btm_flag(map));
+
+        cmc_assert(!btm_remove(map, 1, NULL));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, btm_flag(map));
+
+        // max min
+        map->flag = cmc_flags.ERROR;
+        cmc_assert(!btm_max(map, NULL, NULL));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, btm_flag(map));
+
+        map->flag = cmc_flags.ERROR;
+        cmc_assert(!btm_min(map, NULL, NULL));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, btm_flag(map));
+
+        cmc_assert(btm_insert(map, 1, 1));
+        map->flag = cmc_flags.ERROR;
+        cmc_assert(btm_max(map, NULL, NULL));
+        cmc_assert_equals(int32_t, cmc_flags.OK, btm_flag(map));
+
+        map->flag = cmc_flags.ERROR;
+        cmc_assert(btm_min(map, NULL, NULL));
+        cmc_assert_equals(int32_t, cmc_flags.OK, btm_flag(map));
+
+        // get get_ref
+        btm_get(map, 2);
+        cmc_assert_equals(int32_t, cmc_flags.NOT_FOUND, btm_flag(map));
+
+        btm_get(map, 1);
+        cmc_assert_equals(int32_t, cmc_flags.OK, btm_flag(map));
+
+        btm_get_ref(map, 2);
+        cmc_assert_equals(int32_t, cmc_flags.NOT_FOUND, btm_flag(map));
+
+        btm_get_ref(map, 1);
+        cmc_assert_equals(int32_t, cmc_flags.OK, btm_flag(map));
+
+        cmc_assert(btm_remove(map, 1, NULL));
+        map->flag = cmc_flags.ERROR;
+        btm_get(map, 1);
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, btm_flag(map));
+
+        map->flag = cmc_flags.ERROR;
+        btm_get_ref(map, 1);
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, btm_flag(map));
+
+        // copy_of
+        map->flag = cmc_flags.ERROR;
+        struct btreemap *map2 = btm_copy_of(map);
+        cmc_assert_equals(int32_t, cmc_flags.OK, btm_flag(map));
+        cmc_assert_equals(int32_t, cmc_flags.OK, btm_flag(map2));
+
+        // equals
+        map->flag = cmc_flags.ERROR;
+        map2->flag = cmc_flags.ERROR;
+        cmc_assert(btm_equals(map, map2));
+        cmc_assert_equals(int32_t, cmc_flags.OK, btm_flag(map));
+        cmc_assert_equals(int32_t, cmc_flags.OK, btm_flag(map2));
+
+        btm_free(map);
+        btm_free(map2);
+    });
+
+    CMC_CREATE_TEST(callbacks, {
+        struct btreemap *map =
+            btm_new_custom(btm_fkey, btm_fval, NULL, callbacks);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        total_create = 0;
+        total_read = 0;
+        total_update = 0;
+        total_delete = 0;
+        total_resize = 0;
+
+        cmc_assert(btm_insert(map, 1, 10));
+        cmc_assert_equals(int32_t, 1, total_create);
+
+        cmc_assert(btm_update(map, 1, 2, NULL));
+        cmc_assert_equals(int32_t, 1, total_update);
+
+        cmc_assert(btm_remove(map, 1, NULL));
+        cmc_assert_equals(int32_t, 1, total_delete);
+
+        cmc_assert(btm_insert(map, 1, 2));
+        cmc_assert_equals(int32_t, 2, total_create);
+
+        cmc_assert(btm_max(map, NULL, NULL));
+        cmc_assert_equals(int32_t, 1, total_read);
+
+        cmc_assert(btm_min(map, NULL, NULL));
+        cmc_assert_equals(int32_t, 2, total_read);
+
+        cmc_assert_equals(size_t, 2, btm_get(map, 1));
+        cmc_assert_equals(int32_t, 3, total_read);
+
+        cmc_assert_not_equals(ptr, NULL, btm_get_ref(map, 1));
+        cmc_assert_equals(int32_t, 4, total_read);
+
+        cmc_assert(btm_contains(map, 1));
+        cmc_assert_equals(int32_t, 5, total_read);
+
+        cmc_assert_equals(int32_t, 2, total_create);
+        cmc_assert_equals(int32_t, 5, total_read);
+        cmc_assert_equals(int32_t, 1, total_update);
+        cmc_assert_equals(int32_t, 1, total_delete);
+        cmc_assert_equals(int32_t, 0, total_resize);
+
+        btm_customize(map, NULL, NULL);
+
+        btm_clear(map);
+        cmc_assert(btm_insert(map, 1, 10));
+        cmc_assert(btm_update(map, 1, 2, NULL));
+        cmc_assert(btm_remove(map, 1, NULL));
+        cmc_assert(btm_insert(map, 1, 2));
+        cmc_assert(btm_max(map, NULL, NULL));
+        cmc_assert(btm_min(map, NULL, NULL));
+        cmc_assert_equals(size_t, 2, btm_get(map, 1));
+        cmc_assert_not_equals(ptr, NULL, btm_get_ref(map, 1));
+        cmc_assert(btm_contains(map, 1));
+
+        cmc_assert_equals(int32_t, 2, total_create);
+        cmc_assert_equals(int32_t, 5, total_read);
+        cmc_assert_equals(int32_t, 1, total_update);
+        cmc_assert_equals(int32_t, 1, total_delete);
+        cmc_assert_equals(int32_t, 0, total_resize);
+
+        cmc_assert_equals(ptr, NULL, map->callbacks);
+
+        total_create = 0;
+        total_read = 0;
+        total_update = 0;
+        total_delete = 0;
+        total_resize = 0;
+
+        btm_free(map);
+    });
+
+    CMC_CREATE_TEST(insert[remove], {
+        struct btreemap *map = btm_new(btm_fkey, btm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        // 7919 and 10007 are primes so every key in [0, 10007) is generated
+        for (size_t i = 0; i < 10007; i++)
+            cmc_assert(btm_insert(map, (i * 7919) % 10007, i));
+
+        cmc_assert_equals(size_t, 10007, btm_count(map));
+        cmc_assert_equals(bool, false, map->root->leaf);
+
+        size_t index = 0;
+        struct btreemap_iter it = btm_iter_start(map);
+
+        for (; !btm_iter_at_end(&it); btm_iter_next(&it), index++)
+        {
+            size_t key = btm_iter_key(&it);
+
+            cmc_assert_equals(size_t, index, key);
+            cmc_assert_equals(size_t, key,
+                              (btm_iter_value(&it) * 7919) % 10007);
+        }
+
+        cmc_assert_equals(size_t, 10007, index);
+
+        for (size_t i = 0; i < 10007; i += 2)
+            cmc_assert(btm_remove(map, (i * 4999) % 10007, NULL));
+
+        cmc_assert_equals(size_t, 5003, btm_count(map));
+
+        for (size_t i = 0; i < 10007; i++)
+            cmc_assert_equals(bool, i % 2 == 1,
+                              btm_contains(map, (i * 4999) % 10007));
+
+        for (size_t i = 1; i < 10007; i += 2)
+            cmc_assert(btm_remove(map, (i * 4999) % 10007, NULL));
+
+        cmc_assert_equals(size_t, 0, btm_count(map));
+        cmc_assert_equals(ptr, NULL, map->root);
+        cmc_assert_equals(ptr, NULL, map->head);
+        cmc_assert_equals(ptr, NULL, map->tail);
+
+        btm_free(map);
+    });
+
+    CMC_CREATE_TEST(remove[owned keys], {
+        struct btreemap_str *map = btms_new(btms_fkey, btms_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        char *keys[500];
+
+        for (size_t i = 0; i < 500; i++)
+        {
+            keys[i] = malloc(8);
+            snprintf(keys[i], 8, "%04zu", i);
+
+            cmc_assert(btms_insert(map, keys[i], i));
+        }
+
+        cmc_assert_equals(bool, false, map->root->leaf);
+
+        // Keys copied up as separators must not be read after the caller
+        // frees them, so they are also overwritten before being freed
+        for (size_t i = 0; i < 500; i += 2)
+        {
+            cmc_assert(btms_remove(map, keys[i], NULL));
+
+            keys[i][0] = '~';
+            free(keys[i]);
+        }
+
+        char key[8];
+
+        for (size_t i = 0; i < 500; i++)
+        {
+            snprintf(key, 8, "%04zu", i);
+
+            cmc_assert_equals(bool, i % 2 == 1, btms_contains(map, key));
+        }
+
+        for (size_t i = 1; i < 500; i += 2)
+        {
+            cmc_assert(btms_remove(map, keys[i], NULL));
+
+            free(keys[i]);
+        }
+
+        cmc_assert(btms_empty(map));
+
+        btms_free(map);
+    });
+});
+
+CMC_CREATE_UNIT(BTreeMapIter, true, {
+    CMC_CREATE_TEST(PFX##_iter_start(), {
+        struct btreemap *map = btm_new(btm_fkey, btm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct btreemap_iter it = btm_iter_start(map);
+
+        cmc_assert_equals(ptr, map, it.target);
+        cmc_assert_equals(ptr, NULL, it.cursor);
+        cmc_assert_equals(size_t, 0, it.position);
+        cmc_assert_equals(size_t, 0, it.index);
+        cmc_assert_equals(bool, true, it.start);
+        cmc_assert_equals(bool, true, it.end);
+
+        cmc_assert(btm_iter_at_start(&it));
+        cmc_assert(btm_iter_at_end(&it));
+
+        cmc_assert(btm_insert(map, 1, 1));
+        cmc_assert(btm_insert(map, 2, 2));
+        cmc_assert(btm_insert(map, 3, 3));
+
+        it = btm_iter_start(map);
+
+        cmc_assert_equals(size_t, 0, it.index);
+
+        cmc_assert_equals(ptr, map->head, it.cursor);
+        cmc_assert_equals(size_t, 0, it.position);
+        cmc_assert_equals(size_t, 1, it.cursor->node.keys[it.position]);
+        cmc_assert_equals(bool, false, it.end);
+
+        btm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_end(), {
+        struct btreemap *map = btm_new(btm_fkey, btm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct btreemap_iter it = btm_iter_end(map);
+
+        cmc_assert_equals(ptr, map, it.target);
+        cmc_assert_equals(ptr, NULL, it.cursor);
+        cmc_assert_equals(size_t, 0, it.position);
+        cmc_assert_equals(size_t, 0, it.index);
+        cmc_assert_equals(bool, true, it.start);
+        cmc_assert_equals(bool, true, it.end);
+
+        cmc_assert(btm_iter_at_start(&it));
+        cmc_assert(btm_iter_at_end(&it));
+
+        cmc_assert(btm_insert(map, 1, 1));
+        cmc_assert(btm_insert(map, 2, 2));
+        cmc_assert(btm_insert(map, 3, 3));
+
+        it = btm_iter_end(map);
+
+        cmc_assert_equals(size_t, map->count - 1, it.index);
+
+        cmc_assert_equals(ptr, map->tail, it.cursor);
+        cmc_assert_equals(size_t, 2, it.position);
+        cmc_assert_equals(size_t, 3, it.cursor->node.keys[it.position]);
+        cmc_assert_equals(bool, false, it.start);
+
+        btm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_at_start(), {
+        struct btreemap *map = btm_new(btm_fkey, btm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct btreemap_iter it = btm_iter_start(map);
+
+        // Empty checks
+        cmc_assert(btm_iter_at_start(&it));
+        it = btm_iter_end(map);
+        cmc_assert(btm_iter_at_start(&it));
+
+        // Non-empty checks
+        cmc_assert(btm_insert(map, 1, 1));
+        cmc_assert(btm_insert(map, 2, 2));
+        it = btm_iter_end(map);
+        cmc_assert(!btm_iter_at_start(&it));
+        it = btm_iter_start(map);
+        cmc_assert(btm_iter_at_start(&it));
+
+        btm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_at_end(), {
+        struct btreemap *map = btm_new(btm_fkey, btm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct btreemap_iter it = btm_iter_start(map);
+
+        // Empty check
+        cmc_assert(btm_iter_at_end(&it));
+        it = btm_iter_end(map);
+        cmc_assert(btm_iter_at_end(&it));
+
+        // Non-empty checks
+        cmc_assert(btm_insert(map, 1, 1));
+        cmc_assert(btm_insert(map, 2, 2));
+        it = btm_iter_end(map);
+        cmc_assert(btm_iter_at_end(&it));
+        it = btm_iter_start(map);
+        cmc_assert(!btm_iter_at_end(&it));
+
+        btm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_to_start(), {
+        struct btreemap *map = btm_new(btm_fkey, btm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct btreemap_iter it = btm_iter_start(map);
+
+        cmc_assert(!btm_iter_to_start(&it));
+
+        for (size_t i = 1; i <= 100; i++)
+            btm_insert(map, i, i);
+
+        cmc_assert_equals(size_t, 100, map->count);
+
+        it = btm_iter_end(map);
+
+        cmc_assert(!btm_iter_at_start(&it));
+        cmc_assert(btm_iter_at_end(&it));
+
+        cmc_assert_equals(size_t, 100, btm_iter_value(&it));
+
+        cmc_assert(btm_iter_to_start(&it));
+
+        cmc_assert(btm_iter_at_start(&it));
+        cmc_assert(!btm_iter_at_end(&it));
+
+        cmc_assert_equals(size_t, 1, btm_iter_value(&it));
+
+        btm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_to_end(), {
+        struct btreemap *map = btm_new(btm_fkey, btm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct btreemap_iter it = btm_iter_end(map);
+
+        cmc_assert(!btm_iter_to_end(&it));
+
+        for (size_t i = 1; i <= 100; i++)
+            btm_insert(map, i, i);
+
+        it = btm_iter_start(map);
+
+        cmc_assert(btm_iter_at_start(&it));
+        cmc_assert(!btm_iter_at_end(&it));
+
+        cmc_assert_equals(size_t, 1, btm_iter_value(&it));
+
+        cmc_assert(btm_iter_to_end(&it));
+
+        cmc_assert(!btm_iter_at_start(&it));
+        cmc_assert(btm_iter_at_end(&it));
+
+        cmc_assert_equals(size_t, 100, btm_iter_value(&it));
+
+        btm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_next(), {
+        struct btreemap *map = btm_new(btm_fkey, btm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct btreemap_iter it = btm_iter_start(map);
+
+        cmc_assert(!btm_iter_next(&it));
+
+        for (size_t i = 1; i <= 1000; i++)
+            btm_insert(map, i, i);
+
+        size_t sum = 0;
+        for (it = btm_iter_start(map); !btm_iter_at_end(&it);
+             btm_iter_next(&it))
+        {
+            sum += btm_iter_value(&it);
+        }
+
+        cmc_assert_equals(size_t, 500500, sum);
+
+        sum = 0;
+
+        btm_iter_to_start(&it);
+        do
+        {
+            sum += btm_iter_value(&it);
+        } while (btm_iter_next(&it));
+
+        cmc_assert_equals(size_t, 500500, sum);
+
+        btm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_prev(), {
+        struct btreemap *map = btm_new(btm_fkey, btm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct btreemap_iter it = btm_iter_end(map);
+
+        cmc_assert(!btm_iter_prev(&it));
+
+        for (size_t i = 1; i <= 1000; i++)
+            btm_insert(map, i, i);
+
+        size_t sum = 0;
+        for (it = btm_iter_end(map); !btm_iter_at_start(&it);
+             btm_iter_prev(&it))
+        {
+            sum += btm_iter_value(&it);
+        }
+
+        cmc_assert_equals(size_t, 500500, sum);
+
+        sum = 0;
+
+        btm_iter_to_end(&it);
+        do
+        {
+            sum += btm_iter_value(&it);
+        } while (btm_iter_prev(&it));
+
+        cmc_assert_equals(size_t, 500500, sum);
+
+        btm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_advance(), {
+        struct btreemap *map = btm_new(btm_fkey, btm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct btreemap_iter it = btm_iter_start(map);
+
+        cmc_assert(!btm_iter_advance(&it, 1));
+
+        for (size_t i = 0; i <= 1000; i++)
+            btm_insert(map, i, i);
+
+        it = btm_iter_start(map);
+
+        cmc_assert(!btm_iter_advance(&it, 0));
+        cmc_assert(!btm_iter_advance(&it, map->count));
+
+        size_t sum = 0;
+        for (it = btm_iter_start(map);;)
+        {
+            sum += btm_iter_value(&it);
+
+            if (!btm_iter_advance(&it, 2))
+                break;
+        }
+
+        cmc_assert_equals(size_t, 250500, sum);
+
+        btm_iter_to_start(&it);
+        cmc_assert(btm_iter_advance(&it, map->count - 1));
+
+        btm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_rewind(), {
+        struct btreemap *map = btm_new(btm_fkey, btm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct btreemap_iter it = btm_iter_end(map);
+
+        cmc_assert(!btm_iter_rewind(&it, 1));
+
+        for (size_t i = 0; i <= 1000; i++)
+            btm_insert(map, i, i);
+
+        it = btm_iter_end(map);
+
+        cmc_assert(!btm_iter_rewind(&it, 0));
+        cmc_assert(!btm_iter_rewind(&it, map->count));
+
+        size_t sum = 0;
+        for (it = btm_iter_end(map);;)
+        {
+            sum += btm_iter_value(&it);
+
+            if (!btm_iter_rewind(&it, 2))
+                break;
+        }
+
+        cmc_assert_equals(size_t, 250500, sum);
+
+        btm_iter_to_end(&it);
+        cmc_assert(btm_iter_rewind(&it, map->count - 1));
+
+        btm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_go_to(), {
+        struct btreemap *map = btm_new(btm_fkey, btm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct btreemap_iter it = btm_iter_end(map);
+        cmc_assert(!btm_iter_go_to(&it, 0));
+
+        it = btm_iter_start(map);
+        cmc_assert(!btm_iter_go_to(&it, 0));
+
+        for (size_t i = 0; i <= 1000; i++)
+            btm_insert(map, i, i);
+
+        it = btm_iter_start(map);
+
+        size_t sum = 0;
+        for (size_t i = 0; i < 1001; i++)
+        {
+            btm_iter_go_to(&it, i);
+
+            sum += btm_iter_value(&it);
+        }
+
+        cmc_assert_equals(size_t, 500500, sum);
+
+        sum = 0;
+        for (size_t i = 1001; i > 0; i--)
+        {
+            cmc_assert(btm_iter_go_to(&it, i - 1));
+
+            sum += btm_iter_value(&it);
+        }
+
+        cmc_assert_equals(size_t, 500500, sum);
+
+        sum = 0;
+        for (size_t i = 0; i < 1001; i += 100)
+        {
+            cmc_assert(btm_iter_go_to(&it, i));
+            cmc_assert_equals(size_t, i, btm_iter_index(&it));
+
+            sum += btm_iter_value(&it);
+        }
+
+        cmc_assert_equals(size_t, 5500, sum);
+
+        btm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_key(), {
+        struct btreemap *map = btm_new(btm_fkey, btm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct btreemap_iter it = btm_iter_end(map);
+
+        cmc_assert_equals(size_t, (size_t){ 0 }, btm_iter_key(&it));
+
+        cmc_assert(btm_insert(map, 10, 10));
+
+        it = btm_iter_start(map);
+
+        cmc_assert_equals(size_t, 10, btm_iter_key(&it));
+
+        btm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_value(), {
+        struct btreemap *map = btm_new(btm_fkey, btm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct btreemap_iter it = btm_iter_end(map);
+
+        cmc_assert_equals(size_t, (size_t){ 0 }, btm_iter_value(&it));
+
+        cmc_assert(btm_insert(map, 10, 10));
+
+        it = btm_iter_start(map);
+
+        cmc_assert_equals(size_t, 10, btm_iter_value(&it));
+
+        btm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_rvalue(), {
+        struct btreemap *map = btm_new(btm_fkey, btm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct btreemap_iter it = btm_iter_end(map);
+
+        cmc_assert_equals(ptr, NULL, btm_iter_rvalue(&it));
+
+        cmc_assert(btm_insert(map, 10, 10));
+
+        it = btm_iter_start(map);
+
+        cmc_assert_not_equals(ptr, NULL, btm_iter_rvalue(&it));
+        cmc_assert_equals(size_t, 10, *btm_iter_rvalue(&it));
+
+        btm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_index(), {
+        struct btreemap *map = btm_new(btm_fkey, btm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 0; i <= 1000; i++)
+            btm_insert(map, i, i);
+
+        struct btreemap_iter it = btm_iter_start(map);
+
+        for (size_t i = 0; i < 1001; i++)
+        {
+            cmc_assert_equals(size_t, i, btm_iter_index(&it));
+            btm_iter_next(&it);
+        }
+
+        it = btm_iter_end(map);
+        for (size_t i = 1001; i > 0; i--)
+        {
+            cmc_assert_equals(size_t, i - 1, btm_iter_index(&it));
+            btm_iter_prev(&it);
+        }
+
+        btm_free(map);
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = BTreeMap() + BTreeMapIter();
+
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | BTreeMap Suit : %-46s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
@@ -0,0 +1,736 @@
+#include "utl.c"
+#include "utl/assert.h"
+#include "utl/test.h"
+
+#include "../src/btreeset.c"
+
+struct btreeset_fval *bts_fval = &(struct btreeset_fval){ .cmp = cmc_size_cmp,
+                                                          .cpy = NULL,
+                                                          .str = cmc_size_str,
+                                                          .free = NULL,
+                                                          .hash = cmc_size_hash,
+                                                          .pri = cmc_size_cmp };
+
+CMC_GENERATE_BTREESET(btss, btreeset_str, char *)
+
+struct btreeset_str_fval *btss_fval =
+    &(struct btreeset_str_fval){ .cmp = cmc_str_cmp,
+                                 .cpy = NULL,
+                                 .str = cmc_str_str,
+                                 .free = NULL,
+                                 .hash = cmc_str_hash_djb2,
+                                 .pri = cmc_str_cmp };
+
+CMC_CREATE_UNIT(BTreeSet, true, {
+    CMC_CREATE_TEST(new, {
+        struct btreeset *set = bts_new(bts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        bts_free(set);
+    });
+
+    CMC_CREATE_TEST(clear[count], {
+        struct btreeset *set = bts_new(bts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        for (size_t i = 0; i < 50; i++)
+            bts_insert(set, i);
+
+        cmc_assert_equals(size_t, 50, bts_count(set));
+
+        bts_clear(set);
+
+        cmc_assert_equals(size_t, 0, bts_count(set));
+        cmc_assert_equals(ptr, NULL, set->root);
+
+        bts_free(set);
+    });
+
+    CMC_CREATE_TEST(flags, {
+        struct btreeset *set = bts_new(bts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+        cmc_assert_equals(int32_t, cmc_flags.OK, bts_flag(set));
+
+        // clear
+        set->flag = cmc_flags.ERROR;
+        bts_clear(set);
+        cmc_assert_equals(int32_t, cmc_flags.OK, bts_flag(set));
+
+        // insert
+        set->flag = cmc_flags.ERROR;
+        cmc_assert(bts_insert(set, 1));
+        cmc_assert_equals(int32_t, cmc_flags.OK, bts_flag(set));
+
+        cmc_assert(!bts_insert(set, 1));
+        cmc_assert_equals(int32_t, cmc_flags.DUPLICATE, bts_flag(set));
+
+        // remove
+        cmc_assert(!bts_remove(set, 2));
+        cmc_assert_equals(int32_t, cmc_flags.NOT_FOUND, bts_flag(set));
+
+        cmc_assert(bts_remove(set, 1));
+        cmc_assert_equals(int32_t, cmc_flags.OK, bts_flag(set));
+
+        cmc_assert(!bts_remove(set, 1));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, bts_flag(set));
+
+        // max min
+        set->flag = cmc_flags.ERROR;
+        cmc_assert(!bts_max(set, NULL));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, bts_flag(set));
+
+        set->flag = cmc_flags.ERROR;
+        cmc_assert(!bts_min(set, NULL));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, bts_flag(set));
+
+        cmc_assert(bts_insert(set, 1));
+        set->flag = cmc_flags.ERROR;
+        cmc_assert(bts_max(set, NULL));
+        cmc_assert_equals(int32_t, cmc_flags.OK, bts_flag(set));
+
+        set->flag = cmc_flags.ERROR;
+        cmc_assert(bts_min(set, NULL));
+        cmc_assert_equals(int32_t, cmc_flags.OK, bts_flag(set));
+
+        // copy_of
+        set->flag = cmc_flags.ERROR;
+        struct btreeset *set2 = bts_copy_of(set);
+        cmc_assert_equals(int32_t, cmc_flags.OK, bts_flag(set));
+        cmc_assert_equals(int32_t, cmc_flags.OK, bts_flag(set2));
+
+        // equals
+        set->flag = cmc_flags.ERROR;
+        set2->flag = cmc_flags.ERROR;
+        cmc_assert(bts_equals(set, set2));
+        cmc_assert_equals(int32_t, cmc_flags.OK, bts_flag(set));
+        cmc_assert_equals(int32_t, cmc_flags.OK, bts_flag(set2));
+
+        bts_free(set);
+        bts_free(set2);
+    });
+
+    CMC_CREATE_TEST(callbacks, {
+        struct btreeset *set = bts_new_custom(bts_fval, NULL, callbacks);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        total_create = 0;
+        total_read = 0;
+        total_update = 0;
+        total_delete = 0;
+        total_resize = 0;
+
+        cmc_assert(bts_insert(set, 10));
+        cmc_assert_equals(int32_t, 1, total_create);
+
+        cmc_assert(bts_remove(set, 10));
+        cmc_assert_equals(int32_t, 1, total_delete);
+
+        cmc_assert(bts_insert(set, 1));
+        cmc_assert_equals(int32_t, 2, total_create);
+
+        cmc_assert(bts_max(set, NULL));
+        cmc_assert_equals(int32_t, 1, total_read);
+
+        cmc_assert(bts_min(set, NULL));
+        cmc_assert_equals(int32_t, 2, total_read);
+
+        cmc_assert(bts_contains(set, 1));
+        cmc_assert_equals(int32_t, 3, total_read);
+
+        cmc_assert_equals(int32_t, 2, total_create);
+        cmc_assert_equals(int32_t, 3, total_read);
+        cmc_assert_equals(int32_t, 0, total_update);
+        cmc_assert_equals(int32_t, 1, total_delete);
+        cmc_assert_equals(int32_t, 0, total_resize);
+
+        bts_customize(set, NULL, NULL);
+
+        bts_clear(set);
+        cmc_assert(bts_insert(set, 10));
+        cmc_assert(bts_remove(set, 10));
+        cmc_assert(bts_insert(set, 1));
+        cmc_assert(bts_max(set, NULL));
+        cmc_assert(bts_min(set, NULL));
+        cmc_assert(bts_contains(set, 1));
+
+        cmc_assert_equals(int32_t, 2, total_create);
+        cmc_assert_equals(int32_t, 3, total_read);
+        cmc_assert_equals(int32_t, 0, total_update);
+        cmc_assert_equals(int32_t, 1, total_delete);
+        cmc_assert_equals(int32_t, 0, total_resize);
+
+        cmc_assert_equals(ptr, NULL, set->callbacks);
+
+        total_create = 0;
+        total_read = 0;
+        total_update = 0;
+        total_delete = 0;
+        total_resize = 0;
+
+        bts_free(set);
+    });
+
+    CMC_CREATE_TEST(insert[remove], {
+        struct btreeset *set = bts_new(bts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        // 7919 and 10007 are primes so every value in [0, 10007) is generated
+        for (size_t i = 0; i < 10007; i++)
+            cmc_assert(bts_insert(set, (i * 7919) % 10007));
+
+        cmc_assert_equals(size_t, 10007, bts_count(set));
+        cmc_assert_equals(bool, false, set->root->leaf);
+
+        size_t index = 0;
+        struct btreeset_iter it = bts_iter_start(set);
+
+        for (; !bts_iter_at_end(&it); bts_iter_next(&it), index++)
+            cmc_assert_equals(size_t, index, bts_iter_value(&it));
+
+        cmc_assert_equals(size_t, 10007, index);
+
+        for (size_t i = 0; i < 10007; i += 2)
+            cmc_assert(bts_remove(set, (i * 4999) % 10007));
+
+        cmc_assert_equals(size_t, 5003, bts_count(set));
+
+        for (size_t i = 0; i < 10007; i++)
+            cmc_assert_equals(bool, i % 2 == 1,
+                              bts_contains(set, (i * 4999) % 10007));
+
+        for (size_t i = 1; i < 10007; i += 2)
+            cmc_assert(bts_remove(set, (i * 4999) % 10007));
+
+        cmc_assert_equals(size_t, 0, bts_count(set));
+        cmc_assert_equals(ptr, NULL, set->root);
+        cmc_assert_equals(ptr, NULL, set->head);
+        cmc_assert_equals(ptr, NULL, set->tail);
+
+        bts_free(set);
+    });
+
+    CMC_CREATE_TEST(set_operations, {
+        struct btreeset *set1 = bts_new(bts_fval);
+        struct btreeset *set2 = bts_new(bts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set1);
+        cmc_assert_not_equals(ptr, NULL, set2);
+
+        // set1 has multiples of 2 and set2 has multiples of 3
+        for (size_t i = 0; i < 3000; i += 2)
+            cmc_assert(bts_insert(set1, i));
+        for (size_t i = 0; i < 3000; i += 3)
+            cmc_assert(bts_insert(set2, i));
+
+        struct btreeset *set_u = bts_union(set1, set2);
+        struct btreeset *set_i = bts_intersection(set1, set2);
+        struct btreeset *set_d = bts_difference(set1, set2);
+        struct btreeset *set_s = bts_symmetric_difference(set1, set2);
+
+        cmc_assert_equals(size_t, 2000, bts_count(set_u));
+        cmc_assert_equals(size_t, 500, bts_count(set_i));
+        cmc_assert_equals(size_t, 1000, bts_count(set_d));
+        cmc_assert_equals(size_t, 1500, bts_count(set_s));
+
+        for (size_t i = 0; i < 3000; i++)
+        {
+            bool in1 = i % 2 == 0;
+            bool in2 = i % 3 == 0;
+
+            cmc_assert_equals(bool, in1 || in2, bts_contains(set_u, i));
+            cmc_assert_equals(bool, in1 &&in2, bts_contains(set_i, i));
+            cmc_assert_equals(bool, in1 && !in2, bts_contains(set_d, i));
+            cmc_assert_equals(bool, in1 != in2, bts_contains(set_s, i));
+        }
+
+        cmc_assert(bts_is_subset(set_i, set1));
+        cmc_assert(bts_is_subset(set_i, set2));
+        cmc_assert(bts_is_proper_subset(set_d, set1));
+        cmc_assert(bts_is_superset(set_u, set_s));
+        cmc_assert(!bts_is_subset(set1, set2));
+        cmc_assert(!bts_is_proper_superset(set1, set1));
+        cmc_assert(bts_is_disjointset(set_d, set2));
+        cmc_assert(!bts_is_disjointset(set1, set2));
+
+        bts_free(set1);
+        bts_free(set2);
+        bts_free(set_u);
+        bts_free(set_i);
+        bts_free(set_d);
+        bts_free(set_s);
+    });
+
+    CMC_CREATE_TEST(remove[owned keys], {
+        struct btreeset_str *set = btss_new(btss_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        char *keys[500];
+
+        for (size_t i = 0; i < 500; i++)
+        {
+            keys[i] = malloc(8);
+            snprintf(keys[i], 8, "%04zu", i);
+
+            cmc_assert(btss_insert(set, keys[i]));
+        }
+
+        cmc_assert_equals(bool, false, set->root->leaf);
+
+        // Keys copied up as separators must not be read after the caller
+        // frees them, so they are also overwritten before being freed
+        for (size_t i = 0; i < 500; i += 2)
+        {
+            cmc_assert(btss_remove(set, keys[i]));
+
+            keys[i][0] = '~';
+            free(keys[i]);
+        }
+
+        char key[8];
+
+        for (size_t i = 0; i < 500; i++)
+        {
+            snprintf(key, 8, "%04zu", i);
+
+            cmc_assert_equals(bool, i % 2 == 1, btss_contains(set, key));
+        }
+
+        for (size_t i = 1; i < 500; i += 2)
+        {
+            cmc_assert(btss_remove(set, keys[i]));
+
+            free(keys[i]);
+        }
+
+        cmc_assert(btss_empty(set));
+
+        btss_free(set);
+    });
+});
+
+CMC_CREATE_UNIT(BTreeSetIter, true, {
+    CMC_CREATE_TEST(PFX##_iter_start(), {
+        struct btreeset *set = bts_new(bts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        struct btreeset_iter it = bts_iter_start(set);
+
+        cmc_assert_equals(ptr, set, it.target);
+        cmc_assert_equals(ptr, NULL, it.cursor);
+        cmc_assert_equals(size_t, 0, it.position);
+        cmc_assert_equals(size_t, 0, it.index);
+        cmc_assert_equals(bool, true, it.start);
+        cmc_assert_equals(bool, true, it.end);
+
+        cmc_assert(bts_iter_at_start(&it));
+        cmc_assert(bts_iter_at_end(&it));
+
+        cmc_assert(bts_insert(set, 1));
+        cmc_assert(bts_insert(set, 2));
+        cmc_assert(bts_insert(set, 3));
+
+        it = bts_iter_start(set);
+
+        cmc_assert_equals(size_t, 0, it.index);
+
+        cmc_assert_equals(ptr, set->head, it.cursor);
+        cmc_assert_equals(size_t, 0, it.position);
+        cmc_assert_equals(size_t, 1, it.cursor->node.values[it.position]);
+        cmc_assert_equals(bool, false, it.end);
+
+        bts_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_end(), {
+        struct btreeset *set = bts_new(bts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        struct btreeset_iter it = bts_iter_end(set);
+
+        cmc_assert_equals(ptr, set, it.target);
+        cmc_assert_equals(ptr, NULL, it.cursor);
+        cmc_assert_equals(size_t, 0, it.position);
+        cmc_assert_equals(size_t, 0, it.index);
+        cmc_assert_equals(bool, true, it.start);
+        cmc_assert_equals(bool, true, it.end);
+
+        cmc_assert(bts_iter_at_start(&it));
+        cmc_assert(bts_iter_at_end(&it));
+
+        cmc_assert(bts_insert(set, 1));
+        cmc_assert(bts_insert(set, 2));
+        cmc_assert(bts_insert(set, 3));
+
+        it = bts_iter_end(set);
+
+        cmc_assert_equals(size_t, set->count - 1, it.index);
+
+        cmc_assert_equals(ptr, set->tail, it.cursor);
+        cmc_assert_equals(size_t, 2, it.position);
+        cmc_assert_equals(size_t, 3, it.cursor->node.values[it.position]);
+        cmc_assert_equals(bool, false, it.start);
+
+        bts_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_at_start(), {
+        struct btreeset *set = bts_new(bts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        struct btreeset_iter it = bts_iter_start(set);
+
+        // Empty checks
+        cmc_assert(bts_iter_at_start(&it));
+        it = bts_iter_end(set);
+        cmc_assert(bts_iter_at_start(&it));
+
+        // Non-empty checks
+        cmc_assert(bts_insert(set, 1));
+        cmc_assert(bts_insert(set, 2));
+        it = bts_iter_end(set);
+        cmc_assert(!bts_iter_at_start(&it));
+        it = bts_iter_start(set);
+        cmc_assert(bts_iter_at_start(&it));
+
+        bts_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_at_end(), {
+        struct btreeset *set = bts_new(bts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        struct btreeset_iter it = bts_iter_start(set);
+
+        // Empty check
+        cmc_assert(bts_iter_at_end(&it));
+        it = bts_iter_end(set);
+        cmc_assert(bts_iter_at_end(&it));
+
+        // Non-empty checks
+        cmc_assert(bts_insert(set, 1));
+        cmc_assert(bts_insert(set, 2));
+        it = bts_iter_end(set);
+        cmc_assert(bts_iter_at_end(&it));
+        it = bts_iter_start(set);
+        cmc_assert(!bts_iter_at_end(&it));
+
+        bts_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_to_start(), {
+        struct btreeset *set = bts_new(bts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        struct btreeset_iter it = bts_iter_start(set);
+
+        cmc_assert(!bts_iter_to_start(&it));
+
+        for (size_t i = 1; i <= 100; i++)
+            bts_insert(set, i);
+
+        cmc_assert_equals(size_t, 100, set->count);
+
+        it = bts_iter_end(set);
+
+        cmc_assert(!bts_iter_at_start(&it));
+        cmc_assert(bts_iter_at_end(&it));
+
+        cmc_assert_equals(size_t, 100, bts_iter_value(&it));
+
+        cmc_assert(bts_iter_to_start(&it));
+
+        cmc_assert(bts_iter_at_start(&it));
+        cmc_assert(!bts_iter_at_end(&it));
+
+        cmc_assert_equals(size_t, 1, bts_iter_value(&it));
+
+        bts_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_to_end(), {
+        struct btreeset *set = bts_new(bts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        struct btreeset_iter it = bts_iter_end(set);
+
+        cmc_assert(!bts_iter_to_end(&it));
+
+        for (size_t i = 1; i <= 100; i++)
+            bts_insert(set, i);
+
+        it = bts_iter_start(set);
+
+        cmc_assert(bts_iter_at_start(&it));
+        cmc_assert(!bts_iter_at_end(&it));
+
+        cmc_assert_equals(size_t, 1, bts_iter_value(&it));
+
+        cmc_assert(bts_iter_to_end(&it));
+
+        cmc_assert(!bts_iter_at_start(&it));
+        cmc_assert(bts_iter_at_end(&it));
+
+        cmc_assert_equals(size_t, 100, bts_iter_value(&it));
+
+        bts_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_next(), {
+        struct btreeset *set = bts_new(bts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        struct btreeset_iter it = bts_iter_start(set);
+
+        cmc_assert(!bts_iter_next(&it));
+
+        for (size_t i = 1; i <= 1000; i++)
+            bts_insert(set, i);
+
+        size_t sum = 0;
+        for (it = bts_iter_start(set); !bts_iter_at_end(&it);
+             bts_iter_next(&it))
+        {
+            sum += bts_iter_value(&it);
+        }
+
+        cmc_assert_equals(size_t, 500500, sum);
+
+        sum = 0;
+
+        bts_iter_to_start(&it);
+        do
+        {
+            sum += bts_iter_value(&it);
+        } while (bts_iter_next(&it));
+
+        cmc_assert_equals(size_t, 500500, sum);
+
+        bts_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_prev(), {
+        struct btreeset *set = bts_new(bts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        struct btreeset_iter it = bts_iter_end(set);
+
+        cmc_assert(!bts_iter_prev(&it));
+
+        for (size_t i = 1; i <= 1000; i++)
+            bts_insert(set, i);
+
+        size_t sum = 0;
+        for (it = bts_iter_end(set); !bts_iter_at_start(&it);
+             bts_iter_prev(&it))
+        {
+            sum += bts_iter_value(&it);
+        }
+
+        cmc_assert_equals(size_t, 500500, sum);
+
+        sum = 0;
+
+        bts_iter_to_end(&it);
+        do
+        {
+            sum += bts_iter_value(&it);
+        } while (bts_iter_prev(&it));
+
+        cmc_assert_equals(size_t, 500500, sum);
+
+        bts_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_advance(), {
+        struct btreeset *set = bts_new(bts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        struct btreeset_iter it = bts_iter_start(set);
+
+        cmc_assert(!bts_iter_advance(&it, 1));
+
+        for (size_t i = 0; i <= 1000; i++)
+            bts_insert(set, i);
+
+        it = bts_iter_start(set);
+
+        cmc_assert(!bts_iter_advance(&it, 0));
+        cmc_assert(!bts_iter_advance(&it, set->count));
+
+        size_t sum = 0;
+        for (it = bts_iter_start(set);;)
+        {
+            sum += bts_iter_value(&it);
+
+            if (!bts_iter_advance(&it, 2))
+                break;
+        }
+
+        cmc_assert_equals(size_t, 250500, sum);
+
+        bts_iter_to_start(&it);
+        cmc_assert(bts_iter_advance(&it, set->count - 1));
+
+        bts_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_rewind(), {
+        struct btreeset *set = bts_new(bts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        struct btreeset_iter it = bts_iter_end(set);
+
+        cmc_assert(!bts_iter_rewind(&it, 1));
+
+        for (size_t i = 0; i <= 1000; i++)
+            bts_insert(set, i);
+
+        it = bts_iter_end(set);
+
+        cmc_assert(!bts_iter_rewind(&it, 0));
+        cmc_assert(!bts_iter_rewind(&it, set->count));
+
+        size_t sum = 0;
+        for (it = bts_iter_end(set);;)
+        {
+            sum += bts_iter_value(&it);
+
+            if (!bts_iter_rewind(&it, 2))
+                break;
+        }
+
+        cmc_assert_equals(size_t, 250500, sum);
+
+        bts_iter_to_end(&it);
+        cmc_assert(bts_iter_rewind(&it, set->count - 1));
+
+        bts_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_go_to(), {
+        struct btreeset *set = bts_new(bts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        struct btreeset_iter it = bts_iter_end(set);
+        cmc_assert(!bts_iter_go_to(&it, 0));
+
+        it = bts_iter_start(set);
+        cmc_assert(!bts_iter_go_to(&it, 0));
+
+        for (size_t i = 0; i <= 1000; i++)
+            bts_insert(set, i);
+
+        it = bts_iter_start(set);
+
+        size_t sum = 0;
+        for (size_t i = 0; i < 1001; i++)
+        {
+            bts_iter_go_to(&it, i);
+
+            sum += bts_iter_value(&it);
+        }
+
+        cmc_assert_equals(size_t, 500500, sum);
+
+        sum = 0;
+        for (size_t i = 1001; i > 0; i--)
+        {
+            cmc_assert(bts_iter_go_to(&it, i - 1));
+
+            sum += bts_iter_value(&it);
+        }
+
+        cmc_assert_equals(size_t, 500500, sum);
+
+        sum = 0;
+        for (size_t i = 0; i < 1001; i += 100)
+        {
+            cmc_assert(bts_iter_go_to(&it, i));
+            cmc_assert_equals(size_t, i, bts_iter_index(&it));
+
+            sum += bts_iter_value(&it);
+        }
+
+        cmc_assert_equals(size_t, 5500, sum);
+
+        bts_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_value(), {
+        struct btreeset *set = bts_new(bts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        struct btreeset_iter it = bts_iter_end(set);
+
+        cmc_assert_equals(size_t, (size_t){ 0 }, bts_iter_value(&it));
+
+        cmc_assert(bts_insert(set, 10));
+
+        it = bts_iter_start(set);
+
+        cmc_assert_equals(size_t, 10, bts_iter_value(&it));
+
+        bts_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_index(), {
+        struct btreeset *set = bts_new(bts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        for (size_t i = 0; i <= 1000; i++)
+            bts_insert(set, i);
+
+        struct btreeset_iter it = bts_iter_start(set);
+
+        for (size_t i = 0; i < 1001; i++)
+        {
+            cmc_assert_equals(size_t, i, bts_iter_index(&it));
+            bts_iter_next(&it);
+        }
+
+        it = bts_iter_end(set);
+        for (size_t i = 1001; i > 0; i--)
+        {
+            cmc_assert_equals(size_t, i - 1, bts_iter_index(&it));
+            bts_iter_prev(&it);
+        }
+
+        bts_free(set);
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = BTreeSet() + BTreeSetIter();
+
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | BTreeSet Suit : %-46s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
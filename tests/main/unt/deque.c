@@ -4,6 +4,8 @@
 
 #include "../src/deque.c"
 
+CMC_GENERATE_DEQUE_POD(pd, pod_deque, uint64_t)
+
 struct deque_fval *d_fval = &(struct deque_fval){ .cmp = cmc_size_cmp,
                                                   .cpy = NULL,
                                                   .str = cmc_size_str,
@@ -22,6 +24,13 @@ struct cmc_alloc_node *d_alloc_node = &(struct cmc_alloc_node){
     .malloc = malloc, .calloc = calloc, .realloc = realloc, .free = free
 };
 
+struct pod_deque_fval *pd_fval = &(struct pod_deque_fval){ .cmp = cmc_u64_cmp,
+                                                           .cpy = NULL,
+                                                           .str = cmc_u64_str,
+                                                           .free = NULL,
+                                                           .hash = cmc_u64_hash,
+                                                           .pri = cmc_u64_cmp };
+
 CMC_CREATE_UNIT(Deque, true, {
     CMC_CREATE_TEST(PFX##_new(), {
         struct deque *d = d_new(1000000, d_fval);
@@ -1269,6 +1278,206 @@ CMC_CREATE_UNIT(Deque, true, {
         total_delete = 0;
         total_resize = 0;
     });
+
+    CMC_CREATE_TEST(contains[pod], {
+        struct pod_deque *d = pd_new(100, pd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        cmc_assert(!pd_contains(d, 0));
+
+        // The elements wrap around the end of the buffer
+        for (uint64_t i = 0; i < 50; i++)
+        {
+            cmc_assert(pd_push_front(d, i));
+            cmc_assert(pd_push_back(d, 1000 + i));
+        }
+
+        cmc_assert_equals(size_t, 100, pd_capacity(d));
+
+        for (uint64_t i = 0; i < 50; i++)
+        {
+            cmc_assert(pd_contains(d, i));
+            cmc_assert(pd_contains(d, 1000 + i));
+            cmc_assert(!pd_contains(d, 500 + i));
+        }
+
+        cmc_assert(pd_pop_front(d));
+        cmc_assert(pd_pop_back(d));
+
+        cmc_assert(!pd_contains(d, 49));
+        cmc_assert(!pd_contains(d, 1049));
+
+        pd_free(d);
+    });
+
+    CMC_CREATE_TEST(resize[wrapped], {
+        // Every position of the front and of the wrapped part
+        for (size_t front = 0; front < 16; front++)
+        {
+            for (size_t extra = 1; extra <= 40; extra += 13)
+            {
+                struct deque *x = d_new(16, d_fval);
+
+                cmc_assert_not_equals(ptr, NULL, x);
+
+                for (size_t i = 0; i < front; i++)
+                    cmc_assert(d_push_back(x, 0));
+
+                for (size_t i = 0; i < front; i++)
+                    cmc_assert(d_pop_front(x));
+
+                for (size_t i = 0; i < 16; i++)
+                    cmc_assert(d_push_back(x, i));
+
+                cmc_assert(d_reserve(x, extra));
+                cmc_assert_equals(size_t, 16, d_count(x));
+
+                for (size_t i = 16; i < 16 + extra; i++)
+                    cmc_assert(d_push_back(x, i));
+
+                for (size_t i = 0; i < 16 + extra; i++)
+                {
+                    cmc_assert_equals(size_t, i, d_front(x));
+                    cmc_assert(d_pop_front(x));
+                }
+
+                d_free(x);
+            }
+        }
+    });
+
+    CMC_CREATE_TEST(shrink_to_fit, {
+        struct deque *x = d_new(100, d_fval);
+
+        cmc_assert_not_equals(ptr, NULL, x);
+
+        for (size_t i = 0; i < 90; i++)
+            cmc_assert(d_push_back(x, i));
+
+        for (size_t i = 0; i < 80; i++)
+            cmc_assert(d_pop_front(x));
+
+        for (size_t i = 90; i < 95; i++)
+            cmc_assert(d_push_back(x, i));
+
+        cmc_assert(d_shrink_to_fit(x));
+        cmc_assert_equals(size_t, 15, d_capacity(x));
+
+        for (size_t i = 80; i < 95; i++)
+        {
+            cmc_assert_equals(size_t, i, d_front(x));
+            cmc_assert(d_pop_front(x));
+        }
+
+        cmc_assert(d_shrink_to_fit(x));
+        cmc_assert_equals(size_t, 1, d_capacity(x));
+
+        cmc_assert(d_push_back(x, 1));
+        cmc_assert(d_push_back(x, 2));
+        cmc_assert_equals(size_t, 1, d_front(x));
+
+        d_free(x);
+    });
+
+    CMC_CREATE_TEST(push_back_n pop_front_n[wrap around], {
+        struct deque *x = d_new(10, d_fval);
+
+        cmc_assert_not_equals(ptr, NULL, x);
+
+        size_t values[8];
+        size_t out[20];
+
+        for (size_t i = 0; i < 8; i++)
+            values[i] = i + 100;
+
+        // Moves the front of the buffer close to its end
+        for (size_t i = 0; i < 7; i++)
+            cmc_assert(d_push_back(x, i));
+
+        cmc_assert_equals(size_t, 5, d_pop_front_n(x, NULL, 5));
+
+        // The values are split where the buffer wraps around
+        cmc_assert(d_push_back_n(x, values, 8));
+        cmc_assert_equals(size_t, 10, d_count(x));
+        cmc_assert_equals(size_t, 10, d_capacity(x));
+
+        cmc_assert_equals(size_t, 10, d_pop_front_n(x, out, 20));
+        cmc_assert(d_empty(x));
+
+        // The vacated slots are cleared like a single pop_front does
+        for (size_t i = 0; i < 10; i++)
+            cmc_assert_equals(size_t, 0, x->buffer[i]);
+
+        cmc_assert_equals(size_t, 5, out[0]);
+        cmc_assert_equals(size_t, 6, out[1]);
+
+        for (size_t i = 0; i < 8; i++)
+            cmc_assert_equals(size_t, i + 100, out[i + 2]);
+
+        cmc_assert_equals(size_t, 0, d_pop_front_n(x, out, 1));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, d_flag(x));
+
+        d_free(x);
+    });
+
+    CMC_CREATE_TEST(push_back_n pop_front_n[callbacks], {
+        struct deque *x = d_new_custom(10, d_fval, NULL, callbacks);
+
+        cmc_assert_not_equals(ptr, NULL, x);
+
+        size_t values[5];
+
+        for (size_t i = 0; i < 5; i++)
+            values[i] = i + 1;
+
+        total_create = 0;
+        total_delete = 0;
+
+        // Nothing is inserted or removed
+        cmc_assert(d_push_back_n(x, values, 0));
+        cmc_assert_equals(int32_t, cmc_flags.OK, d_flag(x));
+        cmc_assert_equals(int32_t, 0, total_create);
+        cmc_assert_equals(size_t, 0, d_pop_front_n(x, NULL, 5));
+        cmc_assert_equals(int32_t, 0, total_delete);
+
+        cmc_assert(d_push_back_n(x, values, 5));
+        cmc_assert_equals(int32_t, 1, total_create);
+        cmc_assert_equals(size_t, 5, d_pop_front_n(x, NULL, 5));
+        cmc_assert_equals(int32_t, 1, total_delete);
+
+        d_free(x);
+
+        total_create = 0;
+        total_delete = 0;
+    });
+
+    CMC_CREATE_TEST(push_back_n pop_front_n[grow], {
+        struct deque *x = d_new(10, d_fval);
+
+        cmc_assert_not_equals(ptr, NULL, x);
+
+        size_t values[1000];
+        size_t out[1000];
+        size_t next = 0;
+
+        for (size_t i = 0; i < 1000; i++)
+            values[i] = i;
+
+        // Leaves one more element behind every time
+        for (size_t i = 0; i < 10; i++)
+        {
+            cmc_assert(d_push_back_n(x, values, 1000));
+            cmc_assert_equals(size_t, 999, d_pop_front_n(x, out, 999));
+
+            for (size_t j = 0; j < 999; j++)
+                cmc_assert_equals(size_t, next++ % 1000, out[j]);
+        }
+
+        cmc_assert_equals(size_t, 10, d_count(x));
+
+        d_free(x);
+    });
 });
 
 CMC_CREATE_UNIT(DequeIter, true, {
@@ -5,6 +5,8 @@
 #include "utl/foreach.h"
 
 #include "../src/bitset.c"
+#include "../src/btreemap.c"
+#include "../src/btreeset.c"
 #include "../src/deque.c"
 #include "../src/hashbidimap.c"
 #include "../src/hashmap.c"
@@ -30,6 +32,75 @@ CMC_CREATE_UNIT(ForEach, true, {
     //     bs_free(bs);
     // });
 
+    CMC_CREATE_TEST(CMC<BTreeMap>, {
+        struct btreemap *btm =
+            btm_new(&(struct btreemap_fkey){ .cmp = cmc_size_cmp,
+                                             .cpy = NULL,
+                                             .str = cmc_size_str,
+                                             .free = NULL,
+                                             .hash = cmc_size_hash,
+                                             .pri = cmc_size_cmp },
+                    &(struct btreemap_fval){ .cmp = cmc_size_cmp,
+                                             .cpy = NULL,
+                                             .str = cmc_size_str,
+                                             .free = NULL,
+                                             .hash = cmc_size_hash,
+                                             .pri = cmc_size_cmp });
+
+        for (size_t i = 1; i <= 10000; i++)
+            btm_insert(btm, i, i);
+
+        size_t sumk = 0;
+        size_t sumv = 0;
+        CMC_FOREACH (btm, btreemap, it, btm)
+        {
+            sumk += btm_iter_key(&it);
+            sumv += btm_iter_value(&it);
+        }
+        cmc_assert_equals(size_t, 50005000, sumk);
+        cmc_assert_equals(size_t, 50005000, sumv);
+
+        sumk = 0;
+        sumv = 0;
+        CMC_FOREACH_REV (btm, btreemap, it, btm)
+        {
+            sumk += btm_iter_key(&it);
+            sumv += btm_iter_value(&it);
+        }
+        cmc_assert_equals(size_t, 50005000, sumk);
+        cmc_assert_equals(size_t, 50005000, sumv);
+
+        btm_free(btm);
+    });
+
+    CMC_CREATE_TEST(CMC<BTreeSet>, {
+        struct btreeset *bts =
+            bts_new(&(struct btreeset_fval){ .cmp = cmc_size_cmp,
+                                             .cpy = NULL,
+                                             .str = cmc_size_str,
+                                             .free = NULL,
+                                             .hash = cmc_size_hash,
+                                             .pri = cmc_size_cmp });
+
+        for (size_t i = 1; i <= 10000; i++)
+            bts_insert(bts, i);
+
+        size_t sumv = 0;
+        CMC_FOREACH (bts, btreeset, it, bts)
+        {
+            sumv += bts_iter_value(&it);
+        }
+        cmc_assert_equals(size_t, 50005000, sumv);
+
+        sumv = 0;
+        CMC_FOREACH_REV (bts, btreeset, it, bts)
+        {
+            sumv += bts_iter_value(&it);
+        }
+        cmc_assert_equals(size_t, 50005000, sumv);
+
+        bts_free(bts);
+    });
     CMC_CREATE_TEST(CMC<Deque>, {
         struct deque *d =
             d_new(10000, &(struct deque_fval){ .cmp = cmc_size_cmp,
@@ -0,0 +1,604 @@
+#include "utl.c"
+#include "utl/assert.h"
+#include "utl/test.h"
+
+#include "../src/gapbuffer.c"
+
+struct gapbuffer_fval *gb_fval =
+    &(struct gapbuffer_fval){ .cmp = cmc_size_cmp,
+                              .cpy = NULL,
+                              .str = cmc_size_str,
+                              .free = NULL,
+                              .hash = cmc_size_hash,
+                              .pri = cmc_size_cmp };
+
+struct gapbuffer_fval *gb_fval_counter =
+    &(struct gapbuffer_fval){ .cmp = v_c_cmp,
+                              .cpy = v_c_cpy,
+                              .str = v_c_str,
+                              .free = v_c_free,
+                              .hash = v_c_hash,
+                              .pri = v_c_pri };
+
+/* Where the gap is moved to in the move_gap test */
+size_t gb_gap_indexes[8] = { 0, 40, 20, 3, 37, 19, 20, 0 };
+
+CMC_CREATE_UNIT(GapBuffer, true, {
+    CMC_CREATE_TEST(new, {
+        struct gapbuffer *g = gb_new(100, gb_fval);
+
+        cmc_assert_not_equals(ptr, NULL, g);
+        cmc_assert_not_equals(ptr, NULL, g->buffer);
+        cmc_assert_equals(size_t, 100, gb_capacity(g));
+        cmc_assert_equals(size_t, 0, gb_count(g));
+        cmc_assert_equals(size_t, 0, gb_gap_index(g));
+
+        gb_free(g);
+    });
+
+    CMC_CREATE_TEST(new[capacity = 0], {
+        struct gapbuffer *g = gb_new(0, gb_fval);
+
+        cmc_assert_equals(ptr, NULL, g);
+    });
+
+    CMC_CREATE_TEST(new[capacity = UINT64_MAX], {
+        struct gapbuffer *g = gb_new(UINT64_MAX, gb_fval);
+
+        cmc_assert_equals(ptr, NULL, g);
+    });
+
+    CMC_CREATE_TEST(clear[count capacity], {
+        struct gapbuffer *g = gb_new(100, gb_fval);
+
+        cmc_assert_not_equals(ptr, NULL, g);
+
+        for (size_t i = 0; i < 50; i++)
+            gb_push_back(g, i);
+
+        cmc_assert(gb_move_gap(g, 25));
+
+        gb_clear(g);
+
+        cmc_assert_equals(size_t, 0, gb_count(g));
+        cmc_assert_equals(size_t, 0, gb_gap_index(g));
+        cmc_assert_equals(size_t, 100, gb_capacity(g));
+
+        gb_free(g);
+    });
+
+    CMC_CREATE_TEST(free[counter], {
+        v_total_free = 0;
+
+        struct gapbuffer *g = gb_new(1, gb_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, g);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(gb_push_back(g, i));
+
+        cmc_assert(gb_move_gap(g, 30));
+
+        gb_free(g);
+
+        cmc_assert_equals(int32_t, 100, v_total_free);
+
+        v_total_free = 0;
+    });
+
+    CMC_CREATE_TEST(push_at[clustered], {
+        struct gapbuffer *g = gb_new(1, gb_fval);
+
+        cmc_assert_not_equals(ptr, NULL, g);
+
+        for (size_t i = 0; i < 10; i++)
+            cmc_assert(gb_push_back(g, i));
+
+        for (size_t i = 90; i < 100; i++)
+            cmc_assert(gb_push_back(g, i));
+
+        // Every insertion is done right after the previous one
+        for (size_t i = 10; i < 90; i++)
+        {
+            cmc_assert(gb_push_at(g, i, i));
+            cmc_assert_equals(size_t, i + 1, gb_gap_index(g));
+        }
+
+        cmc_assert_equals(size_t, 100, gb_count(g));
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert_equals(size_t, i, gb_get(g, i));
+
+        cmc_assert(!gb_push_at(g, 100, 101));
+        cmc_assert_equals(int32_t, cmc_flags.RANGE, gb_flag(g));
+
+        gb_free(g);
+    });
+
+    CMC_CREATE_TEST(push_front push_back, {
+        struct gapbuffer *g = gb_new(1, gb_fval);
+
+        cmc_assert_not_equals(ptr, NULL, g);
+
+        for (size_t i = 1; i <= 50; i++)
+        {
+            cmc_assert(gb_push_front(g, 50 - i));
+            cmc_assert(gb_push_back(g, 49 + i));
+        }
+
+        cmc_assert_equals(size_t, 100, gb_count(g));
+        cmc_assert_equals(size_t, 0, gb_front(g));
+        cmc_assert_equals(size_t, 99, gb_back(g));
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert_equals(size_t, i, gb_get(g, i));
+
+        gb_free(g);
+    });
+
+    CMC_CREATE_TEST(pop_at[both sides of the gap], {
+        struct gapbuffer *g = gb_new(1, gb_fval);
+
+        cmc_assert_not_equals(ptr, NULL, g);
+
+        cmc_assert(!gb_pop_front(g));
+        cmc_assert(!gb_pop_back(g));
+        cmc_assert(!gb_pop_at(g, 0));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, gb_flag(g));
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(gb_push_back(g, i));
+
+        cmc_assert(gb_move_gap(g, 50));
+
+        // Removing the elements before the gap, like a backspace
+        for (size_t i = 0; i < 10; i++)
+        {
+            cmc_assert(gb_pop_at(g, gb_gap_index(g) - 1));
+            cmc_assert_equals(size_t, 49 - i, gb_gap_index(g));
+        }
+
+        // Removing the elements after the gap, like a delete
+        for (size_t i = 0; i < 10; i++)
+        {
+            cmc_assert(gb_pop_at(g, gb_gap_index(g)));
+            cmc_assert_equals(size_t, 40, gb_gap_index(g));
+        }
+
+        cmc_assert_equals(size_t, 80, gb_count(g));
+
+        for (size_t i = 0; i < 40; i++)
+            cmc_assert_equals(size_t, i, gb_get(g, i));
+
+        for (size_t i = 40; i < 80; i++)
+            cmc_assert_equals(size_t, i + 20, gb_get(g, i));
+
+        cmc_assert(gb_pop_front(g));
+        cmc_assert(gb_pop_back(g));
+
+        cmc_assert_equals(size_t, 1, gb_front(g));
+        cmc_assert_equals(size_t, 98, gb_back(g));
+
+        cmc_assert(!gb_pop_at(g, 78));
+        cmc_assert_equals(int32_t, cmc_flags.RANGE, gb_flag(g));
+
+        gb_free(g);
+    });
+
+    CMC_CREATE_TEST(move_gap, {
+        struct gapbuffer *g = gb_new(64, gb_fval);
+
+        cmc_assert_not_equals(ptr, NULL, g);
+
+        for (size_t i = 0; i < 40; i++)
+            cmc_assert(gb_push_back(g, i));
+
+        for (size_t i = 0; i < 8; i++)
+        {
+            size_t index = gb_gap_indexes[i];
+
+            cmc_assert(gb_move_gap(g, index));
+            cmc_assert_equals(size_t, index, gb_gap_index(g));
+
+            for (size_t j = 0; j < 40; j++)
+                cmc_assert_equals(size_t, j, gb_get(g, j));
+
+            // The gap itself is kept zeroed
+            for (size_t j = 0; j < 24; j++)
+                cmc_assert_equals(size_t, 0, g->buffer[index + j]);
+        }
+
+        cmc_assert(!gb_move_gap(g, 41));
+        cmc_assert_equals(int32_t, cmc_flags.RANGE, gb_flag(g));
+
+        gb_free(g);
+    });
+
+    CMC_CREATE_TEST(seq_push, {
+        struct gapbuffer *g = gb_new(1, gb_fval);
+
+        cmc_assert_not_equals(ptr, NULL, g);
+
+        size_t values[20];
+
+        for (size_t i = 0; i < 20; i++)
+            values[i] = i;
+
+        cmc_assert(gb_seq_push_back(g, values + 5, 2));
+        cmc_assert(gb_seq_push_front(g, values, 5));
+        cmc_assert(gb_seq_push_back(g, values + 10, 10));
+        cmc_assert(gb_seq_push_at(g, values + 7, 3, 7));
+        cmc_assert_equals(size_t, 10, gb_gap_index(g));
+
+        cmc_assert_equals(size_t, 20, gb_count(g));
+
+        for (size_t i = 0; i < 20; i++)
+            cmc_assert_equals(size_t, i, gb_get(g, i));
+
+        cmc_assert(!gb_seq_push_back(g, values, 0));
+        cmc_assert_equals(int32_t, cmc_flags.INVALID, gb_flag(g));
+
+        cmc_assert(!gb_seq_push_at(g, values, 1, 21));
+        cmc_assert_equals(int32_t, cmc_flags.RANGE, gb_flag(g));
+
+        gb_free(g);
+    });
+
+    CMC_CREATE_TEST(seq_pop_at, {
+        struct gapbuffer *g = gb_new(1, gb_fval);
+
+        cmc_assert_not_equals(ptr, NULL, g);
+
+        for (size_t i = 0; i < 20; i++)
+            cmc_assert(gb_push_back(g, i));
+
+        cmc_assert(gb_move_gap(g, 10));
+        cmc_assert(gb_seq_pop_at(g, 5, 14));
+
+        cmc_assert_equals(size_t, 10, gb_count(g));
+        cmc_assert_equals(size_t, 5, gb_gap_index(g));
+        cmc_assert_equals(size_t, 4, gb_get(g, 4));
+        cmc_assert_equals(size_t, 15, gb_get(g, 5));
+
+        cmc_assert(!gb_seq_pop_at(g, 5, 10));
+        cmc_assert_equals(int32_t, cmc_flags.RANGE, gb_flag(g));
+
+        cmc_assert(!gb_seq_pop_at(g, 5, 4));
+        cmc_assert_equals(int32_t, cmc_flags.INVALID, gb_flag(g));
+
+        gb_free(g);
+    });
+
+    CMC_CREATE_TEST(seq_sublist, {
+        struct gapbuffer *g = gb_new(1, gb_fval);
+
+        cmc_assert_not_equals(ptr, NULL, g);
+
+        for (size_t i = 0; i < 20; i++)
+            cmc_assert(gb_push_back(g, i));
+
+        cmc_assert(gb_move_gap(g, 2));
+
+        struct gapbuffer *s = gb_seq_sublist(g, 10, 13);
+
+        cmc_assert_not_equals(ptr, NULL, s);
+        cmc_assert_equals(size_t, 4, gb_count(s));
+        cmc_assert_equals(size_t, 16, gb_count(g));
+
+        for (size_t i = 0; i < 4; i++)
+            cmc_assert_equals(size_t, 10 + i, gb_get(s, i));
+
+        cmc_assert_equals(size_t, 9, gb_get(g, 9));
+        cmc_assert_equals(size_t, 14, gb_get(g, 10));
+
+        cmc_assert(gb_push_back(s, 14));
+        cmc_assert_equals(size_t, 14, gb_back(s));
+
+        gb_free(s);
+        gb_free(g);
+    });
+
+    CMC_CREATE_TEST(contains index_of, {
+        struct gapbuffer *g = gb_new(1, gb_fval);
+
+        cmc_assert_not_equals(ptr, NULL, g);
+
+        for (size_t i = 0; i < 20; i++)
+            cmc_assert(gb_push_back(g, i % 10));
+
+        // Gaps next to the elements that are searched for
+        for (size_t i = 0; i <= 20; i++)
+        {
+            cmc_assert(gb_move_gap(g, i));
+
+            cmc_assert(gb_contains(g, 0));
+            cmc_assert(gb_contains(g, 9));
+            cmc_assert(!gb_contains(g, 10));
+            cmc_assert_equals(size_t, 3, gb_index_of(g, 3, true));
+            cmc_assert_equals(size_t, 13, gb_index_of(g, 3, false));
+            cmc_assert_equals(size_t, 20, gb_index_of(g, 10, true));
+            cmc_assert_equals(size_t, 20, gb_index_of(g, 10, false));
+        }
+
+        gb_free(g);
+    });
+
+    CMC_CREATE_TEST(resize[gap inside], {
+        struct gapbuffer *g = gb_new(1, gb_fval);
+
+        cmc_assert_not_equals(ptr, NULL, g);
+
+        for (size_t i = 0; i < 30; i++)
+            cmc_assert(gb_push_back(g, i));
+
+        cmc_assert(gb_move_gap(g, 10));
+
+        cmc_assert(gb_resize(g, 200));
+        cmc_assert_equals(size_t, 200, gb_capacity(g));
+        cmc_assert_equals(size_t, 10, gb_gap_index(g));
+
+        for (size_t i = 0; i < 30; i++)
+            cmc_assert_equals(size_t, i, gb_get(g, i));
+
+        cmc_assert(gb_shrink_to_fit(g));
+        cmc_assert_equals(size_t, 30, gb_capacity(g));
+        cmc_assert_equals(size_t, 10, gb_gap_index(g));
+
+        for (size_t i = 0; i < 30; i++)
+            cmc_assert_equals(size_t, i, gb_get(g, i));
+
+        cmc_assert(!gb_resize(g, 29));
+        cmc_assert_equals(int32_t, cmc_flags.INVALID, gb_flag(g));
+
+        cmc_assert(gb_reserve(g, 70));
+        cmc_assert_lesser_equals(size_t, gb_capacity(g), 100);
+
+        for (size_t i = 0; i < 30; i++)
+            cmc_assert_equals(size_t, i, gb_get(g, i));
+
+        gb_free(g);
+    });
+
+    CMC_CREATE_TEST(sort, {
+        struct gapbuffer *g = gb_new(1, gb_fval);
+
+        cmc_assert_not_equals(ptr, NULL, g);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(gb_push_back(g, (i * 37) % 100));
+
+        cmc_assert(gb_move_gap(g, 50));
+
+        // The gap is outside of the range and it is not moved
+        cmc_assert(gb_sort_range(g, 60, 99));
+        cmc_assert_equals(size_t, 50, gb_gap_index(g));
+
+        for (size_t i = 61; i < 100; i++)
+            cmc_assert(gb_get(g, i - 1) <= gb_get(g, i));
+
+        cmc_assert(gb_sort_range(g, 10, 59));
+
+        for (size_t i = 11; i < 60; i++)
+            cmc_assert(gb_get(g, i - 1) <= gb_get(g, i));
+
+        gb_sort(g);
+
+        cmc_assert_equals(size_t, 100, gb_gap_index(g));
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert_equals(size_t, i, gb_get(g, i));
+
+        gb_free(g);
+    });
+
+    CMC_CREATE_TEST(copy_of equals, {
+        struct gapbuffer *g = gb_new(1, gb_fval);
+
+        cmc_assert_not_equals(ptr, NULL, g);
+
+        for (size_t i = 0; i < 50; i++)
+            cmc_assert(gb_push_back(g, i));
+
+        cmc_assert(gb_move_gap(g, 20));
+
+        struct gapbuffer *c = gb_copy_of(g);
+
+        cmc_assert_not_equals(ptr, NULL, c);
+        cmc_assert_equals(size_t, 20, gb_gap_index(c));
+        cmc_assert(gb_equals(g, c));
+
+        // Equality does not depend on where the gaps are
+        cmc_assert(gb_move_gap(c, 45));
+        cmc_assert(gb_equals(g, c));
+
+        cmc_assert(gb_pop_at(c, 3));
+        cmc_assert(!gb_equals(g, c));
+
+        gb_free(c);
+        gb_free(g);
+    });
+
+    CMC_CREATE_TEST(copy_of[counter], {
+        v_total_cpy = 0;
+        v_total_free = 0;
+
+        struct gapbuffer *g = gb_new(1, gb_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, g);
+
+        for (size_t i = 0; i < 50; i++)
+            cmc_assert(gb_push_back(g, i));
+
+        cmc_assert(gb_move_gap(g, 20));
+
+        struct gapbuffer *c = gb_copy_of(g);
+
+        cmc_assert_not_equals(ptr, NULL, c);
+        cmc_assert_equals(int32_t, 50, v_total_cpy);
+
+        for (size_t i = 0; i < 50; i++)
+            cmc_assert_equals(size_t, i, gb_get(c, i));
+
+        gb_free(c);
+        gb_free(g);
+
+        cmc_assert_equals(int32_t, 100, v_total_free);
+
+        v_total_cpy = 0;
+        v_total_free = 0;
+    });
+
+    CMC_CREATE_TEST(random edits, {
+        struct gapbuffer *g = gb_new(1, gb_fval);
+
+        cmc_assert_not_equals(ptr, NULL, g);
+
+        // The same edits are done to a plain array
+        size_t array[500];
+        size_t count = 0;
+        size_t cursor = 0;
+        size_t seed = 7;
+
+        for (size_t i = 0; i < 2000; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+
+            size_t r = (seed >> 16) % 100;
+
+            if (r < 10)
+                cursor = count == 0 ? 0 : (seed >> 8) % (count + 1);
+
+            if (r < 60 && count < 500)
+            {
+                memmove(array + cursor + 1, array + cursor,
+                        (count - cursor) * sizeof(size_t));
+                array[cursor] = i;
+                count++;
+
+                cmc_assert(gb_push_at(g, i, cursor));
+
+                cursor++;
+            }
+            else if (count > 0)
+            {
+                // Either a backspace or a delete at the cursor
+                size_t index = cursor;
+
+                if (cursor == count || (cursor > 0 && r % 2 == 0))
+                    index = cursor - 1;
+
+                memmove(array + index, array + index + 1,
+                        (count - index - 1) * sizeof(size_t));
+                count--;
+
+                cmc_assert(gb_pop_at(g, index));
+
+                cursor = index;
+            }
+        }
+
+        cmc_assert_equals(size_t, count, gb_count(g));
+
+        for (size_t i = 0; i < count; i++)
+            cmc_assert_equals(size_t, array[i], gb_get(g, i));
+
+        gb_free(g);
+    });
+});
+
+CMC_CREATE_UNIT(GapBufferIter, true, {
+    CMC_CREATE_TEST(PFX##_iter_next(), {
+        struct gapbuffer *g = gb_new(1, gb_fval);
+
+        cmc_assert_not_equals(ptr, NULL, g);
+
+        struct gapbuffer_iter it = gb_iter_start(g);
+
+        cmc_assert(!gb_iter_next(&it));
+
+        for (size_t i = 1; i <= 1000; i++)
+        {
+            if (i % 2 == 0)
+                gb_push_back(g, i);
+            else
+                gb_push_front(g, i);
+        }
+
+        cmc_assert(gb_move_gap(g, 333));
+
+        size_t sum = 0;
+        for (it = gb_iter_start(g); !gb_iter_at_end(&it); gb_iter_next(&it))
+        {
+            sum += gb_iter_value(&it);
+        }
+
+        cmc_assert_equals(size_t, 500500, sum);
+
+        gb_free(g);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_prev(), {
+        struct gapbuffer *g = gb_new(1, gb_fval);
+
+        cmc_assert_not_equals(ptr, NULL, g);
+
+        for (size_t i = 1; i <= 5; i++)
+            gb_push_back(g, i);
+
+        cmc_assert(gb_move_gap(g, 2));
+
+        size_t sum = 0;
+        struct gapbuffer_iter it = gb_iter_end(g);
+
+        do
+        {
+            sum += *gb_iter_rvalue(&it);
+        } while (gb_iter_prev(&it));
+
+        cmc_assert_equals(size_t, 15, sum);
+        cmc_assert(gb_iter_at_start(&it));
+
+        gb_free(g);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_go_to(), {
+        struct gapbuffer *g = gb_new(1, gb_fval);
+
+        cmc_assert_not_equals(ptr, NULL, g);
+
+        for (size_t i = 0; i < 100; i++)
+            gb_push_back(g, i);
+
+        cmc_assert(gb_move_gap(g, 30));
+
+        struct gapbuffer_iter it = gb_iter_start(g);
+
+        cmc_assert(gb_iter_go_to(&it, 50));
+        cmc_assert_equals(size_t, 50, gb_iter_index(&it));
+        cmc_assert_equals(size_t, 50, gb_iter_value(&it));
+
+        cmc_assert(gb_iter_go_to(&it, 7));
+        cmc_assert_equals(size_t, 7, gb_iter_value(&it));
+
+        cmc_assert(!gb_iter_go_to(&it, 100));
+
+        gb_free(g);
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = GapBuffer() + GapBufferIter();
+
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | GapBuffer Suit : %-44s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
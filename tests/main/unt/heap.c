@@ -4,6 +4,8 @@
 
 #include "../src/heap.c"
 
+CMC_GENERATE_HEAP_DARY(h4, heap4, size_t, 4)
+
 struct heap_fval *h_fval = &(struct heap_fval){ .cmp = cmc_size_cmp,
                                                 .cpy = NULL,
                                                 .str = cmc_size_str,
@@ -11,6 +13,37 @@ struct heap_fval *h_fval = &(struct heap_fval){ .cmp = cmc_size_cmp,
                                                 .hash = cmc_size_hash,
                                                 .pri = cmc_size_cmp };
 
+struct heap4_fval *h4_fval = &(struct heap4_fval){ .cmp = cmc_size_cmp,
+                                                   .cpy = NULL,
+                                                   .str = cmc_size_str,
+                                                   .free = NULL,
+                                                   .hash = cmc_size_hash,
+                                                   .pri = cmc_size_cmp };
+
+/* Checks if no element of a heap goes before its parent */
+bool h_valid(struct heap *h)
+{
+    for (size_t i = 1; i < h->count; i++)
+    {
+        if (cmc_size_cmp(h->buffer[i], h->buffer[(i - 1) / 2]) * h->HO > 0)
+            return false;
+    }
+
+    return true;
+}
+
+/* Checks if no element of a 4-ary heap goes before its parent */
+bool h4_valid(struct heap4 *h)
+{
+    for (size_t i = 1; i < h->count; i++)
+    {
+        if (cmc_size_cmp(h->buffer[i], h->buffer[(i - 1) / 4]) * h->HO > 0)
+            return false;
+    }
+
+    return true;
+}
+
 CMC_CREATE_UNIT(Heap, true, {
     CMC_CREATE_TEST(new, {
         struct heap *h = h_new(1000000, cmc_max_heap, h_fval);
@@ -140,6 +173,31 @@ CMC_CREATE_UNIT(Heap, true, {
         h_free(h);
     });
 
+    CMC_CREATE_TEST(remove[sorted arity = 4], {
+        struct heap4 *h = h4_new(100, cmc_max_heap, h4_fval);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        // Inserts 0 to 1000 in a scrambled order
+        for (size_t i = 0; i < 1001; i++)
+            cmc_assert(h4_insert(h, (i * 7919) % 1001));
+
+        cmc_assert(h4_valid(h));
+
+        for (size_t i = 1001; i > 0; i--)
+        {
+            cmc_assert_equals(size_t, i - 1, h4_peek(h));
+            cmc_assert(h4_remove(h));
+
+            if (i % 100 == 0)
+                cmc_assert(h4_valid(h));
+        }
+
+        cmc_assert(h4_empty(h));
+
+        h4_free(h);
+    });
+
     CMC_CREATE_TEST(peek, {
         struct heap *h = h_new(100, cmc_max_heap, h_fval);
 
@@ -289,6 +347,147 @@ CMC_CREATE_UNIT(Heap, true, {
         total_delete = 0;
         total_resize = 0;
     });
+
+    CMC_CREATE_TEST(reserve shrink_to_fit, {
+        struct heap *x = h_new(1, cmc_max_heap, h_fval);
+
+        cmc_assert_not_equals(ptr, NULL, x);
+
+        for (size_t i = 0; i < 10; i++)
+            cmc_assert(h_insert(x, i));
+
+        cmc_assert(h_reserve(x, 90));
+        cmc_assert_lesser_equals(size_t, h_capacity(x), 100);
+
+        cmc_assert(h_shrink_to_fit(x));
+        cmc_assert_equals(size_t, 10, h_count(x));
+        cmc_assert_equals(size_t, 10, h_capacity(x));
+        cmc_assert_equals(size_t, 9, h_peek(x));
+
+        h_free(x);
+    });
+
+    CMC_CREATE_TEST(from_array, {
+        size_t values[1001];
+
+        // 0 to 1000 in a scrambled order
+        for (size_t i = 0; i < 1001; i++)
+            values[i] = (i * 7919) % 1001;
+
+        struct heap *h = h_from_array(values, 1001, cmc_min_heap, h_fval);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+        cmc_assert_equals(size_t, 1001, h_count(h));
+        cmc_assert(h_valid(h));
+
+        for (size_t i = 0; i < 1001; i++)
+        {
+            cmc_assert_equals(size_t, i, h_peek(h));
+            cmc_assert(h_remove(h));
+        }
+
+        h_free(h);
+
+        h = h_from_array(NULL, 0, cmc_max_heap, h_fval);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+        cmc_assert(h_empty(h));
+        cmc_assert(h_insert(h, 1));
+        cmc_assert_equals(size_t, 1, h_peek(h));
+
+        h_free(h);
+    });
+
+    CMC_CREATE_TEST(insert_many, {
+        struct heap *h = h_new_custom(1, cmc_max_heap, h_fval, NULL, callbacks);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        size_t values[1000];
+
+        for (size_t i = 0; i < 1000; i++)
+            values[i] = (i * 7919) % 1000;
+
+        total_create = 0;
+
+        // Builds the heap from scratch and then inserts one by one
+        cmc_assert(h_insert_many(h, values, 0));
+        cmc_assert(h_insert_many(h, values, 900));
+        cmc_assert(h_valid(h));
+        cmc_assert(h_insert_many(h, values + 900, 100));
+        cmc_assert(h_valid(h));
+        cmc_assert_equals(size_t, 1000, h_count(h));
+        cmc_assert_equals(int32_t, 2, total_create);
+
+        for (size_t i = 1000; i > 0; i--)
+        {
+            cmc_assert_equals(size_t, i - 1, h_peek(h));
+            cmc_assert(h_remove(h));
+        }
+
+        h_free(h);
+
+        total_create = 0;
+        total_delete = 0;
+    });
+
+    CMC_CREATE_TEST(heap_sort, {
+        struct heap *h = h_new(100, cmc_max_heap, h_fval);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        h_heap_sort(h);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(h_insert(h, (i * 37) % 100));
+
+        h_heap_sort(h);
+
+        // The buffer goes from the top of the heap to the bottom
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert_equals(size_t, 99 - i, h->buffer[i]);
+
+        cmc_assert(h_valid(h));
+        cmc_assert_equals(size_t, 100, h_count(h));
+        cmc_assert(h_insert(h, 50));
+        cmc_assert(h_remove(h));
+        cmc_assert_equals(size_t, 98, h_peek(h));
+
+        h_free(h);
+    });
+
+    CMC_CREATE_TEST(drain_sorted, {
+        struct heap *h =
+            h_new_custom(100, cmc_min_heap, h_fval, NULL, callbacks);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        size_t out[100];
+
+        total_delete = 0;
+
+        cmc_assert_equals(size_t, 0, h_drain_sorted(h, out));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, h_flag(h));
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(h_insert(h, (i * 37) % 100));
+
+        total_update = 0;
+
+        cmc_assert_equals(size_t, 100, h_drain_sorted(h, out));
+        cmc_assert_array_sorted_any(size_t, out, cmc_size_cmp, 0, 99);
+        cmc_assert_equals(size_t, 0, out[0]);
+        cmc_assert(h_empty(h));
+        cmc_assert_equals(int32_t, cmc_flags.OK, h_flag(h));
+        cmc_assert_equals(int32_t, 0, total_update);
+        cmc_assert_equals(int32_t, 1, total_delete);
+
+        h_free(h);
+
+        total_create = 0;
+        total_update = 0;
+        total_delete = 0;
+    });
 });
 
 CMC_CREATE_UNIT(HeapIter, true, {
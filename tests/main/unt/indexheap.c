@@ -0,0 +1,464 @@
+#include "utl.c"
+#include "utl/assert.h"
+#include "utl/test.h"
+
+#include "../src/indexheap.c"
+
+struct indexheap_fval *ixh_fval =
+    &(struct indexheap_fval){ .cmp = cmc_size_cmp,
+                              .cpy = NULL,
+                              .str = cmc_size_str,
+                              .free = NULL,
+                              .hash = cmc_size_hash,
+                              .pri = cmc_size_cmp };
+
+struct indexheap_fval *ixh_fval_counter =
+    &(struct indexheap_fval){ .cmp = v_c_cmp,
+                              .cpy = v_c_cpy,
+                              .str = v_c_str,
+                              .free = v_c_free,
+                              .hash = v_c_hash,
+                              .pri = v_c_pri };
+
+/* Amount of allocations that succeed before ixh_failing_malloc fails */
+size_t ixh_mallocs_left = 0;
+
+void *ixh_failing_malloc(size_t size)
+{
+    if (ixh_mallocs_left == 0)
+        return NULL;
+
+    ixh_mallocs_left--;
+
+    return malloc(size);
+}
+
+struct cmc_alloc_node *ixh_failing_alloc =
+    &(struct cmc_alloc_node){ .malloc = ixh_failing_malloc,
+                              .calloc = calloc,
+                              .realloc = realloc,
+                              .free = free };
+
+/* Checks the heap property and that every handle is at its position */
+bool ixh_valid(struct indexheap *h)
+{
+    for (size_t i = 0; i < h->capacity; i++)
+    {
+        if (h->positions[h->handles[i]] != i)
+            return false;
+    }
+
+    for (size_t i = 1; i < h->count; i++)
+    {
+        size_t value = h->values[h->handles[i]];
+        size_t parent = h->values[h->handles[(i - 1) / 2]];
+
+        if (cmc_size_cmp(value, parent) * h->HO > 0)
+            return false;
+    }
+
+    return true;
+}
+
+/* Edges of a small directed graph as { from, to, weight } */
+#define IXH_NODES 6
+#define IXH_EDGES 9
+
+size_t ixh_edges[IXH_EDGES][3] = { { 0, 1, 7 },  { 0, 2, 9 },  { 0, 5, 14 },
+                                   { 1, 2, 10 }, { 1, 3, 15 }, { 2, 3, 11 },
+                                   { 2, 5, 2 },  { 3, 4, 6 },  { 5, 4, 9 } };
+
+/* Dijkstra's algorithm from node 0, where the handle of each node is the */
+/* node itself */
+bool ixh_dijkstra(size_t *dist)
+{
+    struct indexheap *h = ixh_new(IXH_NODES, cmc_min_heap, ixh_fval);
+
+    if (!h)
+        return false;
+
+    for (size_t i = 0; i < IXH_NODES; i++)
+    {
+        size_t handle;
+
+        if (!ixh_insert(h, i == 0 ? 0 : SIZE_MAX, &handle) || handle != i)
+            return false;
+    }
+
+    while (!ixh_empty(h))
+    {
+        size_t u = ixh_peek_handle(h);
+
+        dist[u] = ixh_peek(h);
+
+        ixh_remove(h);
+
+        for (size_t i = 0; i < IXH_EDGES; i++)
+        {
+            size_t v = ixh_edges[i][1];
+
+            if (ixh_edges[i][0] != u || !ixh_contains(h, v))
+                continue;
+
+            if (dist[u] + ixh_edges[i][2] < ixh_get(h, v))
+                ixh_update(h, v, dist[u] + ixh_edges[i][2]);
+        }
+    }
+
+    ixh_free(h);
+
+    return true;
+}
+
+CMC_CREATE_UNIT(IndexHeap, true, {
+    CMC_CREATE_TEST(new, {
+        struct indexheap *h = ixh_new(1000, cmc_min_heap, ixh_fval);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+        cmc_assert_equals(size_t, 1000, ixh_capacity(h));
+        cmc_assert_equals(size_t, 0, ixh_count(h));
+        cmc_assert(ixh_valid(h));
+
+        ixh_free(h);
+    });
+
+    CMC_CREATE_TEST(new[capacity = 0], {
+        struct indexheap *h = ixh_new(0, cmc_min_heap, ixh_fval);
+
+        cmc_assert_equals(ptr, NULL, h);
+    });
+
+    CMC_CREATE_TEST(new[capacity = UINT64_MAX], {
+        struct indexheap *h = ixh_new(UINT64_MAX, cmc_min_heap, ixh_fval);
+
+        cmc_assert_equals(ptr, NULL, h);
+    });
+
+    CMC_CREATE_TEST(new[f_val = NULL], {
+        struct indexheap *h = ixh_new(1000, cmc_min_heap, NULL);
+
+        cmc_assert_equals(ptr, NULL, h);
+    });
+
+    CMC_CREATE_TEST(insert remove[sorted], {
+        struct indexheap *h = ixh_new(1, cmc_max_heap, ixh_fval);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        size_t handle;
+
+        // Inserts 0 to 1000 in a scrambled order
+        for (size_t i = 0; i < 1001; i++)
+        {
+            cmc_assert(ixh_insert(h, (i * 7919) % 1001, &handle));
+            cmc_assert_equals(size_t, i, handle);
+        }
+
+        cmc_assert(ixh_valid(h));
+
+        for (size_t i = 1001; i > 0; i--)
+        {
+            handle = ixh_peek_handle(h);
+
+            cmc_assert_equals(size_t, i - 1, ixh_peek(h));
+            cmc_assert_equals(size_t, i - 1, ixh_get(h, handle));
+            cmc_assert(ixh_remove(h));
+            cmc_assert(!ixh_contains(h, handle));
+        }
+
+        cmc_assert(ixh_empty(h));
+        cmc_assert(!ixh_remove(h));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, ixh_flag(h));
+        cmc_assert(ixh_valid(h));
+
+        ixh_free(h);
+    });
+
+    CMC_CREATE_TEST(update, {
+        struct indexheap *h = ixh_new(100, cmc_min_heap, ixh_fval);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        size_t handles[100];
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(ixh_insert(h, i * 10, &handles[i]));
+
+        // Decreases a value to the top and increases the top to the bottom
+        cmc_assert(ixh_update(h, handles[50], 5));
+        cmc_assert_equals(size_t, 0, ixh_peek(h));
+        cmc_assert(ixh_update(h, handles[0], 5000));
+        cmc_assert_equals(size_t, 5, ixh_peek(h));
+        cmc_assert_equals(size_t, handles[50], ixh_peek_handle(h));
+        cmc_assert(ixh_valid(h));
+
+        // Every handle still points to its value
+        for (size_t i = 1; i < 100; i++)
+        {
+            if (i != 50)
+                cmc_assert_equals(size_t, i * 10, ixh_get(h, handles[i]));
+        }
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(
+                ixh_update(h, handles[(i * 37) % 100], (i * 7919) % 1000));
+
+        cmc_assert(ixh_valid(h));
+        cmc_assert_equals(size_t, 100, ixh_count(h));
+
+        cmc_assert(!ixh_update(h, 100, 0));
+        cmc_assert_equals(int32_t, cmc_flags.INVALID, ixh_flag(h));
+
+        ixh_free(h);
+    });
+
+    CMC_CREATE_TEST(remove_handle, {
+        struct indexheap *h = ixh_new(100, cmc_max_heap, ixh_fval);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        size_t handles[100];
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(ixh_insert(h, (i * 37) % 100, &handles[i]));
+
+        // Removes every odd value from anywhere in the heap
+        for (size_t i = 0; i < 100; i++)
+        {
+            if (ixh_get(h, handles[i]) % 2 == 1)
+            {
+                cmc_assert(ixh_remove_handle(h, handles[i]));
+                cmc_assert(!ixh_contains(h, handles[i]));
+                cmc_assert(ixh_valid(h));
+            }
+        }
+
+        cmc_assert_equals(size_t, 50, ixh_count(h));
+        cmc_assert(!ixh_remove_handle(h, handles[1]));
+        cmc_assert_equals(int32_t, cmc_flags.INVALID, ixh_flag(h));
+        cmc_assert(!ixh_remove_handle(h, 1000));
+
+        for (size_t i = 50; i > 0; i--)
+        {
+            cmc_assert_equals(size_t, (i - 1) * 2, ixh_peek(h));
+            cmc_assert(ixh_remove(h));
+        }
+
+        ixh_free(h);
+    });
+
+    CMC_CREATE_TEST(insert[handle reuse], {
+        struct indexheap *h = ixh_new(10, cmc_min_heap, ixh_fval);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        size_t handle;
+
+        for (size_t i = 0; i < 10; i++)
+            cmc_assert(ixh_insert(h, i, NULL));
+
+        cmc_assert(ixh_remove_handle(h, 3));
+        cmc_assert(ixh_insert(h, 100, &handle));
+        cmc_assert_equals(size_t, 3, handle);
+        cmc_assert_equals(size_t, 100, ixh_get(h, 3));
+        cmc_assert_equals(size_t, 10, ixh_capacity(h));
+
+        // Grows and gives out the new handles
+        cmc_assert(ixh_insert(h, 1000, &handle));
+        cmc_assert_equals(size_t, 10, handle);
+        cmc_assert_greater(size_t, 10, ixh_capacity(h));
+        cmc_assert(ixh_valid(h));
+
+        ixh_free(h);
+    });
+
+    CMC_CREATE_TEST(get contains, {
+        struct indexheap *h = ixh_new(10, cmc_min_heap, ixh_fval);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        size_t handle;
+
+        cmc_assert(!ixh_contains(h, 0));
+        cmc_assert(!ixh_contains(h, 10));
+        cmc_assert_equals(size_t, 0, ixh_get(h, 0));
+        cmc_assert_equals(int32_t, cmc_flags.INVALID, ixh_flag(h));
+        cmc_assert_equals(size_t, 0, ixh_peek_handle(h));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, ixh_flag(h));
+
+        cmc_assert(ixh_insert(h, 42, &handle));
+        cmc_assert(ixh_contains(h, handle));
+        cmc_assert_equals(size_t, 42, ixh_get(h, handle));
+        cmc_assert_equals(int32_t, cmc_flags.OK, ixh_flag(h));
+
+        ixh_free(h);
+    });
+
+    CMC_CREATE_TEST(resize, {
+        struct indexheap *h = ixh_new(100, cmc_min_heap, ixh_fval);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        for (size_t i = 0; i < 20; i++)
+            cmc_assert(ixh_insert(h, 100 - i, NULL));
+
+        cmc_assert(!ixh_resize(h, 10));
+        cmc_assert_equals(int32_t, cmc_flags.INVALID, ixh_flag(h));
+
+        // Handle 15 is still in use
+        cmc_assert(ixh_remove_handle(h, 5));
+        cmc_assert(!ixh_resize(h, 15));
+
+        for (size_t i = 15; i < 20; i++)
+            cmc_assert(ixh_remove_handle(h, i));
+
+        cmc_assert(ixh_resize(h, 15));
+        cmc_assert_equals(size_t, 15, ixh_capacity(h));
+        cmc_assert_equals(size_t, 14, ixh_count(h));
+        cmc_assert(ixh_valid(h));
+
+        // The only handle left to give out is 5
+        size_t handle;
+
+        cmc_assert(ixh_insert(h, 0, &handle));
+        cmc_assert_equals(size_t, 5, handle);
+        cmc_assert(ixh_full(h));
+
+        cmc_assert(ixh_resize(h, 1000));
+        cmc_assert(ixh_valid(h));
+        cmc_assert_equals(size_t, 0, ixh_peek(h));
+
+        ixh_free(h);
+    });
+
+    CMC_CREATE_TEST(resize[alloc failure], {
+        struct indexheap *h = ixh_new(100, cmc_min_heap, ixh_fval);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        for (size_t i = 0; i < 10; i++)
+            cmc_assert(ixh_insert(h, 100 - i, NULL));
+
+        ixh_customize(h, ixh_failing_alloc, NULL);
+
+        // Each of the three arrays in turn fails to be allocated
+        for (size_t i = 0; i < 3; i++)
+        {
+            ixh_mallocs_left = i;
+
+            cmc_assert(!ixh_resize(h, 20));
+            cmc_assert_equals(int32_t, cmc_flags.ALLOC, ixh_flag(h));
+            cmc_assert(!ixh_resize(h, 200));
+            cmc_assert_equals(int32_t, cmc_flags.ALLOC, ixh_flag(h));
+        }
+
+        cmc_assert_equals(size_t, 100, ixh_capacity(h));
+        cmc_assert(ixh_valid(h));
+
+        for (size_t i = 10; i < 100; i++)
+            cmc_assert(ixh_insert(h, 100 - i, NULL));
+
+        cmc_assert(ixh_full(h));
+        cmc_assert(ixh_valid(h));
+        cmc_assert_equals(size_t, 1, ixh_peek(h));
+
+        ixh_free(h);
+    });
+
+    CMC_CREATE_TEST(dijkstra, {
+        size_t dist[IXH_NODES];
+
+        cmc_assert(ixh_dijkstra(dist));
+
+        cmc_assert_equals(size_t, 0, dist[0]);
+        cmc_assert_equals(size_t, 7, dist[1]);
+        cmc_assert_equals(size_t, 9, dist[2]);
+        cmc_assert_equals(size_t, 20, dist[3]);
+        cmc_assert_equals(size_t, 20, dist[4]);
+        cmc_assert_equals(size_t, 11, dist[5]);
+    });
+
+    CMC_CREATE_TEST(free[counter], {
+        struct indexheap *h = ixh_new(100, cmc_min_heap, ixh_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        v_total_free = 0;
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(ixh_insert(h, i, NULL));
+
+        for (size_t i = 0; i < 40; i++)
+            cmc_assert(ixh_remove(h));
+
+        ixh_clear(h);
+
+        cmc_assert_equals(int32_t, 60, v_total_free);
+
+        for (size_t i = 0; i < 10; i++)
+            cmc_assert(ixh_insert(h, i, NULL));
+
+        ixh_free(h);
+
+        cmc_assert_equals(int32_t, 70, v_total_free);
+
+        v_total_free = 0;
+    });
+
+    CMC_CREATE_TEST(callbacks, {
+        struct indexheap *h =
+            ixh_new_custom(1, cmc_min_heap, ixh_fval, NULL, callbacks);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        size_t handle;
+
+        total_create = 0;
+        total_read = 0;
+        total_update = 0;
+        total_delete = 0;
+        total_resize = 0;
+
+        cmc_assert(ixh_insert(h, 10, &handle));
+        cmc_assert(ixh_insert(h, 20, NULL));
+        cmc_assert_equals(int32_t, 2, total_create);
+        cmc_assert_equals(int32_t, 1, total_resize);
+
+        cmc_assert_equals(size_t, 10, ixh_peek(h));
+        cmc_assert_equals(size_t, handle, ixh_peek_handle(h));
+        cmc_assert_equals(size_t, 10, ixh_get(h, handle));
+        cmc_assert_equals(int32_t, 3, total_read);
+
+        cmc_assert(ixh_update(h, handle, 30));
+        cmc_assert_equals(int32_t, 1, total_update);
+
+        cmc_assert(ixh_remove_handle(h, handle));
+        cmc_assert(ixh_remove(h));
+        cmc_assert_equals(int32_t, 2, total_delete);
+
+        ixh_free(h);
+
+        total_create = 0;
+        total_read = 0;
+        total_update = 0;
+        total_delete = 0;
+        total_resize = 0;
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = IndexHeap();
+
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | IndexHeap Suit : %-44s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
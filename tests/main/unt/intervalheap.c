@@ -4,6 +4,8 @@
 
 #include "../src/intervalheap.c"
 
+CMC_GENERATE_INTERVALHEAP_DARY(ih4, intervalheap4, size_t, 4)
+
 struct intervalheap_fval *ih_fval =
     &(struct intervalheap_fval){ .cmp = cmc_size_cmp,
                                  .cpy = NULL,
@@ -24,6 +26,14 @@ struct cmc_alloc_node *ih_alloc_node = &(struct cmc_alloc_node){
     .malloc = malloc, .calloc = calloc, .realloc = realloc, .free = free
 };
 
+struct intervalheap4_fval *ih4_fval =
+    &(struct intervalheap4_fval){ .cmp = cmc_size_cmp,
+                                  .cpy = NULL,
+                                  .str = cmc_size_str,
+                                  .free = NULL,
+                                  .hash = cmc_size_hash,
+                                  .pri = cmc_size_cmp };
+
 CMC_CREATE_UNIT(IntervalHeap, true, {
     CMC_CREATE_TEST(PFX##_new(), {
         struct intervalheap *ih = ih_new(1000000, ih_fval);
@@ -416,6 +426,245 @@ CMC_CREATE_UNIT(IntervalHeap, true, {
         ih_free(ih);
     });
 
+    CMC_CREATE_TEST(remove_max remove_min[arity = 4], {
+        struct intervalheap4 *ih = ih4_new(100, ih4_fval);
+
+        cmc_assert_not_equals(ptr, NULL, ih);
+
+        // Inserts 0 to 1000 in a scrambled order
+        for (size_t i = 0; i < 1001; i++)
+            cmc_assert(ih4_insert(ih, (i * 7919) % 1001));
+
+        cmc_assert_equals(size_t, 1001, ih4_count(ih));
+
+        for (size_t i = 0; i < 500; i++)
+        {
+            cmc_assert_equals(size_t, i, ih4_min(ih));
+            cmc_assert_equals(size_t, 1000 - i, ih4_max(ih));
+            cmc_assert(ih4_remove_min(ih));
+            cmc_assert(ih4_remove_max(ih));
+        }
+
+        cmc_assert_equals(size_t, 1, ih4_count(ih));
+        cmc_assert_equals(size_t, 500, ih4_min(ih));
+        cmc_assert_equals(size_t, 500, ih4_max(ih));
+
+        ih4_free(ih);
+    });
+
+    CMC_CREATE_TEST(from_array, {
+        size_t values[1001];
+
+        // 0 to 1000 in a scrambled order
+        for (size_t i = 0; i < 1001; i++)
+            values[i] = (i * 7919) % 1001;
+
+        struct intervalheap *ih = ih_from_array(values, 1001, ih_fval);
+
+        cmc_assert_not_equals(ptr, NULL, ih);
+        cmc_assert_equals(size_t, 1001, ih_count(ih));
+
+        for (size_t i = 0; i < 500; i++)
+        {
+            cmc_assert_equals(size_t, i, ih_min(ih));
+            cmc_assert_equals(size_t, 1000 - i, ih_max(ih));
+            cmc_assert(ih_remove_min(ih));
+            cmc_assert(ih_remove_max(ih));
+        }
+
+        cmc_assert_equals(size_t, 500, ih_min(ih));
+        cmc_assert_equals(size_t, 500, ih_max(ih));
+
+        ih_free(ih);
+
+        ih = ih_from_array(NULL, 0, ih_fval);
+
+        cmc_assert_not_equals(ptr, NULL, ih);
+        cmc_assert(ih_empty(ih));
+
+        ih_free(ih);
+    });
+
+    CMC_CREATE_TEST(insert_many, {
+        struct intervalheap4 *ih = ih4_new(1, ih4_fval);
+
+        cmc_assert_not_equals(ptr, NULL, ih);
+
+        size_t values[1000];
+
+        for (size_t i = 0; i < 1000; i++)
+            values[i] = (i * 7919) % 1000;
+
+        // Builds the heap from scratch and then inserts one by one
+        cmc_assert(ih4_insert_many(ih, values, 0));
+        cmc_assert(ih4_insert_many(ih, values, 901));
+        cmc_assert(ih4_insert_many(ih, values + 901, 99));
+        cmc_assert_equals(size_t, 1000, ih4_count(ih));
+
+        for (size_t i = 0; i < 500; i++)
+        {
+            cmc_assert_equals(size_t, i, ih4_min(ih));
+            cmc_assert_equals(size_t, 999 - i, ih4_max(ih));
+            cmc_assert(ih4_remove_min(ih));
+            cmc_assert(ih4_remove_max(ih));
+        }
+
+        cmc_assert(ih4_empty(ih));
+
+        ih4_free(ih);
+    });
+
+    CMC_CREATE_TEST(new_bounded, {
+        struct intervalheap *ih = ih_new_bounded(100, ih_fval);
+
+        cmc_assert_not_equals(ptr, NULL, ih);
+
+        size_t value = 100;
+
+        cmc_assert_equals(size_t, 100, ih->bound);
+        cmc_assert_equals(size_t, 50, ih_capacity(ih));
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(ih_insert(ih, i));
+
+        // Past the bound only offer_max and offer_min can add values
+        cmc_assert(!ih_insert(ih, 100));
+        cmc_assert_equals(int32_t, cmc_flags.INVALID, ih_flag(ih));
+        cmc_assert(!ih_insert_many(ih, &value, 1));
+        cmc_assert_equals(int32_t, cmc_flags.INVALID, ih_flag(ih));
+        cmc_assert_equals(size_t, 100, ih_count(ih));
+        cmc_assert_equals(size_t, 50, ih_capacity(ih));
+
+        ih_free(ih);
+    });
+
+    CMC_CREATE_TEST(offer_max, {
+        struct intervalheap *ih = ih_new_bounded(100, ih_fval);
+
+        cmc_assert_not_equals(ptr, NULL, ih);
+
+        size_t out[100];
+
+        // Keeps the greatest 100 values out of 0 to 999 in a scrambled order
+        for (size_t i = 0; i < 1000; i++)
+            ih_offer_max(ih, (i * 7919) % 1000);
+
+        cmc_assert_equals(size_t, 100, ih_count(ih));
+        cmc_assert_equals(size_t, 900, ih_min(ih));
+        cmc_assert_equals(size_t, 999, ih_max(ih));
+
+        // Values that are not greater than the minimum are rejected
+        cmc_assert(!ih_offer_max(ih, 900));
+        cmc_assert_equals(int32_t, cmc_flags.OK, ih_flag(ih));
+        cmc_assert(ih_offer_max(ih, 1000));
+        cmc_assert_equals(size_t, 901, ih_min(ih));
+        cmc_assert_equals(size_t, 1000, ih_max(ih));
+
+        cmc_assert_equals(size_t, 100, ih_drain_sorted(ih, out));
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert_equals(size_t, i + 901, out[i]);
+
+        cmc_assert(ih_empty(ih));
+
+        ih_free(ih);
+    });
+
+    CMC_CREATE_TEST(offer_min, {
+        struct intervalheap4 *ih = ih4_new_bounded(101, ih4_fval);
+
+        cmc_assert_not_equals(ptr, NULL, ih);
+
+        size_t out[101];
+
+        // Keeps the smallest 101 values out of 0 to 999 in a scrambled order
+        for (size_t i = 0; i < 1000; i++)
+            ih4_offer_min(ih, (i * 7919) % 1000);
+
+        cmc_assert_equals(size_t, 101, ih4_count(ih));
+        cmc_assert_equals(size_t, 0, ih4_min(ih));
+        cmc_assert_equals(size_t, 100, ih4_max(ih));
+
+        cmc_assert(!ih4_offer_min(ih, 100));
+        cmc_assert(ih4_offer_min(ih, 50));
+        cmc_assert_equals(size_t, 99, ih4_max(ih));
+
+        cmc_assert_equals(size_t, 101, ih4_drain_sorted(ih, out));
+
+        for (size_t i = 0; i < 101; i++)
+            cmc_assert_equals(size_t, i <= 50 ? i : i - 1, out[i]);
+
+        ih4_free(ih);
+    });
+
+    CMC_CREATE_TEST(offer_min[bound = 1], {
+        struct intervalheap *ih = ih_new_bounded(1, ih_fval);
+
+        cmc_assert_not_equals(ptr, NULL, ih);
+
+        cmc_assert(ih_offer_min(ih, 10));
+        cmc_assert(!ih_offer_min(ih, 20));
+        cmc_assert(ih_offer_min(ih, 5));
+        cmc_assert_equals(size_t, 5, ih_min(ih));
+        cmc_assert_equals(size_t, 5, ih_max(ih));
+        cmc_assert(!ih_offer_max(ih, 5));
+        cmc_assert(ih_offer_max(ih, 7));
+        cmc_assert_equals(size_t, 1, ih_count(ih));
+        cmc_assert_equals(size_t, 7, ih_min(ih));
+
+        ih_free(ih);
+    });
+
+    CMC_CREATE_TEST(offer_max[unbounded], {
+        struct intervalheap *ih = ih_new(1, ih_fval);
+
+        cmc_assert_not_equals(ptr, NULL, ih);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(ih_offer_max(ih, i));
+
+        cmc_assert_equals(size_t, 100, ih_count(ih));
+        cmc_assert_equals(size_t, 0, ih_min(ih));
+
+        ih_free(ih);
+    });
+
+    CMC_CREATE_TEST(drain_sorted, {
+        struct intervalheap *ih = ih_new_custom(1, ih_fval, NULL, callbacks);
+
+        cmc_assert_not_equals(ptr, NULL, ih);
+
+        size_t out[1001];
+
+        cmc_assert_equals(size_t, 0, ih_drain_sorted(ih, out));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, ih_flag(ih));
+
+        for (size_t i = 0; i < 1001; i++)
+            cmc_assert(ih_insert(ih, (i * 7919) % 1001));
+
+        total_delete = 0;
+
+        cmc_assert_equals(size_t, 1001, ih_drain_sorted(ih, out));
+        cmc_assert_equals(int32_t, cmc_flags.OK, ih_flag(ih));
+        cmc_assert_equals(int32_t, 1, total_delete);
+        cmc_assert(ih_empty(ih));
+
+        for (size_t i = 0; i < 1001; i++)
+            cmc_assert_equals(size_t, i, out[i]);
+
+        // The heap can be used again
+        cmc_assert(ih_insert(ih, 3));
+        cmc_assert(ih_insert(ih, 1));
+        cmc_assert_equals(size_t, 2, ih_drain_sorted(ih, out));
+        cmc_assert_equals(size_t, 1, out[0]);
+        cmc_assert_equals(size_t, 3, out[1]);
+
+        ih_free(ih);
+
+        total_create = 0;
+        total_delete = 0;
+    });
+
     CMC_CREATE_TEST(buffer_growth[capacity = 1], {
         struct intervalheap *ih = ih_new(1, ih_fval);
 
@@ -611,6 +860,26 @@ CMC_CREATE_UNIT(IntervalHeap, true, {
         total_delete = 0;
         total_resize = 0;
     });
+
+    CMC_CREATE_TEST(reserve shrink_to_fit, {
+        struct intervalheap *x = ih_new(1, ih_fval);
+
+        cmc_assert_not_equals(ptr, NULL, x);
+
+        for (size_t i = 0; i < 10; i++)
+            cmc_assert(ih_insert(x, i));
+
+        cmc_assert(ih_reserve(x, 90));
+        cmc_assert_lesser_equals(size_t, ih_capacity(x) * 2, 100);
+
+        cmc_assert(ih_shrink_to_fit(x));
+        cmc_assert_equals(size_t, 10, ih_count(x));
+        cmc_assert_equals(size_t, 6, ih_capacity(x));
+        cmc_assert_equals(size_t, 0, ih_min(x));
+        cmc_assert_equals(size_t, 9, ih_max(x));
+
+        ih_free(x);
+    });
 });
 
 CMC_CREATE_UNIT(IntervalHeapIter, true, {
@@ -0,0 +1,540 @@
+#include "utl.c"
+#include "utl/assert.h"
+#include "utl/test.h"
+#include "utl/thread.h"
+
+#include "../src/lfstack.c"
+
+struct lfstack_fval *lfs_fval =
+    &(struct lfstack_fval){ .cmp = cmc_size_cmp,
+                            .cpy = NULL,
+                            .str = cmc_size_str,
+                            .free = NULL,
+                            .hash = cmc_size_hash,
+                            .pri = cmc_size_cmp };
+
+struct lfstack_fval *lfs_fval_counter =
+    &(struct lfstack_fval){ .cmp = v_c_cmp,
+                            .cpy = v_c_cpy,
+                            .str = v_c_str,
+                            .free = v_c_free,
+                            .hash = v_c_hash,
+                            .pri = v_c_pri };
+
+/* Amount of elements pushed by each thread */
+const size_t lfs_total = 5000;
+
+/* Amount of threads */
+#define LFS_THREADS 8
+
+struct lfs_worker
+{
+    struct lfstack *stack;
+    size_t id;
+    size_t sum;
+    bool magazine;
+};
+
+/* Adds a value to the size_t pointed by args */
+void lfs_sum(size_t value, void *args)
+{
+    *(size_t *)args += value;
+}
+
+/* Pushes id * lfs_total .. (id + 1) * lfs_total - 1, popping an element */
+/* after every two pushes and adding it to sum */
+int lfs_pusher(void *args)
+{
+    struct lfs_worker *w = args;
+    struct lfstack_magazine mag;
+    size_t value;
+
+    lfs_mag_init(&mag, w->stack);
+
+    for (size_t i = 0; i < lfs_total; i++)
+    {
+        value = w->id * lfs_total + i;
+
+        if (w->magazine)
+        {
+            if (!lfs_mag_push(&mag, value))
+                return 1;
+
+            if (i % 2 == 1 && lfs_mag_pop(&mag, &value))
+                w->sum += value;
+        }
+        else
+        {
+            if (!lfs_push(w->stack, value))
+                return 1;
+
+            if (i % 2 == 1 && lfs_pop(w->stack, &value))
+                w->sum += value;
+        }
+    }
+
+    if (!lfs_mag_flush(&mag))
+        return 1;
+
+    return 0;
+}
+
+/* Pushes the same values as lfs_pusher in batches of 40 to 59 values, */
+/* popping one less than each batch and adding them to sum */
+int lfs_batch_pusher(void *args)
+{
+    struct lfs_worker *w = args;
+    size_t values[60];
+    size_t next = w->id * lfs_total;
+    size_t end = next + lfs_total;
+
+    while (next < end)
+    {
+        size_t n = 40 + next % 20;
+
+        if (n > end - next)
+            n = end - next;
+
+        for (size_t i = 0; i < n; i++)
+            values[i] = next + i;
+
+        if (!lfs_push_n(w->stack, values, n))
+            return 1;
+
+        next += n;
+
+        size_t count = lfs_pop_n(w->stack, values, n - 1);
+
+        for (size_t i = 0; i < count; i++)
+            w->sum += values[i];
+    }
+
+    return 0;
+}
+
+/* Allocates memory that is never zeroed, like a recycled block would be */
+void *lfs_dirty_malloc(size_t size)
+{
+    void *block = malloc(size);
+
+    if (block)
+        memset(block, 0xFF, size);
+
+    return block;
+}
+
+struct cmc_alloc_node *lfs_dirty_alloc =
+    &(struct cmc_alloc_node){ .malloc = lfs_dirty_malloc,
+                              .calloc = calloc,
+                              .realloc = realloc,
+                              .free = free };
+
+/* Amount of allocations that succeed before lfs_failing_malloc fails */
+size_t lfs_mallocs_left = 0;
+
+void *lfs_failing_malloc(size_t size)
+{
+    if (lfs_mallocs_left == 0)
+        return NULL;
+
+    lfs_mallocs_left--;
+
+    return malloc(size);
+}
+
+struct cmc_alloc_node *lfs_failing_alloc =
+    &(struct cmc_alloc_node){ .malloc = lfs_failing_malloc,
+                              .calloc = calloc,
+                              .realloc = realloc,
+                              .free = free };
+
+/* Runs LFS_THREADS workers and returns the sum of every element popped */
+size_t lfs_run(struct lfstack *s, cmc_thread_proc proc, bool magazine)
+{
+    struct cmc_thread threads[LFS_THREADS];
+    struct lfs_worker workers[LFS_THREADS];
+    size_t sum = 0;
+
+    for (size_t i = 0; i < LFS_THREADS; i++)
+    {
+        workers[i] = (struct lfs_worker){ s, i, 0, magazine };
+
+        cmc_thrd_create(&threads[i], proc, &workers[i]);
+    }
+
+    for (size_t i = 0; i < LFS_THREADS; i++)
+    {
+        int result = 1;
+
+        cmc_thrd_join(&threads[i], &result);
+
+        if (result == 0)
+            sum += workers[i].sum;
+    }
+
+    lfs_pop_all(s, lfs_sum, &sum);
+
+    return sum;
+}
+
+CMC_CREATE_UNIT(LFStack, true, {
+    CMC_CREATE_TEST(new, {
+        struct lfstack *s = lfs_new(1000, lfs_fval);
+
+        cmc_assert_not_equals(ptr, NULL, s);
+        cmc_assert_not_equals(ptr, NULL, s->chunks[0]);
+        cmc_assert_equals(ptr, NULL, s->chunks[1]);
+        cmc_assert_equals(size_t, 1024, s->chunk_size);
+        cmc_assert(lfs_empty(s));
+        cmc_assert_equals(int32_t, cmc_flags.OK, lfs_flag(s));
+
+        lfs_free(s);
+    });
+
+    CMC_CREATE_TEST(new[capacity = 0], {
+        struct lfstack *s = lfs_new(0, lfs_fval);
+
+        cmc_assert_equals(ptr, NULL, s);
+    });
+
+    CMC_CREATE_TEST(new[capacity = 1], {
+        struct lfstack *s = lfs_new(1, lfs_fval);
+
+        cmc_assert_not_equals(ptr, NULL, s);
+        cmc_assert_equals(size_t, 16, s->chunk_size);
+
+        lfs_free(s);
+    });
+
+    CMC_CREATE_TEST(new[capacity = UINT64_MAX], {
+        struct lfstack *s = lfs_new(UINT64_MAX, lfs_fval);
+
+        cmc_assert_equals(ptr, NULL, s);
+    });
+
+    CMC_CREATE_TEST(new[f_val = NULL], {
+        struct lfstack *s = lfs_new(1000, NULL);
+
+        cmc_assert_equals(ptr, NULL, s);
+    });
+
+    CMC_CREATE_TEST(clear[reuse], {
+        struct lfstack *s = lfs_new(16, lfs_fval);
+
+        cmc_assert_not_equals(ptr, NULL, s);
+
+        for (size_t i = 0; i < 16; i++)
+            cmc_assert(lfs_push(s, i));
+
+        lfs_clear(s);
+
+        cmc_assert(lfs_empty(s));
+        cmc_assert(!lfs_pop(s, NULL));
+
+        // The nodes are reused instead of taking new ones from the chunks
+        for (size_t i = 0; i < 16; i++)
+            cmc_assert(lfs_push(s, i));
+
+        cmc_assert_equals(size_t, 16, s->nodes);
+        cmc_assert_equals(ptr, NULL, s->chunks[1]);
+
+        lfs_free(s);
+    });
+
+    CMC_CREATE_TEST(push pop, {
+        struct lfstack *s = lfs_new(16, lfs_fval);
+
+        cmc_assert_not_equals(ptr, NULL, s);
+
+        size_t value = 0;
+
+        cmc_assert(!lfs_pop(s, &value));
+
+        // Goes beyond the first chunk
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(lfs_push(s, i));
+
+        cmc_assert_not_equals(ptr, NULL, s->chunks[2]);
+        cmc_assert_equals(ptr, NULL, s->chunks[3]);
+
+        for (size_t i = 100; i > 0; i--)
+        {
+            cmc_assert(lfs_pop(s, &value));
+            cmc_assert_equals(size_t, i - 1, value);
+        }
+
+        cmc_assert(lfs_empty(s));
+        cmc_assert(!lfs_pop(s, &value));
+
+        // Only one node is taken from the chunks, every other one is reused
+        for (size_t i = 0; i < 100; i++)
+        {
+            cmc_assert(lfs_push(s, i));
+            cmc_assert(lfs_push(s, i + 1000));
+            cmc_assert(lfs_pop(s, NULL));
+        }
+
+        cmc_assert_equals(size_t, 101, s->nodes);
+
+        lfs_free(s);
+    });
+
+    CMC_CREATE_TEST(push_n pop_n, {
+        struct lfstack *s = lfs_new(16, lfs_fval);
+
+        cmc_assert_not_equals(ptr, NULL, s);
+
+        size_t values[40];
+        size_t out[40];
+
+        for (size_t i = 0; i < 40; i++)
+            values[i] = i;
+
+        cmc_assert(lfs_push_n(s, values, 0));
+        cmc_assert(lfs_empty(s));
+        cmc_assert_equals(size_t, 0, lfs_pop_n(s, out, 40));
+
+        // Half of the nodes are reused and half are new
+        cmc_assert(lfs_push_n(s, values, 20));
+        cmc_assert_equals(size_t, 20, lfs_pop_n(s, NULL, 20));
+        cmc_assert(lfs_push_n(s, values, 40));
+        cmc_assert_equals(size_t, 40, s->nodes);
+
+        cmc_assert_equals(size_t, 10, lfs_pop_n(s, out, 10));
+
+        for (size_t i = 0; i < 10; i++)
+            cmc_assert_equals(size_t, 39 - i, out[i]);
+
+        cmc_assert_equals(size_t, 30, lfs_pop_n(s, out, 40));
+
+        for (size_t i = 0; i < 30; i++)
+            cmc_assert_equals(size_t, 29 - i, out[i]);
+
+        cmc_assert(lfs_empty(s));
+
+        lfs_free(s);
+    });
+
+    CMC_CREATE_TEST(push_n[alloc failure], {
+        lfs_mallocs_left = 2;
+
+        struct lfstack *s =
+            lfs_new_custom(16, lfs_fval, lfs_failing_alloc, NULL);
+
+        cmc_assert_not_equals(ptr, NULL, s);
+
+        size_t values[20];
+
+        for (size_t i = 0; i < 20; i++)
+            values[i] = i;
+
+        cmc_assert(lfs_push_n(s, values, 16));
+
+        // The second chunk can't be allocated so the nodes taken for it are
+        // given back
+        cmc_assert(!lfs_push_n(s, values, 10));
+        cmc_assert(!lfs_push(s, 16));
+        cmc_assert_equals(size_t, 16, s->nodes);
+        cmc_assert_equals(ptr, NULL, s->chunks[1]);
+
+        // And so are the unused nodes taken before the failure
+        cmc_assert_equals(size_t, 4, lfs_pop_n(s, NULL, 4));
+        cmc_assert(!lfs_push_n(s, values, 10));
+        cmc_assert_equals(size_t, 16, s->nodes);
+
+        cmc_assert(lfs_push_n(s, values, 4));
+        cmc_assert_equals(size_t, 16, s->nodes);
+
+        lfs_mallocs_left = 1;
+
+        cmc_assert(lfs_push_n(s, values, 10));
+        cmc_assert_equals(size_t, 26, s->nodes);
+        cmc_assert_equals(size_t, 26, lfs_pop_n(s, NULL, 40));
+        cmc_assert(lfs_empty(s));
+
+        lfs_free(s);
+    });
+
+    CMC_CREATE_TEST(pop_all, {
+        struct lfstack *s = lfs_new(16, lfs_fval);
+
+        cmc_assert_not_equals(ptr, NULL, s);
+
+        size_t sum = 0;
+
+        cmc_assert_equals(size_t, 0, lfs_pop_all(s, lfs_sum, &sum));
+
+        for (size_t i = 1; i <= 50; i++)
+            cmc_assert(lfs_push(s, i));
+
+        cmc_assert_equals(size_t, 50, lfs_pop_all(s, lfs_sum, &sum));
+        cmc_assert_equals(size_t, 1275, sum);
+        cmc_assert(lfs_empty(s));
+
+        for (size_t i = 0; i < 50; i++)
+            cmc_assert(lfs_push(s, i));
+
+        cmc_assert_equals(size_t, 50, lfs_pop_all(s, NULL, NULL));
+        cmc_assert_equals(size_t, 50, s->nodes);
+
+        lfs_free(s);
+    });
+
+    CMC_CREATE_TEST(magazine, {
+        struct lfstack *s = lfs_new(16, lfs_fval);
+
+        cmc_assert_not_equals(ptr, NULL, s);
+
+        struct lfstack_magazine mag;
+        size_t value;
+
+        lfs_mag_init(&mag, s);
+
+        for (size_t i = 0; i < CMC_LFSTACK_MAGAZINE; i++)
+            cmc_assert(lfs_mag_push(&mag, i));
+
+        // Nothing reaches the stack until the magazine is full
+        cmc_assert(lfs_empty(s));
+        cmc_assert(lfs_mag_push(&mag, 1000));
+        cmc_assert(!lfs_empty(s));
+        cmc_assert_equals(size_t, CMC_LFSTACK_MAGAZINE / 2 + 1, mag.count);
+
+        cmc_assert(lfs_mag_pop(&mag, &value));
+        cmc_assert_equals(size_t, 1000, value);
+
+        cmc_assert(lfs_mag_flush(&mag));
+        cmc_assert_equals(size_t, 0, mag.count);
+
+        size_t sum = 0;
+        size_t count = 0;
+
+        while (lfs_mag_pop(&mag, &value))
+        {
+            sum += value;
+            count++;
+        }
+
+        cmc_assert_equals(size_t, CMC_LFSTACK_MAGAZINE, count);
+        cmc_assert_equals(size_t,
+                          CMC_LFSTACK_MAGAZINE * (CMC_LFSTACK_MAGAZINE - 1) / 2,
+                          sum);
+        cmc_assert(lfs_empty(s));
+
+        lfs_free(s);
+    });
+
+    CMC_CREATE_TEST(free[counter], {
+        struct lfstack *s = lfs_new(16, lfs_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, s);
+
+        v_total_free = 0;
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(lfs_push(s, i));
+
+        cmc_assert_equals(size_t, 40, lfs_pop_n(s, NULL, 40));
+
+        lfs_clear(s);
+
+        cmc_assert_equals(int32_t, 60, v_total_free);
+
+        for (size_t i = 0; i < 10; i++)
+            cmc_assert(lfs_push(s, i));
+
+        lfs_free(s);
+
+        cmc_assert_equals(int32_t, 70, v_total_free);
+
+        v_total_free = 0;
+    });
+
+    CMC_CREATE_TEST(callbacks, {
+        struct lfstack *s = lfs_new_custom(32, lfs_fval, NULL, callbacks);
+
+        cmc_assert_not_equals(ptr, NULL, s);
+
+        size_t values[10] = { 0 };
+
+        total_create = 0;
+        total_delete = 0;
+
+        // Bulk functions call each callback once per batch
+        cmc_assert(lfs_push(s, 1));
+        cmc_assert(lfs_push_n(s, values, 10));
+        cmc_assert(lfs_push(s, 2));
+        cmc_assert_equals(int32_t, 3, total_create);
+
+        cmc_assert(lfs_pop(s, NULL));
+        cmc_assert_equals(size_t, 5, lfs_pop_n(s, values, 5));
+        cmc_assert_equals(size_t, 6, lfs_pop_all(s, NULL, NULL));
+        cmc_assert_equals(int32_t, 3, total_delete);
+
+        lfs_free(s);
+
+        total_create = 0;
+        total_delete = 0;
+    });
+
+    CMC_CREATE_TEST(threads, {
+        struct lfstack *s = lfs_new(16, lfs_fval);
+
+        cmc_assert_not_equals(ptr, NULL, s);
+
+        size_t total = lfs_total * LFS_THREADS;
+
+        cmc_assert_equals(size_t, total * (total - 1) / 2,
+                          lfs_run(s, lfs_pusher, false));
+        cmc_assert(lfs_empty(s));
+
+        lfs_free(s);
+    });
+
+    CMC_CREATE_TEST(threads[magazine], {
+        struct lfstack *s = lfs_new(16, lfs_fval);
+
+        cmc_assert_not_equals(ptr, NULL, s);
+
+        size_t total = lfs_total * LFS_THREADS;
+
+        cmc_assert_equals(size_t, total * (total - 1) / 2,
+                          lfs_run(s, lfs_pusher, true));
+        cmc_assert(lfs_empty(s));
+
+        lfs_free(s);
+    });
+
+    CMC_CREATE_TEST(threads[push_n pop_n], {
+        struct lfstack *s = lfs_new_custom(16, lfs_fval, lfs_dirty_alloc, NULL);
+
+        cmc_assert_not_equals(ptr, NULL, s);
+
+        size_t total = lfs_total * LFS_THREADS;
+
+        for (size_t i = 0; i < 10; i++)
+        {
+            cmc_assert_equals(size_t, total * (total - 1) / 2,
+                              lfs_run(s, lfs_batch_pusher, false));
+            cmc_assert(lfs_empty(s));
+        }
+
+        lfs_free(s);
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = LFStack();
+
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | LFStack Suit : %-46s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
@@ -12,6 +12,28 @@ struct linkedlist_fval *ll_fval =
                                .hash = cmc_size_hash,
                                .pri = cmc_size_cmp };
 
+struct linkedlist_fval *ll_fval_counter =
+    &(struct linkedlist_fval){ .cmp = v_c_cmp,
+                               .cpy = v_c_cpy,
+                               .str = v_c_str,
+                               .free = v_c_free,
+                               .hash = v_c_hash,
+                               .pri = v_c_pri };
+
+size_t ll_total_malloc = 0;
+
+void *ll_counting_malloc(size_t size)
+{
+    ll_total_malloc++;
+    return malloc(size);
+}
+
+struct cmc_alloc_node *ll_counting_alloc =
+    &(struct cmc_alloc_node){ .malloc = ll_counting_malloc,
+                              .calloc = calloc,
+                              .realloc = realloc,
+                              .free = free };
+
 CMC_CREATE_UNIT(LinkedList, true, {
     CMC_CREATE_TEST(new, {
         struct linkedlist *ll = ll_new(ll_fval);
@@ -341,6 +363,149 @@ CMC_CREATE_UNIT(LinkedList, true, {
         total_delete = 0;
         total_resize = 0;
     });
+
+    CMC_CREATE_TEST(set_pool, {
+        struct linkedlist *ll = ll_new_custom(ll_fval, ll_counting_alloc, NULL);
+
+        cmc_assert_not_equals(ptr, NULL, ll);
+
+        cmc_assert(ll_set_pool(ll, 16));
+
+        ll_total_malloc = 0;
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(ll_push_back(ll, i));
+
+        // 100 nodes in chunks of 16
+        cmc_assert_equals(size_t, 7, ll_total_malloc);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(ll_pop_front(ll));
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(ll_push_front(ll, i));
+
+        cmc_assert_equals(size_t, 7, ll_total_malloc);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert_equals(size_t, 99 - i, ll_get(ll, i));
+
+        // The pool can only be changed while the list is empty
+        cmc_assert(!ll_set_pool(ll, 0));
+        cmc_assert_equals(int32_t, cmc_flags.INVALID, ll_flag(ll));
+
+        ll_clear(ll);
+
+        cmc_assert(ll_set_pool(ll, 0));
+        cmc_assert_equals(ptr, NULL, ll->chunks);
+        cmc_assert_equals(ptr, NULL, ll->pool);
+
+        cmc_assert(ll_push_back(ll, 1));
+        cmc_assert_equals(size_t, 8, ll_total_malloc);
+
+        cmc_assert(!ll_set_pool(ll, SIZE_MAX));
+
+        ll_free(ll);
+    });
+
+    CMC_CREATE_TEST(set_pool[node reuse], {
+        struct linkedlist *ll = ll_new(ll_fval);
+
+        cmc_assert_not_equals(ptr, NULL, ll);
+
+        cmc_assert(ll_set_pool(ll, 4));
+
+        for (size_t i = 0; i < 10; i++)
+            cmc_assert(ll_push_back(ll, i));
+
+        struct linkedlist_node *node = ll_get_node(ll, 5);
+
+        cmc_assert_not_equals(ptr, NULL, node);
+
+        // Nodes do not move when others are added or removed
+        for (size_t i = 0; i < 100; i++)
+        {
+            cmc_assert(ll_add_next(ll, node, i));
+            cmc_assert(ll_push_front(ll, i));
+            cmc_assert(ll_pop_front(ll));
+            cmc_assert(ll_del_next(ll, node));
+        }
+
+        cmc_assert_equals(size_t, 5, node->value);
+
+        cmc_assert(ll_del_curr(ll, node));
+
+        // The last removed node is the first to be reused
+        cmc_assert(ll_push_front(ll, 42));
+        cmc_assert_equals(ptr, node, ll_head(ll));
+        cmc_assert_equals(size_t, 42, ll_front(ll));
+
+        ll_free(ll);
+    });
+
+    CMC_CREATE_TEST(set_pool[clear free], {
+        v_total_free = 0;
+
+        struct linkedlist *ll =
+            ll_new_custom(ll_fval_counter, ll_counting_alloc, NULL);
+
+        cmc_assert_not_equals(ptr, NULL, ll);
+
+        cmc_assert(ll_set_pool(ll, 64));
+
+        ll_total_malloc = 0;
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(ll_push_back(ll, i));
+
+        ll_clear(ll);
+
+        cmc_assert_equals(int32_t, 1000, v_total_free);
+        cmc_assert_equals(size_t, 0, ll_count(ll));
+        cmc_assert_equals(ptr, NULL, ll_head(ll));
+        cmc_assert_equals(ptr, NULL, ll_tail(ll));
+
+        // Every node is reused after clear
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(ll_push_back(ll, i));
+
+        cmc_assert_equals(size_t, 16, ll_total_malloc);
+
+        ll_free(ll);
+
+        cmc_assert_equals(int32_t, 2000, v_total_free);
+
+        v_total_free = 0;
+    });
+
+    CMC_CREATE_TEST(set_pool[copy_of], {
+        struct linkedlist *ll = ll_new(ll_fval);
+
+        cmc_assert_not_equals(ptr, NULL, ll);
+
+        cmc_assert(ll_set_pool(ll, 8));
+
+        for (size_t i = 0; i < 50; i++)
+            cmc_assert(ll_push_back(ll, i));
+
+        struct linkedlist *copy = ll_copy_of(ll);
+
+        cmc_assert_not_equals(ptr, NULL, copy);
+        cmc_assert_equals(size_t, 8, copy->chunk_size);
+        cmc_assert(ll_equals(ll, copy));
+
+        ll_free(ll);
+
+        for (size_t i = 0; i < 50; i++)
+            cmc_assert(ll_pop_back(copy));
+
+        for (size_t i = 0; i < 50; i++)
+            cmc_assert(ll_push_back(copy, i));
+
+        cmc_assert_equals(size_t, 49, ll_back(copy));
+
+        ll_free(copy);
+    });
 });
 
 CMC_CREATE_UNIT(LinkedListIter, true, {
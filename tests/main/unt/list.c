@@ -1,6 +1,8 @@
 #include "utl.c"
 #include "utl/assert.h"
+#include "utl/condvar.h"
 #include "utl/test.h"
+#include "utl/thread.h"
 
 #include "../src/list.c"
 
@@ -11,6 +13,66 @@ struct list_fval *l_fval = &(struct list_fval){ .cmp = cmc_size_cmp,
                                                 .hash = cmc_size_hash,
                                                 .pri = cmc_size_cmp };
 
+CMC_GENERATE_LIST_RADIX(rl, radix_list, size_t, uint64_t, cmc_size_key)
+CMC_GENERATE_LIST_RADIX(dl, double_list, double, uint64_t, cmc_double_key)
+
+CMC_GENERATE_LIST_PARALLEL(l, list, size_t)
+CMC_GENERATE_LIST_POD(pl, pod_list, uint32_t)
+
+// Only the upper half of the values is compared
+static inline uint32_t kl_key(size_t value)
+{
+    return (uint32_t)(value >> 32);
+}
+
+static inline int kl_cmp(size_t value1, size_t value2)
+{
+    return cmc_u32_cmp(kl_key(value1), kl_key(value2));
+}
+
+CMC_GENERATE_LIST_RADIX(kl, key_list, size_t, uint32_t, kl_key)
+CMC_GENERATE_LIST_PARALLEL(kl, key_list, size_t)
+
+struct radix_list_fval *rl_fval =
+    &(struct radix_list_fval){ .cmp = cmc_size_cmp,
+                               .cpy = NULL,
+                               .str = cmc_size_str,
+                               .free = NULL,
+                               .hash = cmc_size_hash,
+                               .pri = cmc_size_cmp };
+
+struct double_list_fval *dl_fval =
+    &(struct double_list_fval){ .cmp = cmc_double_cmp,
+                                .cpy = NULL,
+                                .str = cmc_double_str,
+                                .free = NULL,
+                                .hash = cmc_double_hash,
+                                .pri = cmc_double_cmp };
+
+struct pod_list_fval *pl_fval = &(struct pod_list_fval){ .cmp = cmc_u32_cmp,
+                                                         .cpy = NULL,
+                                                         .str = cmc_u32_str,
+                                                         .free = NULL,
+                                                         .hash = cmc_u32_hash,
+                                                         .pri = cmc_u32_cmp };
+
+struct key_list_fval *kl_fval = &(struct key_list_fval){ .cmp = kl_cmp,
+                                                         .cpy = NULL,
+                                                         .str = cmc_size_str,
+                                                         .free = NULL,
+                                                         .hash = cmc_size_hash,
+                                                         .pri = kl_cmp };
+
+static size_t l_grow_by_10(size_t capacity, size_t required)
+{
+    return capacity + 10;
+}
+
+struct cmc_growth l_growth_chunked = { 2.0, 100, NULL };
+struct cmc_growth l_growth_slow = { 1.5, 0, NULL };
+struct cmc_growth l_growth_none = { 1.0, 0, NULL };
+struct cmc_growth l_growth_custom = { 0, 0, l_grow_by_10 };
+
 CMC_CREATE_UNIT(List, true, {
     CMC_CREATE_TEST(new, {
         struct list *l = l_new(1000000, l_fval);
@@ -611,6 +673,398 @@ CMC_CREATE_UNIT(List, true, {
         total_delete = 0;
         total_resize = 0;
     });
+
+    CMC_CREATE_TEST(index_of[pod], {
+        struct pod_list *l = pl_new(100, pl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        cmc_assert_equals(size_t, 0, pl_index_of(l, 1, true));
+        cmc_assert(!pl_contains(l, 1));
+
+        // Every length around the vector widths and every position
+        for (uint32_t n = 1; n <= 40; n++)
+        {
+            pl_clear(l);
+
+            for (uint32_t i = 0; i < n; i++)
+                cmc_assert(pl_push_back(l, i % 7));
+
+            for (uint32_t v = 0; v < 8; v++)
+            {
+                size_t first = n;
+                size_t last = n;
+
+                for (size_t i = 0; i < n; i++)
+                {
+                    if (i % 7 == v)
+                    {
+                        if (first == n)
+                            first = i;
+
+                        last = i;
+                    }
+                }
+
+                cmc_assert_equals(size_t, first, pl_index_of(l, v, true));
+                cmc_assert_equals(size_t, last, pl_index_of(l, v, false));
+                cmc_assert_equals(bool, first != n, pl_contains(l, v));
+            }
+        }
+
+        pl_free(l);
+    });
+
+    CMC_CREATE_TEST(sort, {
+        struct list *l = l_new(100, l_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        l_sort(l);
+        cmc_assert_equals(int32_t, cmc_flags.OK, l_flag(l));
+
+        // Random, sorted, reversed, sawtooth, organ pipe and all equal
+        for (size_t pattern = 0; pattern < 6; pattern++)
+        {
+            size_t seed = 42;
+            size_t sum = 0;
+
+            l_clear(l);
+
+            for (size_t i = 0; i < 100000; i++)
+            {
+                size_t value;
+
+                seed = seed * 6364136223846793005 + 1442695040888963407;
+
+                if (pattern == 0)
+                    value = seed >> 40;
+                else if (pattern == 1)
+                    value = i;
+                else if (pattern == 2)
+                    value = 100000 - i;
+                else if (pattern == 3)
+                    value = i % 1000;
+                else if (pattern == 4)
+                    value = i < 50000 ? i : 100000 - i;
+                else
+                    value = 7;
+
+                sum += value;
+
+                cmc_assert(l_push_back(l, value));
+            }
+
+            l_sort(l);
+
+            for (size_t i = 0; i < l_count(l); i++)
+            {
+                if (i > 0)
+                    cmc_assert_lesser_equals(size_t, l_get(l, i),
+                                             l_get(l, i - 1));
+
+                sum -= l_get(l, i);
+            }
+
+            cmc_assert_equals(size_t, 0, sum);
+        }
+
+        l_free(l);
+    });
+
+    CMC_CREATE_TEST(sort_range, {
+        struct list *l = l_new(100, l_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(l_push_back(l, 1000 - i));
+
+        cmc_assert(!l_sort_range(l, 10, 5));
+        cmc_assert_equals(int32_t, cmc_flags.INVALID, l_flag(l));
+        cmc_assert(!l_sort_range(l, 10, 1000));
+        cmc_assert_equals(int32_t, cmc_flags.RANGE, l_flag(l));
+
+        cmc_assert(l_sort_range(l, 100, 199));
+        cmc_assert_equals(int32_t, cmc_flags.OK, l_flag(l));
+
+        for (size_t i = 0; i < 1000; i++)
+        {
+            if (i >= 100 && i < 200)
+                cmc_assert_equals(size_t, 801 + (i - 100), l_get(l, i));
+            else
+                cmc_assert_equals(size_t, 1000 - i, l_get(l, i));
+        }
+
+        cmc_assert(l_sort_range(l, 0, 999));
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert_equals(size_t, i + 1, l_get(l, i));
+
+        l_free(l);
+    });
+
+    CMC_CREATE_TEST(sort[radix], {
+        struct list *l = l_new(100, l_fval);
+        struct radix_list *rl = rl_new(100, rl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+        cmc_assert_not_equals(ptr, NULL, rl);
+
+        // Random, timestamps, small values and below the radix threshold
+        for (size_t pattern = 0; pattern < 4; pattern++)
+        {
+            size_t seed = 42;
+            size_t count = pattern == 3 ? 100 : 100000;
+
+            l_clear(l);
+            rl_clear(rl);
+
+            for (size_t i = 0; i < count; i++)
+            {
+                size_t value;
+
+                seed = seed * 6364136223846793005 + 1442695040888963407;
+
+                if (pattern == 0 || pattern == 3)
+                    value = seed;
+                else if (pattern == 1)
+                    value = 1600000000000 + (seed >> 44);
+                else
+                    value = seed >> 56;
+
+                cmc_assert(l_push_back(l, value));
+                cmc_assert(rl_push_back(rl, value));
+            }
+
+            l_sort(l);
+            rl_sort(rl);
+
+            cmc_assert_equals(int32_t, cmc_flags.OK, rl_flag(rl));
+
+            for (size_t i = 0; i < count; i++)
+                cmc_assert_equals(size_t, l_get(l, i), rl_get(rl, i));
+        }
+
+        cmc_assert(rl_sort_range(rl, 10, 5) == false);
+        cmc_assert_equals(int32_t, cmc_flags.INVALID, rl_flag(rl));
+
+        l_free(l);
+        rl_free(rl);
+    });
+
+    CMC_CREATE_TEST(sort[radix double], {
+        struct double_list *dl = dl_new(100, dl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, dl);
+
+        size_t seed = 42;
+
+        for (size_t i = 0; i < 100000; i++)
+        {
+            seed = seed * 6364136223846793005 + 1442695040888963407;
+
+            double value = (double)(seed >> 11) / 1000.0;
+
+            cmc_assert(dl_push_back(dl, i % 2 == 0 ? value : -value));
+        }
+
+        cmc_assert(dl_push_back(dl, 0.0));
+        cmc_assert(dl_push_back(dl, 1e300));
+        cmc_assert(dl_push_back(dl, -1e300));
+
+        dl_sort(dl);
+
+        cmc_assert_equals(double, -1e300, dl_front(dl));
+        cmc_assert_equals(double, 1e300, dl_back(dl));
+
+        for (size_t i = 1; i < dl_count(dl); i++)
+            cmc_assert_lesser_equals(double, dl_get(dl, i), dl_get(dl, i - 1));
+
+        dl_free(dl);
+    });
+
+    CMC_CREATE_TEST(sort_parallel, {
+        struct list *l = l_new(100, l_fval);
+        struct list *r = l_new(100, l_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+        cmc_assert_not_equals(ptr, NULL, r);
+
+        // Random values and many duplicates
+        for (size_t pattern = 0; pattern < 2; pattern++)
+        {
+            for (size_t threads = 1; threads <= 7; threads += 2)
+            {
+                size_t seed = 42;
+
+                l_clear(l);
+                l_clear(r);
+
+                for (size_t i = 0; i < 200000; i++)
+                {
+                    seed = seed * 6364136223846793005 + 1442695040888963407;
+
+                    size_t value = pattern == 0 ? seed : seed % 10;
+
+                    cmc_assert(l_push_back(l, value));
+                    cmc_assert(l_push_back(r, value));
+                }
+
+                l_sort_parallel(l, threads);
+                l_sort(r);
+
+                cmc_assert_equals(int32_t, cmc_flags.OK, l_flag(l));
+
+                for (size_t i = 0; i < l_count(l); i++)
+                    cmc_assert_equals(size_t, l_get(r, i), l_get(l, i));
+            }
+        }
+
+        l_free(l);
+        l_free(r);
+    });
+
+    CMC_CREATE_TEST(sort_parallel[stable], {
+        struct key_list *l = kl_new(100, kl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        size_t seed = 42;
+
+        // The lower half of each value is its original index
+        for (size_t i = 0; i < 200000; i++)
+        {
+            seed = seed * 6364136223846793005 + 1442695040888963407;
+
+            cmc_assert(kl_push_back(l, ((seed >> 54) << 32) | i));
+        }
+
+        kl_sort_parallel(l, 5);
+
+        for (size_t i = 1; i < kl_count(l); i++)
+        {
+            size_t prev = kl_get(l, i - 1);
+            size_t curr = kl_get(l, i);
+
+            cmc_assert_lesser_equals(uint32_t, kl_key(curr), kl_key(prev));
+
+            if (kl_key(prev) == kl_key(curr))
+                cmc_assert_lesser(uint32_t, (uint32_t)curr, (uint32_t)prev);
+        }
+
+        kl_free(l);
+    });
+
+    CMC_CREATE_TEST(growth, {
+        struct list *l = l_new(1000, l_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        // Grows by at most 100 elements at a time
+        l_set_growth(l, &l_growth_chunked);
+
+        for (size_t i = 0; i < 1001; i++)
+            cmc_assert(l_push_back(l, i));
+
+        cmc_assert_equals(size_t, 1100, l_capacity(l));
+
+        l_set_growth(l, &l_growth_slow);
+
+        for (size_t i = 1001; i < 1101; i++)
+            cmc_assert(l_push_back(l, i));
+
+        cmc_assert_equals(size_t, 1650, l_capacity(l));
+
+        // A factor that does not grow still makes room for the elements
+        l_set_growth(l, &l_growth_none);
+
+        cmc_assert(l_resize(l, l_count(l)));
+        cmc_assert(l_push_back(l, 0));
+        cmc_assert_equals(size_t, 1102, l_capacity(l));
+
+        l_set_growth(l, NULL);
+
+        cmc_assert(l_push_back(l, 0));
+        cmc_assert_equals(size_t, 2204, l_capacity(l));
+
+        for (size_t i = 0; i < 1100; i++)
+            cmc_assert_equals(size_t, i, l_get(l, i));
+
+        l_free(l);
+    });
+
+    CMC_CREATE_TEST(growth[grow], {
+        struct list *l = l_new(10, l_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        l_set_growth(l, &l_growth_custom);
+
+        for (size_t i = 0; i < 11; i++)
+            cmc_assert(l_push_back(l, i));
+
+        cmc_assert_equals(size_t, 20, l_capacity(l));
+
+        size_t values[50] = { 0 };
+
+        cmc_assert(l_seq_push_back(l, values, 50));
+        cmc_assert_equals(size_t, 61, l_capacity(l));
+
+        struct list *c = l_copy_of(l);
+
+        cmc_assert_not_equals(ptr, NULL, c);
+        cmc_assert_equals(ptr, &l_growth_custom, c->growth);
+
+        l_free(c);
+        l_free(l);
+    });
+
+    CMC_CREATE_TEST(reserve, {
+        struct list *l = l_new(10, l_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t i = 0; i < 5; i++)
+            cmc_assert(l_push_back(l, i));
+
+        cmc_assert(l_reserve(l, 5));
+        cmc_assert_equals(size_t, 10, l_capacity(l));
+
+        cmc_assert(l_reserve(l, 6));
+        cmc_assert_equals(size_t, 20, l_capacity(l));
+
+        cmc_assert(l_reserve(l, 100));
+        cmc_assert_equals(size_t, 105, l_capacity(l));
+
+        cmc_assert(!l_reserve(l, SIZE_MAX));
+        cmc_assert_equals(int32_t, cmc_flags.ERROR, l_flag(l));
+
+        for (size_t i = 0; i < 5; i++)
+            cmc_assert_equals(size_t, i, l_get(l, i));
+
+        l_free(l);
+    });
+
+    CMC_CREATE_TEST(shrink_to_fit, {
+        struct list *l = l_new(100, l_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        cmc_assert(l_shrink_to_fit(l));
+        cmc_assert_equals(size_t, 1, l_capacity(l));
+
+        for (size_t i = 0; i < 30; i++)
+            cmc_assert(l_push_back(l, i));
+
+        cmc_assert(l_shrink_to_fit(l));
+        cmc_assert_equals(size_t, 30, l_capacity(l));
+
+        for (size_t i = 0; i < 30; i++)
+            cmc_assert_equals(size_t, i, l_get(l, i));
+
+        l_free(l);
+    });
 })
 
 CMC_CREATE_UNIT(ListIter, true, {
@@ -0,0 +1,359 @@
+#include "utl.c"
+#include "utl/assert.h"
+#include "utl/test.h"
+#include "utl/thread.h"
+
+#include "../src/mpmcqueue.c"
+
+struct mpmcqueue_fval *mpq_fval =
+    &(struct mpmcqueue_fval){ .cmp = cmc_size_cmp,
+                              .cpy = NULL,
+                              .str = cmc_size_str,
+                              .free = NULL,
+                              .hash = cmc_size_hash,
+                              .pri = cmc_size_cmp };
+
+struct mpmcqueue_fval *mpq_fval_counter =
+    &(struct mpmcqueue_fval){ .cmp = v_c_cmp,
+                              .cpy = v_c_cpy,
+                              .str = v_c_str,
+                              .free = v_c_free,
+                              .hash = v_c_hash,
+                              .pri = v_c_pri };
+
+/* Amount of elements enqueued by each producer */
+const size_t mpq_total = 2000;
+
+/* Amount of producers and consumers */
+#define MPQ_THREADS 4
+
+struct mpq_worker
+{
+    struct mpmcqueue *queue;
+    size_t id;
+    size_t sum;
+    size_t count;
+    bool blocking;
+};
+
+/* Enqueues id * mpq_total .. (id + 1) * mpq_total - 1 */
+int mpq_producer(void *args)
+{
+    struct mpq_worker *w = args;
+
+    for (size_t i = 0; i < mpq_total; i++)
+    {
+        size_t value = w->id * mpq_total + i;
+
+        if (w->blocking)
+            mpq_enqueue(w->queue, value);
+        else
+        {
+            while (!mpq_try_enqueue(w->queue, value))
+                ;
+        }
+    }
+
+    return 0;
+}
+
+/* Dequeues mpq_total elements and sums them up */
+int mpq_consumer(void *args)
+{
+    struct mpq_worker *w = args;
+    size_t value;
+
+    while (w->count < mpq_total)
+    {
+        if (w->blocking)
+            mpq_dequeue(w->queue, &value);
+        else
+        {
+            while (!mpq_try_dequeue(w->queue, &value))
+                ;
+        }
+
+        w->sum += value;
+        w->count++;
+    }
+
+    return 0;
+}
+
+/* Runs MPQ_THREADS producers and consumers and returns the sum of all */
+/* elements dequeued */
+size_t mpq_run(struct mpmcqueue *q, bool blocking)
+{
+    struct cmc_thread producers[MPQ_THREADS];
+    struct cmc_thread consumers[MPQ_THREADS];
+    struct mpq_worker p_workers[MPQ_THREADS];
+    struct mpq_worker c_workers[MPQ_THREADS];
+    size_t sum = 0;
+
+    for (size_t i = 0; i < MPQ_THREADS; i++)
+    {
+        p_workers[i] = (struct mpq_worker){ q, i, 0, 0, blocking };
+        c_workers[i] = (struct mpq_worker){ q, i, 0, 0, blocking };
+
+        cmc_thrd_create(&consumers[i], mpq_consumer, &c_workers[i]);
+        cmc_thrd_create(&producers[i], mpq_producer, &p_workers[i]);
+    }
+
+    for (size_t i = 0; i < MPQ_THREADS; i++)
+    {
+        cmc_thrd_join(&producers[i], NULL);
+        cmc_thrd_join(&consumers[i], NULL);
+
+        sum += c_workers[i].sum;
+    }
+
+    return sum;
+}
+
+/* Dequeues a single element, blocking until it is enqueued */
+int mpq_waiter(void *args)
+{
+    struct mpmcqueue *q = args;
+    size_t value = 0;
+
+    mpq_dequeue(q, &value);
+
+    return (int)value;
+}
+
+CMC_CREATE_UNIT(MPMCQueue, true, {
+    CMC_CREATE_TEST(new, {
+        struct mpmcqueue *q = mpq_new(1000, mpq_fval);
+
+        cmc_assert_not_equals(ptr, NULL, q);
+        cmc_assert_not_equals(ptr, NULL, q->buffer);
+        cmc_assert_equals(size_t, 0, mpq_count(q));
+        cmc_assert_equals(size_t, 1024, mpq_capacity(q));
+        cmc_assert_equals(int32_t, cmc_flags.OK, mpq_flag(q));
+
+        for (size_t i = 0; i < 1024; i++)
+            cmc_assert_equals(size_t, i, q->buffer[i].sequence);
+
+        mpq_free(q);
+    });
+
+    CMC_CREATE_TEST(new[capacity = 0], {
+        struct mpmcqueue *q = mpq_new(0, mpq_fval);
+
+        cmc_assert_equals(ptr, NULL, q);
+    });
+
+    CMC_CREATE_TEST(new[capacity = 1], {
+        struct mpmcqueue *q = mpq_new(1, mpq_fval);
+
+        cmc_assert_not_equals(ptr, NULL, q);
+        cmc_assert_equals(size_t, 2, mpq_capacity(q));
+
+        mpq_free(q);
+    });
+
+    CMC_CREATE_TEST(new[capacity = UINT64_MAX], {
+        struct mpmcqueue *q = mpq_new(UINT64_MAX, mpq_fval);
+
+        cmc_assert_equals(ptr, NULL, q);
+    });
+
+    CMC_CREATE_TEST(new[f_val = NULL], {
+        struct mpmcqueue *q = mpq_new(1000, NULL);
+
+        cmc_assert_equals(ptr, NULL, q);
+    });
+
+    CMC_CREATE_TEST(clear[count capacity], {
+        struct mpmcqueue *q = mpq_new(100, mpq_fval);
+
+        cmc_assert_not_equals(ptr, NULL, q);
+
+        for (size_t i = 0; i < 50; i++)
+            cmc_assert(mpq_try_enqueue(q, i));
+
+        cmc_assert_equals(size_t, 50, mpq_count(q));
+
+        mpq_clear(q);
+
+        cmc_assert_equals(size_t, 0, mpq_count(q));
+        cmc_assert_equals(size_t, 128, mpq_capacity(q));
+
+        for (size_t i = 0; i < 128; i++)
+            cmc_assert(mpq_try_enqueue(q, i));
+
+        cmc_assert(mpq_full(q));
+
+        mpq_free(q);
+    });
+
+    CMC_CREATE_TEST(try_enqueue try_dequeue, {
+        struct mpmcqueue *q = mpq_new(8, mpq_fval);
+
+        cmc_assert_not_equals(ptr, NULL, q);
+
+        size_t value = 0;
+
+        cmc_assert(!mpq_try_dequeue(q, &value));
+
+        // Goes around the buffer a few times
+        for (size_t i = 0; i < 100; i++)
+        {
+            cmc_assert(mpq_try_enqueue(q, i));
+            cmc_assert(mpq_try_enqueue(q, i + 1000));
+
+            cmc_assert(mpq_try_dequeue(q, &value));
+            cmc_assert_equals(size_t, i, value);
+            cmc_assert(mpq_try_dequeue(q, NULL));
+        }
+
+        for (size_t i = 0; i < 8; i++)
+            cmc_assert(mpq_try_enqueue(q, i));
+
+        cmc_assert(mpq_full(q));
+        cmc_assert(!mpq_try_enqueue(q, 8));
+        cmc_assert_equals(size_t, 8, mpq_count(q));
+
+        for (size_t i = 0; i < 8; i++)
+        {
+            cmc_assert(mpq_try_dequeue(q, &value));
+            cmc_assert_equals(size_t, i, value);
+        }
+
+        cmc_assert(mpq_empty(q));
+        cmc_assert(!mpq_try_dequeue(q, &value));
+
+        mpq_free(q);
+    });
+
+    CMC_CREATE_TEST(enqueue dequeue[single thread], {
+        struct mpmcqueue *q = mpq_new(4, mpq_fval);
+
+        cmc_assert_not_equals(ptr, NULL, q);
+
+        size_t value = 0;
+
+        // Doesn't block when there is room or an element
+        for (size_t i = 0; i < 4; i++)
+            cmc_assert(mpq_enqueue(q, i));
+
+        for (size_t i = 0; i < 4; i++)
+        {
+            cmc_assert(mpq_dequeue(q, &value));
+            cmc_assert_equals(size_t, i, value);
+        }
+
+        mpq_free(q);
+    });
+
+    CMC_CREATE_TEST(dequeue[wakes up], {
+        struct mpmcqueue *q = mpq_new(4, mpq_fval);
+
+        cmc_assert_not_equals(ptr, NULL, q);
+
+        struct cmc_thread waiter;
+        int result = 0;
+
+        cmc_assert(cmc_thrd_create(&waiter, mpq_waiter, q));
+
+        // Gives the waiter some time to go to sleep
+        for (size_t i = 0; i < 100000 && q->sleeping_consumers == 0; i++)
+            continue;
+
+        cmc_assert(mpq_try_enqueue(q, 42));
+        cmc_assert(cmc_thrd_join(&waiter, &result));
+        cmc_assert_equals(int32_t, 42, result);
+        cmc_assert(mpq_empty(q));
+
+        mpq_free(q);
+    });
+
+    CMC_CREATE_TEST(free[counter], {
+        struct mpmcqueue *q = mpq_new(100, mpq_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, q);
+
+        v_total_free = 0;
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(mpq_try_enqueue(q, i));
+
+        for (size_t i = 0; i < 40; i++)
+            cmc_assert(mpq_try_dequeue(q, NULL));
+
+        mpq_free(q);
+
+        cmc_assert_equals(int32_t, 60, v_total_free);
+
+        v_total_free = 0;
+    });
+
+    CMC_CREATE_TEST(callbacks, {
+        struct mpmcqueue *q = mpq_new_custom(32, mpq_fval, NULL, callbacks);
+
+        cmc_assert_not_equals(ptr, NULL, q);
+
+        size_t value;
+
+        total_create = 0;
+        total_delete = 0;
+
+        cmc_assert(mpq_try_enqueue(q, 1));
+        cmc_assert(mpq_enqueue(q, 2));
+        cmc_assert_equals(int32_t, 2, total_create);
+
+        cmc_assert(mpq_try_dequeue(q, &value));
+        cmc_assert(mpq_dequeue(q, &value));
+        cmc_assert_equals(int32_t, 2, total_delete);
+
+        mpq_free(q);
+
+        total_create = 0;
+        total_delete = 0;
+    });
+
+    CMC_CREATE_TEST(threads[try], {
+        struct mpmcqueue *q = mpq_new(64, mpq_fval);
+
+        cmc_assert_not_equals(ptr, NULL, q);
+
+        size_t total = mpq_total * MPQ_THREADS;
+
+        cmc_assert_equals(size_t, total * (total - 1) / 2, mpq_run(q, false));
+        cmc_assert(mpq_empty(q));
+
+        mpq_free(q);
+    });
+
+    CMC_CREATE_TEST(threads[blocking], {
+        struct mpmcqueue *q = mpq_new(8, mpq_fval);
+
+        cmc_assert_not_equals(ptr, NULL, q);
+
+        size_t total = mpq_total * MPQ_THREADS;
+
+        cmc_assert_equals(size_t, total * (total - 1) / 2, mpq_run(q, true));
+        cmc_assert(mpq_empty(q));
+        cmc_assert_equals(size_t, 0, q->sleeping_producers);
+        cmc_assert_equals(size_t, 0, q->sleeping_consumers);
+
+        mpq_free(q);
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = MPMCQueue();
+
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | MPMCQueue Suit : %-44s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
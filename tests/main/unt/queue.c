@@ -4,6 +4,8 @@
 
 #include "../src/queue.c"
 
+CMC_GENERATE_QUEUE_POD(pq, pod_queue, uint16_t)
+
 struct queue_fval *q_fval = &(struct queue_fval){ .cmp = cmc_size_cmp,
                                                   .cpy = NULL,
                                                   .str = cmc_size_str,
@@ -11,6 +13,13 @@ struct queue_fval *q_fval = &(struct queue_fval){ .cmp = cmc_size_cmp,
                                                   .hash = cmc_size_hash,
                                                   .pri = cmc_size_cmp };
 
+struct pod_queue_fval *pq_fval = &(struct pod_queue_fval){ .cmp = cmc_u16_cmp,
+                                                           .cpy = NULL,
+                                                           .str = cmc_u16_str,
+                                                           .free = NULL,
+                                                           .hash = cmc_u16_hash,
+                                                           .pri = cmc_u16_cmp };
+
 CMC_CREATE_UNIT(Queue, true, {
     CMC_CREATE_TEST(new, {
         struct queue *q = q_new(1000000, q_fval);
@@ -220,6 +229,32 @@ CMC_CREATE_UNIT(Queue, true, {
         q_free(q);
     });
 
+    CMC_CREATE_TEST(contains[pod], {
+        struct pod_queue *q = pq_new(100, pq_fval);
+
+        cmc_assert_not_equals(ptr, NULL, q);
+
+        // Move the front to the middle of the buffer so the elements wrap
+        for (uint16_t i = 0; i < 60; i++)
+            cmc_assert(pq_enqueue(q, 9999));
+
+        for (uint16_t i = 0; i < 60; i++)
+            cmc_assert(pq_dequeue(q));
+
+        for (uint16_t i = 0; i < 90; i++)
+            cmc_assert(pq_enqueue(q, i));
+
+        cmc_assert_equals(size_t, 100, pq_capacity(q));
+
+        for (uint16_t i = 0; i < 90; i++)
+            cmc_assert(pq_contains(q, i));
+
+        cmc_assert(!pq_contains(q, 90));
+        cmc_assert(!pq_contains(q, 9999));
+
+        pq_free(q);
+    });
+
     CMC_CREATE_TEST(contains[count = 0], {
         struct queue *q = q_new(100, q_fval);
 
@@ -543,6 +578,174 @@ CMC_CREATE_UNIT(Queue, true, {
         total_delete = 0;
         total_resize = 0;
     });
+
+    CMC_CREATE_TEST(resize[wrapped], {
+        // Every position of the front and of the wrapped part
+        for (size_t front = 0; front < 16; front++)
+        {
+            for (size_t extra = 1; extra <= 40; extra += 13)
+            {
+                struct queue *x = q_new(16, q_fval);
+
+                cmc_assert_not_equals(ptr, NULL, x);
+
+                for (size_t i = 0; i < front; i++)
+                    cmc_assert(q_enqueue(x, 0));
+
+                for (size_t i = 0; i < front; i++)
+                    cmc_assert(q_dequeue(x));
+
+                for (size_t i = 0; i < 16; i++)
+                    cmc_assert(q_enqueue(x, i));
+
+                cmc_assert(q_reserve(x, extra));
+                cmc_assert_equals(size_t, 16, q_count(x));
+
+                for (size_t i = 16; i < 16 + extra; i++)
+                    cmc_assert(q_enqueue(x, i));
+
+                for (size_t i = 0; i < 16 + extra; i++)
+                {
+                    cmc_assert_equals(size_t, i, q_peek(x));
+                    cmc_assert(q_dequeue(x));
+                }
+
+                q_free(x);
+            }
+        }
+    });
+
+    CMC_CREATE_TEST(shrink_to_fit, {
+        struct queue *x = q_new(100, q_fval);
+
+        cmc_assert_not_equals(ptr, NULL, x);
+
+        for (size_t i = 0; i < 90; i++)
+            cmc_assert(q_enqueue(x, i));
+
+        for (size_t i = 0; i < 80; i++)
+            cmc_assert(q_dequeue(x));
+
+        for (size_t i = 90; i < 95; i++)
+            cmc_assert(q_enqueue(x, i));
+
+        cmc_assert(q_shrink_to_fit(x));
+        cmc_assert_equals(size_t, 15, q_capacity(x));
+
+        for (size_t i = 80; i < 95; i++)
+        {
+            cmc_assert_equals(size_t, i, q_peek(x));
+            cmc_assert(q_dequeue(x));
+        }
+
+        cmc_assert(q_shrink_to_fit(x));
+        cmc_assert_equals(size_t, 1, q_capacity(x));
+
+        cmc_assert(q_enqueue(x, 1));
+        cmc_assert(q_enqueue(x, 2));
+        cmc_assert_equals(size_t, 1, q_peek(x));
+
+        q_free(x);
+    });
+
+    CMC_CREATE_TEST(enqueue_n dequeue_n[wrap around], {
+        struct queue *x = q_new(10, q_fval);
+
+        cmc_assert_not_equals(ptr, NULL, x);
+
+        size_t values[8];
+        size_t out[20];
+
+        for (size_t i = 0; i < 8; i++)
+            values[i] = i + 100;
+
+        // Moves the front of the buffer close to its end
+        for (size_t i = 0; i < 7; i++)
+            cmc_assert(q_enqueue(x, i));
+
+        cmc_assert_equals(size_t, 5, q_dequeue_n(x, NULL, 5));
+
+        // The values are split where the buffer wraps around
+        cmc_assert(q_enqueue_n(x, values, 8));
+        cmc_assert_equals(size_t, 10, q_count(x));
+        cmc_assert_equals(size_t, 10, q_capacity(x));
+
+        cmc_assert_equals(size_t, 10, q_dequeue_n(x, out, 20));
+        cmc_assert(q_empty(x));
+
+        // The vacated slots are cleared like a single dequeue does
+        for (size_t i = 0; i < 10; i++)
+            cmc_assert_equals(size_t, 0, x->buffer[i]);
+
+        cmc_assert_equals(size_t, 5, out[0]);
+        cmc_assert_equals(size_t, 6, out[1]);
+
+        for (size_t i = 0; i < 8; i++)
+            cmc_assert_equals(size_t, i + 100, out[i + 2]);
+
+        cmc_assert_equals(size_t, 0, q_dequeue_n(x, out, 1));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, q_flag(x));
+
+        q_free(x);
+    });
+
+    CMC_CREATE_TEST(enqueue_n dequeue_n[callbacks], {
+        struct queue *x = q_new_custom(10, q_fval, NULL, callbacks);
+
+        cmc_assert_not_equals(ptr, NULL, x);
+
+        size_t values[5];
+
+        for (size_t i = 0; i < 5; i++)
+            values[i] = i + 1;
+
+        total_create = 0;
+        total_delete = 0;
+
+        // Nothing is inserted or removed
+        cmc_assert(q_enqueue_n(x, values, 0));
+        cmc_assert_equals(int32_t, cmc_flags.OK, q_flag(x));
+        cmc_assert_equals(int32_t, 0, total_create);
+        cmc_assert_equals(size_t, 0, q_dequeue_n(x, NULL, 5));
+        cmc_assert_equals(int32_t, 0, total_delete);
+
+        cmc_assert(q_enqueue_n(x, values, 5));
+        cmc_assert_equals(int32_t, 1, total_create);
+        cmc_assert_equals(size_t, 5, q_dequeue_n(x, NULL, 5));
+        cmc_assert_equals(int32_t, 1, total_delete);
+
+        q_free(x);
+
+        total_create = 0;
+        total_delete = 0;
+    });
+
+    CMC_CREATE_TEST(enqueue_n dequeue_n[grow], {
+        struct queue *x = q_new(10, q_fval);
+
+        cmc_assert_not_equals(ptr, NULL, x);
+
+        size_t values[1000];
+        size_t out[1000];
+        size_t next = 0;
+
+        for (size_t i = 0; i < 1000; i++)
+            values[i] = i;
+
+        // Leaves one more element behind every time
+        for (size_t i = 0; i < 10; i++)
+        {
+            cmc_assert(q_enqueue_n(x, values, 1000));
+            cmc_assert_equals(size_t, 999, q_dequeue_n(x, out, 999));
+
+            for (size_t j = 0; j < 999; j++)
+                cmc_assert_equals(size_t, next++ % 1000, out[j]);
+        }
+
+        cmc_assert_equals(size_t, 10, q_count(x));
+
+        q_free(x);
+    });
 });
 
 CMC_CREATE_UNIT(QueueIter, true, {
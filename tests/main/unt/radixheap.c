@@ -0,0 +1,260 @@
+#include "utl.c"
+#include "utl/assert.h"
+#include "utl/test.h"
+
+#include "../src/radixheap.c"
+
+CMC_GENERATE_RADIXHEAP(rh8, radixheap8, uint8_t, size_t)
+
+struct radixheap_fval *rh_fval =
+    &(struct radixheap_fval){ .cmp = cmc_size_cmp,
+                              .cpy = NULL,
+                              .str = cmc_size_str,
+                              .free = NULL,
+                              .hash = cmc_size_hash,
+                              .pri = cmc_size_cmp };
+
+struct radixheap_fval *rh_fval_counter =
+    &(struct radixheap_fval){ .cmp = v_c_cmp,
+                              .cpy = v_c_cpy,
+                              .str = v_c_str,
+                              .free = v_c_free,
+                              .hash = v_c_hash,
+                              .pri = v_c_pri };
+
+struct radixheap8_fval *rh8_fval =
+    &(struct radixheap8_fval){ .cmp = cmc_size_cmp,
+                               .cpy = NULL,
+                               .str = cmc_size_str,
+                               .free = NULL,
+                               .hash = cmc_size_hash,
+                               .pri = cmc_size_cmp };
+
+CMC_CREATE_UNIT(RadixHeap, true, {
+    CMC_CREATE_TEST(new, {
+        struct radixheap *h = rh_new(rh_fval);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+        cmc_assert_equals(size_t, 0, rh_count(h));
+        cmc_assert_equals(size_t, 0, rh_last(h));
+        cmc_assert_equals(ptr, NULL, h->buckets[0].buffer);
+        cmc_assert(rh_empty(h));
+
+        rh_free(h);
+    });
+
+    CMC_CREATE_TEST(new[f_val = NULL], {
+        struct radixheap *h = rh_new(NULL);
+
+        cmc_assert_equals(ptr, NULL, h);
+    });
+
+    CMC_CREATE_TEST(push pop_min[sorted], {
+        struct radixheap *h = rh_new(rh_fval);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        size_t key;
+        size_t value;
+
+        // Inserts 0 to 1000 in a scrambled order
+        for (size_t i = 0; i < 1001; i++)
+            cmc_assert(rh_push(h, (i * 7919) % 1001, i));
+
+        cmc_assert_equals(size_t, 1001, rh_count(h));
+
+        for (size_t i = 0; i < 1001; i++)
+        {
+            cmc_assert(rh_pop_min(h, &key, &value));
+            cmc_assert_equals(size_t, i, key);
+            cmc_assert_equals(size_t, i, (value * 7919) % 1001);
+            cmc_assert_equals(size_t, i, rh_last(h));
+        }
+
+        cmc_assert(rh_empty(h));
+        cmc_assert(!rh_pop_min(h, &key, &value));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, rh_flag(h));
+
+        rh_free(h);
+    });
+
+    CMC_CREATE_TEST(push pop_min[monotone], {
+        struct radixheap *h = rh_new(rh_fval);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        size_t key;
+        size_t prev = 0;
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(rh_push(h, i * 13 % 50, 0));
+
+        // Every key popped schedules a later one, like an event simulation
+        for (size_t i = 0; i < 10000; i++)
+        {
+            cmc_assert(rh_pop_min(h, &key, NULL));
+            cmc_assert_greater_equals(size_t, prev, key);
+            cmc_assert(rh_push(h, key + (i * 7919) % 100, 0));
+
+            prev = key;
+        }
+
+        cmc_assert_equals(size_t, 100, rh_count(h));
+
+        // Keys smaller than the last one popped are rejected
+        cmc_assert(!rh_push(h, prev - 1, 0));
+        cmc_assert_equals(int32_t, cmc_flags.INVALID, rh_flag(h));
+        cmc_assert(rh_push(h, prev, 0));
+        cmc_assert(rh_pop_min(h, &key, NULL));
+        cmc_assert_equals(size_t, prev, key);
+
+        rh_free(h);
+    });
+
+    CMC_CREATE_TEST(push pop_min[large keys], {
+        struct radixheap *h = rh_new(rh_fval);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        size_t key;
+
+        cmc_assert(rh_push(h, SIZE_MAX, 3));
+        cmc_assert(rh_push(h, (size_t)1 << 40, 2));
+        cmc_assert(rh_push(h, 0, 1));
+        cmc_assert(rh_push(h, SIZE_MAX - 1, 4));
+
+        cmc_assert(rh_pop_min(h, &key, NULL));
+        cmc_assert_equals(size_t, 0, key);
+        cmc_assert(rh_pop_min(h, &key, NULL));
+        cmc_assert_equals(size_t, (size_t)1 << 40, key);
+        cmc_assert(rh_pop_min(h, &key, NULL));
+        cmc_assert_equals(size_t, SIZE_MAX - 1, key);
+        cmc_assert(rh_pop_min(h, &key, NULL));
+        cmc_assert_equals(size_t, SIZE_MAX, key);
+
+        rh_free(h);
+    });
+
+    CMC_CREATE_TEST(push pop_min[uint8_t], {
+        struct radixheap8 *h = rh8_new(rh8_fval);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        uint8_t key;
+
+        for (size_t i = 0; i < 256; i++)
+            cmc_assert(rh8_push(h, (uint8_t)(i * 7), i));
+
+        for (size_t i = 0; i < 256; i++)
+        {
+            cmc_assert(rh8_pop_min(h, &key, NULL));
+            cmc_assert_equals(uint8_t, i, key);
+        }
+
+        rh8_free(h);
+    });
+
+    CMC_CREATE_TEST(peek, {
+        struct radixheap *h = rh_new(rh_fval);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        size_t key;
+        size_t value;
+
+        cmc_assert(!rh_peek(h, &key, &value));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, rh_flag(h));
+
+        cmc_assert(rh_push(h, 100, 1));
+        cmc_assert(rh_push(h, 50, 2));
+        cmc_assert(rh_push(h, 75, 3));
+
+        cmc_assert(rh_peek(h, &key, &value));
+        cmc_assert_equals(size_t, 50, key);
+        cmc_assert_equals(size_t, 2, value);
+        cmc_assert_equals(size_t, 3, rh_count(h));
+
+        // Peeking moves the last key up to the smallest one
+        cmc_assert_equals(size_t, 50, rh_last(h));
+        cmc_assert(!rh_push(h, 49, 0));
+
+        cmc_assert(rh_pop_min(h, NULL, &value));
+        cmc_assert_equals(size_t, 2, value);
+
+        rh_free(h);
+    });
+
+    CMC_CREATE_TEST(clear, {
+        struct radixheap *h = rh_new(rh_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        v_total_free = 0;
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(rh_push(h, i + 1000, i));
+
+        for (size_t i = 0; i < 40; i++)
+            cmc_assert(rh_pop_min(h, NULL, NULL));
+
+        rh_clear(h);
+
+        cmc_assert_equals(int32_t, 60, v_total_free);
+        cmc_assert(rh_empty(h));
+        cmc_assert_equals(size_t, 0, rh_last(h));
+
+        // Any key can be pushed again
+        for (size_t i = 0; i < 10; i++)
+            cmc_assert(rh_push(h, i, i));
+
+        rh_free(h);
+
+        cmc_assert_equals(int32_t, 70, v_total_free);
+
+        v_total_free = 0;
+    });
+
+    CMC_CREATE_TEST(callbacks, {
+        struct radixheap *h = rh_new_custom(rh_fval, NULL, callbacks);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        total_create = 0;
+        total_read = 0;
+        total_delete = 0;
+
+        cmc_assert(rh_push(h, 10, 0));
+        cmc_assert(rh_push(h, 20, 0));
+        cmc_assert_equals(int32_t, 2, total_create);
+
+        cmc_assert(rh_peek(h, NULL, NULL));
+        cmc_assert_equals(int32_t, 1, total_read);
+
+        cmc_assert(rh_pop_min(h, NULL, NULL));
+        cmc_assert(rh_pop_min(h, NULL, NULL));
+        cmc_assert_equals(int32_t, 2, total_delete);
+
+        rh_free(h);
+
+        total_create = 0;
+        total_read = 0;
+        total_delete = 0;
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = RadixHeap();
+
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | RadixHeap Suit : %-44s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
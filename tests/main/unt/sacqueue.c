@@ -0,0 +1,148 @@
+#include "utl.c"
+#include "utl/assert.h"
+#include "utl/test.h"
+
+#include "sac/queue.h"
+
+SAC_QUEUE_GENERATE(sq, sac_queue, static, size_t, 16)
+
+CMC_CREATE_UNIT(SACQueue, true, {
+    CMC_CREATE_TEST(PFX##_enqueue_n()[full], {
+        sac_queue q = sq_new();
+
+        size_t values[16];
+
+        for (size_t i = 0; i < 16; i++)
+            values[i] = i + 100;
+
+        for (size_t i = 0; i < 10; i++)
+            cmc_assert(sq_enqueue(&q, i));
+
+        // Nothing is enqueued when not every element fits
+        cmc_assert(!sq_enqueue_n(&q, values, 7));
+        cmc_assert_equals(size_t, 10, sq_count(&q));
+        cmc_assert_equals(size_t, 10, q.rear);
+        cmc_assert_equals(size_t, 0, q.buffer[10]);
+
+        cmc_assert(sq_enqueue_n(&q, values, 6));
+        cmc_assert_equals(size_t, 16, sq_count(&q));
+        cmc_assert(sq_full(&q));
+        cmc_assert_equals(size_t, 0, q.rear);
+
+        cmc_assert(!sq_enqueue_n(&q, values, 1));
+
+        for (size_t i = 0; i < 16; i++)
+        {
+            cmc_assert_equals(size_t, i < 10 ? i : i + 90, sq_peek(&q));
+            cmc_assert(sq_dequeue(&q));
+        }
+
+        cmc_assert(sq_empty(&q));
+    });
+
+    CMC_CREATE_TEST(PFX##_enqueue_n()[wrap], {
+        sac_queue q = sq_new();
+
+        size_t values[16];
+        size_t result[16];
+
+        for (size_t i = 0; i < 16; i++)
+            values[i] = i + 100;
+
+        for (size_t i = 0; i < 12; i++)
+            cmc_assert(sq_enqueue(&q, i));
+
+        cmc_assert_equals(size_t, 10, sq_dequeue_n(&q, NULL, 10));
+        cmc_assert_equals(size_t, 10, q.front);
+        cmc_assert_equals(size_t, 12, q.rear);
+
+        // 4 elements go to the end of the buffer and 6 to its start
+        cmc_assert(sq_enqueue_n(&q, values, 10));
+        cmc_assert_equals(size_t, 12, sq_count(&q));
+        cmc_assert_equals(size_t, 6, q.rear);
+        cmc_assert_equals(size_t, 103, q.buffer[15]);
+        cmc_assert_equals(size_t, 104, q.buffer[0]);
+
+        // And are dequeued back across the end of the buffer
+        cmc_assert_equals(size_t, 12, sq_dequeue_n(&q, result, 12));
+        cmc_assert(sq_empty(&q));
+        cmc_assert_equals(size_t, 6, q.front);
+
+        cmc_assert_equals(size_t, 10, result[0]);
+        cmc_assert_equals(size_t, 11, result[1]);
+
+        for (size_t i = 2; i < 12; i++)
+            cmc_assert_equals(size_t, i + 98, result[i]);
+
+        for (size_t i = 0; i < 16; i++)
+            cmc_assert_equals(size_t, 0, q.buffer[i]);
+    });
+
+    CMC_CREATE_TEST(PFX##_dequeue_n()[partial], {
+        sac_queue q = sq_new();
+
+        size_t result[16];
+
+        for (size_t i = 0; i < 5; i++)
+            cmc_assert(sq_enqueue(&q, i));
+
+        // Only the elements in the queue are dequeued
+        cmc_assert_equals(size_t, 5, sq_dequeue_n(&q, result, 8));
+        cmc_assert(sq_empty(&q));
+        cmc_assert_equals(size_t, 5, q.front);
+        cmc_assert_equals(size_t, 5, q.rear);
+
+        for (size_t i = 0; i < 5; i++)
+            cmc_assert_equals(size_t, i, result[i]);
+
+        cmc_assert_equals(size_t, 0, sq_dequeue_n(&q, result, 8));
+        cmc_assert_equals(size_t, 0, sq_dequeue_n(&q, NULL, 8));
+
+        cmc_assert(sq_enqueue(&q, 1));
+        cmc_assert(sq_enqueue(&q, 2));
+
+        cmc_assert_equals(size_t, 1, sq_dequeue_n(&q, result, 1));
+        cmc_assert_equals(size_t, 1, result[0]);
+        cmc_assert_equals(size_t, 1, sq_count(&q));
+        cmc_assert_equals(size_t, 2, sq_peek(&q));
+    });
+
+    CMC_CREATE_TEST(PFX##_enqueue_n()[zero], {
+        sac_queue q = sq_new();
+
+        size_t values[16];
+
+        for (size_t i = 0; i < 16; i++)
+            values[i] = i + 100;
+
+        cmc_assert(sq_enqueue_n(&q, values, 0));
+        cmc_assert(sq_empty(&q));
+        cmc_assert_equals(size_t, 0, sq_dequeue_n(&q, values, 0));
+
+        cmc_assert(sq_enqueue_n(&q, values, 16));
+        cmc_assert(sq_full(&q));
+
+        // A full queue still takes zero elements
+        cmc_assert(sq_enqueue_n(&q, values, 0));
+        cmc_assert_equals(size_t, 0, sq_dequeue_n(&q, NULL, 0));
+        cmc_assert_equals(size_t, 16, sq_count(&q));
+        cmc_assert_equals(size_t, 100, sq_peek(&q));
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = SACQueue();
+
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | SACQueue Suit : %-45s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
@@ -0,0 +1,548 @@
+#include "utl.c"
+#include "utl/assert.h"
+#include "utl/test.h"
+
+#include "../src/segdeque.c"
+
+struct segdeque_fval *sd_fval = &(struct segdeque_fval){ .cmp = cmc_size_cmp,
+                                                         .cpy = NULL,
+                                                         .str = cmc_size_str,
+                                                         .free = NULL,
+                                                         .hash = cmc_size_hash,
+                                                         .pri = cmc_size_cmp };
+
+struct segdeque_fval *sd_fval_counter =
+    &(struct segdeque_fval){ .cmp = v_c_cmp,
+                             .cpy = v_c_cpy,
+                             .str = v_c_str,
+                             .free = v_c_free,
+                             .hash = v_c_hash,
+                             .pri = v_c_pri };
+
+/* Elements per block */
+const size_t sd_block = CMC_SEGDEQUE_BLOCK_SIZE(size_t);
+
+CMC_CREATE_UNIT(SegDeque, true, {
+    CMC_CREATE_TEST(new, {
+        struct segdeque *d = sd_new(1000, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+        cmc_assert_not_equals(ptr, NULL, d->map);
+        cmc_assert_equals(size_t, 0, sd_count(d));
+        cmc_assert_greater_equals(size_t, 1000, sd_capacity(d));
+        cmc_assert_equals(size_t, 0, sd_capacity(d) % sd_block);
+
+        sd_free(d);
+    });
+
+    CMC_CREATE_TEST(new[capacity = 0], {
+        struct segdeque *d = sd_new(0, sd_fval);
+
+        cmc_assert_equals(ptr, NULL, d);
+    });
+
+    CMC_CREATE_TEST(new[capacity = UINT64_MAX], {
+        struct segdeque *d = sd_new(UINT64_MAX, sd_fval);
+
+        cmc_assert_equals(ptr, NULL, d);
+    });
+
+    CMC_CREATE_TEST(init release, {
+        struct segdeque d = sd_init(100, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d.map);
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(sd_push_front(&d, i));
+
+        cmc_assert_equals(size_t, 1000, sd_count(&d));
+
+        sd_release(d);
+    });
+
+    CMC_CREATE_TEST(clear[count], {
+        struct segdeque *d = sd_new(100, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(sd_push_back(d, i));
+
+        size_t capacity = sd_capacity(d);
+
+        sd_clear(d);
+
+        cmc_assert_equals(size_t, 0, sd_count(d));
+        cmc_assert_equals(size_t, capacity, sd_capacity(d));
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(sd_push_front(d, i));
+
+        cmc_assert_equals(size_t, 999, sd_front(d));
+        cmc_assert_equals(size_t, 0, sd_back(d));
+
+        sd_free(d);
+    });
+
+    CMC_CREATE_TEST(free[counter], {
+        v_total_free = 0;
+
+        struct segdeque *d = sd_new(1, sd_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(sd_push_back(d, i));
+
+        for (size_t i = 0; i < 10; i++)
+            cmc_assert(sd_pop_front(d));
+
+        sd_free(d);
+
+        cmc_assert_equals(size_t, 990, v_total_free);
+
+        v_total_free = 0;
+    });
+
+    CMC_CREATE_TEST(push_front push_back, {
+        struct segdeque *d = sd_new(1, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        for (size_t i = 1; i <= 5000; i++)
+        {
+            cmc_assert(sd_push_front(d, i));
+            cmc_assert(sd_push_back(d, i));
+        }
+
+        cmc_assert_equals(size_t, 10000, sd_count(d));
+
+        for (size_t i = 0; i < 5000; i++)
+        {
+            cmc_assert_equals(size_t, 5000 - i, sd_get(d, i));
+            cmc_assert_equals(size_t, i + 1, sd_get(d, 5000 + i));
+        }
+
+        sd_free(d);
+    });
+
+    CMC_CREATE_TEST(pop_front pop_back, {
+        struct segdeque *d = sd_new(1, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        cmc_assert(!sd_pop_front(d));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, sd_flag(d));
+        cmc_assert(!sd_pop_back(d));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, sd_flag(d));
+
+        for (size_t i = 0; i < 3000; i++)
+            cmc_assert(sd_push_back(d, i));
+
+        for (size_t i = 0; i < 1500; i++)
+        {
+            cmc_assert_equals(size_t, i, sd_front(d));
+            cmc_assert_equals(size_t, 2999 - i, sd_back(d));
+
+            cmc_assert(sd_pop_front(d));
+            cmc_assert(sd_pop_back(d));
+        }
+
+        cmc_assert(sd_empty(d));
+        cmc_assert_equals(size_t, 0, d->blocks);
+
+        sd_free(d);
+    });
+
+    CMC_CREATE_TEST(get get_ref[stable addresses], {
+        struct segdeque *d = sd_new(1, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        cmc_assert_equals(ptr, NULL, sd_get_ref(d, 0));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, sd_flag(d));
+
+        cmc_assert(sd_push_back(d, 10));
+        cmc_assert(sd_push_back(d, 20));
+
+        size_t *ref1 = sd_get_ref(d, 0);
+        size_t *ref2 = sd_get_ref(d, 1);
+
+        // Growing the deque does not move its elements
+        for (size_t i = 0; i < 100000; i++)
+        {
+            cmc_assert(sd_push_back(d, i));
+            cmc_assert(sd_push_front(d, i));
+        }
+
+        cmc_assert_equals(ptr, ref1, sd_get_ref(d, 100000));
+        cmc_assert_equals(ptr, ref2, sd_get_ref(d, 100001));
+        cmc_assert_equals(size_t, 10, *ref1);
+        cmc_assert_equals(size_t, 20, *ref2);
+
+        cmc_assert_equals(ptr, NULL, sd_get_ref(d, 200002));
+        cmc_assert_equals(int32_t, cmc_flags.RANGE, sd_flag(d));
+
+        sd_free(d);
+    });
+
+    CMC_CREATE_TEST(queue[blocks are reused], {
+        struct segdeque *d = sd_new(1, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        size_t sum = 0;
+
+        for (size_t i = 0; i < 100000; i++)
+        {
+            cmc_assert(sd_push_back(d, i));
+
+            if (i >= 100)
+            {
+                sum += sd_front(d);
+                cmc_assert(sd_pop_front(d));
+            }
+        }
+
+        // At most 100 elements were in the deque at a time
+        cmc_assert_equals(size_t, 100, sd_count(d));
+        cmc_assert_lesser_equals(size_t, sd_block * 3, sd_capacity(d));
+        cmc_assert_equals(size_t, (size_t)99900 * 99899 / 2, sum);
+
+        sd_free(d);
+    });
+
+    CMC_CREATE_TEST(random operations, {
+        struct segdeque *d = sd_new(1, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        // The same operations are done to a plain array
+        size_t array[4000];
+        size_t front = 2000;
+        size_t back = 2000;
+        size_t seed = 3;
+
+        for (size_t i = 0; i < 20000; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+
+            size_t r = (seed >> 16) % 4;
+
+            if (r == 0 && front > 0)
+            {
+                array[--front] = i;
+                cmc_assert(sd_push_front(d, i));
+            }
+            else if (r == 1 && back < 4000)
+            {
+                array[back++] = i;
+                cmc_assert(sd_push_back(d, i));
+            }
+            else if (r == 2 && front < back)
+            {
+                front++;
+                cmc_assert(sd_pop_front(d));
+            }
+            else if (r == 3 && front < back)
+            {
+                back--;
+                cmc_assert(sd_pop_back(d));
+            }
+        }
+
+        cmc_assert_equals(size_t, back - front, sd_count(d));
+
+        for (size_t i = front; i < back; i++)
+            cmc_assert_equals(size_t, array[i], sd_get(d, i - front));
+
+        sd_free(d);
+    });
+
+    CMC_CREATE_TEST(contains, {
+        struct segdeque *d = sd_new(1, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        cmc_assert(!sd_contains(d, 0));
+
+        for (size_t i = 0; i < sd_block * 3; i++)
+            cmc_assert(sd_push_front(d, i * 2));
+
+        for (size_t i = 0; i < sd_block * 3; i++)
+        {
+            cmc_assert(sd_contains(d, i * 2));
+            cmc_assert(!sd_contains(d, i * 2 + 1));
+        }
+
+        sd_free(d);
+    });
+
+    CMC_CREATE_TEST(resize reserve shrink_to_fit, {
+        struct segdeque *d = sd_new(1, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+        cmc_assert_equals(size_t, sd_block, sd_capacity(d));
+
+        cmc_assert(sd_reserve(d, sd_block * 10));
+        cmc_assert_equals(size_t, sd_block * 10, sd_capacity(d));
+
+        // Reserved blocks are used by the next pushes
+        for (size_t i = 0; i < sd_block * 5; i++)
+            cmc_assert(sd_push_back(d, i));
+
+        cmc_assert_equals(size_t, sd_block * 10, sd_capacity(d));
+
+        cmc_assert(!sd_resize(d, sd_block * 5 - 1));
+        cmc_assert_equals(int32_t, cmc_flags.INVALID, sd_flag(d));
+
+        cmc_assert(sd_resize(d, sd_block * 6));
+        cmc_assert_equals(size_t, sd_block * 6, sd_capacity(d));
+
+        for (size_t i = 0; i < sd_block * 2; i++)
+            cmc_assert(sd_pop_front(d));
+
+        cmc_assert(sd_shrink_to_fit(d));
+        cmc_assert_equals(size_t, sd_block * 3, sd_capacity(d));
+        cmc_assert_equals(size_t, 5, d->map_capacity);
+
+        for (size_t i = 0; i < sd_block * 3; i++)
+            cmc_assert_equals(size_t, sd_block * 2 + i, sd_get(d, i));
+
+        sd_free(d);
+    });
+
+    CMC_CREATE_TEST(copy_of equals, {
+        struct segdeque *d1 = sd_new(1, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d1);
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(sd_push_front(d1, i));
+
+        struct segdeque *d2 = sd_copy_of(d1);
+
+        cmc_assert_not_equals(ptr, NULL, d2);
+        cmc_assert(sd_equals(d1, d2));
+
+        cmc_assert(sd_pop_back(d2));
+        cmc_assert(!sd_equals(d1, d2));
+
+        cmc_assert(sd_push_back(d2, 1000));
+        cmc_assert(!sd_equals(d1, d2));
+
+        sd_free(d1);
+        sd_free(d2);
+    });
+
+    CMC_CREATE_TEST(copy_of[counter], {
+        v_total_cpy = 0;
+        v_total_free = 0;
+
+        struct segdeque *d1 = sd_new(1, sd_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, d1);
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(sd_push_back(d1, i));
+
+        struct segdeque *d2 = sd_copy_of(d1);
+
+        cmc_assert_not_equals(ptr, NULL, d2);
+        cmc_assert_equals(size_t, 1000, v_total_cpy);
+
+        sd_free(d1);
+        sd_free(d2);
+
+        cmc_assert_equals(size_t, 2000, v_total_free);
+
+        v_total_cpy = 0;
+        v_total_free = 0;
+    });
+
+    CMC_CREATE_TEST(push_back_n pop_front_n, {
+        struct segdeque *d = sd_new(1, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        size_t total = sd_block * 5 + 3;
+        size_t *values = malloc(sizeof(size_t) * total);
+        size_t *out = malloc(sizeof(size_t) * total);
+
+        cmc_assert_not_equals(ptr, NULL, values);
+        cmc_assert_not_equals(ptr, NULL, out);
+
+        for (size_t i = 0; i < total; i++)
+            values[i] = i;
+
+        // Starts the copies in the middle of a block
+        for (size_t i = 0; i < sd_block + 7; i++)
+            cmc_assert(sd_push_back(d, i));
+
+        cmc_assert_equals(size_t, sd_block + 7, sd_pop_front_n(d, NULL, sd_block + 7));
+        cmc_assert(sd_empty(d));
+
+        for (size_t i = 0; i < 5; i++)
+            cmc_assert(sd_push_back(d, i));
+
+        cmc_assert_equals(size_t, 3, sd_pop_front_n(d, NULL, 3));
+
+        cmc_assert(sd_push_back_n(d, values, total));
+        cmc_assert_equals(size_t, total + 2, sd_count(d));
+        cmc_assert(sd_push_back_n(d, values, 0));
+
+        for (size_t i = 0; i < total + 2; i++)
+            cmc_assert_equals(size_t, i < 2 ? i + 3 : i - 2, sd_get(d, i));
+
+        cmc_assert_equals(size_t, 2, sd_pop_front_n(d, out, 2));
+        cmc_assert_equals(size_t, 3, out[0]);
+        cmc_assert_equals(size_t, 4, out[1]);
+
+        cmc_assert_equals(size_t, sd_block, sd_pop_front_n(d, out, sd_block));
+        cmc_assert_equals(size_t, sd_block, sd_front(d));
+
+        for (size_t i = 0; i < sd_block; i++)
+            cmc_assert_equals(size_t, i, out[i]);
+
+        cmc_assert_equals(size_t, total - sd_block, sd_pop_front_n(d, out, total));
+        cmc_assert(sd_empty(d));
+
+        for (size_t i = 0; i < total - sd_block; i++)
+            cmc_assert_equals(size_t, i + sd_block, out[i]);
+
+        cmc_assert_equals(size_t, 0, sd_pop_front_n(d, out, 1));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, sd_flag(d));
+
+        // Reuses the blocks kept by the pops
+        cmc_assert(sd_push_back_n(d, values, total));
+        cmc_assert_equals(size_t, total, sd_count(d));
+        cmc_assert_equals(size_t, 0, sd_front(d));
+        cmc_assert_equals(size_t, total - 1, sd_back(d));
+
+        free(values);
+        free(out);
+        sd_free(d);
+    });
+
+    CMC_CREATE_TEST(push_back_n pop_front_n[counter], {
+        struct segdeque *d = sd_new(1, sd_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        size_t values[10];
+
+        for (size_t i = 0; i < 10; i++)
+            values[i] = i;
+
+        v_total_free = 0;
+
+        cmc_assert(sd_push_back_n(d, values, 10));
+        cmc_assert_equals(size_t, 4, sd_pop_front_n(d, NULL, 4));
+
+        sd_free(d);
+
+        cmc_assert_equals(size_t, 6, v_total_free);
+
+        v_total_free = 0;
+    });
+});
+
+CMC_CREATE_UNIT(SegDequeIter, true, {
+    CMC_CREATE_TEST(PFX##_iter_next(), {
+        struct segdeque *d = sd_new(1, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        struct segdeque_iter it = sd_iter_start(d);
+
+        cmc_assert(!sd_iter_next(&it));
+
+        for (size_t i = 1; i <= 1000; i++)
+        {
+            if (i % 2 == 0)
+                sd_push_back(d, i);
+            else
+                sd_push_front(d, i);
+        }
+
+        size_t sum = 0;
+        for (it = sd_iter_start(d); !sd_iter_at_end(&it); sd_iter_next(&it))
+        {
+            cmc_assert_equals(ptr, sd_get_ref(d, sd_iter_index(&it)),
+                              sd_iter_rvalue(&it));
+
+            sum += sd_iter_value(&it);
+        }
+
+        cmc_assert_equals(size_t, 500500, sum);
+
+        sd_free(d);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_prev(), {
+        struct segdeque *d = sd_new(1, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        for (size_t i = 1; i <= 1000; i++)
+            sd_push_front(d, i);
+
+        size_t sum = 0;
+        struct segdeque_iter it = sd_iter_end(d);
+
+        do
+        {
+            sum += *sd_iter_rvalue(&it);
+        } while (sd_iter_prev(&it));
+
+        cmc_assert_equals(size_t, 500500, sum);
+        cmc_assert(sd_iter_at_start(&it));
+
+        sd_free(d);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_go_to(), {
+        struct segdeque *d = sd_new(1, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        for (size_t i = 0; i < 1000; i++)
+            sd_push_back(d, i);
+
+        // Moves the front away from the start of its block
+        for (size_t i = 0; i < 7; i++)
+            sd_pop_front(d);
+
+        struct segdeque_iter it = sd_iter_start(d);
+
+        for (size_t i = 0; i < 100; i++)
+        {
+            size_t index = (i * 373) % 993;
+
+            cmc_assert(sd_iter_go_to(&it, index));
+            cmc_assert_equals(size_t, index, sd_iter_index(&it));
+            cmc_assert_equals(size_t, index + 7, sd_iter_value(&it));
+        }
+
+        cmc_assert(!sd_iter_go_to(&it, 993));
+
+        sd_free(d);
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = SegDeque() + SegDequeIter();
+
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | SegDeque Suit : %-45s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
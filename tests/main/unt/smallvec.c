@@ -0,0 +1,493 @@
+#include "utl.c"
+#include "utl/assert.h"
+#include "utl/test.h"
+
+#include "../src/smallvec.c"
+
+struct smallvec_fval *sv_fval = &(struct smallvec_fval){ .cmp = cmc_size_cmp,
+                                                         .cpy = NULL,
+                                                         .str = cmc_size_str,
+                                                         .free = NULL,
+                                                         .hash = cmc_size_hash,
+                                                         .pri = cmc_size_cmp };
+
+struct smallvec_fval *sv_fval_counter =
+    &(struct smallvec_fval){ .cmp = v_c_cmp,
+                             .cpy = v_c_cpy,
+                             .str = v_c_str,
+                             .free = v_c_free,
+                             .hash = v_c_hash,
+                             .pri = v_c_pri };
+
+CMC_CREATE_UNIT(SmallVec, true, {
+    CMC_CREATE_TEST(new, {
+        struct smallvec *v = sv_new(1, sv_fval);
+
+        cmc_assert_not_equals(ptr, NULL, v);
+        cmc_assert_equals(ptr, NULL, v->buffer);
+        cmc_assert_equals(size_t, 8, sv_capacity(v));
+        cmc_assert_equals(size_t, 0, sv_count(v));
+        cmc_assert(sv_is_inline(v));
+
+        sv_free(v);
+    });
+
+    CMC_CREATE_TEST(new[capacity > N], {
+        struct smallvec *v = sv_new(1000, sv_fval);
+
+        cmc_assert_not_equals(ptr, NULL, v);
+        cmc_assert_not_equals(ptr, NULL, v->buffer);
+        cmc_assert_equals(size_t, 1000, sv_capacity(v));
+        cmc_assert(!sv_is_inline(v));
+
+        sv_free(v);
+    });
+
+    CMC_CREATE_TEST(new[capacity = 0], {
+        struct smallvec *v = sv_new(0, sv_fval);
+
+        cmc_assert_equals(ptr, NULL, v);
+    });
+
+    CMC_CREATE_TEST(new[capacity = UINT64_MAX], {
+        struct smallvec *v = sv_new(UINT64_MAX, sv_fval);
+
+        cmc_assert_equals(ptr, NULL, v);
+    });
+
+    CMC_CREATE_TEST(init, {
+        struct smallvec v = sv_init(4, sv_fval);
+
+        cmc_assert_not_equals(ptr, NULL, v.f_val);
+        cmc_assert_equals(size_t, 8, sv_capacity(&v));
+
+        for (size_t i = 0; i < 8; i++)
+            cmc_assert(sv_push_back(&v, i));
+
+        // A copy sees its own inline elements
+        struct smallvec copy = v;
+
+        cmc_assert(sv_pop_front(&v));
+        cmc_assert_equals(size_t, 1, sv_front(&v));
+        cmc_assert_equals(size_t, 0, sv_front(&copy));
+        cmc_assert_equals(size_t, 8, sv_count(&copy));
+
+        sv_release(v);
+    });
+
+    CMC_CREATE_TEST(init[capacity = 0], {
+        struct smallvec v = sv_init(0, sv_fval);
+
+        cmc_assert_equals(ptr, NULL, v.f_val);
+    });
+
+    CMC_CREATE_TEST(release[spilled], {
+        v_total_free = 0;
+
+        struct smallvec v = sv_init(1, sv_fval_counter);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(sv_push_back(&v, i));
+
+        cmc_assert(!sv_is_inline(&v));
+
+        sv_release(v);
+
+        cmc_assert_equals(int32_t, 100, v_total_free);
+
+        v_total_free = 0;
+    });
+
+    CMC_CREATE_TEST(clear[count capacity], {
+        struct smallvec *v = sv_new(1, sv_fval);
+
+        cmc_assert_not_equals(ptr, NULL, v);
+
+        for (size_t i = 0; i < 50; i++)
+            sv_push_back(v, i);
+
+        cmc_assert_equals(size_t, 50, sv_count(v));
+
+        size_t capacity = sv_capacity(v);
+
+        sv_clear(v);
+
+        cmc_assert_equals(size_t, 0, sv_count(v));
+        cmc_assert_equals(size_t, capacity, sv_capacity(v));
+
+        sv_free(v);
+    });
+
+    CMC_CREATE_TEST(buffer_growth[capacity = 1], {
+        struct smallvec *v = sv_new(1, sv_fval);
+
+        cmc_assert_not_equals(ptr, NULL, v);
+
+        for (size_t i = 0; i < 8; i++)
+            sv_push_back(v, i);
+
+        cmc_assert(sv_is_inline(v));
+        cmc_assert_equals(size_t, 8, sv_capacity(v));
+
+        for (size_t i = 8; i < 100; i++)
+            sv_push_back(v, i);
+
+        cmc_assert(!sv_is_inline(v));
+        cmc_assert_equals(size_t, 100, sv_count(v));
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert_equals(size_t, i, sv_get(v, i));
+
+        sv_free(v);
+    });
+
+    CMC_CREATE_TEST(push_front[item preservation], {
+        struct smallvec *v = sv_new(1, sv_fval);
+
+        cmc_assert_not_equals(ptr, NULL, v);
+
+        for (size_t i = 0; i < 20; i++)
+            cmc_assert(sv_push_front(v, i));
+
+        for (size_t i = 0; i < 20; i++)
+            cmc_assert_equals(size_t, 19 - i, sv_get(v, i));
+
+        sv_free(v);
+    });
+
+    CMC_CREATE_TEST(push_at[item preservation], {
+        struct smallvec *v = sv_new(1, sv_fval);
+
+        cmc_assert_not_equals(ptr, NULL, v);
+
+        cmc_assert(sv_push_back(v, 0));
+        cmc_assert(sv_push_back(v, 19));
+
+        for (size_t i = 1; i < 19; i++)
+            cmc_assert(sv_push_at(v, i, i));
+
+        for (size_t i = 0; i < 20; i++)
+            cmc_assert_equals(size_t, i, sv_get(v, i));
+
+        cmc_assert(!sv_push_at(v, 100, 21));
+        cmc_assert_equals(int32_t, cmc_flags.RANGE, sv_flag(v));
+
+        sv_free(v);
+    });
+
+    CMC_CREATE_TEST(pop[inline and spilled], {
+        struct smallvec *v = sv_new(1, sv_fval);
+
+        cmc_assert_not_equals(ptr, NULL, v);
+
+        cmc_assert(!sv_pop_front(v));
+        cmc_assert(!sv_pop_back(v));
+        cmc_assert(!sv_pop_at(v, 0));
+
+        for (size_t i = 0; i < 20; i++)
+            cmc_assert(sv_push_back(v, i));
+
+        cmc_assert(sv_pop_front(v));
+        cmc_assert(sv_pop_back(v));
+        cmc_assert(sv_pop_at(v, 9));
+
+        cmc_assert_equals(size_t, 17, sv_count(v));
+        cmc_assert_equals(size_t, 1, sv_front(v));
+        cmc_assert_equals(size_t, 18, sv_back(v));
+        cmc_assert_equals(size_t, 11, sv_get(v, 9));
+
+        sv_free(v);
+    });
+
+    CMC_CREATE_TEST(seq_push, {
+        struct smallvec *v = sv_new(1, sv_fval);
+
+        cmc_assert_not_equals(ptr, NULL, v);
+
+        size_t values[20];
+
+        for (size_t i = 0; i < 20; i++)
+            values[i] = i;
+
+        cmc_assert(sv_seq_push_back(v, values + 5, 2));
+        cmc_assert(sv_seq_push_front(v, values, 5));
+        cmc_assert(sv_is_inline(v));
+
+        cmc_assert(sv_seq_push_back(v, values + 10, 10));
+        cmc_assert(sv_seq_push_at(v, values + 7, 3, 7));
+        cmc_assert(!sv_is_inline(v));
+
+        cmc_assert_equals(size_t, 20, sv_count(v));
+
+        for (size_t i = 0; i < 20; i++)
+            cmc_assert_equals(size_t, i, sv_get(v, i));
+
+        cmc_assert(!sv_seq_push_back(v, values, 0));
+        cmc_assert_equals(int32_t, cmc_flags.INVALID, sv_flag(v));
+
+        sv_free(v);
+    });
+
+    CMC_CREATE_TEST(seq_pop_at, {
+        struct smallvec *v = sv_new(1, sv_fval);
+
+        cmc_assert_not_equals(ptr, NULL, v);
+
+        for (size_t i = 0; i < 20; i++)
+            cmc_assert(sv_push_back(v, i));
+
+        cmc_assert(sv_seq_pop_at(v, 5, 14));
+
+        cmc_assert_equals(size_t, 10, sv_count(v));
+        cmc_assert_equals(size_t, 4, sv_get(v, 4));
+        cmc_assert_equals(size_t, 15, sv_get(v, 5));
+
+        cmc_assert(!sv_seq_pop_at(v, 5, 10));
+        cmc_assert_equals(int32_t, cmc_flags.RANGE, sv_flag(v));
+
+        sv_free(v);
+    });
+
+    CMC_CREATE_TEST(seq_sublist, {
+        struct smallvec *v = sv_new(1, sv_fval);
+
+        cmc_assert_not_equals(ptr, NULL, v);
+
+        for (size_t i = 0; i < 20; i++)
+            cmc_assert(sv_push_back(v, i));
+
+        struct smallvec *s = sv_seq_sublist(v, 10, 13);
+
+        cmc_assert_not_equals(ptr, NULL, s);
+        cmc_assert(sv_is_inline(s));
+        cmc_assert_equals(size_t, 4, sv_count(s));
+        cmc_assert_equals(size_t, 16, sv_count(v));
+
+        for (size_t i = 0; i < 4; i++)
+            cmc_assert_equals(size_t, 10 + i, sv_get(s, i));
+
+        cmc_assert_equals(size_t, 14, sv_get(v, 10));
+
+        sv_free(s);
+        sv_free(v);
+    });
+
+    CMC_CREATE_TEST(contains index_of, {
+        struct smallvec *v = sv_new(1, sv_fval);
+
+        cmc_assert_not_equals(ptr, NULL, v);
+
+        for (size_t i = 0; i < 20; i++)
+            cmc_assert(sv_push_back(v, i % 10));
+
+        cmc_assert(sv_contains(v, 9));
+        cmc_assert(!sv_contains(v, 10));
+        cmc_assert_equals(size_t, 3, sv_index_of(v, 3, true));
+        cmc_assert_equals(size_t, 13, sv_index_of(v, 3, false));
+        cmc_assert_equals(size_t, 20, sv_index_of(v, 10, true));
+
+        sv_free(v);
+    });
+
+    CMC_CREATE_TEST(resize, {
+        struct smallvec *v = sv_new(1, sv_fval);
+
+        cmc_assert_not_equals(ptr, NULL, v);
+
+        for (size_t i = 0; i < 6; i++)
+            cmc_assert(sv_push_back(v, i));
+
+        cmc_assert(sv_resize(v, 100));
+        cmc_assert(!sv_is_inline(v));
+        cmc_assert_equals(size_t, 100, sv_capacity(v));
+
+        cmc_assert(sv_resize(v, 50));
+        cmc_assert(!sv_is_inline(v));
+
+        // Back to the inline storage
+        cmc_assert(sv_resize(v, 1));
+        cmc_assert(sv_is_inline(v));
+        cmc_assert_equals(ptr, NULL, v->buffer);
+        cmc_assert_equals(size_t, 8, sv_capacity(v));
+
+        for (size_t i = 0; i < 6; i++)
+            cmc_assert_equals(size_t, i, sv_get(v, i));
+
+        for (size_t i = 6; i < 20; i++)
+            cmc_assert(sv_push_back(v, i));
+
+        cmc_assert(!sv_resize(v, 10));
+        cmc_assert_equals(int32_t, cmc_flags.INVALID, sv_flag(v));
+
+        sv_free(v);
+    });
+
+    CMC_CREATE_TEST(sort, {
+        struct smallvec *v = sv_new(1, sv_fval);
+
+        cmc_assert_not_equals(ptr, NULL, v);
+
+        for (size_t i = 0; i < 8; i++)
+            cmc_assert(sv_push_back(v, 7 - i));
+
+        sv_sort(v);
+
+        for (size_t i = 0; i < 8; i++)
+            cmc_assert_equals(size_t, i, sv_get(v, i));
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(sv_push_back(v, (i * 37) % 100));
+
+        cmc_assert(sv_sort_range(v, 8, 107));
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert_equals(size_t, i, sv_get(v, i + 8));
+
+        sv_free(v);
+    });
+
+    CMC_CREATE_TEST(copy_of equals, {
+        struct smallvec *v = sv_new(1, sv_fval);
+
+        cmc_assert_not_equals(ptr, NULL, v);
+
+        for (size_t i = 0; i < 5; i++)
+            cmc_assert(sv_push_back(v, i));
+
+        struct smallvec *c = sv_copy_of(v);
+
+        cmc_assert_not_equals(ptr, NULL, c);
+        cmc_assert(sv_is_inline(c));
+        cmc_assert(sv_equals(v, c));
+
+        for (size_t i = 5; i < 50; i++)
+            cmc_assert(sv_push_back(v, i));
+
+        cmc_assert(!sv_equals(v, c));
+
+        sv_free(c);
+
+        c = sv_copy_of(v);
+
+        cmc_assert_not_equals(ptr, NULL, c);
+        cmc_assert(!sv_is_inline(c));
+        cmc_assert(sv_equals(v, c));
+
+        sv_free(c);
+        sv_free(v);
+    });
+
+    CMC_CREATE_TEST(reserve shrink_to_fit, {
+        struct smallvec *x = sv_new(1, sv_fval);
+
+        cmc_assert_not_equals(ptr, NULL, x);
+
+        for (size_t i = 0; i < 10; i++)
+            cmc_assert(sv_push_back(x, i));
+
+        cmc_assert(sv_reserve(x, 90));
+        cmc_assert_lesser_equals(size_t, sv_capacity(x), 100);
+
+        cmc_assert(sv_shrink_to_fit(x));
+        cmc_assert_equals(size_t, 10, sv_count(x));
+        cmc_assert_equals(size_t, 10, sv_capacity(x));
+
+        cmc_assert(sv_seq_pop_at(x, 0, 4));
+        cmc_assert(sv_shrink_to_fit(x));
+        cmc_assert(sv_is_inline(x));
+        cmc_assert_equals(size_t, 5, sv_get(x, 0));
+
+        sv_free(x);
+    });
+});
+
+CMC_CREATE_UNIT(SmallVecIter, true, {
+    CMC_CREATE_TEST(PFX##_iter_next(), {
+        struct smallvec *v = sv_new(1, sv_fval);
+
+        cmc_assert_not_equals(ptr, NULL, v);
+
+        struct smallvec_iter it = sv_iter_start(v);
+
+        cmc_assert(!sv_iter_next(&it));
+
+        for (size_t i = 1; i <= 1000; i++)
+        {
+            if (i % 2 == 0)
+                sv_push_back(v, i);
+            else
+                sv_push_front(v, i);
+        }
+
+        size_t sum = 0;
+        for (it = sv_iter_start(v); !sv_iter_at_end(&it); sv_iter_next(&it))
+        {
+            sum += sv_iter_value(&it);
+        }
+
+        cmc_assert_equals(size_t, 500500, sum);
+
+        sv_free(v);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_prev(), {
+        struct smallvec *v = sv_new(1, sv_fval);
+
+        cmc_assert_not_equals(ptr, NULL, v);
+
+        for (size_t i = 1; i <= 5; i++)
+            sv_push_back(v, i);
+
+        size_t sum = 0;
+        struct smallvec_iter it = sv_iter_end(v);
+
+        do
+        {
+            sum += *sv_iter_rvalue(&it);
+        } while (sv_iter_prev(&it));
+
+        cmc_assert_equals(size_t, 15, sum);
+        cmc_assert(sv_iter_at_start(&it));
+
+        sv_free(v);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_go_to(), {
+        struct smallvec *v = sv_new(1, sv_fval);
+
+        cmc_assert_not_equals(ptr, NULL, v);
+
+        for (size_t i = 0; i < 100; i++)
+            sv_push_back(v, i);
+
+        struct smallvec_iter it = sv_iter_start(v);
+
+        cmc_assert(sv_iter_go_to(&it, 50));
+        cmc_assert_equals(size_t, 50, sv_iter_index(&it));
+        cmc_assert_equals(size_t, 50, sv_iter_value(&it));
+
+        cmc_assert(sv_iter_go_to(&it, 7));
+        cmc_assert_equals(size_t, 7, sv_iter_value(&it));
+
+        cmc_assert(!sv_iter_go_to(&it, 100));
+
+        sv_free(v);
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = SmallVec() + SmallVecIter();
+
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | SmallVec Suit : %-45s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
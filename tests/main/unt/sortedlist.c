@@ -1,9 +1,13 @@
 #include "utl.c"
 #include "utl/assert.h"
+#include "utl/condvar.h"
 #include "utl/test.h"
+#include "utl/thread.h"
 
 #include "../src/sortedlist.c"
 
+CMC_GENERATE_SORTEDLIST_PARALLEL(sl, sortedlist, size_t)
+
 struct sortedlist_fval *sl_fval =
     &(struct sortedlist_fval){ .cmp = cmc_size_cmp,
                                .cpy = NULL,
@@ -12,6 +16,17 @@ struct sortedlist_fval *sl_fval =
                                .hash = cmc_size_hash,
                                .pri = cmc_size_cmp };
 
+CMC_GENERATE_SORTEDLIST_RADIX(rsl, radix_sortedlist, size_t, uint64_t,
+                              cmc_size_key)
+
+struct radix_sortedlist_fval *rsl_fval =
+    &(struct radix_sortedlist_fval){ .cmp = cmc_size_cmp,
+                                     .cpy = NULL,
+                                     .str = cmc_size_str,
+                                     .free = NULL,
+                                     .hash = cmc_size_hash,
+                                     .pri = cmc_size_cmp };
+
 CMC_CREATE_UNIT(SortedList, true, {
     CMC_CREATE_TEST(new, {
         struct sortedlist *sl = sl_new(1000000, sl_fval);
@@ -82,6 +97,95 @@ CMC_CREATE_UNIT(SortedList, true, {
         sl_free(sl);
     });
 
+    CMC_CREATE_TEST(insert[tail], {
+        struct sortedlist *sl = sl_new(100, sl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, sl);
+
+        // Values inserted in order don't need to be sorted
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(sl_insert(sl, i * 10));
+
+        cmc_assert(sl->is_sorted);
+        cmc_assert_equals(size_t, 1000, sl->sorted);
+
+        cmc_assert(sl_insert(sl, 5));
+        cmc_assert(sl_insert(sl, 9999));
+
+        cmc_assert(!sl->is_sorted);
+        cmc_assert_equals(size_t, 1000, sl->sorted);
+
+        cmc_assert_equals(size_t, 5, sl_get(sl, 1));
+        cmc_assert_equals(size_t, 9999, sl_max(sl));
+        cmc_assert_equals(size_t, 1002, sl->sorted);
+
+        // Small tails are galloped into place and large ones are merged
+        size_t seed = 42;
+        for (size_t tail = 1; tail <= 100000; tail *= 10)
+        {
+            for (size_t i = 0; i < tail; i++)
+            {
+                seed = seed * 6364136223846793005 + 1442695040888963407;
+
+                cmc_assert(sl_insert(sl, (seed >> 33) % 20000));
+            }
+
+            // Values not less than the last one can extend the sorted ones
+            cmc_assert(sl->sorted >= sl_count(sl) - tail);
+
+            sl_sort(sl);
+
+            cmc_assert(sl->is_sorted);
+
+            for (size_t i = 1; i < sl_count(sl); i++)
+                cmc_assert_lesser_equals(size_t, sl_get(sl, i),
+                                         sl_get(sl, i - 1));
+        }
+
+        // Removing from the sorted elements or the tail
+        cmc_assert(sl_insert(sl, 0));
+        cmc_assert(sl_remove(sl, sl_count(sl) - 1));
+        cmc_assert(sl->is_sorted);
+        cmc_assert(sl_insert(sl, 0));
+        cmc_assert(sl_remove(sl, 0));
+        cmc_assert(!sl->is_sorted);
+        cmc_assert_equals(size_t, sl_count(sl) - 1, sl->sorted);
+
+        sl_free(sl);
+    });
+
+    CMC_CREATE_TEST(set_eager, {
+        struct sortedlist *sl = sl_new(100, sl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, sl);
+
+        cmc_assert(sl_insert(sl, 10));
+        cmc_assert(sl_insert(sl, 5));
+
+        sl_set_eager(sl, true);
+
+        size_t seed = 42;
+
+        for (size_t i = 0; i < 1000; i++)
+        {
+            seed = seed * 6364136223846793005 + 1442695040888963407;
+
+            cmc_assert(sl_insert(sl, (seed >> 33) % 100));
+            cmc_assert(sl->is_sorted);
+        }
+
+        for (size_t i = 1; i < sl_count(sl); i++)
+            cmc_assert_lesser_equals(size_t, sl->buffer[i], sl->buffer[i - 1]);
+
+        sl_set_eager(sl, false);
+
+        cmc_assert(sl_insert(sl, 0));
+        cmc_assert(!sl->is_sorted);
+        cmc_assert_equals(size_t, 0, sl_min(sl));
+
+        sl_free(sl);
+    });
+
     CMC_CREATE_TEST(remove, {
         struct sortedlist *sl = sl_new(100, sl_fval);
 
@@ -311,6 +415,117 @@ CMC_CREATE_UNIT(SortedList, true, {
         total_delete = 0;
         total_resize = 0;
     });
+
+    CMC_CREATE_TEST(sort[patterns], {
+        struct sortedlist *sl = sl_new(100, sl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, sl);
+
+        // Sawtooth, organ pipe and many duplicates
+        for (size_t pattern = 0; pattern < 3; pattern++)
+        {
+            sl_clear(sl);
+
+            for (size_t i = 0; i < 100000; i++)
+            {
+                if (pattern == 0)
+                    cmc_assert(sl_insert(sl, i % 1000));
+                else if (pattern == 1)
+                    cmc_assert(sl_insert(sl, i < 50000 ? i : 100000 - i));
+                else
+                    cmc_assert(sl_insert(sl, i % 3));
+            }
+
+            sl_sort(sl);
+
+            for (size_t i = 1; i < sl_count(sl); i++)
+                cmc_assert_lesser_equals(size_t, sl_get(sl, i),
+                                         sl_get(sl, i - 1));
+        }
+
+        cmc_assert_equals(size_t, 0, sl_min(sl));
+        cmc_assert_equals(size_t, 2, sl_max(sl));
+
+        sl_free(sl);
+    });
+
+    CMC_CREATE_TEST(sort[radix], {
+        struct radix_sortedlist *sl = rsl_new(100, rsl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, sl);
+
+        size_t seed = 42;
+
+        for (size_t i = 0; i < 100000; i++)
+        {
+            seed = seed * 6364136223846793005 + 1442695040888963407;
+
+            cmc_assert(rsl_insert(sl, seed >> 20));
+        }
+
+        cmc_assert(rsl_insert(sl, 0));
+        cmc_assert(rsl_insert(sl, SIZE_MAX));
+
+        rsl_sort(sl);
+
+        for (size_t i = 1; i < rsl_count(sl); i++)
+            cmc_assert_lesser_equals(size_t, rsl_get(sl, i),
+                                     rsl_get(sl, i - 1));
+
+        cmc_assert_equals(size_t, 0, rsl_min(sl));
+        cmc_assert_equals(size_t, SIZE_MAX, rsl_max(sl));
+        cmc_assert(rsl_contains(sl, 0));
+
+        rsl_free(sl);
+    });
+
+    CMC_CREATE_TEST(sort_parallel, {
+        struct sortedlist *sl = sl_new(100, sl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, sl);
+
+        size_t seed = 42;
+
+        for (size_t i = 0; i < 100000; i++)
+        {
+            seed = seed * 6364136223846793005 + 1442695040888963407;
+
+            cmc_assert(sl_insert(sl, seed % 100000));
+        }
+
+        cmc_assert(sl_insert(sl, 100000));
+
+        sl_sort_parallel(sl, 4);
+
+        cmc_assert(sl->is_sorted);
+        cmc_assert_equals(int32_t, cmc_flags.OK, sl_flag(sl));
+
+        for (size_t i = 1; i < sl_count(sl); i++)
+            cmc_assert_lesser_equals(size_t, sl_get(sl, i), sl_get(sl, i - 1));
+
+        cmc_assert_equals(size_t, 100000, sl_max(sl));
+
+        sl_free(sl);
+    });
+
+    CMC_CREATE_TEST(reserve shrink_to_fit, {
+        struct sortedlist *x = sl_new(1, sl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, x);
+
+        for (size_t i = 0; i < 10; i++)
+            cmc_assert(sl_insert(x, 9 - i));
+
+        cmc_assert(sl_reserve(x, 90));
+        cmc_assert_lesser_equals(size_t, sl_capacity(x), 100);
+
+        cmc_assert(sl_shrink_to_fit(x));
+        cmc_assert_equals(size_t, 10, sl_count(x));
+        cmc_assert_equals(size_t, 10, sl_capacity(x));
+        cmc_assert_equals(size_t, 0, sl_min(x));
+
+        sl_free(x);
+    });
 });
 
 CMC_CREATE_UNIT(SortedListIter, true, {
@@ -0,0 +1,327 @@
+#include "utl.c"
+#include "utl/assert.h"
+#include "utl/test.h"
+#include "utl/thread.h"
+
+#include "../src/spscqueue.c"
+
+struct spscqueue_fval *spq_fval =
+    &(struct spscqueue_fval){ .cmp = cmc_size_cmp,
+                              .cpy = NULL,
+                              .str = cmc_size_str,
+                              .free = NULL,
+                              .hash = cmc_size_hash,
+                              .pri = cmc_size_cmp };
+
+struct spscqueue_fval *spq_fval_counter =
+    &(struct spscqueue_fval){ .cmp = v_c_cmp,
+                              .cpy = v_c_cpy,
+                              .str = v_c_str,
+                              .free = v_c_free,
+                              .hash = v_c_hash,
+                              .pri = v_c_pri };
+
+/* Amount of elements passed between the threads */
+const size_t spq_total = 20000;
+
+/* Enqueues 0 .. spq_total - 1 in batches of varying sizes */
+int spq_producer(void *args)
+{
+    struct spscqueue *q = args;
+    size_t batch[64];
+    size_t next = 0;
+
+    while (next < spq_total)
+    {
+        size_t n = next % 64 + 1;
+
+        if (n > spq_total - next)
+            n = spq_total - next;
+
+        for (size_t i = 0; i < n; i++)
+            batch[i] = next + i;
+
+        size_t sent = 0;
+
+        if (n == 1)
+        {
+            while (!spq_try_enqueue(q, batch[0]))
+                ;
+            sent = 1;
+        }
+        else
+        {
+            while (sent < n)
+                sent += spq_try_enqueue_n(q, batch + sent, n - sent);
+        }
+
+        next += sent;
+    }
+
+    return 0;
+}
+
+/* Returns how many elements were dequeued out of order */
+int spq_consumer(void *args)
+{
+    struct spscqueue *q = args;
+    size_t batch[48];
+    size_t next = 0;
+    int errors = 0;
+
+    while (next < spq_total)
+    {
+        size_t n = 0;
+
+        if (next % 3 == 0)
+            n = spq_try_dequeue(q, batch) ? 1 : 0;
+        else
+            n = spq_try_dequeue_n(q, batch, 48);
+
+        for (size_t i = 0; i < n; i++)
+        {
+            if (batch[i] != next++)
+                errors++;
+        }
+    }
+
+    return errors;
+}
+
+CMC_CREATE_UNIT(SPSCQueue, true, {
+    CMC_CREATE_TEST(new, {
+        struct spscqueue *q = spq_new(1000, spq_fval);
+
+        cmc_assert_not_equals(ptr, NULL, q);
+        cmc_assert_not_equals(ptr, NULL, q->buffer);
+        cmc_assert_equals(size_t, 0, spq_count(q));
+        cmc_assert_equals(size_t, 1024, spq_capacity(q));
+        cmc_assert_equals(int32_t, cmc_flags.OK, spq_flag(q));
+
+        spq_free(q);
+    });
+
+    CMC_CREATE_TEST(new[capacity = 0], {
+        struct spscqueue *q = spq_new(0, spq_fval);
+
+        cmc_assert_equals(ptr, NULL, q);
+    });
+
+    CMC_CREATE_TEST(new[capacity = 1], {
+        struct spscqueue *q = spq_new(1, spq_fval);
+
+        cmc_assert_not_equals(ptr, NULL, q);
+        cmc_assert_equals(size_t, 1, spq_capacity(q));
+
+        cmc_assert(spq_try_enqueue(q, 10));
+        cmc_assert(!spq_try_enqueue(q, 11));
+        cmc_assert(spq_full(q));
+
+        size_t value = 0;
+
+        cmc_assert(spq_try_dequeue(q, &value));
+        cmc_assert_equals(size_t, 10, value);
+        cmc_assert(!spq_try_dequeue(q, &value));
+        cmc_assert(spq_empty(q));
+
+        spq_free(q);
+    });
+
+    CMC_CREATE_TEST(new[capacity = UINT64_MAX], {
+        struct spscqueue *q = spq_new(UINT64_MAX, spq_fval);
+
+        cmc_assert_equals(ptr, NULL, q);
+    });
+
+    CMC_CREATE_TEST(new[f_val = NULL], {
+        struct spscqueue *q = spq_new(1000, NULL);
+
+        cmc_assert_equals(ptr, NULL, q);
+    });
+
+    CMC_CREATE_TEST(clear[count capacity], {
+        struct spscqueue *q = spq_new(100, spq_fval);
+
+        cmc_assert_not_equals(ptr, NULL, q);
+
+        for (size_t i = 0; i < 50; i++)
+            cmc_assert(spq_try_enqueue(q, i));
+
+        cmc_assert_equals(size_t, 50, spq_count(q));
+
+        spq_clear(q);
+
+        cmc_assert_equals(size_t, 0, spq_count(q));
+        cmc_assert_equals(size_t, 128, spq_capacity(q));
+
+        spq_free(q);
+    });
+
+    CMC_CREATE_TEST(try_enqueue try_dequeue, {
+        struct spscqueue *q = spq_new(8, spq_fval);
+
+        cmc_assert_not_equals(ptr, NULL, q);
+
+        size_t value = 0;
+
+        cmc_assert(!spq_try_dequeue(q, &value));
+        cmc_assert(!spq_try_peek(q, &value));
+
+        // Goes around the buffer a few times
+        for (size_t i = 0; i < 100; i++)
+        {
+            cmc_assert(spq_try_enqueue(q, i));
+            cmc_assert(spq_try_enqueue(q, i + 1000));
+
+            cmc_assert(spq_try_peek(q, &value));
+            cmc_assert_equals(size_t, i, value);
+
+            cmc_assert(spq_try_dequeue(q, &value));
+            cmc_assert_equals(size_t, i, value);
+            cmc_assert(spq_try_dequeue(q, NULL));
+        }
+
+        for (size_t i = 0; i < 8; i++)
+            cmc_assert(spq_try_enqueue(q, i));
+
+        cmc_assert(spq_full(q));
+        cmc_assert(!spq_try_enqueue(q, 8));
+        cmc_assert_equals(size_t, 8, spq_count(q));
+
+        for (size_t i = 0; i < 8; i++)
+        {
+            cmc_assert(spq_try_dequeue(q, &value));
+            cmc_assert_equals(size_t, i, value);
+        }
+
+        cmc_assert(spq_empty(q));
+
+        spq_free(q);
+    });
+
+    CMC_CREATE_TEST(try_enqueue_n try_dequeue_n[wrap around], {
+        struct spscqueue *q = spq_new(16, spq_fval);
+
+        cmc_assert_not_equals(ptr, NULL, q);
+
+        size_t values[20];
+        size_t out[20];
+
+        for (size_t i = 0; i < 20; i++)
+            values[i] = i + 100;
+
+        cmc_assert_equals(size_t, 0, spq_try_dequeue_n(q, out, 20));
+
+        // Moves the head and tail close to the end of the buffer
+        cmc_assert_equals(size_t, 12, spq_try_enqueue_n(q, values, 12));
+        cmc_assert_equals(size_t, 12, spq_try_dequeue_n(q, NULL, 12));
+
+        // Only as many as there is space for
+        cmc_assert_equals(size_t, 16, spq_try_enqueue_n(q, values, 20));
+        cmc_assert_equals(size_t, 0, spq_try_enqueue_n(q, values, 20));
+        cmc_assert(spq_full(q));
+
+        cmc_assert_equals(size_t, 10, spq_try_dequeue_n(q, out, 10));
+
+        for (size_t i = 0; i < 10; i++)
+            cmc_assert_equals(size_t, i + 100, out[i]);
+
+        cmc_assert_equals(size_t, 6, spq_try_dequeue_n(q, out, 20));
+
+        for (size_t i = 0; i < 6; i++)
+            cmc_assert_equals(size_t, i + 110, out[i]);
+
+        cmc_assert(spq_empty(q));
+        cmc_assert_equals(size_t, 0, spq_try_enqueue_n(q, values, 0));
+
+        spq_free(q);
+    });
+
+    CMC_CREATE_TEST(free[counter], {
+        struct spscqueue *q = spq_new(100, spq_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, q);
+
+        v_total_free = 0;
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(spq_try_enqueue(q, i));
+
+        cmc_assert_equals(size_t, 40, spq_try_dequeue_n(q, NULL, 40));
+
+        spq_free(q);
+
+        cmc_assert_equals(int32_t, 60, v_total_free);
+
+        v_total_free = 0;
+    });
+
+    CMC_CREATE_TEST(callbacks, {
+        struct spscqueue *q = spq_new_custom(32, spq_fval, NULL, callbacks);
+
+        cmc_assert_not_equals(ptr, NULL, q);
+
+        size_t values[10] = { 0 };
+        size_t value;
+
+        total_create = 0;
+        total_read = 0;
+        total_delete = 0;
+
+        // Bulk functions call each callback once per batch
+        cmc_assert(spq_try_enqueue(q, 1));
+        cmc_assert_equals(size_t, 10, spq_try_enqueue_n(q, values, 10));
+        cmc_assert_equals(int32_t, 2, total_create);
+
+        cmc_assert(spq_try_peek(q, &value));
+        cmc_assert_equals(int32_t, 1, total_read);
+
+        cmc_assert(spq_try_dequeue(q, &value));
+        cmc_assert_equals(size_t, 10, spq_try_dequeue_n(q, values, 10));
+        cmc_assert_equals(int32_t, 2, total_delete);
+
+        spq_free(q);
+
+        total_create = 0;
+        total_read = 0;
+        total_delete = 0;
+    });
+
+    CMC_CREATE_TEST(threads, {
+        struct spscqueue *q = spq_new(256, spq_fval);
+
+        cmc_assert_not_equals(ptr, NULL, q);
+
+        struct cmc_thread producer;
+        struct cmc_thread consumer;
+        int errors = -1;
+
+        cmc_assert(cmc_thrd_create(&consumer, spq_consumer, q));
+        cmc_assert(cmc_thrd_create(&producer, spq_producer, q));
+
+        cmc_assert(cmc_thrd_join(&producer, NULL));
+        cmc_assert(cmc_thrd_join(&consumer, &errors));
+
+        cmc_assert_equals(int32_t, 0, errors);
+        cmc_assert(spq_empty(q));
+
+        spq_free(q);
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = SPSCQueue();
+
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | SPSCQueue Suit : %-44s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
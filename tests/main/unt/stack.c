@@ -4,6 +4,8 @@
 
 #include "../src/stack.c"
 
+CMC_GENERATE_STACK_POD(ps, pod_stack, uint8_t)
+
 struct stack_fval *s_fval = &(struct stack_fval){ .cmp = cmc_size_cmp,
                                                   .cpy = NULL,
                                                   .str = cmc_size_str,
@@ -11,6 +13,13 @@ struct stack_fval *s_fval = &(struct stack_fval){ .cmp = cmc_size_cmp,
                                                   .hash = cmc_size_hash,
                                                   .pri = cmc_size_cmp };
 
+struct pod_stack_fval *ps_fval = &(struct pod_stack_fval){ .cmp = cmc_u8_cmp,
+                                                           .cpy = NULL,
+                                                           .str = cmc_u8_str,
+                                                           .free = NULL,
+                                                           .hash = cmc_u8_hash,
+                                                           .pri = cmc_u8_cmp };
+
 CMC_CREATE_UNIT(Stack, true, {
     CMC_CREATE_TEST(new, {
         struct stack *s = s_new(1000000, s_fval);
@@ -221,6 +230,23 @@ CMC_CREATE_UNIT(Stack, true, {
         s_free(s);
     });
 
+    CMC_CREATE_TEST(contains[pod], {
+        struct pod_stack *s = ps_new(100, ps_fval);
+
+        cmc_assert_not_equals(ptr, NULL, s);
+
+        for (uint8_t i = 0; i < 200; i++)
+            cmc_assert(ps_push(s, i));
+
+        for (uint8_t i = 0; i < 200; i++)
+            cmc_assert(ps_contains(s, i));
+
+        cmc_assert(!ps_contains(s, 200));
+        cmc_assert(!ps_contains(s, 255));
+
+        ps_free(s);
+    });
+
     CMC_CREATE_TEST(contains[count = 0], {
         struct stack *s = s_new(100, s_fval);
 
@@ -403,6 +429,25 @@ CMC_CREATE_UNIT(Stack, true, {
         total_delete = 0;
         total_resize = 0;
     });
+
+    CMC_CREATE_TEST(reserve shrink_to_fit, {
+        struct stack *x = s_new(1, s_fval);
+
+        cmc_assert_not_equals(ptr, NULL, x);
+
+        for (size_t i = 0; i < 10; i++)
+            cmc_assert(s_push(x, i));
+
+        cmc_assert(s_reserve(x, 90));
+        cmc_assert_lesser_equals(size_t, s_capacity(x), 100);
+
+        cmc_assert(s_shrink_to_fit(x));
+        cmc_assert_equals(size_t, 10, s_count(x));
+        cmc_assert_equals(size_t, 10, s_capacity(x));
+        cmc_assert_equals(size_t, 9, s_top(x));
+
+        s_free(x);
+    });
 });
 
 CMC_CREATE_UNIT(StackIter, true, {
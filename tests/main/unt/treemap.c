@@ -18,6 +18,20 @@ struct treemap_fval *tm_fval = &(struct treemap_fval){ .cmp = cmc_size_cmp,
                                                        .hash = cmc_size_hash,
                                                        .pri = cmc_size_cmp };
 
+struct treemap_fkey *tm_fkey_counter = &(struct treemap_fkey){ .cmp = k_c_cmp,
+                                                               .cpy = k_c_cpy,
+                                                               .str = k_c_str,
+                                                               .free = k_c_free,
+                                                               .hash = k_c_hash,
+                                                               .pri = k_c_pri };
+
+struct treemap_fval *tm_fval_counter = &(struct treemap_fval){ .cmp = v_c_cmp,
+                                                               .cpy = v_c_cpy,
+                                                               .str = v_c_str,
+                                                               .free = v_c_free,
+                                                               .hash = v_c_hash,
+                                                               .pri = v_c_pri };
+
 CMC_CREATE_UNIT(TreeMap, true, {
     CMC_CREATE_TEST(new, {
         struct treemap *map = tm_new(tm_fkey, tm_fval);
@@ -211,6 +225,223 @@ CMC_CREATE_UNIT(TreeMap, true, {
 
         tm_free(map);
     });
+
+    CMC_CREATE_TEST(rank[select], {
+        struct treemap *map = tm_new(tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t key;
+        size_t value;
+
+        cmc_assert_equals(size_t, 0, tm_rank(map, 10));
+        cmc_assert(!tm_select(map, 0, &key, &value));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, tm_flag(map));
+
+        // 7919 and 10007 are primes so every key in [0, 10007) is generated
+        for (size_t i = 0; i < 10007; i++)
+            cmc_assert(tm_insert(map, ((i * 7919) % 10007) * 2, i));
+
+        cmc_assert_equals(size_t, 10007, map->root->size);
+
+        for (size_t i = 0; i < 10007; i++)
+        {
+            cmc_assert_equals(size_t, i, tm_rank(map, i * 2));
+            cmc_assert_equals(size_t, i + 1, tm_rank(map, i * 2 + 1));
+
+            cmc_assert(tm_select(map, i, &key, &value));
+            cmc_assert_equals(size_t, i * 2, key);
+            cmc_assert_equals(size_t, i * 2, ((value * 7919) % 10007) * 2);
+        }
+
+        cmc_assert(!tm_select(map, 10007, &key, &value));
+        cmc_assert_equals(int32_t, cmc_flags.RANGE, tm_flag(map));
+
+        // Remove every key that is a multiple of 4
+        for (size_t i = 0; i < 10007; i += 2)
+            cmc_assert(tm_remove(map, i * 2, NULL));
+
+        cmc_assert_equals(size_t, 5003, map->root->size);
+
+        for (size_t i = 0; i < 5003; i++)
+        {
+            cmc_assert(tm_select(map, i, &key, NULL));
+            cmc_assert_equals(size_t, i * 4 + 2, key);
+            cmc_assert_equals(size_t, i, tm_rank(map, key));
+        }
+
+        tm_free(map);
+    });
+
+    CMC_CREATE_TEST(floor[ceiling], {
+        struct treemap *map = tm_new(tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t key;
+        size_t value;
+
+        cmc_assert(!tm_floor(map, 10, &key, &value));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, tm_flag(map));
+        cmc_assert(!tm_ceiling(map, 10, &key, &value));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, tm_flag(map));
+
+        for (size_t i = 1; i <= 100; i++)
+            cmc_assert(tm_insert(map, i * 10, i));
+
+        cmc_assert(!tm_floor(map, 9, &key, &value));
+        cmc_assert_equals(int32_t, cmc_flags.NOT_FOUND, tm_flag(map));
+        cmc_assert(!tm_ceiling(map, 1001, &key, &value));
+        cmc_assert_equals(int32_t, cmc_flags.NOT_FOUND, tm_flag(map));
+
+        for (size_t i = 10; i <= 1000; i++)
+        {
+            cmc_assert(tm_floor(map, i, &key, &value));
+            cmc_assert_equals(size_t, (i / 10) * 10, key);
+            cmc_assert_equals(size_t, i / 10, value);
+
+            cmc_assert(tm_ceiling(map, i, &key, &value));
+            cmc_assert_equals(size_t, ((i + 9) / 10) * 10, key);
+            cmc_assert_equals(size_t, (i + 9) / 10, value);
+        }
+
+        tm_free(map);
+    });
+
+    CMC_CREATE_TEST(remove_range(), {
+        struct treemap *map = tm_new(tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        cmc_assert_equals(size_t, 0, tm_remove_range(map, 0, 10));
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(tm_insert(map, i, i));
+
+        cmc_assert_equals(size_t, 0, tm_remove_range(map, 10, 10));
+        cmc_assert_equals(size_t, 0, tm_remove_range(map, 20, 10));
+        cmc_assert_equals(size_t, 0, tm_remove_range(map, 1000, 2000));
+
+        // Few keys are removed one by one
+        cmc_assert_equals(size_t, 5, tm_remove_range(map, 100, 105));
+        cmc_assert_equals(size_t, 995, tm_count(map));
+        cmc_assert(!tm_contains(map, 100));
+        cmc_assert(!tm_contains(map, 104));
+        cmc_assert(tm_contains(map, 99));
+        cmc_assert(tm_contains(map, 105));
+
+        // Many keys are removed by rebuilding the tree
+        cmc_assert_equals(size_t, 595, tm_remove_range(map, 200, 795));
+        cmc_assert_equals(size_t, 400, tm_count(map));
+        cmc_assert_equals(size_t, 400, map->root->size);
+        cmc_assert_equals(ptr, NULL, map->root->parent);
+
+        size_t key;
+        size_t expected = 0;
+
+        for (size_t i = 0; i < 400; i++)
+        {
+            if (expected == 100)
+                expected = 105;
+            else if (expected == 200)
+                expected = 795;
+
+            cmc_assert(tm_select(map, i, &key, NULL));
+            cmc_assert_equals(size_t, expected, key);
+            cmc_assert_equals(size_t, i, tm_rank(map, key));
+
+            expected++;
+        }
+
+        cmc_assert(tm_insert(map, 500, 500));
+        cmc_assert(tm_remove(map, 0, NULL));
+        cmc_assert_equals(size_t, 400, map->root->size);
+
+        cmc_assert_equals(size_t, 400, tm_remove_range(map, 0, 1000));
+        cmc_assert(tm_empty(map));
+        cmc_assert_equals(ptr, NULL, map->root);
+
+        tm_free(map);
+    });
+
+    CMC_CREATE_TEST(from_sorted(), {
+        size_t keys[1000];
+        size_t values[1000];
+
+        for (size_t i = 0; i < 1000; i++)
+        {
+            keys[i] = i * 2;
+            values[i] = i;
+        }
+
+        struct treemap *map = tm_from_sorted(keys, values, 0, tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+        cmc_assert(tm_empty(map));
+
+        tm_free(map);
+
+        map = tm_from_sorted(keys, values, 1000, tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+        cmc_assert_equals(size_t, 1000, tm_count(map));
+        cmc_assert_equals(size_t, 1000, map->root->size);
+        cmc_assert_equals(size_t, 10, map->root->height);
+        cmc_assert_equals(ptr, NULL, map->root->parent);
+
+        for (size_t i = 0; i < 1000; i++)
+        {
+            cmc_assert_equals(size_t, i, tm_get(map, i * 2));
+            cmc_assert_equals(size_t, i, tm_rank(map, i * 2));
+        }
+
+        cmc_assert(tm_insert(map, 1, 1));
+        cmc_assert(tm_remove(map, 0, NULL));
+        cmc_assert_equals(size_t, 1000, map->root->size);
+
+        tm_free(map);
+
+        // Unsorted keys with duplicates
+        for (size_t i = 0; i < 1000; i++)
+        {
+            keys[i] = (i * 7) % 500;
+            values[i] = i;
+        }
+
+        map = tm_from_sorted(keys, values, 1000, tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+        cmc_assert_equals(size_t, 500, tm_count(map));
+        cmc_assert_equals(size_t, 500, map->root->size);
+
+        for (size_t i = 0; i < 500; i++)
+        {
+            cmc_assert_equals(size_t, i, tm_rank(map, i));
+            cmc_assert_equals(size_t, (i * 143) % 500, tm_get(map, i));
+        }
+
+        tm_free(map);
+
+        // The keys and values that are dropped are freed
+        k_total_free = 0;
+        v_total_free = 0;
+
+        map = tm_from_sorted(keys, values, 1000, tm_fkey_counter,
+                             tm_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+        cmc_assert_equals(size_t, 500, tm_count(map));
+        cmc_assert_equals(int32_t, 500, k_total_free);
+        cmc_assert_equals(int32_t, 500, v_total_free);
+
+        tm_free(map);
+
+        cmc_assert_equals(int32_t, 1000, k_total_free);
+        cmc_assert_equals(int32_t, 1000, v_total_free);
+
+        k_total_free = 0;
+        v_total_free = 0;
+    });
 });
 
 CMC_CREATE_UNIT(TreeMapIter, true, {
@@ -652,6 +883,115 @@ CMC_CREATE_UNIT(TreeMapIter, true, {
 
         tm_free(map);
     });
+
+    CMC_CREATE_TEST(PFX##_iter_range(), {
+        struct treemap *map = tm_new(tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct treemap_iter it = tm_iter_range(map, 0, 10);
+
+        cmc_assert(tm_iter_at_start(&it));
+        cmc_assert(tm_iter_at_end(&it));
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(tm_insert(map, i * 2, i));
+
+        size_t sum = 0;
+        for (it = tm_iter_range(map, 11, 21); !tm_iter_at_end(&it);
+             tm_iter_next(&it))
+        {
+            sum += tm_iter_key(&it);
+        }
+
+        cmc_assert_equals(size_t, 12 + 14 + 16 + 18 + 20, sum);
+
+        it = tm_iter_range(map, 11, 21);
+        cmc_assert(tm_iter_to_end(&it));
+        cmc_assert_equals(size_t, 20, tm_iter_key(&it));
+        cmc_assert_equals(size_t, 4, tm_iter_index(&it));
+        cmc_assert(!tm_iter_advance(&it, 1));
+
+        it = tm_iter_range(map, 11, 21);
+        cmc_assert(tm_iter_advance(&it, 4));
+        cmc_assert_equals(size_t, 20, tm_iter_key(&it));
+        cmc_assert(tm_iter_rewind(&it, 4));
+        cmc_assert_equals(size_t, 12, tm_iter_key(&it));
+
+        it = tm_iter_range(map, 13, 14);
+        cmc_assert(tm_iter_at_end(&it));
+        cmc_assert(!tm_iter_to_start(&it));
+        cmc_assert_equals(ptr, NULL, tm_iter_rvalue(&it));
+
+        sum = 0;
+        for (it = tm_iter_from(map, 1991); !tm_iter_at_end(&it);
+             tm_iter_next(&it))
+        {
+            sum += tm_iter_key(&it);
+        }
+
+        cmc_assert_equals(size_t, 1992 + 1994 + 1996 + 1998, sum);
+
+        it = tm_iter_from(map, 1999);
+        cmc_assert(tm_iter_at_end(&it));
+
+        tm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_lower_bound(), {
+        struct treemap *map = tm_new(tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct treemap_iter it = tm_lower_bound(map, 10);
+
+        cmc_assert(tm_iter_at_end(&it));
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(tm_insert(map, i * 2, i));
+
+        it = tm_lower_bound(map, 10);
+        cmc_assert_equals(size_t, 10, tm_iter_key(&it));
+        cmc_assert_equals(size_t, 5, tm_iter_index(&it));
+
+        it = tm_lower_bound(map, 11);
+        cmc_assert_equals(size_t, 12, tm_iter_key(&it));
+        cmc_assert(tm_iter_prev(&it));
+        cmc_assert_equals(size_t, 10, tm_iter_key(&it));
+
+        it = tm_lower_bound(map, 0);
+        cmc_assert(tm_iter_at_start(&it));
+
+        it = tm_lower_bound(map, 1999);
+        cmc_assert(tm_iter_at_end(&it));
+
+        tm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_upper_bound(), {
+        struct treemap *map = tm_new(tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct treemap_iter it = tm_upper_bound(map, 10);
+
+        cmc_assert(tm_iter_at_end(&it));
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(tm_insert(map, i * 2, i));
+
+        it = tm_upper_bound(map, 10);
+        cmc_assert_equals(size_t, 12, tm_iter_key(&it));
+        cmc_assert_equals(size_t, 6, tm_iter_index(&it));
+
+        it = tm_upper_bound(map, 11);
+        cmc_assert_equals(size_t, 12, tm_iter_key(&it));
+
+        it = tm_upper_bound(map, 1998);
+        cmc_assert(tm_iter_at_end(&it));
+
+        tm_free(map);
+    });
 });
 
 #ifdef CMC_TEST_MAIN
@@ -1,9 +1,12 @@
 #include "utl.c"
 #include "utl/assert.h"
 #include "utl/test.h"
+#include "utl/thread.h"
 
 #include "../src/treeset.c"
 
+CMC_GENERATE_TREESET_PARALLEL(ts, treeset, size_t)
+
 struct treeset_fval *ts_fval = &(struct treeset_fval){ .cmp = cmc_size_cmp,
                                                        .cpy = NULL,
                                                        .str = cmc_size_str,
@@ -11,6 +14,13 @@ struct treeset_fval *ts_fval = &(struct treeset_fval){ .cmp = cmc_size_cmp,
                                                        .hash = cmc_size_hash,
                                                        .pri = cmc_size_cmp };
 
+struct treeset_fval *ts_fval_counter = &(struct treeset_fval){ .cmp = v_c_cmp,
+                                                               .cpy = v_c_cpy,
+                                                               .str = v_c_str,
+                                                               .free = v_c_free,
+                                                               .hash = v_c_hash,
+                                                               .pri = v_c_pri };
+
 CMC_CREATE_UNIT(TreeSet, true, {
     CMC_CREATE_TEST(new, {
         struct treeset *set = ts_new(ts_fval);
@@ -163,6 +173,316 @@ CMC_CREATE_UNIT(TreeSet, true, {
 
         ts_free(set);
     });
+
+    CMC_CREATE_TEST(rank[select], {
+        struct treeset *set = ts_new(ts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        size_t value;
+
+        cmc_assert_equals(size_t, 0, ts_rank(set, 10));
+        cmc_assert(!ts_select(set, 0, &value));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, ts_flag(set));
+
+        // 7919 and 10007 are primes so every value in [0, 10007) is generated
+        for (size_t i = 0; i < 10007; i++)
+            cmc_assert(ts_insert(set, ((i * 7919) % 10007) * 2));
+
+        cmc_assert_equals(size_t, 10007, set->root->size);
+
+        for (size_t i = 0; i < 10007; i++)
+        {
+            cmc_assert_equals(size_t, i, ts_rank(set, i * 2));
+            cmc_assert_equals(size_t, i + 1, ts_rank(set, i * 2 + 1));
+
+            cmc_assert(ts_select(set, i, &value));
+            cmc_assert_equals(size_t, i * 2, value);
+        }
+
+        cmc_assert(!ts_select(set, 10007, &value));
+        cmc_assert_equals(int32_t, cmc_flags.RANGE, ts_flag(set));
+
+        // Remove every value that is a multiple of 4
+        for (size_t i = 0; i < 10007; i += 2)
+            cmc_assert(ts_remove(set, i * 2));
+
+        cmc_assert_equals(size_t, 5003, set->root->size);
+
+        for (size_t i = 0; i < 5003; i++)
+        {
+            cmc_assert(ts_select(set, i, &value));
+            cmc_assert_equals(size_t, i * 4 + 2, value);
+            cmc_assert_equals(size_t, i, ts_rank(set, value));
+        }
+
+        ts_free(set);
+    });
+
+    CMC_CREATE_TEST(floor[ceiling], {
+        struct treeset *set = ts_new(ts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        size_t value;
+
+        cmc_assert(!ts_floor(set, 10, &value));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, ts_flag(set));
+        cmc_assert(!ts_ceiling(set, 10, &value));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, ts_flag(set));
+
+        for (size_t i = 1; i <= 100; i++)
+            cmc_assert(ts_insert(set, i * 10));
+
+        cmc_assert(!ts_floor(set, 9, &value));
+        cmc_assert_equals(int32_t, cmc_flags.NOT_FOUND, ts_flag(set));
+        cmc_assert(!ts_ceiling(set, 1001, &value));
+        cmc_assert_equals(int32_t, cmc_flags.NOT_FOUND, ts_flag(set));
+
+        for (size_t i = 10; i <= 1000; i++)
+        {
+            cmc_assert(ts_floor(set, i, &value));
+            cmc_assert_equals(size_t, (i / 10) * 10, value);
+
+            cmc_assert(ts_ceiling(set, i, &value));
+            cmc_assert_equals(size_t, ((i + 9) / 10) * 10, value);
+        }
+
+        ts_free(set);
+    });
+
+    CMC_CREATE_TEST(remove_range(), {
+        struct treeset *set = ts_new(ts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        cmc_assert_equals(size_t, 0, ts_remove_range(set, 0, 10));
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(ts_insert(set, i));
+
+        cmc_assert_equals(size_t, 0, ts_remove_range(set, 10, 10));
+        cmc_assert_equals(size_t, 0, ts_remove_range(set, 20, 10));
+        cmc_assert_equals(size_t, 0, ts_remove_range(set, 1000, 2000));
+
+        // Few values are removed one by one
+        cmc_assert_equals(size_t, 5, ts_remove_range(set, 100, 105));
+        cmc_assert_equals(size_t, 995, ts_count(set));
+        cmc_assert(!ts_contains(set, 100));
+        cmc_assert(!ts_contains(set, 104));
+        cmc_assert(ts_contains(set, 99));
+        cmc_assert(ts_contains(set, 105));
+
+        // Many values are removed by rebuilding the tree
+        cmc_assert_equals(size_t, 595, ts_remove_range(set, 200, 795));
+        cmc_assert_equals(size_t, 400, ts_count(set));
+        cmc_assert_equals(size_t, 400, set->root->size);
+        cmc_assert_equals(ptr, NULL, set->root->parent);
+
+        size_t value;
+        size_t expected = 0;
+
+        for (size_t i = 0; i < 400; i++)
+        {
+            if (expected == 100)
+                expected = 105;
+            else if (expected == 200)
+                expected = 795;
+
+            cmc_assert(ts_select(set, i, &value));
+            cmc_assert_equals(size_t, expected, value);
+            cmc_assert_equals(size_t, i, ts_rank(set, value));
+
+            expected++;
+        }
+
+        cmc_assert(ts_insert(set, 500));
+        cmc_assert(ts_remove(set, 0));
+        cmc_assert_equals(size_t, 400, set->root->size);
+
+        cmc_assert_equals(size_t, 400, ts_remove_range(set, 0, 1000));
+        cmc_assert(ts_empty(set));
+        cmc_assert_equals(ptr, NULL, set->root);
+
+        ts_free(set);
+    });
+
+    CMC_CREATE_TEST(from_sorted(), {
+        size_t values[1000];
+
+        for (size_t i = 0; i < 1000; i++)
+        {
+            values[i] = i * 2;
+        }
+
+        struct treeset *set = ts_from_sorted(values, 0, ts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+        cmc_assert(ts_empty(set));
+
+        ts_free(set);
+
+        set = ts_from_sorted(values, 1000, ts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+        cmc_assert_equals(size_t, 1000, ts_count(set));
+        cmc_assert_equals(size_t, 1000, set->root->size);
+        cmc_assert_equals(size_t, 10, set->root->height);
+        cmc_assert_equals(ptr, NULL, set->root->parent);
+
+        for (size_t i = 0; i < 1000; i++)
+        {
+            cmc_assert(ts_contains(set, i * 2));
+            cmc_assert_equals(size_t, i, ts_rank(set, i * 2));
+        }
+
+        cmc_assert(ts_insert(set, 1));
+        cmc_assert(ts_remove(set, 0));
+        cmc_assert_equals(size_t, 1000, set->root->size);
+
+        ts_free(set);
+
+        // Unsorted values with duplicates
+        for (size_t i = 0; i < 1000; i++)
+        {
+            values[i] = (i * 7) % 500;
+        }
+
+        set = ts_from_sorted(values, 1000, ts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+        cmc_assert_equals(size_t, 500, ts_count(set));
+        cmc_assert_equals(size_t, 500, set->root->size);
+
+        for (size_t i = 0; i < 500; i++)
+        {
+            cmc_assert_equals(size_t, i, ts_rank(set, i));
+        }
+
+        ts_free(set);
+
+        // The values that are dropped are freed
+        v_total_free = 0;
+
+        set = ts_from_sorted(values, 1000, ts_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+        cmc_assert_equals(size_t, 500, ts_count(set));
+        cmc_assert_equals(int32_t, 500, v_total_free);
+
+        ts_free(set);
+
+        cmc_assert_equals(int32_t, 1000, v_total_free);
+
+        v_total_free = 0;
+    });
+
+    CMC_CREATE_TEST(set_operations, {
+        struct treeset *set1 = ts_new(ts_fval);
+        struct treeset *set2 = ts_new(ts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set1);
+        cmc_assert_not_equals(ptr, NULL, set2);
+
+        // set1 has multiples of 2 and set2 has multiples of 3
+        for (size_t i = 0; i < 3000; i += 2)
+            cmc_assert(ts_insert(set1, i));
+        for (size_t i = 0; i < 3000; i += 3)
+            cmc_assert(ts_insert(set2, i));
+
+        struct treeset *set_u = ts_union(set1, set2);
+        struct treeset *set_i = ts_intersection(set1, set2);
+        struct treeset *set_d = ts_difference(set1, set2);
+        struct treeset *set_s = ts_symmetric_difference(set1, set2);
+
+        cmc_assert_equals(size_t, 2000, ts_count(set_u));
+        cmc_assert_equals(size_t, 500, ts_count(set_i));
+        cmc_assert_equals(size_t, 1000, ts_count(set_d));
+        cmc_assert_equals(size_t, 1500, ts_count(set_s));
+
+        cmc_assert_equals(size_t, 2000, set_u->root->size);
+        cmc_assert_equals(size_t, 500, set_i->root->size);
+        cmc_assert_equals(size_t, 1000, set_d->root->size);
+        cmc_assert_equals(size_t, 1500, set_s->root->size);
+
+        for (size_t i = 0; i < 3000; i++)
+        {
+            bool in1 = i % 2 == 0;
+            bool in2 = i % 3 == 0;
+
+            cmc_assert_equals(bool, in1 || in2, ts_contains(set_u, i));
+            cmc_assert_equals(bool, in1 &&in2, ts_contains(set_i, i));
+            cmc_assert_equals(bool, in1 && !in2, ts_contains(set_d, i));
+            cmc_assert_equals(bool, in1 != in2, ts_contains(set_s, i));
+        }
+
+        cmc_assert(ts_is_subset(set_i, set1));
+        cmc_assert(ts_is_subset(set_i, set2));
+        cmc_assert(ts_is_proper_subset(set_d, set1));
+        cmc_assert(ts_is_superset(set_u, set_s));
+        cmc_assert(!ts_is_subset(set1, set2));
+        cmc_assert(!ts_is_proper_superset(set1, set1));
+        cmc_assert(ts_is_disjointset(set_d, set2));
+        cmc_assert(!ts_is_disjointset(set1, set2));
+
+        ts_free(set1);
+        ts_free(set2);
+        ts_free(set_u);
+        ts_free(set_i);
+        ts_free(set_d);
+        ts_free(set_s);
+    });
+
+    CMC_CREATE_TEST(set_operations_parallel, {
+        struct treeset *set1 = ts_new(ts_fval);
+        struct treeset *set2 = ts_new(ts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set1);
+        cmc_assert_not_equals(ptr, NULL, set2);
+
+        // Enough values to go above CMC_TREESET_PARALLEL_CUTOFF
+        for (size_t i = 0; i < 200000; i += 2)
+            cmc_assert(ts_insert(set1, i));
+        for (size_t i = 0; i < 200000; i += 3)
+            cmc_assert(ts_insert(set2, i));
+
+        for (size_t threads = 1; threads <= 8; threads *= 2)
+        {
+            struct treeset *set_u = ts_union_parallel(set1, set2, threads);
+            struct treeset *set_i =
+                ts_intersection_parallel(set1, set2, threads);
+            struct treeset *set_d = ts_difference_parallel(set1, set2, threads);
+            struct treeset *set_s =
+                ts_symmetric_difference_parallel(set1, set2, threads);
+
+            struct treeset *seq_u = ts_union(set1, set2);
+            struct treeset *seq_i = ts_intersection(set1, set2);
+            struct treeset *seq_d = ts_difference(set1, set2);
+            struct treeset *seq_s = ts_symmetric_difference(set1, set2);
+
+            cmc_assert(ts_equals(set_u, seq_u));
+            cmc_assert(ts_equals(set_i, seq_i));
+            cmc_assert(ts_equals(set_d, seq_d));
+            cmc_assert(ts_equals(set_s, seq_s));
+
+            cmc_assert_equals(size_t, ts_count(seq_u), set_u->root->size);
+            cmc_assert_equals(size_t, ts_count(seq_i), set_i->root->size);
+            cmc_assert_equals(size_t, ts_count(seq_d), set_d->root->size);
+            cmc_assert_equals(size_t, ts_count(seq_s), set_s->root->size);
+
+            ts_free(set_u);
+            ts_free(set_i);
+            ts_free(set_d);
+            ts_free(set_s);
+            ts_free(seq_u);
+            ts_free(seq_i);
+            ts_free(seq_d);
+            ts_free(seq_s);
+        }
+
+        ts_free(set1);
+        ts_free(set2);
+    });
 });
 
 CMC_CREATE_UNIT(TreeSetIter, true, {
@@ -567,6 +887,114 @@ CMC_CREATE_UNIT(TreeSetIter, true, {
 
         ts_free(set);
     });
+
+    CMC_CREATE_TEST(PFX##_iter_range(), {
+        struct treeset *set = ts_new(ts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        struct treeset_iter it = ts_iter_range(set, 0, 10);
+
+        cmc_assert(ts_iter_at_start(&it));
+        cmc_assert(ts_iter_at_end(&it));
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(ts_insert(set, i * 2));
+
+        size_t sum = 0;
+        for (it = ts_iter_range(set, 11, 21); !ts_iter_at_end(&it);
+             ts_iter_next(&it))
+        {
+            sum += ts_iter_value(&it);
+        }
+
+        cmc_assert_equals(size_t, 12 + 14 + 16 + 18 + 20, sum);
+
+        it = ts_iter_range(set, 11, 21);
+        cmc_assert(ts_iter_to_end(&it));
+        cmc_assert_equals(size_t, 20, ts_iter_value(&it));
+        cmc_assert_equals(size_t, 4, ts_iter_index(&it));
+        cmc_assert(!ts_iter_advance(&it, 1));
+
+        it = ts_iter_range(set, 11, 21);
+        cmc_assert(ts_iter_advance(&it, 4));
+        cmc_assert_equals(size_t, 20, ts_iter_value(&it));
+        cmc_assert(ts_iter_rewind(&it, 4));
+        cmc_assert_equals(size_t, 12, ts_iter_value(&it));
+
+        it = ts_iter_range(set, 13, 14);
+        cmc_assert(ts_iter_at_end(&it));
+        cmc_assert(!ts_iter_to_start(&it));
+
+        sum = 0;
+        for (it = ts_iter_from(set, 1991); !ts_iter_at_end(&it);
+             ts_iter_next(&it))
+        {
+            sum += ts_iter_value(&it);
+        }
+
+        cmc_assert_equals(size_t, 1992 + 1994 + 1996 + 1998, sum);
+
+        it = ts_iter_from(set, 1999);
+        cmc_assert(ts_iter_at_end(&it));
+
+        ts_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_lower_bound(), {
+        struct treeset *set = ts_new(ts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        struct treeset_iter it = ts_lower_bound(set, 10);
+
+        cmc_assert(ts_iter_at_end(&it));
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(ts_insert(set, i * 2));
+
+        it = ts_lower_bound(set, 10);
+        cmc_assert_equals(size_t, 10, ts_iter_value(&it));
+        cmc_assert_equals(size_t, 5, ts_iter_index(&it));
+
+        it = ts_lower_bound(set, 11);
+        cmc_assert_equals(size_t, 12, ts_iter_value(&it));
+        cmc_assert(ts_iter_prev(&it));
+        cmc_assert_equals(size_t, 10, ts_iter_value(&it));
+
+        it = ts_lower_bound(set, 0);
+        cmc_assert(ts_iter_at_start(&it));
+
+        it = ts_lower_bound(set, 1999);
+        cmc_assert(ts_iter_at_end(&it));
+
+        ts_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_upper_bound(), {
+        struct treeset *set = ts_new(ts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        struct treeset_iter it = ts_upper_bound(set, 10);
+
+        cmc_assert(ts_iter_at_end(&it));
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(ts_insert(set, i * 2));
+
+        it = ts_upper_bound(set, 10);
+        cmc_assert_equals(size_t, 12, ts_iter_value(&it));
+        cmc_assert_equals(size_t, 6, ts_iter_index(&it));
+
+        it = ts_upper_bound(set, 11);
+        cmc_assert_equals(size_t, 12, ts_iter_value(&it));
+
+        it = ts_upper_bound(set, 1998);
+        cmc_assert(ts_iter_at_end(&it));
+
+        ts_free(set);
+    });
 });
 
 #ifdef CMC_TEST_MAIN
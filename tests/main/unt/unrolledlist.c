@@ -0,0 +1,607 @@
+#include "utl.c"
+#include "utl/assert.h"
+#include "utl/test.h"
+
+#include "../src/unrolledlist.c"
+
+struct unrolledlist_fval *ul_fval =
+    &(struct unrolledlist_fval){ .cmp = cmc_size_cmp,
+                                 .cpy = NULL,
+                                 .str = cmc_size_str,
+                                 .free = NULL,
+                                 .hash = cmc_size_hash,
+                                 .pri = cmc_size_cmp };
+
+struct unrolledlist_fval *ul_fval_counter =
+    &(struct unrolledlist_fval){ .cmp = v_c_cmp,
+                                 .cpy = v_c_cpy,
+                                 .str = v_c_str,
+                                 .free = v_c_free,
+                                 .hash = v_c_hash,
+                                 .pri = v_c_pri };
+
+/* Values per node */
+const size_t ul_capacity = CMC_UNROLLEDLIST_NODE_CAPACITY(size_t);
+
+/* Checks the links between the nodes and that their counts add up */
+bool ul_is_valid(struct unrolledlist *l)
+{
+    size_t count = 0;
+    size_t nodes = 0;
+
+    struct unrolledlist_node *prev = NULL;
+
+    for (struct unrolledlist_node *scan = l->head; scan; scan = scan->next)
+    {
+        if (scan->prev != prev || scan->count == 0 || scan->count > ul_capacity)
+            return false;
+
+        count += scan->count;
+        nodes++;
+        prev = scan;
+    }
+
+    return prev == l->tail && count == l->count && nodes == l->nodes;
+}
+
+CMC_CREATE_UNIT(UnrolledList, true, {
+    CMC_CREATE_TEST(new, {
+        struct unrolledlist *l = ul_new(ul_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+        cmc_assert_equals(ptr, NULL, l->head);
+        cmc_assert_equals(ptr, NULL, l->tail);
+        cmc_assert_equals(size_t, 0, ul_count(l));
+        cmc_assert_equals(size_t, 0, l->nodes);
+
+        ul_free(l);
+    });
+
+    CMC_CREATE_TEST(new[f_val = NULL], {
+        struct unrolledlist *l = ul_new(NULL);
+
+        cmc_assert_equals(ptr, NULL, l);
+    });
+
+    CMC_CREATE_TEST(clear[count], {
+        struct unrolledlist *l = ul_new(ul_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t i = 0; i < 100; i++)
+            ul_push_back(l, i);
+
+        cmc_assert_equals(size_t, 100, ul_count(l));
+
+        ul_clear(l);
+
+        cmc_assert_equals(size_t, 0, ul_count(l));
+        cmc_assert_equals(size_t, 0, l->nodes);
+        cmc_assert_equals(ptr, NULL, l->head);
+        cmc_assert_equals(ptr, NULL, l->tail);
+
+        ul_free(l);
+    });
+
+    CMC_CREATE_TEST(free[counter], {
+        v_total_free = 0;
+
+        struct unrolledlist *l = ul_new(ul_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(ul_push_back(l, i));
+
+        ul_free(l);
+
+        cmc_assert_equals(size_t, 100, v_total_free);
+
+        v_total_free = 0;
+    });
+
+    CMC_CREATE_TEST(push_back[full nodes], {
+        struct unrolledlist *l = ul_new(ul_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t i = 0; i < ul_capacity * 10; i++)
+            cmc_assert(ul_push_back(l, i));
+
+        cmc_assert_equals(size_t, 10, l->nodes);
+        cmc_assert(ul_is_valid(l));
+
+        for (size_t i = 0; i < ul_capacity * 10; i++)
+            cmc_assert_equals(size_t, i, ul_get(l, i));
+
+        ul_free(l);
+    });
+
+    CMC_CREATE_TEST(push_front[full nodes], {
+        struct unrolledlist *l = ul_new(ul_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t i = 0; i < ul_capacity * 10; i++)
+            cmc_assert(ul_push_front(l, i));
+
+        cmc_assert_equals(size_t, 10, l->nodes);
+        cmc_assert(ul_is_valid(l));
+
+        for (size_t i = 0; i < ul_capacity * 10; i++)
+            cmc_assert_equals(size_t, ul_capacity * 10 - i - 1, ul_get(l, i));
+
+        ul_free(l);
+    });
+
+    CMC_CREATE_TEST(pop_front pop_back, {
+        struct unrolledlist *l = ul_new(ul_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        cmc_assert(!ul_pop_front(l));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, ul_flag(l));
+        cmc_assert(!ul_pop_back(l));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, ul_flag(l));
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(ul_push_back(l, i));
+
+        for (size_t i = 0; i < 500; i++)
+        {
+            cmc_assert_equals(size_t, i, ul_front(l));
+            cmc_assert_equals(size_t, 999 - i, ul_back(l));
+
+            cmc_assert(ul_pop_front(l));
+            cmc_assert(ul_pop_back(l));
+            cmc_assert(ul_is_valid(l));
+        }
+
+        cmc_assert(ul_empty(l));
+        cmc_assert_equals(size_t, 0, l->nodes);
+        cmc_assert_equals(ptr, NULL, l->head);
+        cmc_assert_equals(ptr, NULL, l->tail);
+
+        ul_free(l);
+    });
+
+    CMC_CREATE_TEST(push_at[split], {
+        struct unrolledlist *l = ul_new(ul_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t i = 0; i < ul_capacity; i++)
+            cmc_assert(ul_push_back(l, i * 2));
+
+        cmc_assert_equals(size_t, 1, l->nodes);
+
+        cmc_assert(ul_push_at(l, 7, 4));
+
+        cmc_assert_equals(size_t, 2, l->nodes);
+        cmc_assert_equals(size_t, ul_capacity + 1, ul_count(l));
+        cmc_assert_equals(size_t, 7, ul_get(l, 4));
+        cmc_assert(ul_is_valid(l));
+
+        cmc_assert(!ul_push_at(l, 1, ul_capacity + 2));
+        cmc_assert_equals(int32_t, cmc_flags.RANGE, ul_flag(l));
+
+        ul_free(l);
+    });
+
+    CMC_CREATE_TEST(pop_at[merge], {
+        struct unrolledlist *l = ul_new(ul_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t i = 0; i < ul_capacity * 4; i++)
+            cmc_assert(ul_push_back(l, i));
+
+        cmc_assert_equals(size_t, 4, l->nodes);
+
+        // Empties the two nodes in the middle
+        for (size_t i = 0; i < ul_capacity * 2; i++)
+        {
+            cmc_assert(ul_pop_at(l, ul_capacity));
+            cmc_assert(ul_is_valid(l));
+        }
+
+        cmc_assert_equals(size_t, 2, l->nodes);
+        cmc_assert_equals(size_t, ul_capacity * 2, ul_count(l));
+
+        for (size_t i = 0; i < ul_capacity; i++)
+        {
+            cmc_assert_equals(size_t, i, ul_get(l, i));
+            cmc_assert_equals(size_t, ul_capacity * 3 + i,
+                              ul_get(l, ul_capacity + i));
+        }
+
+        cmc_assert(!ul_pop_at(l, ul_capacity * 2));
+        cmc_assert_equals(int32_t, cmc_flags.RANGE, ul_flag(l));
+
+        ul_free(l);
+    });
+
+    CMC_CREATE_TEST(get get_ref, {
+        struct unrolledlist *l = ul_new(ul_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        cmc_assert_equals(ptr, NULL, ul_get_ref(l, 0));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, ul_flag(l));
+
+        for (size_t i = 0; i < 200; i++)
+            cmc_assert(ul_push_back(l, i));
+
+        for (size_t i = 0; i < 200; i++)
+            *ul_get_ref(l, i) += 1;
+
+        for (size_t i = 0; i < 200; i++)
+            cmc_assert_equals(size_t, i + 1, ul_get(l, i));
+
+        cmc_assert_equals(ptr, NULL, ul_get_ref(l, 200));
+        cmc_assert_equals(int32_t, cmc_flags.RANGE, ul_flag(l));
+
+        ul_free(l);
+    });
+
+    CMC_CREATE_TEST(contains, {
+        struct unrolledlist *l = ul_new(ul_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        cmc_assert(!ul_contains(l, 0));
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(ul_push_back(l, i * 2));
+
+        cmc_assert(ul_contains(l, 0));
+        cmc_assert(ul_contains(l, 100));
+        cmc_assert(ul_contains(l, 198));
+        cmc_assert(!ul_contains(l, 99));
+        cmc_assert(!ul_contains(l, 200));
+
+        ul_free(l);
+    });
+
+    CMC_CREATE_TEST(copy_of equals, {
+        struct unrolledlist *l1 = ul_new(ul_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l1);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(ul_push_at(l1, i, i / 2));
+
+        struct unrolledlist *l2 = ul_copy_of(l1);
+
+        cmc_assert_not_equals(ptr, NULL, l2);
+        cmc_assert(ul_is_valid(l2));
+        cmc_assert_equals(size_t, l1->nodes, l2->nodes);
+        cmc_assert(ul_equals(l1, l2));
+
+        cmc_assert(ul_pop_back(l2));
+        cmc_assert(!ul_equals(l1, l2));
+
+        cmc_assert(ul_push_back(l2, 1000));
+        cmc_assert(!ul_equals(l1, l2));
+
+        ul_free(l1);
+        ul_free(l2);
+    });
+
+    CMC_CREATE_TEST(copy_of[counter], {
+        v_total_cpy = 0;
+        v_total_free = 0;
+
+        struct unrolledlist *l1 = ul_new(ul_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, l1);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(ul_push_back(l1, i));
+
+        struct unrolledlist *l2 = ul_copy_of(l1);
+
+        cmc_assert_not_equals(ptr, NULL, l2);
+        cmc_assert_equals(size_t, 100, v_total_cpy);
+
+        ul_free(l1);
+        ul_free(l2);
+
+        cmc_assert_equals(size_t, 200, v_total_free);
+
+        v_total_cpy = 0;
+        v_total_free = 0;
+    });
+
+    CMC_CREATE_TEST(random edits, {
+        struct unrolledlist *l = ul_new(ul_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        // The same edits are done to a plain array
+        size_t array[500];
+        size_t count = 0;
+        size_t seed = 13;
+
+        for (size_t i = 0; i < 5000; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+
+            size_t r = (seed >> 16) % 100;
+            size_t index = (seed >> 8) % (count + 1);
+
+            if (r < 55 && count < 500)
+            {
+                memmove(array + index + 1, array + index,
+                        (count - index) * sizeof(size_t));
+                array[index] = i;
+                count++;
+
+                cmc_assert(ul_push_at(l, i, index));
+            }
+            else if (count > 0)
+            {
+                if (index == count)
+                    index--;
+
+                memmove(array + index, array + index + 1,
+                        (count - index - 1) * sizeof(size_t));
+                count--;
+
+                cmc_assert(ul_pop_at(l, index));
+            }
+        }
+
+        cmc_assert(ul_is_valid(l));
+        cmc_assert_equals(size_t, count, ul_count(l));
+
+        for (size_t i = 0; i < count; i++)
+            cmc_assert_equals(size_t, array[i], ul_get(l, i));
+
+        ul_free(l);
+    });
+});
+
+CMC_CREATE_UNIT(UnrolledListIter, true, {
+    CMC_CREATE_TEST(PFX##_iter_next(), {
+        struct unrolledlist *l = ul_new(ul_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        struct unrolledlist_iter it = ul_iter_start(l);
+
+        cmc_assert(!ul_iter_next(&it));
+
+        for (size_t i = 1; i <= 1000; i++)
+        {
+            if (i % 2 == 0)
+                ul_push_back(l, i);
+            else
+                ul_push_front(l, i);
+        }
+
+        size_t sum = 0;
+        for (it = ul_iter_start(l); !ul_iter_at_end(&it); ul_iter_next(&it))
+        {
+            sum += ul_iter_value(&it);
+        }
+
+        cmc_assert_equals(size_t, 500500, sum);
+        cmc_assert_equals(size_t, 999, ul_iter_index(&it));
+
+        ul_free(l);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_prev(), {
+        struct unrolledlist *l = ul_new(ul_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t i = 1; i <= 100; i++)
+            ul_push_back(l, i);
+
+        size_t sum = 0;
+        struct unrolledlist_iter it = ul_iter_end(l);
+
+        do
+        {
+            sum += *ul_iter_rvalue(&it);
+        } while (ul_iter_prev(&it));
+
+        cmc_assert_equals(size_t, 5050, sum);
+        cmc_assert(ul_iter_at_start(&it));
+
+        ul_free(l);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_advance() PFX##_iter_rewind(), {
+        struct unrolledlist *l = ul_new(ul_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t i = 0; i < 100; i++)
+            ul_push_back(l, i);
+
+        struct unrolledlist_iter it = ul_iter_start(l);
+
+        cmc_assert(!ul_iter_rewind(&it, 1));
+        cmc_assert(ul_iter_advance(&it, 1));
+        cmc_assert_equals(size_t, 1, ul_iter_value(&it));
+        cmc_assert(ul_iter_advance(&it, 60));
+        cmc_assert_equals(size_t, 61, ul_iter_value(&it));
+        cmc_assert(!ul_iter_advance(&it, 39));
+        cmc_assert(ul_iter_advance(&it, 38));
+        cmc_assert_equals(size_t, 99, ul_iter_value(&it));
+
+        cmc_assert(ul_iter_rewind(&it, 45));
+        cmc_assert_equals(size_t, 54, ul_iter_value(&it));
+        cmc_assert(!ul_iter_rewind(&it, 55));
+        cmc_assert(ul_iter_rewind(&it, 54));
+        cmc_assert_equals(size_t, 0, ul_iter_value(&it));
+        cmc_assert_equals(size_t, 0, ul_iter_index(&it));
+
+        ul_free(l);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_go_to(), {
+        struct unrolledlist *l = ul_new(ul_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t i = 0; i < 100; i++)
+            ul_push_back(l, i);
+
+        struct unrolledlist_iter it = ul_iter_start(l);
+
+        for (size_t i = 0; i < 100; i++)
+        {
+            size_t index = (i * 37) % 100;
+
+            cmc_assert(ul_iter_go_to(&it, index));
+            cmc_assert_equals(size_t, index, ul_iter_index(&it));
+            cmc_assert_equals(size_t, index, ul_iter_value(&it));
+        }
+
+        cmc_assert(!ul_iter_go_to(&it, 100));
+
+        ul_free(l);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_add_next(), {
+        struct unrolledlist *l = ul_new(ul_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        struct unrolledlist_iter it = ul_iter_start(l);
+
+        cmc_assert(!ul_iter_add_next(&it, 1));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, ul_flag(l));
+
+        cmc_assert(ul_push_back(l, 0));
+
+        it = ul_iter_start(l);
+
+        // Keeps adding after the cursor, which splits the node many times
+        for (size_t i = 1; i < 200; i++)
+        {
+            cmc_assert(ul_iter_add_next(&it, 200 - i));
+            cmc_assert_equals(size_t, 0, ul_iter_value(&it));
+            cmc_assert(ul_is_valid(l));
+        }
+
+        for (size_t i = 0; i < 200; i++)
+            cmc_assert_equals(size_t, i, ul_get(l, i));
+
+        // Adds after every element
+        for (it = ul_iter_start(l); !ul_iter_at_end(&it); ul_iter_next(&it))
+        {
+            size_t value = ul_iter_value(&it);
+
+            cmc_assert(ul_iter_add_next(&it, value));
+            cmc_assert_equals(size_t, value, ul_iter_value(&it));
+            cmc_assert(ul_iter_next(&it));
+        }
+
+        cmc_assert(ul_is_valid(l));
+        cmc_assert_equals(size_t, 400, ul_count(l));
+
+        for (size_t i = 0; i < 400; i++)
+            cmc_assert_equals(size_t, i / 2, ul_get(l, i));
+
+        ul_free(l);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_add_prev(), {
+        struct unrolledlist *l = ul_new(ul_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        cmc_assert(ul_push_back(l, 199));
+
+        struct unrolledlist_iter it = ul_iter_start(l);
+
+        for (size_t i = 0; i < 199; i++)
+        {
+            cmc_assert(ul_iter_add_prev(&it, i));
+            cmc_assert_equals(size_t, 199, ul_iter_value(&it));
+            cmc_assert_equals(size_t, i + 1, ul_iter_index(&it));
+            cmc_assert(ul_is_valid(l));
+        }
+
+        for (size_t i = 0; i < 200; i++)
+            cmc_assert_equals(size_t, i, ul_get(l, i));
+
+        // Going back to the start of the list goes through every element
+        size_t sum = 0;
+
+        do
+        {
+            sum += ul_iter_value(&it);
+        } while (ul_iter_prev(&it));
+
+        cmc_assert_equals(size_t, 19900, sum);
+
+        ul_free(l);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_del_curr(), {
+        struct unrolledlist *l = ul_new(ul_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t i = 0; i < 200; i++)
+            cmc_assert(ul_push_back(l, i));
+
+        struct unrolledlist_iter it = ul_iter_start(l);
+
+        // Removes every odd element
+        cmc_assert(ul_iter_next(&it));
+
+        for (size_t i = 0; i < 99; i++)
+        {
+            cmc_assert(ul_iter_del_curr(&it));
+            cmc_assert_equals(size_t, (i + 1) * 2, ul_iter_value(&it));
+            cmc_assert(ul_iter_next(&it));
+            cmc_assert(ul_is_valid(l));
+        }
+
+        // The cursor goes to the previous element when removing the last one
+        cmc_assert_equals(size_t, 199, ul_iter_value(&it));
+        cmc_assert(ul_iter_del_curr(&it));
+        cmc_assert_equals(size_t, 198, ul_iter_value(&it));
+        cmc_assert(ul_iter_at_end(&it));
+
+        cmc_assert_equals(size_t, 100, ul_count(l));
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert_equals(size_t, i * 2, ul_get(l, i));
+
+        // Empties the list from its end
+        while (!ul_empty(l))
+            cmc_assert(ul_iter_del_curr(&it));
+
+        cmc_assert_equals(size_t, 0, l->nodes);
+        cmc_assert(!ul_iter_del_curr(&it));
+        cmc_assert_equals(int32_t, cmc_flags.EMPTY, ul_flag(l));
+
+        ul_free(l);
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = UnrolledList() + UnrolledListIter();
+
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | UnrolledList Suit : %-41s |\n",
+           result == 0 ? "PASSED" : "FAILED");
+    printf(
+        " +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif